@@ -332,7 +332,7 @@ function(qt_create_tracepoints name tracepoints_file)
     set(header_filename "${provider_name}_tracepoints_p.h")
     set(header_path "${CMAKE_CURRENT_BINARY_DIR}/${header_filename}")
 
-    if(QT_FEATURE_lttng OR QT_FEATURE_etw)
+    if(QT_FEATURE_lttng OR QT_FEATURE_etw OR QT_FEATURE_ctf)
         set(source_path "${CMAKE_CURRENT_BINARY_DIR}/${provider_name}_tracepoints.cpp")
         qt_configure_file(OUTPUT "${source_path}"
             CONTENT "#define TRACEPOINT_CREATE_PROBES
@@ -346,6 +346,8 @@ function(qt_create_tracepoints name tracepoints_file)
             target_link_libraries(${name} PRIVATE LTTng::UST)
         elseif(QT_FEATURE_etw)
             set(tracegen_arg "etw")
+        elseif(QT_FEATURE_ctf)
+            set(tracegen_arg "ctf")
         endif()
 
         if(QT_HOST_PATH)
@@ -99,6 +99,7 @@
 
 static int system_has_forkfd(void);
 static int system_forkfd(int flags, pid_t *ppid, int *system);
+static int system_vforkfd(int flags, pid_t *ppid, int (*childFn)(void *), void *token, int *system);
 static int system_forkfd_wait(int ffd, struct forkfd_info *info, int ffdwoptions, struct rusage *rusage);
 
 static int disable_fork_fallback(void)
@@ -764,6 +765,47 @@ err_free:
     freeInfo(header, info);
     return -1;
 }
+
+/**
+ * @brief vforkfd starts a child process that runs @a childFn
+ * @return a file descriptor, or -1 in case of failure
+ *
+ * vforkfd() works like forkfd(), except that the child process does not
+ * return from this function: it calls @a childFn with @a token and exits
+ * with the value that function returns.
+ *
+ * Where the system supports it, the child process shares the memory of the
+ * parent, whose calling thread is suspended until the child either calls one
+ * of the exec functions or exits. That avoids copying the page tables of the
+ * parent, which is what makes fork(2) slow for processes with a large amount
+ * of memory. Therefore, @a childFn must only use async-signal-safe functions,
+ * and it may only modify memory it owns. Signal handlers installed by the
+ * parent are not run in the child. On other systems, the child is a regular
+ * forked process.
+ *
+ * The @a flags parameter is the same as for forkfd(); @c FFD_USE_FORK
+ * requests a regular forked child.
+ */
+int vforkfd(int flags, pid_t *ppid, int (*childFn)(void *), void *token)
+{
+    int fd;
+    int ret = 0;
+
+    /* unlike forkfd(), keep FFD_USE_FORK even if the fallback is disabled:
+     * forkfd() then still creates a child that does not share our memory */
+    if ((flags & FFD_USE_FORK) == 0) {
+        fd = system_vforkfd(flags, ppid, childFn, token, &ret);
+        if (ret || disable_fork_fallback())
+            return fd;
+    }
+
+    fd = forkfd(flags, ppid);
+    if (fd == FFD_CHILD_PROCESS) {
+        /* child process */
+        _exit(childFn(token));
+    }
+    return fd;
+}
 #endif // FORKFD_NO_FORKFD
 
 #if _POSIX_SPAWN > 0 && !defined(FORKFD_NO_SPAWNFD)
@@ -880,6 +922,16 @@ int system_forkfd(int flags, pid_t *ppid, int *system)
     return -1;
 }
 
+int system_vforkfd(int flags, pid_t *ppid, int (*childFn)(void *), void *token, int *system)
+{
+    (void)flags;
+    (void)ppid;
+    (void)childFn;
+    (void)token;
+    *system = 0;
+    return -1;
+}
+
 int system_forkfd_wait(int ffd, struct forkfd_info *info, int options, struct rusage *rusage)
 {
     (void)ffd;
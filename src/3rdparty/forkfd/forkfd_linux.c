@@ -36,6 +36,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/resource.h>
 #include <sys/syscall.h>
 #include <sys/types.h>
@@ -95,6 +96,33 @@ static int sys_clone(unsigned long cloneflags, int *ptid)
 #endif
 }
 
+struct vfork_child_args
+{
+    int (*childFn)(void *);
+    void *token;
+    const sigset_t *mask;
+};
+
+static int vfork_child_main(void *arg)
+{
+    /* We share the memory of the parent, so its signal handlers must not run
+     * here. The handler table itself is a copy (no CLONE_SIGHAND). */
+    struct vfork_child_args *args = (struct vfork_child_args *)arg;
+    int sig;
+    for (sig = 1; sig < NSIG; ++sig) {
+        struct sigaction sa;
+        if (sigaction(sig, NULL, &sa) != 0)
+            continue;
+        if (sa.sa_handler == SIG_IGN || sa.sa_handler == SIG_DFL)
+            continue;
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = SIG_DFL;
+        sigaction(sig, &sa, NULL);
+    }
+    sigprocmask(SIG_SETMASK, args->mask, NULL);
+    return args->childFn(args->token);
+}
+
 static int detect_clone_pidfd_support()
 {
     /*
@@ -169,6 +197,79 @@ int system_forkfd(int flags, pid_t *ppid, int *system)
     return pidfd;
 }
 
+/* The child stack is sized like glibc's posix_spawn() does. It is 32 kB plus
+ * room for a copy of argv there; childFn gets argv through token instead. */
+#define VFORK_STACK_SIZE    (32 * 1024)
+
+int system_vforkfd(int flags, pid_t *ppid, int (*childFn)(void *), void *token, int *system)
+{
+    struct vfork_child_args args;
+    sigset_t allSignals, oldMask;
+    size_t pageSize, stackSize;
+    char *stack;
+    pid_t pid;
+    int pidfd;
+    int savedErrno;
+
+    int state = ffd_atomic_load(&system_forkfd_state, FFD_ATOMIC_RELAXED);
+    if (state == 0) {
+        state = detect_clone_pidfd_support();
+        ffd_atomic_store(&system_forkfd_state, state, FFD_ATOMIC_RELAXED);
+    }
+    if (state < 0) {
+        *system = 0;
+        return state;
+    }
+
+    *system = 1;
+
+    /* The child runs on its own stack while our thread is suspended, with a
+     * guard page below it so that an overflow faults instead of overwriting
+     * our memory. */
+    pageSize = sysconf(_SC_PAGESIZE);
+    stackSize = (VFORK_STACK_SIZE + pageSize - 1) & ~(pageSize - 1);
+    stack = (char *)mmap(NULL, stackSize + pageSize, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+    if (stack == MAP_FAILED)
+        return -1;
+    if (mprotect(stack, pageSize, PROT_NONE) == -1) {
+        savedErrno = errno;
+        munmap(stack, stackSize + pageSize);
+        errno = savedErrno;
+        return -1;
+    }
+
+    /* Block all signals so no handler runs in the child before it has reset
+     * them; the child restores our mask before calling childFn. */
+    args.childFn = childFn;
+    args.token = token;
+    args.mask = &oldMask;
+    sigfillset(&allSignals);
+    pthread_sigmask(SIG_SETMASK, &allSignals, &oldMask);
+
+    pid = clone(vfork_child_main, stack + pageSize + stackSize,
+                CLONE_PIDFD | CLONE_VM | CLONE_VFORK, &args, &pidfd);
+
+    /* the child has called execve() or exited by now */
+    savedErrno = errno;
+    pthread_sigmask(SIG_SETMASK, &oldMask, NULL);
+    munmap(stack, stackSize + pageSize);
+    errno = savedErrno;
+
+    if (pid < 0)
+        return pid;
+    if (ppid)
+        *ppid = pid;
+
+    if ((flags & FFD_CLOEXEC) == 0) {
+        /* pidfd defaults to O_CLOEXEC */
+        fcntl(pidfd, F_SETFD, 0);
+    }
+    if (flags & FFD_NONBLOCK)
+        fcntl(pidfd, F_SETFL, fcntl(pidfd, F_GETFL) | O_NONBLOCK);
+    return pidfd;
+}
+
 int system_forkfd_wait(int ffd, struct forkfd_info *info, int ffdoptions, struct rusage *rusage)
 {
     siginfo_t si;
@@ -926,14 +926,20 @@ qt_feature("lttng" PRIVATE
     AUTODETECT OFF
     CONDITION LINUX AND LTTNGUST_FOUND
     ENABLE INPUT_trace STREQUAL 'lttng' OR ( INPUT_trace STREQUAL 'yes' AND LINUX )
-    DISABLE INPUT_trace STREQUAL 'etw' OR INPUT_trace STREQUAL 'no'
+    DISABLE INPUT_trace STREQUAL 'etw' OR INPUT_trace STREQUAL 'ctf' OR INPUT_trace STREQUAL 'no'
 )
 qt_feature("etw" PRIVATE
     LABEL "ETW"
     AUTODETECT OFF
     CONDITION WIN32
     ENABLE INPUT_trace STREQUAL 'etw' OR ( INPUT_trace STREQUAL 'yes' AND WIN32 )
-    DISABLE INPUT_trace STREQUAL 'lttng' OR INPUT_trace STREQUAL 'no'
+    DISABLE INPUT_trace STREQUAL 'lttng' OR INPUT_trace STREQUAL 'ctf' OR INPUT_trace STREQUAL 'no'
+)
+qt_feature("ctf" PRIVATE
+    LABEL "CTF ring buffer"
+    AUTODETECT OFF
+    ENABLE INPUT_trace STREQUAL 'ctf'
+    DISABLE INPUT_trace STREQUAL 'etw' OR INPUT_trace STREQUAL 'lttng' OR INPUT_trace STREQUAL 'no'
 )
 qt_feature("win32_system_libs"
     LABEL "Windows System Libraries"
@@ -958,7 +964,7 @@ qt_configure_add_summary_entry(ARGS "system-libb2")
 qt_configure_add_summary_entry(ARGS "mimetype-database")
 qt_configure_add_summary_entry(
     TYPE "firstAvailableFeature"
-    ARGS "etw lttng"
+    ARGS "etw lttng ctf"
     MESSAGE "Tracing backend"
 )
 qt_configure_add_summary_section(NAME "Logging backends")
@@ -55,3 +55,14 @@ static const auto matcher = qMakeStaticByteArrayMatcher("needle");
 //! [1]
 static const auto matcher = qMakeStaticByteArrayMatcher("needle");
 //! [1]
+
+//! [2]
+const QMultiByteArrayMatcher matcher({ "GET", "POST", "HTTP/1.1" });
+qsizetype needle = -1;
+qsizetype pos = matcher.indexIn("POST /index.html HTTP/1.1", 0, &needle);
+// pos == 0, needle == 1
+
+for (const QMultiByteArrayMatcher::Match &match : matcher.matches("GET / HTTP/1.1"))
+    qDebug() << match.position << match.needleIndex;
+// prints "0 0" and "6 2"
+//! [2]
@@ -355,4 +355,14 @@ QString wildcard = QRegularExpression::wildcardToRegularExpression("*.jpeg");
     ("", "day", "month", "year", "", "name")
 //! [33]
 
+{
+//! [34]
+QRegularExpressionSet rules({ QStringLiteral("connection (refused|reset)"),
+                              QStringLiteral("disk \\w+ full"),
+                              QStringLiteral("timeout after \\d+ ms") });
+const QList<qsizetype> matching = rules.matchingPatterns(u"error: disk /var full");
+// matching == { 1 }
+//! [34]
+}
+
 }
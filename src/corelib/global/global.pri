@@ -18,6 +18,7 @@ HEADERS +=  \
         global/qglobalstatic.h \
         global/qlibraryinfo.h \
         global/qlogging.h \
+        global/qbinarylog_p.h \
         global/qtypeinfo.h \
         global/qsysinfo.h \
         global/qisenum.h \
@@ -39,6 +40,7 @@ SOURCES += \
         global/qfloat16.cpp \
         global/qoperatingsystemversion.cpp \
         global/qlogging.cpp \
+        global/qbinarylog.cpp \
         global/qrandom.cpp \
         global/qsimd.cpp \
         global/qhooks.cpp
@@ -114,6 +116,11 @@ qtConfig(slog2): \
 qtConfig(journald): \
     QMAKE_USE_PRIVATE += journald
 
+qtConfig(ctf) {
+    HEADERS += global/qctf_p.h
+    SOURCES += global/qctf.cpp
+}
+
 gcc:ltcg {
     versiontagging_compiler.commands = $$QMAKE_CXX -c $(CXXFLAGS) $(INCPATH)
 
@@ -0,0 +1,426 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qbinarylog_p.h"
+
+#include "qcoreapplication.h"
+#include "qdatetime.h"
+#include "qdeadlinetimer.h"
+#include "qendian.h"
+#include "qfileinfo.h"
+
+#include <atomic>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \internal
+    \class QBinaryLogWriter
+    \inmodule QtCore
+
+    QBinaryLogWriter is the sink behind the \c QT_LOGGING_BINARY_FILE
+    environment variable. Instead of formatting messages with the message
+    pattern, it appends compact binary records to a memory-mapped file:
+    category, file and function names are interned and referenced by id, and
+    timestamps are stored as varint deltas. The qbinlog2json tool, or
+    QBinaryLogReader, turns the records back into text.
+
+    The file is created with its full size and mapped shared, so records that
+    were written survive a crash of the process. When the file is full, it is
+    renamed with a \c .1 suffix, older files are shifted up to the configured
+    count, and a new file is started. Each file is self-contained.
+
+    A lock file next to the log keeps other processes from rotating or
+    truncating it while it is written; they log to a file named after their
+    process id instead, such as \c{log.bin-1234}. So does a child created
+    with fork(), which must not write to the mapping it shares with its
+    parent: childAfterFork() makes the next write() start a file of its own.
+*/
+
+static void appendVarint(QByteArray *out, quint64 value)
+{
+    while (value >= 0x80) {
+        out->append(char(value | 0x80));
+        value >>= 7;
+    }
+    out->append(char(value));
+}
+
+static void appendSignedVarint(QByteArray *out, qint64 value)
+{
+    appendVarint(out, (quint64(value) << 1) ^ quint64(value >> 63));
+}
+
+static bool readVarint(const uchar *&p, const uchar *end, quint64 *value)
+{
+    quint64 result = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7) {
+        const uchar byte = *p++;
+        result |= quint64(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool readSignedVarint(const uchar *&p, const uchar *end, qint64 *value)
+{
+    quint64 v;
+    if (!readVarint(p, end, &v))
+        return false;
+    *value = qint64(v >> 1) ^ -qint64(v & 1);
+    return true;
+}
+
+QBinaryLogWriter::QBinaryLogWriter(const QString &fileName, qint64 fileSize, int fileCount)
+    : baseName(fileName),
+      lockFile(new QLockFile(fileName + QLatin1String(".lock"))),
+      file(fileName),
+      capacity(qMax(fileSize, qint64(4096))),
+      fileCount(qMax(fileCount, 1))
+{
+    // The file is ours for as long as we write to it. If another process
+    // is logging to it, leave its log alone and write to one of our own.
+    lockFile->setStaleLockTime(0);
+    if (!lockFile->tryLock(0)) {
+        file.setFileName(fileName + QLatin1Char('-')
+                         + QString::number(QCoreApplication::applicationPid()));
+    }
+
+    // keep the log of the previous run
+    if (QFileInfo(file.fileName()).size() > 0)
+        rotateFiles();
+    open();
+}
+
+QBinaryLogWriter::~QBinaryLogWriter()
+{
+    if (forked)
+        detach();
+    else
+        close();
+}
+
+bool QBinaryLogWriter::open()
+{
+    if (!file.open(QIODevice::ReadWrite | QIODevice::Truncate) || !file.resize(capacity))
+        return false;
+    data = file.map(0, capacity);
+    if (!data) {
+        file.close();
+        return false;
+    }
+
+    QBinaryLog::Header header;
+    memcpy(header.magic, QBinaryLog::Magic, sizeof header.magic);
+    header.version = qToLittleEndian(QBinaryLog::Version);
+    header.headerSize = qToLittleEndian(quint32(sizeof header));
+    header.pid = qToLittleEndian(QCoreApplication::applicationPid());
+    header.startWallClockMSecs = qToLittleEndian(QDateTime::currentMSecsSinceEpoch());
+    lastMonotonicNSecs = QDeadlineTimer::current(Qt::PreciseTimer).deadlineNSecs();
+    header.startMonotonicNSecs = qToLittleEndian(lastMonotonicNSecs);
+    header.sequence = qToLittleEndian(sequence);
+    header.reserved = 0;
+    memcpy(data, &header, sizeof header);
+
+    used = sizeof header;
+    strings.clear();
+    nextStringId = 1;
+    return true;
+}
+
+void QBinaryLogWriter::close()
+{
+    if (!data)
+        return;
+    file.unmap(data);
+    data = nullptr;
+    file.resize(used);
+    file.close();
+}
+
+// Lets go of the file of the parent process without changing it.
+void QBinaryLogWriter::detach()
+{
+    if (data) {
+        file.unmap(data);
+        data = nullptr;
+    }
+    file.close();
+    (void)lockFile.release();   // unlocking would remove the lock of the parent
+}
+
+/*!
+    \internal
+    Prepares the writer for use in the child process after fork(). The writer
+    must have been locked with prepareFork() before the fork.
+*/
+void QBinaryLogWriter::childAfterFork()
+{
+    forked = true;
+    mutex.unlock();
+}
+
+void QBinaryLogWriter::rotateFiles()
+{
+    const QString name = file.fileName();
+    if (fileCount <= 1)
+        return;     // open() truncates the file
+
+    const auto rotated = [&name](int n) {
+        return name + QLatin1Char('.') + QString::number(n);
+    };
+    QFile::remove(rotated(fileCount - 1));
+    for (int i = fileCount - 2; i > 0; --i)
+        QFile::rename(rotated(i), rotated(i + 1));
+    QFile::rename(name, rotated(1));
+}
+
+quint32 QBinaryLogWriter::intern(const char *str, QList<PendingString> *pending,
+                                 QByteArray *out) const
+{
+    if (!str)
+        return 0;
+
+    // strings are keyed by address, which is stable for string literals;
+    // the comparison catches buffers that were reused for other contents
+    const auto it = strings.constFind(str);
+    if (it != strings.constEnd() && qstrcmp(it->value, str) == 0)
+        return it->id;
+    for (const PendingString &p : qAsConst(*pending)) {
+        if (p.key == str)
+            return p.string.id;
+    }
+
+    const quint32 id = nextStringId + quint32(pending->size());
+    const QByteArray value(str);
+    pending->append({ str, { id, value } });
+
+    QByteArray payload;
+    appendVarint(&payload, id);
+    payload.append(value);
+    out->append(char(QBinaryLog::StringRecord));
+    appendVarint(out, quint64(payload.size()));
+    out->append(payload);
+    return id;
+}
+
+/*!
+    \internal
+    Appends a record for \a message. Returns \c false if the log is not open,
+    or if the record does not fit into a file of the configured size.
+*/
+bool QBinaryLogWriter::write(QtMsgType type, const QMessageLogContext &context,
+                             const QString &message, qint64 monotonicNSecs, qint64 threadId)
+{
+    const QByteArray text = message.toUtf8();
+
+    QMutexLocker locker(&mutex);
+    if (Q_UNLIKELY(forked)) {
+        // not done in childAfterFork(), which may run where only
+        // async-signal-safe functions are allowed
+        forked = false;
+        detach();
+        file.setFileName(baseName + QLatin1Char('-')
+                         + QString::number(QCoreApplication::applicationPid()));
+        sequence = 0;
+        if (QFileInfo(file.fileName()).size() > 0)
+            rotateFiles();
+        open();
+    }
+    if (!data)
+        return false;
+
+    QByteArray out;
+    QList<PendingString> pending;
+    for (int attempt = 0; ; ++attempt) {
+        out.clear();
+        pending.clear();
+        const quint32 category = intern(context.category, &pending, &out);
+        const quint32 fileId = intern(context.file, &pending, &out);
+        const quint32 function = intern(context.function, &pending, &out);
+
+        QByteArray payload;
+        payload.append(char(type));
+        appendSignedVarint(&payload, monotonicNSecs - lastMonotonicNSecs);
+        appendVarint(&payload, quint64(threadId));
+        appendVarint(&payload, category);
+        appendVarint(&payload, fileId);
+        appendVarint(&payload, function);
+        appendSignedVarint(&payload, context.line);
+        payload.append(text);
+        out.append(char(QBinaryLog::MessageRecord));
+        appendVarint(&out, quint64(payload.size()));
+        out.append(payload);
+
+        if (used + out.size() <= capacity)
+            break;
+        if (attempt > 0 || qint64(sizeof(QBinaryLog::Header)) + out.size() > capacity)
+            return false;       // larger than a whole file
+
+        close();
+        rotateFiles();
+        ++sequence;
+        if (!open())
+            return false;
+    }
+
+    // publish the first type byte last, so that a concurrent or post-mortem
+    // reader never sees a partially written record
+    uchar *p = data + used;
+    memcpy(p + 1, out.constData() + 1, size_t(out.size() - 1));
+    std::atomic_thread_fence(std::memory_order_release);
+    *p = uchar(out.at(0));
+    used += out.size();
+
+    lastMonotonicNSecs = monotonicNSecs;
+    nextStringId += quint32(pending.size());
+    for (PendingString &added : pending)
+        strings.insert(added.key, std::move(added.string));
+    return true;
+}
+
+/*!
+    \internal
+    \class QBinaryLogReader
+    \inmodule QtCore
+
+    Decodes the records of a file written by QBinaryLogWriter.
+*/
+QBinaryLogReader::QBinaryLogReader(const QByteArray &data)
+    : data(data)
+{
+    if (size_t(data.size()) < sizeof header) {
+        fail(QStringLiteral("File too short"));
+        return;
+    }
+    memcpy(&header, data.constData(), sizeof header);
+    if (memcmp(header.magic, QBinaryLog::Magic, sizeof header.magic) != 0) {
+        fail(QStringLiteral("Not a Qt binary log"));
+        return;
+    }
+    header.version = qFromLittleEndian(header.version);
+    header.headerSize = qFromLittleEndian(header.headerSize);
+    header.pid = qFromLittleEndian(header.pid);
+    header.startWallClockMSecs = qFromLittleEndian(header.startWallClockMSecs);
+    header.startMonotonicNSecs = qFromLittleEndian(header.startMonotonicNSecs);
+    header.sequence = qFromLittleEndian(header.sequence);
+    if (header.version != QBinaryLog::Version) {
+        fail(QStringLiteral("Unsupported version %1").arg(header.version));
+        return;
+    }
+    if (header.headerSize < sizeof header || header.headerSize > quint32(data.size())) {
+        fail(QStringLiteral("Invalid header size"));
+        return;
+    }
+    offset = header.headerSize;
+    lastMonotonicNSecs = header.startMonotonicNSecs;
+}
+
+bool QBinaryLogReader::fail(const QString &message)
+{
+    error = message;
+    offset = data.size();
+    return false;
+}
+
+bool QBinaryLogReader::atEnd() const
+{
+    return offset >= data.size() || data.at(offset) == char(QBinaryLog::EndOfData);
+}
+
+/*!
+    \internal
+    Reads the next message into \a message. Returns \c false at the end of the
+    data or if the data is corrupt, in which case errorString() is set.
+*/
+bool QBinaryLogReader::readNext(QBinaryLog::Message *message)
+{
+    const uchar *begin = reinterpret_cast<const uchar *>(data.constData());
+    const uchar *end = begin + data.size();
+
+    while (!atEnd()) {
+        const uchar *p = begin + offset;
+        const quint8 type = *p++;
+        quint64 size;
+        if (!readVarint(p, end, &size) || size > quint64(end - p))
+            return fail(QStringLiteral("Truncated record at offset %1").arg(offset));
+        const uchar *payloadEnd = p + size;
+        offset = payloadEnd - begin;
+
+        if (type == QBinaryLog::StringRecord) {
+            quint64 id;
+            if (!readVarint(p, payloadEnd, &id))
+                return fail(QStringLiteral("Corrupt string record"));
+            strings.insert(quint32(id), QByteArray(reinterpret_cast<const char *>(p),
+                                                   payloadEnd - p));
+        } else if (type == QBinaryLog::MessageRecord) {
+            if (p == payloadEnd)
+                return fail(QStringLiteral("Corrupt message record"));
+            message->type = QtMsgType(*p++);
+            qint64 delta, line;
+            quint64 thread, category, file, function;
+            if (!readSignedVarint(p, payloadEnd, &delta) || !readVarint(p, payloadEnd, &thread)
+                    || !readVarint(p, payloadEnd, &category) || !readVarint(p, payloadEnd, &file)
+                    || !readVarint(p, payloadEnd, &function)
+                    || !readSignedVarint(p, payloadEnd, &line)) {
+                return fail(QStringLiteral("Corrupt message record"));
+            }
+            lastMonotonicNSecs += delta;
+            message->monotonicNSecs = lastMonotonicNSecs;
+            message->wallClockMSecs = header.startWallClockMSecs
+                    + (lastMonotonicNSecs - header.startMonotonicNSecs) / (1000 * 1000);
+            message->threadId = qint64(thread);
+            message->line = int(line);
+            message->category = strings.value(quint32(category));
+            message->file = strings.value(quint32(file));
+            message->function = strings.value(quint32(function));
+            message->message = QString::fromUtf8(reinterpret_cast<const char *>(p),
+                                                 payloadEnd - p);
+            return true;
+        }
+        // skip records of unknown types
+    }
+    return false;
+}
+
+QT_END_NAMESPACE
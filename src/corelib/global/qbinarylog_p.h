@@ -0,0 +1,190 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QBINARYLOG_P_H
+#define QBINARYLOG_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of qlogging.cpp and the qbinlog2json tool.  This header file may change
+// from version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qlockfile.h>
+#include <QtCore/qlogging.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qstring.h>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+namespace QBinaryLog {
+
+// All integers are little-endian. A file starts with a Header, followed by
+// records that each consist of a RecordType byte, the payload size as a
+// varint and the payload. A RecordType of EndOfData (zero) terminates the
+// file; the writer publishes the type byte of a record last.
+static constexpr char Magic[8] = { 'Q', 'T', 'B', 'I', 'N', 'L', 'O', 'G' };
+static constexpr quint32 Version = 1;
+
+struct Header
+{
+    char magic[8];
+    quint32 version;
+    quint32 headerSize;
+    qint64 pid;
+    qint64 startWallClockMSecs;
+    qint64 startMonotonicNSecs;
+    quint32 sequence;               // number of rotations since the process started
+    quint32 reserved;
+};
+static_assert(sizeof(Header) == 48, "QBinaryLog::Header must not have padding");
+
+enum RecordType : quint8 {
+    EndOfData = 0,
+    StringRecord = 1,               // id, then the bytes of an interned string
+    MessageRecord = 2               // type, time delta, thread, category, file,
+                                    // function, line, then the UTF-8 message
+};
+
+struct Message
+{
+    QtMsgType type = QtDebugMsg;
+    qint64 monotonicNSecs = 0;
+    qint64 wallClockMSecs = 0;
+    qint64 threadId = 0;
+    int line = 0;
+    QByteArray category;
+    QByteArray file;
+    QByteArray function;
+    QString message;
+};
+
+} // namespace QBinaryLog
+
+class Q_AUTOTEST_EXPORT QBinaryLogWriter
+{
+public:
+    QBinaryLogWriter(const QString &fileName, qint64 fileSize, int fileCount);
+    ~QBinaryLogWriter();
+
+    bool isOpen() const { return data != nullptr; }
+    bool write(QtMsgType type, const QMessageLogContext &context, const QString &message,
+               qint64 monotonicNSecs, qint64 threadId);
+
+    // to be called around fork(), see pthread_atfork()
+    void prepareFork() { mutex.lock(); }
+    void parentAfterFork() { mutex.unlock(); }
+    void childAfterFork();
+
+private:
+    Q_DISABLE_COPY(QBinaryLogWriter)
+
+    struct InternedString
+    {
+        quint32 id;
+        QByteArray value;
+    };
+    struct PendingString
+    {
+        const char *key;
+        InternedString string;
+    };
+
+    bool open();
+    void close();
+    void detach();
+    void rotateFiles();
+    quint32 intern(const char *str, QList<PendingString> *pending, QByteArray *out) const;
+
+    QMutex mutex;
+    QString baseName;
+    std::unique_ptr<QLockFile> lockFile;
+    QFile file;
+    uchar *data = nullptr;
+    qint64 capacity;
+    qint64 used = 0;
+    int fileCount;
+    quint32 sequence = 0;
+    qint64 lastMonotonicNSecs = 0;
+    quint32 nextStringId = 1;
+    bool forked = false;
+    QHash<const char *, InternedString> strings;
+};
+
+class Q_CORE_EXPORT QBinaryLogReader
+{
+public:
+    explicit QBinaryLogReader(const QByteArray &data);
+
+    bool isValid() const { return errorString().isEmpty(); }
+    QString errorString() const { return error; }
+    bool atEnd() const;
+
+    qint64 pid() const { return header.pid; }
+    quint32 sequence() const { return header.sequence; }
+
+    bool readNext(QBinaryLog::Message *message);
+
+private:
+    bool fail(const QString &message);
+
+    QByteArray data;
+    QBinaryLog::Header header = {};
+    qsizetype offset = 0;
+    qint64 lastMonotonicNSecs = 0;
+    QHash<quint32, QByteArray> strings;
+    QString error;
+};
+
+QT_END_NAMESPACE
+
+#endif // QBINARYLOG_P_H
@@ -0,0 +1,531 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qctf_p.h"
+
+#include "qcoreapplication.h"
+#include "qdir.h"
+#include "qfile.h"
+#include "qlist.h"
+#include "qmutex.h"
+#include "qthread.h"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#if defined(Q_OS_LINUX)
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+constexpr quint32 CtfMagic = 0xc1fc1fc1;
+constexpr qsizetype DefaultBufferSize = 1024 * 1024;
+constexpr qsizetype PacketSize = 64 * 1024;
+constexpr qsizetype MinimumPacketCount = 2;
+constexpr qsizetype EventHeaderSize = sizeof(quint32) + sizeof(quint64);
+
+// packet.header (magic, stream_id) followed by the seven 64-bit fields of
+// the stream's packet.context, see metadata() below
+constexpr qsizetype PacketHeaderSize = 2 * sizeof(quint32) + 7 * sizeof(quint64);
+
+quint64 monotonicTime() noexcept
+{
+    using namespace std::chrono;
+    return quint64(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+quint64 currentThreadId() noexcept
+{
+#if defined(Q_OS_LINUX)
+    return quint64(syscall(SYS_gettid));
+#else
+    return quint64(quintptr(QThread::currentThreadId()));
+#endif
+}
+
+bool wildcardMatch(const char *pattern, const char *text) noexcept
+{
+    const char *star = nullptr;
+    const char *resume = nullptr;
+    while (*text) {
+        if (*pattern == '*') {
+            star = pattern++;
+            resume = text;
+        } else if (*pattern == *text) {
+            ++pattern;
+            ++text;
+        } else if (star) {
+            pattern = star + 1;
+            text = ++resume;
+        } else {
+            return false;
+        }
+    }
+    while (*pattern == '*')
+        ++pattern;
+    return !*pattern;
+}
+
+struct Packet
+{
+    quint64 sequenceNumber = 0;
+    quint64 beginTime = 0;
+    quint64 endTime = 0;
+    quint32 size = 0;
+    quint32 eventCount = 0;
+};
+
+// One ring of packets per thread. The mutex is only ever contended while
+// QCtfTracer::writeTrace() copies the packets out.
+struct ThreadBuffer
+{
+    ThreadBuffer(quint32 serial, qsizetype packetCount)
+        : storage(new char[packetCount * PacketSize]), packets(packetCount),
+          threadId(currentThreadId()), serial(serial)
+    {}
+
+    char *packetData(qsizetype index) const { return storage.get() + index * PacketSize; }
+
+    void write(quint32 id, quint64 time, const char *payload, qsizetype size) noexcept
+    {
+        const qsizetype eventSize = EventHeaderSize + size;
+        if (eventSize > PacketSize) {
+            ++discarded;
+            return;
+        }
+
+        Packet *packet = &packets[current];
+        if (packet->size + eventSize > PacketSize) {
+            // switch to the next packet, overwriting the oldest one
+            current = (current + 1) % packets.size();
+            packet = &packets[current];
+            discarded += packet->eventCount;
+            *packet = Packet();
+        }
+        if (packet->eventCount == 0) {
+            packet->sequenceNumber = nextSequenceNumber++;
+            packet->beginTime = time;
+        }
+
+        char *out = packetData(current) + packet->size;
+        memcpy(out, &id, sizeof(id));
+        memcpy(out + sizeof(id), &time, sizeof(time));
+        memcpy(out + EventHeaderSize, payload, size_t(size));
+        packet->size += quint32(eventSize);
+        packet->endTime = time;
+        ++packet->eventCount;
+    }
+
+    // Serializes all recorded packets, oldest first, and empties the ring.
+    QByteArray takeStream()
+    {
+        QByteArray stream;
+        for (size_t i = 1; i <= packets.size(); ++i) {
+            const size_t index = (current + i) % packets.size();
+            Packet &packet = packets[index];
+            if (packet.eventCount == 0)
+                continue;
+
+            const quint32 header[2] = { CtfMagic, 0 };
+            const quint64 bits = quint64(PacketHeaderSize + packet.size) * 8;
+            const quint64 context[7] = {
+                packet.beginTime, packet.endTime, bits, bits,
+                packet.sequenceNumber, discarded, threadId
+            };
+            stream.append(reinterpret_cast<const char *>(header), sizeof(header));
+            stream.append(reinterpret_cast<const char *>(context), sizeof(context));
+            stream.append(packetData(qsizetype(index)), packet.size);
+            packet = Packet();
+        }
+        return stream;
+    }
+
+    QBasicMutex mutex;
+    std::unique_ptr<char[]> storage;
+    std::vector<Packet> packets;
+    size_t current = 0;
+    quint64 nextSequenceNumber = 0;
+    quint64 discarded = 0;
+    const quint64 threadId;
+    const quint32 serial;
+    bool orphaned = false;
+};
+
+struct ThreadBufferHolder
+{
+    ~ThreadBufferHolder()
+    {
+        if (buffer) {
+            QMutexLocker locker(&buffer->mutex);
+            buffer->orphaned = true;
+        }
+    }
+
+    ThreadBuffer *buffer = nullptr;
+};
+
+thread_local ThreadBufferHolder threadBufferHolder;
+
+struct Rule
+{
+    QByteArray pattern;
+    bool enabled;
+};
+
+struct QCtfRegistry
+{
+    QCtfRegistry();
+    ~QCtfRegistry();
+
+    void setRules(const QString &filter);
+    bool isEnabled(const QCtfTracePoint *tracePoint) const;
+    ThreadBuffer *createThreadBuffer();
+    QByteArray metadata() const;
+    bool writeTrace(const QString &directory);
+
+    QBasicMutex mutex;
+    QList<QCtfTracePoint *> tracePoints;
+    QList<Rule> rules;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    qsizetype packetCount = DefaultBufferSize / PacketSize;
+    quint32 nextSerial = 0;
+    quint64 clockOffset = 0;
+    QString outputDirectory;
+};
+
+Q_GLOBAL_STATIC(QCtfRegistry, ctfRegistry)
+
+QCtfRegistry::QCtfRegistry()
+{
+    using namespace std::chrono;
+    const quint64 realTime =
+            quint64(duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count());
+    const quint64 monotonic = monotonicTime();
+    clockOffset = realTime > monotonic ? realTime - monotonic : 0;
+
+    bool ok = false;
+    const int bufferSize = qEnvironmentVariableIntValue("QT_CTF_BUFFER_SIZE", &ok);
+    if (ok && bufferSize > 0)
+        packetCount = qMax(MinimumPacketCount, bufferSize / PacketSize);
+
+    setRules(qEnvironmentVariable("QT_CTF_TRACEPOINTS"));
+    outputDirectory = qEnvironmentVariable("QT_CTF_OUTPUT_DIRECTORY");
+}
+
+QCtfRegistry::~QCtfRegistry()
+{
+    if (!outputDirectory.isEmpty() && !writeTrace(outputDirectory))
+        qWarning("QCtfTracer: cannot write the trace to %s", qPrintable(outputDirectory));
+
+    // Threads that are still running may hold on to their buffers; leak
+    // them rather than pulling the memory out from under those threads.
+    for (auto &buffer : buffers)
+        buffer.release();
+}
+
+void QCtfRegistry::setRules(const QString &filter)
+{
+    rules.clear();
+    const auto patterns = QStringView{filter}.split(QLatin1Char(','), Qt::SkipEmptyParts);
+    for (QStringView pattern : patterns) {
+        pattern = pattern.trimmed();
+        const bool enabled = !pattern.startsWith(QLatin1Char('-'));
+        if (!enabled)
+            pattern = pattern.mid(1);
+        if (!pattern.isEmpty())
+            rules.append({ pattern.toLatin1(), enabled });
+    }
+}
+
+bool QCtfRegistry::isEnabled(const QCtfTracePoint *tracePoint) const
+{
+    const QByteArray fullName = QByteArray(tracePoint->provider) + ':' + tracePoint->name;
+    bool enabled = false;
+    for (const Rule &rule : rules) {
+        // patterns without a provider apply to all providers
+        const char *name = rule.pattern.contains(':') ? fullName.constData() : tracePoint->name;
+        if (wildcardMatch(rule.pattern.constData(), name))
+            enabled = rule.enabled;
+    }
+    return enabled;
+}
+
+ThreadBuffer *QCtfRegistry::createThreadBuffer()
+{
+    QMutexLocker locker(&mutex);
+    buffers.push_back(std::make_unique<ThreadBuffer>(nextSerial++, packetCount));
+    return buffers.back().get();
+}
+
+static void appendIntegerType(QByteArray &out, const QCtfTracePointField &field, int base)
+{
+    out += "integer { size = " + QByteArray::number(field.size * 8)
+         + "; align = 8; signed = " + (field.isSigned ? "true" : "false");
+    if (field.isText)
+        out += "; encoding = UTF8";
+    out += "; base = " + QByteArray::number(base) + "; }";
+}
+
+static void appendField(QByteArray &out, const QCtfTracePointField &field)
+{
+    const QByteArray name = QByteArray("_") + field.name;
+    out += "\t\t";
+    switch (field.type) {
+    case QCtfTracePointField::Integer:
+        appendIntegerType(out, field, 10);
+        out += ' ' + name;
+        break;
+    case QCtfTracePointField::IntegerHex:
+        appendIntegerType(out, field, 16);
+        out += ' ' + name;
+        break;
+    case QCtfTracePointField::Float:
+        out += field.size == sizeof(float)
+                ? "floating_point { exp_dig = 8; mant_dig = 24; align = 8; } "
+                : "floating_point { exp_dig = 11; mant_dig = 53; align = 8; } ";
+        out += name;
+        break;
+    case QCtfTracePointField::String:
+        out += "string { encoding = UTF8; } " + name;
+        break;
+    case QCtfTracePointField::Sequence:
+        out += "uint32_t _" + name + "_length;\n\t\t";
+        appendIntegerType(out, field, 10);
+        out += ' ' + name + "[_" + name + "_length]";
+        break;
+    case QCtfTracePointField::Array:
+        appendIntegerType(out, field, 10);
+        out += ' ' + name + '[' + QByteArray::number(field.arrayLength) + ']';
+        break;
+    }
+    out += ";\n";
+}
+
+QByteArray QCtfRegistry::metadata() const
+{
+    QByteArray out = "/* CTF 1.8 */\n\n"
+            "typealias integer { size = 32; align = 8; signed = false; } := uint32_t;\n"
+            "typealias integer { size = 64; align = 8; signed = false; } := uint64_t;\n\n"
+            "trace {\n"
+            "\tmajor = 1;\n"
+            "\tminor = 8;\n"
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+            "\tbyte_order = le;\n"
+#else
+            "\tbyte_order = be;\n"
+#endif
+            "\tpacket.header := struct {\n"
+            "\t\tuint32_t magic;\n"
+            "\t\tuint32_t stream_id;\n"
+            "\t};\n"
+            "};\n\n"
+            "env {\n"
+            "\tdomain = \"ust\";\n"
+            "\ttracer_name = \"qt\";\n";
+    out += "\tvpid = " + QByteArray::number(QCoreApplication::applicationPid()) + ";\n"
+           "};\n\n"
+           "clock {\n"
+           "\tname = monotonic;\n"
+           "\tfreq = 1000000000;\n"
+           "\toffset_s = " + QByteArray::number(clockOffset / 1000000000) + ";\n"
+           "\toffset = " + QByteArray::number(clockOffset % 1000000000) + ";\n"
+           "};\n\n"
+           "typealias integer { size = 64; align = 8; signed = false; map = clock.monotonic.value; }"
+           " := uint64_clock_monotonic_t;\n\n"
+           "stream {\n"
+           "\tid = 0;\n"
+           "\tpacket.context := struct {\n"
+           "\t\tuint64_clock_monotonic_t timestamp_begin;\n"
+           "\t\tuint64_clock_monotonic_t timestamp_end;\n"
+           "\t\tuint64_t content_size;\n"
+           "\t\tuint64_t packet_size;\n"
+           "\t\tuint64_t packet_seq_num;\n"
+           "\t\tuint64_t events_discarded;\n"
+           "\t\tuint64_t tid;\n"
+           "\t};\n"
+           "\tevent.header := struct {\n"
+           "\t\tuint32_t id;\n"
+           "\t\tuint64_clock_monotonic_t timestamp;\n"
+           "\t};\n"
+           "};\n";
+
+    // tracepoint ids are their index in the registration order
+    for (qsizetype id = 0; id < tracePoints.size(); ++id) {
+        const QCtfTracePoint *tracePoint = tracePoints.at(id);
+        out += "\nevent {\n"
+               "\tname = \"" + QByteArray(tracePoint->provider) + ':' + tracePoint->name + "\";\n"
+               "\tid = " + QByteArray::number(id) + ";\n"
+               "\tstream_id = 0;\n"
+               "\tfields := struct {\n";
+        for (quint32 i = 0; i < tracePoint->fieldCount; ++i)
+            appendField(out, tracePoint->fields[i]);
+        out += "\t};\n"
+               "};\n";
+    }
+    return out;
+}
+
+bool QCtfRegistry::writeTrace(const QString &directory)
+{
+    // Collect everything under the lock, but write without it: the file I/O
+    // passes tracepoints itself, which may need to register or to create a
+    // buffer for this thread.
+    QByteArray text;
+    QList<std::pair<quint32, QByteArray>> streams;
+    {
+        QMutexLocker locker(&mutex);
+        text = metadata();
+        for (auto it = buffers.begin(); it != buffers.end(); ) {
+            ThreadBuffer *buffer = it->get();
+            QMutexLocker bufferLocker(&buffer->mutex);
+            QByteArray stream = buffer->takeStream();
+            const bool orphaned = buffer->orphaned;
+            bufferLocker.unlock();
+
+            if (!stream.isEmpty())
+                streams.append({ buffer->serial, std::move(stream) });
+            if (orphaned)
+                it = buffers.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    const QDir dir(directory);
+    if (!dir.mkpath(QStringLiteral(".")))
+        return false;
+
+    QFile metadataFile(dir.filePath(QStringLiteral("metadata")));
+    if (!metadataFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    bool ok = metadataFile.write(text) == text.size();
+
+    for (const auto &stream : qAsConst(streams)) {
+        QFile file(dir.filePath(QLatin1String("stream_") + QString::number(stream.first)));
+        ok = file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+                && file.write(stream.second) == stream.second.size() && ok;
+    }
+    return ok;
+}
+
+ThreadBuffer *currentThreadBuffer()
+{
+    ThreadBufferHolder &holder = threadBufferHolder;
+    if (Q_UNLIKELY(!holder.buffer)) {
+        QCtfRegistry *registry = ctfRegistry();
+        if (!registry)
+            return nullptr;
+        holder.buffer = registry->createThreadBuffer();
+    }
+    return holder.buffer;
+}
+
+} // unnamed namespace
+
+bool QCtfTracePoint::registerTracePoint() noexcept
+{
+    QCtfRegistry *registry = ctfRegistry();
+    if (!registry)
+        return false;
+
+    QMutexLocker locker(&registry->mutex);
+    if (state.loadRelaxed() == Unregistered) {
+        id = quint32(registry->tracePoints.size());
+        registry->tracePoints.append(this);
+        state.storeRelease(registry->isEnabled(this) ? Enabled : Disabled);
+    }
+    return state.loadRelaxed() == Enabled;
+}
+
+/*!
+    \internal
+
+    Enables the tracepoints matching \a filter and disables all others.
+    The syntax is the same as for the QT_CTF_TRACEPOINTS environment variable.
+*/
+void QCtfTracer::setTracePointFilter(const QString &filter)
+{
+    QCtfRegistry *registry = ctfRegistry();
+    if (!registry)
+        return;
+
+    QMutexLocker locker(&registry->mutex);
+    registry->setRules(filter);
+    for (QCtfTracePoint *tracePoint : qAsConst(registry->tracePoints)) {
+        tracePoint->state.storeRelease(registry->isEnabled(tracePoint)
+                                       ? QCtfTracePoint::Enabled : QCtfTracePoint::Disabled);
+    }
+}
+
+/*!
+    \internal
+
+    Writes the events recorded since the last call to \a directory as a CTF
+    trace and empties the ring buffers. Returns \c true on success.
+*/
+bool QCtfTracer::writeTrace(const QString &directory)
+{
+    QCtfRegistry *registry = ctfRegistry();
+    return registry && registry->writeTrace(directory);
+}
+
+void QCtfTracer::writeEvent(QCtfTracePoint *tracePoint, const char *payload, qsizetype size) noexcept
+{
+    // Q_UNCONDITIONAL_TRACE can get here before the tracepoint was registered
+    if (Q_UNLIKELY(tracePoint->state.loadAcquire() == QCtfTracePoint::Unregistered))
+        tracePoint->registerTracePoint();
+    if (Q_UNLIKELY(tracePoint->state.loadAcquire() == QCtfTracePoint::Unregistered))
+        return;
+
+    const quint64 time = monotonicTime();
+    ThreadBuffer *buffer = currentThreadBuffer();
+    if (Q_UNLIKELY(!buffer || ctfRegistry.isDestroyed()))
+        return;
+
+    QMutexLocker locker(&buffer->mutex);
+    buffer->write(tracePoint->id, time, payload, size);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,228 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QCTF_P_H
+#define QCTF_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the tracepoint headers generated by tracegen.  This header file may
+// change from version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <cstring>
+#include <type_traits>
+
+QT_REQUIRE_CONFIG(ctf);
+
+QT_BEGIN_NAMESPACE
+
+/*
+ * Runtime support for the "ctf" tracegen backend.
+ *
+ * Every tracepoint becomes a QCtfTracePoint describing its provider, name
+ * and payload layout. Events are serialized by QCtfEventWriter into a
+ * per-thread ring of fixed size packets that already use the CTF 1.8
+ * binary layout, so QCtfTracer::writeTrace() only has to prepend the packet
+ * headers and emit the TSDL metadata; the result can be opened with
+ * babeltrace or Trace Compass like any LTTng userspace trace.
+ *
+ * Nothing is recorded until tracepoints are enabled, either with the
+ * QT_CTF_TRACEPOINTS environment variable or with
+ * QCtfTracer::setTracePointFilter(). Both take a comma separated list of
+ * "provider:name" patterns; '*' matches any sequence of characters and a
+ * leading '-' disables the matching tracepoints again. The last matching
+ * pattern wins. For instance:
+ *
+ *     QT_CTF_TRACEPOINTS="qtcore:*,-qtcore:QEvent_*,qtgui:QPainter_*"
+ *
+ * QT_CTF_BUFFER_SIZE sets the size of each thread's ring buffer in bytes
+ * (default 1 MiB). When QT_CTF_OUTPUT_DIRECTORY is set, the recorded trace
+ * is written to that directory when QtCore is unloaded.
+ */
+
+struct QCtfTracePointField
+{
+    enum Type : quint8 {
+        Integer,
+        IntegerHex,
+        Float,
+        String,
+        Sequence,
+        Array
+    };
+
+    const char *name;
+    Type type;
+    quint8 size;            // size of one element, in bytes
+    bool isSigned;
+    bool isText;            // char elements are decoded as UTF-8
+    quint32 arrayLength;
+
+    template <typename T>
+    static constexpr QCtfTracePointField make(const char *name, Type type,
+                                              quint32 arrayLength = 0) noexcept
+    {
+        using U = std::remove_cv_t<std::remove_reference_t<T>>;
+        return { name, type,
+                 quint8(type == Float && sizeof(U) > sizeof(double) ? sizeof(double) : sizeof(U)),
+                 std::is_signed<U>::value, std::is_same<U, char>::value, arrayLength };
+    }
+};
+
+class QCtfTracePoint
+{
+public:
+    enum State {
+        Unregistered,
+        Disabled,
+        Enabled
+    };
+
+    constexpr QCtfTracePoint(const char *provider, const char *name,
+                             const QCtfTracePointField *fields, quint32 fieldCount) noexcept
+        : provider(provider), name(name), fields(fields), fieldCount(fieldCount)
+    {}
+
+    bool isEnabled() noexcept
+    {
+        const int s = state.loadAcquire();
+        if (Q_LIKELY(s == Disabled))
+            return false;
+        if (s == Enabled)
+            return true;
+        return registerTracePoint();
+    }
+
+    const char * const provider;
+    const char * const name;
+    const QCtfTracePointField * const fields;
+    const quint32 fieldCount;
+
+private:
+    Q_CORE_EXPORT bool registerTracePoint() noexcept;
+
+    friend class QCtfTracer;
+    QAtomicInt state;
+    quint32 id = 0;
+};
+
+class Q_CORE_EXPORT QCtfTracer
+{
+public:
+    static void setTracePointFilter(const QString &filter);
+    static bool writeTrace(const QString &directory);
+
+private:
+    friend class QCtfEventWriter;
+    static void writeEvent(QCtfTracePoint *tracePoint, const char *payload, qsizetype size) noexcept;
+};
+
+class QCtfEventWriter
+{
+public:
+    template <typename T>
+    void writeValue(T value)
+    {
+        static_assert(std::is_arithmetic<T>::value, "Only arithmetic types can be written as values");
+        append(&value, sizeof(value));
+    }
+
+    void writeFloat(float value) { writeValue(value); }
+    void writeFloat(double value) { writeValue(value); }
+    void writeFloat(long double value) { writeValue(double(value)); }
+
+    void writePointer(const void *pointer) { writeValue(quintptr(pointer)); }
+
+    void writeString(const char *string)
+    {
+        if (!string)
+            string = "";
+        append(string, qsizetype(std::strlen(string)) + 1);
+    }
+    void writeString(const QByteArray &string)
+    {
+        const qsizetype length = qstrnlen(string.constData(), string.size());
+        append(string.constData(), length);
+        append("", 1);
+    }
+    void writeString(const QString &string) { writeString(string.toUtf8()); }
+
+    template <typename T>
+    void writeArray(const T *data, quint32 count)
+    {
+        append(data, qsizetype(count) * qsizetype(sizeof(T)));
+    }
+
+    template <typename T>
+    void writeSequence(const T *data, qsizetype count)
+    {
+        writeValue(quint32(count));
+        writeArray(data, quint32(count));
+    }
+
+    void commit(QCtfTracePoint *tracePoint) noexcept
+    {
+        QCtfTracer::writeEvent(tracePoint, payload.constData(), payload.size());
+    }
+
+private:
+    void append(const void *data, qsizetype size)
+    {
+        payload.append(static_cast<const char *>(data), size);
+    }
+
+    QVarLengthArray<char, 256> payload;
+};
+
+QT_END_NAMESPACE
+
+#endif // QCTF_P_H
@@ -43,7 +43,7 @@ QT_BEGIN_NAMESPACE
 
 // Only add to the end, and bump version if you do.
 quintptr Q_CORE_EXPORT qtHookData[] = {
-    3, // hook data version
+    4, // hook data version
     QHooks::LastHookIndex, // size of qtHookData
     QT_VERSION,
 
@@ -67,7 +67,27 @@ quintptr Q_CORE_EXPORT qtHookData[] = {
     // The required sizes and offsets are tested in tests/auto/other/toolsupport.
     // When this fails and the change was intentional, adjust the test and
     // adjust this value here.
-    20
+    21,
+
+    // EventDequeued, void(*)(QObject*, QEvent*, qint64), called by
+    // QCoreApplication::sendPostedEvents() right before a posted event is
+    // delivered. The last argument is the time in nanoseconds the event spent
+    // in the queue. Events are only timestamped while this hook is set, so
+    // events posted before it was installed are not reported.
+    0,
+
+    // EventNotifyBegin, void(*)(QObject*, QEvent*), called for every event
+    // delivered through QCoreApplication::notifyInternal2() before the
+    // receiver or any event filter sees it.
+    0,
+
+    // EventNotifyEnd, void(*)(QObject*, QEvent*), called after the delivery
+    // announced by EventNotifyBegin has finished, also when it is left by an
+    // exception. It is only called if EventNotifyBegin was set when the
+    // delivery started, and it is the callback that was set at that time that
+    // gets called. Note: the receiver may already have been destroyed by its
+    // event handler, so it must not be dereferenced.
+    0
 };
 
 static_assert(QHooks::LastHookIndex == sizeof(qtHookData) / sizeof(qtHookData[0]));
@@ -56,6 +56,7 @@
 
 QT_BEGIN_NAMESPACE
 
+class QEvent;
 class QObject;
 
 namespace QHooks {
@@ -68,12 +69,18 @@ enum HookIndex {
     RemoveQObject = 4,
     Startup = 5,
     TypeInformationVersion = 6,
+    EventDequeued = 7,
+    EventNotifyBegin = 8,
+    EventNotifyEnd = 9,
     LastHookIndex
 };
 
 typedef void(*AddQObjectCallback)(QObject*);
 typedef void(*RemoveQObjectCallback)(QObject*);
 typedef void(*StartupCallback)();
+typedef void(*EventDequeuedCallback)(QObject*, QEvent*, qint64);
+typedef void(*EventNotifyBeginCallback)(QObject*, QEvent*);
+typedef void(*EventNotifyEndCallback)(QObject*, QEvent*);
 
 }
 
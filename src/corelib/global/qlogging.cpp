@@ -157,6 +157,21 @@ static QT_PREPEND_NAMESPACE(qint64) qt_gettid()
 #  include <cxxabi.h>
 #  include <execinfo.h>
 #endif
+
+#if QT_CONFIG(thread) && defined(Q_COMPILER_THREAD_LOCAL)
+#  define QLOGGING_HAVE_ASYNC
+#  include "qwaitcondition.h"
+#  include <atomic>
+#  ifdef Q_OS_UNIX
+#    include <pthread.h>
+#  endif
+#endif
+
+#include "qdeadlinetimer.h"
+#include "qbinarylog_p.h"
+#ifdef Q_OS_UNIX
+#  include <pthread.h>
+#endif
 #endif // !QT_BOOTSTRAPPED
 
 #include <cstdlib>
@@ -1069,6 +1084,26 @@ static const char emptyTokenC[] = "";
 
 static const char defaultPattern[] = "%{if-category}%{category}: %{endif}%{message}";
 
+#ifdef QLOGGING_HAVE_ASYNC
+// Where and when a message was logged, if it is formatted later on a
+// different thread. Set by the asynchronous writer while it dispatches a
+// message and used by qFormatLogMessage() in place of the current values.
+struct QMessageLogOrigin
+{
+    qint64 monotonicNSecs;
+    qint64 wallClockMSecs;
+    qint64 threadId;
+    QThread *thread;
+};
+static thread_local const QMessageLogOrigin *currentLogOrigin = nullptr;
+
+// set if the message pattern can only be formatted on the calling thread
+static QBasicAtomicInt patternNeedsCallerThread = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+// set while the asynchronous writer dispatches a batch of messages
+static thread_local QByteArray *stderrBatch = nullptr;
+#endif
+
 
 struct QMessagePattern {
     QMessagePattern();
@@ -1267,6 +1302,10 @@ void QMessagePattern::setPattern(const QString &pattern)
 
     literals.reset(new std::unique_ptr<const char[]>[literalsVar.size() + 1]);
     std::move(literalsVar.begin(), literalsVar.end(), &literals[0]);
+
+#if defined(QLOGGING_HAVE_ASYNC) && defined(QLOGGING_HAVE_BACKTRACE)
+    patternNeedsCallerThread.storeRelaxed(!backtraceArgs.isEmpty());
+#endif
 }
 
 #if defined(QLOGGING_HAVE_BACKTRACE) && !defined(QT_BOOTSTRAPPED)
@@ -1437,9 +1476,19 @@ QString qFormatLogMessage(QtMsgType type, const QMessageLogContext &context, con
             message.append(QCoreApplication::applicationName());
         } else if (token == threadidTokenC) {
             // print the TID as decimal
+#ifdef QLOGGING_HAVE_ASYNC
+            if (currentLogOrigin)
+                message.append(QString::number(currentLogOrigin->threadId));
+            else
+#endif
             message.append(QString::number(qt_gettid()));
         } else if (token == qthreadptrTokenC) {
             message.append(QLatin1String("0x"));
+#ifdef QLOGGING_HAVE_ASYNC
+            if (currentLogOrigin)
+                message.append(QString::number(qlonglong(currentLogOrigin->thread), 16));
+            else
+#endif
             message.append(QString::number(qlonglong(QThread::currentThread()->currentThread()), 16));
 #ifdef QLOGGING_HAVE_BACKTRACE
         } else if (token == backtraceTokenC) {
@@ -1452,6 +1501,12 @@ QString qFormatLogMessage(QtMsgType type, const QMessageLogContext &context, con
             timeArgsIdx++;
             if (timeFormat == QLatin1String("process")) {
                     quint64 ms = pattern->timer.elapsed();
+#ifdef QLOGGING_HAVE_ASYNC
+                    if (currentLogOrigin) {
+                        ms = currentLogOrigin->monotonicNSecs / (1000 * 1000)
+                                - pattern->timer.msecsSinceReference();
+                    }
+#endif
                     message.append(QString::asprintf("%6d.%03d", uint(ms / 1000), uint(ms % 1000)));
             } else if (timeFormat ==  QLatin1String("boot")) {
                 // just print the milliseconds since the elapsed timer reference
@@ -1459,12 +1514,22 @@ QString qFormatLogMessage(QtMsgType type, const QMessageLogContext &context, con
                 QElapsedTimer now;
                 now.start();
                 uint ms = now.msecsSinceReference();
+#ifdef QLOGGING_HAVE_ASYNC
+                if (currentLogOrigin)
+                    ms = currentLogOrigin->monotonicNSecs / (1000 * 1000);
+#endif
                 message.append(QString::asprintf("%6d.%03d", uint(ms / 1000), uint(ms % 1000)));
 #if QT_CONFIG(datestring)
-            } else if (timeFormat.isEmpty()) {
-                    message.append(QDateTime::currentDateTime().toString(Qt::ISODate));
             } else {
-                message.append(QDateTime::currentDateTime().toString(timeFormat));
+                QDateTime now = QDateTime::currentDateTime();
+#ifdef QLOGGING_HAVE_ASYNC
+                if (currentLogOrigin)
+                    now = QDateTime::fromMSecsSinceEpoch(currentLogOrigin->wallClockMSecs);
+#endif
+                if (timeFormat.isEmpty())
+                    message.append(now.toString(Qt::ISODate));
+                else
+                    message.append(now.toString(timeFormat));
 #endif // QT_CONFIG(datestring)
             }
 #endif // !QT_BOOTSTRAPPED
@@ -1498,6 +1563,78 @@ static QBasicAtomicPointer<void (QtMsgType, const QMessageLogContext &, const QS
     // Boostrapped tools always print to stderr, so no need for alternate sinks
 #else
 
+struct QBinaryLogSink
+{
+    QBinaryLogSink()
+        : writer(qEnvironmentVariable("QT_LOGGING_BINARY_FILE"),
+                 qEnvironmentVariableIsSet("QT_LOGGING_BINARY_FILE_SIZE")
+                     ? qgetenv("QT_LOGGING_BINARY_FILE_SIZE").toLongLong()
+                     : 16 * 1024 * 1024,
+                 qEnvironmentVariableIsSet("QT_LOGGING_BINARY_FILE_COUNT")
+                     ? qEnvironmentVariableIntValue("QT_LOGGING_BINARY_FILE_COUNT")
+                     : 4)
+    {
+#ifdef Q_OS_UNIX
+        pthread_atfork(prepareFork, parentAfterFork, childAfterFork);
+#endif
+    }
+    QBinaryLogWriter writer;
+
+#ifdef Q_OS_UNIX
+    static void prepareFork();
+    static void parentAfterFork();
+    static void childAfterFork();
+#endif
+};
+Q_GLOBAL_STATIC(QBinaryLogSink, binaryLogSink)
+
+#ifdef Q_OS_UNIX
+// keep the child from writing to the mapping it shares with the parent
+void QBinaryLogSink::prepareFork()
+{
+    if (QBinaryLogSink *sink = binaryLogSink())
+        sink->writer.prepareFork();
+}
+
+void QBinaryLogSink::parentAfterFork()
+{
+    if (QBinaryLogSink *sink = binaryLogSink())
+        sink->writer.parentAfterFork();
+}
+
+void QBinaryLogSink::childAfterFork()
+{
+    if (QBinaryLogSink *sink = binaryLogSink())
+        sink->writer.childAfterFork();
+}
+#endif
+
+static bool isBinaryLogEnabled()
+{
+    static const bool enabled = !qEnvironmentVariableIsEmpty("QT_LOGGING_BINARY_FILE");
+    return enabled;
+}
+
+static bool binary_log_message_handler(QtMsgType type, const QMessageLogContext &context,
+                                       const QString &message)
+{
+    if (!isBinaryLogEnabled())
+        return false;
+    QBinaryLogSink *sink = binaryLogSink();
+    if (!sink || !sink->writer.isOpen())
+        return false;
+
+#ifdef QLOGGING_HAVE_ASYNC
+    if (currentLogOrigin) {
+        return sink->writer.write(type, context, message, currentLogOrigin->monotonicNSecs,
+                                  currentLogOrigin->threadId);
+    }
+#endif
+    return sink->writer.write(type, context, message,
+                              QDeadlineTimer::current(Qt::PreciseTimer).deadlineNSecs(),
+                              qt_gettid());
+}
+
 #if QT_CONFIG(slog2)
 #ifndef QT_LOG_CODE
 #define QT_LOG_CODE 9000
@@ -1733,6 +1870,14 @@ static void stderr_message_handler(QtMsgType type, const QMessageLogContext &con
     if (formattedMessage.isNull())
         return;
 
+#ifdef QLOGGING_HAVE_ASYNC
+    if (stderrBatch) {
+        stderrBatch->append(formattedMessage.toLocal8Bit());
+        stderrBatch->append('\n');
+        return;
+    }
+#endif
+
     fprintf(stderr, "%s\n", formattedMessage.toLocal8Bit().constData());
     fflush(stderr);
 }
@@ -1752,6 +1897,10 @@ static void qDefaultMessageHandler(QtMsgType type, const QMessageLogContext &con
     // a list of sinks.
 
 #if !defined(QT_BOOTSTRAPPED)
+    // the binary log replaces all text output
+    if (binary_log_message_handler(type, context, message))
+        return;
+
 # if defined(Q_OS_WIN)
     handledStderr |= win_message_handler(type, context, message);
 # elif QT_CONFIG(slog2)
@@ -1796,6 +1945,449 @@ static bool grabMessageHandler() { return true; }
 static void ungrabMessageHandler() { }
 #endif // (Q_COMPILER_THREAD_LOCAL)
 
+// ------------------------- Asynchronous output ----------------------------
+
+#ifdef QLOGGING_HAVE_ASYNC
+
+/*
+    In asynchronous mode, qt_message_print() only captures the message and
+    the context it was logged in and appends it to a ring buffer owned by the
+    calling thread. Each ring has a single producer and a single consumer, so
+    neither side takes a lock. A writer thread drains all rings, orders the
+    messages by time and passes them to the message handler in batches,
+    setting currentLogOrigin so that qFormatLogMessage() reports the thread
+    and time of the caller.
+
+    The rings are bounded. When one is full, debug and info messages are
+    dropped, whereas warnings and more severe messages wait for the writer
+    to make room, for at most FullRingTimeout milliseconds. Once such a
+    wait timed out, they are dropped as well until the writer drains the
+    ring again. The writer reports how many messages were dropped. Fatal
+    messages are never queued: the queue is flushed and they are handled
+    synchronously.
+
+    A child process forked while the writer is running has no writer thread
+    and may have inherited a locked mutex, so it logs synchronously and
+    never touches the queue again.
+*/
+
+static QBasicAtomicInt asyncLoggingMode = Q_BASIC_ATOMIC_INITIALIZER(-1);
+static bool asyncLoggingForked = false;
+
+struct QAsyncMessage
+{
+    QtMsgType type = QtDebugMsg;
+    int line = 0;
+    QByteArray strings;         // category, file and function, '\0'-separated
+    QString message;
+    QMessageLogOrigin origin = {};
+};
+
+class QAsyncMessageRing
+{
+public:
+    static constexpr quint32 Capacity = 1024;
+
+    QAsyncMessageRing() : entries(new QAsyncMessage[Capacity]) {}
+
+    // producer side
+    bool push(QAsyncMessage &&message)
+    {
+        const quint32 t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == Capacity)
+            return false;
+        entries[t % Capacity] = std::move(message);
+        tail.store(t + 1);      // sequentially consistent, see QAsyncMessageLogger::wait()
+        return true;
+    }
+
+    // consumer side
+    bool pop(QAsyncMessage *message)
+    {
+        const quint32 h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire))
+            return false;
+        *message = std::move(entries[h % Capacity]);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool isEmpty() const { return head.load() == tail.load(); }
+
+    std::unique_ptr<QAsyncMessage[]> entries;
+    std::atomic<quint32> head = { 0 };
+    std::atomic<quint32> tail = { 0 };
+    std::atomic<quint32> dropped = { 0 };
+    std::atomic<bool> stalled = { false };    // a wait for room timed out
+    std::atomic<bool> orphaned = { false };   // the owning thread has exited
+    qint64 threadId = 0;
+    QThread *thread = nullptr;
+};
+
+// Detaches the calling thread's ring when the thread exits; the writer
+// deletes it once it has been drained.
+struct QAsyncMessageRingRef
+{
+    QAsyncMessageRing *ring = nullptr;
+    ~QAsyncMessageRingRef()
+    {
+        if (ring)
+            ring->orphaned.store(true, std::memory_order_release);
+        ring = nullptr;     // messages logged from later destructors use a new ring
+    }
+};
+static thread_local QAsyncMessageRingRef localMessageRing;
+static thread_local bool isMessageWriterThread = false;
+
+class QAsyncMessageLogger
+{
+public:
+    QAsyncMessageLogger()
+    {
+        // make sure the pattern and the binary log outlive us, we need them
+        // to flush at exit
+        qMessagePattern();
+        if (isBinaryLogEnabled())
+            binaryLogSink();
+    }
+    ~QAsyncMessageLogger();
+
+    bool enqueue(QtMsgType type, const QMessageLogContext &context, const QString &message);
+    void flush();
+
+    static constexpr int FullRingTimeout = 1000;
+
+private:
+    class Writer : public QThread
+    {
+    public:
+        explicit Writer(QAsyncMessageLogger *logger) : logger(logger) {}
+        void run() override { logger->run(); }
+        QAsyncMessageLogger *logger;
+    };
+
+    QAsyncMessageRing *registerRing();
+    void wake();
+    void run();
+    bool wait();
+    quint32 drain(std::vector<QAsyncMessage> *batch);
+    void dispatch(std::vector<QAsyncMessage> *batch, quint32 dropped);
+
+    QMutex mutex;
+    QWaitCondition writerCondition;
+    QWaitCondition flushCondition;
+    QList<QAsyncMessageRing *> rings;
+    std::unique_ptr<Writer> writer;
+    QWaitCondition roomCondition;
+    int waitingProducers = 0;
+    std::atomic<bool> writerSleeping = { false };
+    quint64 flushRequested = 0;
+    quint64 flushCompleted = 0;
+    std::atomic<bool> quit = { false };
+};
+
+Q_GLOBAL_STATIC(QAsyncMessageLogger, asyncMessageLogger)
+
+static bool isAsyncLoggingEnabled()
+{
+    int mode = asyncLoggingMode.loadRelaxed();
+    if (Q_UNLIKELY(mode < 0)) {
+        const int fromEnvironment = qEnvironmentVariableIntValue("QT_LOGGING_ASYNC") ? 1 : 0;
+        if (asyncLoggingMode.testAndSetRelaxed(-1, fromEnvironment, mode))
+            mode = fromEnvironment;
+    }
+    return mode;
+}
+
+#ifdef Q_OS_UNIX
+static void resetAsyncLoggingInChild()
+{
+    asyncLoggingMode.storeRelaxed(0);
+    asyncLoggingForked = true;
+}
+#endif
+
+QAsyncMessageLogger::~QAsyncMessageLogger()
+{
+    if (asyncLoggingForked) {
+        // the writer thread does not exist in this process
+        (void)writer.release();
+        return;
+    }
+    {
+        const auto locker = qt_scoped_lock(mutex);
+        quit.store(true);
+        writerCondition.wakeOne();
+    }
+    if (writer)
+        writer->wait();
+
+    // rings of threads that are still running are leaked on purpose, their
+    // thread_local reference may still be used
+    for (QAsyncMessageRing *ring : qAsConst(rings)) {
+        if (ring->orphaned.load(std::memory_order_acquire))
+            delete ring;
+    }
+}
+
+QAsyncMessageRing *QAsyncMessageLogger::registerRing()
+{
+    auto ring = new QAsyncMessageRing;
+    ring->threadId = qt_gettid();
+    ring->thread = QThread::currentThread();
+
+    Writer *newWriter = nullptr;
+    {
+        const auto locker = qt_scoped_lock(mutex);
+        rings.append(ring);
+        if (!writer) {
+            writer.reset(new Writer(this));
+            newWriter = writer.get();
+#ifdef Q_OS_UNIX
+            pthread_atfork(nullptr, nullptr, resetAsyncLoggingInChild);
+#endif
+        }
+    }
+    // not under the lock, starting the thread may log something
+    if (newWriter) {
+        newWriter->setObjectName(QStringLiteral("Qt message logger"));
+        newWriter->start();
+    }
+    return ring;
+}
+
+bool QAsyncMessageLogger::enqueue(QtMsgType type, const QMessageLogContext &context,
+                                  const QString &message)
+{
+    if (Q_UNLIKELY(isMessageWriterThread || asyncLoggingForked
+                   || quit.load(std::memory_order_relaxed))) {
+        return false;
+    }
+    QAsyncMessageRing *ring = localMessageRing.ring;
+    if (Q_UNLIKELY(!ring))
+        ring = localMessageRing.ring = registerRing();
+
+    QAsyncMessage entry;
+    entry.type = type;
+    entry.line = context.line;
+    const auto appendString = [&entry](const char *str) {
+        if (str)
+            entry.strings.append(str);
+        entry.strings.append('\0');
+    };
+    appendString(context.category);
+    appendString(context.file);
+    appendString(context.function);
+    entry.message = message;
+    entry.origin.monotonicNSecs = QDeadlineTimer::current(Qt::PreciseTimer).deadlineNSecs();
+    entry.origin.wallClockMSecs = QDateTime::currentMSecsSinceEpoch();
+    entry.origin.threadId = ring->threadId;
+    entry.origin.thread = ring->thread;
+
+    if (Q_LIKELY(ring->push(std::move(entry)))) {
+        if (writerSleeping.load())
+            wake();
+        return true;
+    }
+
+    bool queued = false;
+    if (type != QtDebugMsg && type != QtInfoMsg && !ring->stalled.load(std::memory_order_relaxed)) {
+        const QDeadlineTimer deadline(FullRingTimeout);
+        const auto locker = qt_scoped_lock(mutex);
+        ++waitingProducers;
+        writerCondition.wakeOne();
+        while (!(queued = ring->push(std::move(entry))) && !quit.load(std::memory_order_relaxed)) {
+            if (!roomCondition.wait(&mutex, deadline)) {
+                ring->stalled.store(true, std::memory_order_relaxed);
+                break;
+            }
+        }
+        --waitingProducers;
+        // the writer may have gone back to sleep since it made room
+        writerCondition.wakeOne();
+    } else {
+        wake();
+    }
+    if (!queued)
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void QAsyncMessageLogger::wake()
+{
+    const auto locker = qt_scoped_lock(mutex);
+    writerCondition.wakeOne();
+}
+
+/*!
+    \internal
+    Blocks until all messages queued by the calling thread before the call
+    have been handled.
+*/
+void QAsyncMessageLogger::flush()
+{
+    if (isMessageWriterThread || asyncLoggingForked)
+        return;
+    auto locker = qt_unique_lock(mutex);
+    if (!writer)
+        return;
+    const quint64 request = ++flushRequested;
+    writerCondition.wakeOne();
+    while (flushCompleted < request && !writer->isFinished())
+        flushCondition.wait(&mutex, QDeadlineTimer(100));
+}
+
+// Called with the mutex locked. Returns false when the writer should exit.
+bool QAsyncMessageLogger::wait()
+{
+    for (;;) {
+        bool pending = false;
+        for (QAsyncMessageRing *ring : qAsConst(rings))
+            pending = pending || !ring->isEmpty() || ring->dropped.load(std::memory_order_relaxed);
+        if (pending || flushCompleted < flushRequested)
+            return true;
+        if (quit)
+            return false;
+
+        // a producer checks writerSleeping after publishing its message, so
+        // either it sees the flag and wakes us, or we see the message above
+        writerSleeping.store(true);
+        bool recheck = false;
+        for (QAsyncMessageRing *ring : qAsConst(rings))
+            recheck = recheck || !ring->isEmpty();
+        if (!recheck)
+            writerCondition.wait(&mutex);
+        writerSleeping.store(false);
+    }
+}
+
+// Moves all queued messages to \a batch and returns the number of dropped ones.
+quint32 QAsyncMessageLogger::drain(std::vector<QAsyncMessage> *batch)
+{
+    QList<QAsyncMessageRing *> snapshot;
+    {
+        const auto locker = qt_scoped_lock(mutex);
+        snapshot = rings;
+    }
+
+    quint32 dropped = 0;
+    QAsyncMessage message;
+    QList<QAsyncMessageRing *> finished;
+    for (QAsyncMessageRing *ring : qAsConst(snapshot)) {
+        // check before popping, so that nothing pushed before the thread
+        // exited can be left behind
+        const bool orphaned = ring->orphaned.load(std::memory_order_acquire);
+        while (ring->pop(&message))
+            batch->push_back(std::move(message));
+        ring->stalled.store(false, std::memory_order_relaxed);
+        dropped += ring->dropped.exchange(0, std::memory_order_relaxed);
+        if (orphaned)
+            finished.append(ring);
+    }
+
+    const auto locker = qt_scoped_lock(mutex);
+    for (QAsyncMessageRing *ring : qAsConst(finished)) {
+        rings.removeOne(ring);
+        delete ring;
+    }
+    if (waitingProducers)
+        roomCondition.wakeAll();
+    return dropped;
+}
+
+void QAsyncMessageLogger::dispatch(std::vector<QAsyncMessage> *batch, quint32 dropped)
+{
+    // messages of different threads are only ordered among each other here
+    std::stable_sort(batch->begin(), batch->end(),
+                     [](const QAsyncMessage &lhs, const QAsyncMessage &rhs) {
+        return lhs.origin.monotonicNSecs < rhs.origin.monotonicNSecs;
+    });
+
+    QByteArray output;
+    stderrBatch = &output;
+    for (const QAsyncMessage &entry : qAsConst(*batch)) {
+        const char *category = entry.strings.constData();
+        const char *file = category + qstrlen(category) + 1;
+        const char *function = file + qstrlen(file) + 1;
+        QMessageLogContext context(*file ? file : nullptr, entry.line,
+                                   *function ? function : nullptr,
+                                   *category ? category : nullptr);
+
+        currentLogOrigin = &entry.origin;
+        if (grabMessageHandler()) {
+            const auto ungrab = qScopeGuard([]{ ungrabMessageHandler(); });
+            auto msgHandler = messageHandler.loadAcquire();
+            (msgHandler ? msgHandler : qDefaultMessageHandler)(entry.type, context, entry.message);
+        }
+        currentLogOrigin = nullptr;
+    }
+
+    if (dropped) {
+        const QString message = QString::fromLatin1("%1 messages were dropped "
+                                                     "because the message queue was full")
+                .arg(dropped);
+        if (grabMessageHandler()) {
+            const auto ungrab = qScopeGuard([]{ ungrabMessageHandler(); });
+            auto msgHandler = messageHandler.loadAcquire();
+            (msgHandler ? msgHandler : qDefaultMessageHandler)(QtWarningMsg, QMessageLogContext(),
+                                                               message);
+        }
+    }
+
+    stderrBatch = nullptr;
+    if (!output.isEmpty()) {
+        fwrite(output.constData(), 1, size_t(output.size()), stderr);
+        fflush(stderr);
+    }
+    batch->clear();
+}
+
+void QAsyncMessageLogger::run()
+{
+    isMessageWriterThread = true;
+    std::vector<QAsyncMessage> batch;
+    for (;;) {
+        quint64 flushing;
+        {
+            const auto locker = qt_scoped_lock(mutex);
+            if (!wait())
+                break;
+            flushing = flushRequested;
+        }
+
+        const quint32 dropped = drain(&batch);
+        dispatch(&batch, dropped);
+
+        const auto locker = qt_scoped_lock(mutex);
+        if (flushing > flushCompleted) {
+            flushCompleted = flushing;
+            flushCondition.wakeAll();
+        }
+    }
+}
+
+static bool qt_message_enqueue(QtMsgType msgType, const QMessageLogContext &context,
+                               const QString &message)
+{
+    if (msgType == QtFatalMsg || !isAsyncLoggingEnabled()
+            || patternNeedsCallerThread.loadRelaxed()) {
+        return false;
+    }
+    QAsyncMessageLogger *logger = asyncMessageLogger();
+    return logger && logger->enqueue(msgType, context, message);
+}
+
+static void qt_message_flush()
+{
+    if (asyncMessageLogger.exists() && !asyncMessageLogger.isDestroyed())
+        asyncMessageLogger()->flush();
+}
+
+#else
+static void qt_message_flush() { }
+#endif // QLOGGING_HAVE_ASYNC
+
+
 static void qt_message_print(QtMsgType msgType, const QMessageLogContext &context, const QString &message)
 {
 #ifndef QT_BOOTSTRAPPED
@@ -1808,6 +2400,14 @@ static void qt_message_print(QtMsgType msgType, const QMessageLogContext &contex
                 return;
         }
     }
+
+#ifdef QLOGGING_HAVE_ASYNC
+    if (qt_message_enqueue(msgType, context, message))
+        return;
+    // fatal messages are never queued, write what was logged before them
+    if (msgType == QtFatalMsg)
+        qt_message_flush();
+#endif
 #endif
 
     // prevent recursion in case the message handler generates messages
@@ -1835,6 +2435,9 @@ static void qt_message_print(const QString &message)
 
 static void qt_message_fatal(QtMsgType, const QMessageLogContext &context, const QString &message)
 {
+    // a warning or critical message made fatal may still be queued
+    qt_message_flush();
+
 #if defined(Q_CC_MSVC) && defined(QT_DEBUG) && defined(_DEBUG) && defined(_CRT_ERROR)
     wchar_t contextFileL[256];
     // we probably should let the compiler do this for us, by declaring QMessageLogContext::file to
@@ -2041,6 +2644,8 @@ void qErrnoWarning(int code, const char *msg, ...)
 
 QtMessageHandler qInstallMessageHandler(QtMessageHandler h)
 {
+    // queued messages go to the handler that was installed when they were logged
+    qt_message_flush();
     const auto old = messageHandler.fetchAndStoreOrdered(h);
     if (old)
         return old;
@@ -2050,12 +2655,65 @@ QtMessageHandler qInstallMessageHandler(QtMessageHandler h)
 
 void qSetMessagePattern(const QString &pattern)
 {
+    qt_message_flush();
     const auto locker = qt_scoped_lock(QMessagePattern::mutex);
 
     if (!qMessagePattern()->fromEnvironment)
         qMessagePattern()->setPattern(pattern);
 }
 
+/*!
+    \relates <QtGlobal>
+    \since 6.0
+
+    Enables asynchronous message output if \a enable is \c true, or disables
+    it otherwise.
+
+    By default, qDebug(), qWarning() and the other logging functions pass each
+    message to the message handler on the calling thread and return once it
+    has been written. In asynchronous mode, they only capture the message and
+    the context it was logged in and return; a dedicated thread formats the
+    messages and passes them to the message handler in batches. This keeps
+    threads that log a lot from serializing on the output.
+
+    The message pattern placeholders for the thread and the time refer to the
+    thread that logged the message and the time it did so. A message handler
+    installed with qInstallMessageHandler(), however, is called on the
+    writer thread, and QThread::currentThread() returns that thread there.
+    Messages of different threads are ordered by the time they were logged.
+
+    Fatal messages, and messages made fatal by \c QT_FATAL_WARNINGS or
+    \c QT_FATAL_CRITICALS, are handled only after all queued messages have
+    been written. The queue is also flushed when the application exits, when
+    the message handler or the message pattern is changed, and when
+    asynchronous output is disabled.
+
+    Each thread queues a bounded number of messages. If a thread logs faster
+    than the messages are written, further debug and info messages are
+    dropped and a warning reports how many were lost, whereas warnings and
+    critical messages wait up to a second for room before they are dropped
+    as well.
+
+    A child process created with \c fork() logs synchronously.
+
+    Asynchronous output can also be enabled by setting the
+    \c QT_LOGGING_ASYNC environment variable to \c 1. It is not used if the
+    message pattern contains \c %{backtrace}, or if Qt was built without
+    thread support.
+
+    \sa qInstallMessageHandler(), qSetMessagePattern()
+*/
+void qSetAsyncMessageLogging(bool enable)
+{
+#ifdef QLOGGING_HAVE_ASYNC
+    if (!enable)
+        qt_message_flush();
+    asyncLoggingMode.storeRelaxed(enable ? 1 : 0);
+#else
+    Q_UNUSED(enable);
+#endif
+}
+
 
 /*!
     Copies context information from \a logContext into this QMessageLogContext.
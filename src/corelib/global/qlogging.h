@@ -192,6 +192,7 @@ typedef void (*QtMessageHandler)(QtMsgType, const QMessageLogContext &, const QS
 Q_CORE_EXPORT QtMessageHandler qInstallMessageHandler(QtMessageHandler);
 
 Q_CORE_EXPORT void qSetMessagePattern(const QString &messagePattern);
+Q_CORE_EXPORT void qSetAsyncMessageLogging(bool enable);
 Q_CORE_EXPORT QString qFormatLogMessage(QtMsgType type, const QMessageLogContext &context,
                                         const QString &buf);
 
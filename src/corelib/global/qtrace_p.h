@@ -79,6 +79,10 @@
  * amounting to a call to TraceLoggingWrite(), whereas Q_TRACE_ENABLED()
  * wraps around TraceLoggingProviderEnabled().
  *
+ * With CTF, events are recorded into per-thread ring buffers inside the
+ * process and written out as a CTF trace on request, without needing a
+ * tracing daemon; see qctf_p.h for how tracepoints are enabled.
+ *
  * A tracepoint provider is defined in a separate file, that follows the
  * following format:
  *
@@ -93,7 +97,7 @@
  *     qcoreapplication_qrect(const QRect &rect)
  *
  * The provider file is then parsed by src/tools/tracegen, which can be
- * switched to output either ETW or LTTNG tracepoint definitions. The provider
+ * switched to output ETW, LTTNG or CTF tracepoint definitions. The provider
  * name is deduced to be basename(provider_file).
  *
  * To use the above (inside qtcore), you need to include
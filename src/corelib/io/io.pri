@@ -20,6 +20,7 @@ HEADERS +=  \
         io/qiodevice_p.h \
         io/qlockfile.h \
         io/qlockfile_p.h \
+        io/qmappedfiledevice.h \
         io/qnoncontiguousbytedevice_p.h \
         io/qtemporarydir.h \
         io/qtemporaryfile.h \
@@ -57,6 +58,7 @@ SOURCES += \
         io/qipaddress.cpp \
         io/qiodevice.cpp \
         io/qlockfile.cpp \
+        io/qmappedfiledevice.cpp \
         io/qnoncontiguousbytedevice.cpp \
         io/qstorageinfo.cpp \
         io/qtemporarydir.cpp \
@@ -79,6 +81,11 @@ SOURCES += \
 
 qtConfig(zstd): QMAKE_USE_PRIVATE += zstd
 
+qtConfig(future) {
+    SOURCES += io/qasyncfile.cpp
+    HEADERS += io/qasyncfile.h
+}
+
 qtConfig(filesystemwatcher) {
     HEADERS += \
         io/qfilesystemwatcher.h \
@@ -120,10 +127,12 @@ qtConfig(processenvironment) {
 
 qtConfig(settings) {
     SOURCES += \
-        io/qsettings.cpp
+        io/qsettings.cpp \
+        io/qsettingsbinarystore.cpp
     HEADERS += \
         io/qsettings.h \
-        io/qsettings_p.h
+        io/qsettings_p.h \
+        io/qsettingsbinarystore_p.h
 
     win32 {
         SOURCES += io/qsettings_win.cpp
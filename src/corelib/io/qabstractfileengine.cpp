@@ -861,6 +861,28 @@ bool QAbstractFileEngine::unmap(uchar *address)
     return extension(UnMapExtension, &options);
 }
 
+/*!
+    \since 6.0
+
+    Applies the access \a hints to the \a size bytes at \a address, which
+    must lie within memory returned by map(). Returns \c true if the hints
+    were applied; otherwise returns \c false.
+
+    This function bases its behavior on calling extension() with
+    AdviseMapExtensionOption. If the engine does not support this extension,
+    false is returned.
+
+    \sa map(), supportsExtension()
+ */
+bool QAbstractFileEngine::adviseMap(uchar *address, qint64 size, QFile::MemoryMapFlags hints)
+{
+    AdviseMapExtensionOption options;
+    options.address = address;
+    options.size = size;
+    options.hints = hints;
+    return extension(AdviseMapExtension, &options);
+}
+
 /*!
     \since 5.10
 
@@ -1206,6 +1228,18 @@ qint64 QAbstractFileEngine::readLine(char *data, qint64 maxlen)
 
    \value UnMapExtension Whether the file engine provides the ability to
    unmap memory that was previously mapped.
+
+   \value AdviseMapExtension Whether the file engine provides the ability to
+   pass access hints for memory that was previously mapped. This value was
+   introduced in Qt 6.0.
+
+   \value ScatterReadExtension Whether the file engine can read into several
+   buffers, filling them in order, with a single call into the operating
+   system. The input is a ScatterReadExtensionOption; the total number of
+   bytes read, or -1 on error, is returned in a ScatterReadExtensionReturn.
+   An engine may still return \c false from extension() if it cannot do so
+   in its current state, in which case nothing has been read. This value was
+   introduced in Qt 6.0.
 */
 
 /*!
@@ -154,6 +154,7 @@ public:
     bool atEnd() const;
     uchar *map(qint64 offset, qint64 size, QFile::MemoryMapFlags flags);
     bool unmap(uchar *ptr);
+    bool adviseMap(uchar *address, qint64 size, QFile::MemoryMapFlags hints);
 
     typedef QAbstractFileEngineIterator Iterator;
     virtual Iterator *beginEntryList(QDir::Filters filters, const QStringList &filterNames);
@@ -170,7 +171,9 @@ public:
         AtEndExtension,
         FastReadLineExtension,
         MapExtension,
-        UnMapExtension
+        UnMapExtension,
+        AdviseMapExtension,
+        ScatterReadExtension
     };
     class ExtensionOption
     {};
@@ -193,6 +196,27 @@ public:
         uchar *address;
     };
 
+    class AdviseMapExtensionOption : public ExtensionOption {
+    public:
+        uchar *address;
+        qint64 size;
+        QFile::MemoryMapFlags hints;
+    };
+
+    class ScatterReadExtensionOption : public ExtensionOption {
+    public:
+        struct Buffer {
+            char *data;
+            qint64 size;
+        };
+        const Buffer *buffers;
+        int count;
+    };
+    class ScatterReadExtensionReturn : public ExtensionReturn {
+    public:
+        qint64 bytesRead;
+    };
+
     virtual bool extension(Extension extension, const ExtensionOption *option = nullptr, ExtensionReturn *output = nullptr);
     virtual bool supportsExtension(Extension extension) const;
 
@@ -0,0 +1,704 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qplatformdefs.h"
+#include "qasyncfile.h"
+
+#include "qfile.h"
+#include "qmutex.h"
+#include "qthread.h"
+#include "qthreadpool.h"
+#include "private/qabstractfileengine_p.h"
+#include "private/qfilesystemengine_p.h"
+
+#if defined(Q_OS_LINUX) && __has_include(<linux/io_uring.h>)
+#  include <linux/io_uring.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <sys/syscall.h>
+#  include <errno.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#  if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register)
+#    define QT_ASYNCFILE_IO_URING
+#  endif
+#endif
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QAsyncFile
+    \inmodule QtCore
+    \since 6.0
+    \brief The QAsyncFile class provides asynchronous reading and writing of whole files.
+
+    \ingroup io
+
+    QAsyncFile performs file I/O without blocking the calling thread. Each
+    function starts the operation and returns a QFuture that finishes once
+    the operation has completed; use QFutureWatcher or the continuations of
+    QFuture to act on the result.
+
+    On Linux, QAsyncFile submits the opening, reading and writing of files to
+    the kernel through io_uring when it is available, so that the operations
+    on many files are batched into few system calls and no thread is blocked
+    while they are in flight. Elsewhere, or when io_uring cannot be used, the
+    operations are run on a thread pool dedicated to file I/O. Setting the
+    \c QT_NO_IO_URING environment variable forces the thread pool.
+
+    Only readAll() with a list of files submits the operations on several
+    files together. read() and write() submit the operations on their file
+    on their own, and copy() always runs on the thread pool.
+
+    Files that are handled by a file engine, such as the Qt resource system,
+    are always read and written on the thread pool.
+
+    \sa QFile, QFuture
+*/
+
+namespace {
+
+enum { IoUringEntries = 64 };
+
+// Blocking implementations, run on the thread pool.
+bool readAllBlocking(const QString &fileName, QByteArray *result)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Unbuffered))
+        return false;
+    *result = file.readAll();
+    return file.error() == QFileDevice::NoError;
+}
+
+qint64 readBlocking(const QString &fileName, char *data, qint64 maxSize, qint64 offset)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Unbuffered))
+        return -1;
+    if (offset && !file.seek(offset))
+        return -1;
+    return file.read(data, maxSize);
+}
+
+qint64 writeBlocking(const QString &fileName, const QByteArray &data)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Unbuffered))
+        return -1;
+    const qint64 written = file.write(data);
+    return written == data.size() ? written : -1;
+}
+
+bool isNativeFile(const QString &fileName)
+{
+    QFileSystemEntry entry(fileName);
+    QFileSystemMetaData data;
+    std::unique_ptr<QAbstractFileEngine> engine(
+            QFileSystemEngine::resolveEntryAndCreateLegacyEngine(entry, data));
+    return !engine;
+}
+
+#ifdef QT_ASYNCFILE_IO_URING
+struct QIoUringRequest
+{
+    enum Kind { ReadAll, Read, Write };
+    enum Stage { Opening, Transferring };
+
+    Kind kind;
+    Stage stage = Opening;
+    int fd = -1;
+    QByteArray path;
+    QByteArray buffer;          // the result of ReadAll, the data of Write
+    char *data = nullptr;       // the caller's buffer for Read
+    qint64 size = 0;            // the number of bytes to transfer
+    qint64 offset = 0;
+    qint64 done = 0;
+    bool sizeKnown = true;      // false when reading up to EOF
+    QFutureInterface<QByteArray> bytesInterface;
+    QFutureInterface<qint64> countInterface;
+
+    char *transferPointer() const
+    { return (kind == Read ? data : const_cast<char *>(buffer.constData())) + done; }
+};
+
+// A single io_uring instance shared by all the QAsyncFile requests. Requests
+// are submitted from any thread under the mutex; the completions are reaped
+// by the thread itself, which advances each request to its next step.
+class QIoUring : public QThread
+{
+public:
+    static QIoUring *create();
+    ~QIoUring();
+
+    void submit(const QList<QIoUringRequest *> &requests);
+
+protected:
+    void run() override;
+
+private:
+    QIoUring() = default;
+    bool setup();
+    void queueLocked(QIoUringRequest *request);
+    void pushLocked(QIoUringRequest *request);
+    void flushLocked();
+    void rejectLocked();
+    void failRejected(QMutexLocker &locker);
+    void advance(QIoUringRequest *request, int result);
+    bool transfer(QIoUringRequest *request);
+    void finish(QIoUringRequest *request, bool ok);
+
+    QMutex mutex;
+    QList<QIoUringRequest *> backlog;
+    QList<QIoUringRequest *> rejected;
+    int active = 0;
+    unsigned unsubmitted = 0;
+
+    int ringFd = -1;
+    unsigned entries = 0;
+    void *sqRing = MAP_FAILED;
+    void *cqRing = MAP_FAILED;
+    size_t sqRingSize = 0;
+    size_t cqRingSize = 0;
+    io_uring_sqe *sqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+    unsigned *sqTail = nullptr;
+    unsigned sqMask = 0;
+    unsigned *sqArray = nullptr;
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    unsigned cqMask = 0;
+    io_uring_cqe *cqes = nullptr;
+};
+
+int qt_io_uring_enter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    return int(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+QIoUring *QIoUring::create()
+{
+    std::unique_ptr<QIoUring> ring(new QIoUring);
+    if (!ring->setup())
+        return nullptr;
+    ring->start();
+    return ring.release();
+}
+
+bool QIoUring::setup()
+{
+    io_uring_params params = {};
+    ringFd = int(syscall(__NR_io_uring_setup, IoUringEntries, &params));
+    if (ringFd < 0)
+        return false;
+
+    // Make sure that the kernel knows all the operations we need
+    // (IORING_OP_OPENAT appeared in Linux 5.6).
+    const unsigned probeOps = 256;
+    const size_t probeSize = sizeof(io_uring_probe) + probeOps * sizeof(io_uring_probe_op);
+    std::unique_ptr<char[]> probeBuffer(new char[probeSize]());
+    io_uring_probe *probe = reinterpret_cast<io_uring_probe *>(probeBuffer.get());
+    if (syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_PROBE, probe, probeOps) < 0)
+        return false;
+    for (unsigned op : { IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_WRITE, IORING_OP_NOP }) {
+        if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED))
+            return false;
+    }
+
+    entries = params.sq_entries;
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap)
+        sqRingSize = cqRingSize = qMax(sqRingSize, cqRingSize);
+
+    sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                  ringFd, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED)
+        return false;
+    if (singleMmap) {
+        cqRing = sqRing;
+    } else {
+        cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ringFd, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED)
+            return false;
+    }
+    void *sqeMap = mmap(nullptr, params.sq_entries * sizeof(io_uring_sqe),
+                        PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd,
+                        IORING_OFF_SQES);
+    if (sqeMap == MAP_FAILED)
+        return false;
+    sqes = static_cast<io_uring_sqe *>(sqeMap);
+
+    char *sq = static_cast<char *>(sqRing);
+    sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sqMask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    char *cq = static_cast<char *>(cqRing);
+    cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cqMask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+    return true;
+}
+
+QIoUring::~QIoUring()
+{
+    if (isRunning()) {
+        // A NOP without a request tells the completion thread to exit.
+        QMutexLocker locker(&mutex);
+        const unsigned tail = *sqTail;
+        const unsigned index = tail & sqMask;
+        io_uring_sqe *sqe = &sqes[index];
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_NOP;
+        sqArray[index] = index;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        ++unsubmitted;
+        flushLocked();
+        failRejected(locker);
+        locker.unlock();
+        wait();
+    }
+    if (sqes != MAP_FAILED)
+        munmap(sqes, entries * sizeof(io_uring_sqe));
+    if (cqRing != MAP_FAILED && cqRing != sqRing)
+        munmap(cqRing, cqRingSize);
+    if (sqRing != MAP_FAILED)
+        munmap(sqRing, sqRingSize);
+    if (ringFd >= 0)
+        ::close(ringFd);
+}
+
+void QIoUring::submit(const QList<QIoUringRequest *> &requests)
+{
+    QMutexLocker locker(&mutex);
+    for (QIoUringRequest *request : requests)
+        queueLocked(request);
+    flushLocked();
+    failRejected(locker);
+}
+
+// Starts the request if a slot is free, otherwise keeps it for later. Each
+// active request has at most one operation in flight, so limiting the number
+// of active requests to the number of entries keeps both rings from
+// overflowing.
+void QIoUring::queueLocked(QIoUringRequest *request)
+{
+    if (active < int(entries)) {
+        ++active;
+        pushLocked(request);
+    } else {
+        backlog.append(request);
+    }
+}
+
+void QIoUring::pushLocked(QIoUringRequest *request)
+{
+    const unsigned tail = *sqTail;
+    const unsigned index = tail & sqMask;
+    io_uring_sqe *sqe = &sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->user_data = quintptr(request);
+
+    if (request->stage == QIoUringRequest::Opening) {
+        sqe->opcode = IORING_OP_OPENAT;
+        sqe->fd = AT_FDCWD;
+        sqe->addr = quintptr(request->path.constData());
+        if (request->kind == QIoUringRequest::Write) {
+            sqe->open_flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+            sqe->len = 0666;
+        } else {
+            sqe->open_flags = O_RDONLY | O_CLOEXEC;
+        }
+    } else {
+        const qint64 remaining = request->size - request->done;
+        sqe->opcode = request->kind == QIoUringRequest::Write ? IORING_OP_WRITE
+                                                              : IORING_OP_READ;
+        sqe->fd = request->fd;
+        sqe->addr = quintptr(request->transferPointer());
+        sqe->len = unsigned(qMin(remaining, qint64(1) << 30));
+        sqe->off = request->offset + request->done;
+    }
+
+    sqArray[index] = index;
+    __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+    ++unsubmitted;
+}
+
+void QIoUring::flushLocked()
+{
+    while (unsubmitted) {
+        const int submitted = qt_io_uring_enter(ringFd, unsubmitted, 0, 0);
+        if (submitted < 0) {
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+                continue;
+            qWarning("QAsyncFile: io_uring_enter failed: %s", qPrintable(qt_error_string(errno)));
+            rejectLocked();
+            return;
+        }
+        unsubmitted -= unsigned(submitted);
+    }
+}
+
+// Takes the operations that the kernel refused back out of the submission
+// ring. It only consumes entries inside io_uring_enter(), which is called
+// with the mutex locked, so they are still ours.
+void QIoUring::rejectLocked()
+{
+    const unsigned tail = *sqTail;
+    const unsigned first = tail - unsubmitted;
+    for (unsigned i = first; i != tail; ++i) {
+        const io_uring_sqe &sqe = sqes[sqArray[i & sqMask]];
+        if (QIoUringRequest *request = reinterpret_cast<QIoUringRequest *>(sqe.user_data))
+            rejected.append(request);
+    }
+    __atomic_store_n(sqTail, first, __ATOMIC_RELEASE);
+    unsubmitted = 0;
+}
+
+// Finishes the rejected requests with an error. That starts requests from the
+// backlog, which are submitted and may be rejected in turn.
+void QIoUring::failRejected(QMutexLocker &locker)
+{
+    while (!rejected.isEmpty()) {
+        const QList<QIoUringRequest *> failed = std::exchange(rejected, {});
+        locker.unlock();
+        for (QIoUringRequest *request : failed)
+            finish(request, false);
+        locker.relock();
+        flushLocked();
+    }
+}
+
+void QIoUring::run()
+{
+    for (;;) {
+        unsigned head = *cqHead;
+        const unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        if (head == tail) {
+            if (qt_io_uring_enter(ringFd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR)
+                return;
+            continue;
+        }
+
+        for (; head != tail; ++head) {
+            const io_uring_cqe &cqe = cqes[head & cqMask];
+            QIoUringRequest *request = reinterpret_cast<QIoUringRequest *>(cqe.user_data);
+            const int result = cqe.res;
+            __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+            if (!request)
+                return;
+            advance(request, result);
+        }
+
+        // Submit the follow-up operations of the whole batch at once.
+        QMutexLocker locker(&mutex);
+        flushLocked();
+        failRejected(locker);
+    }
+}
+
+void QIoUring::advance(QIoUringRequest *request, int result)
+{
+    if (result == -EINTR || result == -EAGAIN) {
+        QMutexLocker locker(&mutex);
+        pushLocked(request);
+        return;
+    }
+    if (result < 0)
+        return finish(request, false);
+
+    if (request->stage == QIoUringRequest::Opening) {
+        request->fd = result;
+        request->stage = QIoUringRequest::Transferring;
+        if (request->kind == QIoUringRequest::ReadAll) {
+            // The size at the time of opening bounds the read, like
+            // QFile::readAll() does; files that do not report a size, such as
+            // those in /proc, are read until EOF.
+            QT_STATBUF st;
+            if (QT_FSTAT(request->fd, &st) != 0)
+                return finish(request, false);
+            request->size = S_ISREG(st.st_mode) ? qint64(st.st_size) : 0;
+            if (request->size <= 0) {
+                request->sizeKnown = false;
+                request->size = 16384;
+            }
+            request->buffer.resize(request->size);
+        }
+    } else if (result == 0) {
+        if (request->kind == QIoUringRequest::Write)
+            return finish(request, false);
+        return finish(request, true);           // EOF
+    } else {
+        request->done += result;
+    }
+
+    if (!transfer(request))
+        finish(request, true);
+}
+
+// Queues the next read or write of the request, or returns false if there is
+// nothing left to transfer.
+bool QIoUring::transfer(QIoUringRequest *request)
+{
+    if (request->done == request->size) {
+        if (request->sizeKnown)
+            return false;
+        request->size *= 2;
+        request->buffer.resize(request->size);
+    }
+    QMutexLocker locker(&mutex);
+    pushLocked(request);
+    return true;
+}
+
+void QIoUring::finish(QIoUringRequest *request, bool ok)
+{
+    if (request->fd >= 0)
+        ::close(request->fd);
+
+    switch (request->kind) {
+    case QIoUringRequest::ReadAll:
+        if (ok) {
+            request->buffer.truncate(request->done);
+            request->bytesInterface.reportResult(request->buffer);
+        } else {
+            request->bytesInterface.reportCanceled();
+        }
+        request->bytesInterface.reportFinished();
+        break;
+    case QIoUringRequest::Read:
+    case QIoUringRequest::Write:
+        if (request->kind == QIoUringRequest::Write)
+            QFileSystemMetaDataCache::invalidate(QFileSystemEntry(QFile::decodeName(request->path)));
+        request->countInterface.reportResult(ok ? request->done : -1);
+        request->countInterface.reportFinished();
+        break;
+    }
+    delete request;
+
+    QMutexLocker locker(&mutex);
+    --active;
+    if (!backlog.isEmpty())
+        queueLocked(backlog.takeFirst());
+}
+#endif // QT_ASYNCFILE_IO_URING
+
+class QAsyncFileBackend
+{
+public:
+    QAsyncFileBackend()
+    {
+#ifdef QT_ASYNCFILE_IO_URING
+        if (!qEnvironmentVariableIsSet("QT_NO_IO_URING"))
+            ring.reset(QIoUring::create());
+#endif
+    }
+
+#ifdef QT_ASYNCFILE_IO_URING
+    std::unique_ptr<QIoUring> ring;
+#endif
+    QThreadPool pool;
+};
+
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(QAsyncFileBackend, asyncFileBackend)
+
+/*!
+    Starts reading the contents of the file \a fileName and returns a future
+    that holds them once the file has been read.
+
+    If the file cannot be opened or read, the future is canceled and holds no
+    result.
+
+    \sa QFile::readAll()
+*/
+QFuture<QByteArray> QAsyncFile::readAll(const QString &fileName)
+{
+    return readAll(QStringList(fileName)).constFirst();
+}
+
+/*!
+    \overload
+
+    Starts reading the contents of each file in \a fileNames and returns a
+    list with one future per file, in the same order. The files are opened and
+    read concurrently; with io_uring the operations on all the files are
+    submitted together, which makes this considerably cheaper than reading
+    the files one by one.
+*/
+QList<QFuture<QByteArray>> QAsyncFile::readAll(const QStringList &fileNames)
+{
+    QList<QFuture<QByteArray>> futures;
+    futures.reserve(fileNames.size());
+    QAsyncFileBackend *backend = asyncFileBackend();
+#ifdef QT_ASYNCFILE_IO_URING
+    QList<QIoUringRequest *> requests;
+#endif
+
+    for (const QString &fileName : fileNames) {
+        QFutureInterface<QByteArray> iface;
+        iface.reportStarted();
+        futures.append(iface.future());
+#ifdef QT_ASYNCFILE_IO_URING
+        if (backend->ring && !fileName.isEmpty() && isNativeFile(fileName)) {
+            QIoUringRequest *request = new QIoUringRequest;
+            request->kind = QIoUringRequest::ReadAll;
+            request->path = QFile::encodeName(fileName);
+            request->bytesInterface = iface;
+            requests.append(request);
+            continue;
+        }
+#endif
+        backend->pool.start([iface, fileName]() mutable {
+            QByteArray data;
+            if (readAllBlocking(fileName, &data))
+                iface.reportResult(data);
+            else
+                iface.reportCanceled();
+            iface.reportFinished();
+        });
+    }
+
+#ifdef QT_ASYNCFILE_IO_URING
+    if (!requests.isEmpty())
+        backend->ring->submit(requests);
+#endif
+    return futures;
+}
+
+/*!
+    Starts reading at most \a maxSize bytes from the file \a fileName, starting
+    at \a offset, into \a data and returns a future that holds the number of
+    bytes read, or -1 if an error occurred.
+
+    \a data must remain valid until the future has finished.
+
+    \sa QIODevice::read()
+*/
+QFuture<qint64> QAsyncFile::read(const QString &fileName, char *data, qint64 maxSize,
+                                 qint64 offset)
+{
+    QFutureInterface<qint64> iface;
+    iface.reportStarted();
+    QFuture<qint64> future = iface.future();
+    QAsyncFileBackend *backend = asyncFileBackend();
+
+#ifdef QT_ASYNCFILE_IO_URING
+    if (backend->ring && !fileName.isEmpty() && maxSize >= 0 && offset >= 0
+            && isNativeFile(fileName)) {
+        QIoUringRequest *request = new QIoUringRequest;
+        request->kind = QIoUringRequest::Read;
+        request->path = QFile::encodeName(fileName);
+        request->data = data;
+        request->size = maxSize;
+        request->offset = offset;
+        request->countInterface = iface;
+        backend->ring->submit({ request });
+        return future;
+    }
+#endif
+
+    backend->pool.start([iface, fileName, data, maxSize, offset]() mutable {
+        iface.reportResult(readBlocking(fileName, data, maxSize, offset));
+        iface.reportFinished();
+    });
+    return future;
+}
+
+/*!
+    Starts replacing the contents of the file \a fileName with \a data,
+    creating the file if it does not exist, and returns a future that holds
+    the number of bytes written, or -1 if an error occurred.
+
+    \sa QIODevice::write()
+*/
+QFuture<qint64> QAsyncFile::write(const QString &fileName, const QByteArray &data)
+{
+    QFutureInterface<qint64> iface;
+    iface.reportStarted();
+    QFuture<qint64> future = iface.future();
+    QAsyncFileBackend *backend = asyncFileBackend();
+
+#ifdef QT_ASYNCFILE_IO_URING
+    if (backend->ring && !fileName.isEmpty() && isNativeFile(fileName)) {
+        QIoUringRequest *request = new QIoUringRequest;
+        request->kind = QIoUringRequest::Write;
+        request->path = QFile::encodeName(fileName);
+        request->buffer = data;
+        request->size = data.size();
+        request->countInterface = iface;
+        backend->ring->submit({ request });
+        return future;
+    }
+#endif
+
+    backend->pool.start([iface, fileName, data]() mutable {
+        iface.reportResult(writeBlocking(fileName, data));
+        iface.reportFinished();
+    });
+    return future;
+}
+
+/*!
+    Starts copying the file \a fileName to \a newName and returns a future
+    that holds \c true if the copy succeeded.
+
+    The copy is done on the thread pool with QFile::copy(), which already
+    lets the kernel copy the data where possible.
+
+    \sa QFile::copy()
+*/
+QFuture<bool> QAsyncFile::copy(const QString &fileName, const QString &newName)
+{
+    QFutureInterface<bool> iface;
+    iface.reportStarted();
+    QFuture<bool> future = iface.future();
+    asyncFileBackend()->pool.start([iface, fileName, newName]() mutable {
+        iface.reportResult(QFile::copy(fileName, newName));
+        iface.reportFinished();
+    });
+    return future;
+}
+
+QT_END_NAMESPACE
@@ -93,9 +93,14 @@
 #include "qdir_p.h"
 #include "qabstractfileengine_p.h"
 
+#include <QtCore/qmutex.h>
 #include <QtCore/qset.h>
 #include <QtCore/qstack.h>
 #include <QtCore/qvariant.h>
+#include <QtCore/qwaitcondition.h>
+#if QT_CONFIG(thread)
+#include <QtCore/qthreadpool.h>
+#endif
 #if QT_CONFIG(regularexpression)
 #include <QtCore/qregularexpression.h>
 #endif
@@ -127,16 +132,22 @@ public:
     QDirIteratorPrivate(const QFileSystemEntry &entry, const QStringList &nameFilters,
                         QDir::Filters filters, QDirIterator::IteratorFlags flags, bool resolveEngine = true);
 
+    void start();
     void advance();
 
     bool entryMatches(const QString & fileName, const QFileInfo &fileInfo);
     void pushDirectory(const QFileInfo &fileInfo);
     void checkAndPushDirectory(const QFileInfo &);
+    bool shouldDescendInto(const QFileInfo &fileInfo) const;
     bool matchesFilters(const QString &fileName, const QFileInfo &fi) const;
 
+    static const QFileSystemEntry &fileEntry(const QFileInfo &fileInfo)
+    { return fileInfo.d_ptr->fileEntry; }
+
     std::unique_ptr<QAbstractFileEngine> engine;
 
     QFileSystemEntry dirEntry;
+    QFileSystemMetaData dirMetaData;
     const QStringList nameFilters;
     const QDir::Filters filters;
     const QDirIterator::IteratorFlags iteratorFlags;
@@ -175,10 +186,16 @@ QDirIteratorPrivate::QDirIteratorPrivate(const QFileSystemEntry &entry, const QS
         nameRegExps.append(re);
     }
 #endif
-    QFileSystemMetaData metaData;
     if (resolveEngine)
-        engine.reset(QFileSystemEngine::resolveEntryAndCreateLegacyEngine(dirEntry, metaData));
-    QFileInfo fileInfo(new QFileInfoPrivate(dirEntry, metaData));
+        engine.reset(QFileSystemEngine::resolveEntryAndCreateLegacyEngine(dirEntry, dirMetaData));
+}
+
+/*!
+    \internal
+*/
+void QDirIteratorPrivate::start()
+{
+    QFileInfo fileInfo(new QFileInfoPrivate(dirEntry, dirMetaData));
 
     // Populate fields for hasNext() and next()
     pushDirectory(fileInfo);
@@ -227,7 +244,11 @@ inline bool QDirIteratorPrivate::entryMatches(const QString & fileName, const QF
 {
     checkAndPushDirectory(fileInfo);
 
-    if (matchesFilters(fileName, fileInfo)) {
+    const bool matches = matchesFilters(fileName, fileInfo);
+    if (!engine)
+        QFileSystemMetaDataCache::insert(fileInfo.d_ptr->fileEntry, fileInfo.d_ptr->metaData);
+
+    if (matches) {
         currentFileInfo = nextFileInfo;
         nextFileInfo = fileInfo;
 
@@ -286,29 +307,38 @@ void QDirIteratorPrivate::advance()
     \internal
  */
 void QDirIteratorPrivate::checkAndPushDirectory(const QFileInfo &fileInfo)
+{
+    if (shouldDescendInto(fileInfo))
+        pushDirectory(fileInfo);
+}
+
+/*!
+    \internal
+ */
+bool QDirIteratorPrivate::shouldDescendInto(const QFileInfo &fileInfo) const
 {
     // If we're doing flat iteration, we're done.
     if (!(iteratorFlags & QDirIterator::Subdirectories))
-        return;
+        return false;
 
     // Never follow non-directory entries
     if (!fileInfo.isDir())
-        return;
+        return false;
 
     // Follow symlinks only when asked
     if (!(iteratorFlags & QDirIterator::FollowSymlinks) && fileInfo.isSymLink())
-        return;
+        return false;
 
     // Never follow . and ..
     QString fileName = fileInfo.fileName();
     if (QLatin1String(".") == fileName || QLatin1String("..") == fileName)
-        return;
+        return false;
 
     // No hidden directories unless requested
     if (!(filters & QDir::AllDirs) && !(filters & QDir::Hidden) && fileInfo.isHidden())
-        return;
+        return false;
 
-    pushDirectory(fileInfo);
+    return true;
 }
 
 /*!
@@ -417,6 +447,7 @@ QDirIterator::QDirIterator(const QDir &dir, IteratorFlags flags)
 {
     const QDirPrivate *other = dir.d_ptr.constData();
     d.reset(new QDirIteratorPrivate(other->dirEntry, other->nameFilters, other->filters, flags, bool(other->fileEngine)));
+    d->start();
 }
 
 /*!
@@ -435,6 +466,7 @@ QDirIterator::QDirIterator(const QDir &dir, IteratorFlags flags)
 QDirIterator::QDirIterator(const QString &path, QDir::Filters filters, IteratorFlags flags)
     : d(new QDirIteratorPrivate(QFileSystemEntry(path), QStringList(), filters, flags))
 {
+    d->start();
 }
 
 /*!
@@ -452,6 +484,7 @@ QDirIterator::QDirIterator(const QString &path, QDir::Filters filters, IteratorF
 QDirIterator::QDirIterator(const QString &path, IteratorFlags flags)
     : d(new QDirIteratorPrivate(QFileSystemEntry(path), QStringList(), QDir::NoFilter, flags))
 {
+    d->start();
 }
 
 /*!
@@ -476,6 +509,7 @@ QDirIterator::QDirIterator(const QString &path, const QStringList &nameFilters,
                            QDir::Filters filters, IteratorFlags flags)
     : d(new QDirIteratorPrivate(QFileSystemEntry(path), nameFilters, filters, flags))
 {
+    d->start();
 }
 
 /*!
@@ -562,4 +596,221 @@ QString QDirIterator::path() const
     return d->dirEntry.filePath();
 }
 
+namespace {
+enum { TraversalBatchSize = 1024 };
+
+#ifndef QT_NO_FILESYSTEMITERATOR
+/*!
+    \internal
+
+    Shared state of a QDirIterator::traverse() call. Workers pop directories
+    off a common stack, list them with QFileSystemIterator and push the
+    subdirectories they find back onto it. The traversal is over once the
+    stack is empty and no worker is still listing a directory.
+
+    QFileInfo caches lazily, so every QFileInfo is only ever touched by the
+    worker that created it until it has been handed out; the stack holds
+    plain QFileSystemEntry objects.
+*/
+class QDirTraversal
+{
+public:
+    typedef std::function<void(const QFileInfoList &)> Handler;
+
+    QDirTraversal(const QDirIteratorPrivate &d, const Handler &handler)
+        : d(d), handler(handler)
+    {
+    }
+
+    void enqueue(const QFileInfo &directory);
+    void run();
+
+private:
+    struct Directory
+    {
+        QFileSystemEntry entry;
+        QString canonicalPath;
+    };
+
+    Directory directoryFor(const QFileInfo &fileInfo) const;
+    void processDirectory(const QFileSystemEntry &dirEntry, QFileInfoList &batch,
+                          QList<Directory> &subdirectories);
+    void flush(QFileInfoList &batch);
+
+    const QDirIteratorPrivate &d;
+    const Handler &handler;
+
+    QMutex mutex;
+    QWaitCondition condition;
+    QList<QFileSystemEntry> pending;
+    int busyWorkers = 0;
+    QDuplicateTracker<QString> visitedLinks;
+
+    QMutex handlerMutex;
+};
+
+QDirTraversal::Directory QDirTraversal::directoryFor(const QFileInfo &fileInfo) const
+{
+    Directory directory;
+#ifdef Q_OS_WIN
+    if (fileInfo.isSymLink())
+        directory.entry = QFileSystemEntry(fileInfo.canonicalFilePath());
+    else
+#endif
+        directory.entry = QDirIteratorPrivate::fileEntry(fileInfo);
+    if (d.iteratorFlags & QDirIterator::FollowSymlinks)
+        directory.canonicalPath = fileInfo.canonicalFilePath();
+    return directory;
+}
+
+void QDirTraversal::enqueue(const QFileInfo &fileInfo)
+{
+    const Directory directory = directoryFor(fileInfo);
+    QMutexLocker locker(&mutex);
+    // Stop link loops
+    if (!directory.canonicalPath.isNull() && visitedLinks.hasSeen(directory.canonicalPath))
+        return;
+    pending.append(directory.entry);
+}
+
+void QDirTraversal::run()
+{
+    QFileInfoList batch;
+    QList<Directory> subdirectories;
+
+    QMutexLocker locker(&mutex);
+    for (;;) {
+        while (pending.isEmpty() && busyWorkers > 0)
+            condition.wait(&mutex);
+        if (pending.isEmpty())
+            break;
+
+        const QFileSystemEntry dirEntry = pending.takeLast();
+        ++busyWorkers;
+        locker.unlock();
+
+        processDirectory(dirEntry, batch, subdirectories);
+
+        locker.relock();
+        --busyWorkers;
+        for (const Directory &subdirectory : qAsConst(subdirectories)) {
+            // Stop link loops
+            if (!subdirectory.canonicalPath.isNull() && visitedLinks.hasSeen(subdirectory.canonicalPath))
+                continue;
+            pending.append(subdirectory.entry);
+        }
+        subdirectories.clear();
+        condition.wakeAll();
+    }
+    locker.unlock();
+
+    flush(batch);
+}
+
+void QDirTraversal::processDirectory(const QFileSystemEntry &dirEntry, QFileInfoList &batch,
+                                     QList<Directory> &subdirectories)
+{
+    QFileSystemIterator it(dirEntry, d.filters, d.nameFilters, d.iteratorFlags);
+    QFileSystemEntry entry;
+    QFileSystemMetaData metaData;
+    while (it.advance(entry, metaData)) {
+#if !defined(Q_OS_WIN)
+        // Stat the entry relative to the open directory while we are at it,
+        // so that neither the filters nor the handler need to look it up by
+        // path again.
+        it.fillCurrentMetaData(metaData);
+#endif
+        QFileSystemMetaDataCache::insert(entry, metaData);
+        QFileInfo fileInfo(new QFileInfoPrivate(entry, metaData));
+        if (d.shouldDescendInto(fileInfo))
+            subdirectories.append(directoryFor(fileInfo));
+        if (d.matchesFilters(entry.fileName(), fileInfo)) {
+            batch.append(fileInfo);
+            if (batch.size() >= TraversalBatchSize)
+                flush(batch);
+        }
+    }
+}
+
+void QDirTraversal::flush(QFileInfoList &batch)
+{
+    if (batch.isEmpty())
+        return;
+    {
+        QMutexLocker locker(&handlerMutex);
+        handler(batch);
+    }
+    batch.clear();
+}
+#endif // QT_NO_FILESYSTEMITERATOR
+} // unnamed namespace
+
+/*!
+    \since 6.0
+
+    Lists the contents of the directory \a path the same way a QDirIterator
+    constructed with \a nameFilters, \a filters and \a flags would, but
+    reads directories concurrently on up to \a maxThreadCount threads and
+    hands the matching entries to \a handler in batches.
+
+    If \a maxThreadCount is 0 or negative, QThread::idealThreadCount() threads
+    are used. The handler may be called from any of the worker threads, but
+    never from more than one at a time, and traverse() returns only after
+    the last batch has been delivered. The order in which entries are
+    reported is unspecified.
+
+    The QFileInfo objects passed to the handler already have their
+    attributes cached, so that querying for instance their size or
+    modification time does not touch the file system again.
+
+    Paths that are handled by a custom file engine, such as Qt resources,
+    are listed sequentially on the calling thread.
+
+    \sa QThread::idealThreadCount()
+*/
+void QDirIterator::traverse(const QString &path, const QStringList &nameFilters,
+                            QDir::Filters filters, IteratorFlags flags,
+                            const std::function<void(const QFileInfoList &)> &handler,
+                            int maxThreadCount)
+{
+    QDirIteratorPrivate d(QFileSystemEntry(path), nameFilters, filters, flags);
+
+#ifndef QT_NO_FILESYSTEMITERATOR
+    if (!d.engine) {
+        QDirTraversal traversal(d, handler);
+        traversal.enqueue(QFileInfo(new QFileInfoPrivate(d.dirEntry, d.dirMetaData)));
+#if QT_CONFIG(thread)
+        if (maxThreadCount <= 0)
+            maxThreadCount = QThread::idealThreadCount();
+        if (maxThreadCount > 1 && (flags & Subdirectories)) {
+            QThreadPool pool;
+            pool.setMaxThreadCount(maxThreadCount - 1);
+            for (int i = 1; i < maxThreadCount; ++i)
+                pool.start([&traversal] { traversal.run(); });
+            traversal.run();
+            pool.waitForDone();
+            return;
+        }
+#endif
+        Q_UNUSED(maxThreadCount);
+        traversal.run();
+        return;
+    }
+#endif
+
+    Q_UNUSED(maxThreadCount);
+    QDirIterator it(path, nameFilters, filters, flags);
+    QFileInfoList batch;
+    while (it.hasNext()) {
+        it.next();
+        batch.append(it.fileInfo());
+        if (batch.size() >= TraversalBatchSize) {
+            handler(batch);
+            batch.clear();
+        }
+    }
+    if (!batch.isEmpty())
+        handler(batch);
+}
+
 QT_END_NAMESPACE
@@ -42,6 +42,8 @@
 
 #include <QtCore/qdir.h>
 
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 
 
@@ -76,6 +78,11 @@ public:
     QFileInfo fileInfo() const;
     QString path() const;
 
+    static void traverse(const QString &path, const QStringList &nameFilters,
+                         QDir::Filters filters, IteratorFlags flags,
+                         const std::function<void(const QFileInfoList &)> &handler,
+                         int maxThreadCount = 0);
+
 private:
     Q_DISABLE_COPY(QDirIterator)
 
@@ -814,24 +814,17 @@ QFile::copy(const QString &newName)
                     d->setError(QFile::CopyError, tr("Cannot open for output: %1").arg(out.errorString()));
                 } else {
                     if (!d->engine()->cloneTo(out.d_func()->engine())) {
-                        char block[4096];
-                        qint64 totalRead = 0;
-                        while (!atEnd()) {
-                            qint64 in = read(block, sizeof(block));
-                            if (in <= 0)
-                                break;
-                            totalRead += in;
-                            if (in != out.write(block, in)) {
-                                close();
-                                d->setError(QFile::CopyError, tr("Failure to write block"));
-                                error = true;
-                                break;
-                            }
-                        }
-
-                        if (totalRead != size()) {
+                        const qint64 totalRead = transferTo(&out);
+                        if (out.error() != QFile::NoError) {
+                            close();
+                            d->setError(QFile::CopyError, tr("Failure to write block"));
+                            error = true;
+                        } else if (totalRead != size()) {
                             // Unable to read from the source. The error string is
-                            // already set from read().
+                            // already set from read() or transferTo().
+                            const QString errorString = this->errorString();
+                            close();
+                            d->setError(QFile::CopyError, errorString);
                             error = true;
                         }
                     }
@@ -40,6 +40,10 @@
 #include "qplatformdefs.h"
 #include "qfiledevice.h"
 #include "qfiledevice_p.h"
+#include "qfile.h"
+#if QT_CONFIG(temporaryfile)
+#include "qtemporaryfile.h"
+#endif
 #include "qfsfileengine_p.h"
 
 #include <private/qmemory_p.h>
@@ -59,6 +63,7 @@ QFileDevicePrivate::QFileDevicePrivate()
       error(QFile::NoError), lastWasWrite(false)
 {
     writeBufferChunkSize = QFILE_WRITEBUFFER_SIZE;
+    readBufferMaxChunkSize = QIODEVICE_MAX_BUFFERSIZE;
 }
 
 QFileDevicePrivate::~QFileDevicePrivate()
@@ -474,6 +479,56 @@ qint64 QFileDevice::readData(char *data, qint64 len)
     return read;
 }
 
+/*!
+    \internal
+*/
+bool QFileDevicePrivate::readScattered(char *data, qint64 maxSize, char *bufferData,
+                                       qint64 bufferSize, qint64 *bytesRead)
+{
+    Q_Q(QFileDevice);
+    if (!fileEngine || !fileEngine->supportsExtension(QAbstractFileEngine::ScatterReadExtension))
+        return false;
+#ifndef QT_NO_QOBJECT
+    // this bypasses readData(), which subclasses of QFile may reimplement
+    const QMetaObject *metaObject = q->metaObject();
+    if (metaObject != &QFile::staticMetaObject
+#if QT_CONFIG(temporaryfile)
+            && metaObject != &QTemporaryFile::staticMetaObject
+#endif
+            ) {
+        return false;
+    }
+#endif
+
+    q->unsetError();
+    if (!ensureFlushed()) {
+        *bytesRead = -1;
+        return true;
+    }
+
+    const QAbstractFileEngine::ScatterReadExtensionOption::Buffer buffers[] = {
+        { data, maxSize },
+        { bufferData, bufferSize }
+    };
+    QAbstractFileEngine::ScatterReadExtensionOption option;
+    option.buffers = buffers;
+    option.count = 2;
+    QAbstractFileEngine::ScatterReadExtensionReturn result;
+    if (!fileEngine->extension(QAbstractFileEngine::ScatterReadExtension, &option, &result))
+        return false;
+
+    if (result.bytesRead < 0) {
+        QFileDevice::FileError err = fileEngine->error();
+        if (err == QFileDevice::UnspecifiedError)
+            err = QFileDevice::ReadError;
+        setError(err, fileEngine->errorString());
+    }
+    if (result.bytesRead < maxSize + bufferSize)
+        cachedSize = 0;
+    *bytesRead = result.bytesRead;
+    return true;
+}
+
 /*!
     \internal
 */
@@ -531,6 +586,28 @@ bool QFileDevicePrivate::putCharHelper(char c)
 #endif
 }
 
+/*!
+    \internal
+
+    Only local files whose contents are not transformed qualify; files opened
+    for appending are excluded since the kernel copy paths cannot append.
+*/
+int QFileDevicePrivate::transferDescriptor(QIODevice::OpenModeFlag direction)
+{
+    Q_Q(QFileDevice);
+    if (!fileEngine || (openMode & QIODevice::Text))
+        return -1;
+    if (direction == QIODevice::WriteOnly && (openMode & QIODevice::Append))
+        return -1;
+    if ((fileEngine->fileFlags(QAbstractFileEngine::LocalDiskFlag)
+         & QAbstractFileEngine::LocalDiskFlag) == 0) {
+        return -1;
+    }
+    if (!q->flush())
+        return -1;
+    return fileEngine->handle();
+}
+
 /*!
   \reimp
 */
@@ -683,6 +760,24 @@ bool QFileDevice::setPermissions(Permissions permissions)
     memory is unmapped.  It is unspecified whether modifications made
     to the file made after the mapping is created will be visible through
     the mapped memory. This enum value was introduced in Qt 5.4.
+    \value MapPopulateOption The pages of the mapping are read in when it is
+    created, so that accessing them later does not cause page faults. This
+    enum value was introduced in Qt 6.0.
+
+    The following values are hints about how the mapped memory will be
+    accessed. The operating system may use them to tune read-ahead and
+    caching, or ignore them. They were introduced in Qt 6.0.
+
+    \value MapSequentialHint The memory will be accessed sequentially, so
+    pages can be read ahead aggressively and released soon after use.
+    \value MapRandomHint The memory will be accessed in random order, so
+    reading ahead is not useful.
+    \value MapWillNeedHint The memory will be accessed soon, so its pages
+    should be read in the background.
+    \value MapHugePagesHint The memory should be backed by huge pages where
+    possible, to reduce the TLB pressure of large mappings.
+
+    \sa adviseMap()
 */
 
 /*!
@@ -738,6 +833,37 @@ bool QFileDevice::unmap(uchar *address)
     return false;
 }
 
+/*!
+    \since 6.0
+
+    Passes the access \a hints for the \a size bytes at \a address to the
+    operating system. The memory must lie within a mapping returned by map().
+    Only the hint values of MemoryMapFlags are meaningful here;
+    MapPopulateOption requests the pages to be read in the background.
+
+    This can be used to prefetch the part of a large mapping that is about to
+    be accessed, or to change the access pattern of a part of it.
+
+    Returns \c true if the hints were passed on; false otherwise. Hints that
+    the platform does not support are ignored.
+
+    \sa map(), MemoryMapFlags
+ */
+bool QFileDevice::adviseMap(uchar *address, qint64 size, MemoryMapFlags hints)
+{
+    Q_D(QFileDevice);
+    if (d->engine()
+        && d->fileEngine->supportsExtension(QAbstractFileEngine::AdviseMapExtension)) {
+        unsetError();
+        bool success = d->fileEngine->adviseMap(address, size, hints);
+        if (!success)
+            d->setError(d->fileEngine->error(), d->fileEngine->errorString());
+        return success;
+    }
+    d->setError(PermissionsError, tr("No file engine available or engine does not support AdviseMapExtension"));
+    return false;
+}
+
 /*!
     \enum QFileDevice::FileTime
     \since 5.10
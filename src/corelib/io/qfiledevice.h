@@ -120,12 +120,18 @@ public:
 
     enum MemoryMapFlag {
         NoOptions = 0,
-        MapPrivateOption = 0x0001
+        MapPrivateOption = 0x0001,
+        MapPopulateOption = 0x0002,
+        MapSequentialHint = 0x0004,
+        MapRandomHint = 0x0008,
+        MapWillNeedHint = 0x0010,
+        MapHugePagesHint = 0x0020
     };
     Q_DECLARE_FLAGS(MemoryMapFlags, MemoryMapFlag)
 
     uchar *map(qint64 offset, qint64 size, MemoryMapFlags flags = NoOptions);
     bool unmap(uchar *address);
+    bool adviseMap(uchar *address, qint64 size, MemoryMapFlags hints);
 
     QDateTime fileTime(QFileDevice::FileTime time) const;
     bool setFileTime(const QDateTime &newDate, QFileDevice::FileTime fileTime);
@@ -72,6 +72,9 @@ protected:
     inline bool ensureFlushed() const;
 
     bool putCharHelper(char c) override;
+    int transferDescriptor(QIODevice::OpenModeFlag direction) override;
+    bool readScattered(char *data, qint64 maxSize, char *bufferData, qint64 bufferSize,
+                       qint64 *bytesRead) override;
 
     void setError(QFileDevice::FileError err);
     void setError(QFileDevice::FileError err, const QString &errorString);
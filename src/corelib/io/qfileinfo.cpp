@@ -686,8 +686,13 @@ bool QFileInfo::exists() const
     if (d->isDefaultConstructed)
         return false;
     if (d->fileEngine == nullptr) {
-        if (!d->cache_enabled || !d->metaData.hasFlags(QFileSystemMetaData::ExistsAttribute))
+        if (!d->cache_enabled) {
             QFileSystemEngine::fillMetaData(d->fileEntry, d->metaData, QFileSystemMetaData::ExistsAttribute);
+        } else if (!d->metaData.hasFlags(QFileSystemMetaData::ExistsAttribute)
+                   && !QFileSystemMetaDataCache::lookup(d->fileEntry, d->metaData,
+                                                        QFileSystemMetaData::ExistsAttribute)) {
+            QFileSystemEngine::fillMetaData(d->fileEntry, d->metaData, QFileSystemMetaData::ExistsAttribute);
+        }
         return d->metaData.exists();
     }
     return d->getFileFlags(QAbstractFileEngine::ExistsFlag);
@@ -716,18 +721,25 @@ bool QFileInfo::exists(const QString &file)
     if (engine)
         return QFileInfo(new QFileInfoPrivate(entry, data, std::move(engine))).exists();
 
-    QFileSystemEngine::fillMetaData(entry, data, QFileSystemMetaData::ExistsAttribute);
+    if (!QFileSystemMetaDataCache::lookup(entry, data, QFileSystemMetaData::ExistsAttribute))
+        QFileSystemEngine::fillMetaData(entry, data, QFileSystemMetaData::ExistsAttribute);
     return data.exists();
 }
 
 /*!
     Refreshes the information about the file, i.e. reads in information
     from the file system the next time a cached property is fetched.
+
+    This also drops the file from the shared cache.
+
+    \sa setSharedCacheEnabled()
 */
 void QFileInfo::refresh()
 {
     Q_D(QFileInfo);
     d->clear();
+    if (!d->fileEngine && !d->isDefaultConstructed)
+        QFileSystemMetaDataCache::invalidate(d->fileEntry);
 }
 
 /*!
@@ -1526,6 +1538,125 @@ void QFileInfo::stat()
     QFileSystemEngine::fillMetaData(d->fileEntry, d->metaData, QFileSystemMetaData::AllMetaDataFlags);
 }
 
+/*!
+    \enum QFileInfo::MetadataField
+    \since 6.0
+
+    This enum describes groups of file attributes that stat() can read.
+
+    \value Type        Whether the file is a regular file, a directory or a
+                       symbolic link, as returned by isFile(), isDir() and
+                       isSymLink().
+    \value Size        The size of the file, as returned by size().
+    \value Times       The times returned by fileTime().
+    \value Permissions The permissions, as returned by permissions().
+    \value Owner       The owner and group IDs, as returned by ownerId() and
+                       groupId().
+    \value All         All of the above.
+*/
+
+/*!
+    \overload
+    \since 6.0
+
+    Reads only the attributes in \a fields from the file system. Where the
+    operating system supports it, as Linux does with \c statx(), this
+    avoids fetching data the caller is not going to use, which can be
+    noticeably cheaper on network file systems.
+
+    The attributes are cached as if they had been queried individually;
+    reading other attributes later still goes to the file system.
+
+    \sa setCaching(), refresh()
+*/
+void QFileInfo::stat(MetadataFields fields)
+{
+    Q_D(QFileInfo);
+    if (d->isDefaultConstructed || d->fileEngine)
+        return;
+
+    QFileSystemMetaData::MetaDataFlags what = QFileSystemMetaData::ExistsAttribute;
+    if (fields & MetadataField::Type) {
+        what |= QFileSystemMetaData::LinkType | QFileSystemMetaData::FileType
+                | QFileSystemMetaData::DirectoryType;
+    }
+    if (fields & MetadataField::Size)
+        what |= QFileSystemMetaData::SizeAttribute;
+    if (fields & MetadataField::Times)
+        what |= QFileSystemMetaData::Times;
+    if (fields & MetadataField::Permissions)
+        what |= QFileSystemMetaData::Permissions;
+    if (fields & MetadataField::Owner)
+        what |= QFileSystemMetaData::OwnerIds;
+    QFileSystemEngine::fillRequestedMetaData(d->fileEntry, d->metaData, what);
+}
+
+/*!
+    \since 6.0
+
+    Returns whether the process-wide cache of file attributes is enabled.
+
+    \sa setSharedCacheEnabled()
+*/
+bool QFileInfo::isSharedCacheEnabled()
+{
+    return QFileSystemMetaDataCache::isEnabled();
+}
+
+/*!
+    \since 6.0
+
+    Enables the process-wide cache of file attributes if \a enable is
+    true, and disables and empties it otherwise. It is disabled by default.
+
+    While the cache is enabled, QDirIterator, and with it QDir::entryList()
+    and QDir::entryInfoList(), records the attributes of the entries it
+    lists. A QFileInfo constructed later for one of those entries uses the
+    recorded attributes instead of querying the file system again. Only
+    absolute paths are cached.
+
+    Changes made through Qt, for example by QFile::remove(), QFile::rename()
+    or writing to a QFile, drop the affected entries from the cache. Changes
+    made by other means, including by other processes, are not noticed; use
+    invalidateSharedCache() or clearSharedCache() after such changes.
+
+    \note Caching per QFileInfo object, as controlled by setCaching(), is
+    independent of this; a QFileInfo that does not cache never uses the
+    shared cache either.
+
+    \sa isSharedCacheEnabled(), refresh()
+*/
+void QFileInfo::setSharedCacheEnabled(bool enable)
+{
+    QFileSystemMetaDataCache::setEnabled(enable);
+}
+
+/*!
+    \since 6.0
+
+    Drops the attributes of \a path, and of the directory containing it,
+    from the process-wide cache of file attributes.
+
+    \sa clearSharedCache(), setSharedCacheEnabled()
+*/
+void QFileInfo::invalidateSharedCache(const QString &path)
+{
+    if (!path.isEmpty())
+        QFileSystemMetaDataCache::invalidate(QFileSystemEntry(QDir::fromNativeSeparators(path)));
+}
+
+/*!
+    \since 6.0
+
+    Empties the process-wide cache of file attributes.
+
+    \sa invalidateSharedCache(), setSharedCacheEnabled()
+*/
+void QFileInfo::clearSharedCache()
+{
+    QFileSystemMetaDataCache::clear();
+}
+
 /*!
     \typedef QFileInfoList
     \relates QFileInfo
@@ -57,6 +57,16 @@ class Q_CORE_EXPORT QFileInfo
 {
     friend class QDirIteratorPrivate;
 public:
+    enum class MetadataField {
+        Type        = 0x01,
+        Size        = 0x02,
+        Times       = 0x04,
+        Permissions = 0x08,
+        Owner       = 0x10,
+        All         = Type | Size | Times | Permissions | Owner
+    };
+    Q_DECLARE_FLAGS(MetadataFields, MetadataField)
+
     explicit QFileInfo(QFileInfoPrivate *d);
 
     QFileInfo();
@@ -176,6 +186,12 @@ public:
     bool caching() const;
     void setCaching(bool on);
     void stat();
+    void stat(MetadataFields fields);
+
+    static bool isSharedCacheEnabled();
+    static void setSharedCacheEnabled(bool enable);
+    static void invalidateSharedCache(const QString &path);
+    static void clearSharedCache();
 
 protected:
     QSharedDataPointer<QFileInfoPrivate> d_ptr;
@@ -189,6 +205,7 @@ private:
 };
 
 Q_DECLARE_SHARED(QFileInfo)
+Q_DECLARE_OPERATORS_FOR_FLAGS(QFileInfo::MetadataFields)
 
 typedef QList<QFileInfo> QFileInfoList;
 
@@ -189,7 +189,10 @@ public:
             return defaultValue;
         if (fileEngine)
             return engineLambda();
-        if (!cache_enabled || !metaData.hasFlags(fsFlags)) {
+        if (!cache_enabled) {
+            QFileSystemEngine::fillMetaData(fileEntry, metaData, fsFlags);
+        } else if (!metaData.hasFlags(fsFlags)
+                   && !QFileSystemMetaDataCache::lookup(fileEntry, metaData, fsFlags)) {
             QFileSystemEngine::fillMetaData(fileEntry, metaData, fsFlags);
             // ignore errors, fillMetaData will have cleared the flags
         }
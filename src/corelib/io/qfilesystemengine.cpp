@@ -38,7 +38,9 @@
 ****************************************************************************/
 
 #include "qfilesystemengine_p.h"
+#include <QtCore/qcache.h>
 #include <QtCore/qdir.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qset.h>
 #include <QtCore/qstringbuilder.h>
 #include <QtCore/private/qabstractfileengine_p.h>
@@ -232,4 +234,110 @@ QString QFileSystemEngine::resolveGroupName(const QFileSystemEntry &entry, QFile
 #endif
 }
 
+QBasicAtomicInt QFileSystemMetaDataCache::enabled = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+namespace {
+struct QFileSystemMetaDataCacheData
+{
+    enum { MaxEntries = 64 * 1024 };
+
+    QFileSystemMetaDataCacheData() : entries(MaxEntries) { }
+
+    QMutex mutex;
+    QCache<QString, QFileSystemMetaData> entries;
+};
+}
+Q_GLOBAL_STATIC(QFileSystemMetaDataCacheData, metaDataCache)
+
+/*!
+    \internal
+
+    Enables or disables the cache. Disabling it drops all entries.
+*/
+void QFileSystemMetaDataCache::setEnabled(bool enable)
+{
+    enabled.storeRelaxed(enable);
+    if (enable)
+        return;
+    if (QFileSystemMetaDataCacheData *d = metaDataCache()) {
+        QMutexLocker locker(&d->mutex);
+        d->entries.clear();
+    }
+}
+
+/*!
+    \internal
+
+    Copies the cached metadata of \a entry to \a data if there is any that
+    covers all of \a what, and returns whether it did. Only absolute paths
+    are cached, since relative ones would depend on the current directory.
+*/
+bool QFileSystemMetaDataCache::lookup(const QFileSystemEntry &entry, QFileSystemMetaData &data,
+                                      QFileSystemMetaData::MetaDataFlags what)
+{
+    if (!isEnabled() || !entry.isAbsolute())
+        return false;
+    QFileSystemMetaDataCacheData *d = metaDataCache();
+    if (!d)
+        return false;
+    QMutexLocker locker(&d->mutex);
+    const QFileSystemMetaData *cached = d->entries.object(entry.filePath());
+    if (!cached || !cached->hasFlags(what))
+        return false;
+    data = *cached;
+    return true;
+}
+
+/*!
+    \internal
+
+    Stores \a data as the metadata of \a entry.
+*/
+void QFileSystemMetaDataCache::insert(const QFileSystemEntry &entry, const QFileSystemMetaData &data)
+{
+    if (!isEnabled() || !entry.isAbsolute())
+        return;
+    QFileSystemMetaDataCacheData *d = metaDataCache();
+    if (!d)
+        return;
+    QMutexLocker locker(&d->mutex);
+    d->entries.insert(entry.filePath(), new QFileSystemMetaData(data));
+}
+
+/*!
+    \internal
+
+    Drops the cached metadata of \a entry and of the directory containing
+    it, whose modification time changes along with it.
+*/
+void QFileSystemMetaDataCache::invalidate(const QFileSystemEntry &entry)
+{
+    if (!isEnabled())
+        return;
+    QFileSystemMetaDataCacheData *d = metaDataCache();
+    if (!d)
+        return;
+    const QFileSystemEntry absolute = entry.isAbsolute() ? entry
+                                                         : QFileSystemEngine::absoluteName(entry);
+    QMutexLocker locker(&d->mutex);
+    d->entries.remove(absolute.filePath());
+    d->entries.remove(absolute.path());
+}
+
+/*!
+    \internal
+
+    Drops all cached metadata.
+*/
+void QFileSystemMetaDataCache::clear()
+{
+    if (!isEnabled())
+        return;
+    QFileSystemMetaDataCacheData *d = metaDataCache();
+    if (!d)
+        return;
+    QMutexLocker locker(&d->mutex);
+    d->entries.clear();
+}
+
 QT_END_NAMESPACE
@@ -54,6 +54,7 @@
 #include "qfile.h"
 #include "qfilesystementry_p.h"
 #include "qfilesystemmetadata_p.h"
+#include <QtCore/qatomic.h>
 #include <QtCore/private/qsystemerror_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -120,9 +121,14 @@ public:
 
     static bool fillMetaData(const QFileSystemEntry &entry, QFileSystemMetaData &data,
                              QFileSystemMetaData::MetaDataFlags what);
+    static bool fillRequestedMetaData(const QFileSystemEntry &entry, QFileSystemMetaData &data,
+                                      QFileSystemMetaData::MetaDataFlags what);
 #if defined(Q_OS_UNIX)
     static bool cloneFile(int srcfd, int dstfd, const QFileSystemMetaData &knownData);
+    static qint64 transferData(int srcfd, qint64 srcOffset, int dstfd, qint64 dstOffset,
+                               qint64 maxSize, QSystemError &error);
     static bool fillMetaData(int fd, QFileSystemMetaData &data); // what = PosixStatFlags
+    static bool fillMetaData(int dirFd, const char *name, QFileSystemMetaData &data); // what = PosixStatFlags | LinkType
     static QByteArray id(int fd);
     static bool setFileTime(int fd, const QDateTime &newDate,
                             QAbstractFileEngine::FileTime whatTime, QSystemError &error);
@@ -174,11 +180,34 @@ public:
                                                                   QFileSystemMetaData &data);
 private:
     static QString slowCanonicalized(const QString &path);
+#if defined(Q_OS_UNIX)
+    static bool fillMetaData(const QFileSystemEntry &entry, QFileSystemMetaData &data,
+                             QFileSystemMetaData::MetaDataFlags what, bool requestedOnly);
+#endif
 #if defined(Q_OS_WIN)
     static void clearWinStatData(QFileSystemMetaData &data);
 #endif
 };
 
+// Process-wide cache of the metadata of absolute paths, fed by QDirIterator
+// and consulted by QFileInfo. It is disabled by default; when enabled, the
+// modifications made through QFileSystemEngine invalidate the affected entries.
+class Q_AUTOTEST_EXPORT QFileSystemMetaDataCache
+{
+public:
+    static bool isEnabled() { return enabled.loadRelaxed(); }
+    static void setEnabled(bool enable);
+
+    static bool lookup(const QFileSystemEntry &entry, QFileSystemMetaData &data,
+                       QFileSystemMetaData::MetaDataFlags what);
+    static void insert(const QFileSystemEntry &entry, const QFileSystemMetaData &data);
+    static void invalidate(const QFileSystemEntry &entry);
+    static void clear();
+
+private:
+    static QBasicAtomicInt enabled;
+};
+
 QT_END_NAMESPACE
 
 #endif // include guard
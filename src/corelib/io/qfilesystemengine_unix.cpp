@@ -91,6 +91,7 @@ extern "C" NSString *NSTemporaryDirectory();
 #if defined(Q_OS_LINUX)
 #  include <sys/ioctl.h>
 #  include <sys/sendfile.h>
+#  include <sys/syscall.h>
 #  include <linux/fs.h>
 
 // in case linux/fs.h is too old and doesn't define it:
@@ -308,94 +309,176 @@ mtime(const T &statBuffer, int)
 } // unnamed namespace
 
 #ifdef STATX_BASIC_STATS
-static int qt_real_statx(int fd, const char *pathname, int flags, struct statx *statxBuffer)
+enum : unsigned { DefaultStatxMask = STATX_BASIC_STATS | STATX_BTIME };
+
+static int qt_real_statx(int fd, const char *pathname, int flags, struct statx *statxBuffer,
+                         unsigned mask)
 {
-    unsigned mask = STATX_BASIC_STATS | STATX_BTIME;
     int ret = statx(fd, pathname, flags, mask, statxBuffer);
     return ret == -1 ? -errno : 0;
 }
 
-static int qt_statx(const char *pathname, struct statx *statxBuffer)
+static int qt_statx(const char *pathname, struct statx *statxBuffer,
+                    unsigned mask = DefaultStatxMask)
 {
-    return qt_real_statx(AT_FDCWD, pathname, 0, statxBuffer);
+    return qt_real_statx(AT_FDCWD, pathname, 0, statxBuffer, mask);
 }
 
-static int qt_lstatx(const char *pathname, struct statx *statxBuffer)
+static int qt_lstatx(const char *pathname, struct statx *statxBuffer,
+                     unsigned mask = DefaultStatxMask)
 {
-    return qt_real_statx(AT_FDCWD, pathname, AT_SYMLINK_NOFOLLOW, statxBuffer);
+    return qt_real_statx(AT_FDCWD, pathname, AT_SYMLINK_NOFOLLOW, statxBuffer, mask);
 }
 
 static int qt_fstatx(int fd, struct statx *statxBuffer)
 {
-    return qt_real_statx(fd, "", AT_EMPTY_PATH, statxBuffer);
+    return qt_real_statx(fd, "", AT_EMPTY_PATH, statxBuffer, DefaultStatxMask);
 }
 
-inline void QFileSystemMetaData::fillFromStatxBuf(const struct statx &statxBuffer)
+static int qt_statxat(int dirFd, const char *name, int flags, struct statx *statxBuffer)
 {
-    // Permissions
-    if (statxBuffer.stx_mode & S_IRUSR)
-        entryFlags |= QFileSystemMetaData::OwnerReadPermission;
-    if (statxBuffer.stx_mode & S_IWUSR)
-        entryFlags |= QFileSystemMetaData::OwnerWritePermission;
-    if (statxBuffer.stx_mode & S_IXUSR)
-        entryFlags |= QFileSystemMetaData::OwnerExecutePermission;
+    return qt_real_statx(dirFd, name, flags, statxBuffer, DefaultStatxMask);
+}
 
-    if (statxBuffer.stx_mode & S_IRGRP)
-        entryFlags |= QFileSystemMetaData::GroupReadPermission;
-    if (statxBuffer.stx_mode & S_IWGRP)
-        entryFlags |= QFileSystemMetaData::GroupWritePermission;
-    if (statxBuffer.stx_mode & S_IXGRP)
-        entryFlags |= QFileSystemMetaData::GroupExecutePermission;
+// The statx(2) fields needed to answer the stat(2) flags in what. The type is
+// always asked for, since we need it to tell symlinks apart.
+static unsigned statxMaskFor(QFileSystemMetaData::MetaDataFlags what)
+{
+    unsigned mask = STATX_TYPE;
+    if (what & (QFileSystemMetaData::OtherPermissions | QFileSystemMetaData::GroupPermissions
+                | QFileSystemMetaData::OwnerPermissions))
+        mask |= STATX_MODE;
+    if (what & QFileSystemMetaData::WasDeletedAttribute)
+        mask |= STATX_NLINK;
+    if (what & QFileSystemMetaData::SizeAttribute)
+        mask |= STATX_SIZE;
+    if (what & QFileSystemMetaData::Times)
+        mask |= STATX_ATIME | STATX_MTIME | STATX_CTIME | STATX_BTIME;
+    if (what & QFileSystemMetaData::UserId)
+        mask |= STATX_UID;
+    if (what & QFileSystemMetaData::GroupId)
+        mask |= STATX_GID;
+    return mask;
+}
 
-    if (statxBuffer.stx_mode & S_IROTH)
-        entryFlags |= QFileSystemMetaData::OtherReadPermission;
-    if (statxBuffer.stx_mode & S_IWOTH)
-        entryFlags |= QFileSystemMetaData::OtherWritePermission;
-    if (statxBuffer.stx_mode & S_IXOTH)
-        entryFlags |= QFileSystemMetaData::OtherExecutePermission;
+// The inverse of statxMaskFor(): the stat(2) flags that the statx(2) fields in
+// mask answer. All times share one flag, the birth time being optional.
+static QFileSystemMetaData::MetaDataFlags flagsForStatxMask(unsigned mask)
+{
+    QFileSystemMetaData::MetaDataFlags flags;
+    if (mask & STATX_TYPE) {
+        flags |= QFileSystemMetaData::FileType | QFileSystemMetaData::DirectoryType
+                | QFileSystemMetaData::SequentialType;
+    }
+    if (mask & STATX_MODE) {
+        flags |= QFileSystemMetaData::OtherPermissions | QFileSystemMetaData::GroupPermissions
+                | QFileSystemMetaData::OwnerPermissions;
+    }
+    if (mask & STATX_NLINK)
+        flags |= QFileSystemMetaData::WasDeletedAttribute;
+    if (mask & STATX_SIZE)
+        flags |= QFileSystemMetaData::SizeAttribute;
+    const unsigned times = STATX_ATIME | STATX_MTIME | STATX_CTIME;
+    if ((mask & times) == times)
+        flags |= QFileSystemMetaData::Times;
+    if (mask & STATX_UID)
+        flags |= QFileSystemMetaData::UserId;
+    if (mask & STATX_GID)
+        flags |= QFileSystemMetaData::GroupId;
+    return flags;
+}
+
+// Only the fields present in stx_mask are filled in, so that a statx(2) call
+// that asked for less than everything does not clobber what we already know.
+inline void QFileSystemMetaData::fillFromStatxBuf(const struct statx &statxBuffer)
+{
+    const unsigned mask = statxBuffer.stx_mask;
+
+    // Permissions
+    if (mask & STATX_MODE) {
+        if (statxBuffer.stx_mode & S_IRUSR)
+            entryFlags |= QFileSystemMetaData::OwnerReadPermission;
+        if (statxBuffer.stx_mode & S_IWUSR)
+            entryFlags |= QFileSystemMetaData::OwnerWritePermission;
+        if (statxBuffer.stx_mode & S_IXUSR)
+            entryFlags |= QFileSystemMetaData::OwnerExecutePermission;
+
+        if (statxBuffer.stx_mode & S_IRGRP)
+            entryFlags |= QFileSystemMetaData::GroupReadPermission;
+        if (statxBuffer.stx_mode & S_IWGRP)
+            entryFlags |= QFileSystemMetaData::GroupWritePermission;
+        if (statxBuffer.stx_mode & S_IXGRP)
+            entryFlags |= QFileSystemMetaData::GroupExecutePermission;
+
+        if (statxBuffer.stx_mode & S_IROTH)
+            entryFlags |= QFileSystemMetaData::OtherReadPermission;
+        if (statxBuffer.stx_mode & S_IWOTH)
+            entryFlags |= QFileSystemMetaData::OtherWritePermission;
+        if (statxBuffer.stx_mode & S_IXOTH)
+            entryFlags |= QFileSystemMetaData::OtherExecutePermission;
+    }
 
     // Type
-    if (S_ISLNK(statxBuffer.stx_mode))
-        entryFlags |= QFileSystemMetaData::LinkType;
-    if ((statxBuffer.stx_mode & S_IFMT) == S_IFREG)
-        entryFlags |= QFileSystemMetaData::FileType;
-    else if ((statxBuffer.stx_mode & S_IFMT) == S_IFDIR)
-        entryFlags |= QFileSystemMetaData::DirectoryType;
-    else if ((statxBuffer.stx_mode & S_IFMT) != S_IFBLK)
-        entryFlags |= QFileSystemMetaData::SequentialType;
+    if (mask & STATX_TYPE) {
+        if (S_ISLNK(statxBuffer.stx_mode))
+            entryFlags |= QFileSystemMetaData::LinkType;
+        if ((statxBuffer.stx_mode & S_IFMT) == S_IFREG)
+            entryFlags |= QFileSystemMetaData::FileType;
+        else if ((statxBuffer.stx_mode & S_IFMT) == S_IFDIR)
+            entryFlags |= QFileSystemMetaData::DirectoryType;
+        else if ((statxBuffer.stx_mode & S_IFMT) != S_IFBLK)
+            entryFlags |= QFileSystemMetaData::SequentialType;
+    }
 
     // Attributes
     entryFlags |= QFileSystemMetaData::ExistsAttribute; // inode exists
-    if (statxBuffer.stx_nlink == 0)
+    if ((mask & STATX_NLINK) && statxBuffer.stx_nlink == 0)
         entryFlags |= QFileSystemMetaData::WasDeletedAttribute;
-    size_ = qint64(statxBuffer.stx_size);
+    if (mask & STATX_SIZE)
+        size_ = qint64(statxBuffer.stx_size);
 
     // Times
     auto toMSecs = [](struct statx_timestamp ts)
     {
         return qint64(ts.tv_sec) * 1000 + (ts.tv_nsec / 1000000);
     };
-    accessTime_ = toMSecs(statxBuffer.stx_atime);
-    metadataChangeTime_ = toMSecs(statxBuffer.stx_ctime);
-    modificationTime_ = toMSecs(statxBuffer.stx_mtime);
-    if (statxBuffer.stx_mask & STATX_BTIME)
+    if (mask & STATX_ATIME)
+        accessTime_ = toMSecs(statxBuffer.stx_atime);
+    if (mask & STATX_CTIME)
+        metadataChangeTime_ = toMSecs(statxBuffer.stx_ctime);
+    if (mask & STATX_MTIME)
+        modificationTime_ = toMSecs(statxBuffer.stx_mtime);
+    if (mask & STATX_BTIME)
         birthTime_ = toMSecs(statxBuffer.stx_btime);
-    else
+    else if (mask & STATX_MTIME)
         birthTime_ = 0;
 
-    userId_ = statxBuffer.stx_uid;
-    groupId_ = statxBuffer.stx_gid;
+    if (mask & STATX_UID)
+        userId_ = statxBuffer.stx_uid;
+    if (mask & STATX_GID)
+        groupId_ = statxBuffer.stx_gid;
 }
 #else
-static int qt_statx(const char *, struct statx *)
+enum : unsigned { DefaultStatxMask = 0 };
+
+static int qt_statx(const char *, struct statx *, unsigned = DefaultStatxMask)
 { return -ENOSYS; }
 
-static int qt_lstatx(const char *, struct statx *)
+static int qt_lstatx(const char *, struct statx *, unsigned = DefaultStatxMask)
 { return -ENOSYS; }
 
 static int qt_fstatx(int, struct statx *)
 { return -ENOSYS; }
 
+static int qt_statxat(int, const char *, int, struct statx *)
+{ return -ENOSYS; }
+
+static unsigned statxMaskFor(QFileSystemMetaData::MetaDataFlags)
+{ return DefaultStatxMask; }
+
+static QFileSystemMetaData::MetaDataFlags flagsForStatxMask(unsigned)
+{ return QFileSystemMetaData::PosixStatFlags; }
+
 inline void QFileSystemMetaData::fillFromStatxBuf(const struct statx &)
 { }
 #endif
@@ -428,6 +511,56 @@ bool QFileSystemEngine::fillMetaData(int fd, QFileSystemMetaData &data)
     return false;
 }
 
+static int qt_fstatat(int dirFd, const char *name, QT_STATBUF *statBuffer, int flags)
+{
+#if defined(QT_USE_XOPEN_LFS_EXTENSIONS) && defined(QT_LARGEFILE_SUPPORT)
+    return ::fstatat64(dirFd, name, statBuffer, flags);
+#else
+    return ::fstatat(dirFd, name, statBuffer, flags);
+#endif
+}
+
+// Fills in the stat(2) data of the entry name of the directory open as dirFd,
+// like fillMetaData() does for LinkType and PosixStatFlags, but looking the
+// entry up relative to the directory instead of resolving its full path again.
+// Returns false if the entry does not exist; for a dangling symlink, only the
+// link type is filled in.
+//static
+bool QFileSystemEngine::fillMetaData(int dirFd, const char *name, QFileSystemMetaData &data)
+{
+    data.entryFlags &= ~(QFileSystemMetaData::PosixStatFlags | QFileSystemMetaData::LinkType
+                         | QFileSystemMetaData::ExistsAttribute);
+    data.knownFlagsMask |= QFileSystemMetaData::PosixStatFlags | QFileSystemMetaData::LinkType
+            | QFileSystemMetaData::ExistsAttribute;
+
+    union {
+        QT_STATBUF statBuffer;
+        struct statx statxBuffer;
+    };
+
+    // First lstat(2), then stat(2) if the entry is a symlink:
+    int flags = AT_SYMLINK_NOFOLLOW;
+    for (;;) {
+        int ret = qt_statxat(dirFd, name, flags, &statxBuffer);
+        const bool usedStatx = ret != -ENOSYS;
+        if (!usedStatx)
+            ret = qt_fstatat(dirFd, name, &statBuffer, flags) == 0 ? 0 : -errno;
+        if (ret != 0)
+            return flags == 0; // a dangling symlink still exists
+        const mode_t mode = usedStatx ? mode_t(statxBuffer.stx_mode) : statBuffer.st_mode;
+        if (flags != 0 && S_ISLNK(mode)) {
+            data.entryFlags |= QFileSystemMetaData::LinkType;
+            flags = 0;
+            continue;
+        }
+        if (usedStatx)
+            data.fillFromStatxBuf(statxBuffer);
+        else
+            data.fillFromStatBuf(statBuffer);
+        return true;
+    }
+}
+
 #if defined(_DEXTRA_FIRST)
 static void fillStat64fromStat32(struct stat64 *statBuf64, const struct stat &statBuf32)
 {
@@ -878,6 +1011,24 @@ QString QFileSystemEngine::bundleName(const QFileSystemEntry &entry)
 //static
 bool QFileSystemEngine::fillMetaData(const QFileSystemEntry &entry, QFileSystemMetaData &data,
         QFileSystemMetaData::MetaDataFlags what)
+{
+    return fillMetaData(entry, data, what, false);
+}
+
+// Like fillMetaData(), but where statx(2) is available, only the fields
+// needed for the flags in what are asked for, and only those are marked as
+// known afterwards. fillMetaData() fetches all stat(2) data as soon as any of
+// it is requested, which is cheaper if more of it is going to be needed later.
+//static
+bool QFileSystemEngine::fillRequestedMetaData(const QFileSystemEntry &entry, QFileSystemMetaData &data,
+        QFileSystemMetaData::MetaDataFlags what)
+{
+    return fillMetaData(entry, data, what, true);
+}
+
+//static
+bool QFileSystemEngine::fillMetaData(const QFileSystemEntry &entry, QFileSystemMetaData &data,
+        QFileSystemMetaData::MetaDataFlags what, bool requestedOnly)
 {
     Q_CHECK_FILE_NAME(entry, false);
 
@@ -894,9 +1045,39 @@ bool QFileSystemEngine::fillMetaData(const QFileSystemEntry &entry, QFileSystemM
     }
 #endif // defined(Q_OS_DARWIN)
 
-    // if we're asking for any of the stat(2) flags, then we're getting them all
-    if (what & QFileSystemMetaData::PosixStatFlags)
-        what |= QFileSystemMetaData::PosixStatFlags;
+    // if we're asking for any of the stat(2) flags, then we're getting them all,
+    // unless we were told to fetch only what is needed for them
+    unsigned statxMask = DefaultStatxMask;
+    if (what & QFileSystemMetaData::PosixStatFlags) {
+        if (requestedOnly) {
+            statxMask = statxMaskFor(what);
+            what |= flagsForStatxMask(statxMask) & QFileSystemMetaData::PosixStatFlags;
+        } else {
+            what |= QFileSystemMetaData::PosixStatFlags;
+        }
+    } else if (requestedOnly) {
+        statxMask = statxMaskFor({});
+    }
+    auto fillFromStatx = [&](struct statx &statxBuffer) {
+        if (requestedOnly) {
+            // don't let fields we did not ask for, but got anyway, replace
+            // values we still consider known
+            statxBuffer.stx_mask &= statxMask;
+            const QFileSystemMetaData::MetaDataFlags known = flagsForStatxMask(statxBuffer.stx_mask);
+            data.entryFlags &= ~known;
+            data.fillFromStatxBuf(statxBuffer);
+            data.knownFlagsMask |= known;
+        } else {
+            data.fillFromStatxBuf(statxBuffer);
+            data.knownFlagsMask |= QFileSystemMetaData::PosixStatFlags;
+        }
+    };
+    auto fillFromStat = [&](const QT_STATBUF &statBuffer) {
+        // stat(2) gives us everything
+        data.entryFlags &= ~QFileSystemMetaData::PosixStatFlags;
+        data.fillFromStatBuf(statBuffer);
+        data.knownFlagsMask |= QFileSystemMetaData::PosixStatFlags;
+    };
 
     data.entryFlags &= ~what;
 
@@ -923,7 +1104,7 @@ bool QFileSystemEngine::fillMetaData(const QFileSystemEntry &entry, QFileSystemM
     int statResult = -1;
     if (what & QFileSystemMetaData::LinkType) {
         mode_t mode = 0;
-        statResult = qt_lstatx(nativeFilePath, &statxBuffer);
+        statResult = qt_lstatx(nativeFilePath, &statxBuffer, statxMask);
         if (statResult == -ENOSYS) {
             // use lstst(2)
             statResult = QT_LSTAT(nativeFilePath, &statBuffer);
@@ -942,11 +1123,10 @@ bool QFileSystemEngine::fillMetaData(const QFileSystemEntry &entry, QFileSystemM
             } else {
                 // it's a reagular file and it exists
                 if (statResult)
-                    data.fillFromStatxBuf(statxBuffer);
+                    fillFromStatx(statxBuffer);
                 else
-                    data.fillFromStatBuf(statBuffer);
-                data.knownFlagsMask |= QFileSystemMetaData::PosixStatFlags
-                        | QFileSystemMetaData::ExistsAttribute;
+                    fillFromStat(statBuffer);
+                data.knownFlagsMask |= QFileSystemMetaData::ExistsAttribute;
                 data.entryFlags |= QFileSystemMetaData::ExistsAttribute;
             }
         } else {
@@ -961,15 +1141,15 @@ bool QFileSystemEngine::fillMetaData(const QFileSystemEntry &entry, QFileSystemM
     // second, we try a regular stat(2)
     if (statResult == -1 && (what & QFileSystemMetaData::PosixStatFlags)) {
         if (entryErrno == 0 && statResult == -1) {
-            data.entryFlags &= ~QFileSystemMetaData::PosixStatFlags;
-            statResult = qt_statx(nativeFilePath, &statxBuffer);
+            data.entryFlags &= ~(what & QFileSystemMetaData::PosixStatFlags);
+            statResult = qt_statx(nativeFilePath, &statxBuffer, statxMask);
             if (statResult == -ENOSYS) {
                 // use stat(2)
                 statResult = QT_STAT(nativeFilePath, &statBuffer);
                 if (statResult == 0)
-                    data.fillFromStatBuf(statBuffer);
+                    fillFromStat(statBuffer);
             } else if (statResult == 0) {
-                data.fillFromStatxBuf(statxBuffer);
+                fillFromStatx(statxBuffer);
             }
         }
 
@@ -985,8 +1165,9 @@ bool QFileSystemEngine::fillMetaData(const QFileSystemEntry &entry, QFileSystemM
         }
 
         // reset the mask
-        data.knownFlagsMask |= QFileSystemMetaData::PosixStatFlags
-            | QFileSystemMetaData::ExistsAttribute;
+        if (statResult != 0)
+            data.knownFlagsMask |= what & QFileSystemMetaData::PosixStatFlags;
+        data.knownFlagsMask |= QFileSystemMetaData::ExistsAttribute;
     }
 
     // third, we try access(2)
@@ -1076,30 +1257,34 @@ bool QFileSystemEngine::cloneFile(int srcfd, int dstfd, const QFileSystemMetaDat
     if (::ioctl(dstfd, FICLONE, srcfd) == 0)
         return true;
 
-    // Second, try sendfile (it can send to some special types too).
-    // sendfile(2) is limited in the kernel to 2G - 4k
-    const size_t SendfileSize = 0x7ffff000;
+    // Second, let the kernel copy the data (copy_file_range, then sendfile,
+    // which can send to some special types too).
+    const QT_OFF_T srcOffset = QT_LSEEK(srcfd, 0, SEEK_CUR);
+    const QT_OFF_T dstOffset = QT_LSEEK(dstfd, 0, SEEK_CUR);
+    if (srcOffset == -1 || dstOffset == -1)
+        return false;
 
-    ssize_t n = ::sendfile(dstfd, srcfd, nullptr, SendfileSize);
+    QSystemError error;
+    const qint64 n = transferData(srcfd, srcOffset, dstfd, dstOffset,
+                                  std::numeric_limits<qint64>::max(), error);
     if (n == -1) {
         // if we got an error here, give up and try at an upper layer
         return false;
     }
-
-    while (n) {
-        n = ::sendfile(dstfd, srcfd, nullptr, SendfileSize);
-        if (n == -1) {
-            // uh oh, this is probably a real error (like ENOSPC), but we have
-            // no way to notify QFile of partial success, so just erase any work
-            // done (hopefully we won't get any errors, because there's nothing
-            // we can do about them)
-            n = ftruncate(dstfd, 0);
-            n = lseek(srcfd, 0, SEEK_SET);
-            n = lseek(dstfd, 0, SEEK_SET);
-            return false;
-        }
+    if (error.error() != 0) {
+        // uh oh, this is probably a real error (like ENOSPC), but we have
+        // no way to notify QFile of partial success, so just erase any work
+        // done (hopefully we won't get any errors, because there's nothing
+        // we can do about them)
+        int ret = ftruncate(dstfd, dstOffset);
+        Q_UNUSED(ret);
+        QT_LSEEK(srcfd, srcOffset, SEEK_SET);
+        QT_LSEEK(dstfd, dstOffset, SEEK_SET);
+        return false;
     }
 
+    QT_LSEEK(srcfd, srcOffset + n, SEEK_SET);
+    QT_LSEEK(dstfd, dstOffset + n, SEEK_SET);
     return true;
 #elif defined(Q_OS_DARWIN)
     // try fcopyfile
@@ -1110,6 +1295,81 @@ bool QFileSystemEngine::cloneFile(int srcfd, int dstfd, const QFileSystemMetaDat
 #endif
 }
 
+// Copies up to \a maxSize bytes from \a srcfd, starting at \a srcOffset, to
+// \a dstfd inside the kernel. The data is written at \a dstOffset, or at the
+// current position of \a dstfd if \a dstOffset is -1 (for pipes and
+// sockets). Returns -1 if the kernel cannot copy between these descriptors,
+// in which case nothing was copied. Otherwise, returns the number of bytes
+// copied; if that is less than \a maxSize, \a error is either unset (the end
+// of \a srcfd was reached), EAGAIN (\a dstfd is non-blocking and cannot take
+// more data) or a real error.
+qint64 QFileSystemEngine::transferData(int srcfd, qint64 srcOffset, int dstfd, qint64 dstOffset,
+                                       qint64 maxSize, QSystemError &error)
+{
+    error = QSystemError();
+#if defined(Q_OS_LINUX)
+    // sendfile(2) is limited in the kernel to 2G - 4k
+    const qint64 MaxChunkSize = 0x7ffff000;
+
+    enum Method { CopyFileRange, Sendfile };
+    Method method = dstOffset == -1 ? Sendfile : CopyFileRange;
+    qint64 copied = 0;
+    while (copied < maxSize) {
+        const size_t chunkSize = size_t(qMin(maxSize - copied, MaxChunkSize));
+        ssize_t n;
+        if (method == CopyFileRange) {
+#ifdef SYS_copy_file_range
+            loff_t in = srcOffset + copied;
+            loff_t out = dstOffset + copied;
+            n = ::syscall(SYS_copy_file_range, srcfd, &in, dstfd, &out, chunkSize, 0u);
+            // copy_file_range does not work across file systems before
+            // Linux 5.3 and on some special files, where older kernels also
+            // report 0 bytes instead of failing
+            if (copied == 0 && (n == 0 || (n == -1 && errno != EINTR && errno != ENOSPC
+                                           && errno != EIO && errno != EFBIG))) {
+                method = Sendfile;
+                continue;
+            }
+#else
+            method = Sendfile;
+            continue;
+#endif
+        } else {
+            if (dstOffset != -1 && QT_LSEEK(dstfd, dstOffset + copied, SEEK_SET) == -1) {
+                if (copied == 0)
+                    return -1;
+                error = QSystemError(errno, QSystemError::StandardLibraryError);
+                break;
+            }
+            off_t in = srcOffset + copied;
+            n = ::sendfile(dstfd, srcfd, &in, chunkSize);
+            if (n == -1 && copied == 0 && errno != EINTR && errno != EAGAIN
+                    && errno != ENOSPC && errno != EIO && errno != EPIPE) {
+                return -1;
+            }
+        }
+
+        if (n == -1) {
+            if (errno == EINTR)
+                continue;
+            error = QSystemError(errno, QSystemError::StandardLibraryError);
+            break;
+        }
+        if (n == 0)
+            break;      // end of file
+        copied += n;
+    }
+    return copied;
+#else
+    Q_UNUSED(srcfd);
+    Q_UNUSED(srcOffset);
+    Q_UNUSED(dstfd);
+    Q_UNUSED(dstOffset);
+    Q_UNUSED(maxSize);
+    return -1;
+#endif
+}
+
 // Note: if \a shouldMkdirFirst is false, we assume the caller did try to mkdir
 // before calling this function.
 static bool createDirectoryWithParents(const QByteArray &nativeName, bool shouldMkdirFirst = true)
@@ -1147,6 +1407,7 @@ static bool createDirectoryWithParents(const QByteArray &nativeName, bool should
 //static
 bool QFileSystemEngine::createDirectory(const QFileSystemEntry &entry, bool createParents)
 {
+    QFileSystemMetaDataCache::invalidate(entry);
     QString dirName = entry.filePath();
     Q_CHECK_FILE_NAME(dirName, false);
 
@@ -1167,6 +1428,7 @@ bool QFileSystemEngine::createDirectory(const QFileSystemEntry &entry, bool crea
 //static
 bool QFileSystemEngine::removeDirectory(const QFileSystemEntry &entry, bool removeEmptyParents)
 {
+    QFileSystemMetaDataCache::clear();
     Q_CHECK_FILE_NAME(entry, false);
 
     if (removeEmptyParents) {
@@ -1192,6 +1454,7 @@ bool QFileSystemEngine::removeDirectory(const QFileSystemEntry &entry, bool remo
 //static
 bool QFileSystemEngine::createLink(const QFileSystemEntry &source, const QFileSystemEntry &target, QSystemError &error)
 {
+    QFileSystemMetaDataCache::invalidate(target);
     Q_CHECK_FILE_NAME(source, false);
     Q_CHECK_FILE_NAME(target, false);
 
@@ -1314,6 +1577,7 @@ static QString freeDesktopTrashLocation(const QString &sourcePath)
 bool QFileSystemEngine::moveFileToTrash(const QFileSystemEntry &source,
                                         QFileSystemEntry &newLocation, QSystemError &error)
 {
+    QFileSystemMetaDataCache::clear();
 #ifdef QT_BOOTSTRAPPED
     Q_UNUSED(source);
     Q_UNUSED(newLocation);
@@ -1417,6 +1681,7 @@ bool QFileSystemEngine::moveFileToTrash(const QFileSystemEntry &source,
 //static
 bool QFileSystemEngine::copyFile(const QFileSystemEntry &source, const QFileSystemEntry &target, QSystemError &error)
 {
+    QFileSystemMetaDataCache::invalidate(target);
 #if defined(Q_OS_DARWIN)
     if (::clonefile(source.nativeFilePath().constData(),
                     target.nativeFilePath().constData(), 0) == 0)
@@ -1434,6 +1699,7 @@ bool QFileSystemEngine::copyFile(const QFileSystemEntry &source, const QFileSyst
 //static
 bool QFileSystemEngine::renameFile(const QFileSystemEntry &source, const QFileSystemEntry &target, QSystemError &error)
 {
+    QFileSystemMetaDataCache::clear();
     QFileSystemEntry::NativePath srcPath = source.nativeFilePath();
     QFileSystemEntry::NativePath tgtPath = target.nativeFilePath();
 
@@ -1506,6 +1772,7 @@ bool QFileSystemEngine::renameFile(const QFileSystemEntry &source, const QFileSy
 //static
 bool QFileSystemEngine::renameOverwriteFile(const QFileSystemEntry &source, const QFileSystemEntry &target, QSystemError &error)
 {
+    QFileSystemMetaDataCache::clear();
     Q_CHECK_FILE_NAME(source, false);
     Q_CHECK_FILE_NAME(target, false);
 
@@ -1518,6 +1785,7 @@ bool QFileSystemEngine::renameOverwriteFile(const QFileSystemEntry &source, cons
 //static
 bool QFileSystemEngine::removeFile(const QFileSystemEntry &entry, QSystemError &error)
 {
+    QFileSystemMetaDataCache::invalidate(entry);
     Q_CHECK_FILE_NAME(entry, false);
     if (unlink(entry.nativeFilePath().constData()) == 0)
         return true;
@@ -1553,6 +1821,7 @@ static mode_t toMode_t(QFile::Permissions permissions)
 //static
 bool QFileSystemEngine::setPermissions(const QFileSystemEntry &entry, QFile::Permissions permissions, QSystemError &error, QFileSystemMetaData *data)
 {
+    QFileSystemMetaDataCache::invalidate(entry);
     Q_CHECK_FILE_NAME(entry, false);
 
     mode_t mode = toMode_t(permissions);
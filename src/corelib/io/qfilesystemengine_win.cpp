@@ -1015,6 +1015,14 @@ bool QFileSystemEngine::fillMetaData(HANDLE fHandle, QFileSystemMetaData &data,
 
 static bool isDirPath(const QString &dirPath, bool *existed);
 
+//static
+bool QFileSystemEngine::fillRequestedMetaData(const QFileSystemEntry &entry, QFileSystemMetaData &data,
+                                              QFileSystemMetaData::MetaDataFlags what)
+{
+    // The attribute data comes in one piece anyway
+    return fillMetaData(entry, data, what);
+}
+
 //static
 bool QFileSystemEngine::fillMetaData(const QFileSystemEntry &entry, QFileSystemMetaData &data,
                                      QFileSystemMetaData::MetaDataFlags what)
@@ -1160,6 +1168,7 @@ static bool createDirectoryWithParents(const QString &nativeName, bool shouldMkd
 //static
 bool QFileSystemEngine::createDirectory(const QFileSystemEntry &entry, bool createParents)
 {
+    QFileSystemMetaDataCache::invalidate(entry);
     QString dirName = entry.filePath();
     Q_CHECK_FILE_NAME(dirName, false);
 
@@ -1181,6 +1190,7 @@ bool QFileSystemEngine::createDirectory(const QFileSystemEntry &entry, bool crea
 //static
 bool QFileSystemEngine::removeDirectory(const QFileSystemEntry &entry, bool removeEmptyParents)
 {
+    QFileSystemMetaDataCache::clear();
     QString dirName = entry.filePath();
     Q_CHECK_FILE_NAME(dirName, false);
 
@@ -1313,9 +1323,9 @@ QFileSystemEntry QFileSystemEngine::currentPath()
 //static
 bool QFileSystemEngine::createLink(const QFileSystemEntry &source, const QFileSystemEntry &target, QSystemError &error)
 {
+    QFileSystemMetaDataCache::invalidate(target);
     Q_ASSERT(false);
     Q_UNUSED(source);
-    Q_UNUSED(target);
     Q_UNUSED(error);
 
     return false; // TODO implement; - code needs to be moved from qfsfileengine_win.cpp
@@ -1324,6 +1334,7 @@ bool QFileSystemEngine::createLink(const QFileSystemEntry &source, const QFileSy
 //static
 bool QFileSystemEngine::copyFile(const QFileSystemEntry &source, const QFileSystemEntry &target, QSystemError &error)
 {
+    QFileSystemMetaDataCache::invalidate(target);
     bool ret = ::CopyFile((wchar_t*)source.nativeFilePath().utf16(),
                           (wchar_t*)target.nativeFilePath().utf16(), true) != 0;
     if(!ret)
@@ -1334,6 +1345,7 @@ bool QFileSystemEngine::copyFile(const QFileSystemEntry &source, const QFileSyst
 //static
 bool QFileSystemEngine::renameFile(const QFileSystemEntry &source, const QFileSystemEntry &target, QSystemError &error)
 {
+    QFileSystemMetaDataCache::clear();
     Q_CHECK_FILE_NAME(source, false);
     Q_CHECK_FILE_NAME(target, false);
 
@@ -1347,6 +1359,7 @@ bool QFileSystemEngine::renameFile(const QFileSystemEntry &source, const QFileSy
 //static
 bool QFileSystemEngine::renameOverwriteFile(const QFileSystemEntry &source, const QFileSystemEntry &target, QSystemError &error)
 {
+    QFileSystemMetaDataCache::clear();
     Q_CHECK_FILE_NAME(source, false);
     Q_CHECK_FILE_NAME(target, false);
 
@@ -1361,6 +1374,7 @@ bool QFileSystemEngine::renameOverwriteFile(const QFileSystemEntry &source, cons
 //static
 bool QFileSystemEngine::removeFile(const QFileSystemEntry &entry, QSystemError &error)
 {
+    QFileSystemMetaDataCache::invalidate(entry);
     Q_CHECK_FILE_NAME(entry, false);
 
     bool ret = ::DeleteFile((wchar_t*)entry.nativeFilePath().utf16()) != 0;
@@ -1379,6 +1393,7 @@ bool QFileSystemEngine::removeFile(const QFileSystemEntry &entry, QSystemError &
 bool QFileSystemEngine::moveFileToTrash(const QFileSystemEntry &source,
                                         QFileSystemEntry &newLocation, QSystemError &error)
 {
+    QFileSystemMetaDataCache::clear();
     // we need the "display name" of the file, so can't use nativeAbsoluteFilePath
     const QString sourcePath = QDir::toNativeSeparators(absoluteName(source).filePath());
 
@@ -1463,6 +1478,7 @@ bool QFileSystemEngine::moveFileToTrash(const QFileSystemEntry &source,
 bool QFileSystemEngine::setPermissions(const QFileSystemEntry &entry, QFile::Permissions permissions, QSystemError &error,
                                        QFileSystemMetaData *data)
 {
+    QFileSystemMetaDataCache::invalidate(entry);
     Q_CHECK_FILE_NAME(entry, false);
 
     Q_UNUSED(data);
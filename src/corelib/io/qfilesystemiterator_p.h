@@ -78,6 +78,9 @@ public:
     ~QFileSystemIterator();
 
     bool advance(QFileSystemEntry &fileEntry, QFileSystemMetaData &metaData);
+#if !defined(Q_OS_WIN)
+    bool fillCurrentMetaData(QFileSystemMetaData &metaData) const;
+#endif
 
 private:
     QFileSystemEntry::NativePath nativePath;
@@ -39,6 +39,7 @@
 
 #include "qplatformdefs.h"
 #include "qfilesystemiterator_p.h"
+#include "qfilesystemengine_p.h"
 
 #include <private/qstringconverter_p.h>
 
@@ -108,6 +109,16 @@ bool QFileSystemIterator::advance(QFileSystemEntry &fileEntry, QFileSystemMetaDa
     return false;
 }
 
+// Fills in the stat(2) data of the entry that advance() returned last. The
+// entry is looked up relative to the open directory, which avoids resolving
+// every component of its path again.
+bool QFileSystemIterator::fillCurrentMetaData(QFileSystemMetaData &metaData) const
+{
+    if (!dir || !dirEntry)
+        return false;
+    return QFileSystemEngine::fillMetaData(dirfd(dir), dirEntry->d_name, metaData);
+}
+
 QT_END_NAMESPACE
 
 #endif // QT_NO_FILESYSTEMITERATOR
@@ -88,7 +88,7 @@ QFileSystemWatcherEngine *QFileSystemWatcherPrivate::createNativeEngine(QObject
 }
 
 QFileSystemWatcherPrivate::QFileSystemWatcherPrivate()
-    : native(nullptr), poller(nullptr)
+    : native(nullptr), poller(nullptr), batchTimer(nullptr), batchInterval(100)
 {
 }
 
@@ -105,6 +105,10 @@ void QFileSystemWatcherPrivate::init()
                          SIGNAL(directoryChanged(QString,bool)),
                          q,
                          SLOT(_q_directoryChanged(QString,bool)));
+        QObject::connect(native,
+                         SIGNAL(pathsChanged(QStringList)),
+                         q,
+                         SLOT(_q_pathsChanged(QStringList)));
 #if defined(Q_OS_WIN)
         QObject::connect(static_cast<QWindowsFileSystemWatcherEngine *>(native),
                          &QWindowsFileSystemWatcherEngine::driveLockForRemoval,
@@ -162,6 +166,35 @@ void QFileSystemWatcherPrivate::_q_directoryChanged(const QString &path, bool re
     emit q->directoryChanged(path, QFileSystemWatcher::QPrivateSignal());
 }
 
+void QFileSystemWatcherPrivate::_q_pathsChanged(const QStringList &paths)
+{
+    Q_Q(QFileSystemWatcher);
+    qCDebug(lcWatcher) << "paths changed" << paths;
+    for (const QString &path : paths)
+        changedPaths.insert(path);
+
+    // The window starts with the first change, so that a steady stream of
+    // changes is still delivered once per interval.
+    if (!batchTimer) {
+        batchTimer = new QTimer(q);
+        batchTimer->setSingleShot(true);
+        QObject::connect(batchTimer, &QTimer::timeout, q, [this] { flushChangedPaths(); });
+    }
+    if (!batchTimer->isActive())
+        batchTimer->start(batchInterval);
+}
+
+void QFileSystemWatcherPrivate::flushChangedPaths()
+{
+    Q_Q(QFileSystemWatcher);
+    if (changedPaths.isEmpty())
+        return;
+    QStringList paths(changedPaths.cbegin(), changedPaths.cend());
+    changedPaths.clear();
+    std::sort(paths.begin(), paths.end());
+    emit q->pathsChanged(paths, QFileSystemWatcher::QPrivateSignal());
+}
+
 #if defined(Q_OS_WIN)
 
 void QFileSystemWatcherPrivate::_q_winDriveLockForRemoval(const QString &path)
@@ -229,6 +262,12 @@ void  QFileSystemWatcherPrivate::_q_winDriveRemoved(const QString &path)
     they have been renamed or removed from disk, and directories once
     they have been removed from disk.
 
+    addRecursivePath() watches a whole directory tree instead, including
+    directories created in it later on. Changes anywhere in the tree are
+    coalesced and reported together by the pathsChanged() signal, at most
+    once per batchInterval(), which avoids a signal per change when many
+    files change at once.
+
     \list
     \li \b Notes:
     \list
@@ -489,6 +528,137 @@ QStringList QFileSystemWatcher::removePaths(const QStringList &paths)
     \sa directories()
 */
 
+/*!
+    \since 6.0
+
+    Starts watching the directory \a path and all directories below it,
+    including the ones created after this call. Changes to files and
+    directories in the tree are reported by the pathsChanged() signal.
+
+    Returns \c true if the tree is being watched. Returns \c false if
+    \a path is not a directory, if it is already watched or overlaps with
+    a tree that is already watched, or if the platform does not support
+    watching directory trees. Currently, this is supported on Linux only.
+
+    On Linux, a fanotify filesystem mark is used if the process is
+    permitted to set one, so that setting up the watch does not depend on
+    the size of the tree. Otherwise an inotify watch is added for every
+    directory of the tree. If the system drops events, for example
+    because its event queue overflowed, the tree is re-scanned for new
+    directories and \a path itself is reported as changed, meaning that
+    anything below it may have changed.
+
+    Trees watched by this function are not listed by directories().
+
+    \sa removeRecursivePath(), recursivePaths(), pathsChanged()
+*/
+bool QFileSystemWatcher::addRecursivePath(const QString &path)
+{
+    Q_D(QFileSystemWatcher);
+    if (path.isEmpty()) {
+        qWarning("QFileSystemWatcher::addRecursivePath: path is empty");
+        return false;
+    }
+    qCDebug(lcWatcher) << "adding recursive" << path;
+
+    const QString cleanPath = QDir::cleanPath(QFileInfo(path).absoluteFilePath());
+    if (!d->native || !QFileInfo(cleanPath).isDir() || !d->native->addRecursivePath(cleanPath))
+        return false;
+    d->recursivePaths.append(cleanPath);
+    return true;
+}
+
+/*!
+    \since 6.0
+
+    Stops watching the directory tree below \a path, which must have been
+    added with addRecursivePath(). Changes in that tree that have not been
+    reported yet are dropped.
+
+    Returns \c true if the tree was being watched.
+
+    \sa addRecursivePath()
+*/
+bool QFileSystemWatcher::removeRecursivePath(const QString &path)
+{
+    Q_D(QFileSystemWatcher);
+    const QString cleanPath = QDir::cleanPath(QFileInfo(path).absoluteFilePath());
+    if (!d->recursivePaths.contains(cleanPath))
+        return false;
+    qCDebug(lcWatcher) << "removing recursive" << path;
+
+    d->recursivePaths.removeAll(cleanPath);
+    d->native->removeRecursivePath(cleanPath);
+
+    const QString prefix = cleanPath + QLatin1Char('/');
+    for (auto it = d->changedPaths.begin(); it != d->changedPaths.end(); ) {
+        if (*it == cleanPath || it->startsWith(prefix))
+            it = d->changedPaths.erase(it);
+        else
+            ++it;
+    }
+    return true;
+}
+
+/*!
+    \since 6.0
+
+    Returns the list of directory trees that are being watched, as clean
+    absolute paths.
+
+    \sa addRecursivePath()
+*/
+QStringList QFileSystemWatcher::recursivePaths() const
+{
+    Q_D(const QFileSystemWatcher);
+    return d->recursivePaths;
+}
+
+/*!
+    \since 6.0
+
+    Sets the interval in which changes in the trees added by
+    addRecursivePath() are collected before they are reported together by
+    pathsChanged() to \a msec milliseconds. The default is 100
+    milliseconds. With an interval of 0, changes are reported as soon as
+    control returns to the event loop.
+
+    \sa batchInterval()
+*/
+void QFileSystemWatcher::setBatchInterval(int msec)
+{
+    Q_D(QFileSystemWatcher);
+    d->batchInterval = qMax(0, msec);
+}
+
+/*!
+    \since 6.0
+
+    Returns the interval in milliseconds in which changes are collected
+    before pathsChanged() is emitted.
+
+    \sa setBatchInterval()
+*/
+int QFileSystemWatcher::batchInterval() const
+{
+    Q_D(const QFileSystemWatcher);
+    return d->batchInterval;
+}
+
+/*!
+    \fn void QFileSystemWatcher::pathsChanged(const QStringList &paths)
+    \since 6.0
+
+    This signal is emitted when files or directories in a tree added by
+    addRecursivePath() were created, modified, removed or renamed, or had
+    their attributes changed. \a paths lists the absolute paths that
+    changed since the signal was last emitted, sorted and without
+    duplicates. A renamed entry is reported under both its old and its
+    new name.
+
+    \sa setBatchInterval()
+*/
+
 QStringList QFileSystemWatcher::directories() const
 {
     Q_D(const QFileSystemWatcher);
@@ -67,13 +67,22 @@ public:
     QStringList files() const;
     QStringList directories() const;
 
+    bool addRecursivePath(const QString &path);
+    bool removeRecursivePath(const QString &path);
+    QStringList recursivePaths() const;
+
+    void setBatchInterval(int msec);
+    int batchInterval() const;
+
 Q_SIGNALS:
     void fileChanged(const QString &path, QPrivateSignal);
     void directoryChanged(const QString &path, QPrivateSignal);
+    void pathsChanged(const QStringList &paths, QPrivateSignal);
 
 private:
     Q_PRIVATE_SLOT(d_func(), void _q_fileChanged(const QString &path, bool removed))
     Q_PRIVATE_SLOT(d_func(), void _q_directoryChanged(const QString &path, bool removed))
+    Q_PRIVATE_SLOT(d_func(), void _q_pathsChanged(const QStringList &paths))
 };
 
 QT_END_NAMESPACE
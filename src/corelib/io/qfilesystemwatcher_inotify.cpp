@@ -57,6 +57,17 @@
 #include <fcntl.h>
 #endif
 
+#if defined(Q_OS_LINUX) && __has_include(<sys/fanotify.h>)
+#  include <sys/fanotify.h>
+#  include <sys/vfs.h>
+#  if defined(FAN_REPORT_DFID_NAME) && defined(FAN_MARK_FILESYSTEM) && defined(MAX_HANDLE_SZ)
+#    define QT_FILESYSTEMWATCHER_FANOTIFY
+#  endif
+#endif
+
+#include <dirent.h>
+#include <sys/stat.h>
+
 #if defined(QT_NO_INOTIFY)
 
 #if defined(Q_OS_QNX)
@@ -208,6 +219,9 @@ struct inotify_event {
 #define IN_UNMOUNT              0x00002000
 #define IN_Q_OVERFLOW           0x00004000
 #define IN_IGNORED              0x00008000
+#define IN_ONLYDIR              0x01000000
+#define IN_DONT_FOLLOW          0x02000000
+#define IN_ISDIR                0x40000000
 
 #define IN_CLOSE                (IN_CLOSE_WRITE | IN_CLOSE_NOWRITE)
 #define IN_MOVE                 (IN_MOVED_FROM | IN_MOVED_TO)
@@ -233,17 +247,22 @@ static inline int inotify_init1(int flags)
 
 QT_BEGIN_NAMESPACE
 
-QInotifyFileSystemWatcherEngine *QInotifyFileSystemWatcherEngine::create(QObject *parent)
+static int createInotifyFd()
 {
     int fd = -1;
 #if defined(IN_CLOEXEC)
     fd = inotify_init1(IN_CLOEXEC);
 #endif
-    if (fd == -1) {
+    if (fd == -1)
         fd = inotify_init();
-        if (fd == -1)
-            return nullptr;
-    }
+    return fd;
+}
+
+QInotifyFileSystemWatcherEngine *QInotifyFileSystemWatcherEngine::create(QObject *parent)
+{
+    int fd = createInotifyFd();
+    if (fd == -1)
+        return nullptr;
     return new QInotifyFileSystemWatcherEngine(fd, parent);
 }
 
@@ -263,6 +282,17 @@ QInotifyFileSystemWatcherEngine::~QInotifyFileSystemWatcherEngine()
         inotify_rm_watch(inotifyFd, id < 0 ? -id : id);
 
     ::close(inotifyFd);
+
+    if (recursiveNotifier) {
+        recursiveNotifier->setEnabled(false);
+        ::close(recursiveFd);
+    }
+    if (fanotifyNotifier) {
+        fanotifyNotifier->setEnabled(false);
+        for (const FanotifyRoot &root : qAsConst(fanotifyRoots))
+            qt_safe_close(root.fd);
+        qt_safe_close(fanotifyFd);
+    }
 }
 
 QStringList QInotifyFileSystemWatcherEngine::addPaths(const QStringList &paths,
@@ -422,6 +452,426 @@ void QInotifyFileSystemWatcherEngine::readFromInotify()
     }
 }
 
+/*
+    Recursive watches.
+
+    Directory trees are watched with a fanotify filesystem mark if the
+    process is permitted to set one: this is a single call no matter how
+    large the tree is, and the events identify the directory by a file
+    handle, which we resolve to a path and filter by the watched trees.
+
+    Otherwise, every directory of the tree gets an inotify watch. New
+    directories are added as their creation is reported, so the watch
+    before listing a directory ensures that nothing created in between is
+    missed. If the kernel drops events because the queue overflowed, the
+    trees are re-scanned for directories that have no watch yet, and their
+    roots are reported as changed.
+
+    Either way, the paths from one read of the queue are reported in one
+    pathsChanged() signal, and QFileSystemWatcher coalesces them further.
+*/
+
+static const quint32 recursiveWatchMask = IN_ATTRIB | IN_MODIFY | IN_MOVE | IN_CREATE | IN_DELETE
+        | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR | IN_DONT_FOLLOW;
+
+static inline bool isInTree(const QString &path, const QString &root)
+{
+    return path.startsWith(root)
+            && (path.size() == root.size() || root.endsWith(QLatin1Char('/'))
+                || path.at(root.size()) == QLatin1Char('/'));
+}
+
+static inline QString childPath(const QString &directory, const QString &name)
+{
+    if (directory.endsWith(QLatin1Char('/')))
+        return directory + name;
+    return directory + QLatin1Char('/') + name;
+}
+
+bool QInotifyFileSystemWatcherEngine::isRecursivelyWatched(const QString &path) const
+{
+    const auto overlaps = [&path](const QString &root) {
+        return isInTree(path, root) || isInTree(root, path);
+    };
+    if (std::any_of(recursiveRoots.cbegin(), recursiveRoots.cend(), overlaps))
+        return true;
+    return std::any_of(fanotifyRoots.cbegin(), fanotifyRoots.cend(),
+                       [&](const FanotifyRoot &root) { return overlaps(root.path); });
+}
+
+bool QInotifyFileSystemWatcherEngine::addRecursivePath(const QString &path)
+{
+    if (isRecursivelyWatched(path))
+        return false;
+
+#ifdef QT_FILESYSTEMWATCHER_FANOTIFY
+    if (addFanotifyPath(path))
+        return true;
+#endif
+
+    if (!recursiveNotifier) {
+        recursiveFd = createInotifyFd();
+        if (recursiveFd == -1)
+            return false;
+        recursiveNotifier = new QSocketNotifier(recursiveFd, QSocketNotifier::Read, this);
+        connect(recursiveNotifier, SIGNAL(activated(QSocketDescriptor)),
+                SLOT(readFromRecursiveInotify()));
+    }
+
+    addRecursiveWatches(path);
+    if (!recursivePathToWd.contains(path))
+        return false;
+    recursiveRoots.append(path);
+    return true;
+}
+
+bool QInotifyFileSystemWatcherEngine::removeRecursivePath(const QString &path)
+{
+    if (recursiveRoots.removeAll(path)) {
+        removeRecursiveWatches(path);
+        return true;
+    }
+
+#ifdef QT_FILESYSTEMWATCHER_FANOTIFY
+    for (int i = 0; i < fanotifyRoots.size(); ++i) {
+        const FanotifyRoot root = fanotifyRoots.at(i);
+        if (root.path != path)
+            continue;
+        fanotifyRoots.removeAt(i);
+
+        const auto sameFilesystem = [&root](const FanotifyRoot &other) {
+            return other.fsid == root.fsid;
+        };
+        if (std::none_of(fanotifyRoots.cbegin(), fanotifyRoots.cend(), sameFilesystem)) {
+            fanotify_mark(fanotifyFd, FAN_MARK_REMOVE | FAN_MARK_FILESYSTEM, 0,
+                          root.fd, nullptr);
+        }
+        qt_safe_close(root.fd);
+        fanotifyHandleToPath.clear();
+        return true;
+    }
+#endif
+    return false;
+}
+
+// Adds watches for the directory \a path and all directories below it. If
+// \a newEntries is set, everything found is appended to it.
+void QInotifyFileSystemWatcherEngine::addRecursiveWatches(const QString &path,
+                                                          QStringList *newEntries)
+{
+    QStringList pending(path);
+    while (!pending.isEmpty()) {
+        const QString directory = pending.takeLast();
+        const QByteArray encodedDirectory = QFile::encodeName(directory);
+
+        const int wd = inotify_add_watch(recursiveFd, encodedDirectory, recursiveWatchMask);
+        if (wd < 0) {
+            if (errno == ENOSPC && !recursiveWatchLimitReached) {
+                recursiveWatchLimitReached = true;
+                qErrnoWarning("inotify_add_watch(%s) failed, the directory tree is not fully watched:",
+                              qPrintable(directory));
+            }
+            continue;
+        }
+
+        // the directory may have had a watch under another name before it was moved
+        const auto previous = recursiveWdToPath.constFind(wd);
+        if (previous != recursiveWdToPath.constEnd() && *previous != directory)
+            recursivePathToWd.remove(*previous);
+        recursiveWdToPath.insert(wd, directory);
+        recursivePathToWd.insert(directory, wd);
+
+        DIR *dir = ::opendir(encodedDirectory.constData());
+        if (!dir)
+            continue;
+        while (const dirent *entry = ::readdir(dir)) {
+            const char *name = entry->d_name;
+            if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+                continue;
+
+            bool isDirectory = entry->d_type == DT_DIR;
+            if (entry->d_type == DT_UNKNOWN) {
+                QT_STATBUF st;
+                const QByteArray encodedPath = encodedDirectory + '/' + name;
+                isDirectory = QT_LSTAT(encodedPath.constData(), &st) == 0 && S_ISDIR(st.st_mode);
+            }
+            if (isDirectory || newEntries) {
+                const QString entryPath = childPath(directory, QFile::decodeName(name));
+                if (newEntries)
+                    newEntries->append(entryPath);
+                if (isDirectory)
+                    pending.append(entryPath);
+            }
+        }
+        ::closedir(dir);
+    }
+}
+
+void QInotifyFileSystemWatcherEngine::removeRecursiveWatches(const QString &path)
+{
+    auto it = recursivePathToWd.lowerBound(path);
+    while (it != recursivePathToWd.end() && it.key().startsWith(path)) {
+        if (!isInTree(it.key(), path)) {
+            ++it;
+            continue;
+        }
+        inotify_rm_watch(recursiveFd, it.value());
+        recursiveWdToPath.remove(it.value());
+        it = recursivePathToWd.erase(it);
+    }
+}
+
+void QInotifyFileSystemWatcherEngine::rescanRecursivePaths(QStringList *changed)
+{
+    for (const QString &root : qAsConst(recursiveRoots)) {
+        addRecursiveWatches(root);
+        changed->append(root);
+    }
+    for (const FanotifyRoot &root : qAsConst(fanotifyRoots))
+        changed->append(root.path);
+    fanotifyHandleToPath.clear();
+}
+
+void QInotifyFileSystemWatcherEngine::readFromRecursiveInotify()
+{
+    int buffSize = 0;
+    ioctl(recursiveFd, FIONREAD, (char *) &buffSize);
+    QVarLengthArray<char, 4096> buffer(buffSize);
+    buffSize = read(recursiveFd, buffer.data(), buffSize);
+    const char *at = buffer.data();
+    const char * const end = at + qMax(buffSize, 0);
+
+    QStringList changed;
+    bool overflow = false;
+    while (at < end) {
+        const inotify_event &event = *reinterpret_cast<const inotify_event *>(at);
+        at += sizeof(inotify_event) + event.len;
+
+        if (event.mask & IN_Q_OVERFLOW) {
+            overflow = true;
+            continue;
+        }
+        const auto it = recursiveWdToPath.constFind(event.wd);
+        if (it == recursiveWdToPath.constEnd())
+            continue;
+        const QString directory = *it;
+
+        if (event.mask & IN_IGNORED) {
+            // the directory is gone, or we removed the watch ourselves
+            if (recursivePathToWd.value(directory, -1) == event.wd)
+                recursivePathToWd.remove(directory);
+            recursiveWdToPath.remove(event.wd);
+            continue;
+        }
+
+        const QString path = (event.len > 0 && event.name[0])
+                ? childPath(directory, QFile::decodeName(event.name)) : directory;
+        changed.append(path);
+
+        if (event.mask & IN_ISDIR) {
+            if (event.mask & IN_MOVED_FROM)
+                removeRecursiveWatches(path);
+            else if (event.mask & (IN_CREATE | IN_MOVED_TO))
+                addRecursiveWatches(path, &changed);
+        }
+    }
+
+    if (overflow)
+        rescanRecursivePaths(&changed);
+    if (!changed.isEmpty())
+        emit pathsChanged(changed);
+}
+
+#ifdef QT_FILESYSTEMWATCHER_FANOTIFY
+namespace {
+struct FileHandle
+{
+    file_handle handle;
+    unsigned char data[MAX_HANDLE_SZ];
+};
+}
+
+static const quint64 fanotifyMask = FAN_CREATE | FAN_DELETE | FAN_MOVED_FROM | FAN_MOVED_TO
+        | FAN_MODIFY | FAN_ATTRIB | FAN_DELETE_SELF | FAN_MOVE_SELF | FAN_ONDIR;
+
+static QString pathOfFd(int fd)
+{
+    char buffer[PATH_MAX];
+    const QByteArray link = "/proc/self/fd/" + QByteArray::number(fd);
+    const ssize_t len = ::readlink(link.constData(), buffer, sizeof(buffer));
+    return len > 0 ? QFile::decodeName(QByteArray(buffer, int(len))) : QString();
+}
+
+bool QInotifyFileSystemWatcherEngine::addFanotifyPath(const QString &path)
+{
+    if (fanotifyUnavailable)
+        return false;
+
+    if (!fanotifyNotifier) {
+        // Filesystem marks need CAP_SYS_ADMIN, so this fails for most
+        // processes; we then use inotify for good.
+        if (qEnvironmentVariableIsSet("QT_NO_FANOTIFY"))
+            fanotifyFd = -1;
+        else
+            fanotifyFd = fanotify_init(FAN_CLASS_NOTIF | FAN_CLOEXEC | FAN_NONBLOCK | FAN_REPORT_DFID_NAME,
+                                       O_RDONLY | O_CLOEXEC);
+        if (fanotifyFd == -1) {
+            fanotifyUnavailable = true;
+            return false;
+        }
+        fanotifyNotifier = new QSocketNotifier(fanotifyFd, QSocketNotifier::Read, this);
+        connect(fanotifyNotifier, SIGNAL(activated(QSocketDescriptor)), SLOT(readFromFanotify()));
+    }
+
+    FanotifyRoot root;
+    root.path = path;
+    root.fd = qt_safe_open(QFile::encodeName(path).constData(), O_RDONLY | O_DIRECTORY);
+    if (root.fd == -1)
+        return false;
+    auto closeRoot = qScopeGuard([&root] { qt_safe_close(root.fd); });
+
+    // Resolving the handles in the events needs CAP_DAC_READ_SEARCH, so try
+    // it on the root first.
+    struct statfs fs;
+    FileHandle fileHandle;
+    fileHandle.handle.handle_bytes = MAX_HANDLE_SZ;
+    int mountId;
+    if (::fstatfs(root.fd, &fs) == -1
+        || ::name_to_handle_at(root.fd, "", &fileHandle.handle, &mountId, AT_EMPTY_PATH) == -1) {
+        return false;
+    }
+    const int probe = ::open_by_handle_at(root.fd, &fileHandle.handle, O_PATH | O_CLOEXEC);
+    if (probe == -1)
+        return false;
+    root.resolvedPath = pathOfFd(probe);
+    qt_safe_close(probe);
+
+    root.fsid = QByteArray(reinterpret_cast<const char *>(&fs.f_fsid), sizeof(fs.f_fsid));
+    const auto sameFilesystem = [&root](const FanotifyRoot &other) {
+        return other.fsid == root.fsid;
+    };
+    if (std::none_of(fanotifyRoots.cbegin(), fanotifyRoots.cend(), sameFilesystem)
+        && fanotify_mark(fanotifyFd, FAN_MARK_ADD | FAN_MARK_FILESYSTEM, fanotifyMask,
+                         root.fd, nullptr) == -1) {
+        if (errno == EPERM)
+            fanotifyUnavailable = true;
+        return false;
+    }
+
+    closeRoot.dismiss();
+    fanotifyRoots.append(root);
+    return true;
+}
+
+// Returns the path of the directory identified by \a fsid and \a fileHandle
+// within one of the watched trees, or a null string if it is not in any.
+QString QInotifyFileSystemWatcherEngine::fanotifyDirectoryPath(const char *fsid,
+                                                               const void *fileHandle)
+{
+    const FileHandle &handle = *static_cast<const FileHandle *>(fileHandle);
+    QByteArray key(fsid, sizeof(__kernel_fsid_t));
+    key.append(reinterpret_cast<const char *>(&handle.handle.handle_type), sizeof(int));
+    key.append(reinterpret_cast<const char *>(handle.handle.f_handle), handle.handle.handle_bytes);
+    const auto cached = fanotifyHandleToPath.constFind(key);
+    if (cached != fanotifyHandleToPath.constEnd())
+        return *cached;
+
+    QString resolvedPath;
+    for (const FanotifyRoot &root : qAsConst(fanotifyRoots)) {
+        if (!key.startsWith(root.fsid))
+            continue;
+        // open_by_handle_at() takes a non-const handle
+        FileHandle copy = handle;
+        const int fd = ::open_by_handle_at(root.fd, &copy.handle, O_PATH | O_CLOEXEC);
+        if (fd != -1) {
+            resolvedPath = pathOfFd(fd);
+            qt_safe_close(fd);
+        }
+        break;
+    }
+
+    QString path;
+    for (const FanotifyRoot &root : qAsConst(fanotifyRoots)) {
+        if (!resolvedPath.isEmpty() && isInTree(resolvedPath, root.resolvedPath)) {
+            path = root.path + QStringView(resolvedPath).mid(root.resolvedPath.size());
+            break;
+        }
+    }
+
+    if (fanotifyHandleToPath.size() > 0x10000)
+        fanotifyHandleToPath.clear();
+    fanotifyHandleToPath.insert(key, path);
+    return path;
+}
+#endif // QT_FILESYSTEMWATCHER_FANOTIFY
+
+void QInotifyFileSystemWatcherEngine::readFromFanotify()
+{
+#ifdef QT_FILESYSTEMWATCHER_FANOTIFY
+    QStringList changed;
+    bool overflow = false;
+
+    alignas(fanotify_event_metadata) char buffer[16 * 1024];
+    for (;;) {
+        ssize_t len = ::read(fanotifyFd, buffer, sizeof(buffer));
+        if (len <= 0)
+            break;
+
+        auto *event = reinterpret_cast<fanotify_event_metadata *>(buffer);
+        for (; FAN_EVENT_OK(event, len); event = FAN_EVENT_NEXT(event, len)) {
+            if (event->vers != FANOTIFY_METADATA_VERSION)
+                break;
+            if (event->fd >= 0)
+                qt_safe_close(event->fd);
+            if (event->mask & FAN_Q_OVERFLOW) {
+                overflow = true;
+                continue;
+            }
+
+            const char *info = reinterpret_cast<const char *>(event) + event->metadata_len;
+            const char *end = reinterpret_cast<const char *>(event) + event->event_len;
+            while (info + sizeof(fanotify_event_info_header) <= end) {
+                fanotify_event_info_header header;
+                memcpy(&header, info, sizeof(header));
+                if (header.len < sizeof(header) || info + header.len > end)
+                    break;
+
+                if (header.info_type == FAN_EVENT_INFO_TYPE_DFID_NAME
+                    || header.info_type == FAN_EVENT_INFO_TYPE_DFID) {
+                    const char *fsid = info + offsetof(fanotify_event_info_fid, fsid);
+                    const char *handleData = info + offsetof(fanotify_event_info_fid, handle);
+                    FileHandle handle;
+                    memcpy(&handle.handle, handleData, sizeof(file_handle));
+                    if (handle.handle.handle_bytes > MAX_HANDLE_SZ)
+                        break;
+                    memcpy(&handle.handle, handleData, sizeof(file_handle) + handle.handle.handle_bytes);
+
+                    QString path = fanotifyDirectoryPath(fsid, &handle);
+                    if (!path.isEmpty()) {
+                        const char *name = handleData + sizeof(file_handle) + handle.handle.handle_bytes;
+                        if (header.info_type == FAN_EVENT_INFO_TYPE_DFID_NAME && qstrcmp(name, ".") != 0)
+                            path = childPath(path, QFile::decodeName(name));
+                        changed.append(path);
+                    }
+                }
+                info += header.len;
+            }
+
+            // the cached directory paths are stale once a directory moved or went away
+            if ((event->mask & FAN_ONDIR)
+                && (event->mask & (FAN_MOVED_FROM | FAN_DELETE | FAN_DELETE_SELF | FAN_MOVE_SELF))) {
+                fanotifyHandleToPath.clear();
+            }
+        }
+    }
+
+    if (overflow)
+        rescanRecursivePaths(&changed);
+    if (!changed.isEmpty())
+        emit pathsChanged(changed);
+#endif
+}
+
 template <typename Hash, typename Key>
 typename Hash::const_iterator
 find_last_in_equal_range(const Hash &c, const Key &key)
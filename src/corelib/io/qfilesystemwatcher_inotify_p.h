@@ -56,6 +56,7 @@
 QT_REQUIRE_CONFIG(filesystemwatcher);
 
 #include <QtCore/qhash.h>
+#include <QtCore/qmap.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/qsocketnotifier.h>
 
@@ -73,18 +74,56 @@ public:
     QStringList addPaths(const QStringList &paths, QStringList *files, QStringList *directories) override;
     QStringList removePaths(const QStringList &paths, QStringList *files, QStringList *directories) override;
 
+    bool addRecursivePath(const QString &path) override;
+    bool removeRecursivePath(const QString &path) override;
+
 private Q_SLOTS:
     void readFromInotify();
+    void readFromRecursiveInotify();
+    void readFromFanotify();
 
 private:
     QString getPathFromID(int id) const;
 
+    bool isRecursivelyWatched(const QString &path) const;
+    void addRecursiveWatches(const QString &path, QStringList *newDirectories = nullptr);
+    void removeRecursiveWatches(const QString &path);
+    void rescanRecursivePaths(QStringList *changed);
+    bool addFanotifyPath(const QString &path);
+    QString fanotifyDirectoryPath(const char *fsid, const void *fileHandle);
+
 private:
     QInotifyFileSystemWatcherEngine(int fd, QObject *parent);
     int inotifyFd;
     QHash<QString, int> pathToID;
     QMultiHash<int, QString> idToPath;
     QSocketNotifier notifier;
+
+    // Directory trees watched with one inotify watch per directory, on
+    // their own inotify instance so that their masks do not interfere
+    // with the watches above.
+    QStringList recursiveRoots;
+    int recursiveFd = -1;
+    QSocketNotifier *recursiveNotifier = nullptr;
+    QMap<QString, int> recursivePathToWd;
+    QHash<int, QString> recursiveWdToPath;
+    bool recursiveWatchLimitReached = false;
+
+    // Directory trees watched through fanotify filesystem marks. Events
+    // identify the directory by a file handle, resolved through one of
+    // the roots on the same filesystem.
+    struct FanotifyRoot
+    {
+        QString path;
+        QString resolvedPath;   // path as reported by the kernel
+        QByteArray fsid;
+        int fd;
+    };
+    QList<FanotifyRoot> fanotifyRoots;
+    int fanotifyFd = -1;
+    bool fanotifyUnavailable = false;
+    QSocketNotifier *fanotifyNotifier = nullptr;
+    QHash<QByteArray, QString> fanotifyHandleToPath;
 };
 
 
@@ -59,9 +59,12 @@ QT_REQUIRE_CONFIG(filesystemwatcher);
 
 #include <QtCore/qstringlist.h>
 #include <QtCore/qhash.h>
+#include <QtCore/qset.h>
 
 QT_BEGIN_NAMESPACE
 
+class QTimer;
+
 class QFileSystemWatcherEngine : public QObject
 {
     Q_OBJECT
@@ -84,10 +87,24 @@ public:
     virtual QStringList removePaths(const QStringList &paths,
                                     QStringList *files,
                                     QStringList *directories) = 0;
+    // starts watching the directory tree below \a path, reporting changes
+    // through pathsChanged(); returns false if the engine cannot watch
+    // directory trees
+    virtual bool addRecursivePath(const QString &path)
+    {
+        Q_UNUSED(path);
+        return false;
+    }
+    virtual bool removeRecursivePath(const QString &path)
+    {
+        Q_UNUSED(path);
+        return false;
+    }
 
 Q_SIGNALS:
     void fileChanged(const QString &path, bool removed);
     void directoryChanged(const QString &path, bool removed);
+    void pathsChanged(const QStringList &paths);
 };
 
 class QFileSystemWatcherPrivate : public QObjectPrivate
@@ -102,11 +119,18 @@ public:
     void initPollerEngine();
 
     QFileSystemWatcherEngine *native, *poller;
-    QStringList files, directories;
+    QStringList files, directories, recursivePaths;
+
+    // changes below recursivePaths, delivered once per batch interval
+    QSet<QString> changedPaths;
+    QTimer *batchTimer;
+    int batchInterval;
 
     // private slots
     void _q_fileChanged(const QString &path, bool removed);
     void _q_directoryChanged(const QString &path, bool removed);
+    void _q_pathsChanged(const QStringList &paths);
+    void flushChangedPaths();
 
 #if defined(Q_OS_WIN)
     void _q_winDriveLockForRemoval(const QString &);
@@ -250,6 +250,8 @@ bool QFSFileEngine::open(QIODevice::OpenMode openMode)
     d->fh = nullptr;
     d->fd = -1;
 
+    if (d->openMode & QIODevice::WriteOnly)
+        QFileSystemMetaDataCache::invalidate(d->fileEntry);
     return d->nativeOpen(d->openMode);
 }
 
@@ -386,6 +388,8 @@ bool QFSFileEnginePrivate::openFd(QIODevice::OpenMode openMode, int fd)
 bool QFSFileEngine::close()
 {
     Q_D(QFSFileEngine);
+    if (d->openMode & QIODevice::WriteOnly)
+        QFileSystemMetaDataCache::invalidate(d->fileEntry);
     d->openMode = QIODevice::NotOpen;
     return d->nativeClose();
 }
@@ -889,6 +893,17 @@ bool QFSFileEngine::extension(Extension extension, const ExtensionOption *option
         const UnMapExtensionOption *options = (const UnMapExtensionOption*)option;
         return d->unmap(options->address);
     }
+    if (extension == AdviseMapExtension) {
+        const AdviseMapExtensionOption *options = (const AdviseMapExtensionOption *)option;
+        return d->adviseMap(options->address, options->size, options->hints);
+    }
+#ifdef Q_OS_UNIX
+    if (extension == ScatterReadExtension) {
+        const ScatterReadExtensionOption *options = (const ScatterReadExtensionOption *)option;
+        ScatterReadExtensionReturn *returnValue = static_cast<ScatterReadExtensionReturn *>(output);
+        return d->nativeReadScattered(options, &returnValue->bytesRead);
+    }
+#endif
 
     return false;
 }
@@ -905,8 +920,13 @@ bool QFSFileEngine::supportsExtension(Extension extension) const
         return true;
     if (extension == FastReadLineExtension && d->fd != -1 && isSequential())
         return true;
-    if (extension == UnMapExtension || extension == MapExtension)
+    if (extension == UnMapExtension || extension == MapExtension
+            || extension == AdviseMapExtension)
         return true;
+#ifdef Q_OS_UNIX
+    if (extension == ScatterReadExtension && d->fd != -1 && !d->fh)
+        return true;
+#endif
     return false;
 }
 
@@ -171,6 +171,10 @@ public:
     qint64 nativeRead(char *data, qint64 maxlen);
     qint64 readFdFh(char *data, qint64 maxlen);
     qint64 nativeReadLine(char *data, qint64 maxlen);
+#ifdef Q_OS_UNIX
+    bool nativeReadScattered(const QAbstractFileEngine::ScatterReadExtensionOption *option,
+                             qint64 *bytesRead);
+#endif
     qint64 readLineFdFh(char *data, qint64 maxlen);
     qint64 nativeWrite(const char *data, qint64 len);
     qint64 writeFdFh(const char *data, qint64 len);
@@ -182,6 +186,7 @@ public:
 
     uchar *map(qint64 offset, qint64 size, QFile::MemoryMapFlags flags);
     bool unmap(uchar *ptr);
+    bool adviseMap(uchar *address, qint64 size, QFile::MemoryMapFlags hints);
     void unmapAll();
 
     mutable QFileSystemMetaData metaData;
@@ -53,6 +53,7 @@
 #include "qvarlengtharray.h"
 
 #include <sys/mman.h>
+#include <sys/uio.h>
 #include <stdlib.h>
 #include <limits.h>
 #include <errno.h>
@@ -256,6 +257,63 @@ qint64 QFSFileEnginePrivate::nativeRead(char *data, qint64 len)
     return readFdFh(data, len);
 }
 
+/*!
+    \internal
+
+    Reads into the buffers of \a option with readv(), retrying until they
+    are all full like readFdFh() does, and stores the number of bytes read
+    in \a bytesRead. Returns \c false without reading anything if the file
+    is accessed through stdio, whose buffering must not be bypassed.
+*/
+bool QFSFileEnginePrivate::nativeReadScattered(const QAbstractFileEngine::ScatterReadExtensionOption *option,
+                                               qint64 *bytesRead)
+{
+    Q_Q(QFSFileEngine);
+    if (fh || fd == -1 || option->count <= 0)
+        return false;
+#ifdef IOV_MAX
+    if (option->count > IOV_MAX)
+        return false;
+#endif
+
+    QVarLengthArray<struct iovec, 4> vectors(option->count);
+    for (int i = 0; i < option->count; ++i) {
+        if (option->buffers[i].size < 0 || option->buffers[i].size != qint64(size_t(option->buffers[i].size)))
+            return false;
+        vectors[i].iov_base = option->buffers[i].data;
+        vectors[i].iov_len = size_t(option->buffers[i].size);
+    }
+
+    qint64 readBytes = 0;
+    struct iovec *vector = vectors.data();
+    int remaining = vectors.size();
+    ssize_t result;
+    forever {
+        EINTR_LOOP(result, ::readv(fd, vector, remaining));
+        if (result <= 0)
+            break;
+        readBytes += result;
+
+        // Skip what was filled and retry with the rest
+        while (remaining && size_t(result) >= vector->iov_len) {
+            result -= vector->iov_len;
+            ++vector;
+            --remaining;
+        }
+        if (!remaining)
+            break;
+        vector->iov_base = static_cast<char *>(vector->iov_base) + result;
+        vector->iov_len -= size_t(result);
+    }
+
+    if (result < 0 && readBytes == 0) {
+        q->setError(QFile::ReadError, qt_error_string(errno));
+        readBytes = -1;
+    }
+    *bytesRead = readBytes;
+    return true;
+}
+
 /*!
     \internal
 */
@@ -510,6 +568,7 @@ QString QFSFileEngine::owner(FileOwner own) const
 bool QFSFileEngine::setPermissions(uint perms)
 {
     Q_D(QFSFileEngine);
+    QFileSystemMetaDataCache::invalidate(d->fileEntry);
     QSystemError error;
     bool ok;
     if (d->fd != -1)
@@ -526,6 +585,7 @@ bool QFSFileEngine::setPermissions(uint perms)
 bool QFSFileEngine::setSize(qint64 size)
 {
     Q_D(QFSFileEngine);
+    QFileSystemMetaDataCache::invalidate(d->fileEntry);
     bool ret = false;
     if (d->fd != -1)
         ret = QT_FTRUNCATE(d->fd, size) == 0;
@@ -541,6 +601,7 @@ bool QFSFileEngine::setSize(qint64 size)
 bool QFSFileEngine::setFileTime(const QDateTime &newDate, FileTime time)
 {
     Q_D(QFSFileEngine);
+    QFileSystemMetaDataCache::invalidate(d->fileEntry);
 
     if (d->openMode == QIODevice::NotOpen) {
         setError(QFile::PermissionsError, qt_error_string(EACCES));
@@ -557,6 +618,44 @@ bool QFSFileEngine::setFileTime(const QDateTime &newDate, FileTime time)
     return true;
 }
 
+// Passes the access hints in flags for the page-aligned memory range to the
+// kernel. MapPopulateOption prefaults the pages where the kernel can do that
+// on an existing mapping and turns into a read-ahead request otherwise.
+static bool adviseMemory(void *address, size_t size, QFile::MemoryMapFlags flags)
+{
+    bool ok = true;
+#ifdef MADV_SEQUENTIAL
+    if (flags & QFileDevice::MapSequentialHint)
+        ok &= madvise(address, size, MADV_SEQUENTIAL) == 0;
+#endif
+#ifdef MADV_RANDOM
+    if (flags & QFileDevice::MapRandomHint)
+        ok &= madvise(address, size, MADV_RANDOM) == 0;
+#endif
+#ifdef MADV_HUGEPAGE
+    if (flags & QFileDevice::MapHugePagesHint)
+        ok &= madvise(address, size, MADV_HUGEPAGE) == 0;
+#endif
+#ifdef MADV_POPULATE_READ
+    if (flags & QFileDevice::MapPopulateOption) {
+        // Linux 5.14; older kernels reject it with EINVAL and, like the
+        // pages that could not be populated, get the read-ahead request below
+        if (madvise(address, size, MADV_POPULATE_READ) == 0)
+            flags.setFlag(QFileDevice::MapPopulateOption, false);
+        else if (errno != EINVAL)
+            ok = false;
+    }
+#endif
+#ifdef MADV_WILLNEED
+    if (flags & (QFileDevice::MapWillNeedHint | QFileDevice::MapPopulateOption))
+        ok &= madvise(address, size, MADV_WILLNEED) == 0;
+#endif
+    Q_UNUSED(address);
+    Q_UNUSED(size);
+    Q_UNUSED(flags);
+    return ok;
+}
+
 uchar *QFSFileEnginePrivate::map(qint64 offset, qint64 size, QFile::MemoryMapFlags flags)
 {
     qint64 maxFileOffset = std::numeric_limits<QT_OFF_T>::max();
@@ -615,11 +714,20 @@ uchar *QFSFileEnginePrivate::map(qint64 offset, qint64 size, QFile::MemoryMapFla
     QT_OFF_T realOffset = QT_OFF_T(offset);
     realOffset &= ~(QT_OFF_T(pageSize - 1));
 
+#ifdef MAP_POPULATE
+    if (flags & QFileDevice::MapPopulateOption) {
+        sharemode |= MAP_POPULATE;
+        flags.setFlag(QFileDevice::MapPopulateOption, false);
+    }
+#endif
+
     void *mapAddress = QT_MMAP((void*)nullptr, realSize,
                    access, sharemode, nativeHandle(), realOffset);
     if (MAP_FAILED != mapAddress) {
         uchar *address = extra + static_cast<uchar*>(mapAddress);
         maps[address] = QPair<int,size_t>(extra, realSize);
+        // The hints are advisory, failing to apply them is not an error.
+        adviseMemory(mapAddress, realSize, flags);
         return address;
     }
 
@@ -662,6 +770,32 @@ bool QFSFileEnginePrivate::unmap(uchar *ptr)
 #endif
 }
 
+bool QFSFileEnginePrivate::adviseMap(uchar *address, qint64 size, QFile::MemoryMapFlags hints)
+{
+    Q_Q(QFSFileEngine);
+    for (auto it = maps.cbegin(), end = maps.cend(); it != end; ++it) {
+        uchar *start = it.key() - it.value().first;
+        if (address < it.key() || size < 0
+                || quint64(address - start) + quint64(size) > it.value().second) {
+            continue;
+        }
+
+#if defined(Q_OS_INTEGRITY)
+        int pageSize = sysconf(_SC_PAGESIZE);
+#else
+        int pageSize = getpagesize();
+#endif
+        const size_t extra = quintptr(address) % pageSize;
+        if (!adviseMemory(address - extra, size_t(size) + extra, hints)) {
+            q->setError(QFile::UnspecifiedError, qt_error_string(errno));
+            return false;
+        }
+        return true;
+    }
+    q->setError(QFile::UnspecifiedError, qt_error_string(EINVAL));
+    return false;
+}
+
 /*!
     \reimp
 */
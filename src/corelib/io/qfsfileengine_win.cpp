@@ -501,6 +501,7 @@ bool QFSFileEngine::link(const QString &newName)
 
     QString linkName = newName;
     //### assume that they add .lnk
+    QFileSystemMetaDataCache::invalidate(QFileSystemEntry(linkName));
 
     IShellLink *psl;
     bool neededCoInit = false;
@@ -721,6 +722,7 @@ bool QFSFileEngine::setPermissions(uint perms)
 bool QFSFileEngine::setSize(qint64 size)
 {
     Q_D(QFSFileEngine);
+    QFileSystemMetaDataCache::invalidate(d->fileEntry);
 
     if (d->fileHandle != INVALID_HANDLE_VALUE || d->fd != -1 || d->fh) {
         // resize open file
@@ -760,6 +762,7 @@ bool QFSFileEngine::setSize(qint64 size)
 bool QFSFileEngine::setFileTime(const QDateTime &newDate, FileTime time)
 {
     Q_D(QFSFileEngine);
+    QFileSystemMetaDataCache::invalidate(d->fileEntry);
 
     if (d->openMode == QFile::NotOpen) {
         setError(QFile::PermissionsError, qt_error_string(ERROR_ACCESS_DENIED));
@@ -918,6 +921,26 @@ bool QFSFileEnginePrivate::unmap(uchar *ptr)
     return true;
 }
 
+bool QFSFileEnginePrivate::adviseMap(uchar *address, qint64 size, QFile::MemoryMapFlags hints)
+{
+    // There are no access hints for views on Windows; only check that the
+    // memory belongs to one of our views.
+    Q_Q(QFSFileEngine);
+    Q_UNUSED(hints);
+    MEMORY_BASIC_INFORMATION info;
+    if (size >= 0 && VirtualQuery(address, &info, sizeof(info)) != 0) {
+        const uchar *regionEnd = static_cast<const uchar *>(info.BaseAddress) + info.RegionSize;
+        for (auto it = maps.cbegin(), end = maps.cend(); it != end; ++it) {
+            if (it.key() - it.value() == info.AllocationBase && address >= it.key()
+                    && size <= regionEnd - address) {
+                return true;
+            }
+        }
+    }
+    q->setError(QFile::UnspecifiedError, qt_error_string(ERROR_INVALID_PARAMETER));
+    return false;
+}
+
 /*!
     \reimp
 */
@@ -46,8 +46,18 @@
 #include "qstringlist.h"
 #include "qdir.h"
 #include "private/qbytearray_p.h"
+#ifdef Q_OS_UNIX
+#  include "private/qfilesystemengine_p.h"
+#  include <errno.h>
+#endif
+#ifndef QT_BOOTSTRAPPED
+#  include <qtcore_tracepoints_p.h>
+#else
+#  include "private/qtrace_p.h"
+#endif
 
 #include <algorithm>
+#include <limits>
 
 #ifdef QIODEVICE_DEBUG
 #  include <ctype.h>
@@ -616,6 +626,45 @@ bool QIODevice::isWritable() const
     return (openMode() & WriteOnly) != 0;
 }
 
+/*!
+    \since 6.0
+
+    Sets the number of bytes that QIODevice requests from readData() at once
+    when it refills its read buffer to \a size. Reads of at least this many
+    bytes bypass the buffer.
+
+    By default, the chunk size depends on the device. Files start with
+    16 KiB and double the chunk size while they are being read sequentially,
+    up to 256 KiB; a seek makes them start over. Setting a chunk size
+    disables this growth.
+
+    \sa readBufferChunkSize(), read()
+*/
+void QIODevice::setReadBufferChunkSize(qint64 size)
+{
+    Q_D(QIODevice);
+    if (size <= 0 || size >= MaxByteArraySize) {
+        qWarning("QIODevice::setReadBufferChunkSize: Invalid chunk size %lld", size);
+        return;
+    }
+    d->readBufferBaseChunkSize = int(size);
+    d->readBufferMaxChunkSize = int(size);
+    d->resetReadBufferChunkSize();
+}
+
+/*!
+    \since 6.0
+
+    Returns the number of bytes that QIODevice currently requests from
+    readData() at once when it refills its read buffer.
+
+    \sa setReadBufferChunkSize()
+*/
+qint64 QIODevice::readBufferChunkSize() const
+{
+    return d_func()->readBufferChunkSize;
+}
+
 /*!
     \since 5.7
 
@@ -776,6 +825,7 @@ bool QIODevice::open(OpenMode mode)
     d->accessMode = QIODevicePrivate::Unset;
     d->readBuffers.clear();
     d->writeBuffers.clear();
+    d->resetReadBufferChunkSize();
     d->setReadChannelCount(isReadable() ? 1 : 0);
     d->setWriteChannelCount(isWritable() ? 1 : 0);
     d->errorString.clear();
@@ -904,6 +954,10 @@ void QIODevicePrivate::seekBuffer(qint64 newPos)
         // When seeking backwards, an operation that is only allowed for
         // random-access devices, the buffer is cleared. The next read
         // operation will then refill the buffer.
+        if (offset < 0 || offset > buffer.size()) {
+            // Random access: go back to small refills.
+            resetReadBufferChunkSize();
+        }
         buffer.clear();
     } else {
         buffer.free(offset);
@@ -1028,6 +1082,7 @@ qint64 QIODevice::read(char *data, qint64 maxSize)
 #endif
             if (d->buffer.isEmpty())
                 readData(data, 0);
+            Q_TRACE(QIODevice_read, this, maxSize, qint64(1));
             return qint64(1);
         }
     }
@@ -1036,6 +1091,7 @@ qint64 QIODevice::read(char *data, qint64 maxSize)
     CHECK_READABLE(read, qint64(-1));
 
     const qint64 readBytes = d->read(data, maxSize);
+    Q_TRACE(QIODevice_read, this, maxSize, readBytes);
 
 #if defined QIODEVICE_DEBUG
     printf("%p \treturning %lld, d->pos == %lld, d->buffer.size() == %lld\n", this,
@@ -1110,18 +1166,43 @@ qint64 QIODevicePrivate::read(char *data, qint64 maxSize, bool peeking)
                     const qint64 bytesToBuffer = (buffered || readBufferChunkSize < maxSize)
                             ? qint64(readBufferChunkSize)
                             : maxSize;
-                    // Try to fill QIODevice buffer by single read
-                    readFromDevice = q->readData(buffer.reserve(bytesToBuffer), bytesToBuffer);
-                    deviceAtEof = (readFromDevice != bytesToBuffer);
-                    buffer.chop(bytesToBuffer - qMax(Q_INT64_C(0), readFromDevice));
-                    if (readFromDevice > 0) {
-                        if (!sequential)
+                    char *bufferPtr = buffer.reserve(bytesToBuffer);
+                    if (buffered && !sequential && !keepDataInBuffer
+                            && readScattered(data, maxSize, bufferPtr, bytesToBuffer,
+                                             &readFromDevice)) {
+                        // A single call filled the output and refilled the buffer
+                        deviceAtEof = (readFromDevice != maxSize + bytesToBuffer);
+                        const qint64 bufferedBytes = qMax(Q_INT64_C(0), readFromDevice - maxSize);
+                        buffer.chop(bytesToBuffer - bufferedBytes);
+                        adaptReadBufferChunkSize(bufferedBytes, bytesToBuffer);
+#if defined QIODEVICE_DEBUG
+                        printf("%p \treading %lld bytes from device, %lld into buffer\n", q,
+                               readFromDevice, bufferedBytes);
+#endif
+                        if (readFromDevice > 0) {
+                            const qint64 directBytes = readFromDevice - bufferedBytes;
+                            readSoFar += directBytes;
+                            data += directBytes;
+                            maxSize -= directBytes;
+                            pos += directBytes;
                             devicePos += readFromDevice;
+                        }
+                    } else {
+                        // Try to fill QIODevice buffer by single read
+                        readFromDevice = q->readData(bufferPtr, bytesToBuffer);
+                        deviceAtEof = (readFromDevice != bytesToBuffer);
+                        buffer.chop(bytesToBuffer - qMax(Q_INT64_C(0), readFromDevice));
+                        if (buffered)
+                            adaptReadBufferChunkSize(readFromDevice, bytesToBuffer);
+                        if (readFromDevice > 0) {
+                            if (!sequential)
+                                devicePos += readFromDevice;
 #if defined QIODEVICE_DEBUG
-                        printf("%p \treading %lld from device into buffer\n", q,
-                               readFromDevice);
+                            printf("%p \treading %lld from device into buffer\n", q,
+                                   readFromDevice);
 #endif
-                        continue;
+                            continue;
+                        }
                     }
                 }
             } else {
@@ -1218,6 +1299,9 @@ QByteArray QIODevice::read(qint64 maxSize)
     CHECK_MAXLEN(read, result);
     CHECK_MAXBYTEARRAYSIZE(read);
 
+    if (!d->transactionStarted && d->readInPlace(maxSize, &result))
+        return result;
+
     result.resize(int(maxSize));
     qint64 readBytes = read(result.data(), result.size());
 
@@ -1247,6 +1331,10 @@ QByteArray QIODevice::readAll()
 
     QByteArray result;
     qint64 readBytes = (d->isSequential() ? Q_INT64_C(0) : size());
+    if (readBytes > d->pos && readBytes - d->pos < MaxByteArraySize
+            && !d->transactionStarted && d->readInPlace(readBytes - d->pos, &result)) {
+        return result;
+    }
     if (readBytes == 0) {
         // Size is unknown, read incrementally.
         qint64 readChunkSize = qMax(qint64(d->readBufferChunkSize),
@@ -1700,6 +1788,7 @@ qint64 QIODevice::write(const char *data, qint64 maxSize)
         d->devicePos += written;
         d->buffer.skip(written);
     }
+    Q_TRACE(QIODevice_write, this, maxSize, written);
     return written;
 }
 
@@ -2043,6 +2132,205 @@ qint64 QIODevice::skipData(qint64 maxSize)
     return d_func()->skipByReading(maxSize);
 }
 
+/*!
+    \since 6.0
+
+    Transfers up to \a maxSize bytes from this device to \a target, or all the
+    data up to the end of this device if \a maxSize is -1. Returns the number
+    of bytes transferred, or -1 if an error occurred before any data could be
+    transferred.
+
+    The data is read from this device and written to \a target as if by read()
+    and write(), without the caller having to provide a buffer. On Linux, when
+    this device is a file and \a target is a file, a pipe or a TCP socket, the
+    data is copied by the kernel (using copy_file_range() or sendfile()) and
+    never enters the process. Otherwise, it goes through a large intermediate
+    buffer. This makes transferTo() the preferred way of copying large files
+    or sending them over a QTcpSocket.
+
+    For sequential devices, only the data that is available without waiting is
+    transferred. If \a target cannot accept more data without blocking, such
+    as a socket whose send buffer is full, transferTo() passes at most one more
+    block to the write() function of \a target and returns; call it again, for
+    instance when \a target emits bytesWritten(), to continue the transfer.
+    The data copied by the kernel bypasses the write buffer of \a target and
+    is not reported by its bytesWritten() signal.
+
+    \sa read(), write(), QFile::copy()
+*/
+qint64 QIODevice::transferTo(QIODevice *target, qint64 maxSize)
+{
+    Q_D(QIODevice);
+    CHECK_READABLE(transferTo, qint64(-1));
+    if (!target || target == this) {
+        checkWarnMessage(this, "transferTo", "Invalid target device");
+        return qint64(-1);
+    }
+    if (!target->isWritable()) {
+        checkWarnMessage(this, "transferTo", "Target device not open for writing");
+        return qint64(-1);
+    }
+    if (maxSize < 0)
+        maxSize = std::numeric_limits<qint64>::max();
+
+    const bool sequential = d->isSequential();
+    qint64 transferred = 0;
+    bool wouldBlock = false;
+
+    if (!d->transactionStarted && ((d->openMode | target->openMode()) & Text) == 0) {
+        // First, pass on the data in the internal buffer without copying it.
+        if (!d->buffer.isEmpty()) {
+            while (transferred < maxSize && !d->buffer.isEmpty()) {
+                const qint64 blockSize = qMin(d->buffer.nextDataBlockSize(),
+                                              maxSize - transferred);
+                const qint64 written = target->write(d->buffer.readPointer(), blockSize);
+                if (written <= 0)
+                    return transferred ? transferred : qint64(-1);
+                d->buffer.free(written);
+                if (!sequential)
+                    d->pos += written;
+                transferred += written;
+            }
+            if (d->buffer.isEmpty())
+                readData(nullptr, 0);
+        }
+
+#ifdef Q_OS_UNIX
+        // Then, let the kernel copy the data if both devices have a descriptor.
+        if (transferred < maxSize && !sequential) {
+            const int srcfd = d->transferDescriptor(ReadOnly);
+            const int dstfd = srcfd != -1 ? target->d_func()->transferDescriptor(WriteOnly) : -1;
+            if (dstfd != -1) {
+                const qint64 srcPos = d->pos;
+                const qint64 dstPos = target->isSequential() ? qint64(-1) : target->pos();
+                QSystemError error;
+                const qint64 copied = QFileSystemEngine::transferData(srcfd, srcPos, dstfd, dstPos,
+                                                                      maxSize - transferred, error);
+                if (copied != -1) {
+                    // The descriptors were used at explicit offsets; move the
+                    // devices past the data.
+                    seek(srcPos + copied);
+                    if (dstPos != -1)
+                        target->seek(dstPos + copied);
+                    transferred += copied;
+                    if (error.error() != EAGAIN) {
+                        if (error.error() != 0 && transferred == 0) {
+                            setErrorString(error.toString());
+                            return qint64(-1);
+                        }
+                        return transferred;
+                    }
+                    wouldBlock = true;
+                }
+            }
+        }
+#endif
+    }
+
+    // Fall back to reading and writing blocks.
+    const qint64 bufferSize = qMin(maxSize - transferred, qint64(QIODEVICE_TRANSFER_BUFFERSIZE));
+    if (bufferSize <= 0)
+        return transferred;
+    QByteArray buffer(bufferSize, Qt::Uninitialized);
+    // A sequential target may just queue what it cannot write right away;
+    // unless it has a descriptor we cannot tell, so pass it a single block.
+    const bool targetSequential = target->isSequential();
+    const bool singleBlock = targetSequential
+            && target->d_func()->transferDescriptor(WriteOnly) == -1;
+    while (transferred < maxSize) {
+        const qint64 readBytes = read(buffer.data(), qMin(maxSize - transferred, bufferSize));
+        if (readBytes <= 0) {
+            if (readBytes < 0 && transferred == 0)
+                return qint64(-1);
+            break;
+        }
+        const qint64 written = target->write(buffer.constData(), readBytes);
+        if (written < 0)
+            return transferred ? transferred : qint64(-1);
+        transferred += written;
+        if (written != readBytes || wouldBlock || singleBlock
+                || (targetSequential && target->bytesToWrite() > 0)) {
+            break;
+        }
+    }
+    return transferred;
+}
+
+/*!
+    \internal
+
+    Lets devices that keep their whole contents in memory return up to
+    \a maxSize bytes from the current position in \a result without copying
+    them, for instance with QByteArray::fromRawData(). Returns \c false if the
+    device cannot do that, in which case QIODevice reads the data as usual.
+    This is not called during transactions.
+*/
+bool QIODevicePrivate::readInPlace(qint64 maxSize, QByteArray *result)
+{
+    Q_UNUSED(maxSize);
+    Q_UNUSED(result);
+    return false;
+}
+
+/*!
+    \internal
+
+    Lets devices read up to \a maxSize bytes into \a data and, with the
+    same call into the device, up to \a bufferSize more bytes into
+    \a bufferData, which is memory reserved at the end of the read buffer.
+    Stores the total number of bytes read, or -1 on error, in \a bytesRead.
+    Returns \c false if the device cannot do that, in which case nothing has
+    been read and QIODevice refills the buffer with readData() as usual.
+
+    This is only used for buffered random-access devices; it saves copying
+    the requested data out of the buffer after the refill. As readData() is
+    not called, devices must not do it when a subclass may reimplement it.
+*/
+bool QIODevicePrivate::readScattered(char *data, qint64 maxSize, char *bufferData,
+                                     qint64 bufferSize, qint64 *bytesRead)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+    Q_UNUSED(bufferData);
+    Q_UNUSED(bufferSize);
+    Q_UNUSED(bytesRead);
+    return false;
+}
+
+/*!
+    \internal
+
+    Called after the read buffer has been refilled with \a bytesRead out of
+    \a bytesRequested bytes. Every few complete refills in a row double the
+    chunk size, up to readBufferMaxChunkSize, so that long sequential reads
+    need fewer calls into the device. A short read ends the streak.
+*/
+void QIODevicePrivate::adaptReadBufferChunkSize(qint64 bytesRead, qint64 bytesRequested)
+{
+    if (bytesRead < bytesRequested) {
+        readBufferFillStreak = 0;
+        return;
+    }
+    if (readBufferChunkSize >= readBufferMaxChunkSize || ++readBufferFillStreak < 4)
+        return;
+    readBufferFillStreak = 0;
+    readBufferChunkSize = qMin(readBufferChunkSize * 2, readBufferMaxChunkSize);
+}
+
+/*!
+    \internal
+
+    Returns a file descriptor that QIODevice::transferTo() can read from or
+    write to directly, depending on \a direction, or -1 if the device has
+    none. Any data buffered for writing must have been flushed. Reads and
+    writes happen at the position of the device for random-access devices.
+*/
+int QIODevicePrivate::transferDescriptor(QIODevice::OpenModeFlag direction)
+{
+    Q_UNUSED(direction);
+    return -1;
+}
+
 /*!
     Blocks until new data is available for reading and the readyRead()
     signal has been emitted, or until \a msecs milliseconds have
@@ -88,6 +88,9 @@ public:
     bool isWritable() const;
     virtual bool isSequential() const;
 
+    void setReadBufferChunkSize(qint64 size);
+    qint64 readBufferChunkSize() const;
+
     int readChannelCount() const;
     int writeChannelCount() const;
     int currentReadChannel() const;
@@ -128,6 +131,7 @@ public:
     qint64 peek(char *data, qint64 maxlen);
     QByteArray peek(qint64 maxlen);
     qint64 skip(qint64 maxSize);
+    qint64 transferTo(QIODevice *target, qint64 maxSize = -1);
 
     virtual bool waitForReadyRead(int msecs);
     virtual bool waitForBytesWritten(int msecs);
@@ -67,6 +67,14 @@ QT_BEGIN_NAMESPACE
 #define QIODEVICE_BUFFERSIZE 16384
 #endif
 
+#ifndef QIODEVICE_MAX_BUFFERSIZE
+#define QIODEVICE_MAX_BUFFERSIZE (256 * 1024)
+#endif
+
+#ifndef QIODEVICE_TRANSFER_BUFFERSIZE
+#define QIODEVICE_TRANSFER_BUFFERSIZE (256 * 1024)
+#endif
+
 Q_CORE_EXPORT int qt_subtract_from_timeout(int timeout, int elapsed);
 
 class Q_CORE_EXPORT QIODevicePrivate
@@ -132,6 +140,8 @@ public:
     int currentWriteChannel = 0;
     int readBufferChunkSize = QIODEVICE_BUFFERSIZE;
     int writeBufferChunkSize = 0;
+    int readBufferBaseChunkSize = QIODEVICE_BUFFERSIZE;
+    int readBufferMaxChunkSize = QIODEVICE_BUFFERSIZE;
 
     QList<QRingBuffer> readBuffers;
     QList<QRingBuffer> writeBuffers;
@@ -149,6 +159,7 @@ public:
         RandomAccess
     };
     mutable AccessMode accessMode = Unset;
+    quint8 readBufferFillStreak = 0;
     inline bool isSequential() const
     {
         if (accessMode == Unset)
@@ -164,6 +175,12 @@ public:
     bool allWriteBuffersEmpty() const;
 
     void seekBuffer(qint64 newPos);
+    void adaptReadBufferChunkSize(qint64 bytesRead, qint64 bytesRequested);
+    inline void resetReadBufferChunkSize()
+    {
+        readBufferChunkSize = readBufferBaseChunkSize;
+        readBufferFillStreak = 0;
+    }
 
     inline void setCurrentReadChannel(int channel)
     {
@@ -182,6 +199,10 @@ public:
     virtual qint64 peek(char *data, qint64 maxSize);
     virtual QByteArray peek(qint64 maxSize);
     qint64 skipByReading(qint64 maxSize);
+    virtual bool readInPlace(qint64 maxSize, QByteArray *result);
+    virtual bool readScattered(char *data, qint64 maxSize, char *bufferData, qint64 bufferSize,
+                               qint64 *bytesRead);
+    virtual int transferDescriptor(QIODevice::OpenModeFlag direction);
     void write(const char *data, qint64 size);
 
 #ifdef QT_NO_QOBJECT
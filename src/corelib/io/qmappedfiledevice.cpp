@@ -0,0 +1,364 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qmappedfiledevice.h"
+
+#include "qfile.h"
+#include "private/qbytearray_p.h"
+#include "private/qiodevice_p.h"
+
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+class QMappedFileDevicePrivate : public QIODevicePrivate
+{
+    Q_DECLARE_PUBLIC(QMappedFileDevice)
+
+public:
+    QByteArray peek(qint64 maxSize) override;
+    bool readInPlace(qint64 maxSize, QByteArray *result) override;
+
+    QByteArray viewAt(qint64 offset, qint64 maxSize) const;
+
+    QFile file;
+    QFileDevice::MemoryMapFlags mapFlags = QFileDevice::NoOptions;
+    uchar *mapping = nullptr;
+    qint64 mappedSize = 0;
+};
+
+QByteArray QMappedFileDevicePrivate::viewAt(qint64 offset, qint64 maxSize) const
+{
+    if (offset < 0 || offset >= mappedSize || maxSize <= 0)
+        return QByteArray();
+    const qint64 length = qMin(qMin(maxSize, mappedSize - offset), qint64(MaxByteArraySize - 1));
+    return QByteArray::fromRawData(reinterpret_cast<const char *>(mapping) + offset, length);
+}
+
+QByteArray QMappedFileDevicePrivate::peek(qint64 maxSize)
+{
+    if (openMode & QIODevice::Text)
+        return QIODevicePrivate::peek(maxSize);
+    return viewAt(pos, maxSize);
+}
+
+bool QMappedFileDevicePrivate::readInPlace(qint64 maxSize, QByteArray *result)
+{
+    if ((openMode & QIODevice::Text) || !buffer.isEmpty())
+        return false;
+    *result = viewAt(pos, maxSize);
+    pos += result->size();
+    devicePos = pos;
+    return true;
+}
+
+/*!
+    \class QMappedFileDevice
+    \inmodule QtCore
+    \since 6.0
+    \brief The QMappedFileDevice class provides a read-only QIODevice on a
+    memory-mapped file.
+
+    \ingroup io
+    \reentrant
+
+    QMappedFileDevice maps a whole file into memory when it is opened and
+    serves all reads from the mapping. read() into a caller's buffer copies
+    straight from the mapped pages, without going through a read buffer, and
+    read(qint64), readAll() and peek(qint64) return byte arrays that refer to
+    the mapped memory instead of copying it, as if created with
+    QByteArray::fromRawData(). This makes it cheap to hand very large files to
+    parsers that take a QIODevice or a QByteArray, such as QTextStream,
+    QXmlStreamReader or QJsonDocument.
+
+    \snippet code/src_corelib_io_qmappedfiledevice.cpp 0
+
+    The byte arrays returned by these functions and by view() are only valid
+    while the device is open; modifying one of them makes a deep copy first.
+    The contents of a mapping of a file that is truncated by another process
+    while it is mapped are undefined.
+
+    The mapFlags() are passed to QFileDevice::map(), so that the mapping can
+    be populated up front or the access pattern can be described to the
+    operating system; advise() does the same for a part of the file.
+
+    \sa QFileDevice::map(), QByteArray::fromRawData(), QBuffer
+*/
+
+/*!
+    Constructs a QMappedFileDevice object with the given \a parent.
+*/
+QMappedFileDevice::QMappedFileDevice(QObject *parent)
+    : QIODevice(*new QMappedFileDevicePrivate, parent)
+{
+}
+
+/*!
+    Constructs a QMappedFileDevice object with the given \a parent to
+    represent the file with the given \a fileName.
+*/
+QMappedFileDevice::QMappedFileDevice(const QString &fileName, QObject *parent)
+    : QIODevice(*new QMappedFileDevicePrivate, parent)
+{
+    Q_D(QMappedFileDevice);
+    d->file.setFileName(fileName);
+}
+
+/*!
+    Destroys the device, unmapping the file.
+*/
+QMappedFileDevice::~QMappedFileDevice()
+{
+    close();
+}
+
+/*!
+    Returns the name of the file.
+
+    \sa setFileName()
+*/
+QString QMappedFileDevice::fileName() const
+{
+    Q_D(const QMappedFileDevice);
+    return d->file.fileName();
+}
+
+/*!
+    Sets the name of the file to \a fileName. Does nothing if the device is
+    open.
+
+    \sa fileName()
+*/
+void QMappedFileDevice::setFileName(const QString &fileName)
+{
+    Q_D(QMappedFileDevice);
+    if (isOpen()) {
+        qWarning("QMappedFileDevice::setFileName: File (%ls) is already opened",
+                 qUtf16Printable(d->file.fileName()));
+        return;
+    }
+    d->file.setFileName(fileName);
+}
+
+/*!
+    Returns the flags that are passed to QFileDevice::map() when the file is
+    opened. The default is QFileDevice::NoOptions.
+
+    \sa setMapFlags()
+*/
+QFileDevice::MemoryMapFlags QMappedFileDevice::mapFlags() const
+{
+    Q_D(const QMappedFileDevice);
+    return d->mapFlags;
+}
+
+/*!
+    Sets the flags that are passed to QFileDevice::map() when the file is
+    opened to \a flags. For instance, QFileDevice::MapPopulateOption reads the
+    whole file in up front, and QFileDevice::MapSequentialHint suits a single
+    pass over a large file.
+
+    \sa mapFlags(), advise()
+*/
+void QMappedFileDevice::setMapFlags(QFileDevice::MemoryMapFlags flags)
+{
+    Q_D(QMappedFileDevice);
+    d->mapFlags = flags;
+}
+
+/*!
+    \reimp
+
+    Opens the file and maps it into memory. \a mode must be
+    QIODevice::ReadOnly, optionally combined with QIODevice::Text; the device
+    is always unbuffered. Returns \c true if successful; otherwise sets the
+    errorString() and returns \c false.
+*/
+bool QMappedFileDevice::open(OpenMode mode)
+{
+    Q_D(QMappedFileDevice);
+    if (isOpen()) {
+        qWarning("QMappedFileDevice::open: File (%ls) already open",
+                 qUtf16Printable(d->file.fileName()));
+        return false;
+    }
+    if ((mode & (ReadOnly | WriteOnly | Append | Truncate)) != ReadOnly) {
+        qWarning("QMappedFileDevice::open: Only ReadOnly is supported");
+        return false;
+    }
+
+    if (!d->file.open(ReadOnly)) {
+        setErrorString(d->file.errorString());
+        return false;
+    }
+    const qint64 size = d->file.size();
+    if (size > 0) {
+        d->mapping = d->file.map(0, size, d->mapFlags);
+        if (!d->mapping) {
+            setErrorString(d->file.errorString());
+            d->file.close();
+            return false;
+        }
+    }
+    d->mappedSize = size;
+    // The mapping outlives the file descriptor.
+    d->file.close();
+    return QIODevice::open(mode | Unbuffered);
+}
+
+/*!
+    \reimp
+
+    Unmaps the file. The byte arrays that refer to the mapping become invalid.
+*/
+void QMappedFileDevice::close()
+{
+    Q_D(QMappedFileDevice);
+    if (!isOpen())
+        return;
+    QIODevice::close();
+    if (d->mapping)
+        d->file.unmap(d->mapping);
+    d->mapping = nullptr;
+    d->mappedSize = 0;
+}
+
+/*!
+    \reimp
+
+    Returns the size of the mapped file, or 0 if the device is not open.
+*/
+qint64 QMappedFileDevice::size() const
+{
+    Q_D(const QMappedFileDevice);
+    return d->mappedSize;
+}
+
+/*!
+    \reimp
+*/
+bool QMappedFileDevice::seek(qint64 pos)
+{
+    Q_D(QMappedFileDevice);
+    if (pos > d->mappedSize) {
+        qWarning("QMappedFileDevice::seek: Invalid pos: %lld", pos);
+        return false;
+    }
+    return QIODevice::seek(pos);
+}
+
+/*!
+    Returns a pointer to the mapped contents of the file, or \nullptr if the
+    device is not open or the file is empty.
+
+    \sa view()
+*/
+const uchar *QMappedFileDevice::data() const
+{
+    Q_D(const QMappedFileDevice);
+    return d->mapping;
+}
+
+/*!
+    Returns a byte array that refers to \a size bytes of the mapped file
+    starting at \a offset, without copying them. If \a size is -1 or extends
+    beyond the end of the file, the byte array ends at the end of the file.
+    Returns an empty byte array if the device is not open or \a offset is not
+    within the file.
+
+    The byte array is only valid while the device is open. The current
+    position is not changed.
+
+    \sa data(), QByteArray::fromRawData()
+*/
+QByteArray QMappedFileDevice::view(qint64 offset, qint64 size) const
+{
+    Q_D(const QMappedFileDevice);
+    return d->viewAt(offset, size < 0 ? d->mappedSize : size);
+}
+
+/*!
+    Passes the access \a hints for the \a size bytes of the file starting at
+    \a offset to the operating system, for instance to prefetch the part of
+    the file that is about to be parsed with QFileDevice::MapWillNeedHint.
+    Returns \c true if the hints were passed on; otherwise returns \c false.
+
+    \sa QFileDevice::adviseMap(), setMapFlags()
+*/
+bool QMappedFileDevice::advise(qint64 offset, qint64 size, QFileDevice::MemoryMapFlags hints)
+{
+    Q_D(QMappedFileDevice);
+    if (!d->mapping || offset < 0 || size < 0 || offset > d->mappedSize
+            || size > d->mappedSize - offset) {
+        return false;
+    }
+    if (size == 0)
+        return true;
+    return d->file.adviseMap(d->mapping + offset, size, hints);
+}
+
+/*!
+    \reimp
+*/
+qint64 QMappedFileDevice::readData(char *data, qint64 maxlen)
+{
+    Q_D(QMappedFileDevice);
+    const qint64 length = qMin(maxlen, d->mappedSize - pos());
+    if (length <= 0)
+        return 0;
+    memcpy(data, d->mapping + pos(), size_t(length));
+    return length;
+}
+
+/*!
+    \reimp
+
+    The device is read-only; this function always returns -1.
+*/
+qint64 QMappedFileDevice::writeData(const char *data, qint64 len)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(len);
+    return -1;
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qmappedfiledevice.cpp"
@@ -0,0 +1,88 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QMAPPEDFILEDEVICE_H
+#define QMAPPEDFILEDEVICE_H
+
+#include <QtCore/qfiledevice.h>
+#include <QtCore/qiodevice.h>
+#include <QtCore/qstring.h>
+
+QT_BEGIN_NAMESPACE
+
+class QMappedFileDevicePrivate;
+
+class Q_CORE_EXPORT QMappedFileDevice : public QIODevice
+{
+    Q_OBJECT
+
+public:
+    explicit QMappedFileDevice(QObject *parent = nullptr);
+    explicit QMappedFileDevice(const QString &fileName, QObject *parent = nullptr);
+    ~QMappedFileDevice();
+
+    QString fileName() const;
+    void setFileName(const QString &fileName);
+
+    QFileDevice::MemoryMapFlags mapFlags() const;
+    void setMapFlags(QFileDevice::MemoryMapFlags flags);
+
+    bool open(OpenMode mode) override;
+    void close() override;
+
+    qint64 size() const override;
+    bool seek(qint64 pos) override;
+
+    const uchar *data() const;
+    QByteArray view(qint64 offset = 0, qint64 size = -1) const;
+    bool advise(qint64 offset, qint64 size, QFileDevice::MemoryMapFlags hints);
+
+protected:
+    qint64 readData(char *data, qint64 maxlen) override;
+    qint64 writeData(const char *data, qint64 len) override;
+
+private:
+    Q_DECLARE_PRIVATE(QMappedFileDevice)
+    Q_DISABLE_COPY(QMappedFileDevice)
+};
+
+QT_END_NAMESPACE
+
+#endif // QMAPPEDFILEDEVICE_H
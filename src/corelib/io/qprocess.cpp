@@ -827,6 +827,8 @@ void QProcessPrivate::Channel::clear()
 QProcessPrivate::QProcessPrivate()
 {
     readBufferChunkSize = QRINGBUFFER_CHUNKSIZE;
+    readBufferBaseChunkSize = QRINGBUFFER_CHUNKSIZE;
+    readBufferMaxChunkSize = QRINGBUFFER_CHUNKSIZE;
     writeBufferChunkSize = QRINGBUFFER_CHUNKSIZE;
     processChannelMode = QProcess::SeparateChannels;
     inputChannelMode = QProcess::ManagedInputChannel;
@@ -359,6 +359,24 @@ static char **_q_dupEnvironment(const QProcessEnvironmentPrivate::Map &environme
     return envp;
 }
 
+namespace {
+struct QProcessChildArguments
+{
+    QProcessPrivate *d;
+    const char *workingDirectory;
+    char **argv;
+    char **envp;
+};
+} // anonymous namespace
+
+// Runs in the child process, which may share the memory of the parent.
+static int qt_process_child_main(void *token)
+{
+    const QProcessChildArguments *args = static_cast<const QProcessChildArguments *>(token);
+    args->d->execChild(args->workingDirectory, args->argv, args->envp);
+    return -1;
+}
+
 void QProcessPrivate::startProcess()
 {
     Q_Q(QProcess);
@@ -450,30 +468,30 @@ void QProcessPrivate::startProcess()
         workingDirPtr = encodedWorkingDirectory.constData();
     }
 
-    // Select FFD_USE_FORK and FFD_VFORK_SEMANTICS based on whether there's
-    // user code running in the child process: if there is, we don't know what
-    // the user will want to do, so we err on the safe side and request an
-    // actual fork() (for example, the user could attempt to do some
-    // synchronization with the parent process). But if there isn't, then our
-    // code in execChild() is just a handful of dup2() and a chdir(), so it's
-    // safe with vfork semantics: suspend the parent execution until the child
-    // either execve()s or _exit()s.
+    // Select FFD_USE_FORK based on whether there's user code running in the
+    // child process: if there is, we don't know what the user will want to
+    // do, so we err on the safe side and request an actual fork() (for
+    // example, the user could attempt to do some synchronization with the
+    // parent process). But if there isn't, then our code in execChild() is
+    // just a handful of dup2() and a chdir(), so it's safe with vfork
+    // semantics: the child shares our memory and this thread is suspended
+    // until the child either execve()s or _exit()s. That makes starting a
+    // process independent of the size of the parent.
     int ffdflags = FFD_CLOEXEC;
     if (childProcessModifier)
         ffdflags |= FFD_USE_FORK;
     pid_t childPid;
-    forkfd = ::forkfd(ffdflags , &childPid);
+    QProcessChildArguments childArguments = { this, workingDirPtr, argv, envp };
+    forkfd = ::vforkfd(ffdflags, &childPid, qt_process_child_main, &childArguments);
     int lastForkErrno = errno;
-    if (forkfd != FFD_CHILD_PROCESS) {
-        // Parent process.
-        // Clean up duplicated memory.
-        for (int i = 0; i <= arguments.count(); ++i)
-            free(argv[i]);
-        for (int i = 0; i < envc; ++i)
-            free(envp[i]);
-        delete [] argv;
-        delete [] envp;
-    }
+
+    // Clean up duplicated memory.
+    for (int i = 0; i <= arguments.count(); ++i)
+        free(argv[i]);
+    for (int i = 0; i < envc; ++i)
+        free(envp[i]);
+    delete [] argv;
+    delete [] envp;
 
     // On QNX, if spawnChild failed, childPid will be -1 but forkfd is still 0.
     // This is intentional because we only want to handle failure to fork()
@@ -491,12 +509,6 @@ void QProcessPrivate::startProcess()
         return;
     }
 
-    // Start the child.
-    if (forkfd == FFD_CHILD_PROCESS) {
-        execChild(workingDirPtr, argv, envp);
-        ::_exit(-1);
-    }
-
     pid = Q_PID(childPid);
 
     // parent
@@ -592,9 +604,9 @@ void QProcessPrivate::execChild(const char *workingDir, char **argv, char **envp
     // don't use strerror or any other routines that may allocate memory, since
     // some buggy libc versions can deadlock on locked mutexes.
 report_errno:
+    // The child may share the parent's memory, so don't modify any member.
     error.code = errno;
     qt_safe_write(childStartedPipe[1], &error, sizeof(error));
-    childStartedPipe[1] = -1;
 }
 
 bool QProcessPrivate::processStarted(QString *errorMessage)
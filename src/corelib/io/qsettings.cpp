@@ -67,6 +67,7 @@
 #ifndef QT_BOOTSTRAPPED
 #include "qsavefile.h"
 #include "qlockfile.h"
+#include "qsettingsbinarystore_p.h"
 #endif
 
 #ifdef Q_OS_VXWORKS
@@ -107,6 +108,7 @@ struct QConfFileCustomFormat
     QSettings::ReadFunc readFunc;
     QSettings::WriteFunc writeFunc;
     Qt::CaseSensitivity caseSensitivity;
+    bool binary;
 };
 Q_DECLARE_TYPEINFO(QConfFileCustomFormat, Q_MOVABLE_TYPE);
 
@@ -900,6 +902,7 @@ void QConfFileSettingsPrivate::initFormat()
     extension = (format == QSettings::NativeFormat) ? QLatin1String(".conf") : QLatin1String(".ini");
     readFunc = nullptr;
     writeFunc = nullptr;
+    binaryFormat = false;
 #if defined(Q_OS_MAC)
     caseSensitivity = (format == QSettings::NativeFormat) ? Qt::CaseSensitive : IniCaseSensitivity;
 #else
@@ -917,6 +920,7 @@ void QConfFileSettingsPrivate::initFormat()
             readFunc = info.readFunc;
             writeFunc = info.writeFunc;
             caseSensitivity = info.caseSensitivity;
+            binaryFormat = info.binary;
         }
     }
 }
@@ -925,7 +929,7 @@ void QConfFileSettingsPrivate::initAccess()
 {
     if (!confFiles.isEmpty()) {
         if (format > QSettings::IniFormat) {
-            if (!readFunc)
+            if (!readFunc && !binaryFormat)
                 setStatus(QSettings::AccessError);
         }
     }
@@ -1187,6 +1191,16 @@ void QConfFileSettingsPrivate::remove(const QString &key)
     }
     if (confFile->originalKeys.contains(theKey))
         confFile->removedKeys.insert(theKey, QVariant());
+
+#ifndef QT_BOOTSTRAPPED
+    if (const QSettingsBinaryStore *store = binaryStore(confFile)) {
+        const QStringList storedKeys = store->keys(prefix);
+        for (const QString &storedKey : storedKeys)
+            confFile->removedKeys.insert(QSettingsKey(storedKey, caseSensitivity), QVariant());
+        if (store->contains(theKey))
+            confFile->removedKeys.insert(theKey, QVariant());
+    }
+#endif
 }
 
 void QConfFileSettingsPrivate::set(const QString &key, const QVariant &value)
@@ -1258,6 +1272,17 @@ QStringList QConfFileSettingsPrivate::children(const QString &prefix, ChildSpec
             ++j;
         }
 
+#ifndef QT_BOOTSTRAPPED
+        // list the keys of a binary store without decoding their values
+        if (const QSettingsBinaryStore *store = binaryStore(confFile)) {
+            const QStringList storedKeys = store->keys(prefix);
+            for (const QString &storedKey : storedKeys) {
+                if (!confFile->removedKeys.contains(QSettingsKey(storedKey, caseSensitivity)))
+                    processChild(QStringView{storedKey}.mid(startPos), spec, result);
+            }
+        }
+#endif
+
         j = const_cast<const ParsedSettingsMap *>(
                 &confFile->addedKeys)->lowerBound(thePrefix);
         while (j != confFile->addedKeys.constEnd() && j.key().startsWith(thePrefix)) {
@@ -1286,6 +1311,14 @@ void QConfFileSettingsPrivate::clear()
     ensureAllSectionsParsed(confFile);
     confFile->addedKeys.clear();
     confFile->removedKeys = confFile->originalKeys;
+
+#ifndef QT_BOOTSTRAPPED
+    if (const QSettingsBinaryStore *store = binaryStore(confFile)) {
+        const QStringList storedKeys = store->keys(QString());
+        for (const QString &storedKey : storedKeys)
+            confFile->removedKeys.insert(QSettingsKey(storedKey, caseSensitivity), QVariant());
+    }
+#endif
 }
 
 void QConfFileSettingsPrivate::sync()
@@ -1315,7 +1348,7 @@ QString QConfFileSettingsPrivate::fileName() const
 
 bool QConfFileSettingsPrivate::isWritable() const
 {
-    if (format > QSettings::IniFormat && !writeFunc)
+    if (format > QSettings::IniFormat && !writeFunc && !binaryFormat)
         return false;
 
     if (confFiles.isEmpty())
@@ -1324,18 +1357,41 @@ bool QConfFileSettingsPrivate::isWritable() const
     return confFiles.at(0)->isWritable();
 }
 
+static void setCreatedFilePermissions(const QConfFile *confFile, const QFileInfo &fileInfo)
+{
+    QFile::Permissions perms = fileInfo.permissions() | QFile::ReadOwner | QFile::WriteOwner;
+    if (!confFile->userPerms)
+        perms |= QFile::ReadGroup | QFile::ReadOther;
+    QFile(confFile->name).setPermissions(perms);
+}
+
 void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
 {
     bool readOnly = confFile->addedKeys.isEmpty() && confFile->removedKeys.isEmpty();
 
+#ifndef QT_BOOTSTRAPPED
+    if (binaryFormat && !confFile->binaryStore)
+        confFile->binaryStore.reset(new QSettingsBinaryStore);
+    QSettingsBinaryStore *store = binaryStore(confFile);
+#endif
+
     /*
         We can often optimize the read-only case, if the file on disk
-        hasn't changed.
+        hasn't changed. A mapped binary store tells us so without a stat().
     */
     if (readOnly && confFile->size > 0) {
-        QFileInfo fileInfo(confFile->name);
-        if (confFile->size == fileInfo.size() && confFile->timeStamp == fileInfo.lastModified())
+#ifndef QT_BOOTSTRAPPED
+        const QSettingsBinaryStore::ChangeState storeState =
+                store ? store->changeState() : QSettingsBinaryStore::Unknown;
+        if (storeState == QSettingsBinaryStore::Unchanged)
             return;
+        if (storeState == QSettingsBinaryStore::Unknown)
+#endif
+        {
+            QFileInfo fileInfo(confFile->name);
+            if (confFile->size == fileInfo.size() && confFile->timeStamp == fileInfo.lastModified())
+                return;
+        }
     }
 
     if (!readOnly && !confFile->isWritable()) {
@@ -1369,10 +1425,18 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
     if (!readOnly)
         mustReadFile = (confFile->size != fileInfo.size()
                         || (confFile->size != 0 && confFile->timeStamp != fileInfo.lastModified()));
+#ifndef QT_BOOTSTRAPPED
+    if (!readOnly && store && store->changeState() == QSettingsBinaryStore::Changed)
+        mustReadFile = true;
+#endif
 
     if (mustReadFile) {
         confFile->unparsedIniSections.clear();
         confFile->originalKeys.clear();
+#ifndef QT_BOOTSTRAPPED
+        if (store)
+            store->unload();
+#endif
 
         QFile file(confFile->name);
         if (!createFile && !file.open(QFile::ReadOnly)) {
@@ -1386,6 +1450,11 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
         */
         if (file.isReadable() && file.size() != 0) {
             bool ok = false;
+#ifndef QT_BOOTSTRAPPED
+            if (store) {
+                ok = store->load(confFile->name);
+            } else
+#endif
 #ifdef Q_OS_MAC
             if (format == QSettings::NativeFormat) {
                 QByteArray data = file.readAll();
@@ -1422,6 +1491,25 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
         so everything is under control.
     */
     if (!readOnly) {
+#ifndef QT_BOOTSTRAPPED
+        if (store) {
+            if (!writeBinaryStore(confFile)) {
+                setStatus(QSettings::AccessError);
+                return;
+            }
+            // the decoded values are dropped and decoded again from the new store
+            confFile->originalKeys.clear();
+            confFile->addedKeys.clear();
+            confFile->removedKeys.clear();
+
+            QFileInfo fileInfo(confFile->name);
+            confFile->size = fileInfo.size();
+            confFile->timeStamp = fileInfo.lastModified();
+            if (createFile)
+                setCreatedFilePermissions(confFile, fileInfo);
+            return;
+        }
+#endif
         bool ok = false;
         ensureAllSectionsParsed(confFile);
         ParsedSettingsMap mergedKeys = confFile->mergedKeyMap();
@@ -1471,18 +1559,66 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
             confFile->timeStamp = fileInfo.lastModified();
 
             // If we have created the file, apply the file perms
-            if (createFile) {
-                QFile::Permissions perms = fileInfo.permissions() | QFile::ReadOwner | QFile::WriteOwner;
-                if (!confFile->userPerms)
-                    perms |= QFile::ReadGroup | QFile::ReadOther;
-                QFile(confFile->name).setPermissions(perms);
-            }
+            if (createFile)
+                setCreatedFilePermissions(confFile, fileInfo);
         } else {
             setStatus(QSettings::AccessError);
         }
     }
 }
 
+#ifndef QT_BOOTSTRAPPED
+QSettingsBinaryStore *QConfFileSettingsPrivate::binaryStore(QConfFile *confFile) const
+{
+    return binaryFormat ? confFile->binaryStore.data() : nullptr;
+}
+
+/*
+    Writes the pending changes of \a confFile to its binary store, either by
+    appending them to the log, or by compacting the store into a new file.
+    The caller holds the lock file.
+*/
+bool QConfFileSettingsPrivate::writeBinaryStore(QConfFile *confFile)
+{
+    QSettingsBinaryStore *store = confFile->binaryStore.data();
+
+    QMap<QString, QVariant> addedKeys;
+    for (auto i = confFile->addedKeys.cbegin(); i != confFile->addedKeys.cend(); ++i)
+        addedKeys.insert(i.key(), i.value());
+    QStringList removedKeys;
+    for (auto i = confFile->removedKeys.cbegin(); i != confFile->removedKeys.cend(); ++i)
+        removedKeys.append(i.key());
+
+    if (!store->needsCompaction())
+        return store->append(confFile->name, addedKeys, removedKeys) && store->load(confFile->name);
+
+    // Readers map the store, so it is always replaced atomically
+#if QT_CONFIG(temporaryfile)
+    QSaveFile sf(confFile->name);
+#else
+    QFile sf(confFile->name);
+#endif
+    if (!sf.open(QIODevice::WriteOnly) || !store->write(sf, addedKeys, removedKeys))
+        return false;
+
+#if QT_CONFIG(temporaryfile)
+#  ifndef Q_OS_WIN
+    QFile oldFile(confFile->name);
+    const bool replacing = oldFile.open(QIODevice::ReadWrite);
+#  endif
+    if (!sf.commit())
+        return false;
+#  ifndef Q_OS_WIN
+    if (replacing)
+        QSettingsBinaryStore::markSuperseded(oldFile);
+#  endif
+#else
+    sf.close();
+#endif
+    return store->load(confFile->name);
+}
+#endif // QT_BOOTSTRAPPED
+
 enum { Space = 0x1, Special = 0x2 };
 
 static const char charTraits[256] =
@@ -1846,6 +1982,16 @@ void QConfFileSettingsPrivate::ensureAllSectionsParsed(QConfFile *confFile) cons
 void QConfFileSettingsPrivate::ensureSectionParsed(QConfFile *confFile,
                                                    const QSettingsKey &key) const
 {
+#ifndef QT_BOOTSTRAPPED
+    // values of a binary store are decoded one key at a time
+    if (const QSettingsBinaryStore *store = binaryStore(confFile)) {
+        QVariant value;
+        if (!confFile->originalKeys.contains(key) && store->value(key, &value))
+            confFile->originalKeys.insert(key, value);
+        return;
+    }
+#endif
+
     if (confFile->unparsedIniSections.isEmpty())
         return;
 
@@ -3453,6 +3599,59 @@ QSettings::Format QSettings::registerFormat(const QString &extension, ReadFunc r
     info.readFunc = readFunc;
     info.writeFunc = writeFunc;
     info.caseSensitivity = caseSensitivity;
+    info.binary = false;
+    customFormatVector->append(info);
+
+    return QSettings::Format((int)QSettings::CustomFormat1 + index);
+}
+
+/*!
+    \since 6.0
+    \threadsafe
+
+    Registers a binary storage format for settings files with the given
+    \a extension (without the '.'), such as "qsb". On success, returns a
+    special Format value that can then be passed to the QSettings
+    constructor. On failure, returns InvalidFormat. Registering the same
+    extension again returns the same Format value.
+
+    Settings files in this format are mapped into memory and keep their
+    keys in a sorted index, so opening a file does not depend on the
+    number of keys it holds, and values are only decoded when they are
+    read. Changes made with sync() are appended to a log at the end of the
+    file, which is compacted into a new file from time to time. Other
+    processes that use the same file notice changes without having to
+    check the file's modification time.
+
+    Keys are always case sensitive. Values are stored with QDataStream, so
+    any type that can be streamed into a QVariant can be stored. The files
+    use the byte order of the host and cannot be shared between machines
+    of different endianness. Files in this format are always replaced
+    atomically; setAtomicSyncRequired() has no effect on them.
+
+    \sa registerFormat(), setPath()
+*/
+QSettings::Format QSettings::registerBinaryFormat(const QString &extension)
+{
+    const auto locker = qt_scoped_lock(settingsGlobalMutex);
+    CustomFormatVector *customFormatVector = customFormatVectorFunc();
+    const QString dottedExtension = QLatin1Char('.') + extension;
+    for (int i = 0; i < customFormatVector->size(); ++i) {
+        const QConfFileCustomFormat &info = customFormatVector->at(i);
+        if (info.binary && info.extension == dottedExtension)
+            return QSettings::Format((int)QSettings::CustomFormat1 + i);
+    }
+
+    int index = customFormatVector->size();
+    if (index == 16) // the QSettings::Format enum has room for 16 custom formats
+        return QSettings::InvalidFormat;
+
+    QConfFileCustomFormat info;
+    info.extension = dottedExtension;
+    info.readFunc = nullptr;
+    info.writeFunc = nullptr;
+    info.caseSensitivity = Qt::CaseSensitive;
+    info.binary = true;
     customFormatVector->append(info);
 
     return QSettings::Format((int)QSettings::CustomFormat1 + index);
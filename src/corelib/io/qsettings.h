@@ -189,6 +189,7 @@ public:
 
     static Format registerFormat(const QString &extension, ReadFunc readFunc, WriteFunc writeFunc,
                                  Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive);
+    static Format registerBinaryFormat(const QString &extension);
 
 protected:
 #ifndef QT_NO_QOBJECT
@@ -148,6 +148,8 @@ inline QString QSettingsGroup::toString() const
     return result;
 }
 
+class QSettingsBinaryStore;
+
 class Q_AUTOTEST_EXPORT QConfFile
 {
 public:
@@ -166,6 +168,9 @@ public:
     ParsedSettingsMap originalKeys;
     ParsedSettingsMap addedKeys;
     ParsedSettingsMap removedKeys;
+#ifndef QT_BOOTSTRAPPED
+    QScopedPointer<QSettingsBinaryStore> binaryStore;
+#endif
     QAtomicInt ref;
     QMutex mutex;
     bool userPerms;
@@ -285,6 +290,10 @@ private:
     void initFormat();
     virtual void initAccess();
     void syncConfFile(QConfFile *confFile);
+#ifndef QT_BOOTSTRAPPED
+    QSettingsBinaryStore *binaryStore(QConfFile *confFile) const;
+    bool writeBinaryStore(QConfFile *confFile);
+#endif
     bool writeIniFile(QIODevice &device, const ParsedSettingsMap &map);
 #ifdef Q_OS_MAC
     bool readPlistFile(const QByteArray &data, ParsedSettingsMap *map) const;
@@ -298,6 +307,7 @@ private:
     QSettings::WriteFunc writeFunc;
     QString extension;
     Qt::CaseSensitivity caseSensitivity;
+    bool binaryFormat;
     int nextPosition;
 #ifdef Q_OS_WASM
     friend class QWasmSettingsPrivate;
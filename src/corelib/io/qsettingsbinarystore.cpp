@@ -0,0 +1,520 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qsettingsbinarystore_p.h"
+
+#include <QtCore/qdatastream.h>
+#include <QtCore/qendian.h>
+#include <QtCore/qset.h>
+
+#include <algorithm>
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QSettingsBinaryStore
+    \inmodule QtCore
+    \internal
+
+    QSettingsBinaryStore implements the file format used by the formats
+    created with QSettings::registerBinaryFormat(). The file is mapped into
+    memory and nothing but its header is read when it is loaded; values are
+    decoded one at a time when they are first looked up.
+
+    A file consists of a header, a data area holding the keys (as UTF-16 in
+    host byte order) and the values (as QVariants serialized with
+    QDataStream), an index of all keys in the data area sorted by key, and
+    an append log. All offsets are 32-bit, so a store is limited to 4 GB.
+
+    Each log record holds a key and either a new value or a removal marker,
+    later records overriding earlier ones. Writers hold the QSettings lock
+    file, append their records past the end of the log, and only then update
+    the log end and the generation counter in the header. When the log has
+    grown too large compared to the rest of the file, the writer compacts
+    the store into a new file instead and marks the old one as superseded.
+
+    Since the file is mapped with MAP_SHARED, other processes see the new
+    generation (or the superseded flag) in their own mapping, which allows
+    them to detect changes without calling stat() on every sync. On Windows
+    a mapped file cannot be replaced, so the file is read into memory
+    instead and QSettings falls back to comparing size and modification
+    time.
+*/
+
+namespace {
+enum : quint32 {
+    Magic = 0x31425351,         // "QSB1", in host byte order
+    FormatVersion = 1,
+    SupersededFlag = 0x1
+};
+
+enum HeaderField : quint32 {
+    MagicField = 0,
+    VersionField = 4,
+    DataStreamVersionField = 8,
+    KeyCountField = 12,
+    IndexOffsetField = 16,
+    LogOffsetField = 20,
+    LogEndField = 24,
+    GenerationField = 28,
+    FlagsField = 32,
+    HeaderSize = 40
+};
+
+enum IndexEntryField : quint32 {
+    KeyOffsetField = 0,
+    KeyLengthField = 4,
+    ValueOffsetField = 8,
+    ValueSizeField = 12,
+    IndexEntrySize = 16
+};
+
+// Compact the store when the log exceeds this size and half of the
+// compacted part of the file.
+const qint64 MinimumCompactionLogSize = 64 * 1024;
+}
+
+static inline quint32 readField(const uchar *data, quint32 offset)
+{
+    return qFromUnaligned<quint32>(data + offset);
+}
+
+static inline quint32 readVolatileField(const uchar *data, quint32 offset)
+{
+    // the header of a mapped file may be changed by another process at any time
+    return *reinterpret_cast<const volatile quint32 *>(data + offset);
+}
+
+static inline void appendField(QByteArray &data, quint32 value)
+{
+    data.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+static inline void appendPadding(QByteArray &data)
+{
+    data.append((4 - (data.size() & 3)) & 3, '\0');
+}
+
+static inline qint64 aligned(qint64 size)
+{
+    return (size + 3) & ~qint64(3);
+}
+
+static QByteArray encodeValue(const QVariant &value, int version)
+{
+    QByteArray result;
+    QDataStream stream(&result, QIODevice::WriteOnly);
+    stream.setVersion(version);
+    stream << value;
+    return result;
+}
+
+static void appendLogRecord(QByteArray &log, const QString &key, const QByteArray *value)
+{
+    appendField(log, quint32(key.size()));
+    appendField(log, value ? quint32(value->size()) : quint32(-1));
+    log.append(reinterpret_cast<const char *>(key.utf16()), key.size() * sizeof(QChar));
+    appendPadding(log);
+    if (value) {
+        log.append(*value);
+        appendPadding(log);
+    }
+}
+
+static bool writeField(QFile &file, quint32 offset, quint32 value)
+{
+    return file.seek(offset)
+            && file.write(reinterpret_cast<const char *>(&value), sizeof(value)) == sizeof(value)
+            && file.flush();
+}
+
+QSettingsBinaryStore::QSettingsBinaryStore()
+{
+}
+
+QSettingsBinaryStore::~QSettingsBinaryStore()
+{
+    unload();
+}
+
+/*!
+    Maps the store in \a fileName. Returns \c false if the file cannot be
+    opened or is not a valid store, in which case the store is left empty.
+*/
+bool QSettingsBinaryStore::load(const QString &fileName)
+{
+    // A writer may extend the file between our fstat() and our look at the
+    // header; in that case the log end lies beyond the mapping and we retry.
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        unload();
+
+        file.setFileName(fileName);
+        if (!file.open(QIODevice::ReadOnly))
+            return false;
+        dataSize = file.size();
+        if (dataSize < HeaderSize || dataSize > std::numeric_limits<quint32>::max()) {
+            unload();
+            return false;
+        }
+
+#ifndef Q_OS_WIN
+        data = file.map(0, dataSize);
+#endif
+        if (!data) {
+            buffer = file.readAll();
+            file.close();
+            if (buffer.size() != dataSize) {
+                unload();
+                return false;
+            }
+            data = reinterpret_cast<const uchar *>(buffer.constData());
+        }
+
+        if (readField(data, MagicField) != Magic || readField(data, VersionField) != FormatVersion) {
+            unload();
+            return false;
+        }
+
+        // read the generation first: the writer updates it last
+        generation = readVolatileField(data, GenerationField);
+        logEnd = readVolatileField(data, LogEndField);
+        dataStreamVersion = int(readField(data, DataStreamVersionField));
+        keyCount = readField(data, KeyCountField);
+        indexOffset = readField(data, IndexOffsetField);
+        logOffset = readField(data, LogOffsetField);
+
+        if (logEnd > dataSize)
+            continue;
+
+        if (indexOffset < HeaderSize || indexOffset % 4 != 0
+            || quint64(indexOffset) + quint64(keyCount) * IndexEntrySize > logOffset
+            || logOffset > logEnd || logOffset % 4 != 0) {
+            break;
+        }
+
+        if (parseLog())
+            return true;
+        break;
+    }
+
+    unload();
+    return false;
+}
+
+/*!
+    Unmaps the store and releases all memory held by it.
+*/
+void QSettingsBinaryStore::unload()
+{
+    if (data && buffer.isEmpty())
+        file.unmap(const_cast<uchar *>(data));
+    file.close();
+    data = nullptr;
+    dataSize = 0;
+    buffer.clear();
+    keyCount = indexOffset = logOffset = logEnd = generation = 0;
+    dataStreamVersion = 0;
+    log.clear();
+}
+
+/*!
+    Returns whether the file has been changed by a writer since it was
+    loaded, or Unknown if the store is not mapped.
+*/
+QSettingsBinaryStore::ChangeState QSettingsBinaryStore::changeState() const
+{
+    if (!data || !buffer.isEmpty())
+        return Unknown;
+    if (readVolatileField(data, FlagsField) & SupersededFlag)
+        return Changed;
+    return readVolatileField(data, GenerationField) == generation ? Unchanged : Changed;
+}
+
+bool QSettingsBinaryStore::parseLog()
+{
+    qint64 pos = logOffset;
+    while (pos < logEnd) {
+        if (logEnd - pos < 8)
+            return false;
+        const quint32 keyLength = readField(data, pos);
+        const qint32 valueSize = qint32(readField(data, pos + 4));
+        const qint64 keyPos = pos + 8;
+        pos = keyPos + aligned(qint64(keyLength) * 2);
+        if (pos > logEnd || valueSize < -1)
+            return false;
+
+        const LogEntry entry = { quint32(pos), valueSize };
+        if (valueSize >= 0) {
+            pos += aligned(valueSize);
+            if (pos > logEnd)
+                return false;
+        }
+        log.insert(QString(reinterpret_cast<const QChar *>(data + keyPos), keyLength), entry);
+    }
+    return true;
+}
+
+QStringView QSettingsBinaryStore::keyAt(quint32 index) const
+{
+    const uchar *entry = data + indexOffset + index * IndexEntrySize;
+    const quint32 keyOffset = readField(entry, KeyOffsetField);
+    const quint32 keyLength = readField(entry, KeyLengthField);
+    if (keyOffset % 2 != 0 || quint64(keyOffset) + quint64(keyLength) * 2 > indexOffset)
+        return QStringView();
+    return QStringView(reinterpret_cast<const QChar *>(data + keyOffset), keyLength);
+}
+
+quint32 QSettingsBinaryStore::lowerBound(QStringView key) const
+{
+    quint32 first = 0;
+    quint32 count = keyCount;
+    while (count > 0) {
+        const quint32 step = count / 2;
+        if (keyAt(first + step).compare(key) < 0) {
+            first += step + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    return first;
+}
+
+bool QSettingsBinaryStore::rawValue(const QString &key, QByteArray *value) const
+{
+    if (!data)
+        return false;
+
+    quint32 valueOffset;
+    quint32 valueSize;
+    const auto it = log.constFind(key);
+    if (it != log.constEnd()) {
+        if (it->valueSize < 0)
+            return false;
+        valueOffset = it->valueOffset;
+        valueSize = quint32(it->valueSize);
+    } else {
+        const quint32 index = lowerBound(key);
+        if (index == keyCount || keyAt(index) != key)
+            return false;
+        const uchar *entry = data + indexOffset + index * IndexEntrySize;
+        valueOffset = readField(entry, ValueOffsetField);
+        valueSize = readField(entry, ValueSizeField);
+        if (quint64(valueOffset) + valueSize > indexOffset)
+            return false;
+    }
+
+    if (value)
+        *value = QByteArray::fromRawData(reinterpret_cast<const char *>(data + valueOffset), valueSize);
+    return true;
+}
+
+/*!
+    Returns \c true if the store holds a value for \a key.
+*/
+bool QSettingsBinaryStore::contains(const QString &key) const
+{
+    return rawValue(key, nullptr);
+}
+
+/*!
+    Decodes the value stored for \a key into \a value. Returns \c false if
+    there is no such key, or if its value cannot be decoded.
+*/
+bool QSettingsBinaryStore::value(const QString &key, QVariant *value) const
+{
+    QByteArray raw;
+    if (!rawValue(key, &raw))
+        return false;
+
+    QDataStream stream(raw);
+    stream.setVersion(dataStreamVersion);
+    stream >> *value;
+    return stream.status() == QDataStream::Ok;
+}
+
+/*!
+    Returns the sorted list of keys starting with \a prefix, without
+    decoding any value.
+*/
+QStringList QSettingsBinaryStore::keys(const QString &prefix) const
+{
+    QStringList result;
+    if (!data)
+        return result;
+
+    for (quint32 i = lowerBound(prefix); i < keyCount; ++i) {
+        const QStringView key = keyAt(i);
+        if (!key.startsWith(prefix))
+            break;
+        QString keyString = key.toString();
+        if (!log.contains(keyString))
+            result.append(std::move(keyString));
+    }
+    for (auto it = log.cbegin(), end = log.cend(); it != end; ++it) {
+        if (it->valueSize >= 0 && it.key().startsWith(prefix))
+            result.append(it.key());
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+/*!
+    Returns \c true if the next write should rewrite the whole file rather
+    than append to the log.
+*/
+bool QSettingsBinaryStore::needsCompaction() const
+{
+    if (!data)
+        return true;
+    return logEnd - logOffset >= qMax<qint64>(MinimumCompactionLogSize, logOffset / 2);
+}
+
+/*!
+    Appends \a addedKeys and \a removedKeys to the log of the store in
+    \a fileName, which must be the file this store was loaded from. The
+    caller must hold the settings lock file.
+*/
+bool QSettingsBinaryStore::append(const QString &fileName, const QMap<QString, QVariant> &addedKeys,
+                                  const QStringList &removedKeys) const
+{
+    if (!data)
+        return false;
+
+    QByteArray records;
+    for (const QString &key : removedKeys)
+        appendLogRecord(records, key, nullptr);
+    for (auto it = addedKeys.cbegin(), end = addedKeys.cend(); it != end; ++it) {
+        const QByteArray value = encodeValue(it.value(), dataStreamVersion);
+        appendLogRecord(records, it.key(), &value);
+    }
+
+    const qint64 newLogEnd = qint64(logEnd) + records.size();
+    if (newLogEnd > std::numeric_limits<quint32>::max())
+        return false;
+
+    QFile storeFile(fileName);
+    if (!storeFile.open(QIODevice::ReadWrite))
+        return false;
+    if (!storeFile.seek(logEnd) || storeFile.write(records) != records.size() || !storeFile.flush())
+        return false;
+
+    // publish the records: readers look at the generation first
+    return writeField(storeFile, LogEndField, quint32(newLogEnd))
+            && writeField(storeFile, GenerationField, generation + 1);
+}
+
+/*!
+    Writes a compacted store to \a device that holds the contents of this
+    store with \a addedKeys and \a removedKeys applied. Values that did not
+    change are copied without being decoded.
+*/
+bool QSettingsBinaryStore::write(QIODevice &device, const QMap<QString, QVariant> &addedKeys,
+                                 const QStringList &removedKeys) const
+{
+    const int version = data ? dataStreamVersion : int(QDataStream::Qt_DefaultCompiledVersion);
+
+    QMap<QString, QByteArray> entries;
+    const QSet<QString> removed(removedKeys.cbegin(), removedKeys.cend());
+    const QStringList storedKeys = keys(QString());
+    for (const QString &key : storedKeys) {
+        QByteArray value;
+        if (!removed.contains(key) && rawValue(key, &value))
+            entries.insert(key, value);
+    }
+    for (auto it = addedKeys.cbegin(), end = addedKeys.cend(); it != end; ++it)
+        entries.insert(it.key(), encodeValue(it.value(), version));
+
+    QByteArray area;
+    QByteArray index;
+    index.reserve(entries.size() * IndexEntrySize);
+    for (auto it = entries.cbegin(), end = entries.cend(); it != end; ++it) {
+        const qint64 keyOffset = HeaderSize + area.size();
+        area.append(reinterpret_cast<const char *>(it.key().utf16()), it.key().size() * sizeof(QChar));
+        appendPadding(area);
+        const qint64 valueOffset = HeaderSize + area.size();
+        area.append(it.value());
+        appendPadding(area);
+
+        appendField(index, quint32(keyOffset));
+        appendField(index, quint32(it.key().size()));
+        appendField(index, quint32(valueOffset));
+        appendField(index, quint32(it.value().size()));
+    }
+
+    const qint64 indexOffset = HeaderSize + area.size();
+    const qint64 logOffset = indexOffset + index.size();
+    if (logOffset > std::numeric_limits<quint32>::max())
+        return false;
+
+    QByteArray header;
+    header.reserve(HeaderSize);
+    appendField(header, Magic);
+    appendField(header, FormatVersion);
+    appendField(header, quint32(version));
+    appendField(header, quint32(entries.size()));
+    appendField(header, quint32(indexOffset));
+    appendField(header, quint32(logOffset));
+    appendField(header, quint32(logOffset));    // log end
+    appendField(header, generation + 1);
+    appendField(header, 0);                     // flags
+    appendField(header, 0);                     // reserved
+
+    return device.write(header) == header.size()
+            && device.write(area) == area.size()
+            && device.write(index) == index.size();
+}
+
+/*!
+    Flags the store in \a oldFile as replaced by a compacted file, so that
+    processes still mapping it reload the store.
+*/
+bool QSettingsBinaryStore::markSuperseded(QFile &oldFile)
+{
+    quint32 flags;
+    if (!oldFile.seek(FlagsField)
+        || oldFile.read(reinterpret_cast<char *>(&flags), sizeof(flags)) != sizeof(flags)) {
+        return false;
+    }
+    return writeField(oldFile, FlagsField, flags | SupersededFlag);
+}
+
+QT_END_NAMESPACE
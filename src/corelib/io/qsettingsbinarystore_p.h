@@ -0,0 +1,123 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QSETTINGSBINARYSTORE_P_H
+#define QSETTINGSBINARYSTORE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmap.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qvariant.h>
+
+QT_REQUIRE_CONFIG(settings);
+
+QT_BEGIN_NAMESPACE
+
+class Q_AUTOTEST_EXPORT QSettingsBinaryStore
+{
+public:
+    enum ChangeState {
+        Unchanged,
+        Changed,
+        Unknown
+    };
+
+    QSettingsBinaryStore();
+    ~QSettingsBinaryStore();
+
+    bool load(const QString &fileName);
+    void unload();
+    ChangeState changeState() const;
+
+    bool contains(const QString &key) const;
+    bool value(const QString &key, QVariant *value) const;
+    QStringList keys(const QString &prefix) const;
+
+    bool needsCompaction() const;
+    bool append(const QString &fileName, const QMap<QString, QVariant> &addedKeys,
+                const QStringList &removedKeys) const;
+    bool write(QIODevice &device, const QMap<QString, QVariant> &addedKeys,
+               const QStringList &removedKeys) const;
+    static bool markSuperseded(QFile &oldFile);
+
+private:
+    Q_DISABLE_COPY(QSettingsBinaryStore)
+
+    struct LogEntry
+    {
+        quint32 valueOffset;
+        qint32 valueSize;           // -1 for keys removed by the log
+    };
+
+    QStringView keyAt(quint32 index) const;
+    quint32 lowerBound(QStringView key) const;
+    bool rawValue(const QString &key, QByteArray *value) const;
+    bool parseLog();
+
+    QFile file;
+    const uchar *data = nullptr;
+    qint64 dataSize = 0;
+    QByteArray buffer;              // file contents when not mapped
+    quint32 keyCount = 0;
+    quint32 indexOffset = 0;
+    quint32 logOffset = 0;
+    quint32 logEnd = 0;
+    quint32 generation = 0;
+    int dataStreamVersion = 0;
+    QHash<QString, LogEntry> log;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSETTINGSBINARYSTORE_P_H
@@ -8,6 +8,7 @@ HEADERS += \
         kernel/qdeadlinetimer_p.h \
         kernel/qelapsedtimer.h \
         kernel/qeventloop.h \
+        kernel/qeventloopstatistics_p.h \
         kernel/qpointer.h \
         kernel/qcorecmdlineargs_p.h \
         kernel/qcoreapplication.h \
@@ -56,6 +57,7 @@ SOURCES += \
         kernel/qdeadlinetimer.cpp \
         kernel/qelapsedtimer.cpp \
         kernel/qeventloop.cpp \
+        kernel/qeventloopstatistics.cpp \
         kernel/qcoreapplication.cpp \
         kernel/qcoreevent.cpp \
         kernel/qmetacontainer.cpp \
@@ -61,6 +61,7 @@
 #include <qthread.h>
 #include <qthreadstorage.h>
 #include <private/qthread_p.h>
+#include "qeventloopstatistics_p.h"
 #if QT_CONFIG(thread)
 #include <qthreadpool.h>
 #endif
@@ -123,6 +124,7 @@
 #endif
 
 #include <algorithm>
+#include <chrono>
 
 QT_BEGIN_NAMESPACE
 
@@ -384,6 +386,13 @@ Q_GLOBAL_STATIC(QCoreApplicationData, coreappdata)
 
 #ifndef QT_NO_QOBJECT
 static bool quitLockRefEnabled = true;
+
+// the clock used for QPostEvent::postedAt
+static inline qint64 postedEventClock()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
 #endif
 
 #if defined(Q_OS_WIN)
@@ -846,6 +855,7 @@ void QCoreApplicationPrivate::init()
 #endif
 
 #ifndef QT_NO_QOBJECT
+    QEventLoopStatistics::setupFromEnvironment();
     is_app_running = true; // No longer starting up.
 #endif
 }
@@ -1035,6 +1045,17 @@ bool QCoreApplication::notifyInternal2(QObject *receiver, QEvent *event)
     QObjectPrivate *d = receiver->d_func();
     QThreadData *threadData = d->threadData;
     QScopedScopeLevelCounter scopeLevelCounter(threadData);
+    if (Q_UNLIKELY(qtHookData[QHooks::EventNotifyBegin])) {
+        reinterpret_cast<QHooks::EventNotifyBeginCallback>(qtHookData[QHooks::EventNotifyBegin])(receiver, event);
+        const auto endHook = reinterpret_cast<QHooks::EventNotifyEndCallback>(qtHookData[QHooks::EventNotifyEnd]);
+        const auto notifyEnd = qScopeGuard([endHook, receiver, event] {
+            if (endHook)
+                endHook(receiver, event);
+        });
+        if (!selfRequired)
+            return doNotify(receiver, event);
+        return self->notify(receiver, event);
+    }
     if (!selfRequired)
         return doNotify(receiver, event);
     return self->notify(receiver, event);
@@ -1516,6 +1537,9 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         return;
     }
 
+    // only timestamp the event when someone is interested in its queue time
+    const qint64 postedAt = Q_UNLIKELY(qtHookData[QHooks::EventDequeued]) ? postedEventClock() : 0;
+
     auto locker = QCoreApplicationPrivate::lockThreadPostEventList(receiver);
     if (!locker.threadData) {
         // posting during destruction? just delete the event to prevent a leak
@@ -1561,7 +1585,7 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
     // properly owned in the postEventList
     QScopedPointer<QEvent> eventDeleter(event);
     Q_TRACE(QCoreApplication_postEvent_event_posted, receiver, event, event->type());
-    data->postEventList.addEvent(QPostEvent(receiver, event, priority));
+    data->postEventList.addEvent(QPostEvent(receiver, event, priority, postedAt));
     eventDeleter.take();
     event->posted = true;
     ++receiver->d_func()->postedEvents;
@@ -1777,6 +1801,7 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
         pe.event->posted = false;
         QEvent *e = pe.event;
         QObject * r = pe.receiver;
+        const qint64 postedAt = pe.postedAt;
 
         --r->d_func()->postedEvents;
         Q_ASSERT(r->d_func()->postedEvents >= 0);
@@ -1790,6 +1815,12 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
 
         QScopedPointer<QEvent> event_deleter(e); // will delete the event (with the mutex unlocked)
 
+        if (Q_UNLIKELY(postedAt)) {
+            const auto hook = reinterpret_cast<QHooks::EventDequeuedCallback>(qtHookData[QHooks::EventDequeued]);
+            if (hook)
+                hook(r, e, postedEventClock() - postedAt);
+        }
+
         // after all that work, it's time to deliver the event.
         QCoreApplication::sendEvent(r, e);
 
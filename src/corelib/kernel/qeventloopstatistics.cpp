@@ -0,0 +1,620 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qeventloopstatistics_p.h"
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qcoreevent.h>
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qloggingcategory.h>
+#include <QtCore/qmetaobject.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qvarlengtharray.h>
+#if QT_CONFIG(thread)
+#include <QtCore/qwaitcondition.h>
+#endif
+#include <QtCore/private/qhooks_p.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+Q_LOGGING_CATEGORY(lcEventLoopStatistics, "qt.core.eventloop.statistics")
+
+namespace {
+
+inline qint64 monotonicNSecs()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+struct Record
+{
+    int eventType;
+    QByteArray receiverClass;
+    QEventLoopStatistics::Histogram queueWait;
+    QEventLoopStatistics::Histogram dispatch;
+};
+
+// Everything one thread has recorded. Only the owning thread inserts into
+// records and touches inFlight; it takes the mutex for every modification
+// so that snapshot() and reset() can read from other threads.
+struct ThreadStatistics
+{
+    QMutex mutex;
+    Qt::HANDLE threadId = nullptr;
+    QString threadName;
+    QHash<QPair<int, const QMetaObject *>, Record *> records;
+
+    struct Dispatch {
+        Record *record;
+        qint64 start;
+    };
+    // deliveries can nest, e.g. through sendEvent() or a local event loop
+    QVarLengthArray<Dispatch, 16> inFlight;
+
+    Record *record(QObject *receiver, QEvent *event)
+    {
+        const QMetaObject *metaObject = receiver->metaObject();
+        const auto key = qMakePair(int(event->type()), metaObject);
+        if (Record *r = records.value(key))
+            return r;
+        Record *r = new Record{key.first, metaObject->className(), {}, {}};
+        QMutexLocker locker(&mutex);
+        records.insert(key, r);
+        return r;
+    }
+};
+
+#if QT_CONFIG(thread)
+class StatisticsDumper : public QThread
+{
+public:
+    StatisticsDumper(int interval, const QString &fileName)
+        : interval(interval), fileName(fileName)
+    {
+        setObjectName(QStringLiteral("QEventLoopStatistics dumper"));
+    }
+
+    void stop()
+    {
+        {
+            QMutexLocker locker(&mutex);
+            stopping = true;
+        }
+        condition.wakeAll();
+        wait();
+    }
+
+protected:
+    void run() override;
+
+private:
+    QMutex mutex;
+    QWaitCondition condition;
+    const int interval;
+    const QString fileName;
+    bool stopping = false;
+};
+#endif
+
+struct Registry
+{
+    QMutex mutex;
+    // threads keep writing into their ThreadStatistics until they exit;
+    // then their records are folded into finishedThreads, which is listed
+    // here too once the first thread that recorded anything has finished
+    QList<ThreadStatistics *> threads;
+    ThreadStatistics *finishedThreads = nullptr;
+
+    // QT_EVENTLOOP_STATISTICS state
+    bool environmentSetup = false;
+    QString dumpFileName;
+#if QT_CONFIG(thread)
+    StatisticsDumper *dumper = nullptr;
+#endif
+};
+
+Q_GLOBAL_STATIC(Registry, registry)
+
+// Owns the calling thread's ThreadStatistics and retires them when the
+// thread exits, unless QThread already did so when it finished.
+struct ThreadStatisticsRef
+{
+    ThreadStatistics *stats = nullptr;
+    ~ThreadStatisticsRef() { retire(); }
+    void retire();
+};
+thread_local ThreadStatisticsRef currentThreadStatistics;
+
+void ThreadStatisticsRef::retire()
+{
+    // events delivered after this start afresh
+    const std::unique_ptr<ThreadStatistics> finished(std::exchange(stats, nullptr));
+    if (!finished)
+        return;
+    if (Registry *r = registry()) {
+        QMutexLocker locker(&r->mutex);
+        r->threads.removeOne(finished.get());
+        for (auto it = finished->records.cbegin(), end = finished->records.cend(); it != end; ++it) {
+            const Record *record = it.value();
+            if (!record->queueWait.count() && !record->dispatch.count())
+                continue;
+            if (!r->finishedThreads) {
+                r->finishedThreads = new ThreadStatistics;
+                r->finishedThreads->threadName = QStringLiteral("finished threads");
+                r->threads.append(r->finishedThreads);
+            }
+            QMutexLocker finishedLocker(&r->finishedThreads->mutex);
+            Record *&target = r->finishedThreads->records[it.key()];
+            if (!target)
+                target = new Record{record->eventType, record->receiverClass, {}, {}};
+            target->queueWait.add(record->queueWait);
+            target->dispatch.add(record->dispatch);
+        }
+    }
+    qDeleteAll(finished->records);
+}
+
+ThreadStatistics *threadStatistics()
+{
+    if (Q_LIKELY(currentThreadStatistics.stats))
+        return currentThreadStatistics.stats;
+
+    auto stats = new ThreadStatistics;
+    stats->threadId = QThread::currentThreadId();
+    if (QThread *thread = QThread::currentThread()) {
+        stats->threadName = thread->objectName();
+        if (stats->threadName.isEmpty() && QCoreApplication::instance()
+            && QCoreApplication::instance()->thread() == thread) {
+            stats->threadName = QStringLiteral("main");
+        }
+    }
+    if (Registry *r = registry()) {
+        QMutexLocker locker(&r->mutex);
+        r->threads.append(stats);
+    }
+    currentThreadStatistics.stats = stats;
+    return stats;
+}
+
+void eventDequeued(QObject *receiver, QEvent *event, qint64 nsecs)
+{
+    ThreadStatistics *stats = threadStatistics();
+    Record *record = stats->record(receiver, event);
+    QMutexLocker locker(&stats->mutex);
+    record->queueWait.record(nsecs);
+}
+
+void eventNotifyBegin(QObject *receiver, QEvent *event)
+{
+    ThreadStatistics *stats = threadStatistics();
+    Record *record = stats->record(receiver, event);
+    stats->inFlight.append({record, monotonicNSecs()});
+}
+
+void eventNotifyEnd(QObject *, QEvent *)
+{
+    const qint64 now = monotonicNSecs();
+    ThreadStatistics *stats = threadStatistics();
+    if (stats->inFlight.isEmpty())
+        return;
+    const ThreadStatistics::Dispatch dispatch = stats->inFlight.last();
+    stats->inFlight.removeLast();
+    QMutexLocker locker(&stats->mutex);
+    dispatch.record->dispatch.record(now - dispatch.start);
+}
+
+const struct {
+    QHooks::HookIndex index;
+    quintptr callback;
+} hooks[] = {
+    { QHooks::EventDequeued, quintptr(&eventDequeued) },
+    { QHooks::EventNotifyBegin, quintptr(&eventNotifyBegin) },
+    { QHooks::EventNotifyEnd, quintptr(&eventNotifyEnd) },
+};
+
+QByteArray eventTypeName(int type)
+{
+    static const QMetaEnum metaEnum = QMetaEnum::fromType<QEvent::Type>();
+    if (const char *key = metaEnum.valueToKey(type))
+        return key;
+    if (type >= QEvent::User && type <= QEvent::MaxUser)
+        return "User+" + QByteArray::number(type - QEvent::User);
+    return QByteArray::number(type);
+}
+
+void writeDump(const QString &fileName)
+{
+    const QString text = QEventLoopStatistics::dump();
+    if (fileName.isEmpty()) {
+        qCInfo(lcEventLoopStatistics).noquote() << text;
+        return;
+    }
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        qCWarning(lcEventLoopStatistics, "Cannot open %ls: %ls",
+                  qUtf16Printable(fileName), qUtf16Printable(file.errorString()));
+        return;
+    }
+    file.write(text.toUtf8());
+}
+
+#if QT_CONFIG(thread)
+void StatisticsDumper::run()
+{
+    QMutexLocker locker(&mutex);
+    while (!stopping) {
+        QDeadlineTimer deadline(interval);
+        while (!stopping && !deadline.hasExpired())
+            condition.wait(&mutex, deadline);
+        if (stopping)
+            break;
+        locker.unlock();
+        writeDump(fileName);
+        locker.relock();
+    }
+}
+#endif
+
+void shutdownFromEnvironment()
+{
+    Registry *r = registry();
+    if (!r)
+        return;
+#if QT_CONFIG(thread)
+    StatisticsDumper *dumper = nullptr;
+#endif
+    QString fileName;
+    {
+        QMutexLocker locker(&r->mutex);
+        if (!r->environmentSetup)
+            return;
+        r->environmentSetup = false;
+        fileName = r->dumpFileName;
+#if QT_CONFIG(thread)
+        dumper = std::exchange(r->dumper, nullptr);
+#endif
+    }
+#if QT_CONFIG(thread)
+    if (dumper) {
+        dumper->stop();
+        delete dumper;
+    }
+#endif
+    writeDump(fileName);
+}
+
+} // unnamed namespace
+
+/*!
+    \class QEventLoopStatistics
+    \inmodule QtCore
+    \internal
+
+    \brief The QEventLoopStatistics class records how long events wait in
+    the event queue and how long their delivery takes.
+
+    Once enabled, every event delivered through QCoreApplication::notify()
+    is accounted to the thread it is delivered in, its QEvent::Type and the
+    class name of its receiver. For each such combination two histograms are
+    kept: the time posted events spent in the queue of the receiver's thread,
+    and the time the delivery took, including event filters and any nested
+    deliveries. Sent events only contribute to the latter.
+
+    The instrumentation is built on the EventDequeued, EventNotifyBegin and
+    EventNotifyEnd hooks in qtHookData. While it is disabled the cost is a
+    load and a branch per event; while it is enabled it adds two clock reads,
+    a hash lookup and an uncontended mutex lock.
+
+    Setting the \c QT_EVENTLOOP_STATISTICS environment variable to a non-zero
+    value enables the instrumentation when QCoreApplication is constructed,
+    and dumps the statistics when it is destroyed. If
+    \c QT_EVENTLOOP_STATISTICS_INTERVAL is set to a number of milliseconds,
+    the statistics are additionally dumped at that interval from a
+    background thread, so that stalls of the main thread show up while they
+    happen. Dumps are logged with the \c qt.core.eventloop.statistics
+    category, or appended to the file named by
+    \c QT_EVENTLOOP_STATISTICS_FILE.
+*/
+
+/*!
+    \class QEventLoopStatistics::Histogram
+    \internal
+
+    A fixed size latency histogram with a bounded relative error, modeled
+    after HdrHistogram. All values are in nanoseconds.
+*/
+
+static inline int histogramBucket(quint64 value) noexcept
+{
+    using H = QEventLoopStatistics::Histogram;
+    if (value < (1U << H::SubBucketBits))
+        return int(value);
+    if (value >= (Q_UINT64_C(1) << H::MaximumBits))
+        return H::BucketCount - 1;
+    const int shift = 63 - qCountLeadingZeroBits(value) - (H::SubBucketBits - 1);
+    return (shift << (H::SubBucketBits - 1)) + int(value >> shift);
+}
+
+static inline qint64 histogramBucketUpperBound(int bucket) noexcept
+{
+    using H = QEventLoopStatistics::Histogram;
+    if (bucket < (1 << H::SubBucketBits))
+        return bucket;
+    const int shift = (bucket >> (H::SubBucketBits - 1)) - 1;
+    const qint64 subBucket = (bucket & ((1 << (H::SubBucketBits - 1)) - 1))
+                             + (1 << (H::SubBucketBits - 1));
+    return ((subBucket + 1) << shift) - 1;
+}
+
+/*!
+    Adds a sample of \a nsecs nanoseconds. Negative values are counted as 0.
+*/
+void QEventLoopStatistics::Histogram::record(qint64 nsecs) noexcept
+{
+    nsecs = qMax(nsecs, qint64(0));
+    if (m_count == 0 || nsecs < m_minimum)
+        m_minimum = nsecs;
+    m_maximum = qMax(m_maximum, nsecs);
+    m_total += nsecs;
+    ++m_count;
+    ++m_buckets[histogramBucket(quint64(nsecs))];
+}
+
+/*!
+    Adds all samples recorded in \a other.
+*/
+void QEventLoopStatistics::Histogram::add(const Histogram &other) noexcept
+{
+    if (other.m_count == 0)
+        return;
+    if (m_count == 0 || other.m_minimum < m_minimum)
+        m_minimum = other.m_minimum;
+    m_maximum = qMax(m_maximum, other.m_maximum);
+    m_total += other.m_total;
+    m_count += other.m_count;
+    for (int i = 0; i < BucketCount; ++i)
+        m_buckets[i] += other.m_buckets[i];
+}
+
+void QEventLoopStatistics::Histogram::reset() noexcept
+{
+    *this = Histogram();
+}
+
+/*!
+    Returns the value below or at which \a percentile percent of the
+    samples lie, rounded up to the end of its bucket and clamped to the
+    recorded range. Returns 0 if nothing has been recorded.
+*/
+qint64 QEventLoopStatistics::Histogram::valueAtPercentile(double percentile) const noexcept
+{
+    if (m_count == 0)
+        return 0;
+    percentile = qBound(0.0, percentile, 100.0);
+    const quint64 rank = qMax(quint64(1), quint64(percentile / 100 * m_count + 0.5));
+    quint64 seen = 0;
+    for (int i = 0; i < BucketCount; ++i) {
+        seen += m_buckets[i];
+        if (seen < rank)
+            continue;
+        // the last bucket is open ended, only the maximum bounds it
+        if (i == BucketCount - 1)
+            return m_maximum;
+        return qBound(m_minimum, histogramBucketUpperBound(i), m_maximum);
+    }
+    return m_maximum;
+}
+
+/*!
+    Installs the event hooks if \a enable is \c true and removes them
+    otherwise. Already recorded data is kept. Returns \c false if another
+    tool already occupies one of the hooks; nothing is changed in that case.
+*/
+bool QEventLoopStatistics::setEnabled(bool enable)
+{
+    for (const auto &hook : hooks) {
+        const quintptr current = qtHookData[hook.index];
+        if (current && current != hook.callback) {
+            qCWarning(lcEventLoopStatistics,
+                      "QEventLoopStatistics: event hooks are in use by another tool");
+            return false;
+        }
+    }
+    // install the end hook before the begin hook, and remove it after the
+    // begin hook, so that no delivery starts without being able to finish
+    if (enable) {
+        for (int i = int(std::size(hooks)) - 1; i >= 0; --i)
+            qtHookData[hooks[i].index] = hooks[i].callback;
+    } else {
+        for (const auto &hook : hooks)
+            qtHookData[hook.index] = 0;
+    }
+    return true;
+}
+
+/*!
+    Returns \c true if the event hooks are installed.
+*/
+bool QEventLoopStatistics::isEnabled()
+{
+    return qtHookData[QHooks::EventNotifyBegin] == hooks[1].callback;
+}
+
+/*!
+    Clears all histograms of all threads.
+*/
+void QEventLoopStatistics::reset()
+{
+    Registry *r = registry();
+    if (!r)
+        return;
+    QMutexLocker locker(&r->mutex);
+    for (ThreadStatistics *stats : qAsConst(r->threads)) {
+        QMutexLocker statsLocker(&stats->mutex);
+        for (Record *record : qAsConst(stats->records)) {
+            record->queueWait.reset();
+            record->dispatch.reset();
+        }
+    }
+}
+
+/*!
+    Merges the data of the calling thread into the "finished threads"
+    entries. Called by QThread when it finishes, so that the registry does
+    not grow with every thread ever started; other threads are handled
+    when they exit.
+*/
+void QEventLoopStatistics::threadFinished()
+{
+    currentThreadStatistics.retire();
+}
+
+/*!
+    Returns a copy of everything recorded so far, grouped by thread in the
+    order the threads first delivered an event, and within a thread sorted
+    by descending total delivery time. The data of threads that have
+    finished is merged into entries with a null thread id and the thread
+    name "finished threads".
+*/
+QList<QEventLoopStatistics::Entry> QEventLoopStatistics::snapshot()
+{
+    QList<Entry> result;
+    Registry *r = registry();
+    if (!r)
+        return result;
+    QMutexLocker locker(&r->mutex);
+    for (ThreadStatistics *stats : qAsConst(r->threads)) {
+        const qsizetype first = result.size();
+        {
+            QMutexLocker statsLocker(&stats->mutex);
+            for (const Record *record : qAsConst(stats->records)) {
+                if (!record->queueWait.count() && !record->dispatch.count())
+                    continue;
+                Entry entry;
+                entry.threadId = stats->threadId;
+                entry.threadName = stats->threadName;
+                entry.eventType = record->eventType;
+                entry.receiverClass = record->receiverClass;
+                entry.queueWait = record->queueWait;
+                entry.dispatch = record->dispatch;
+                result.append(std::move(entry));
+            }
+        }
+        std::sort(result.begin() + first, result.end(), [](const Entry &lhs, const Entry &rhs) {
+            return lhs.dispatch.total() > rhs.dispatch.total();
+        });
+    }
+    return result;
+}
+
+/*!
+    Returns snapshot() formatted as a human readable table. Times are in
+    microseconds.
+*/
+QString QEventLoopStatistics::dump()
+{
+    const auto usecs = [](qint64 nsecs) { return nsecs / 1000.0; };
+    const QList<Entry> entries = snapshot();
+
+    QString result = QStringLiteral("Event loop statistics (times in microseconds)\n");
+    Qt::HANDLE thread = nullptr;
+    for (const Entry &entry : entries) {
+        if (entry.threadId != thread || &entry == &entries.first()) {
+            thread = entry.threadId;
+            result += QString::asprintf("Thread %p \"%ls\"\n", thread,
+                                        qUtf16Printable(entry.threadName));
+            result += QString::asprintf("  %-24s %-32s %9s %9s %9s %9s %9s %9s %9s %11s\n",
+                                        "event", "receiver", "posted", "wait p50", "wait p99",
+                                        "delivered", "p50", "p99", "max", "total");
+        }
+        const Histogram &wait = entry.queueWait;
+        const Histogram &dispatch = entry.dispatch;
+        result += QString::asprintf("  %-24s %-32s %9llu %9.1f %9.1f %9llu %9.1f %9.1f %9.1f %11.1f\n",
+                                    eventTypeName(entry.eventType).constData(),
+                                    entry.receiverClass.constData(),
+                                    wait.count(), usecs(wait.valueAtPercentile(50)),
+                                    usecs(wait.valueAtPercentile(99)),
+                                    dispatch.count(), usecs(dispatch.valueAtPercentile(50)),
+                                    usecs(dispatch.valueAtPercentile(99)),
+                                    usecs(dispatch.maximum()), usecs(dispatch.total()));
+    }
+    return result;
+}
+
+/*!
+    Applies the \c QT_EVENTLOOP_STATISTICS environment variables. Called
+    once QCoreApplication is operational; the final dump and the shutdown of
+    the periodic dumper happen from a post routine.
+*/
+void QEventLoopStatistics::setupFromEnvironment()
+{
+    if (Q_LIKELY(!qEnvironmentVariableIntValue("QT_EVENTLOOP_STATISTICS")))
+        return;
+    Registry *r = registry();
+    if (!r || !setEnabled(true))
+        return;
+
+    QMutexLocker locker(&r->mutex);
+    if (r->environmentSetup)
+        return;
+    r->environmentSetup = true;
+    r->dumpFileName = qEnvironmentVariable("QT_EVENTLOOP_STATISTICS_FILE");
+#if QT_CONFIG(thread)
+    const int interval = qEnvironmentVariableIntValue("QT_EVENTLOOP_STATISTICS_INTERVAL");
+    if (interval > 0) {
+        r->dumper = new StatisticsDumper(interval, r->dumpFileName);
+        r->dumper->start(QThread::LowPriority);
+    }
+#endif
+    locker.unlock();
+    qAddPostRoutine(shutdownFromEnvironment);
+}
+
+QT_END_NAMESPACE
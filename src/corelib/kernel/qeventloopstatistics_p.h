@@ -0,0 +1,123 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QEVENTLOOPSTATISTICS_P_H
+#define QEVENTLOOPSTATISTICS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qstring.h>
+
+QT_BEGIN_NAMESPACE
+
+class Q_CORE_EXPORT QEventLoopStatistics
+{
+public:
+    class Q_CORE_EXPORT Histogram
+    {
+    public:
+        // Log-linear buckets in the spirit of HdrHistogram: values below
+        // 2^SubBucketBits nanoseconds are exact, larger values fall into one
+        // of 2^(SubBucketBits - 1) buckets per power of two, so the relative
+        // error stays below 1 / 2^(SubBucketBits - 1). Values of 2^MaximumBits
+        // nanoseconds (about a minute) and above share an extra, open-ended
+        // bucket at the end.
+        enum : int {
+            SubBucketBits = 4,
+            MaximumBits = 36,
+            BucketCount = ((MaximumBits - SubBucketBits + 2) << (SubBucketBits - 1)) + 1
+        };
+
+        void record(qint64 nsecs) noexcept;
+        void add(const Histogram &other) noexcept;
+        void reset() noexcept;
+
+        quint64 count() const noexcept { return m_count; }
+        qint64 minimum() const noexcept { return m_minimum; }
+        qint64 maximum() const noexcept { return m_maximum; }
+        qint64 total() const noexcept { return m_total; }
+        qint64 valueAtPercentile(double percentile) const noexcept;
+
+    private:
+        quint64 m_count = 0;
+        qint64 m_minimum = 0;
+        qint64 m_maximum = 0;
+        qint64 m_total = 0;
+        quint64 m_buckets[BucketCount] = {};
+    };
+
+    struct Entry
+    {
+        Qt::HANDLE threadId = nullptr;
+        QString threadName;
+        int eventType = 0;
+        QByteArray receiverClass;
+        Histogram queueWait;
+        Histogram dispatch;
+    };
+
+    static bool setEnabled(bool enable);
+    static bool isEnabled();
+    static void reset();
+    static void threadFinished();
+
+    static QList<Entry> snapshot();
+    static QString dump();
+
+    static void setupFromEnvironment();
+};
+
+Q_DECLARE_TYPEINFO(QEventLoopStatistics::Entry, Q_MOVABLE_TYPE);
+
+QT_END_NAMESPACE
+
+#endif // QEVENTLOOPSTATISTICS_P_H
@@ -590,6 +590,32 @@ bool QMetaObjectPrivate::methodMatch(const QMetaObject *m, const QMetaMethod &me
     return true;
 }
 
+static inline bool hasNameHash(const QMetaObject *m)
+{
+    const QMetaObjectPrivate *d = priv(m->d.data);
+    return d->revision >= 10 && d->nameHashData;
+}
+
+/*!
+    \internal
+    Returns the name hash entry for \a name in \a m, which must have a name
+    hash, or \nullptr if none of its methods and properties is called \a name.
+*/
+const uint *QMetaObjectPrivate::nameHashEntry(const QMetaObject *m, const QByteArray &name)
+{
+    const uint *data = m->d.data;
+    const uint *table = data + priv(data)->nameHashData;
+    const uint bucketCount = table[0];
+    const uint size = table[1];
+    const uint *seeds = table + NameHashHeaderSize;
+    const uint hash = nameHash(name.constData(), name.size());
+    const uint slot = nameHashSlot(hash, seeds[hash & (bucketCount - 1)]) & (size - 1);
+    const uint entry = seeds[bucketCount + slot];
+    if (!entry || stringData(m, data[entry]) != name)
+        return nullptr;
+    return data + entry;
+}
+
 /**
 * \internal
 * helper function for indexOf{Method,Slot,Signal}, returns the relative index of the method within
@@ -608,6 +634,25 @@ inline int QMetaObjectPrivate::indexOfMethodRelative(const QMetaObject **baseObj
         const int end = (MethodType == MethodSlot)
                         ? (priv(m->d.data)->signalCount) : 0;
 
+        if (hasNameHash(m)) {
+            // only look at the methods of that name, in the same order
+            const uint *entry = nameHashEntry(m, name);
+            if (!entry)
+                continue;
+            const uint *indexes = entry + NameHashEntryHeaderSize;
+            for (uint j = 0; j < entry[2]; ++j) {
+                const int index = int(indexes[j]);
+                if (index > i || index < end)
+                    continue;
+                auto data = QMetaMethod::fromRelativeMethodIndex(m, index);
+                if (methodMatch(m, data, name, argc, types)) {
+                    *baseObject = m;
+                    return index;
+                }
+            }
+            continue;
+        }
+
         for (; i >= end; --i) {
             auto data = QMetaMethod::fromRelativeMethodIndex(m, i);
             if (methodMatch(m, data, name, argc, types)) {
@@ -1009,9 +1054,17 @@ int QMetaObject::indexOfEnumerator(const char *name) const
 */
 int QMetaObject::indexOfProperty(const char *name) const
 {
+    const QByteArray nameArray = QByteArray::fromRawData(name, qstrlen(name));
     const QMetaObject *m = this;
     while (m) {
         const QMetaObjectPrivate *d = priv(m->d.data);
+        if (hasNameHash(m)) {
+            const uint *entry = QMetaObjectPrivate::nameHashEntry(m, nameArray);
+            if (entry && entry[1])
+                return int(entry[1]) - 1 + m->propertyOffset();
+            m = m->d.superdata;
+            continue;
+        }
         for (int i = 0; i < d->propertyCount; ++i) {
             const QMetaProperty p(m, i);
             const char *prop = rawStringData(m, p.data.name());
@@ -171,7 +171,8 @@ struct QMetaObjectPrivate
     // revision 7 is Qt 5.0 everything lower is not supported
     // revision 8 is Qt 5.12: It adds the enum name to QMetaEnum
     // revision 9 is Qt 6.0: It adds the metatype of properties and methods
-    enum { OutputRevision = 9 }; // Used by moc, qmetaobjectbuilder and qdbus
+    // revision 10 is Qt 6.0: It adds a perfect hash of method and property names
+    enum { OutputRevision = 10 }; // Used by moc, qmetaobjectbuilder and qdbus
     enum { IntsPerMethod = QMetaMethod::Data::Size};
     enum { IntsPerEnum = QMetaEnum::Data::Size };
     enum { IntsPerProperty = QMetaProperty::Data::Size };
@@ -185,6 +186,7 @@ struct QMetaObjectPrivate
     int constructorCount, constructorData;
     int flags;
     int signalCount;
+    int nameHashData;
 
     static inline const QMetaObjectPrivate *get(const QMetaObject *metaobject)
     { return reinterpret_cast<const QMetaObjectPrivate*>(metaobject->d.data); }
@@ -252,6 +254,40 @@ struct QMetaObjectPrivate
                             const QByteArray &name, int argc,
                             const QArgumentType *types);
 
+    // The name hash is a hash and displace table of the method and property
+    // names of the class. It starts with the number of buckets and the size
+    // of the table, both powers of two, followed by a seed for every bucket
+    // and the table. A name with hash h falls into bucket h & (buckets - 1)
+    // and into slot nameHashSlot(h, seed) & (size - 1), where seed is the one
+    // of its bucket; moc chooses the seeds so that no two names of the class
+    // share a slot. A slot holds the data index of the entry for its name, or
+    // 0. An entry is the name, 1 + the relative index of the first property
+    // of that name or 0, the number of methods of that name and their
+    // relative indexes in descending order.
+    enum { NameHashHeaderSize = 2, NameHashEntryHeaderSize = 3 };
+    static constexpr uint nameHashMix(uint h) noexcept
+    {
+        // the MurmurHash3 finalizer
+        h ^= h >> 16;
+        h *= 0x85ebca6bu;
+        h ^= h >> 13;
+        h *= 0xc2b2ae35u;
+        h ^= h >> 16;
+        return h;
+    }
+    static constexpr uint nameHash(const char *name, qsizetype length) noexcept
+    {
+        // FNV-1a
+        uint h = 2166136261u;
+        for (qsizetype i = 0; i < length; ++i)
+            h = (h ^ uchar(name[i])) * 16777619u;
+        return nameHashMix(h);
+    }
+    static constexpr uint nameHashSlot(uint hash, uint seed) noexcept
+    {
+        return nameHashMix(hash ^ (seed * 0x9e3779b9u));
+    }
+    static const uint *nameHashEntry(const QMetaObject *m, const QByteArray &name);
 };
 
 // For meta-object generators
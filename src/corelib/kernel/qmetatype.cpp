@@ -42,7 +42,7 @@
 #include "qobjectdefs.h"
 #include "qdatetime.h"
 #include "qbytearray.h"
-#include "qreadwritelock.h"
+#include "qmutex.h"
 #include "qstring.h"
 #include "qstringlist.h"
 #include "qlist.h"
@@ -86,8 +86,12 @@
 # include "qline.h"
 #endif
 
+#include <array>
+#include <atomic>
 #include <bitset>
+#include <memory>
 #include <new>
+#include <thread>
 #include <cstring>
 
 QT_BEGIN_NAMESPACE
@@ -103,18 +107,305 @@ struct DefinedTypesFilter {
     };
 };
 
+/*
+    A hash table for the meta type registries that readers search without
+    taking a lock; writers serialize on mutex. Published nodes are never
+    modified again, except for being marked as removed. A removed node keeps
+    its slot until an insertion on the same probe sequence takes it over, or
+    until growing the table publishes a new bucket array without it.
+
+    Lookups run inside a ReadGuard, which counts the reader in one of two
+    counters chosen by the parity of epoch. Nodes and bucket arrays that
+    readers can no longer reach are first collected as pending. A writer
+    moves them to grace and advances the epoch, so that new readers count
+    themselves in the other counter; once the counter of the previous epoch
+    has dropped to zero, no reader can still look at what is in grace, and
+    the next writer frees it. Readers only hold a guard for the lookup
+    itself, so when too much is pending, the writer waits for them instead
+    of letting pending grow further.
+*/
+template <typename Key, typename T>
+class QMetaTypeLockFreeHash
+{
+public:
+    struct Node
+    {
+        Node(const Key &key, size_t hash, const T &value)
+            : key(key), hash(hash), value(value)
+        {}
+
+        const Key key;
+        const size_t hash;
+        const T value;
+        QAtomicInt removed;
+        Node *nextAllocated = nullptr;
+    };
+
+    class ReadGuard
+    {
+    public:
+        explicit ReadGuard(const QMetaTypeLockFreeHash &hash)
+            : readers(hash.enterRead())
+        {}
+        ~ReadGuard() { readers->fetch_sub(1, std::memory_order_release); }
+        Q_DISABLE_COPY_MOVE(ReadGuard)
+
+    private:
+        std::atomic<int> *readers;
+    };
+
+    QMetaTypeLockFreeHash() = default;
+    Q_DISABLE_COPY_MOVE(QMetaTypeLockFreeHash)
+
+    ~QMetaTypeLockFreeHash()
+    {
+        delete buckets.loadRelaxed();
+        pending.free();
+        grace.free();
+        for (Node *list : { allocated, removedNodes }) {
+            while (Node *n = list) {
+                list = n->nextAllocated;
+                delete n;
+            }
+        }
+    }
+
+    // may be called without holding mutex, but then only while a ReadGuard
+    // is alive, which also keeps the returned node alive
+    const Node *find(const Key &key) const
+    {
+        const Buckets *b = buckets.loadAcquire();
+        if (!b)
+            return nullptr;
+        const size_t hash = qHash(key);
+        for (size_t i = hash & b->mask; ; i = (i + 1) & b->mask) {
+            const Node *n = b->entries[i].loadAcquire();
+            if (!n)
+                return nullptr;
+            if (n->hash == hash && !n->removed.loadAcquire() && n->key == key)
+                return n;
+        }
+    }
+
+    // the following require mutex to be locked; key must not be in the table
+    const Node *insert(const Key &key, const T &value)
+    {
+        Node *n = new Node(key, qHash(key), value);
+        Buckets *b = buckets.loadRelaxed();
+        if (!b || !replaceRemoved(b, n)) {
+            if (!b || 2 * (used + 1) > b->mask + 1)
+                b = grow(b);
+            place(b, n);
+            ++used;
+        }
+        n->nextAllocated = allocated;
+        allocated = n;
+        reclaim();
+        return n;
+    }
+
+    template <typename Predicate>
+    void removeIf(Predicate pred)
+    {
+        for (Node **link = &allocated; Node *n = *link; ) {
+            if (!pred(n->key, n->value)) {
+                link = &n->nextAllocated;
+                continue;
+            }
+            n->removed.storeRelease(1);
+            *link = n->nextAllocated;
+            n->nextAllocated = removedNodes;
+            removedNodes = n;
+        }
+        reclaim();
+    }
+
+    mutable QMutex mutex;
+
+private:
+    struct Buckets
+    {
+        explicit Buckets(size_t size) : mask(size - 1), entries(new QAtomicPointer<Node>[size]) {}
+
+        const size_t mask;
+        const std::unique_ptr<QAtomicPointer<Node>[]> entries;
+        Buckets *nextRetired = nullptr;
+    };
+
+    struct Retired
+    {
+        Buckets *buckets = nullptr;
+        Node *nodes = nullptr;
+        size_t count = 0;
+
+        bool isEmpty() const { return !count; }
+        void add(Buckets *b)
+        {
+            b->nextRetired = buckets;
+            buckets = b;
+            ++count;
+        }
+        void add(Node *n)
+        {
+            n->nextAllocated = nodes;
+            nodes = n;
+            ++count;
+        }
+        void free()
+        {
+            count = 0;
+            while (Buckets *b = buckets) {
+                buckets = b->nextRetired;
+                delete b;
+            }
+            while (Node *n = nodes) {
+                nodes = n->nextAllocated;
+                delete n;
+            }
+        }
+    };
+
+    std::atomic<int> *enterRead() const
+    {
+        // the epoch may advance between reading it and counting ourselves;
+        // the writer would then not wait for us, so count again
+        for (;;) {
+            const unsigned e = epoch.load();
+            std::atomic<int> *r = &readers[e & 1];
+            r->fetch_add(1);
+            if (epoch.load() == e)
+                return r;
+            r->fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    void reclaim()
+    {
+        enum { MaxPending = 64 };
+        const unsigned e = epoch.load();
+        if (!grace.isEmpty()) {
+            while (readers[(e - 1) & 1].load() != 0) {
+                if (pending.count < MaxPending)
+                    return;
+                std::this_thread::yield();
+            }
+            grace.free();
+        }
+        if (!pending.isEmpty()) {
+            grace = std::exchange(pending, Retired());
+            epoch.store(e + 1);
+        }
+    }
+
+    static void place(Buckets *b, Node *n)
+    {
+        size_t i = n->hash & b->mask;
+        while (b->entries[i].loadRelaxed())
+            i = (i + 1) & b->mask;
+        b->entries[i].storeRelease(n);
+    }
+
+    bool replaceRemoved(Buckets *b, Node *n)
+    {
+        // the slot stays occupied, so probe sequences through it still work
+        for (size_t i = n->hash & b->mask; ; i = (i + 1) & b->mask) {
+            Node *old = b->entries[i].loadRelaxed();
+            if (!old)
+                return false;
+            if (!old->removed.loadRelaxed())
+                continue;
+            b->entries[i].storeRelease(n);
+            Node **link = &removedNodes;
+            while (*link != old)
+                link = &(*link)->nextAllocated;
+            *link = old->nextAllocated;
+            pending.add(old);
+            return true;
+        }
+    }
+
+    Buckets *grow(Buckets *old)
+    {
+        used = 0;
+        for (Node *n = allocated; n; n = n->nextAllocated)
+            ++used;
+        size_t size = 16;
+        while (2 * (used + 1) > size)
+            size *= 2;
+        if (old && size < old->mask + 1)
+            size = old->mask + 1;
+
+        Buckets *b = new Buckets(size);
+        for (Node *n = allocated; n; n = n->nextAllocated)
+            place(b, n);
+        buckets.storeRelease(b);
+
+        // the removed nodes are not carried over
+        if (old)
+            pending.add(old);
+        while (Node *n = removedNodes) {
+            removedNodes = n->nextAllocated;
+            pending.add(n);
+        }
+        return b;
+    }
+
+    QAtomicPointer<Buckets> buckets;
+    Node *allocated = nullptr;
+    Node *removedNodes = nullptr;   // still in buckets
+    Retired pending;
+    Retired grace;
+    size_t used = 0;        // occupied slots of buckets, removed nodes included
+    mutable std::atomic<unsigned> epoch = 0;
+    mutable std::atomic<int> readers[2] = {};
+};
+
 struct QMetaTypeCustomRegistry
 {
-    QReadWriteLock lock;
-    QList<QtPrivate::QMetaTypeInterface *> registry;
-    QHash<QByteArray, QtPrivate::QMetaTypeInterface *> aliases;
+    // Ids index an array that is replaced by a larger copy when it is full;
+    // like the aliases, it can be read without locking.
+    struct TypeArray
+    {
+        explicit TypeArray(int size)
+            : size(size), types(new QAtomicPointer<QtPrivate::QMetaTypeInterface>[size])
+        {}
+
+        const int size;
+        const std::unique_ptr<QAtomicPointer<QtPrivate::QMetaTypeInterface>[]> types;
+        TypeArray *retired = nullptr;
+    };
+
+    QMetaTypeLockFreeHash<QByteArray, QtPrivate::QMetaTypeInterface *> aliases;
+    QAtomicPointer<TypeArray> registry;
+    // number of ids handed out; guarded by aliases.mutex
+    int count = 0;
     // index of first empty (unregistered) type in registry, if any.
     int firstEmpty = 0;
 
+    QMetaTypeCustomRegistry() = default;
+    Q_DISABLE_COPY_MOVE(QMetaTypeCustomRegistry)
+
+    ~QMetaTypeCustomRegistry()
+    {
+        TypeArray *a = registry.loadRelaxed();
+        while (a) {
+            TypeArray *retired = a->retired;
+            delete a;
+            a = retired;
+        }
+    }
+
+    QtPrivate::QMetaTypeInterface *findAlias(const QByteArray &name) const
+    {
+        const decltype(aliases)::ReadGuard guard(aliases);
+        const auto node = aliases.find(name);
+        return node ? node->value : nullptr;
+    }
+
     int registerCustomType(QtPrivate::QMetaTypeInterface *ti)
     {
         {
-            QWriteLocker l(&lock);
+            QMutexLocker l(&aliases.mutex);
             if (ti->typeId)
                 return ti->typeId;
             QByteArray name =
@@ -122,55 +413,69 @@ struct QMetaTypeCustomRegistry
                     QMetaObject::normalizedType
 #endif
                     (ti->name);
-            if (auto ti2 = aliases.value(name)) {
+            if (auto ti2 = findAlias(name)) {
                 ti->typeId.storeRelaxed(ti2->typeId.loadRelaxed());
                 return ti2->typeId;
             }
-            aliases[name] = ti;
-            int size = registry.size();
-            while (firstEmpty < size && registry[firstEmpty])
+            TypeArray *a = registry.loadRelaxed();
+            while (firstEmpty < count && a->types[firstEmpty].loadRelaxed())
                 ++firstEmpty;
-            if (firstEmpty < size) {
-                registry[firstEmpty] = ti;
-                ++firstEmpty;
-            } else {
-                registry.append(ti);
-                firstEmpty = registry.size();
+            if (firstEmpty == count) {
+                if (!a || count == a->size) {
+                    TypeArray *grown = new TypeArray(a ? 2 * a->size : 64);
+                    for (int i = 0; i < count; ++i)
+                        grown->types[i].storeRelaxed(a->types[i].loadRelaxed());
+                    grown->retired = a;
+                    registry.storeRelease(grown);
+                    a = grown;
+                }
+                ++count;
             }
-            ti->typeId = firstEmpty + QMetaType::User;
+            // publish the type before its id, and the id before the name
+            a->types[firstEmpty].storeRelease(ti);
+            ++firstEmpty;
+            ti->typeId.storeRelease(firstEmpty + QMetaType::User);
+            aliases.insert(name, ti);
         }
         if (ti->legacyRegisterOp)
             ti->legacyRegisterOp();
         return ti->typeId;
     };
 
+    void registerAlias(const QByteArray &name, QtPrivate::QMetaTypeInterface *ti)
+    {
+        QMutexLocker l(&aliases.mutex);
+        if (!findAlias(name))
+            aliases.insert(name, ti);
+    }
+
     void unregisterDynamicType(int id)
     {
         if (!id)
             return;
         Q_ASSERT(id > QMetaType::User);
-        QWriteLocker l(&lock);
+        QMutexLocker l(&aliases.mutex);
         int idx = id - QMetaType::User - 1;
-        auto &ti = registry[idx];
+        auto &slot = registry.loadRelaxed()->types[idx];
+        const auto ti = slot.loadRelaxed();
 
         // We must unregister all names.
-        auto it = aliases.begin();
-        while (it != aliases.end()) {
-            if (it.value() == ti)
-                it = aliases.erase(it);
-            else
-                ++it;
-        }
+        aliases.removeIf([ti](const QByteArray &, QtPrivate::QMetaTypeInterface *iface) {
+            return iface == ti;
+        });
 
-        ti = nullptr;
+        slot.storeRelease(nullptr);
 
         firstEmpty = std::min(firstEmpty, idx);
     }
 
-    QtPrivate::QMetaTypeInterface *getCustomType(int id)
+    QtPrivate::QMetaTypeInterface *getCustomType(int id) const
     {
-        QReadLocker l(&lock);
-        return registry.value(id - QMetaType::User - 1);
+        const int idx = id - QMetaType::User - 1;
+        const TypeArray *a = registry.loadAcquire();
+        if (!a || idx < 0 || idx >= a->size)
+            return nullptr;
+        return a->types[idx].loadAcquire();
     }
 };
 
@@ -1516,6 +1821,200 @@ static const struct : QMetaTypeModuleHelper
     }
 } metatypeHelper;
 
+namespace {
+/*
+    The conversions between the builtin number, string and date types are by
+    far the most frequent ones. They are dispatched through a table that is
+    built at compile time, instead of the general path and the switch in
+    metatypeHelper. Every entry behaves exactly like the corresponding case
+    of that switch; pairs without an entry take the general path.
+*/
+template <typename... Types>
+struct BuiltinConversionTypes {};
+
+using BuiltinConversionTypeList = BuiltinConversionTypes<
+        bool, char, signed char, unsigned char, short, unsigned short, int, unsigned int,
+        long, unsigned long, qlonglong, qulonglong, float, double,
+        QString, QByteArray, QDate, QTime, QDateTime>;
+
+template <typename T>
+constexpr bool isBuiltinString = std::is_same_v<T, QString> || std::is_same_v<T, QByteArray>;
+template <typename T>
+constexpr bool isBuiltinCharacter = std::is_same_v<T, char> || std::is_same_v<T, signed char>
+                                    || std::is_same_v<T, unsigned char>;
+
+template <typename To, typename From>
+bool convertBuiltinNumber(const void *from, void *to)
+{
+    const From &source = *static_cast<const From *>(from);
+    To &result = *static_cast<To *>(to);
+    if constexpr (std::is_floating_point_v<From> && !std::is_floating_point_v<To>)
+        result = qRound64(source);
+    else
+        result = To(source);
+    return true;
+}
+
+template <typename To, typename From>
+bool convertBuiltinStringToNumber(const void *from, void *to)
+{
+    const From &source = *static_cast<const From *>(from);
+    To &result = *static_cast<To *>(to);
+    bool ok = false;
+    if constexpr (std::is_same_v<To, bool>)
+        result = (ok = true, metatypeHelper.convertToBool(source));
+    else if constexpr (std::is_floating_point_v<To>)
+        result = source.toDouble(&ok);
+    else if constexpr (std::is_signed_v<To>)
+        result = To(source.toLongLong(&ok));
+    else
+        result = To(source.toULongLong(&ok));
+    return ok;
+}
+
+template <typename To, typename From>
+bool convertBuiltinNumberToString(const void *from, void *to)
+{
+    const From &source = *static_cast<const From *>(from);
+    To &result = *static_cast<To *>(to);
+    if constexpr (std::is_same_v<From, bool>) {
+        if constexpr (std::is_same_v<To, QString>)
+            result = source ? QStringLiteral("true") : QStringLiteral("false");
+        else
+            result = source ? "true" : "false";
+    } else if constexpr (isBuiltinCharacter<From>) {
+        const char c = char(source);
+        result = QString::fromLatin1(&c, 1);
+    } else if constexpr (std::is_floating_point_v<From>) {
+        result = To::number(source, 'g', QLocale::FloatingPointShortest);
+    } else {
+        result = To::number(source);
+    }
+    return true;
+}
+
+template <typename To, typename From>
+constexpr QtPrivate::BuiltinConverterFunction builtinConverterFor()
+{
+    if constexpr (std::is_same_v<To, From>) {
+        return nullptr;
+    } else if constexpr (std::is_arithmetic_v<To> && std::is_arithmetic_v<From>) {
+        return convertBuiltinNumber<To, From>;
+    } else if constexpr (std::is_arithmetic_v<To> && isBuiltinString<From>) {
+        return convertBuiltinStringToNumber<To, From>;
+    } else if constexpr (isBuiltinString<To> && std::is_arithmetic_v<From>) {
+        // QByteArray has its own conversion from characters
+        if constexpr (std::is_same_v<To, QByteArray> && isBuiltinCharacter<From>)
+            return nullptr;
+        else
+            return convertBuiltinNumberToString<To, From>;
+    } else if constexpr (std::is_same_v<To, QString> && std::is_same_v<From, QByteArray>) {
+        return [](const void *from, void *to) {
+            *static_cast<QString *>(to) = QString::fromUtf8(*static_cast<const QByteArray *>(from));
+            return true;
+        };
+    } else if constexpr (std::is_same_v<To, QByteArray> && std::is_same_v<From, QString>) {
+        return [](const void *from, void *to) {
+            *static_cast<QByteArray *>(to) = static_cast<const QString *>(from)->toUtf8();
+            return true;
+        };
+    } else if constexpr (std::is_same_v<To, QDate> && std::is_same_v<From, QDateTime>) {
+        return [](const void *from, void *to) {
+            *static_cast<QDate *>(to) = static_cast<const QDateTime *>(from)->date();
+            return true;
+        };
+    } else if constexpr (std::is_same_v<To, QTime> && std::is_same_v<From, QDateTime>) {
+        return [](const void *from, void *to) {
+            *static_cast<QTime *>(to) = static_cast<const QDateTime *>(from)->time();
+            return true;
+        };
+    } else if constexpr (std::is_same_v<To, QDateTime> && std::is_same_v<From, QDate>) {
+        return [](const void *from, void *to) {
+            *static_cast<QDateTime *>(to) = static_cast<const QDate *>(from)->startOfDay();
+            return true;
+        };
+#if QT_CONFIG(datestring)
+    } else if constexpr (std::is_same_v<To, QString> && std::is_same_v<From, QDate>) {
+        return [](const void *from, void *to) {
+            *static_cast<QString *>(to) = static_cast<const QDate *>(from)->toString(Qt::ISODate);
+            return true;
+        };
+    } else if constexpr (std::is_same_v<To, QString>
+                         && (std::is_same_v<From, QTime> || std::is_same_v<From, QDateTime>)) {
+        return [](const void *from, void *to) {
+            *static_cast<QString *>(to) =
+                    static_cast<const From *>(from)->toString(Qt::ISODateWithMs);
+            return true;
+        };
+    } else if constexpr ((std::is_same_v<To, QDate> || std::is_same_v<To, QTime>
+                          || std::is_same_v<To, QDateTime>) && std::is_same_v<From, QString>) {
+        return [](const void *from, void *to) {
+            To &result = *static_cast<To *>(to);
+            result = To::fromString(*static_cast<const QString *>(from), Qt::ISODate);
+            return result.isValid();
+        };
+#endif
+    } else {
+        return nullptr;
+    }
+}
+
+template <typename... Types>
+using BuiltinConverterRow = std::array<QtPrivate::BuiltinConverterFunction, sizeof...(Types)>;
+
+template <typename To, typename... Types>
+constexpr BuiltinConverterRow<Types...> builtinConverterRow()
+{
+    return {{ builtinConverterFor<To, Types>()... }};
+}
+
+// indexed by [to][from], in the order of the type list
+template <typename... Types>
+constexpr auto makeBuiltinConverterTable(BuiltinConversionTypes<Types...>)
+{
+    return std::array<BuiltinConverterRow<Types...>, sizeof...(Types)>{{
+        builtinConverterRow<Types, Types...>()...
+    }};
+}
+
+// maps a type id to its position in the type list, or -1
+template <typename... Types>
+constexpr auto makeBuiltinConverterIndex(BuiltinConversionTypes<Types...>)
+{
+    std::array<qint8, QMetaType::LastCoreType + 1> index = {};
+    for (qint8 &i : index)
+        i = -1;
+    const int typeIds[] = { QMetaTypeId2<Types>::MetaType... };
+    for (int i = 0; i < int(sizeof...(Types)); ++i)
+        index[typeIds[i]] = qint8(i);
+    return index;
+}
+
+constexpr auto builtinConverterTable = makeBuiltinConverterTable(BuiltinConversionTypeList());
+constexpr auto builtinConverterIndex = makeBuiltinConverterIndex(BuiltinConversionTypeList());
+} // namespace
+
+/*!
+    \internal
+
+    Returns the function converting between the builtin types \a fromTypeId
+    and \a toTypeId without going through QMetaType::convert(), or \c nullptr
+    if there is none. The function returns \c false if the value could not be
+    converted, in which case QMetaType::convert() has to be used to try the
+    remaining conversions.
+*/
+QtPrivate::BuiltinConverterFunction QtPrivate::builtinConverter(int fromTypeId,
+                                                                int toTypeId) noexcept
+{
+    if (uint(fromTypeId) > QMetaType::LastCoreType || uint(toTypeId) > QMetaType::LastCoreType)
+        return nullptr;
+    const int from = builtinConverterIndex[fromTypeId];
+    const int to = builtinConverterIndex[toTypeId];
+    if (from < 0 || to < 0)
+        return nullptr;
+    return builtinConverterTable[to][from];
+}
+
 static const QMetaTypeModuleHelper *qMetaTypeCoreHelper = &metatypeHelper;
 Q_CORE_EXPORT const QMetaTypeModuleHelper *qMetaTypeGuiHelper = nullptr;
 Q_CORE_EXPORT const QMetaTypeModuleHelper *qMetaTypeWidgetsHelper = nullptr;
@@ -1534,44 +2033,39 @@ static const QMetaTypeModuleHelper *qModuleHelperForType(int type)
 template<typename T, typename Key>
 class QMetaTypeFunctionRegistry
 {
+    using Map = QMetaTypeLockFreeHash<Key, T>;
 public:
-    ~QMetaTypeFunctionRegistry()
-    {
-        const QWriteLocker locker(&lock);
-        map.clear();
-    }
-
     bool contains(Key k) const
     {
-        const QReadLocker locker(&lock);
-        return map.contains(k);
+        const typename Map::ReadGuard guard(map);
+        return map.find(k) != nullptr;
     }
 
     bool insertIfNotContains(Key k, const T &f)
     {
-        const QWriteLocker locker(&lock);
-        if (map.contains(k))
+        const QMutexLocker locker(&map.mutex);
+        if (map.find(k))
             return false;
         map.insert(k, f);
         return true;
     }
 
-    const T *function(Key k) const
+    // returns a copy, as the function may be removed while it is called
+    T function(Key k) const
     {
-        const QReadLocker locker(&lock);
-        auto it = map.find(k);
-        return it == map.end() ? nullptr : std::addressof(*it);
+        const typename Map::ReadGuard guard(map);
+        const auto node = map.find(k);
+        return node ? node->value : T();
     }
 
     void remove(int from, int to)
     {
         const Key k(from, to);
-        const QWriteLocker locker(&lock);
-        map.remove(k);
+        const QMutexLocker locker(&map.mutex);
+        map.removeIf([&k](const Key &key, const T &) { return key == k; });
     }
 private:
-    mutable QReadWriteLock lock;
-    QHash<Key, T> map;
+    Map map;
 };
 
 typedef QMetaTypeFunctionRegistry<QMetaType::ConverterFunction,QPair<int,int> >
@@ -1831,14 +2325,14 @@ static bool convertToEnum(QMetaType fromType, const void *from, QMetaType toType
 
 static bool convertIterableToVariantList(QMetaType fromType, const void *from, void *to)
 {
-    const QMetaType::ConverterFunction * const f =
+    const auto f =
         customTypesConversionRegistry()->function(qMakePair(fromType.id(),
                                                             qMetaTypeId<QSequentialIterable>()));
     if (!f)
         return false;
 
     QSequentialIterable list;
-    (*f)(from, &list);
+    f(from, &list);
     QVariantList &l = *static_cast<QVariantList *>(to);
     l.clear();
     l.reserve(list.size());
@@ -1850,14 +2344,14 @@ static bool convertIterableToVariantList(QMetaType fromType, const void *from, v
 
 static bool convertIterableToVariantMap(QMetaType fromType, const void *from, void *to)
 {
-    const QMetaType::ConverterFunction * const f =
+    const auto f =
         customTypesConversionRegistry()->function(qMakePair(fromType.id(),
                                                             qMetaTypeId<QtMetaTypePrivate::QAssociativeIterableImpl>()));
     if (!f)
         return false;
 
     QtMetaTypePrivate::QAssociativeIterableImpl iter;
-    (*f)(from, &iter);
+    f(from, &iter);
     QAssociativeIterable map(iter);
     QVariantMap &h = *static_cast<QVariantMap *>(to);
     h.clear();
@@ -1869,14 +2363,14 @@ static bool convertIterableToVariantMap(QMetaType fromType, const void *from, vo
 
 static bool convertIterableToVariantHash(QMetaType fromType, const void *from, void *to)
 {
-    const QMetaType::ConverterFunction * const f =
+    const auto f =
         customTypesConversionRegistry()->function(qMakePair(fromType.id(),
                                                             qMetaTypeId<QtMetaTypePrivate::QAssociativeIterableImpl>()));
     if (!f)
         return false;
 
     QtMetaTypePrivate::QAssociativeIterableImpl iter;
-    (*f)(from, &iter);
+    f(from, &iter);
     QAssociativeIterable map(iter);
     QVariantHash &h = *static_cast<QVariantHash *>(to);
     h.clear();
@@ -1889,14 +2383,14 @@ static bool convertIterableToVariantHash(QMetaType fromType, const void *from, v
 
 static bool convertIterableToVariantPair(QMetaType fromType, const void *from, void *to)
 {
-    const QMetaType::ConverterFunction * const f =
+    const auto f =
         customTypesConversionRegistry()->function(qMakePair(fromType.id(),
                                                             qMetaTypeId<QtMetaTypePrivate::QPairVariantInterfaceImpl>()));
     if (!f)
         return false;
 
     QtMetaTypePrivate::QPairVariantInterfaceImpl pi;
-    (*f)(from, &pi);
+    f(from, &pi);
 
     QVariant v1(pi._metaType_first);
     void *dataPtr;
@@ -2001,14 +2495,18 @@ bool QMetaType::convert(QMetaType fromType, const void *from, QMetaType toType,
     int fromTypeId = fromType.id();
     int toTypeId = toType.id();
 
+    if (auto convert = QtPrivate::builtinConverter(fromTypeId, toTypeId)) {
+        if (convert(from, to))
+            return true;
+    }
     if (auto moduleHelper = qModuleHelperForType(qMax(fromTypeId, toTypeId))) {
         if (moduleHelper->convert(from, fromTypeId, to, toTypeId))
             return true;
     }
-    const QMetaType::ConverterFunction * const f =
+    const auto f =
         customTypesConversionRegistry()->function(qMakePair(fromTypeId, toTypeId));
     if (f)
-        return (*f)(from, to);
+        return f(from, to);
 
     if (fromType.flags() & QMetaType::IsEnumeration)
         return convertFromEnum(fromType, from, toType, to);
@@ -2144,11 +2642,13 @@ bool QMetaType::canConvert(QMetaType fromType, QMetaType toType)
     if (fromTypeId == toTypeId)
         return true;
 
+    if (QtPrivate::builtinConverter(fromTypeId, toTypeId))
+        return true;
     if (auto moduleHelper = qModuleHelperForType(qMax(fromTypeId, toTypeId))) {
         if (moduleHelper->convert(nullptr, fromTypeId, nullptr, toTypeId))
             return true;
     }
-    const ConverterFunction * const f =
+    const auto f =
         customTypesConversionRegistry()->function(qMakePair(fromTypeId, toTypeId));
     if (f)
         return true;
@@ -2251,18 +2751,13 @@ static inline int qMetaTypeStaticType(const char *typeName, int length)
 
 /*
     Similar to QMetaType::type(), but only looks in the custom set of
-    types, and doesn't lock the mutex.
-
+    types. The registry is read without locking.
 */
-static int qMetaTypeCustomType_unlocked(const char *typeName, int length)
+static int qMetaTypeCustomType(const char *typeName, int length)
 {
     if (auto reg = customTypeRegistry()) {
-#if QT_CONFIG(thread)
-        Q_ASSERT(!reg->lock.tryLockForWrite());
-#endif
-        if (auto ti = reg->aliases.value(QByteArray(typeName, length), nullptr)) {
+        if (auto ti = reg->findAlias(QByteArray::fromRawData(typeName, length)))
             return ti->typeId;
-        }
     }
     return QMetaType::UnknownType;
 }
@@ -2279,13 +2774,8 @@ void QMetaType::registerNormalizedTypedef(const NS(QByteArray) & normalizedTypeN
 {
     if (!metaType.isValid())
         return;
-    if (auto reg = customTypeRegistry()) {
-        QWriteLocker lock(&reg->lock);
-        auto &al = reg->aliases[normalizedTypeName];
-        if (al)
-            return;
-        al = metaType.d_ptr;
-    }
+    if (auto reg = customTypeRegistry())
+        reg->registerAlias(normalizedTypeName, metaType.d_ptr);
 }
 
 /*!
@@ -2306,16 +2796,15 @@ static inline int qMetaTypeTypeImpl(const char *typeName, int length)
         return QMetaType::UnknownType;
     int type = qMetaTypeStaticType(typeName, length);
     if (type == QMetaType::UnknownType) {
-        QReadLocker locker(&customTypeRegistry()->lock);
-        type = qMetaTypeCustomType_unlocked(typeName, length);
+        type = qMetaTypeCustomType(typeName, length);
 #ifndef QT_NO_QOBJECT
         if ((type == QMetaType::UnknownType) && tryNormalizedType) {
             const NS(QByteArray) normalizedTypeName = QMetaObject::normalizedType(typeName);
             type = qMetaTypeStaticType(normalizedTypeName.constData(),
                                        normalizedTypeName.size());
             if (type == QMetaType::UnknownType) {
-                type = qMetaTypeCustomType_unlocked(normalizedTypeName.constData(),
-                                                    normalizedTypeName.size());
+                type = qMetaTypeCustomType(normalizedTypeName.constData(),
+                                           normalizedTypeName.size());
             }
         }
 #endif
@@ -1187,6 +1187,9 @@ namespace QtPrivate
     };
 
     Q_CORE_EXPORT bool isBuiltinType(const QByteArray &type);
+
+    using BuiltinConverterFunction = bool (*)(const void *from, void *to);
+    Q_CORE_EXPORT BuiltinConverterFunction builtinConverter(int fromTypeId, int toTypeId) noexcept;
 } // namespace QtPrivate
 
 template <typename T, int =
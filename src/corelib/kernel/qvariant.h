@@ -645,6 +645,12 @@ template<typename T> inline T qvariant_cast(const QVariant &v)
         return v.d.get<T>();
 
     T t{};
+    if constexpr (bool(QMetaTypeId2<T>::IsBuiltIn)) {
+        // conversions between builtin types skip the checks of QMetaType::convert()
+        const auto convert = QtPrivate::builtinConverter(v.d.typeId(), QMetaTypeId2<T>::MetaType);
+        if (convert && convert(v.constData(), &t))
+            return t;
+    }
     QMetaType::convert(v.metaType(), v.constData(), targetType, &t);
     return t;
 }
@@ -67,9 +67,11 @@ if ($fname eq "--zstd") {
 
 # Check if xml (from xmlstarlet) is in $PATH
 my $cmd;
+my $minify;
 if (checkCommand("xmlstarlet")) {
     # Minify the data before compressing
-    $cmd = "xmlstarlet sel -D -B -t -c / $fname";
+    $minify = "xmlstarlet sel -D -B -t -c / $fname";
+    $cmd = $minify;
     $cmd .= "| $compress" if $compress;
 } elsif ($compress) {
     $cmd = "$compress < $fname"
@@ -100,14 +102,294 @@ if (!$compress && $zlib) {
     };
 }
 
+# The index lets the bundled database be used without parsing the XML. All
+# integers are 32-bit little endian, all offsets are relative to the start of
+# the index and all strings are UTF-8, null-terminated and stored once.
+#
+# Header:
+#   "QMDX", version, total size, then the offsets of the tables below
+# Type list (sorted by name):
+#   count, { name, parent list offset, icon, generic icon, pattern list offset,
+#            element offset, element size }...
+#   where a parent list is: count, name...
+#   and a pattern list holds the glob patterns as written: count, pattern...
+#   The element is the <mime-type> element in the uncompressed XML data, so
+#   that the comments can be read without parsing the whole file.
+# Alias list (sorted by alias):
+#   count, { alias, name }...
+# Glob list (in the order of the XML file):
+#   count, { pattern, name, weight | case-sensitive << 8 | suffix length << 16, order }...
+#   where order sorts the globs like QMimeAllGlobPatterns tries them
+# Literal and other glob lists:
+#   count, glob index...
+# Case-insensitive and case-sensitive suffix trees, for the "*foo" patterns:
+#   child count, children offset
+#   where children are sorted by character: { character, child count,
+#   children offset, glob list offset (count, glob index...) or 0 }...
+# Magic list (in the order of the XML file):
+#   count, { name, priority, rule count, rules offset }...
+#   where rules are: { type, value, offset, mask, sub-rule count, sub-rules offset }...
+
+sub decodeEntity($) {
+    my $entity = $_[0];
+    return '<' if $entity eq 'lt';
+    return '>' if $entity eq 'gt';
+    return '&' if $entity eq 'amp';
+    return '"' if $entity eq 'quot';
+    return "'" if $entity eq 'apos';
+    my $c = chr($entity =~ /^#x(.*)/ ? hex $1 : substr($entity, 1));
+    utf8::encode($c);
+    return $c;
+}
+
+sub parseAttributes($) {
+    my %attributes;
+    while ($_[0] =~ /([^\s=]+)\s*=\s*(?:"([^"]*)"|'([^']*)')/g) {
+        my ($name, $value) = ($1, defined $2 ? $2 : $3);
+        $value =~ s/[\t\r\n]/ /g;
+        $value =~ s/&(lt|gt|amp|quot|apos|#[0-9]+|#x[0-9A-Fa-f]+);/decodeEntity($1)/ge;
+        $attributes{$name} = $value;
+    }
+    return %attributes;
+}
+
+sub parseInteger($) {
+    my $n = $_[0];
+    return ($n =~ /^\s*([+-]?\d+)\s*$/) ? $1 + 0 : undef;
+}
+
+sub buildIndex($) {
+    my $xml = $_[0];
+    # Blank out what is not markup, keeping the offsets of the elements
+    my $blank = sub { return " " x length $_[0]; };
+    $xml =~ s/(<!--.*?-->)/$blank->($1)/ges;
+    $xml =~ s/(<\?.*?\?>)/$blank->($1)/ges;
+    $xml =~ s/(<!DOCTYPE[^\[>]*(?:\[.*?\])?\s*>)/$blank->($1)/es;
+    $xml =~ s/(<!\[CDATA\[.*?\]\]>)/$blank->($1)/ges;
+
+    # Collect what QMimeTypeParser would report
+    my (%types, %aliases, @globs, @magic);
+    my ($type, $matcher, @rules);
+    while ($xml =~ /<(\/?)([A-Za-z_][\w.:-]*)((?:\s+[^\s=\/>]+\s*=\s*(?:"[^"]*"|'[^']*'))*)\s*(\/?)>/g) {
+        my ($isEnd, $tag, $attributes, $isEmpty) = ($1, $2, $3, $4);
+        my %a = parseAttributes($attributes);
+        if ($isEnd) {
+            if ($tag eq "mime-type" && defined $type) {
+                $types{$type}{elementSize} = $+[0] - $types{$type}{elementOffset};
+                undef $type;
+            } elsif ($tag eq "match") {
+                pop @rules;
+            } elsif ($tag eq "magic" && $matcher) {
+                push @magic, $matcher;
+                undef $matcher;
+            }
+            next;
+        }
+
+        if ($tag eq "mime-type") {
+            $type = $a{"type"};
+            die("Missing 'type'-attribute in $fname") unless $type;
+            # A repeated type replaces the earlier one, but keeps its parents
+            my $parents = $types{$type} ? $types{$type}{parents} : [];
+            $types{$type} = { parents => $parents, icon => "", genericIcon => "", patterns => [],
+                              elementOffset => $-[0], elementSize => $+[0] - $-[0] };
+            undef $type if $isEmpty;
+        } elsif (!defined $type) {
+            next;
+        } elsif ($tag eq "glob") {
+            my $weight = parseInteger($a{"weight"} // "") || 50;
+            my $caseSensitive = ($a{"case-sensitive"} // "") eq "true";
+            push @globs, { pattern => $a{"pattern"} // "", name => $type,
+                           weight => $weight, caseSensitive => $caseSensitive };
+            push @{$types{$type}{patterns}}, $a{"pattern"} // "";
+        } elsif ($tag eq "sub-class-of") {
+            push @{$types{$type}{parents}}, $a{"type"} if $a{"type"};
+        } elsif ($tag eq "alias") {
+            $aliases{$a{"type"}} = $type if $a{"type"};
+        } elsif ($tag eq "icon") {
+            $types{$type}{icon} = $a{"name"} // "";
+        } elsif ($tag eq "generic-icon") {
+            $types{$type}{genericIcon} = $a{"name"} // "";
+        } elsif ($tag eq "magic") {
+            my $priority = 50;
+            if (($a{"priority"} // "") ne "") {
+                $priority = parseInteger($a{"priority"});
+                die("Not a number '$a{priority}' in $fname") unless defined $priority;
+            }
+            $matcher = { name => $type, priority => $priority, rules => [] };
+            @rules = ();
+        } elsif ($tag eq "match" && $matcher) {
+            my $rule = { type => $a{"type"} // "", value => $a{"value"} // "",
+                         offset => $a{"offset"} // "", mask => $a{"mask"} // "",
+                         rules => [] };
+            push @{@rules ? $rules[-1]{rules} : $matcher->{rules}}, $rule;
+            push @rules, $rule unless $isEmpty;
+        }
+    }
+
+    # Sort the globs into the lists QMimeAllGlobPatterns::addGlob would use
+    my (@literals, @others);
+    my %trees = (0 => { children => {}, globs => [] }, 1 => { children => {}, globs => [] });
+    for my $i (0 .. $#globs) {
+        my $glob = $globs[$i];
+        my $pattern = $glob->{pattern};
+        $pattern = lc $pattern unless $glob->{caseSensitive};
+        $glob->{pattern} = $pattern;
+        my $stars = () = $pattern =~ /\*/g;
+        $glob->{suffixLength} = 0;
+        $glob->{suffixLength} = length($pattern) - 2
+            if $pattern =~ /^\*\.[^*?\[]*$/;
+        my $isFast = $glob->{weight} == 50 && !$glob->{caseSensitive}
+            && $pattern =~ /^\*\.[^*?\[.]*$/;
+        $glob->{order} = (($isFast ? 1 : $glob->{weight} > 50 ? 0 : 2) << 24) | $i;
+
+        if ($pattern eq "" || $pattern =~ /[^\x00-\x7f]/) {
+            # Non-ASCII patterns need Unicode case folding
+            push @others, $i if $pattern ne "";
+        } elsif ($pattern =~ /^\*[^\[*]+$/) {
+            # Patterns like "*.txt" and "*~", compared character by character
+            my $node = $trees{$glob->{caseSensitive} ? 1 : 0};
+            for my $c (reverse split //, substr($pattern, 1)) {
+                $node = $node->{children}{ord $c} //= { children => {}, globs => [] };
+            }
+            push @{$node->{globs}}, $i;
+        } elsif ($stars == 0 && $pattern !~ /\[/ && index($pattern, "?") != 0) {
+            push @literals, $i;
+        } else {
+            push @others, $i;
+        }
+    }
+
+    # Lay out the strings first, right after the header
+    my $headerSize = 44;
+    my %strings;
+    my $blob = "\0" x $headerSize;
+    my $string = sub {
+        my $s = $_[0];
+        return 0 if $s eq "";
+        unless (defined $strings{$s}) {
+            $strings{$s} = length $blob;
+            $blob .= $s . "\0";
+        }
+        return $strings{$s};
+    };
+    my $addRuleStrings;
+    $addRuleStrings = sub {
+        for my $rule (@{$_[0]}) {
+            $string->($rule->{$_}) for qw(type value offset mask);
+            $addRuleStrings->($rule->{rules});
+        }
+    };
+    for my $name (sort keys %types) {
+        $string->($name);
+        $string->($types{$name}{$_}) for qw(icon genericIcon);
+        $string->($_) for @{$types{$name}{parents}}, @{$types{$name}{patterns}};
+    }
+    $string->($_) for sort keys %aliases;
+    $string->($_->{pattern}) for @globs;
+    $addRuleStrings->($_->{rules}) for @magic;
+    $blob .= "\0" x (-length($blob) & 3);
+
+    my $emit = sub {
+        my $offset = length $blob;
+        $blob .= pack("V*", @_);
+        return $offset;
+    };
+
+    my @typeEntries;
+    for my $name (sort keys %types) {
+        my @parents = @{$types{$name}{parents}};
+        my $parentList = @parents ? $emit->(scalar @parents, map { $string->($_) } @parents) : 0;
+        my @patterns = @{$types{$name}{patterns}};
+        my $patternList = @patterns ? $emit->(scalar @patterns, map { $string->($_) } @patterns) : 0;
+        push @typeEntries, $string->($name), $parentList,
+            $string->($types{$name}{icon}), $string->($types{$name}{genericIcon}), $patternList,
+            $types{$name}{elementOffset}, $types{$name}{elementSize};
+    }
+    my $typeList = $emit->(scalar keys %types, @typeEntries);
+    my $aliasList = $emit->(scalar keys %aliases,
+                            map { ($string->($_), $string->($aliases{$_})) } sort keys %aliases);
+    my $globList = $emit->(scalar @globs, map {
+        ($string->($_->{pattern}), $string->($_->{name}),
+         $_->{weight} & 0xff | ($_->{caseSensitive} ? 1 << 8 : 0) | $_->{suffixLength} << 16,
+         $_->{order})
+    } @globs);
+    my $literalList = $emit->(scalar @literals, @literals);
+    my $otherList = $emit->(scalar @others, @others);
+
+    my $emitTree;
+    $emitTree = sub {
+        my $node = $_[0];
+        my @children;
+        for my $c (sort { $a <=> $b } keys %{$node->{children}}) {
+            my $child = $node->{children}{$c};
+            my @tree = $emitTree->($child);
+            my @childGlobs = @{$child->{globs}};
+            my $childGlobList = @childGlobs ? $emit->(scalar @childGlobs, @childGlobs) : 0;
+            push @children, $c, @tree, $childGlobList;
+        }
+        return (0, 0) unless @children;
+        return (scalar @children / 4, $emit->(@children));
+    };
+    my $caseInsensitiveTree = $emit->($emitTree->($trees{0}));
+    my $caseSensitiveTree = $emit->($emitTree->($trees{1}));
+
+    my $emitRules;
+    $emitRules = sub {
+        my @entries;
+        for my $rule (@{$_[0]}) {
+            my $subRules = $emitRules->($rule->{rules});
+            push @entries, (map { $string->($rule->{$_}) } qw(type value offset mask)),
+                scalar @{$rule->{rules}}, $subRules;
+        }
+        return @entries ? $emit->(@entries) : 0;
+    };
+    my @magicEntries;
+    for my $m (@magic) {
+        my $rules = $emitRules->($m->{rules});
+        push @magicEntries, $string->($m->{name}), $m->{priority} & 0xffffffff,
+            scalar @{$m->{rules}}, $rules;
+    }
+    my $magicList = $emit->(scalar @magic, @magicEntries);
+
+    substr($blob, 0, $headerSize) = pack("a4V*", "QMDX", 2, length $blob,
+        $typeList, $aliasList, $globList, $literalList, $otherList,
+        $caseInsensitiveTree, $caseSensitiveTree, $magicList);
+    return $blob;
+}
+
+# Build the binary index read by QMimeIndexProvider, from the same XML data
+# that is embedded
+my $xml;
+if ($minify) {
+    open CMD, "$minify |";
+    binmode CMD;
+    $xml = <CMD>;
+    close CMD;
+    die("Failed to run $minify") if ($? >> 8);
+} else {
+    open F, "<$fname";
+    binmode F;
+    $xml = <F>;
+    close F;
+}
+my $index = buildIndex($xml);
+
 # Now print as hex
+sub printArray($$) {
+    my ($declaration, $bytes) = @_;
+    printf "%s = {", $declaration;
+    my $i = 0;
+    map {
+        printf "\n  " if $i++ % 12 == 0;
+        printf "0x%02x, ", ord $_
+    } split //, $bytes;
+    printf "\n};\n";
+}
+
 printf "#define %s\n", $macro if $macro;
-printf "static const unsigned char mimetype_database[] = {";
-my $i = 0;
-map {
-    printf "\n  " if $i++ % 12 == 0;
-    printf "0x%02x, ", ord $_
-} split //, $data;
-printf "\n};\n";
+printf "#define MIME_DATABASE_HAS_INDEX\n";
+printArray("static const unsigned char mimetype_database[]", $data);
 printf "static constexpr size_t MimeTypeDatabaseOriginalSize = %d;\n",
     (stat $fname)[7];
+printArray("alignas(16) static const unsigned char mimetype_database_index[]", $index);
@@ -108,7 +108,21 @@ void QMimeDatabasePrivate::loadProviders()
 
     if (QMimeXMLProvider::InternalDatabaseAvailable && fdoIterator == mimeDirs.constEnd()) {
         m_providers.reserve(mimeDirs.size() + 1);
-        m_providers.push_back(Providers::value_type(new QMimeXMLProvider(this, QMimeXMLProvider::InternalDatabase)));
+        // The internal database never changes, so keep its provider
+        const auto it = std::find_if(currentProviders.begin(), currentProviders.end(),
+                                     [](const std::unique_ptr<QMimeProviderBase> &prov) {
+            return prov && prov->isInternalDatabase();
+        });
+        std::unique_ptr<QMimeProviderBase> provider;
+        if (it != currentProviders.end()) {
+            provider = std::move(*it);
+        } else {
+            // Prefer the index generated at build time over parsing the XML
+            provider.reset(new QMimeIndexProvider(this));
+            if (!provider->isValid())
+                provider.reset(new QMimeXMLProvider(this, QMimeXMLProvider::InternalDatabase));
+        }
+        m_providers.push_back(std::move(provider));
     } else {
         m_providers.reserve(mimeDirs.size());
     }
@@ -216,9 +230,13 @@ void QMimeDatabasePrivate::loadMimeTypePrivate(QMimeTypePrivate &mimePrivate)
     QMutexLocker locker(&mutex);
     if (mimePrivate.name.isEmpty())
         return; // invalid mimetype
-    if (!mimePrivate.loaded) { // XML provider sets loaded=true, binary provider does this on demand
+    if (!mimePrivate.loaded) { // XML provider sets loaded=true, binary and index providers do this on demand
         Q_ASSERT(mimePrivate.fromCache);
-        QMimeBinaryProvider::loadMimeTypePrivate(mimePrivate);
+        for (const auto &provider : providers()) {
+            provider->loadMimeTypePrivate(mimePrivate);
+            if (mimePrivate.loaded)
+                break;
+        }
     }
 }
 
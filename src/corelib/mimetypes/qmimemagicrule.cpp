@@ -337,6 +337,50 @@ QByteArray QMimeMagicRule::mask() const
     return result;
 }
 
+template <typename T>
+static inline void storeNumber(uchar *dest, quint32 number)
+{
+    qToUnaligned<T>(T(number), dest);
+}
+
+// If this rule only compares data at startPos(), stores the first (up to four)
+// bytes it compares, pre-masked, and their mask, so that the value can be
+// checked against a word loaded from the data in host byte order.
+// Used by the prefilter of QMimeMagicRuleMatcherSet.
+bool QMimeMagicRule::fixedPrefix(quint32 *value, quint32 *mask) const
+{
+    if (!m_matchFunction || m_startPos != m_endPos || m_startPos < 0)
+        return false;
+
+    uchar valueBytes[4] = {};
+    uchar maskBytes[4] = {};
+    switch (m_type) {
+    case String:
+        for (int i = 0; i < qMin(4, m_pattern.size()); ++i) {
+            maskBytes[i] = uchar(m_mask.at(i));
+            valueBytes[i] = uchar(m_pattern.at(i)) & maskBytes[i];
+        }
+        break;
+    case Byte:
+        storeNumber<quint8>(valueBytes, m_number & m_numberMask);
+        storeNumber<quint8>(maskBytes, m_numberMask);
+        break;
+    case Host16:
+    case Big16:
+    case Little16:
+        storeNumber<quint16>(valueBytes, m_number & m_numberMask);
+        storeNumber<quint16>(maskBytes, m_numberMask);
+        break;
+    default:
+        storeNumber<quint32>(valueBytes, m_number & m_numberMask);
+        storeNumber<quint32>(maskBytes, m_numberMask);
+        break;
+    }
+    memcpy(value, valueBytes, sizeof(valueBytes));
+    memcpy(mask, maskBytes, sizeof(maskBytes));
+    return true;
+}
+
 bool QMimeMagicRule::matches(const QByteArray &data) const
 {
     const bool ok = m_matchFunction && (this->*m_matchFunction)(data);
@@ -61,7 +61,7 @@ QT_REQUIRE_CONFIG(mimetype);
 
 QT_BEGIN_NAMESPACE
 
-class QMimeMagicRule
+class Q_AUTOTEST_EXPORT QMimeMagicRule
 {
 public:
     enum Type { Invalid = 0, String, Host16, Host32, Big16, Big32, Little16, Little32, Byte };
@@ -93,6 +93,7 @@ public:
     bool isValid() const { return m_matchFunction != nullptr; }
 
     bool matches(const QByteArray &data) const;
+    bool fixedPrefix(quint32 *value, quint32 *mask) const;
 
     QList<QMimeMagicRule> m_subMatches;
 
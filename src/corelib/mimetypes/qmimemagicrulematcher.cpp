@@ -43,6 +43,10 @@
 
 #include "qmimetype_p.h"
 
+#include <QtCore/qmap.h>
+#include <QtCore/qvarlengtharray.h>
+#include <private/qsimd_p.h>
+
 QT_BEGIN_NAMESPACE
 
 /*!
@@ -103,4 +107,143 @@ unsigned QMimeMagicRuleMatcher::priority() const
     return m_priority;
 }
 
+/*!
+    \internal
+    \class QMimeMagicRuleMatcherSet
+    \inmodule QtCore
+
+    \brief The QMimeMagicRuleMatcherSet class finds the best matching one of
+    a list of QMimeMagicRuleMatcher.
+
+    Most rules compare a few bytes at a fixed offset. Their first four bytes
+    are collected into one table per offset, which is compared against the
+    data four rules at a time, so that only the matchers having a rule that
+    can match at all are evaluated.
+*/
+
+void QMimeMagicRuleMatcherSet::append(const QMimeMagicRuleMatcher &matcher)
+{
+    m_matchers.append(matcher);
+    m_prefilterValid = false;
+}
+
+void QMimeMagicRuleMatcherSet::clear()
+{
+    m_matchers.clear();
+    m_groups.clear();
+    m_values.clear();
+    m_masks.clear();
+    m_matcherIndexes.clear();
+    m_alwaysChecked.clear();
+    m_prefilterValid = false;
+}
+
+void QMimeMagicRuleMatcherSet::buildPrefilter()
+{
+    struct Entry {
+        quint32 value;
+        quint32 mask;
+        int matcherIndex;
+    };
+    QMap<int, QList<Entry>> entriesByOffset;
+
+    m_alwaysChecked.fill(0, (m_matchers.size() + 63) / 64);
+    for (int i = 0; i < m_matchers.size(); ++i) {
+        for (const QMimeMagicRule &rule : m_matchers.at(i).magicRules()) {
+            if (!rule.isValid())
+                continue; // never matches
+            Entry entry = { 0, 0, i };
+            if (rule.fixedPrefix(&entry.value, &entry.mask))
+                entriesByOffset[rule.startPos()].append(entry);
+            else
+                m_alwaysChecked[i / 64] |= Q_UINT64_C(1) << (i % 64);
+        }
+    }
+
+    m_groups.clear();
+    m_values.clear();
+    m_masks.clear();
+    m_matcherIndexes.clear();
+    for (auto it = entriesByOffset.cbegin(), end = entriesByOffset.cend(); it != end; ++it) {
+        const PrefilterGroup group = { it.key(), int(m_values.size()),
+                                       int(m_values.size() + ((it->size() + 3) & ~3)) };
+        for (const Entry &entry : *it) {
+            m_values.append(entry.value);
+            m_masks.append(entry.mask);
+            m_matcherIndexes.append(entry.matcherIndex);
+        }
+        // padding that never matches
+        while (m_values.size() < group.end) {
+            m_values.append(1);
+            m_masks.append(0);
+            m_matcherIndexes.append(0);
+        }
+        m_groups.append(group);
+    }
+    m_prefilterValid = true;
+}
+
+// Returns a bitmask of which of the four entries match \a word
+static inline uint prefilterMatches(const quint32 *values, const quint32 *masks, quint32 word)
+{
+#if defined(__SSE2__)
+    const __m128i data = _mm_set1_epi32(int(word));
+    const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(values));
+    const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i *>(masks));
+    const __m128i result = _mm_cmpeq_epi32(_mm_and_si128(data, mask), value);
+    return uint(_mm_movemask_ps(_mm_castsi128_ps(result)));
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64) // vaddv is only available on Aarch64
+    const uint32x4_t lanes = { 1, 1 << 1, 1 << 2, 1 << 3 };
+    const uint32x4_t data = vdupq_n_u32(word);
+    const uint32x4_t result = vceqq_u32(vandq_u32(data, vld1q_u32(masks)), vld1q_u32(values));
+    return vaddvq_u32(vandq_u32(result, lanes));
+#else
+    uint result = 0;
+    for (int i = 0; i < 4; ++i) {
+        if ((word & masks[i]) == values[i])
+            result |= 1U << i;
+    }
+    return result;
+#endif
+}
+
+/*!
+    Returns the first matcher with the highest priority above \a minimumPriority
+    that matches \a data, or \nullptr if there is none.
+*/
+const QMimeMagicRuleMatcher *QMimeMagicRuleMatcherSet::bestMatch(const QByteArray &data, unsigned minimumPriority)
+{
+    if (!m_prefilterValid)
+        buildPrefilter();
+
+    QVarLengthArray<quint64, 8> candidates(m_alwaysChecked.cbegin(), m_alwaysChecked.cend());
+    for (const PrefilterGroup &group : qAsConst(m_groups)) {
+        if (group.offset >= data.size())
+            break; // sorted by offset
+        quint32 word = 0;
+        memcpy(&word, data.constData() + group.offset, qMin(data.size() - group.offset, qsizetype(sizeof(word))));
+        for (int i = group.begin; i < group.end; i += 4) {
+            for (uint hits = prefilterMatches(m_values.constData() + i, m_masks.constData() + i, word);
+                 hits; hits &= hits - 1) {
+                const int index = m_matcherIndexes.at(i + qCountTrailingZeroBits(hits));
+                candidates[index / 64] |= Q_UINT64_C(1) << (index % 64);
+            }
+        }
+    }
+
+    // Evaluate the candidates in order, so that the first of equal priorities wins
+    const QMimeMagicRuleMatcher *best = nullptr;
+    unsigned bestPriority = minimumPriority;
+    for (qsizetype word = 0; word < candidates.size(); ++word) {
+        for (quint64 bits = candidates.at(word); bits; bits &= bits - 1) {
+            const QMimeMagicRuleMatcher &matcher = m_matchers.at(word * 64 + qCountTrailingZeroBits(bits));
+            if (matcher.priority() > bestPriority && matcher.matches(data)) {
+                best = &matcher;
+                bestPriority = matcher.priority();
+            }
+        }
+    }
+    return best;
+}
+
 QT_END_NAMESPACE
@@ -61,7 +61,7 @@ QT_REQUIRE_CONFIG(mimetype);
 
 QT_BEGIN_NAMESPACE
 
-class QMimeMagicRuleMatcher
+class Q_AUTOTEST_EXPORT QMimeMagicRuleMatcher
 {
 public:
     explicit QMimeMagicRuleMatcher(const QString &mime, unsigned priority = 65535);
@@ -92,6 +92,35 @@ private:
 };
 Q_DECLARE_SHARED(QMimeMagicRuleMatcher)
 
+class Q_AUTOTEST_EXPORT QMimeMagicRuleMatcherSet
+{
+public:
+    void append(const QMimeMagicRuleMatcher &matcher);
+    void clear();
+    bool isEmpty() const { return m_matchers.isEmpty(); }
+
+    const QMimeMagicRuleMatcher *bestMatch(const QByteArray &data, unsigned minimumPriority);
+
+private:
+    void buildPrefilter();
+
+    // The fixed-offset rules compared against the word at one offset,
+    // padded to a multiple of four entries
+    struct PrefilterGroup {
+        int offset;
+        int begin;
+        int end;
+    };
+
+    QList<QMimeMagicRuleMatcher> m_matchers;
+    QList<PrefilterGroup> m_groups;
+    QList<quint32> m_values;
+    QList<quint32> m_masks;
+    QList<int> m_matcherIndexes;
+    QList<quint64> m_alwaysChecked; // bitmap of matchers the prefilter can't rule out
+    bool m_prefilterValid = false;
+};
+
 QT_END_NAMESPACE
 
 #endif // QMIMEMAGICRULEMATCHER_P_H
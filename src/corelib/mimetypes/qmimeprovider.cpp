@@ -53,6 +53,9 @@
 #include <QDebug>
 #include <QDateTime>
 #include <QtEndian>
+#include <QVarLengthArray>
+
+#include <algorithm>
 
 #if QT_CONFIG(mimetype_database)
 #  if defined(Q_CC_MSVC)
@@ -89,6 +92,16 @@ QMimeProviderBase::QMimeProviderBase(QMimeDatabasePrivate *db, const QString &di
 {
 }
 
+static QString internalMimeFileName()
+{
+    return QStringLiteral("<internal MIME data>");
+}
+
+bool QMimeProviderBase::isInternalDatabase() const
+{
+    return m_directory == internalMimeFileName();
+}
+
 
 QMimeBinaryProvider::QMimeBinaryProvider(QMimeDatabasePrivate *db, const QString &directory)
     : QMimeProviderBase(db, directory), m_mimetypeListLoaded(false)
@@ -622,35 +635,30 @@ void QMimeBinaryProvider::loadGenericIcon(QMimeTypePrivate &data)
 ////
 
 #if QT_CONFIG(mimetype_database)
-static QString internalMimeFileName()
-{
-    return QStringLiteral("<internal MIME data>");
-}
-
-QMimeXMLProvider::QMimeXMLProvider(QMimeDatabasePrivate *db, InternalDatabaseEnum)
-    : QMimeProviderBase(db, internalMimeFileName())
+// Returns the XML data of the internal database, uncompressed
+static QByteArray internalMimeData()
 {
     static_assert(sizeof(mimetype_database), "Bundled MIME database is empty");
     static_assert(sizeof(mimetype_database) <= MimeTypeDatabaseOriginalSize,
                       "Compressed MIME database is larger than the original size");
     static_assert(MimeTypeDatabaseOriginalSize <= 16*1024*1024,
                       "Bundled MIME database is too big");
-    const char *data = reinterpret_cast<const char *>(mimetype_database);
-    qsizetype size = MimeTypeDatabaseOriginalSize;
 
 #ifdef MIME_DATABASE_IS_ZSTD
     // uncompress with libzstd
-    std::unique_ptr<char []> uncompressed(new char[size]);
-    size = ZSTD_decompress(uncompressed.get(), size, mimetype_database, sizeof(mimetype_database));
+    QByteArray uncompressed(MimeTypeDatabaseOriginalSize, Qt::Uninitialized);
+    const size_t size = ZSTD_decompress(uncompressed.data(), uncompressed.size(),
+                                        mimetype_database, sizeof(mimetype_database));
     Q_ASSERT(!ZSTD_isError(size));
-    data = uncompressed.get();
+    uncompressed.resize(qsizetype(size));
+    return uncompressed;
 #elif defined(MIME_DATABASE_IS_GZIP)
-    std::unique_ptr<char []> uncompressed(new char[size]);
+    QByteArray uncompressed(MimeTypeDatabaseOriginalSize, Qt::Uninitialized);
     z_stream zs = {};
     zs.next_in = const_cast<Bytef *>(mimetype_database);
     zs.avail_in = sizeof(mimetype_database);
-    zs.next_out = reinterpret_cast<Bytef *>(uncompressed.get());
-    zs.avail_out = size;
+    zs.next_out = reinterpret_cast<Bytef *>(uncompressed.data());
+    zs.avail_out = uncompressed.size();
 
     int res = inflateInit2(&zs, MAX_WBITS | 32);
     Q_ASSERT(res == Z_OK);
@@ -659,11 +667,19 @@ QMimeXMLProvider::QMimeXMLProvider(QMimeDatabasePrivate *db, InternalDatabaseEnu
     res = inflateEnd(&zs);
     Q_ASSERT(res == Z_OK);
 
-    data = uncompressed.get();
-    size = zs.total_out;
+    uncompressed.resize(qsizetype(zs.total_out));
+    return uncompressed;
+#else
+    return QByteArray::fromRawData(reinterpret_cast<const char *>(mimetype_database),
+                                   sizeof(mimetype_database));
 #endif
+}
 
-    load(data, size);
+QMimeXMLProvider::QMimeXMLProvider(QMimeDatabasePrivate *db, InternalDatabaseEnum)
+    : QMimeProviderBase(db, internalMimeFileName())
+{
+    const QByteArray data = internalMimeData();
+    load(data.constData(), data.size());
 }
 #else // !QT_CONFIG(mimetype_database)
 // never called in release mode, but some debug builds may need
@@ -704,20 +720,10 @@ void QMimeXMLProvider::addFileNameMatches(const QString &fileName, QMimeGlobMatc
 
 void QMimeXMLProvider::findByMagic(const QByteArray &data, int *accuracyPtr, QMimeType &candidate)
 {
-    QString candidateName;
-    bool foundOne = false;
-    for (const QMimeMagicRuleMatcher &matcher : qAsConst(m_magicMatchers)) {
-        if (matcher.matches(data)) {
-            const int priority = matcher.priority();
-            if (priority > *accuracyPtr) {
-                *accuracyPtr = priority;
-                candidateName = matcher.mimetype();
-                foundOne = true;
-            }
-        }
+    if (const QMimeMagicRuleMatcher *matcher = m_magicMatchers.bestMatch(data, *accuracyPtr)) {
+        *accuracyPtr = matcher->priority();
+        candidate = mimeTypeForName(matcher->mimetype());
     }
-    if (foundOne)
-        candidate = mimeTypeForName(candidateName);
 }
 
 void QMimeXMLProvider::ensureLoaded()
@@ -847,4 +853,360 @@ void QMimeXMLProvider::addMagicMatcher(const QMimeMagicRuleMatcher &matcher)
     m_magicMatchers.append(matcher);
 }
 
+////
+
+enum {
+    // The index of the internal database, written by mime/generate.pl
+    IndexPosSize = 8,
+    IndexPosTypeListOffset = 12,
+    IndexPosAliasListOffset = 16,
+    IndexPosGlobListOffset = 20,
+    IndexPosLiteralGlobListOffset = 24,
+    IndexPosOtherGlobListOffset = 28,
+    IndexPosCaseInsensitiveSuffixTreeOffset = 32,
+    IndexPosCaseSensitiveSuffixTreeOffset = 36,
+    IndexPosMagicListOffset = 40,
+    IndexHeaderSize = 44,
+    IndexVersion = 2,
+
+    IndexTypeEntrySize = 28,
+    IndexAliasEntrySize = 8,
+    IndexGlobEntrySize = 16,
+    IndexSuffixTreeNodeSize = 16,
+    IndexMagicEntrySize = 16,
+    IndexMagicRuleSize = 24
+};
+
+static inline quint32 indexUint32(const uchar *data, quint32 offset)
+{
+    return qFromLittleEndian<quint32>(data + offset);
+}
+
+static inline const char *indexCharStar(const uchar *data, quint32 offset)
+{
+    return offset ? reinterpret_cast<const char *>(data + offset) : "";
+}
+
+static inline QLatin1String indexLatin1(const uchar *data, quint32 offset)
+{
+    return QLatin1String(indexCharStar(data, offset));
+}
+
+// Returns the offset of the type list entry for \a name, or 0
+static quint32 indexTypeEntry(const uchar *data, const QString &name)
+{
+    if (!data)
+        return 0;
+    const QByteArray inputMime = name.toLatin1();
+    const quint32 listOffset = indexUint32(data, IndexPosTypeListOffset);
+    int begin = 0;
+    int end = indexUint32(data, listOffset) - 1;
+    while (begin <= end) {
+        const int medium = (begin + end) / 2;
+        const quint32 off = listOffset + 4 + IndexTypeEntrySize * medium;
+        const int cmp = qstrcmp(indexCharStar(data, indexUint32(data, off)), inputMime);
+        if (cmp < 0)
+            begin = medium + 1;
+        else if (cmp > 0)
+            end = medium - 1;
+        else
+            return off;
+    }
+    return 0;
+}
+
+using IndexGlobList = QVarLengthArray<quint32, 16>;
+
+// Collects the globs of the "*foo" patterns that match the end of \a fileName
+static void matchIndexSuffixTree(const uchar *data, quint32 treeOffset, const QString &fileName,
+                                 IndexGlobList &globs)
+{
+    quint32 numChildren = indexUint32(data, treeOffset);
+    quint32 childrenOffset = indexUint32(data, treeOffset + 4);
+    for (qsizetype charPos = fileName.size() - 1; charPos >= 0 && numChildren; --charPos) {
+        const quint32 fileChar = fileName.at(charPos).unicode();
+        quint32 node = 0;
+        quint32 begin = 0;
+        quint32 end = numChildren;
+        while (begin < end) {
+            const quint32 medium = (begin + end) / 2;
+            const quint32 off = childrenOffset + IndexSuffixTreeNodeSize * medium;
+            const quint32 ch = indexUint32(data, off);
+            if (ch < fileChar) {
+                begin = medium + 1;
+            } else if (ch > fileChar) {
+                end = medium;
+            } else {
+                node = off;
+                break;
+            }
+        }
+        if (!node)
+            return;
+        if (const quint32 globListOffset = indexUint32(data, node + 12)) {
+            const quint32 numGlobs = indexUint32(data, globListOffset);
+            for (quint32 i = 0; i < numGlobs; ++i)
+                globs.append(indexUint32(data, globListOffset + 4 + 4 * i));
+        }
+        numChildren = indexUint32(data, node + 4);
+        childrenOffset = indexUint32(data, node + 8);
+    }
+}
+
+static QMimeMagicRule indexMagicRule(const uchar *data, quint32 off)
+{
+    const auto rawData = [data](quint32 offset) {
+        const char *s = indexCharStar(data, offset);
+        return QByteArray::fromRawData(s, qstrlen(s));
+    };
+    QString errorString;
+    QMimeMagicRule rule(indexLatin1(data, indexUint32(data, off)),
+                        rawData(indexUint32(data, off + 4)),
+                        indexLatin1(data, indexUint32(data, off + 8)),
+                        rawData(indexUint32(data, off + 12)),
+                        &errorString);
+    if (Q_UNLIKELY(!rule.isValid()))
+        qWarning("QMimeDatabase: Error parsing %ls\n%ls",
+                 qUtf16Printable(internalMimeFileName()), qUtf16Printable(errorString));
+    const quint32 numSubRules = indexUint32(data, off + 16);
+    const quint32 subRulesOffset = indexUint32(data, off + 20);
+    for (quint32 i = 0; i < numSubRules; ++i)
+        rule.m_subMatches.append(indexMagicRule(data, subRulesOffset + IndexMagicRuleSize * i));
+    return rule;
+}
+
+QMimeIndexProvider::QMimeIndexProvider(QMimeDatabasePrivate *db)
+    : QMimeProviderBase(db, internalMimeFileName())
+{
+#if QT_CONFIG(mimetype_database) && defined(MIME_DATABASE_HAS_INDEX)
+    static_assert(sizeof(mimetype_database_index) >= IndexHeaderSize, "Bundled MIME index is empty");
+    const uchar *data = mimetype_database_index;
+    if (memcmp(data, "QMDX", 4) != 0 || indexUint32(data, 4) != IndexVersion
+            || indexUint32(data, IndexPosSize) != sizeof(mimetype_database_index)) {
+        qWarning("QMimeDatabase: The internal MIME index is not compatible, parsing the internal MIME data instead");
+        return;
+    }
+    m_data = data;
+
+    // The globs that need a regular expression, like "*.anim[1-9j]"
+    const quint32 globListOffset = indexUint32(m_data, IndexPosGlobListOffset);
+    const quint32 otherListOffset = indexUint32(m_data, IndexPosOtherGlobListOffset);
+    const quint32 numOtherGlobs = indexUint32(m_data, otherListOffset);
+    m_otherGlobs.reserve(numOtherGlobs);
+    for (quint32 i = 0; i < numOtherGlobs; ++i) {
+        const quint32 off = globListOffset + 4 + IndexGlobEntrySize * indexUint32(m_data, otherListOffset + 4 + 4 * i);
+        const quint32 flagsAndWeight = indexUint32(m_data, off + 8);
+        m_otherGlobs.append(QMimeGlobPattern(QString::fromUtf8(indexCharStar(m_data, indexUint32(m_data, off))),
+                                             indexLatin1(m_data, indexUint32(m_data, off + 4)),
+                                             flagsAndWeight & 0xff,
+                                             flagsAndWeight & 0x100 ? Qt::CaseSensitive : Qt::CaseInsensitive));
+    }
+#endif
+}
+
+QMimeIndexProvider::~QMimeIndexProvider()
+{
+}
+
+bool QMimeIndexProvider::isValid()
+{
+    return m_data != nullptr;
+}
+
+QMimeType QMimeIndexProvider::mimeTypeForName(const QString &name)
+{
+    if (!indexTypeEntry(m_data, name))
+        return QMimeType(); // unknown mimetype
+    return mimeTypeForNameUnchecked(name);
+}
+
+void QMimeIndexProvider::addFileNameMatches(const QString &fileName, QMimeGlobMatchResult &result)
+{
+    const QString lowerFileName = fileName.toLower();
+    IndexGlobList globs;
+
+    // Check literals (e.g. "Makefile")
+    const quint32 globListOffset = indexUint32(m_data, IndexPosGlobListOffset);
+    const quint32 literalListOffset = indexUint32(m_data, IndexPosLiteralGlobListOffset);
+    const quint32 numLiterals = indexUint32(m_data, literalListOffset);
+    for (quint32 i = 0; i < numLiterals; ++i) {
+        const quint32 glob = indexUint32(m_data, literalListOffset + 4 + 4 * i);
+        const quint32 off = globListOffset + 4 + IndexGlobEntrySize * glob;
+        const bool caseSensitive = indexUint32(m_data, off + 8) & 0x100;
+        if ((caseSensitive ? fileName : lowerFileName) == indexLatin1(m_data, indexUint32(m_data, off)))
+            globs.append(glob);
+    }
+
+    // Check the very common *.txt cases with the suffix trees
+    matchIndexSuffixTree(m_data, indexUint32(m_data, IndexPosCaseInsensitiveSuffixTreeOffset), lowerFileName, globs);
+    matchIndexSuffixTree(m_data, indexUint32(m_data, IndexPosCaseSensitiveSuffixTreeOffset), fileName, globs);
+
+    // Check complex globs (e.g. "*.anim[1-9j]")
+    const quint32 otherListOffset = indexUint32(m_data, IndexPosOtherGlobListOffset);
+    for (int i = 0; i < m_otherGlobs.size(); ++i) {
+        if (m_otherGlobs.at(i).matchFileName(fileName))
+            globs.append(indexUint32(m_data, otherListOffset + 4 + 4 * i));
+    }
+
+    // QMimeGlobMatchResult keeps the first of equally good matches, so report
+    // them in the order QMimeAllGlobPatterns would try them
+    const auto globOffset = [&](quint32 glob) { return globListOffset + 4 + IndexGlobEntrySize * glob; };
+    std::sort(globs.begin(), globs.end(), [&](quint32 lhs, quint32 rhs) {
+        return indexUint32(m_data, globOffset(lhs) + 12) < indexUint32(m_data, globOffset(rhs) + 12);
+    });
+    for (quint32 glob : qAsConst(globs)) {
+        const quint32 off = globOffset(glob);
+        const quint32 flagsAndWeight = indexUint32(m_data, off + 8);
+        result.addMatch(indexLatin1(m_data, indexUint32(m_data, off + 4)), flagsAndWeight & 0xff,
+                        QString::fromUtf8(indexCharStar(m_data, indexUint32(m_data, off))),
+                        flagsAndWeight >> 16);
+    }
+}
+
+void QMimeIndexProvider::addParents(const QString &mime, QStringList &result)
+{
+    const quint32 entry = indexTypeEntry(m_data, mime);
+    const quint32 parentListOffset = entry ? indexUint32(m_data, entry + 4) : 0;
+    if (!parentListOffset)
+        return;
+    const quint32 numParents = indexUint32(m_data, parentListOffset);
+    for (quint32 i = 0; i < numParents; ++i) {
+        const QString parent = indexLatin1(m_data, indexUint32(m_data, parentListOffset + 4 + 4 * i));
+        if (!result.contains(parent))
+            result.append(parent);
+    }
+}
+
+QString QMimeIndexProvider::resolveAlias(const QString &name)
+{
+    const QByteArray input = name.toLatin1();
+    const quint32 aliasListOffset = indexUint32(m_data, IndexPosAliasListOffset);
+    int begin = 0;
+    int end = indexUint32(m_data, aliasListOffset) - 1;
+    while (begin <= end) {
+        const int medium = (begin + end) / 2;
+        const quint32 off = aliasListOffset + 4 + IndexAliasEntrySize * medium;
+        const int cmp = qstrcmp(indexCharStar(m_data, indexUint32(m_data, off)), input);
+        if (cmp < 0)
+            begin = medium + 1;
+        else if (cmp > 0)
+            end = medium - 1;
+        else
+            return indexLatin1(m_data, indexUint32(m_data, off + 4));
+    }
+    return QString();
+}
+
+void QMimeIndexProvider::addAliases(const QString &name, QStringList &result)
+{
+    // Iterate through the whole list. This method is rarely used.
+    const quint32 aliasListOffset = indexUint32(m_data, IndexPosAliasListOffset);
+    const quint32 numAliases = indexUint32(m_data, aliasListOffset);
+    for (quint32 i = 0; i < numAliases; ++i) {
+        const quint32 off = aliasListOffset + 4 + IndexAliasEntrySize * i;
+        if (indexLatin1(m_data, indexUint32(m_data, off + 4)) == name) {
+            const QString alias = indexLatin1(m_data, indexUint32(m_data, off));
+            if (!result.contains(alias))
+                result.append(alias);
+        }
+    }
+}
+
+void QMimeIndexProvider::loadMagicMatchers()
+{
+    const quint32 magicListOffset = indexUint32(m_data, IndexPosMagicListOffset);
+    const quint32 numMatchers = indexUint32(m_data, magicListOffset);
+    for (quint32 i = 0; i < numMatchers; ++i) {
+        const quint32 off = magicListOffset + 4 + IndexMagicEntrySize * i;
+        QMimeMagicRuleMatcher matcher(indexLatin1(m_data, indexUint32(m_data, off)),
+                                      indexUint32(m_data, off + 4));
+        const quint32 numRules = indexUint32(m_data, off + 8);
+        const quint32 rulesOffset = indexUint32(m_data, off + 12);
+        for (quint32 j = 0; j < numRules; ++j)
+            matcher.addRule(indexMagicRule(m_data, rulesOffset + IndexMagicRuleSize * j));
+        m_magicMatchers.append(matcher);
+    }
+    m_magicMatchersLoaded = true;
+}
+
+void QMimeIndexProvider::findByMagic(const QByteArray &data, int *accuracyPtr, QMimeType &candidate)
+{
+    if (!m_magicMatchersLoaded)
+        loadMagicMatchers();
+    if (const QMimeMagicRuleMatcher *matcher = m_magicMatchers.bestMatch(data, *accuracyPtr)) {
+        *accuracyPtr = matcher->priority();
+        candidate = mimeTypeForNameUnchecked(matcher->mimetype());
+    }
+}
+
+void QMimeIndexProvider::addAllMimeTypes(QList<QMimeType> &result)
+{
+    const quint32 typeListOffset = indexUint32(m_data, IndexPosTypeListOffset);
+    const quint32 numTypes = indexUint32(m_data, typeListOffset);
+    const bool fastPath = result.isEmpty();
+    result.reserve(result.size() + numTypes);
+    for (quint32 i = 0; i < numTypes; ++i) {
+        const QString name = indexLatin1(m_data, indexUint32(m_data, typeListOffset + 4 + IndexTypeEntrySize * i));
+        if (fastPath || std::find_if(result.constBegin(), result.constEnd(), [&name](const QMimeType &mime) -> bool { return mime.name() == name; })
+                == result.constEnd())
+            result.append(mimeTypeForNameUnchecked(name));
+    }
+}
+
+void QMimeIndexProvider::loadMimeTypePrivate(QMimeTypePrivate &data)
+{
+    const quint32 entry = data.loaded ? 0 : indexTypeEntry(m_data, data.name);
+    if (!entry)
+        return;
+
+    QStringList globPatterns;
+    if (const quint32 patternListOffset = indexUint32(m_data, entry + 16)) {
+        const quint32 numPatterns = indexUint32(m_data, patternListOffset);
+        globPatterns.reserve(numPatterns);
+        for (quint32 i = 0; i < numPatterns; ++i) {
+            const quint32 pattern = indexUint32(m_data, patternListOffset + 4 + 4 * i);
+            globPatterns.append(QString::fromUtf8(indexCharStar(m_data, pattern)));
+        }
+    }
+    data.globPatterns = globPatterns;
+
+#if QT_CONFIG(mimetype_database) && defined(MIME_DATABASE_HAS_INDEX)
+    // The comments are only in the XML; parse the element of this type alone
+    if (m_xmlData.isNull())
+        m_xmlData = internalMimeData();
+    const quint32 elementOffset = indexUint32(m_data, entry + 20);
+    const quint32 elementSize = indexUint32(m_data, entry + 24);
+    if (Q_LIKELY(qsizetype(elementOffset) + elementSize <= m_xmlData.size())) {
+        QBuffer buffer;
+        buffer.setData(QByteArray::fromRawData(m_xmlData.constData() + elementOffset, elementSize));
+        buffer.open(QIODevice::ReadOnly);
+        QString errorMessage;
+        QMimeTypeElementParser parser;
+        if (parser.parse(&buffer, internalMimeFileName(), &errorMessage))
+            data.localeComments = QMimeTypePrivate(parser.mimeType()).localeComments;
+        else
+            qWarning("QMimeDatabase: Error loading internal MIME data\n%s", qPrintable(errorMessage));
+    }
+#endif
+    data.loaded = true;
+}
+
+void QMimeIndexProvider::loadIcon(QMimeTypePrivate &data)
+{
+    if (const quint32 entry = indexTypeEntry(m_data, data.name)) {
+        const QLatin1String icon = indexLatin1(m_data, indexUint32(m_data, entry + 8));
+        if (!icon.isEmpty())
+            data.iconName = icon;
+    }
+}
+
+void QMimeIndexProvider::loadGenericIcon(QMimeTypePrivate &data)
+{
+    if (const quint32 entry = indexTypeEntry(m_data, data.name)) {
+        const QLatin1String icon = indexLatin1(m_data, indexUint32(m_data, entry + 12));
+        if (!icon.isEmpty())
+            data.genericIconName = icon;
+    }
+}
+
 QT_END_NAMESPACE
@@ -57,12 +57,12 @@
 QT_REQUIRE_CONFIG(mimetype);
 
 #include "qmimeglobpattern_p.h"
+#include "qmimemagicrulematcher_p.h"
 #include <QtCore/qdatetime.h>
 #include <QtCore/qset.h>
 
-QT_BEGIN_NAMESPACE
 
-class QMimeMagicRuleMatcher;
+QT_BEGIN_NAMESPACE
 
 class QMimeProviderBase
 {
@@ -78,11 +78,13 @@ public:
     virtual void addAliases(const QString &name, QStringList &result) = 0;
     virtual void findByMagic(const QByteArray &data, int *accuracyPtr, QMimeType &candidate) = 0;
     virtual void addAllMimeTypes(QList<QMimeType> &result) = 0;
+    virtual void loadMimeTypePrivate(QMimeTypePrivate &) {}
     virtual void loadIcon(QMimeTypePrivate &) {}
     virtual void loadGenericIcon(QMimeTypePrivate &) {}
     virtual void ensureLoaded() {}
 
     QString directory() const { return m_directory; }
+    bool isInternalDatabase() const;
 
     QMimeDatabasePrivate *m_db;
     QString m_directory;
@@ -105,7 +107,7 @@ public:
     void addAliases(const QString &name, QStringList &result) override;
     void findByMagic(const QByteArray &data, int *accuracyPtr, QMimeType &candidate) override;
     void addAllMimeTypes(QList<QMimeType> &result) override;
-    static void loadMimeTypePrivate(QMimeTypePrivate &);
+    void loadMimeTypePrivate(QMimeTypePrivate &) override;
     void loadIcon(QMimeTypePrivate &) override;
     void loadGenericIcon(QMimeTypePrivate &) override;
     void ensureLoaded() override;
@@ -129,7 +131,7 @@ private:
 /*
    Parses the raw XML files (slower)
  */
-class QMimeXMLProvider : public QMimeProviderBase
+class Q_AUTOTEST_EXPORT QMimeXMLProvider : public QMimeProviderBase
 {
 public:
     enum InternalDatabaseEnum { InternalDatabase };
@@ -175,10 +177,42 @@ private:
     ParentsHash m_parents;
     QMimeAllGlobPatterns m_mimeTypeGlobs;
 
-    QList<QMimeMagicRuleMatcher> m_magicMatchers;
+    QMimeMagicRuleMatcherSet m_magicMatchers;
     QStringList m_allFiles;
 };
 
+/*
+   Reads the index of the internal database generated at build time, and
+   only parses the XML element of a MIME type when its comments are needed
+ */
+class Q_AUTOTEST_EXPORT QMimeIndexProvider : public QMimeProviderBase
+{
+public:
+    explicit QMimeIndexProvider(QMimeDatabasePrivate *db);
+    ~QMimeIndexProvider();
+
+    bool isValid() override;
+    QMimeType mimeTypeForName(const QString &name) override;
+    void addFileNameMatches(const QString &fileName, QMimeGlobMatchResult &result) override;
+    void addParents(const QString &mime, QStringList &result) override;
+    QString resolveAlias(const QString &name) override;
+    void addAliases(const QString &name, QStringList &result) override;
+    void findByMagic(const QByteArray &data, int *accuracyPtr, QMimeType &candidate) override;
+    void addAllMimeTypes(QList<QMimeType> &result) override;
+    void loadMimeTypePrivate(QMimeTypePrivate &) override;
+    void loadIcon(QMimeTypePrivate &) override;
+    void loadGenericIcon(QMimeTypePrivate &) override;
+
+private:
+    void loadMagicMatchers();
+
+    const uchar *m_data = nullptr;
+    QList<QMimeGlobPattern> m_otherGlobs; // in the order of the index
+    QMimeMagicRuleMatcherSet m_magicMatchers;
+    bool m_magicMatchersLoaded = false;
+    QByteArray m_xmlData; // uncompressed on demand, for the comments
+};
+
 QT_END_NAMESPACE
 
 #endif // QMIMEPROVIDER_P_H
@@ -62,7 +62,7 @@ QT_BEGIN_NAMESPACE
 
 class QIODevice;
 
-class QMimeTypeParserBase
+class Q_AUTOTEST_EXPORT QMimeTypeParserBase
 {
     Q_DISABLE_COPY_MOVE(QMimeTypeParserBase)
 
@@ -127,6 +127,29 @@ private:
     QMimeXMLProvider &m_provider;
 };
 
+// Parses a single <mime-type> element, for the comments of that type
+class QMimeTypeElementParser : public QMimeTypeParserBase
+{
+public:
+    QMimeTypeElementParser() {}
+
+    QMimeType mimeType() const { return m_mimeType; }
+
+protected:
+    inline bool process(const QMimeType &t, QString *) override
+    { m_mimeType = t; return true; }
+
+    inline bool process(const QMimeGlobPattern &, QString *) override
+    { return true; }
+
+    inline void processParent(const QString &, const QString &) override {}
+    inline void processAlias(const QString &, const QString &) override {}
+    inline void processMagicMatcher(const QMimeMagicRuleMatcher &) override {}
+
+private:
+    QMimeType m_mimeType;
+};
+
 QT_END_NAMESPACE
 
 #endif // MIMETYPEPARSER_P_H
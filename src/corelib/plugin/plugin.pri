@@ -24,12 +24,14 @@ qtConfig(library) {
         plugin/qlibrary.h \
         plugin/qlibrary_p.h \
         plugin/qelfparser_p.h \
-        plugin/qmachparser_p.h
+        plugin/qmachparser_p.h \
+        plugin/qpluginmetadatacache_p.h
 
     SOURCES += \
         plugin/qlibrary.cpp \
         plugin/qelfparser_p.cpp \
-        plugin/qmachparser.cpp
+        plugin/qmachparser.cpp \
+        plugin/qpluginmetadatacache.cpp
 
     unix: SOURCES += plugin/qlibrary_unix.cpp
     else: SOURCES += plugin/qlibrary_win.cpp
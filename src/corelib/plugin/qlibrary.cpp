@@ -63,6 +63,7 @@
 #include <qjsonvalue.h>
 #include "qelfparser_p.h"
 #include "qmachparser_p.h"
+#include "qpluginmetadatacache_p.h"
 
 #include <qtcore_tracepoints_p.h>
 
@@ -236,6 +237,14 @@ static qsizetype qt_find_pattern(const char *s, qsizetype s_len,
 */
 static bool findPatternUnloaded(const QString &library, QLibraryPrivate *lib)
 {
+    // the cache needs somewhere to put what it found and to take what to store
+    QPluginMetaDataCache *cache = lib ? QPluginMetaDataCache::instance() : nullptr;
+    if (cache && cache->lookup(library, &lib->metaData, &lib->errorString)) {
+        if (qt_debug_component())
+            qWarning("Found cached metadata for lib %ls", qUtf16Printable(library));
+        return !lib->metaData.isEmpty();
+    }
+
     QFile file(library);
     if (!file.open(QIODevice::ReadOnly)) {
         if (lib)
@@ -277,6 +286,8 @@ static bool findPatternUnloaded(const QString &library, QLibraryPrivate *lib)
             if (lib && qt_debug_component()) {
                 qWarning("QElfParser: %ls", qUtf16Printable(lib->errorString));
             }
+            if (cache)
+                cache->insert(library, QJsonObject(), lib->errorString);
             return false;
     } else if (r == QElfParser::QtMetaDataSection) {
         qsizetype rel = qt_find_pattern(filedata + pos, fdlen, pattern, plen);
@@ -332,6 +343,8 @@ static bool findPatternUnloaded(const QString &library, QLibraryPrivate *lib)
 
     if (!ret && lib)
         lib->errorString = QLibrary::tr("Failed to extract plugin meta data from '%1'").arg(library);
+    if (cache)
+        cache->insert(library, ret ? lib->metaData : QJsonObject(), lib->errorString);
     file.close();
     return ret;
 }
@@ -0,0 +1,393 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qpluginmetadatacache_p.h"
+
+#include <qcborarray.h>
+#include <qcborvalue.h>
+#include <qdir.h>
+#include <qfile.h>
+#include <qfileinfo.h>
+#include <qlockfile.h>
+#include <qsavefile.h>
+#include <qstandardpaths.h>
+#include <qsysinfo.h>
+#include "qlibrary_p.h"
+#include "private/qfilesystemengine_p.h"
+
+#ifdef Q_OS_UNIX
+#  include "private/qcore_unix_p.h"
+#endif
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \internal
+    \class QPluginMetaDataCache
+    \inmodule QtCore
+
+    QPluginMetaDataCache remembers the metadata that QLibrary extracted from
+    plugins that were scanned but not loaded, so that QFactoryLoader does not
+    have to open and parse every file in the plugin directories on each start.
+
+    Each entry is keyed by the path of the library as QLibrary was given it,
+    which is the canonical path for the plugins that QFactoryLoader scans, and
+    stamped with its modification time, size and file identity (device and
+    inode on Unix). A file reached through different paths may therefore have
+    several entries; the stamps keep all of them correct.
+    A lookup whose stamp no longer matches the file on disk is a miss, so
+    replaced or rebuilt plugins are picked up without any explicit
+    invalidation. Files that were found not to be plugins are remembered as
+    well, together with the reason they were rejected.
+
+    The cache file is a CBOR document. It is replaced atomically with
+    QSaveFile, so readers always see a complete snapshot, and writers
+    serialize through a QLockFile and merge the entries written by other
+    processes in the meantime. A process that cannot get the lock immediately
+    keeps its changes and tries again on the next sync().
+
+    The location defaults to a file below
+    QStandardPaths::GenericCacheLocation that is specific to the build ABI.
+    It can be changed with the \c QT_PLUGIN_METADATA_CACHE environment
+    variable; setting it to an empty value disables the cache.
+*/
+
+static const int CacheFormatVersion = 1;
+
+enum EntryField {
+    PathField,
+    ModificationTimeField,
+    SizeField,
+    IdField,
+    DataField,
+    FieldCount
+};
+
+Q_GLOBAL_STATIC(QPluginMetaDataCache, pluginMetaDataCache)
+
+QPluginMetaDataCache::QPluginMetaDataCache()
+    : cacheFileName(defaultFileName())
+{
+}
+
+QPluginMetaDataCache::~QPluginMetaDataCache()
+{
+}
+
+/*!
+    \internal
+    Returns the process-wide cache, or \nullptr during global destruction.
+*/
+QPluginMetaDataCache *QPluginMetaDataCache::instance()
+{
+    return pluginMetaDataCache();
+}
+
+QString QPluginMetaDataCache::defaultFileName()
+{
+    if (qEnvironmentVariableIsSet("QT_PLUGIN_METADATA_CACHE"))
+        return qEnvironmentVariable("QT_PLUGIN_METADATA_CACHE");
+
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    if (dir.isEmpty())
+        return QString();
+    return dir + QLatin1String("/qt" QT_STRINGIFY(QT_VERSION_MAJOR) "/plugin-metadata-")
+            + QSysInfo::buildAbi() + QLatin1String(".cbor");
+}
+
+#ifdef Q_OS_UNIX
+template <typename T>
+static inline typename std::enable_if_t<(&T::st_mtim, true), qint64> modificationTimeNSecs(const T &st)
+{
+    return qint64(st.st_mtim.tv_sec) * Q_INT64_C(1000000000) + st.st_mtim.tv_nsec;
+}
+
+template <typename T>
+static inline typename std::enable_if_t<(&T::st_mtimespec, true), qint64> modificationTimeNSecs(const T &st)
+{
+    return qint64(st.st_mtimespec.tv_sec) * Q_INT64_C(1000000000) + st.st_mtimespec.tv_nsec;
+}
+
+static inline qint64 modificationTimeNSecs(...)
+{
+    return 0;
+}
+#endif
+
+/*!
+    \internal
+    Returns the stamp that identifies the current contents of \a fileName,
+    or an invalid stamp if the file cannot be examined.
+*/
+QPluginMetaDataCache::Stamp QPluginMetaDataCache::stamp(const QString &fileName)
+{
+    Stamp result;
+#ifdef Q_OS_UNIX
+    QT_STATBUF st;
+    if (QT_STAT(QFile::encodeName(fileName).constData(), &st) != 0)
+        return result;
+    result.modificationTime = modificationTimeNSecs(st);
+    if (!result.modificationTime)
+        result.modificationTime = qint64(st.st_mtime) * Q_INT64_C(1000000000);
+    result.size = st.st_size;
+    result.id = QByteArray::number(quint64(st.st_dev), 16) + ':'
+            + QByteArray::number(quint64(st.st_ino));
+#else
+    QFileSystemEntry entry(fileName);
+    QFileSystemMetaData data;
+    if (!QFileSystemEngine::fillMetaData(entry, data, QFileSystemMetaData::SizeAttribute
+                                         | QFileSystemMetaData::ModificationTime)
+            || !data.exists()) {
+        return result;
+    }
+    result.modificationTime = data.modificationTime().toMSecsSinceEpoch() * 1000000;
+    result.size = data.size();
+    result.id = QFileSystemEngine::id(entry);
+#endif
+    return result;
+}
+
+QString QPluginMetaDataCache::fileName() const
+{
+    QMutexLocker locker(&mutex);
+    return cacheFileName;
+}
+
+/*!
+    \internal
+    Makes the cache use \a fileName from now on, discarding whatever was read
+    from or remembered for the previous file. An empty \a fileName disables
+    the cache.
+*/
+void QPluginMetaDataCache::setFileName(const QString &fileName)
+{
+    QMutexLocker locker(&mutex);
+    cacheFileName = fileName;
+    entries.clear();
+    pendingStamps.clear();
+    loaded = false;
+    dirty = false;
+}
+
+void QPluginMetaDataCache::ensureLoaded()
+{
+    if (loaded)
+        return;
+    loaded = true;
+    read(cacheFileName, &entries);
+}
+
+/*!
+    \internal
+    Looks up the metadata of \a library. Returns \c false if the cache has no
+    up-to-date entry for it, in which case the caller should parse the file
+    and report the result with insert(). Otherwise, sets \a metaData and
+    \a errorString to what was recorded; \a metaData is empty if the file is
+    not a plugin.
+*/
+bool QPluginMetaDataCache::lookup(const QString &library, QJsonObject *metaData,
+                                  QString *errorString)
+{
+    QMutexLocker locker(&mutex);
+    if (cacheFileName.isEmpty())
+        return false;
+    ensureLoaded();
+
+    // stat before the caller parses the file, so that a plugin replaced while
+    // we are reading it gets a stamp that will not match on the next lookup
+    const Stamp current = stamp(library);
+    if (!current.isValid())
+        return false;
+
+    const auto it = entries.constFind(library);
+    if (it == entries.constEnd() || it->stamp != current) {
+        pendingStamps.insert(library, current);
+        return false;
+    }
+
+    *metaData = it->metaData.toJsonObject();
+    *errorString = it->errorString;
+    return true;
+}
+
+/*!
+    \internal
+    Records the result of parsing \a library: its \a metaData, or an empty
+    object and \a errorString if it is not a plugin. The cache is not written
+    to disk until sync() is called.
+*/
+void QPluginMetaDataCache::insert(const QString &library, const QJsonObject &metaData,
+                                  const QString &errorString)
+{
+    QMutexLocker locker(&mutex);
+    if (cacheFileName.isEmpty())
+        return;
+
+    Entry entry;
+    entry.stamp = pendingStamps.take(library);
+    if (!entry.stamp.isValid())
+        entry.stamp = stamp(library);
+    if (!entry.stamp.isValid())
+        return;
+    entry.metaData = QCborMap::fromJsonObject(metaData);
+    if (metaData.isEmpty())
+        entry.errorString = errorString;
+
+    ensureLoaded();
+    entries.insert(library, std::move(entry));
+    dirty = true;
+}
+
+/*!
+    \internal
+    Writes the entries added since the last sync() to the cache file, merged
+    with the ones other processes have written in the meantime. Entries for
+    libraries that no longer exist are dropped.
+
+    Returns \c true if there was nothing to write or the file was written.
+*/
+bool QPluginMetaDataCache::sync()
+{
+    QMutexLocker locker(&mutex);
+    if (!dirty || cacheFileName.isEmpty())
+        return true;
+
+#if QT_CONFIG(temporaryfile)
+    QDir().mkpath(QFileInfo(cacheFileName).absolutePath());
+
+    // don't make application startup wait on another process; our entries
+    // stay dirty and are written out by the next sync() instead
+    QLockFile lock(cacheFileName + QLatin1String(".lock"));
+    if (!lock.tryLock(0))
+        return false;
+
+    EntryHash merged;
+    read(cacheFileName, &merged);
+    for (auto it = entries.cbegin(); it != entries.cend(); ++it)
+        merged.insert(it.key(), it.value());
+
+    // drop the libraries that were removed or replaced since they were cached,
+    // whether we or another process recorded them
+    for (auto it = merged.begin(); it != merged.end(); ) {
+        if (stamp(it.key()) != it->stamp)
+            it = merged.erase(it);
+        else
+            ++it;
+    }
+
+    QSaveFile file(cacheFileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    file.write(serialize(merged));
+    if (!file.commit()) {
+        if (qt_debug_component())
+            qWarning("QPluginMetaDataCache: cannot write %ls: %ls",
+                     qUtf16Printable(cacheFileName), qUtf16Printable(file.errorString()));
+        return false;
+    }
+
+    entries = std::move(merged);
+    dirty = false;
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool QPluginMetaDataCache::read(const QString &fileName, EntryHash *entries)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QCborParserError error;
+    const QCborValue document = QCborValue::fromCbor(file.readAll(), &error);
+    if (error.error != QCborError::NoError
+            || document[QLatin1String("version")].toInteger() != CacheFormatVersion) {
+        if (qt_debug_component())
+            qWarning("QPluginMetaDataCache: ignoring invalid cache file %ls",
+                     qUtf16Printable(fileName));
+        return false;
+    }
+
+    const QCborArray list = document[QLatin1String("entries")].toArray();
+    entries->reserve(entries->size() + list.size());
+    for (const QCborValue &value : list) {
+        const QCborArray fields = value.toArray();
+        if (fields.size() != FieldCount)
+            continue;
+
+        Entry entry;
+        entry.stamp.modificationTime = fields.at(ModificationTimeField).toInteger();
+        entry.stamp.size = fields.at(SizeField).toInteger(-1);
+        entry.stamp.id = fields.at(IdField).toByteArray();
+        const QCborValue data = fields.at(DataField);
+        if (data.isMap())
+            entry.metaData = data.toMap();
+        else
+            entry.errorString = data.toString();
+        entries->insert(fields.at(PathField).toString(), std::move(entry));
+    }
+    return true;
+}
+
+QByteArray QPluginMetaDataCache::serialize(const EntryHash &entries)
+{
+    QCborArray list;
+    for (auto it = entries.cbegin(); it != entries.cend(); ++it) {
+        QCborArray fields;
+        fields.append(it.key());
+        fields.append(it->stamp.modificationTime);
+        fields.append(it->stamp.size);
+        fields.append(it->stamp.id);
+        if (it->metaData.isEmpty())
+            fields.append(it->errorString);
+        else
+            fields.append(it->metaData);
+        list.append(fields);
+    }
+
+    QCborMap document;
+    document.insert(QLatin1String("version"), CacheFormatVersion);
+    document.insert(QLatin1String("entries"), list);
+    return document.toCborValue().toCbor();
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,121 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QPLUGINMETADATACACHE_P_H
+#define QPLUGINMETADATACACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qcbormap.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qstring.h>
+
+QT_REQUIRE_CONFIG(library);
+
+QT_BEGIN_NAMESPACE
+
+class Q_CORE_EXPORT QPluginMetaDataCache
+{
+public:
+    struct Stamp
+    {
+        qint64 modificationTime = 0;
+        qint64 size = -1;
+        QByteArray id;
+
+        bool isValid() const { return size >= 0; }
+        bool operator==(const Stamp &other) const
+        {
+            return modificationTime == other.modificationTime && size == other.size
+                    && id == other.id;
+        }
+        bool operator!=(const Stamp &other) const { return !operator==(other); }
+    };
+
+    QPluginMetaDataCache();
+    ~QPluginMetaDataCache();
+
+    static QPluginMetaDataCache *instance();
+    static QString defaultFileName();
+    static Stamp stamp(const QString &fileName);
+
+    QString fileName() const;
+    void setFileName(const QString &fileName);
+
+    bool lookup(const QString &library, QJsonObject *metaData, QString *errorString);
+    void insert(const QString &library, const QJsonObject &metaData, const QString &errorString);
+    bool sync();
+
+private:
+    struct Entry
+    {
+        Stamp stamp;
+        QCborMap metaData;          // empty if the file is not a plugin
+        QString errorString;
+    };
+    using EntryHash = QHash<QString, Entry>;
+
+    void ensureLoaded();
+    static bool read(const QString &fileName, EntryHash *entries);
+    static QByteArray serialize(const EntryHash &entries);
+
+    mutable QMutex mutex;
+    QString cacheFileName;
+    EntryHash entries;
+    QHash<QString, Stamp> pendingStamps;
+    bool loaded = false;
+    bool dirty = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QPLUGINMETADATACACHE_P_H
@@ -49,6 +49,8 @@
 #include <stdlib.h>
 #include "qendian.h"
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 /*!
@@ -1114,6 +1116,179 @@ int QDataStream::readRawData(char *s, int len)
     return readBlock(s, len);
 }
 
+/*!
+    \fn template <typename T> QDataStream &QDataStream::readRawArray(T *data, qsizetype count)
+    \since 6.0
+
+    Reads \a count values of the arithmetic type \c T from the stream into
+    the preallocated array \a data, and returns a reference to the stream.
+
+    The result is the same as reading each element with operator>>(), but
+    the whole array is read with a single call to the underlying device and
+    converted in bulk if byteOrder() differs from the host byte order.
+    \c T must be an integral type of at most 64 bits, \c float or
+    \c double; the floatingPointPrecision() of the stream is honored.
+
+    If the stream runs out of data, the status is set to ReadPastEnd and
+    the contents of \a data are zeroed.
+
+    \sa writeRawArray(), readRawData()
+*/
+
+namespace {
+bool hasHostByteOrder(const QDataStream &s)
+{
+    return int(s.byteOrder()) == int(QSysInfo::ByteOrder);
+}
+
+void swapArray(const void *source, qsizetype count, int size, void *dest)
+{
+    switch (size) {
+    case 2:
+        qbswap<2>(source, count, dest);
+        break;
+    case 4:
+        qbswap<4>(source, count, dest);
+        break;
+    case 8:
+        qbswap<8>(source, count, dest);
+        break;
+    }
+}
+
+// Reads or writes \a count values of \a size bytes each, converting between
+// the stream and the host byte order in bulk.
+void readSwappedArray(QDataStream &s, void *data, qsizetype count, int size)
+{
+    const qint64 len = qint64(count) * size;
+    // Disable reads on failure in transacted stream
+    if (s.status() != QDataStream::Ok && s.device()->isTransactionStarted())
+        return;
+
+    if (s.device()->read(static_cast<char *>(data), len) != len) {
+        s.setStatus(QDataStream::ReadPastEnd);
+        memset(data, 0, len);
+    } else if (!hasHostByteOrder(s)) {
+        swapArray(data, count, size, data);
+    }
+}
+
+void writeSwappedArray(QDataStream &s, const void *data, qsizetype count, int size)
+{
+    QIODevice *dev = s.device();
+    if (hasHostByteOrder(s) || size == 1) {
+        const qint64 len = qint64(count) * size;
+        if (dev->write(static_cast<const char *>(data), len) != len)
+            s.setStatus(QDataStream::WriteFailed);
+        return;
+    }
+
+    alignas(quint64) char buffer[16384];
+    const qsizetype step = qsizetype(sizeof(buffer)) / size;
+    const char *src = static_cast<const char *>(data);
+    for (qsizetype i = 0; i < count; i += step) {
+        const qsizetype n = qMin(step, count - i);
+        swapArray(src + i * size, n, size, buffer);
+        if (dev->write(buffer, n * size) != n * size) {
+            s.setStatus(QDataStream::WriteFailed);
+            break;
+        }
+    }
+}
+
+// Number of elements converted at a time when the stream and the array
+// disagree on the floating point precision.
+constexpr qsizetype ConversionChunkSize = 2048;
+
+template <typename To, typename From>
+void readConvertedArray(QDataStream &s, To *data, qsizetype count)
+{
+    From buffer[ConversionChunkSize];
+    for (qsizetype i = 0; i < count; i += ConversionChunkSize) {
+        const qsizetype n = qMin(ConversionChunkSize, count - i);
+        const QDataStream::Status oldStatus = s.status();
+        readSwappedArray(s, buffer, n, int(sizeof(From)));
+        if (s.status() != oldStatus) {
+            std::fill_n(data, count, To(0));
+            break;
+        }
+        std::copy(buffer, buffer + n, data + i);
+    }
+}
+
+template <typename To, typename From>
+void writeConvertedArray(QDataStream &s, const From *data, qsizetype count)
+{
+    To buffer[ConversionChunkSize];
+    for (qsizetype i = 0; i < count && s.status() == QDataStream::Ok; i += ConversionChunkSize) {
+        const qsizetype n = qMin(ConversionChunkSize, count - i);
+        std::copy(data + i, data + i + n, buffer);
+        writeSwappedArray(s, buffer, n, int(sizeof(To)));
+    }
+}
+} // unnamed namespace
+
+/*!
+    \internal
+
+    Reads \a count integers of \a size bytes each into \a data.
+*/
+QDataStream &QDataStream::readRawArrayHelper(void *data, qsizetype count, int size)
+{
+    if (count <= 0)
+        return *this;
+    memset(data, 0, qint64(count) * size);
+    CHECK_STREAM_PRECOND(*this)
+
+    if (size == int(sizeof(qint64)) && version() < 6) {
+        // old streams store 64-bit integers as two 32-bit halves
+        qint64 *values = static_cast<qint64 *>(data);
+        for (qsizetype i = 0; i < count; ++i)
+            *this >> values[i];
+        return *this;
+    }
+
+    readSwappedArray(*this, data, count, size);
+    return *this;
+}
+
+/*!
+    \internal
+*/
+QDataStream &QDataStream::readRawArrayHelper(float *data, qsizetype count)
+{
+    if (count <= 0)
+        return *this;
+    std::fill_n(data, count, 0.0f);
+    CHECK_STREAM_PRECOND(*this)
+
+    if (version() >= QDataStream::Qt_4_6
+        && floatingPointPrecision() == QDataStream::DoublePrecision) {
+        readConvertedArray<float, double>(*this, data, count);
+    } else {
+        readSwappedArray(*this, data, count, int(sizeof(float)));
+    }
+    return *this;
+}
+
+/*!
+    \internal
+*/
+QDataStream &QDataStream::readRawArrayHelper(double *data, qsizetype count)
+{
+    if (count <= 0)
+        return *this;
+    std::fill_n(data, count, 0.0);
+    CHECK_STREAM_PRECOND(*this)
+
+    if (version() >= QDataStream::Qt_4_6
+        && floatingPointPrecision() == QDataStream::SinglePrecision) {
+        readConvertedArray<double, float>(*this, data, count);
+    } else {
+        readSwappedArray(*this, data, count, int(sizeof(double)));
+    }
+    return *this;
+}
 /*! \fn template <class T1, class T2> QDataStream &operator>>(QDataStream &in, std::pair<T1, T2> &pair)
     \since 6.0
     \relates QDataStream
@@ -1428,6 +1603,82 @@ int QDataStream::writeRawData(const char *s, int len)
     return ret;
 }
 
+/*!
+    \fn template <typename T> QDataStream &QDataStream::writeRawArray(const T *data, qsizetype count)
+    \since 6.0
+
+    Writes \a count values of the arithmetic type \c T from the array
+    \a data to the stream, and returns a reference to the stream.
+
+    The encoded data is the same as writing each element with operator<<(),
+    but if the stream uses the host byte order the array is passed to the
+    underlying device in a single call. Otherwise it is byte swapped in bulk,
+    a block at a time. \c T must be an integral type of at most 64 bits,
+    \c float or \c double; the floatingPointPrecision() of the stream is
+    honored.
+
+    \sa readRawArray(), writeRawData()
+*/
+
+/*!
+    \internal
+
+    Writes \a count integers of \a size bytes each from \a data.
+*/
+QDataStream &QDataStream::writeRawArrayHelper(const void *data, qsizetype count, int size)
+{
+    CHECK_STREAM_WRITE_PRECOND(*this)
+    if (count <= 0)
+        return *this;
+
+    if (size == int(sizeof(qint64)) && version() < 6) {
+        // old streams store 64-bit integers as two 32-bit halves
+        const qint64 *values = static_cast<const qint64 *>(data);
+        for (qsizetype i = 0; i < count && q_status == Ok; ++i)
+            *this << values[i];
+        return *this;
+    }
+
+    writeSwappedArray(*this, data, count, size);
+    return *this;
+}
+
+/*!
+    \internal
+*/
+QDataStream &QDataStream::writeRawArrayHelper(const float *data, qsizetype count)
+{
+    CHECK_STREAM_WRITE_PRECOND(*this)
+    if (count <= 0)
+        return *this;
+
+    if (version() >= QDataStream::Qt_4_6
+        && floatingPointPrecision() == QDataStream::DoublePrecision) {
+        writeConvertedArray<double, float>(*this, data, count);
+    } else {
+        writeSwappedArray(*this, data, count, int(sizeof(float)));
+    }
+    return *this;
+}
+
+/*!
+    \internal
+*/
+QDataStream &QDataStream::writeRawArrayHelper(const double *data, qsizetype count)
+{
+    CHECK_STREAM_WRITE_PRECOND(*this)
+    if (count <= 0)
+        return *this;
+
+    if (version() >= QDataStream::Qt_4_6
+        && floatingPointPrecision() == QDataStream::SinglePrecision) {
+        writeConvertedArray<float, double>(*this, data, count);
+    } else {
+        writeSwappedArray(*this, data, count, int(sizeof(double)));
+    }
+    return *this;
+}
+
 /*!
     \since 4.1
 
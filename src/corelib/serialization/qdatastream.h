@@ -59,6 +59,10 @@ class QIODevice;
 class QDataStreamPrivate;
 namespace QtPrivate {
 class StreamStateSaver;
+template <typename T>
+using IsDataStreamArrayType = std::bool_constant<(std::is_integral_v<T> && sizeof(T) <= sizeof(qint64))
+                                                 || std::is_same_v<T, float>
+                                                 || std::is_same_v<T, double>>;
 }
 class Q_CORE_EXPORT QDataStream : public QIODeviceBase
 {
@@ -190,6 +194,13 @@ public:
 
     int skipRawData(int len);
 
+    template <typename T>
+    std::enable_if_t<QtPrivate::IsDataStreamArrayType<T>::value, QDataStream &>
+    readRawArray(T *data, qsizetype count);
+    template <typename T>
+    std::enable_if_t<QtPrivate::IsDataStreamArrayType<T>::value, QDataStream &>
+    writeRawArray(const T *data, qsizetype count);
+
     void startTransaction();
     bool commitTransaction();
     void rollbackTransaction();
@@ -209,6 +220,12 @@ private:
     Status q_status;
 
     int readBlock(char *data, int len);
+    QDataStream &readRawArrayHelper(void *data, qsizetype count, int size);
+    QDataStream &readRawArrayHelper(float *data, qsizetype count);
+    QDataStream &readRawArrayHelper(double *data, qsizetype count);
+    QDataStream &writeRawArrayHelper(const void *data, qsizetype count, int size);
+    QDataStream &writeRawArrayHelper(const float *data, qsizetype count);
+    QDataStream &writeRawArrayHelper(const double *data, qsizetype count);
     friend class QtPrivate::StreamStateSaver;
 };
 
@@ -257,6 +274,33 @@ QDataStream &readArrayBasedContainer(QDataStream &s, Container &c)
     return s;
 }
 
+template <typename Container>
+QDataStream &readArithmeticArrayContainer(QDataStream &s, Container &c)
+{
+    StreamStateSaver stateSaver(&s);
+
+    c.clear();
+    quint32 n;
+    s >> n;
+    // Grow in bounded steps, so that a corrupt size only allocates as much
+    // memory as the stream actually provides data for.
+    constexpr quint32 Step = 1024 * 1024 / sizeof(typename Container::value_type);
+    for (quint32 done = 0; done < n; ) {
+        const quint32 chunk = qMin(Step, n - done);
+        if (qint64(done + chunk) > c.capacity())
+            c.reserve(qMin<qint64>(n, qMax<qint64>(2 * c.capacity(), done + chunk)));
+        c.resize(done + chunk);
+        s.readRawArray(c.data() + done, chunk);
+        if (s.status() != QDataStream::Ok) {
+            c.clear();
+            break;
+        }
+        done += chunk;
+    }
+
+    return s;
+}
+
 template <typename Container>
 QDataStream &readListBasedContainer(QDataStream &s, Container &c)
 {
@@ -310,6 +354,13 @@ QDataStream &writeSequentialContainer(QDataStream &s, const Container &c)
     return s;
 }
 
+template <typename Container>
+QDataStream &writeArithmeticArrayContainer(QDataStream &s, const Container &c)
+{
+    s << quint32(c.size());
+    return s.writeRawArray(c.constData(), c.size());
+}
+
 template <typename Container>
 QDataStream &writeAssociativeContainer(QDataStream &s, const Container &c)
 {
@@ -399,6 +450,34 @@ inline QDataStream &QDataStream::operator<<(quint32 i)
 inline QDataStream &QDataStream::operator<<(quint64 i)
 { return *this << qint64(i); }
 
+template <typename T>
+inline std::enable_if_t<QtPrivate::IsDataStreamArrayType<T>::value, QDataStream &>
+QDataStream::readRawArray(T *data, qsizetype count)
+{
+    if constexpr (std::is_floating_point_v<T>) {
+        return readRawArrayHelper(data, count);
+    } else {
+        readRawArrayHelper(data, count, int(sizeof(T)));
+        if constexpr (std::is_same_v<T, bool>) {
+            // the stream may hold any non-zero byte for true
+            uchar *bytes = reinterpret_cast<uchar *>(data);
+            for (qsizetype i = 0; i < count; ++i)
+                bytes[i] = bytes[i] != 0;
+        }
+        return *this;
+    }
+}
+
+template <typename T>
+inline std::enable_if_t<QtPrivate::IsDataStreamArrayType<T>::value, QDataStream &>
+QDataStream::writeRawArray(const T *data, qsizetype count)
+{
+    if constexpr (std::is_floating_point_v<T>)
+        return writeRawArrayHelper(data, count);
+    else
+        return writeRawArrayHelper(data, count, int(sizeof(T)));
+}
+
 template <typename Enum>
 inline QDataStream &operator<<(QDataStream &s, QFlags<Enum> e)
 { return s << typename QFlags<Enum>::Int(e); }
@@ -425,13 +504,19 @@ operator>>(QDataStream &s, T &t)
 template<typename T>
 inline QDataStreamIfHasIStreamOperators<T> operator>>(QDataStream &s, QList<T> &v)
 {
-    return QtPrivate::readArrayBasedContainer(s, v);
+    if constexpr (QtPrivate::IsDataStreamArrayType<T>::value)
+        return QtPrivate::readArithmeticArrayContainer(s, v);
+    else
+        return QtPrivate::readArrayBasedContainer(s, v);
 }
 
 template<typename T>
 inline QDataStreamIfHasOStreamOperators<T> operator<<(QDataStream &s, const QList<T> &v)
 {
-    return QtPrivate::writeSequentialContainer(s, v);
+    if constexpr (QtPrivate::IsDataStreamArrayType<T>::value)
+        return QtPrivate::writeArithmeticArrayContainer(s, v);
+    else
+        return QtPrivate::writeSequentialContainer(s, v);
 }
 
 template <typename T>
@@ -0,0 +1,450 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QAHOCORASICK_P_H
+#define QAHOCORASICK_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of internal files.  This header file may change from version to version
+// without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/private/qsimd_p.h>
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qlist.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPrivate {
+
+/*
+    Aho-Corasick automaton finding all the occurrences of a set of needles
+    in a haystack in a single pass, independently of the number of needles.
+
+    Needles are added with addNeedle(), each with a caller-chosen id (several
+    needles may share an id, and several ids may share a needle). build()
+    must be called once after the last needle was added and before the first
+    scan(). A built automaton is immutable and can be scanned from several
+    threads at the same time.
+
+    \c Char is the code unit type, e.g. uchar or char16_t. Transitions out of
+    the root for code units below 256 are kept in a table, all the others in
+    sorted per-node edge lists.
+*/
+template <typename Char>
+class AhoCorasickAutomaton
+{
+public:
+    AhoCorasickAutomaton()
+    {
+        nodes.append(Node());
+        std::fill_n(rootTable, RootTableSize, 0);
+        std::fill_n(firstUnitBitmap, RootTableSize / 8, uchar(0));
+    }
+
+    void addNeedle(const Char *needle, qsizetype length, qsizetype id)
+    {
+        Q_ASSERT(!built);
+        if (length <= 0)
+            return;
+
+        qint32 state = 0;
+        for (qsizetype i = 0; i < length; ++i) {
+            const Char c = needle[i];
+            QList<Edge> &edges = nodes[state].edges;
+            auto it = std::lower_bound(edges.begin(), edges.end(), c, edgeLessThan);
+            if (it != edges.end() && it->c == c) {
+                state = it->target;
+                continue;
+            }
+            const qint32 target = qint32(nodes.size());
+            edges.insert(it, Edge{ c, target });
+            Node node;
+            node.depth = qint32(i + 1);
+            nodes.append(node);
+            state = target;
+        }
+        maxDepth = qMax(maxDepth, length);
+        nodes[state].ids.append(id);
+        ++needles;
+    }
+
+    void build()
+    {
+        Q_ASSERT(!built);
+        built = true;
+
+        for (const Edge &e : qAsConst(nodes.first().edges)) {
+            if (uint(e.c) < RootTableSize) {
+                rootTable[uint(e.c)] = e.target;
+                firstUnitBitmap[uint(e.c) / 8] |= uchar(1u << (uint(e.c) % 8));
+            } else {
+                hasWideFirstUnits = true;
+            }
+        }
+
+        // breadth-first, so that the failure link of a node is final before
+        // the node's children are visited
+        QList<qint32> queue;
+        queue.reserve(nodes.size());
+        for (const Edge &e : qAsConst(nodes.first().edges))
+            queue.append(e.target);
+        for (qsizetype head = 0; head < queue.size(); ++head) {
+            const qint32 state = queue.at(head);
+            const QList<Edge> edges = nodes.at(state).edges;
+            for (const Edge &e : edges) {
+                qint32 fail = nodes.at(state).fail;
+                qint32 target;
+                while ((target = findEdge(fail, e.c)) < 0 && fail != 0)
+                    fail = nodes.at(fail).fail;
+                if (target < 0 || target == e.target)
+                    target = 0;
+                Node &child = nodes[e.target];
+                child.fail = target;
+                child.outputLink = nodes.at(target).ids.isEmpty()
+                        ? nodes.at(target).outputLink : target;
+                queue.append(e.target);
+            }
+        }
+    }
+
+    bool isEmpty() const noexcept { return needles == 0; }
+    qsizetype needleCount() const noexcept { return needles; }
+
+    qsizetype maximumNeedleLength() const noexcept { return maxDepth; }
+
+    // Whether \a c can start a needle; always true for code units that do
+    // not fit the root table if any needle starts with such a unit.
+    bool canStartNeedle(Char c) const noexcept
+    {
+        if (uint(c) < RootTableSize)
+            return firstUnitBitmap[uint(c) / 8] & (1u << (uint(c) % 8));
+        return hasWideFirstUnits;
+    }
+
+    // The distinct (folded) code units that needles start with, in ascending order.
+    QList<Char> startUnits() const
+    {
+        QList<Char> units;
+        units.reserve(nodes.first().edges.size());
+        for (const Edge &e : nodes.first().edges)
+            units.append(e.c);
+        return units;
+    }
+
+    /*
+        Feeds the \a length code units at \a haystack through the automaton.
+        Each code unit is transformed by \a fold, which is called with a
+        pointer to the code unit and \a haystack, so that it can look at the
+        preceding code units (for instance to fold surrogate pairs). For every occurrence of a needle, calls
+        \a onMatch with the offset of its first code unit and the needle's id,
+        in order of the occurrences' ends; scanning stops if \a onMatch returns
+        false. \a skip is called with the remaining haystack whenever the
+        automaton is in its initial state, and returns how many code units
+        cannot start a needle and can be skipped.
+    */
+    template <typename Fold, typename Skip, typename Callback>
+    void scan(const Char *haystack, qsizetype length, Fold fold, Skip skip, Callback onMatch) const
+    {
+        Q_ASSERT(built);
+        qint32 state = 0;
+        for (qsizetype i = 0; i < length; ++i) {
+            if (state == 0) {
+                i += skip(haystack + i, length - i);
+                if (i >= length)
+                    break;
+            }
+            state = next(state, fold(haystack + i, haystack));
+            const Node &node = nodes.at(state);
+            for (qint32 out = node.ids.isEmpty() ? node.outputLink : state; out > 0;
+                 out = nodes.at(out).outputLink) {
+                const Node &match = nodes.at(out);
+                for (qsizetype id : match.ids) {
+                    if (!onMatch(i + 1 - match.depth, id))
+                        return;
+                }
+            }
+        }
+    }
+
+    template <typename Fold, typename Callback>
+    void scan(const Char *haystack, qsizetype length, Fold fold, Callback onMatch) const
+    {
+        scan(haystack, length, fold, [](const Char *, qsizetype) { return qsizetype(0); },
+             onMatch);
+    }
+
+private:
+    static constexpr uint RootTableSize = 256;
+
+    struct Edge {
+        Char c;
+        qint32 target;
+    };
+    static bool edgeLessThan(const Edge &e, Char c) noexcept { return e.c < c; }
+
+    struct Node {
+        QList<Edge> edges;          // sorted by code unit
+        QList<qsizetype> ids;       // needles ending in this node
+        qint32 fail = 0;            // longest proper suffix that is in the trie
+        qint32 outputLink = -1;     // longest proper suffix that ends a needle
+        qint32 depth = 0;
+    };
+
+    qint32 findEdge(qint32 state, Char c) const noexcept
+    {
+        if (state == 0 && built && uint(c) < RootTableSize)
+            return rootTable[uint(c)] ? rootTable[uint(c)] : -1;
+        const QList<Edge> &edges = nodes.at(state).edges;
+        auto it = std::lower_bound(edges.cbegin(), edges.cend(), c, edgeLessThan);
+        return (it != edges.cend() && it->c == c) ? it->target : -1;
+    }
+
+    qint32 next(qint32 state, Char c) const noexcept
+    {
+        for (;;) {
+            const qint32 target = findEdge(state, c);
+            if (target >= 0)
+                return target;
+            if (state == 0)
+                return 0;
+            state = nodes.at(state).fail;
+        }
+    }
+
+    QList<Node> nodes;
+    qint32 rootTable[RootTableSize];
+    uchar firstUnitBitmap[RootTableSize / 8];
+    qsizetype needles = 0;
+    qsizetype maxDepth = 0;
+    bool hasWideFirstUnits = false;
+    bool built = false;
+};
+
+/*
+    Finds the first code unit in a haystack that can start a needle, to skip
+    over the parts of the haystack in which the automaton would stay in its
+    initial state. Up to MaximumVectorUnits distinct units are searched for
+    with SSE2 comparisons, sixteen bytes at a time; larger sets use a bitmap.
+    A default-constructed filter never skips anything.
+*/
+template <typename Char>
+class AhoCorasickStartFilter
+{
+public:
+    // \a rawUnits are all the unfolded code units that can start a needle
+    void setUnits(const QList<Char> &rawUnits)
+    {
+        enabled = true;
+        neverStarts = rawUnits.isEmpty();
+        unitCount = 0;
+        hasWideUnits = false;
+        std::fill_n(bitmap, sizeof(bitmap), uchar(0));
+        for (Char c : rawUnits) {
+            if (uint(c) < 256)
+                bitmap[uint(c) / 8] |= uchar(1u << (uint(c) % 8));
+            else
+                hasWideUnits = true;
+        }
+        if (rawUnits.size() <= MaximumVectorUnits) {
+            unitCount = int(rawUnits.size());
+            std::copy(rawUnits.cbegin(), rawUnits.cend(), units);
+        }
+    }
+
+    // Returns how many code units at the start of \a data cannot start a needle.
+    qsizetype skip(const Char *data, qsizetype length) const noexcept
+    {
+        if (!enabled)
+            return 0;
+        if (neverStarts)
+            return length;
+        qsizetype i = 0;
+#ifdef __SSE2__
+        if (unitCount > 0) {
+            constexpr qsizetype Stride = 16 / sizeof(Char);
+            __m128i needles[MaximumVectorUnits];
+            for (int n = 0; n < unitCount; ++n)
+                needles[n] = broadcast(units[n]);
+            for ( ; i + Stride <= length; i += Stride) {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+                __m128i found = compare(chunk, needles[0]);
+                for (int n = 1; n < unitCount; ++n)
+                    found = _mm_or_si128(found, compare(chunk, needles[n]));
+                if (const uint mask = uint(_mm_movemask_epi8(found)))
+                    return i + qCountTrailingZeroBits(mask) / sizeof(Char);
+            }
+        }
+#endif
+        for ( ; i < length; ++i) {
+            if (canStart(data[i]))
+                return i;
+        }
+        return length;
+    }
+
+private:
+    static constexpr int MaximumVectorUnits = 4;
+
+    bool canStart(Char c) const noexcept
+    {
+        if (uint(c) < 256)
+            return bitmap[uint(c) / 8] & (1u << (uint(c) % 8));
+        if (!hasWideUnits)
+            return false;
+        if (unitCount == 0)
+            return true;
+        return std::find(units, units + unitCount, c) != units + unitCount;
+    }
+
+#ifdef __SSE2__
+    static __m128i broadcast(Char c) noexcept
+    {
+        if constexpr (sizeof(Char) == 1)
+            return _mm_set1_epi8(char(c));
+        else
+            return _mm_set1_epi16(short(c));
+    }
+    static __m128i compare(__m128i a, __m128i b) noexcept
+    {
+        if constexpr (sizeof(Char) == 1)
+            return _mm_cmpeq_epi8(a, b);
+        else
+            return _mm_cmpeq_epi16(a, b);
+    }
+#endif
+
+    Char units[MaximumVectorUnits] = {};
+    int unitCount = 0;
+    uchar bitmap[256 / 8] = {};
+    bool hasWideUnits = false;
+    bool neverStarts = false;
+    bool enabled = false;
+};
+
+/*
+    Returns the position in \a haystack of the leftmost occurrence, at or
+    after \a from, of any of the needles of \a automaton, whose lengths are
+    given by \a needleLengths indexed by needle id; among the needles that
+    occur at that position, the one with the lowest id is reported in
+    \a needleId. Returns -1 if no needle occurs.
+*/
+template <typename Char, typename Fold>
+qsizetype ahoCorasickIndexIn(const AhoCorasickAutomaton<Char> &automaton,
+                             const AhoCorasickStartFilter<Char> &filter,
+                             const QList<qsizetype> &needleLengths,
+                             const Char *haystack, qsizetype length, qsizetype from,
+                             Fold fold, qsizetype *needleId)
+{
+    if (from < 0)
+        from = qMax(from + length, qsizetype(0));
+    if (from > length || automaton.isEmpty())
+        return -1;
+    haystack += from;
+    length -= from;
+
+    const auto skip = [&filter](const Char *data, qsizetype n) { return filter.skip(data, n); };
+    qsizetype bestPosition = -1;
+    qsizetype bestId = -1;
+    qsizetype firstEnd = 0;
+    automaton.scan(haystack, length, fold, skip, [&](qsizetype position, qsizetype id) {
+        bestPosition = position;
+        bestId = id;
+        firstEnd = position + needleLengths.at(id);
+        return false;
+    });
+    if (bestPosition < 0)
+        return -1;
+
+    // Occurrences are reported in order of their ends, so a longer needle
+    // starting further left may end after the first occurrence found. Such
+    // an occurrence ends at or after firstEnd and before
+    // bestPosition + maximumNeedleLength(), so rescan just that window.
+    const qsizetype maxLength = automaton.maximumNeedleLength();
+    const qsizetype windowStart = qMax(firstEnd - maxLength, qsizetype(0));
+    const qsizetype windowEnd = qMin(bestPosition + maxLength, length);
+    automaton.scan(haystack + windowStart, windowEnd - windowStart, fold, skip,
+                   [&](qsizetype position, qsizetype id) {
+        position += windowStart;
+        if (position < bestPosition || (position == bestPosition && id < bestId)) {
+            bestPosition = position;
+            bestId = id;
+        }
+        return true;
+    });
+
+    if (needleId)
+        *needleId = bestId;
+    return from + bestPosition;
+}
+
+/*
+    Calls \a onMatch(position, id) for every occurrence in \a haystack of
+    the needles of \a automaton, including overlapping ones.
+*/
+template <typename Char, typename Fold, typename Callback>
+void ahoCorasickForEachMatch(const AhoCorasickAutomaton<Char> &automaton,
+                             const AhoCorasickStartFilter<Char> &filter,
+                             const Char *haystack, qsizetype length,
+                             Fold fold, Callback onMatch)
+{
+    if (automaton.isEmpty())
+        return;
+    const auto skip = [&filter](const Char *data, qsizetype n) { return filter.skip(data, n); };
+    automaton.scan(haystack, length, fold, skip, [&](qsizetype position, qsizetype id) {
+        onMatch(position, id);
+        return true;
+    });
+}
+
+} // namespace QtPrivate
+
+QT_END_NAMESPACE
+
+#endif // QAHOCORASICK_P_H
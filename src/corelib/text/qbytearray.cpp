@@ -46,6 +46,7 @@
 #include "qlist.h"
 #include "qlocale_p.h"
 #include "qlocale_tools_p.h"
+#include "qfloatconversion_p.h"
 #include "private/qnumeric_p.h"
 #include "private/qsimd_p.h"
 #include "qstringalgorithms_p.h"
@@ -3924,10 +3925,100 @@ QByteArray &QByteArray::setNum(double n, char f, int prec)
             break;
     }
 
+    if (form == QLocaleData::DFSignificantDigits && prec == QLocale::FloatingPointShortest) {
+        char buf[QtShortestDoubleBufferSize];
+        const int length = qt_doubleToShortestCLocale(n, buf, flags & QLocaleData::CapitalEorX);
+        *this = QByteArray(buf, length);
+        return *this;
+    }
+
     *this = QLocaleData::c()->doubleToString(n, prec, form, -1, flags).toUtf8();
     return *this;
 }
 
+/*!
+    \since 6.0
+
+    Appends the \a count doubles at \a values to this byte array, separated
+    by \a separator, and returns a reference to this byte array. Each value
+    is formatted as number(value, 'g', QLocale::FloatingPointShortest)
+    would, that is with the fewest digits that convert back to the same
+    value; no separator is appended after the last value.
+
+    This is meant for writing columns of numbers, for instance in CSV or
+    JSON documents: the byte array grows at most a few times, instead of
+    once per value as when appending the result of number().
+
+    \note The format of the numbers is not localized; the default C locale
+    is used regardless of the user's locale.
+
+    \sa number(), parseDoubles()
+*/
+QByteArray &QByteArray::appendDoubles(const double *values, qsizetype count, char separator)
+{
+    if (count <= 0)
+        return *this;
+    reserve(size() + count * 8);
+    char buf[QtShortestDoubleBufferSize];
+    for (qsizetype i = 0; i < count; ++i) {
+        const int length = qt_doubleToShortestCLocale(values[i], buf);
+        if (i)
+            append(separator);
+        append(buf, length);
+    }
+    return *this;
+}
+
+/*!
+    \since 6.0
+
+    Parses the numbers in \a column, separated by \a separator, into the
+    array \a values, which has room for \a maxCount doubles, and returns
+    the number of values stored. Each field is converted as toDouble()
+    would; in particular, whitespace around the numbers is ignored, which
+    allows for \c{"\r\n"} line endings when \a separator is \c{'\n'}. A
+    separator at the very end of \a column does not start another field.
+
+    If \a ok is not \nullptr, \c{*ok} is set to \c false if a field could
+    not be converted, and to \c true otherwise. Parsing stops at the first
+    field that cannot be converted and at \a maxCount values; the values
+    before it are stored.
+
+    This is meant for reading columns of numbers, for instance from CSV
+    files: unlike splitting \a column and calling toDouble() on the parts,
+    it does not allocate memory.
+
+    \note The conversion is not localized; the default C locale is used
+    regardless of the user's locale.
+
+    \sa toDouble(), appendDoubles()
+*/
+qsizetype QByteArray::parseDoubles(QByteArrayView column, double *values, qsizetype maxCount,
+                                   char separator, bool *ok)
+{
+    const char *p = column.data();
+    const char *const end = p + column.size();
+    qsizetype count = 0;
+    bool allOk = true;
+    while (p != end && count < maxCount) {
+        const char *fieldEnd = static_cast<const char *>(memchr(p, separator, end - p));
+        if (!fieldEnd)
+            fieldEnd = end;
+        bool fieldOk = false;
+        int processed = 0;
+        const double d = qt_asciiToDouble(p, fieldEnd - p, fieldOk, processed, WhitespacesAllowed);
+        if (!fieldOk) {
+            allOk = false;
+            break;
+        }
+        values[count++] = d;
+        p = fieldEnd == end ? end : fieldEnd + 1;
+    }
+    if (ok)
+        *ok = allOk;
+    return count;
+}
+
 /*!
     \fn QByteArray &QByteArray::setNum(float n, char f, int prec)
     \overload
@@ -368,6 +368,10 @@ public:
     QByteArray &setNum(double, char f = 'g', int prec = 6);
     QByteArray &setRawData(const char *a, qsizetype n);
 
+    QByteArray &appendDoubles(const double *values, qsizetype count, char separator = '\n');
+    static qsizetype parseDoubles(QByteArrayView column, double *values, qsizetype maxCount,
+                                  char separator = '\n', bool *ok = nullptr);
+
     Q_REQUIRED_RESULT static QByteArray number(int, int base = 10);
     Q_REQUIRED_RESULT static QByteArray number(uint, int base = 10);
     Q_REQUIRED_RESULT static QByteArray number(long, int base = 10);
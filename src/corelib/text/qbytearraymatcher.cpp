@@ -38,7 +38,11 @@
 ****************************************************************************/
 
 #include "qbytearraymatcher.h"
+#include "qahocorasick_p.h"
 
+#include <QtCore/qvarlengtharray.h>
+
+#include <algorithm>
 #include <limits.h>
 
 QT_BEGIN_NAMESPACE
@@ -322,6 +326,284 @@ qsizetype qFindByteArray(
     return -1;
 }
 
+namespace {
+// Latin-1 case folding that stays within Latin-1: the letters of
+// U+0041..U+005A and U+00C0..U+00DE, except U+00D7, map to their lowercase
+// counterparts; everything else, including U+00B5 and U+00DF, maps to itself.
+struct Latin1FoldTable
+{
+    uchar data[256];
+
+    constexpr Latin1FoldTable() : data()
+    {
+        for (uint c = 0; c < 256; ++c) {
+            const bool upper = (c >= 'A' && c <= 'Z') || (c >= 0xc0 && c <= 0xde && c != 0xd7);
+            data[c] = uchar(upper ? c + 0x20 : c);
+        }
+    }
+};
+constexpr Latin1FoldTable latin1Fold;
+} // unnamed namespace
+
+class QMultiByteArrayMatcherPrivate : public QSharedData
+{
+public:
+    void build();
+
+    QList<QByteArray> needles;
+    Qt::CaseSensitivity cs = Qt::CaseSensitive;
+
+    QList<qsizetype> needleLengths;
+    QtPrivate::AhoCorasickAutomaton<uchar> automaton;
+    QtPrivate::AhoCorasickStartFilter<uchar> startFilter;
+};
+
+void QMultiByteArrayMatcherPrivate::build()
+{
+    automaton = QtPrivate::AhoCorasickAutomaton<uchar>();
+    needleLengths.clear();
+    needleLengths.reserve(needles.size());
+
+    QVarLengthArray<uchar, 256> folded;
+    for (qsizetype i = 0; i < needles.size(); ++i) {
+        const QByteArray &needle = needles.at(i);
+        const uchar *data = reinterpret_cast<const uchar *>(needle.constData());
+        needleLengths.append(needle.size());
+        if (cs == Qt::CaseSensitive) {
+            automaton.addNeedle(data, needle.size(), i);
+        } else {
+            folded.resize(needle.size());
+            std::transform(data, data + needle.size(), folded.begin(),
+                           [](uchar c) { return latin1Fold.data[c]; });
+            automaton.addNeedle(folded.constData(), folded.size(), i);
+        }
+    }
+    automaton.build();
+
+    // the start filter looks at the unfolded haystack
+    QList<uchar> startBytes;
+    for (uint c = 0; c < 256; ++c) {
+        const uchar folded = cs == Qt::CaseSensitive ? uchar(c) : latin1Fold.data[c];
+        if (automaton.canStartNeedle(folded))
+            startBytes.append(uchar(c));
+    }
+    startFilter.setUnits(startBytes);
+}
+
+/*!
+    \class QMultiByteArrayMatcher
+    \inmodule QtCore
+    \since 6.0
+    \brief The QMultiByteArrayMatcher class finds any of a set of byte
+    arrays in a byte array in a single pass.
+
+    \ingroup tools
+    \ingroup string-processing
+    \ingroup shared
+    \reentrant
+
+    Searching a buffer for any of a large number of keywords with one
+    QByteArrayMatcher per keyword needs one pass over the buffer for every
+    keyword. QMultiByteArrayMatcher compiles all the keywords, called
+    needles, into a single Aho-Corasick automaton, so that one pass over the
+    buffer finds the occurrences of all needles, independently of how many
+    there are. Stretches of the buffer that cannot start any needle are
+    skipped quickly, using SIMD instructions when only a few distinct bytes
+    start the needles.
+
+    matches() returns every occurrence of every needle, including
+    overlapping ones, together with the index of the needle in needles().
+    indexIn() returns the leftmost occurrence only:
+
+    \snippet code/src_corelib_text_qbytearraymatcher.cpp 2
+
+    If the case sensitivity is set to Qt::CaseInsensitive, the ASCII
+    letters and the letters of the Latin-1 Supplement are matched case
+    insensitively. Empty needles never match.
+
+    \sa QByteArrayMatcher, QMultiStringMatcher
+*/
+
+/*!
+    \class QMultiByteArrayMatcher::Match
+    \inmodule QtCore
+    \since 6.0
+    \brief The Match struct describes an occurrence of a needle found by
+    QMultiByteArrayMatcher.
+
+    \variable QMultiByteArrayMatcher::Match::position
+    The position of the first byte of the occurrence in the haystack.
+
+    \variable QMultiByteArrayMatcher::Match::needleIndex
+    The index in QMultiByteArrayMatcher::needles() of the needle that
+    occurred.
+*/
+
+/*!
+    Constructs an empty multi-needle matcher that won't match anything.
+    Call setNeedles() to give it some needles to match.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher()
+    : d(new QMultiByteArrayMatcherPrivate)
+{
+    d->build();
+}
+
+/*!
+    Constructs a matcher that searches for any of the given \a needles,
+    with case sensitivity \a cs.
+
+    \sa setNeedles(), setCaseSensitivity()
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher(const QList<QByteArray> &needles,
+                                               Qt::CaseSensitivity cs)
+    : d(new QMultiByteArrayMatcherPrivate)
+{
+    d->needles = needles;
+    d->cs = cs;
+    d->build();
+}
+
+/*!
+    Copies the \a other matcher to this matcher.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher(const QMultiByteArrayMatcher &other)
+    : d(other.d)
+{
+}
+
+/*!
+    Destroys the matcher.
+*/
+QMultiByteArrayMatcher::~QMultiByteArrayMatcher()
+{
+}
+
+/*!
+    Assigns the \a other matcher to this matcher.
+*/
+QMultiByteArrayMatcher &QMultiByteArrayMatcher::operator=(const QMultiByteArrayMatcher &other)
+{
+    d = other.d;
+    return *this;
+}
+
+/*!
+    \fn QMultiByteArrayMatcher &QMultiByteArrayMatcher::operator=(QMultiByteArrayMatcher &&other)
+
+    Move-assigns \a other to this matcher.
+*/
+
+/*!
+    \fn void QMultiByteArrayMatcher::swap(QMultiByteArrayMatcher &other)
+
+    Swaps the matcher \a other with this matcher. This operation is very
+    fast and never fails.
+*/
+
+/*!
+    Returns the needles this matcher searches for.
+
+    \sa setNeedles()
+*/
+QList<QByteArray> QMultiByteArrayMatcher::needles() const
+{
+    return d->needles;
+}
+
+/*!
+    Sets the needles to search for to \a needles. The needle indexes
+    reported by indexIn() and matches() are indexes into this list.
+
+    \sa needles()
+*/
+void QMultiByteArrayMatcher::setNeedles(const QList<QByteArray> &needles)
+{
+    d.detach();
+    d->needles = needles;
+    d->build();
+}
+
+/*!
+    Returns the case sensitivity of this matcher.
+
+    \sa setCaseSensitivity()
+*/
+Qt::CaseSensitivity QMultiByteArrayMatcher::caseSensitivity() const
+{
+    return d->cs;
+}
+
+/*!
+    Sets the case sensitivity of this matcher to \a cs.
+
+    \sa caseSensitivity()
+*/
+void QMultiByteArrayMatcher::setCaseSensitivity(Qt::CaseSensitivity cs)
+{
+    if (d->cs == cs)
+        return;
+    d.detach();
+    d->cs = cs;
+    d->build();
+}
+
+/*!
+    Searches \a haystack, from byte position \a from, for the leftmost
+    occurrence of any of the needles. A negative \a from counts from the
+    end of \a haystack.
+
+    Returns the position of the occurrence, or -1 if no needle occurs. If
+    \a needleIndex is not \nullptr, the index of the needle is stored in
+    it; if several needles occur at the returned position, the lowest index
+    is stored.
+
+    \sa matches()
+*/
+qsizetype QMultiByteArrayMatcher::indexIn(QByteArrayView haystack, qsizetype from,
+                                          qsizetype *needleIndex) const
+{
+    const uchar *data = reinterpret_cast<const uchar *>(haystack.data());
+    if (d->cs == Qt::CaseSensitive) {
+        const auto identity = [](const uchar *c, const uchar *) { return *c; };
+        return QtPrivate::ahoCorasickIndexIn(d->automaton, d->startFilter, d->needleLengths,
+                                             data, haystack.size(), from, identity, needleIndex);
+    }
+    const auto fold = [](const uchar *c, const uchar *) { return latin1Fold.data[*c]; };
+    return QtPrivate::ahoCorasickIndexIn(d->automaton, d->startFilter, d->needleLengths,
+                                         data, haystack.size(), from, fold, needleIndex);
+}
+
+/*!
+    Returns all the occurrences of all the needles in \a haystack,
+    including overlapping ones, ordered by position. Occurrences at the same
+    position are ordered by needle index.
+
+    \sa indexIn()
+*/
+QList<QMultiByteArrayMatcher::Match> QMultiByteArrayMatcher::matches(QByteArrayView haystack) const
+{
+    QList<Match> result;
+    const auto append = [&result](qsizetype position, qsizetype id) {
+        result.append(Match{ position, id });
+    };
+    const uchar *data = reinterpret_cast<const uchar *>(haystack.data());
+    if (d->cs == Qt::CaseSensitive) {
+        const auto identity = [](const uchar *c, const uchar *) { return *c; };
+        QtPrivate::ahoCorasickForEachMatch(d->automaton, d->startFilter, data, haystack.size(),
+                                           identity, append);
+    } else {
+        const auto fold = [](const uchar *c, const uchar *) { return latin1Fold.data[*c]; };
+        QtPrivate::ahoCorasickForEachMatch(d->automaton, d->startFilter, data, haystack.size(),
+                                           fold, append);
+    }
+    std::sort(result.begin(), result.end(), [](Match lhs, Match rhs) {
+        return lhs.position < rhs.position
+                || (lhs.position == rhs.position && lhs.needleIndex < rhs.needleIndex);
+    });
+    return result;
+}
+
 /*!
     \class QStaticByteArrayMatcherBase
     \since 5.9
@@ -41,6 +41,8 @@
 #define QBYTEARRAYMATCHER_H
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qshareddata.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -83,6 +85,48 @@ private:
     };
 };
 
+class QMultiByteArrayMatcherPrivate;
+
+class Q_CORE_EXPORT QMultiByteArrayMatcher
+{
+public:
+    struct Match {
+        qsizetype position;
+        qsizetype needleIndex;
+
+        friend constexpr bool operator==(Match lhs, Match rhs) noexcept
+        { return lhs.position == rhs.position && lhs.needleIndex == rhs.needleIndex; }
+        friend constexpr bool operator!=(Match lhs, Match rhs) noexcept
+        { return !(lhs == rhs); }
+    };
+
+    QMultiByteArrayMatcher();
+    explicit QMultiByteArrayMatcher(const QList<QByteArray> &needles,
+                                    Qt::CaseSensitivity cs = Qt::CaseSensitive);
+    QMultiByteArrayMatcher(const QMultiByteArrayMatcher &other);
+    ~QMultiByteArrayMatcher();
+    QMultiByteArrayMatcher &operator=(const QMultiByteArrayMatcher &other);
+    QMultiByteArrayMatcher &operator=(QMultiByteArrayMatcher &&other) noexcept
+    { d.swap(other.d); return *this; }
+    void swap(QMultiByteArrayMatcher &other) noexcept { d.swap(other.d); }
+
+    QList<QByteArray> needles() const;
+    void setNeedles(const QList<QByteArray> &needles);
+
+    Qt::CaseSensitivity caseSensitivity() const;
+    void setCaseSensitivity(Qt::CaseSensitivity cs);
+
+    qsizetype indexIn(QByteArrayView haystack, qsizetype from = 0,
+                      qsizetype *needleIndex = nullptr) const;
+    QList<Match> matches(QByteArrayView haystack) const;
+
+private:
+    QSharedDataPointer<QMultiByteArrayMatcherPrivate> d;
+};
+
+Q_DECLARE_SHARED(QMultiByteArrayMatcher)
+Q_DECLARE_TYPEINFO(QMultiByteArrayMatcher::Match, Q_PRIMITIVE_TYPE);
+
 class QStaticByteArrayMatcherBase
 {
     alignas(16)
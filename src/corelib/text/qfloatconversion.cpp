@@ -0,0 +1,558 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Copyright (C) 2016 Intel Corporation.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qfloatconversion_p.h"
+#include "qfloatconversiontables_p.h"
+
+#include <QtCore/qalgorithms.h>
+#include <QtCore/private/qnumeric_p.h>
+
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Shortest round-trip formatting follows Ulf Adams' Ryū ("Ryū: fast
+    float-to-string conversion", PLDI 2018, reference implementation under
+    the Apache License 2.0 or the Boost Software License 1.0), using the
+    full 128-bit lookup tables. Parsing uses the algorithm by Michael
+    Eisel and Daniel Lemire ("Number Parsing at a Gigabyte per Second",
+    2021), preceded by Clinger's fast path for exactly representable
+    operands. Inputs the latter cannot decide are left to the general
+    conversion in qlocale_tools.cpp.
+*/
+
+namespace {
+
+using QFloatConversionTables::UInt128;
+
+constexpr int DoubleMantissaBits = 52;
+constexpr int DoubleExponentBits = 11;
+constexpr int DoubleBias = 1023;
+
+inline UInt128 multiply(quint64 a, quint64 b) noexcept
+{
+#ifdef __SIZEOF_INT128__
+    __extension__ const unsigned __int128 product = (unsigned __int128)a * b;
+    return { quint64(product), quint64(product >> 64) };
+#else
+    const quint64 aLow = quint32(a), aHigh = a >> 32;
+    const quint64 bLow = quint32(b), bHigh = b >> 32;
+    const quint64 lowLow = aLow * bLow;
+    const quint64 lowHigh = aLow * bHigh;
+    const quint64 highLow = aHigh * bLow;
+    const quint64 highHigh = aHigh * bHigh;
+    const quint64 middle = (lowLow >> 32) + quint32(lowHigh) + quint32(highLow);
+    return { (middle << 32) | quint32(lowLow),
+             highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32) };
+#endif
+}
+
+inline quint64 doubleToBits(double d) noexcept
+{
+    quint64 bits;
+    memcpy(&bits, &d, sizeof(bits));
+    return bits;
+}
+
+inline double bitsToDouble(quint64 bits) noexcept
+{
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+//
+// Ryū
+//
+
+// Returns e == 0 ? 1 : ceil(log_2(5^e)), for 0 <= e <= 3528
+inline int pow5bits(int e) noexcept
+{
+    return int((uint(e) * 1217359) >> 19) + 1;
+}
+
+// Returns floor(log_10(2^e)), for 0 <= e <= 1650
+inline uint log10Pow2(int e) noexcept
+{
+    return (uint(e) * 78913) >> 18;
+}
+
+// Returns floor(log_10(5^e)), for 0 <= e <= 2620
+inline uint log10Pow5(int e) noexcept
+{
+    return (uint(e) * 732923) >> 20;
+}
+
+inline uint pow5Factor(quint64 value) noexcept
+{
+    uint count = 0;
+    for (;;) {
+        const quint64 q = value / 5;
+        if (value != 5 * q)
+            break;
+        value = q;
+        ++count;
+    }
+    return count;
+}
+
+inline bool multipleOfPowerOf5(quint64 value, uint p) noexcept
+{
+    return pow5Factor(value) >= p;
+}
+
+inline bool multipleOfPowerOf2(quint64 value, uint p) noexcept
+{
+    return (value & ((quint64(1) << p) - 1)) == 0;
+}
+
+inline quint64 mulShift64(quint64 m, const UInt128 &mul, int j) noexcept
+{
+    const UInt128 low = multiply(m, mul.low);
+    const UInt128 high = multiply(m, mul.high);
+    // (low.high + high) >> (j - 64), with the 128-bit sum
+    const quint64 sumLow = high.low + low.high;
+    const quint64 sumHigh = high.high + (sumLow < high.low);
+    const int shift = j - 64;
+    Q_ASSERT(shift > 0 && shift < 64);
+    return (sumHigh << (64 - shift)) | (sumLow >> shift);
+}
+
+inline int decimalLength17(quint64 v) noexcept
+{
+    Q_ASSERT(v < Q_UINT64_C(100000000000000000));
+    int length = 1;
+    for (quint64 bound = 10; length < 17 && v >= bound; bound *= 10)
+        ++length;
+    return length;
+}
+
+struct DecimalDouble {
+    quint64 mantissa;
+    int exponent;
+};
+
+DecimalDouble shortestDecimal(quint64 ieeeMantissa, uint ieeeExponent) noexcept
+{
+    int e2;
+    quint64 m2;
+    if (ieeeExponent == 0) {
+        // subtract 2 so that the bounds computation has 2 additional bits
+        e2 = 1 - DoubleBias - DoubleMantissaBits - 2;
+        m2 = ieeeMantissa;
+    } else {
+        e2 = int(ieeeExponent) - DoubleBias - DoubleMantissaBits - 2;
+        m2 = (quint64(1) << DoubleMantissaBits) | ieeeMantissa;
+    }
+    const bool even = (m2 & 1) == 0;
+    const bool acceptBounds = even;
+
+    // the interval of valid decimal representations, scaled by 4
+    const quint64 mv = 4 * m2;
+    const uint mmShift = ieeeMantissa != 0 || ieeeExponent <= 1;
+
+    // convert to a decimal power base
+    quint64 vr, vp, vm;
+    int e10;
+    bool vmIsTrailingZeros = false;
+    bool vrIsTrailingZeros = false;
+    if (e2 >= 0) {
+        const uint q = log10Pow2(e2) - (e2 > 3);
+        e10 = int(q);
+        const int k = QFloatConversionTables::DoublePow5InvBitCount + pow5bits(int(q)) - 1;
+        const int i = -e2 + int(q) + k;
+        const UInt128 &mul = QFloatConversionTables::DoublePow5InvSplit[q];
+        vr = mulShift64(4 * m2, mul, i);
+        vp = mulShift64(4 * m2 + 2, mul, i);
+        vm = mulShift64(4 * m2 - 1 - mmShift, mul, i);
+        if (q <= 21) {
+            // only one of mp, mv and mm can be a multiple of 5, if any
+            if (mv % 5 == 0)
+                vrIsTrailingZeros = multipleOfPowerOf5(mv, q);
+            else if (acceptBounds)
+                vmIsTrailingZeros = multipleOfPowerOf5(mv - 1 - mmShift, q);
+            else
+                vp -= multipleOfPowerOf5(mv + 2, q);
+        }
+    } else {
+        const uint q = log10Pow5(-e2) - (-e2 > 1);
+        e10 = int(q) + e2;
+        const int i = -e2 - int(q);
+        const int k = pow5bits(i) - QFloatConversionTables::DoublePow5BitCount;
+        const int j = int(q) - k;
+        const UInt128 &mul = QFloatConversionTables::DoublePow5Split[i];
+        vr = mulShift64(4 * m2, mul, j);
+        vp = mulShift64(4 * m2 + 2, mul, j);
+        vm = mulShift64(4 * m2 - 1 - mmShift, mul, j);
+        if (q <= 1) {
+            // {vr,vp,vm} is trailing zeros if {mv,mp,mm} has at least q
+            // trailing 0 bits; mv = 4 * m2 always has at least two
+            vrIsTrailingZeros = true;
+            if (acceptBounds)
+                vmIsTrailingZeros = mmShift == 1;
+            else
+                --vp;
+        } else if (q < 63) {
+            vrIsTrailingZeros = multipleOfPowerOf2(mv, q);
+        }
+    }
+
+    // find the shortest decimal representation in the interval
+    int removed = 0;
+    quint64 output;
+    if (vmIsTrailingZeros || vrIsTrailingZeros) {
+        // the general case, which happens rarely (~0.7%)
+        uint lastRemovedDigit = 0;
+        while (vp / 10 > vm / 10) {
+            vmIsTrailingZeros &= vm % 10 == 0;
+            vrIsTrailingZeros &= lastRemovedDigit == 0;
+            lastRemovedDigit = uint(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            ++removed;
+        }
+        if (vmIsTrailingZeros) {
+            while (vm % 10 == 0) {
+                vrIsTrailingZeros &= lastRemovedDigit == 0;
+                lastRemovedDigit = uint(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                ++removed;
+            }
+        }
+        if (vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0) {
+            // round to even if the exact number is .....50..0
+            lastRemovedDigit = 4;
+        }
+        // take vr + 1 if vr is outside the bounds or needs rounding up
+        output = vr + ((vr == vm && (!acceptBounds || !vmIsTrailingZeros)) || lastRemovedDigit >= 5);
+    } else {
+        // the common case (~99.3%)
+        bool roundUp = false;
+        if (vp / 100 > vm / 100) {
+            // remove two digits at a time (~86.2%)
+            roundUp = vr % 100 >= 50;
+            vr /= 100;
+            vp /= 100;
+            vm /= 100;
+            removed += 2;
+        }
+        while (vp / 10 > vm / 10) {
+            roundUp = vr % 10 >= 5;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            ++removed;
+        }
+        output = vr + (vr == vm || roundUp);
+    }
+    return { output, e10 + removed };
+}
+
+//
+// Eisel-Lemire
+//
+
+constexpr double exactPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+} // unnamed namespace
+
+int qt_doubleToShortestDigits(double d, char *digits, int &decpt) noexcept
+{
+    const quint64 bits = doubleToBits(d);
+    const quint64 ieeeMantissa = bits & ((quint64(1) << DoubleMantissaBits) - 1);
+    const uint ieeeExponent = uint(bits >> DoubleMantissaBits) & ((1u << DoubleExponentBits) - 1);
+    Q_ASSERT(ieeeExponent != (1u << DoubleExponentBits) - 1); // not inf or nan
+
+    if (ieeeExponent == 0 && ieeeMantissa == 0) {
+        digits[0] = '0';
+        decpt = 1;
+        return 1;
+    }
+
+    DecimalDouble decimal = shortestDecimal(ieeeMantissa, ieeeExponent);
+    while (decimal.mantissa % 10 == 0) {
+        decimal.mantissa /= 10;
+        ++decimal.exponent;
+    }
+    const int length = decimalLength17(decimal.mantissa);
+    for (int i = length - 1; i >= 0; --i) {
+        digits[i] = char('0' + decimal.mantissa % 10);
+        decimal.mantissa /= 10;
+    }
+    decpt = decimal.exponent + length;
+    return length;
+}
+
+int qt_doubleToShortestCLocale(double d, char *buf, bool capitalEorX, int minExponentDigits) noexcept
+{
+    char *out = buf;
+    const auto append = [&out, capitalEorX](const char *lower, const char *upper) {
+        for (const char *s = capitalEorX ? upper : lower; *s; ++s)
+            *out++ = *s;
+    };
+    if (qt_is_nan(d)) {
+        append("nan", "NAN");
+        return int(out - buf);
+    }
+    // like QLocaleData::doubleToString(), no sign for negative zero
+    if (std::signbit(d) && d != 0)
+        *out++ = '-';
+    if (qt_is_inf(d)) {
+        append("inf", "INF");
+        return int(out - buf);
+    }
+
+    char digits[17];
+    int decpt;
+    const int digitCount = qt_doubleToShortestDigits(d, digits, decpt);
+
+    // same choice between decimal and exponent form as in doubleToString()
+    int bias = 2 + minExponentDigits;
+    if (decpt > 10 && minExponentDigits == 1)
+        ++bias;
+    if (digitCount <= decpt && digitCount > 1)
+        ++bias;
+    else if (digitCount == 1 && decpt <= 0)
+        --bias;
+    const bool useDecimal = decpt <= 0 ? 1 - decpt <= bias
+                          : decpt <= digitCount ? 0 <= bias
+                          : decpt <= digitCount + bias;
+
+    if (useDecimal) {
+        if (decpt <= 0) {
+            *out++ = '0';
+            *out++ = '.';
+            for (int i = decpt; i < 0; ++i)
+                *out++ = '0';
+            memcpy(out, digits, digitCount);
+            out += digitCount;
+        } else if (decpt >= digitCount) {
+            memcpy(out, digits, digitCount);
+            out += digitCount;
+            for (int i = digitCount; i < decpt; ++i)
+                *out++ = '0';
+        } else {
+            memcpy(out, digits, decpt);
+            out += decpt;
+            *out++ = '.';
+            memcpy(out, digits + decpt, digitCount - decpt);
+            out += digitCount - decpt;
+        }
+    } else {
+        *out++ = digits[0];
+        if (digitCount > 1) {
+            *out++ = '.';
+            memcpy(out, digits + 1, digitCount - 1);
+            out += digitCount - 1;
+        }
+        *out++ = capitalEorX ? 'E' : 'e';
+        int exponent = decpt - 1;
+        *out++ = exponent < 0 ? '-' : '+';
+        exponent = qAbs(exponent);
+        char exponentDigits[3];
+        int exponentLength = 0;
+        do {
+            exponentDigits[exponentLength++] = char('0' + exponent % 10);
+            exponent /= 10;
+        } while (exponent);
+        for (int i = exponentLength; i < minExponentDigits; ++i)
+            *out++ = '0';
+        while (exponentLength)
+            *out++ = exponentDigits[--exponentLength];
+    }
+    Q_ASSERT(out - buf <= QtShortestDoubleBufferSize);
+    return int(out - buf);
+}
+
+bool qt_decimalToDouble(quint64 w, int q, bool negative, double &result) noexcept
+{
+    if (w == 0) {
+        result = negative ? -0.0 : 0.0;
+        return true;
+    }
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    // Clinger: both operands are exact, so is the correctly rounded result
+    if (q >= -22 && q <= 22 && w <= (quint64(1) << 53)) {
+        double d = double(w);
+        if (q < 0)
+            d /= exactPowersOfTen[-q];
+        else
+            d *= exactPowersOfTen[q];
+        result = negative ? -d : d;
+        return true;
+    }
+#endif
+
+    // out of range: the result is zero or infinity, which the callers
+    // report as underflow or overflow
+    if (q < QFloatConversionTables::SmallestPowerOfFive
+            || q > QFloatConversionTables::LargestPowerOfFive) {
+        return false;
+    }
+
+    const int lz = qCountLeadingZeroBits(w);
+    w <<= lz;
+
+    // w * 5^q, truncated to the 64 + 55 bits needed to round correctly
+    const UInt128 &power = QFloatConversionTables::PowersOfFive[q - QFloatConversionTables::SmallestPowerOfFive];
+    UInt128 product = multiply(w, power.high);
+    constexpr quint64 PrecisionMask = ~quint64(0) >> (DoubleMantissaBits + 3);
+    if ((product.high & PrecisionMask) == PrecisionMask) {
+        const UInt128 second = multiply(w, power.low);
+        product.low += second.high;
+        if (second.high > product.low)
+            ++product.high;
+    }
+    // the truncated product may be one less than the exact one, which
+    // matters only if all the truncated bits are ones
+    if (product.low == ~quint64(0) && (q < -27 || q > 55))
+        return false;
+
+    const int upperBit = int(product.high >> 63);
+    const int shift = upperBit + 64 - DoubleMantissaBits - 3;
+    quint64 mantissa = product.high >> shift;
+    // floor(log2(10^q)) + 63, plus the exponent bias
+    int power2 = int(((152170 + 65536) * q) >> 16) + 63 + upperBit - lz + DoubleBias;
+
+    if (power2 <= 0) {
+        // subnormal
+        if (-power2 + 1 >= 64)
+            return false;
+        mantissa >>= -power2 + 1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        if (mantissa == 0)
+            return false;
+        power2 = mantissa < (quint64(1) << DoubleMantissaBits) ? 0 : 1;
+        mantissa &= ~(quint64(1) << DoubleMantissaBits);
+    } else {
+        // exactly half-way between two doubles: round to even
+        if (product.low <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1
+                && (mantissa << shift) == product.high) {
+            mantissa &= ~quint64(1);
+        }
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        if (mantissa >= (quint64(2) << DoubleMantissaBits)) {
+            mantissa = quint64(1) << DoubleMantissaBits;
+            ++power2;
+        }
+        mantissa &= ~(quint64(1) << DoubleMantissaBits);
+        if (power2 >= (1 << DoubleExponentBits) - 1)
+            return false;
+    }
+
+    quint64 bits = mantissa | (quint64(power2) << DoubleMantissaBits);
+    if (negative)
+        bits |= quint64(1) << 63;
+    result = bitsToDouble(bits);
+    return true;
+}
+
+const char *qt_parseSimpleDouble(const char *begin, const char *end, double &result) noexcept
+{
+    const char *p = begin;
+    bool negative = false;
+    if (p != end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+
+    quint64 mantissa = 0;
+    int significantDigits = 0;
+    int exponent = 0;
+    bool hasDigits = false;
+    const auto addDigit = [&](char c) {
+        hasDigits = true;
+        if (mantissa == 0 && c == '0')
+            return true;
+        if (++significantDigits > 19)
+            return false;
+        mantissa = mantissa * 10 + uint(c - '0');
+        return true;
+    };
+
+    for (; p != end && *p >= '0' && *p <= '9'; ++p) {
+        if (!addDigit(*p))
+            return nullptr;
+    }
+    if (p != end && *p == '.') {
+        for (++p; p != end && *p >= '0' && *p <= '9'; ++p) {
+            if (!addDigit(*p))
+                return nullptr;
+            --exponent;
+        }
+    }
+    if (!hasDigits)
+        return nullptr;
+
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExponent = false;
+        if (p != end && (*p == '-' || *p == '+')) {
+            negativeExponent = *p == '-';
+            ++p;
+        }
+        if (p == end || *p < '0' || *p > '9')
+            return nullptr;
+        int explicitExponent = 0;
+        for (; p != end && *p >= '0' && *p <= '9'; ++p) {
+            if (explicitExponent < 100000)
+                explicitExponent = explicitExponent * 10 + (*p - '0');
+        }
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+
+    if (!qt_decimalToDouble(mantissa, exponent, negative, result))
+        return nullptr;
+    return p;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,90 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QFLOATCONVERSION_P_H
+#define QFLOATCONVERSION_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of internal files.  This header file may change from version to version
+// without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+
+QT_BEGIN_NAMESPACE
+
+// Enough for "-2.2250738585072014e-308" and the like
+constexpr int QtShortestDoubleBufferSize = 32;
+
+// Writes the shortest decimal digits that round-trip to the finite,
+// positive value \a d into \a digits, which must have room for 17 digits,
+// and returns their number; \a decpt receives the position of the decimal
+// point relative to the first digit, as for qt_doubleToAscii().
+int qt_doubleToShortestDigits(double d, char *digits, int &decpt) noexcept;
+
+// Formats \a d as QByteArray::number(d, 'g', QLocale::FloatingPointShortest)
+// does into \a buf, which must have room for QtShortestDoubleBufferSize
+// bytes, and returns the number of bytes written (no terminating '\0').
+// \a capitalEorX and \a minExponentDigits correspond to the CapitalEorX and
+// ZeroPadExponent flags of QLocaleData::doubleToString().
+Q_CORE_EXPORT int qt_doubleToShortestCLocale(double d, char *buf, bool capitalEorX = false,
+                                             int minExponentDigits = 2) noexcept;
+
+// Converts the decimal \a mantissa * 10^\a exponent10 to the nearest double,
+// returning false if that cannot be decided quickly; \a mantissa must not
+// have been truncated.
+bool qt_decimalToDouble(quint64 mantissa, int exponent10, bool negative, double &result) noexcept;
+
+// Parses a number of the form [+-]digits[.digits][(e|E)[+-]digits] at the
+// start of [\a begin, \a end) and returns the end of the number, or \nullptr
+// if the number has another form, overflows, underflows or has too many
+// significant digits to be converted quickly; callers then fall back to the
+// general conversion.
+const char *qt_parseSimpleDouble(const char *begin, const char *end, double &result) noexcept;
+
+QT_END_NAMESPACE
+
+#endif // QFLOATCONVERSION_P_H
@@ -54,6 +54,7 @@
 #include "qlocale.h"
 #include "qlocale_p.h"
 #include "qlocale_tools_p.h"
+#include "qfloatconversion_p.h"
 #if QT_CONFIG(datetimeparser)
 #include "private/qdatetimeparser_p.h"
 #endif
@@ -3296,6 +3297,16 @@ QString QLocaleData::doubleToString(double d, int precision, DoubleForm form,
     if (width < 0)
         width = 0;
 
+    // The C locale's shortest form, used for serialization, needs none of
+    // the locale-specific processing below.
+    if (this == c() && precision == QLocale::FloatingPointShortest && form == DFSignificantDigits
+            && width == 0 && (flags & ~(ZeroPadExponent | CapitalEorX)) == 0) {
+        char buf[QtShortestDoubleBufferSize];
+        const int length = qt_doubleToShortestCLocale(d, buf, flags & CapitalEorX,
+                                                      flags & ZeroPadExponent ? 2 : 1);
+        return QString::fromLatin1(buf, length);
+    }
+
     int decpt;
     int bufSize = 1;
     if (precision == QLocale::FloatingPointShortest)
@@ -40,6 +40,7 @@
 
 #include "qlocale_tools_p.h"
 #include "qdoublescanprint_p.h"
+#include "qfloatconversion_p.h"
 #include "qlocale_p.h"
 #include "qstring.h"
 
@@ -116,6 +117,12 @@ void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision, cha
     if (form == QLocaleData::DFSignificantDigits && precision == 0)
         precision = 1; // 0 significant digits is silently converted to 1
 
+    if (precision == QLocale::FloatingPointShortest && bufSize >= 17) {
+        sign = std::signbit(d);
+        length = qt_doubleToShortestDigits(qAbs(d), buf, decpt);
+        return;
+    }
+
 #if !defined(QT_NO_DOUBLECONVERSION) && !defined(QT_BOOTSTRAPPED)
     // one digit before the decimal dot, counts as significant digit for DoubleToStringConverter
     if (form == QLocaleData::DFExponent && precision >= 0)
@@ -320,6 +327,23 @@ double qt_asciiToDouble(const char *num, qsizetype numLen, bool &ok, int &proces
     }
 
     double d = 0.0;
+    if (strayCharMode != TrailingJunkAllowed) {
+        // Most numbers in the wild have few enough digits to be converted
+        // without the big-number arithmetic of the general conversion.
+        const char *begin = num;
+        const char *end = num + numLen;
+        if (strayCharMode == WhitespacesAllowed) {
+            while (begin != end && ascii_isspace(*begin))
+                ++begin;
+            while (end != begin && ascii_isspace(end[-1]))
+                --end;
+        }
+        if (begin != end && qt_parseSimpleDouble(begin, end, d) == end) {
+            processed = int(qMin(numLen, qsizetype(INT_MAX)));
+            return d;
+        }
+    }
+
 #if !defined(QT_NO_DOUBLECONVERSION) && !defined(QT_BOOTSTRAPPED)
     int conv_flags = double_conversion::StringToDoubleConverter::NO_FLAGS;
     if (strayCharMode == TrailingJunkAllowed) {
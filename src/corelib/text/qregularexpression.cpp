@@ -40,7 +40,10 @@
 ****************************************************************************/
 
 #include "qregularexpression.h"
+#include "qregularexpression_p.h"
+#include "qahocorasick_p.h"
 
+#include <QtCore/qcache.h>
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qhashfunctions.h>
 #include <QtCore/qlist.h>
@@ -48,6 +51,7 @@
 #include <QtCore/qstringlist.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qthreadstorage.h>
+#include <QtCore/qvarlengtharray.h>
 #include <QtCore/qglobal.h>
 #include <QtCore/qatomic.h>
 #include <QtCore/qdatastream.h>
@@ -447,6 +451,17 @@ QT_BEGIN_NAMESPACE
     \c{QT_ENABLE_REGEXP_JIT} environment variable to a non-zero or zero value
     respectively.
 
+    \section1 Sharing of Compiled Patterns
+
+    QRegularExpression objects constructed from the same pattern and pattern
+    options share the compiled (and JIT-compiled) code, even if they were
+    created independently and are used from different threads. A process-wide
+    cache keeps the most recently used compiled patterns alive, so that
+    constructing a QRegularExpression from a pattern that has been used
+    recently does not compile it again. The cache holds up to 256 patterns
+    by default; this can be changed by setting the \c{QT_REGEXP_CACHE_SIZE}
+    environment variable, and a value of 0 disables the cache.
+
     \sa QRegularExpressionMatch, QRegularExpressionMatchIterator
 */
 
@@ -721,6 +736,29 @@ static int convertToPcreOptions(QRegularExpression::MatchOptions matchOptions)
     return options;
 }
 
+/*
+    A compiled (and possibly JIT-compiled) pattern. PCRE2 allows concurrent
+    matching against the same code, so instances are shared by all the
+    QRegularExpressionPrivate objects using the same pattern and pattern
+    options, and by the pattern cache.
+*/
+struct QRegularExpressionCompiledPattern : QSharedData
+{
+    explicit QRegularExpressionCompiledPattern(pcre2_code_16 *c) noexcept
+        : code(c)
+    {
+    }
+    ~QRegularExpressionCompiledPattern()
+    {
+        pcre2_code_free_16(code);
+    }
+
+    pcre2_code_16 * const code;
+
+private:
+    Q_DISABLE_COPY_MOVE(QRegularExpressionCompiledPattern)
+};
+
 struct QRegularExpressionPrivate : QSharedData
 {
     QRegularExpressionPrivate();
@@ -753,9 +791,11 @@ struct QRegularExpressionPrivate : QSharedData
     // (right after a detach happened).
     mutable QMutex mutex;
 
-    // The PCRE code pointer is reference-counted by the QRegularExpressionPrivate
-    // objects themselves; when the private is copied (i.e. a detach happened)
-    // it is set to nullptr
+    // The PCRE code is owned by sharedPattern, which is shared with the
+    // pattern cache and with other QRegularExpressionPrivate objects using
+    // the same pattern; compiledPattern points into it. When the private is
+    // copied (i.e. a detach happened) both are reset.
+    QExplicitlySharedDataPointer<QRegularExpressionCompiledPattern> sharedPattern;
     pcre2_code_16 *compiledPattern;
     int errorCode;
     qsizetype errorOffset;
@@ -826,6 +866,7 @@ QRegularExpressionPrivate::QRegularExpressionPrivate()
       patternOptions(),
       pattern(),
       mutex(),
+      sharedPattern(),
       compiledPattern(nullptr),
       errorCode(0),
       errorOffset(-1),
@@ -857,6 +898,7 @@ QRegularExpressionPrivate::QRegularExpressionPrivate(const QRegularExpressionPri
       patternOptions(other.patternOptions),
       pattern(other.pattern),
       mutex(),
+      sharedPattern(),
       compiledPattern(nullptr),
       errorCode(0),
       errorOffset(-1),
@@ -871,7 +913,7 @@ QRegularExpressionPrivate::QRegularExpressionPrivate(const QRegularExpressionPri
 */
 void QRegularExpressionPrivate::cleanCompiledPattern()
 {
-    pcre2_code_free_16(compiledPattern);
+    sharedPattern.reset();
     compiledPattern = nullptr;
     errorCode = 0;
     errorOffset = -1;
@@ -879,8 +921,148 @@ void QRegularExpressionPrivate::cleanCompiledPattern()
     usingCrLfNewlines = false;
 }
 
+namespace {
+struct QRegularExpressionCacheKey
+{
+    QString pattern;
+    QRegularExpression::PatternOptions patternOptions;
+
+    friend bool operator==(const QRegularExpressionCacheKey &lhs,
+                           const QRegularExpressionCacheKey &rhs) noexcept
+    {
+        return lhs.patternOptions == rhs.patternOptions && lhs.pattern == rhs.pattern;
+    }
+};
+
+size_t qHash(const QRegularExpressionCacheKey &key, size_t seed = 0) noexcept
+{
+    return qHashMulti(seed, key.pattern, int(key.patternOptions));
+}
+
+/*
+    Process-wide, size-bounded LRU cache of successfully compiled patterns,
+    so that QRegularExpression objects constructed from the same pattern
+    string do not compile (and JIT-compile) it over and over again. The
+    maximum number of entries defaults to 256 and can be changed with the
+    QT_REGEXP_CACHE_SIZE environment variable; 0 disables the cache.
+*/
+class QRegularExpressionCache
+{
+public:
+    using CompiledPatternPointer = QExplicitlySharedDataPointer<QRegularExpressionCompiledPattern>;
+
+    QRegularExpressionCache()
+        : cache(defaultMaxSize())
+    {
+    }
+
+    CompiledPatternPointer find(const QRegularExpressionCacheKey &key)
+    {
+        const QMutexLocker lock(&mutex);
+        if (const CompiledPatternPointer *p = cache.object(key)) {
+            ++hits;
+            return *p;
+        }
+        ++misses;
+        return CompiledPatternPointer();
+    }
+
+    // Returns the cached entry, which is not \a pattern if another thread
+    // inserted the same key in the meantime.
+    CompiledPatternPointer insert(const QRegularExpressionCacheKey &key,
+                                  const CompiledPatternPointer &pattern)
+    {
+        const QMutexLocker lock(&mutex);
+        if (const CompiledPatternPointer *p = cache.object(key))
+            return *p;
+        cache.insert(key, new CompiledPatternPointer(pattern));
+        return pattern;
+    }
+
+    QRegularExpressionCacheStatistics statistics()
+    {
+        const QMutexLocker lock(&mutex);
+        QRegularExpressionCacheStatistics result;
+        result.hits = hits;
+        result.misses = misses;
+        result.size = cache.size();
+        result.maxSize = cache.maxCost();
+        return result;
+    }
+
+    void setMaxSize(qsizetype maxSize)
+    {
+        const QMutexLocker lock(&mutex);
+        cache.setMaxCost(int(qMin(qMax(maxSize, qsizetype(0)), qsizetype(INT_MAX))));
+    }
+
+    void clear()
+    {
+        const QMutexLocker lock(&mutex);
+        cache.clear();
+        hits = 0;
+        misses = 0;
+    }
+
+private:
+    static int defaultMaxSize()
+    {
+        bool ok;
+        const int size = qEnvironmentVariableIntValue("QT_REGEXP_CACHE_SIZE", &ok);
+        return ok ? qMax(size, 0) : 256;
+    }
+
+    QMutex mutex;
+    QCache<QRegularExpressionCacheKey, CompiledPatternPointer> cache;
+    qint64 hits = 0;
+    qint64 misses = 0;
+};
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(QRegularExpressionCache, patternCache)
+
+/*!
+    \internal
+
+    Returns the hit and miss counts and the size of the process-wide cache
+    of compiled patterns.
+*/
+QRegularExpressionCacheStatistics qt_regularExpressionCacheStatistics()
+{
+    if (QRegularExpressionCache *cache = patternCache())
+        return cache->statistics();
+    return QRegularExpressionCacheStatistics();
+}
+
 /*!
     \internal
+
+    Sets the maximum number of compiled patterns kept by the process-wide
+    cache to \a maxSize. A size of 0 disables the cache.
+*/
+void qt_setRegularExpressionCacheSize(qsizetype maxSize)
+{
+    if (QRegularExpressionCache *cache = patternCache())
+        cache->setMaxSize(maxSize);
+}
+
+/*!
+    \internal
+
+    Removes all the entries from the process-wide cache of compiled patterns
+    and resets its statistics.
+*/
+void qt_clearRegularExpressionCache()
+{
+    if (QRegularExpressionCache *cache = patternCache())
+        cache->clear();
+}
+
+/*!
+    \internal
+
+    Looks the pattern up in the process-wide cache, and compiles it (and
+    adds it to the cache) if it is not found there.
 */
 void QRegularExpressionPrivate::compilePattern()
 {
@@ -892,26 +1074,38 @@ void QRegularExpressionPrivate::compilePattern()
     isDirty = false;
     cleanCompiledPattern();
 
-    int options = convertToPcreOptions(patternOptions);
-    options |= PCRE2_UTF;
-
-    PCRE2_SIZE patternErrorOffset;
-    compiledPattern = pcre2_compile_16(reinterpret_cast<PCRE2_SPTR16>(pattern.utf16()),
-                                       pattern.length(),
-                                       options,
-                                       &errorCode,
-                                       &patternErrorOffset,
-                                       nullptr);
+    const QRegularExpressionCacheKey key{ pattern, patternOptions };
+    QRegularExpressionCache *cache = patternCache();
+    if (cache)
+        sharedPattern = cache->find(key);
+
+    if (!sharedPattern) {
+        int options = convertToPcreOptions(patternOptions);
+        options |= PCRE2_UTF;
+
+        PCRE2_SIZE patternErrorOffset;
+        compiledPattern = pcre2_compile_16(reinterpret_cast<PCRE2_SPTR16>(pattern.utf16()),
+                                           pattern.length(),
+                                           options,
+                                           &errorCode,
+                                           &patternErrorOffset,
+                                           nullptr);
+
+        if (!compiledPattern) {
+            errorOffset = qsizetype(patternErrorOffset);
+            return;
+        } else {
+            // ignore whatever PCRE2 wrote into errorCode -- leave it to 0 to mean "no error"
+            errorCode = 0;
+        }
 
-    if (!compiledPattern) {
-        errorOffset = qsizetype(patternErrorOffset);
-        return;
-    } else {
-        // ignore whatever PCRE2 wrote into errorCode -- leave it to 0 to mean "no error"
-        errorCode = 0;
+        optimizePattern();
+        sharedPattern = new QRegularExpressionCompiledPattern(compiledPattern);
+        if (cache)
+            sharedPattern = cache->insert(key, sharedPattern);
     }
 
-    optimizePattern();
+    compiledPattern = sharedPattern->code;
     getPatternInfo();
 }
 
@@ -1013,7 +1207,8 @@ static bool isJitEnabled()
     JIT-compiles the pattern.
 
     It gets called when a pattern is recompiled by us (in compilePattern()),
-    under mutex protection.
+    under mutex protection, before the compiled pattern is published to the
+    cache and can be used by other threads.
 */
 void QRegularExpressionPrivate::optimizePattern()
 {
@@ -2571,6 +2766,536 @@ QRegularExpression::MatchOptions QRegularExpressionMatchIterator::matchOptions()
     return d->matchOptions;
 }
 
+/*!
+    \class QRegularExpressionSet
+    \inmodule QtCore
+    \reentrant
+    \since 6.0
+
+    \brief The QRegularExpressionSet class matches a string against many
+    regular expressions at once.
+
+    \ingroup tools
+    \ingroup shared
+
+    \keyword regular expression set
+
+    Matching one string against a large number of regular expressions, for
+    instance to classify log lines with thousands of rules, is expensive if
+    each QRegularExpression is tried in turn. QRegularExpressionSet holds a
+    list of patterns sharing the same pattern options and reports which of
+    them match a given subject string:
+
+    \snippet code/src_corelib_text_qregularexpression.cpp 34
+
+    When the patterns are set, QRegularExpressionSet extracts from each of
+    them a literal string that every match of the pattern must contain, if
+    there is one, and compiles all these literals into a single automaton.
+    Matching first scans the subject once with that automaton, which costs
+    the same independently of the number of patterns, and then runs the
+    regular expression engine only for the patterns whose literal was found,
+    and for the patterns from which no literal could be extracted (for
+    instance because they use alternation at the top level, or consist only
+    of character classes).
+
+    The result is always the same as matching each pattern individually
+    with QRegularExpression::match(); the literal prefilter only avoids
+    running patterns that cannot match. Sets work best when most patterns
+    contain a distinctive literal of a few characters.
+
+    \sa QRegularExpression
+*/
+
+/*
+    Returns the longest string of code units that every match of \a pattern
+    must contain (case-folded if the pattern is case insensitive), or an
+    empty string if no such string can be determined. The analysis is
+    conservative: it only looks at the top level of the pattern, skips all
+    groups, and gives up on constructs that could change the meaning of the
+    following characters or end the match early.
+*/
+static QString requiredLiteral(QStringView pattern, QRegularExpression::PatternOptions options)
+{
+    if (options & QRegularExpression::ExtendedPatternSyntaxOption)
+        return QString();
+
+    const bool caseInsensitive = options & QRegularExpression::CaseInsensitiveOption;
+    const qsizetype length = pattern.size();
+    QString best;
+    QString current;
+
+    const auto endRun = [&]() {
+        if (current.size() > best.size())
+            best = current;
+        current.clear();
+    };
+    // the last character is quantified by something that allows zero repetitions
+    const auto dropLast = [&]() {
+        if (!current.isEmpty()) {
+            current.chop(current.size() >= 2 && current.back().isLowSurrogate()
+                         && current.at(current.size() - 2).isHighSurrogate() ? 2 : 1);
+        }
+        endRun();
+    };
+    const auto appendLiteral = [&](QChar c) {
+        if (!caseInsensitive)
+            current.append(c);
+        else if (c.isSurrogate())
+            endRun();
+        else
+            current.append(c.toCaseFolded());
+    };
+    // returns the position after the closing character, or -1 if missing
+    const auto skipPast = [&](qsizetype i, QChar close) -> qsizetype {
+        for (; i < length; ++i) {
+            if (pattern.at(i) == close)
+                return i + 1;
+        }
+        return -1;
+    };
+    // returns the position after the escape sequence starting at i
+    const auto skipEscape = [&](qsizetype i) -> qsizetype {
+        if (i + 1 < length && pattern.at(i + 1) == QLatin1Char('Q')) {
+            // everything up to \E is quoted, or up to the end of the pattern
+            const qsizetype end = pattern.indexOf(QLatin1String("\\E"), i + 2);
+            return end < 0 ? length : end + 2;
+        }
+        return i + 2;
+    };
+    const auto skipClass = [&](qsizetype i) -> qsizetype {
+        // i is after the opening '['
+        if (i < length && pattern.at(i) == QLatin1Char('^'))
+            ++i;
+        if (i < length && pattern.at(i) == QLatin1Char(']'))
+            ++i;
+        while (i < length) {
+            const QChar c = pattern.at(i);
+            if (c == QLatin1Char('\\')) {
+                i = skipEscape(i);
+            } else if (c == QLatin1Char('[') && i + 1 < length
+                       && pattern.at(i + 1) == QLatin1Char(':')) {
+                const qsizetype end = pattern.indexOf(QLatin1String(":]"), i + 2);
+                if (end < 0)
+                    return -1;
+                i = end + 2;
+            } else if (c == QLatin1Char(']')) {
+                return i + 1;
+            } else {
+                ++i;
+            }
+        }
+        return -1;
+    };
+
+    qsizetype i = 0;
+    while (i < length) {
+        const QChar c = pattern.at(i);
+        switch (c.unicode()) {
+        case u'\\': {
+            if (i + 1 >= length)
+                return QString();
+            const QChar escaped = pattern.at(i + 1);
+            i += 2;
+            if (!escaped.isLetterOrNumber()) {
+                appendLiteral(escaped);
+                break;
+            }
+            switch (escaped.unicode()) {
+            case u'Q':
+                // quoted sequences are rare enough not to bother
+                return QString();
+            case u'E':
+                break;
+            case u'a':
+                appendLiteral(QChar(0x07));
+                break;
+            case u'e':
+                appendLiteral(QChar(0x1b));
+                break;
+            case u'f':
+                appendLiteral(QChar(0x0c));
+                break;
+            case u'n':
+                appendLiteral(QChar(0x0a));
+                break;
+            case u'r':
+                appendLiteral(QChar(0x0d));
+                break;
+            case u't':
+                appendLiteral(QChar(0x09));
+                break;
+            case u'c':
+                endRun();
+                ++i;
+                break;
+            case u'x':
+                endRun();
+                if (i < length && pattern.at(i) == QLatin1Char('{')) {
+                    i = skipPast(i, QLatin1Char('}'));
+                } else {
+                    for (int n = 0; n < 2 && i < length && isxdigit(pattern.at(i).toLatin1()); ++n)
+                        ++i;
+                }
+                break;
+            case u'g':
+            case u'k':
+                endRun();
+                if (i < length && pattern.at(i) == QLatin1Char('{'))
+                    i = skipPast(i, QLatin1Char('}'));
+                else if (i < length && pattern.at(i) == QLatin1Char('<'))
+                    i = skipPast(i, QLatin1Char('>'));
+                else if (i < length && pattern.at(i) == QLatin1Char('\''))
+                    i = skipPast(i + 1, QLatin1Char('\''));
+                else if (i < length && (pattern.at(i) == QLatin1Char('-') || pattern.at(i) == QLatin1Char('+')))
+                    ++i;
+                while (i >= 0 && i < length && pattern.at(i).isDigit())
+                    ++i;
+                break;
+            case u'o':
+            case u'p':
+            case u'P':
+            case u'N':
+                endRun();
+                if (i < length && pattern.at(i) == QLatin1Char('{'))
+                    i = skipPast(i, QLatin1Char('}'));
+                else if (escaped != QLatin1Char('N') && escaped != QLatin1Char('o'))
+                    ++i;
+                break;
+            default:
+                // character types, assertions, back references and octal escapes
+                endRun();
+                while (escaped.isDigit() && i < length && pattern.at(i).isDigit())
+                    ++i;
+                break;
+            }
+            if (i < 0)
+                return QString();
+            break;
+        }
+        case u'[':
+            endRun();
+            i = skipClass(i + 1);
+            if (i < 0)
+                return QString();
+            break;
+        case u'(': {
+            endRun();
+            if (i + 2 < length && pattern.at(i + 1) == QLatin1Char('?')
+                && QStringView(u"imnsxJU-^").contains(pattern.at(i + 2))) {
+                // inline options may apply to the rest of the pattern
+                return QString();
+            }
+            int depth = 0;
+            while (i < length) {
+                const QChar g = pattern.at(i);
+                if (g == QLatin1Char('\\')) {
+                    i = skipEscape(i);
+                    continue;
+                }
+                if (g == QLatin1Char('(') && i + 1 < length && pattern.at(i + 1) == QLatin1Char('*')) {
+                    // backtracking control verbs such as (*ACCEPT) can end
+                    // the match early, or change how the pattern is matched
+                    return QString();
+                }
+                if (g == QLatin1Char('[')) {
+                    i = skipClass(i + 1);
+                    if (i < 0)
+                        return QString();
+                    continue;
+                }
+                ++i;
+                if (g == QLatin1Char('(')) {
+                    ++depth;
+                } else if (g == QLatin1Char(')') && --depth == 0) {
+                    break;
+                }
+            }
+            if (depth != 0)
+                return QString();
+            break;
+        }
+        case u')':
+        case u'|':
+            return QString();
+        case u'.':
+        case u'^':
+        case u'$':
+            endRun();
+            ++i;
+            break;
+        case u'?':
+        case u'*':
+            dropLast();
+            ++i;
+            break;
+        case u'+':
+            endRun();
+            ++i;
+            break;
+        case u'{': {
+            qsizetype j = i + 1;
+            qsizetype minimumRepetitions = 0;
+            bool hasMinimum = false;
+            while (j < length && pattern.at(j).isDigit()) {
+                minimumRepetitions = qMin<qsizetype>(minimumRepetitions * 10 + pattern.at(j).digitValue(), 1000);
+                hasMinimum = true;
+                ++j;
+            }
+            const qsizetype end = skipPast(j, QLatin1Char('}'));
+            if (end < 0) {
+                // a literal brace
+                endRun();
+                ++i;
+            } else {
+                // zero repetitions make the quantified character optional;
+                // if the braces turn out to be literal, skipping them is
+                // merely less selective
+                if (hasMinimum && minimumRepetitions > 0)
+                    endRun();
+                else
+                    dropLast();
+                i = end;
+            }
+            break;
+        }
+        default:
+            appendLiteral(c);
+            ++i;
+            break;
+        }
+    }
+    endRun();
+    return best;
+}
+
+struct QRegularExpressionSetPrivate : QSharedData
+{
+    void build();
+
+    QStringList patterns;
+    QRegularExpression::PatternOptions patternOptions;
+
+    QList<QRegularExpression> expressions;
+    // patterns for which no required literal was found, always matched
+    QList<qsizetype> unfilteredPatterns;
+    QtPrivate::AhoCorasickAutomaton<char16_t> prefilter;
+};
+
+/*!
+    \internal
+*/
+void QRegularExpressionSetPrivate::build()
+{
+    expressions.clear();
+    unfilteredPatterns.clear();
+    prefilter = QtPrivate::AhoCorasickAutomaton<char16_t>();
+
+    expressions.reserve(patterns.size());
+    for (qsizetype i = 0; i < patterns.size(); ++i) {
+        const QString &pattern = patterns.at(i);
+        expressions.append(QRegularExpression(pattern, patternOptions));
+        const QString literal = requiredLiteral(pattern, patternOptions);
+        if (literal.isEmpty())
+            unfilteredPatterns.append(i);
+        else
+            prefilter.addNeedle(QStringView(literal).utf16(), literal.size(), i);
+    }
+    prefilter.build();
+}
+
+/*!
+    Constructs an empty QRegularExpressionSet, which matches no string.
+*/
+QRegularExpressionSet::QRegularExpressionSet()
+    : d(new QRegularExpressionSetPrivate)
+{
+    d->build();
+}
+
+/*!
+    Constructs a QRegularExpressionSet object holding the given \a patterns,
+    which are all compiled with the given pattern \a options.
+
+    \sa setPatterns(), setPatternOptions()
+*/
+QRegularExpressionSet::QRegularExpressionSet(const QStringList &patterns,
+                                             QRegularExpression::PatternOptions options)
+    : d(new QRegularExpressionSetPrivate)
+{
+    d->patterns = patterns;
+    d->patternOptions = options;
+    d->build();
+}
+
+/*!
+    Constructs a QRegularExpressionSet object as a copy of \a other.
+
+    \sa operator=()
+*/
+QRegularExpressionSet::QRegularExpressionSet(const QRegularExpressionSet &other)
+    : d(other.d)
+{
+}
+
+/*!
+    Destroys the QRegularExpressionSet object.
+*/
+QRegularExpressionSet::~QRegularExpressionSet()
+{
+}
+
+/*!
+    Assigns the set \a other to this object, and returns a reference to the
+    copy.
+*/
+QRegularExpressionSet &QRegularExpressionSet::operator=(const QRegularExpressionSet &other)
+{
+    d = other.d;
+    return *this;
+}
+
+/*!
+    \fn QRegularExpressionSet &QRegularExpressionSet::operator=(QRegularExpressionSet &&other)
+
+    Move-assigns \a other to this QRegularExpressionSet instance.
+*/
+
+/*!
+    \fn void QRegularExpressionSet::swap(QRegularExpressionSet &other)
+
+    Swaps the set \a other with this set. This operation is very fast and
+    never fails.
+*/
+
+/*!
+    Returns the patterns of this set. The indexes returned by
+    matchingPatterns() are indexes into this list.
+
+    \sa setPatterns()
+*/
+QStringList QRegularExpressionSet::patterns() const
+{
+    return d->patterns;
+}
+
+/*!
+    Sets the patterns of this set to \a patterns, and rebuilds the combined
+    prefilter.
+
+    \sa patterns()
+*/
+void QRegularExpressionSet::setPatterns(const QStringList &patterns)
+{
+    d.detach();
+    d->patterns = patterns;
+    d->build();
+}
+
+/*!
+    Returns the pattern options used for all the patterns of this set.
+
+    \sa setPatternOptions()
+*/
+QRegularExpression::PatternOptions QRegularExpressionSet::patternOptions() const
+{
+    return d->patternOptions;
+}
+
+/*!
+    Sets the pattern options used for all the patterns of this set to
+    \a options.
+
+    \sa patternOptions()
+*/
+void QRegularExpressionSet::setPatternOptions(QRegularExpression::PatternOptions options)
+{
+    d.detach();
+    d->patternOptions = options;
+    d->build();
+}
+
+/*!
+    Returns \c true if all the patterns of this set are valid regular
+    expressions; returns \c false otherwise. Invalid patterns never match.
+
+    \sa regularExpression(), QRegularExpression::isValid()
+*/
+bool QRegularExpressionSet::isValid() const
+{
+    return std::all_of(d->expressions.cbegin(), d->expressions.cend(),
+                       [](const QRegularExpression &re) { return re.isValid(); });
+}
+
+/*!
+    Returns the regular expression for the pattern at position \a index,
+    which must be a valid index into patterns(). This can be used to find
+    out why a pattern is invalid, or to extract the captured substrings of a
+    pattern reported by matchingPatterns().
+*/
+QRegularExpression QRegularExpressionSet::regularExpression(qsizetype index) const
+{
+    Q_ASSERT(index >= 0 && index < d->expressions.size());
+    return d->expressions.at(index);
+}
+
+/*!
+    Returns \c true if at least one of the patterns of this set matches
+    \a subject, using the match options \a matchOptions; otherwise returns
+    \c false.
+
+    \sa matchingPatterns()
+*/
+bool QRegularExpressionSet::hasMatch(QStringView subject,
+                                     QRegularExpression::MatchOptions matchOptions) const
+{
+    return !matchingPatterns(subject, matchOptions).isEmpty();
+}
+
+/*!
+    Returns the indexes, in ascending order, of the patterns of this set
+    that match \a subject using the match options \a matchOptions. The result
+    is the same as calling QRegularExpression::match() with each pattern and
+    collecting the ones that have a match.
+
+    \sa hasMatch(), regularExpression()
+*/
+QList<qsizetype> QRegularExpressionSet::matchingPatterns(QStringView subject,
+                                                         QRegularExpression::MatchOptions matchOptions) const
+{
+    // match() treats a null QString like an empty one, but not a null view
+    if (subject.isNull())
+        subject = QStringView(u"");
+
+    const qsizetype patternCount = d->patterns.size();
+    QVarLengthArray<bool, 256> candidates(patternCount);
+    std::fill(candidates.begin(), candidates.end(), false);
+    for (qsizetype index : qAsConst(d->unfilteredPatterns))
+        candidates[index] = true;
+
+    const auto markCandidate = [&candidates](qsizetype, qsizetype index) {
+        candidates[index] = true;
+        return true;
+    };
+    if (d->patternOptions & QRegularExpression::CaseInsensitiveOption) {
+        const auto fold = [](const char16_t *c, const char16_t *) {
+            return char16_t(QChar::toCaseFolded(*c));
+        };
+        d->prefilter.scan(subject.utf16(), subject.size(), fold, markCandidate);
+    } else {
+        const auto identity = [](const char16_t *c, const char16_t *) { return *c; };
+        d->prefilter.scan(subject.utf16(), subject.size(), identity, markCandidate);
+    }
+
+    QList<qsizetype> result;
+    for (qsizetype i = 0; i < patternCount; ++i) {
+        if (candidates[i] && d->expressions.at(i).match(subject, 0, QRegularExpression::NormalMatch,
+                                                        matchOptions).hasMatch()) {
+            result.append(i);
+        }
+    }
+    return result;
+}
+
 #ifndef QT_NO_DATASTREAM
 /*!
     \relates QRegularExpression
@@ -299,6 +299,41 @@ private:
 
 Q_DECLARE_SHARED(QRegularExpressionMatchIterator)
 
+struct QRegularExpressionSetPrivate;
+
+class Q_CORE_EXPORT QRegularExpressionSet
+{
+public:
+    QRegularExpressionSet();
+    explicit QRegularExpressionSet(const QStringList &patterns,
+                                   QRegularExpression::PatternOptions options = QRegularExpression::NoPatternOption);
+    QRegularExpressionSet(const QRegularExpressionSet &other);
+    ~QRegularExpressionSet();
+    QRegularExpressionSet &operator=(const QRegularExpressionSet &other);
+    QRegularExpressionSet &operator=(QRegularExpressionSet &&other) noexcept
+    { d.swap(other.d); return *this; }
+    void swap(QRegularExpressionSet &other) noexcept { d.swap(other.d); }
+
+    QStringList patterns() const;
+    void setPatterns(const QStringList &patterns);
+
+    QRegularExpression::PatternOptions patternOptions() const;
+    void setPatternOptions(QRegularExpression::PatternOptions options);
+
+    bool isValid() const;
+    QRegularExpression regularExpression(qsizetype index) const;
+
+    bool hasMatch(QStringView subject,
+                  QRegularExpression::MatchOptions matchOptions = QRegularExpression::NoMatchOption) const;
+    QList<qsizetype> matchingPatterns(QStringView subject,
+                                      QRegularExpression::MatchOptions matchOptions = QRegularExpression::NoMatchOption) const;
+
+private:
+    QSharedDataPointer<QRegularExpressionSetPrivate> d;
+};
+
+Q_DECLARE_SHARED(QRegularExpressionSet)
+
 QT_END_NAMESPACE
 
 #endif // QREGULAREXPRESSION_H
@@ -39,6 +39,11 @@
 ****************************************************************************/
 
 #include "qstringmatcher.h"
+#include "qahocorasick_p.h"
+
+#include <QtCore/qvarlengtharray.h>
+
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
@@ -321,6 +326,278 @@ qsizetype QStringMatcher::indexIn(QStringView str, qsizetype from) const
     \sa setCaseSensitivity()
 */
 
+// Folds the code unit at \a ch like QStringMatcher does: a low surrogate is
+// folded together with the preceding high surrogate, whose own fold is the
+// same for all the case pairs outside the Basic Multilingual Plane.
+static inline char16_t foldCaseUnit(const char16_t *ch, const char16_t *start)
+{
+    const char32_t folded = foldCase(ch, start);
+    return QChar::requiresSurrogates(folded) ? QChar::lowSurrogate(folded) : char16_t(folded);
+}
+
+class QMultiStringMatcherPrivate : public QSharedData
+{
+public:
+    void build();
+
+    QList<QString> needles;
+    Qt::CaseSensitivity cs = Qt::CaseSensitive;
+
+    QList<qsizetype> needleLengths;
+    QtPrivate::AhoCorasickAutomaton<char16_t> automaton;
+    QtPrivate::AhoCorasickStartFilter<char16_t> startFilter;
+};
+
+void QMultiStringMatcherPrivate::build()
+{
+    automaton = QtPrivate::AhoCorasickAutomaton<char16_t>();
+    startFilter = QtPrivate::AhoCorasickStartFilter<char16_t>();
+    needleLengths.clear();
+    needleLengths.reserve(needles.size());
+
+    QVarLengthArray<char16_t, 256> folded;
+    for (qsizetype i = 0; i < needles.size(); ++i) {
+        const QString &needle = needles.at(i);
+        const char16_t *data = QStringView(needle).utf16();
+        needleLengths.append(needle.size());
+        if (cs == Qt::CaseSensitive) {
+            automaton.addNeedle(data, needle.size(), i);
+        } else {
+            folded.resize(needle.size());
+            for (qsizetype j = 0; j < needle.size(); ++j)
+                folded[j] = foldCaseUnit(data + j, data);
+            automaton.addNeedle(folded.constData(), folded.size(), i);
+        }
+    }
+    automaton.build();
+
+    // the start filter looks at the unfolded haystack
+    const QList<char16_t> startUnits = automaton.startUnits();
+    if (cs == Qt::CaseSensitive) {
+        startFilter.setUnits(startUnits);
+        return;
+    }
+    // A folded low surrogate depends on the preceding code unit, so needles
+    // starting with one cannot be found by looking at single code units.
+    if (std::any_of(startUnits.cbegin(), startUnits.cend(),
+                    [](char16_t c) { return QChar::isSurrogate(c); })) {
+        return;
+    }
+    QList<char16_t> rawUnits;
+    for (char32_t c = 0; c <= 0xffff; ++c) {
+        if (QChar::isSurrogate(c))
+            continue;
+        if (std::binary_search(startUnits.cbegin(), startUnits.cend(), foldCase(char16_t(c))))
+            rawUnits.append(char16_t(c));
+    }
+    startFilter.setUnits(rawUnits);
+}
+
+/*!
+    \class QMultiStringMatcher
+    \inmodule QtCore
+    \since 6.0
+    \brief The QMultiStringMatcher class finds any of a set of strings in a
+    Unicode string in a single pass.
+
+    \ingroup tools
+    \ingroup string-processing
+    \ingroup shared
+    \reentrant
+
+    QMultiStringMatcher is the Unicode counterpart of
+    QMultiByteArrayMatcher: it compiles a list of strings, called needles,
+    into a single Aho-Corasick automaton, so that one pass over a string
+    finds the occurrences of all needles, independently of how many there
+    are.
+
+    matches() returns every occurrence of every needle, including
+    overlapping ones, together with the index of the needle in needles().
+    indexIn() returns the leftmost occurrence only.
+
+    If the case sensitivity is set to Qt::CaseInsensitive, characters are
+    compared after case folding, like QStringMatcher does. Empty needles
+    never match.
+
+    \sa QStringMatcher, QMultiByteArrayMatcher
+*/
+
+/*!
+    \class QMultiStringMatcher::Match
+    \inmodule QtCore
+    \since 6.0
+    \brief The Match struct describes an occurrence of a needle found by
+    QMultiStringMatcher.
+
+    \variable QMultiStringMatcher::Match::position
+    The position of the first code unit of the occurrence in the haystack.
+
+    \variable QMultiStringMatcher::Match::needleIndex
+    The index in QMultiStringMatcher::needles() of the needle that occurred.
+*/
+
+/*!
+    Constructs an empty multi-needle matcher that won't match anything.
+    Call setNeedles() to give it some needles to match.
+*/
+QMultiStringMatcher::QMultiStringMatcher()
+    : d(new QMultiStringMatcherPrivate)
+{
+    d->build();
+}
+
+/*!
+    Constructs a matcher that searches for any of the given \a needles,
+    with case sensitivity \a cs.
+
+    \sa setNeedles(), setCaseSensitivity()
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QList<QString> &needles, Qt::CaseSensitivity cs)
+    : d(new QMultiStringMatcherPrivate)
+{
+    d->needles = needles;
+    d->cs = cs;
+    d->build();
+}
+
+/*!
+    Copies the \a other matcher to this matcher.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QMultiStringMatcher &other)
+    : d(other.d)
+{
+}
+
+/*!
+    Destroys the matcher.
+*/
+QMultiStringMatcher::~QMultiStringMatcher()
+{
+}
+
+/*!
+    Assigns the \a other matcher to this matcher.
+*/
+QMultiStringMatcher &QMultiStringMatcher::operator=(const QMultiStringMatcher &other)
+{
+    d = other.d;
+    return *this;
+}
+
+/*!
+    \fn QMultiStringMatcher &QMultiStringMatcher::operator=(QMultiStringMatcher &&other)
+
+    Move-assigns \a other to this matcher.
+*/
+
+/*!
+    \fn void QMultiStringMatcher::swap(QMultiStringMatcher &other)
+
+    Swaps the matcher \a other with this matcher. This operation is very
+    fast and never fails.
+*/
+
+/*!
+    Returns the needles this matcher searches for.
+
+    \sa setNeedles()
+*/
+QList<QString> QMultiStringMatcher::needles() const
+{
+    return d->needles;
+}
+
+/*!
+    Sets the needles to search for to \a needles. The needle indexes
+    reported by indexIn() and matches() are indexes into this list.
+
+    \sa needles()
+*/
+void QMultiStringMatcher::setNeedles(const QList<QString> &needles)
+{
+    d.detach();
+    d->needles = needles;
+    d->build();
+}
+
+/*!
+    Returns the case sensitivity of this matcher.
+
+    \sa setCaseSensitivity()
+*/
+Qt::CaseSensitivity QMultiStringMatcher::caseSensitivity() const
+{
+    return d->cs;
+}
+
+/*!
+    Sets the case sensitivity of this matcher to \a cs.
+
+    \sa caseSensitivity()
+*/
+void QMultiStringMatcher::setCaseSensitivity(Qt::CaseSensitivity cs)
+{
+    if (d->cs == cs)
+        return;
+    d.detach();
+    d->cs = cs;
+    d->build();
+}
+
+/*!
+    Searches \a haystack, from position \a from, for the leftmost
+    occurrence of any of the needles. A negative \a from counts from the
+    end of \a haystack.
+
+    Returns the position of the occurrence, or -1 if no needle occurs. If
+    \a needleIndex is not \nullptr, the index of the needle is stored in
+    it; if several needles occur at the returned position, the lowest index
+    is stored.
+
+    \sa matches()
+*/
+qsizetype QMultiStringMatcher::indexIn(QStringView haystack, qsizetype from,
+                                       qsizetype *needleIndex) const
+{
+    if (d->cs == Qt::CaseSensitive) {
+        const auto identity = [](const char16_t *c, const char16_t *) { return *c; };
+        return QtPrivate::ahoCorasickIndexIn(d->automaton, d->startFilter, d->needleLengths,
+                                             haystack.utf16(), haystack.size(), from,
+                                             identity, needleIndex);
+    }
+    return QtPrivate::ahoCorasickIndexIn(d->automaton, d->startFilter, d->needleLengths,
+                                         haystack.utf16(), haystack.size(), from,
+                                         foldCaseUnit, needleIndex);
+}
+
+/*!
+    Returns all the occurrences of all the needles in \a haystack,
+    including overlapping ones, ordered by position. Occurrences at the same
+    position are ordered by needle index.
+
+    \sa indexIn()
+*/
+QList<QMultiStringMatcher::Match> QMultiStringMatcher::matches(QStringView haystack) const
+{
+    QList<Match> result;
+    const auto append = [&result](qsizetype position, qsizetype id) {
+        result.append(Match{ position, id });
+    };
+    if (d->cs == Qt::CaseSensitive) {
+        const auto identity = [](const char16_t *c, const char16_t *) { return *c; };
+        QtPrivate::ahoCorasickForEachMatch(d->automaton, d->startFilter, haystack.utf16(),
+                                           haystack.size(), identity, append);
+    } else {
+        QtPrivate::ahoCorasickForEachMatch(d->automaton, d->startFilter, haystack.utf16(),
+                                           haystack.size(), foldCaseUnit, append);
+    }
+    std::sort(result.begin(), result.end(), [](Match lhs, Match rhs) {
+        return lhs.position < rhs.position
+                || (lhs.position == rhs.position && lhs.needleIndex < rhs.needleIndex);
+    });
+    return result;
+}
+
 /*!
     \internal
 */
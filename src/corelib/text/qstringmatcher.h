@@ -43,6 +43,8 @@
 
 #include <QtCore/qstring.h>
 #include <QtCore/qstringview.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qshareddata.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -86,6 +88,48 @@ private:
     uchar q_skiptable[256] = {};
 };
 
+class QMultiStringMatcherPrivate;
+
+class Q_CORE_EXPORT QMultiStringMatcher
+{
+public:
+    struct Match {
+        qsizetype position;
+        qsizetype needleIndex;
+
+        friend constexpr bool operator==(Match lhs, Match rhs) noexcept
+        { return lhs.position == rhs.position && lhs.needleIndex == rhs.needleIndex; }
+        friend constexpr bool operator!=(Match lhs, Match rhs) noexcept
+        { return !(lhs == rhs); }
+    };
+
+    QMultiStringMatcher();
+    explicit QMultiStringMatcher(const QList<QString> &needles,
+                                 Qt::CaseSensitivity cs = Qt::CaseSensitive);
+    QMultiStringMatcher(const QMultiStringMatcher &other);
+    ~QMultiStringMatcher();
+    QMultiStringMatcher &operator=(const QMultiStringMatcher &other);
+    QMultiStringMatcher &operator=(QMultiStringMatcher &&other) noexcept
+    { d.swap(other.d); return *this; }
+    void swap(QMultiStringMatcher &other) noexcept { d.swap(other.d); }
+
+    QList<QString> needles() const;
+    void setNeedles(const QList<QString> &needles);
+
+    Qt::CaseSensitivity caseSensitivity() const;
+    void setCaseSensitivity(Qt::CaseSensitivity cs);
+
+    qsizetype indexIn(QStringView haystack, qsizetype from = 0,
+                      qsizetype *needleIndex = nullptr) const;
+    QList<Match> matches(QStringView haystack) const;
+
+private:
+    QSharedDataPointer<QMultiStringMatcherPrivate> d;
+};
+
+Q_DECLARE_SHARED(QMultiStringMatcher)
+Q_DECLARE_TYPEINFO(QMultiStringMatcher::Match, Q_PRIMITIVE_TYPE);
+
 QT_END_NAMESPACE
 
 #endif // QSTRINGMATCHER_H
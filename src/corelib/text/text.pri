@@ -1,6 +1,7 @@
 # Qt text / string / character / unicode / byte array module
 
 HEADERS +=  \
+        text/qahocorasick_p.h \
         text/qanystringview.h \
         text/qbytearray.h \
         text/qbytearray_p.h \
@@ -13,6 +14,8 @@ HEADERS +=  \
         text/qcollator.h \
         text/qcollator_p.h \
         text/qdoublescanprint_p.h \
+        text/qfloatconversion_p.h \
+        text/qfloatconversiontables_p.h \
         text/qlocale.h \
         text/qlocale_p.h \
         text/qlocale_tools_p.h \
@@ -39,6 +42,7 @@ SOURCES += \
         text/qbytearraylist.cpp \
         text/qbytearraymatcher.cpp \
         text/qcollator.cpp \
+        text/qfloatconversion.cpp \
         text/qlocale.cpp \
         text/qlocale_tools.cpp \
         text/qstring.cpp \
@@ -80,7 +84,8 @@ qtConfig(regularexpression) {
     QMAKE_USE_PRIVATE += pcre2
 
     HEADERS += \
-        text/qregularexpression.h
+        text/qregularexpression.h \
+        text/qregularexpression_p.h
     SOURCES += text/qregularexpression.cpp
 }
 
@@ -78,11 +78,13 @@ public:
     QObject *receiver;
     QEvent *event;
     int priority;
+    // steady clock nanoseconds, only set while QHooks::EventDequeued is installed
+    qint64 postedAt;
     inline QPostEvent()
-        : receiver(nullptr), event(nullptr), priority(0)
+        : receiver(nullptr), event(nullptr), priority(0), postedAt(0)
     { }
-    inline QPostEvent(QObject *r, QEvent *e, int p)
-        : receiver(r), event(e), priority(p)
+    inline QPostEvent(QObject *r, QEvent *e, int p, qint64 t = 0)
+        : receiver(r), event(e), priority(p), postedAt(t)
     { }
 };
 Q_DECLARE_TYPEINFO(QPostEvent, Q_MOVABLE_TYPE);
@@ -47,6 +47,7 @@
 
 #include <private/qcoreapplication_p.h>
 #include <private/qeventdispatcher_win_p.h>
+#include <private/qeventloopstatistics_p.h>
 
 #include <qt_windows.h>
 
@@ -342,6 +343,8 @@ void QThreadPrivate::finish(void *arg, bool lockAnyway) noexcept
     emit thr->finished(QThread::QPrivateSignal());
     QCoreApplication::sendPostedEvents(0, QEvent::DeferredDelete);
     QThreadStorageData::finish(tls_data);
+    if (d->id == GetCurrentThreadId()) // not when finished from another thread
+        QEventLoopStatistics::threadFinished();
     locker.relock();
 
     QAbstractEventDispatcher *eventDispatcher = d->data->eventDispatcher.loadRelaxed();
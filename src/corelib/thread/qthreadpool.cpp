@@ -42,6 +42,8 @@
 #include "qdeadlinetimer.h"
 #include "qcoreapplication.h"
 
+#include <qtcore_tracepoints_p.h>
+
 #include <algorithm>
 
 QT_BEGIN_NAMESPACE
@@ -97,7 +99,10 @@ void QThreadPoolThread::run()
 #ifndef QT_NO_EXCEPTIONS
                 try {
 #endif
-                    r->run();
+                    {
+                        Q_TRACE_SCOPE(QThreadPoolThread_run, r);
+                        r->run();
+                    }
 #ifndef QT_NO_EXCEPTIONS
                 } catch (...) {
                     qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
@@ -212,6 +217,7 @@ inline bool comparePriority(int priority, const QueuePage *p)
 void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
 {
     Q_ASSERT(runnable != nullptr);
+    Q_TRACE(QThreadPool_enqueue, runnable, priority);
     for (QueuePage *page : qAsConst(queue)) {
         if (page->priority() == priority && !page->isFull()) {
             page->push(runnable);
@@ -507,6 +513,7 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         return;
 
     Q_D(QThreadPool);
+    Q_TRACE(QThreadPool_start, this, runnable, priority);
     QMutexLocker locker(&d->mutex);
     if (runnable->autoDelete()) {
         Q_ASSERT(runnable->ref == 0);
@@ -565,8 +572,11 @@ bool QThreadPool::tryStart(QRunnable *runnable)
 
     Q_D(QThreadPool);
     QMutexLocker locker(&d->mutex);
-    if (d->tryStart(runnable))
+    if (d->tryStart(runnable)) {
+        // still under the lock, so this is recorded before the thread runs it
+        Q_TRACE(QThreadPool_start, this, runnable, 0);
         return true;
+    }
 
     // Undo the reference above as we did not start the runnable and
     // take over ownership.
@@ -597,8 +607,10 @@ bool QThreadPool::tryStart(std::function<void()> functionToRun)
         return false;
 
     QRunnable *runnable = QRunnable::create(std::move(functionToRun));
-    if (d->tryStart(runnable))
+    if (d->tryStart(runnable)) {
+        Q_TRACE(QThreadPool_start, this, runnable, 0);
         return true;
+    }
     delete runnable;
     return false;
 }
@@ -40,6 +40,7 @@
 
 #include "qplatformdefs.h"
 #include "private/qdatetime_p.h"
+#include "private/qlocale_p.h"
 #if QT_CONFIG(datetimeparser)
 #include "private/qdatetimeparser_p.h"
 #endif
@@ -52,6 +53,7 @@
 #include "qtimezoneprivate_p.h"
 #endif
 #include "qdebug.h"
+#include "private/qsimd_p.h"
 #ifndef Q_OS_WIN
 #include <locale.h>
 #endif
@@ -3961,24 +3963,59 @@ QString QDateTime::toString(Qt::DateFormat format) const
     case Qt::ISODate:
     case Qt::ISODateWithMs: {
         const QPair<QDate, QTime> p = getDateTime(d);
-        buf = toStringIsoDate(p.first);
-        if (buf.isEmpty())
+        const auto parts = QCalendar().partsFromDate(p.first);
+        if (!parts.isValid() || parts.year < 0 || parts.year > 9999)
             return QString();   // failed to convert
-        buf += QLatin1Char('T') + p.second.toString(format);
+
+        // Write yyyy-MM-ddTHH:mm:ss[.zzz][Z|[+-]HH:mm] into one buffer, instead
+        // of concatenating the date, time and offset strings.
+        char16_t text[29];
+        char16_t *out = text;
+        const auto writeDigits = [&out](int value, int count) {
+            for (int i = count - 1; i >= 0; --i, value /= 10)
+                out[i] = u'0' + value % 10;
+            out += count;
+        };
+        writeDigits(parts.year, 4);
+        *out++ = u'-';
+        writeDigits(parts.month, 2);
+        *out++ = u'-';
+        writeDigits(parts.day, 2);
+        *out++ = u'T';
+        writeDigits(p.second.hour(), 2);
+        *out++ = u':';
+        writeDigits(p.second.minute(), 2);
+        *out++ = u':';
+        writeDigits(p.second.second(), 2);
+        if (format == Qt::ISODateWithMs) {
+            *out++ = u'.';
+            writeDigits(p.second.msec(), 3);
+        }
         switch (getSpec(d)) {
         case Qt::UTC:
-            buf += QLatin1Char('Z');
+            *out++ = u'Z';
             break;
         case Qt::OffsetFromUTC:
 #if QT_CONFIG(timezone)
         case Qt::TimeZone:
 #endif
-            buf += toOffsetString(Qt::ISODate, offsetFromUtc());
+        {
+            const int offset = offsetFromUtc();
+            if (qAbs(offset) >= 100 * SECS_PER_HOUR) {
+                buf = QStringView(text, out - text).toString();
+                buf += toOffsetString(Qt::ISODate, offset);
+                return buf;
+            }
+            *out++ = offset >= 0 ? u'+' : u'-';
+            writeDigits(qAbs(offset) / SECS_PER_HOUR, 2);
+            *out++ = u':';
+            writeDigits((qAbs(offset) / 60) % 60, 2);
             break;
+        }
         default:
             break;
         }
-        return buf;
+        return QStringView(text, out - text).toString();
     }
     }
 }
@@ -4660,6 +4697,142 @@ QDateTime QDateTime::fromSecsSinceEpoch(qint64 secs, const QTimeZone &timeZone)
 
 #if QT_CONFIG(datestring) // depends on, so implies, textdate
 
+namespace {
+
+struct IsoDateTimeFields
+{
+    qint64 julianDay = 0;
+    int msecsOfDay = 0;
+    int offsetSeconds = 0;
+    Qt::TimeSpec spec = Qt::LocalTime;
+
+    QDateTime toDateTime() const
+    {
+        return QDateTime(QDate::fromJulianDay(julianDay),
+                         QTime::fromMSecsSinceStartOfDay(msecsOfDay), spec, offsetSeconds);
+    }
+
+    qint64 toMSecsSinceEpoch() const
+    {
+        if (spec == Qt::LocalTime)
+            return toDateTime().toMSecsSinceEpoch();
+        return (julianDay - JULIAN_DAY_FOR_EPOCH) * MSECS_PER_DAY + msecsOfDay
+                - offsetSeconds * qint64(1000);
+    }
+};
+
+template <typename Char>
+bool readFixedDigits(const Char *text, int count, int *value) noexcept
+{
+    int result = 0;
+    for (int i = 0; i < count; ++i) {
+        const uint digit = uint(text[i]) - '0';
+        if (digit > 9)
+            return false;
+        result = result * 10 + int(digit);
+    }
+    *value = result;
+    return true;
+}
+
+/*
+    \internal
+
+    Parses the fixed layouts that toString(Qt::ISODate), toString(Qt::ISODateWithMs)
+    and RFC 3339 produce, yyyy-MM-dd[T ]HH:mm[:ss[.z...]][Z|[+-]HH[[:]mm]], without
+    allocating memory. Returns false for anything else, including the less common
+    forms that fromString() accepts and 24:00 as the end of the day; callers then
+    fall back to the general parser, which either accepts the text or rejects it.
+    Where both accept the text, they agree on the result.
+*/
+template <typename Char>
+bool parseIsoDateTimeFast(const Char *text, qsizetype size, IsoDateTimeFields *fields) noexcept
+{
+    // yyyy-MM-ddTHH:mm is the shortest layout with a time
+    if (size < 16)
+        return false;
+#ifdef __SSE2__
+    if constexpr (sizeof(Char) == 1) {
+        // Check the twelve digit positions of the first sixteen bytes at once
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text));
+        const __m128i offsets = _mm_sub_epi8(chunk, _mm_set1_epi8('0'));
+        const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(offsets, _mm_set1_epi8(9)), offsets);
+        constexpr int DigitPositions = 0xdb6f; // 0-3, 5-6, 8-9, 11-12, 14-15
+        if ((_mm_movemask_epi8(isDigit) & DigitPositions) != DigitPositions)
+            return false;
+    }
+#endif
+    if (text[4] != '-' || text[7] != '-' || text[13] != ':'
+        || (text[10] != 'T' && text[10] != 't' && text[10] != ' ')) {
+        return false;
+    }
+
+    int year, month, day, hour, minute;
+    if (!readFixedDigits(text, 4, &year) || !readFixedDigits(text + 5, 2, &month)
+        || !readFixedDigits(text + 8, 2, &day) || !readFixedDigits(text + 11, 2, &hour)
+        || !readFixedDigits(text + 14, 2, &minute) || hour > 23 || minute > 59
+        || !QGregorianCalendar::julianFromParts(year, month, day, &fields->julianDay)) {
+        return false;
+    }
+
+    qsizetype pos = 16;
+    int second = 0;
+    int msec = 0;
+    if (pos < size && text[pos] == ':') {
+        if (size < pos + 3 || !readFixedDigits(text + pos + 1, 2, &second) || second > 59)
+            return false;
+        pos += 3;
+        if (pos < size && (text[pos] == '.' || text[pos] == ',')) {
+            // Like fromIsoTimeString(), round the first four digits to milliseconds
+            const qsizetype start = ++pos;
+            int fraction = 0;
+            for (; pos < size && uint(text[pos]) - '0' <= 9; ++pos) {
+                if (pos - start < 4)
+                    fraction = fraction * 10 + int(text[pos] - '0');
+            }
+            static const double scale[] = { 1, 10, 100, 1000, 10000 };
+            const qsizetype digits = qMin(pos - start, qsizetype(4));
+            if (!digits)
+                return false;
+            msec = qMin(qRound(fraction / scale[digits] * 1000.0), 999);
+        }
+    }
+    fields->msecsOfDay = ((hour * 60 + minute) * 60 + second) * 1000 + msec;
+
+    if (pos == size) {
+        fields->spec = Qt::LocalTime;
+        return true;
+    }
+    if (text[pos] == 'Z' || text[pos] == 'z') {
+        fields->spec = Qt::UTC;
+        return pos + 1 == size;
+    }
+    if (text[pos] != '+' && text[pos] != '-')
+        return false;
+    const int sign = text[pos] == '-' ? -1 : 1;
+    const qsizetype rest = size - pos - 1;
+    const Char *offset = text + pos + 1;
+    int offsetHours, offsetMinutes = 0;
+    if (rest < 2 || !readFixedDigits(offset, 2, &offsetHours) || offsetHours > 23)
+        return false;
+    if (rest == 4) {
+        if (!readFixedDigits(offset + 2, 2, &offsetMinutes))
+            return false;
+    } else if (rest == 5 && offset[2] == ':') {
+        if (!readFixedDigits(offset + 3, 2, &offsetMinutes))
+            return false;
+    } else if (rest != 2) {
+        return false;
+    }
+    if (offsetMinutes > 59)
+        return false;
+    fields->offsetSeconds = sign * (offsetHours * 60 + offsetMinutes) * 60;
+    fields->spec = Qt::OffsetFromUTC;
+    return true;
+}
+
+} // unnamed namespace
+
 /*!
     Returns the QDateTime represented by the \a string, using the
     \a format given, or an invalid datetime if this is not possible.
@@ -4687,6 +4860,10 @@ QDateTime QDateTime::fromString(const QString &string, Qt::DateFormat format)
     }
     case Qt::ISODate:
     case Qt::ISODateWithMs: {
+        IsoDateTimeFields fields;
+        if (parseIsoDateTimeFast(QStringView(string).utf16(), string.size(), &fields))
+            return fields.toDateTime();
+
         const int size = string.size();
         if (size < 10)
             return QDateTime();
@@ -4949,6 +5126,104 @@ QDateTime QDateTime::fromString(const QString &string, const QString &format, QC
     return QDateTime();
 }
 
+/*!
+    \since 6.0
+
+    Returns the number of milliseconds since 1970-01-01T00:00:00.000, Coordinated
+    Universal Time, of the ISO 8601 date-time in \a string, or 0 if \a string is
+    not a valid date-time in that format.
+
+    The result is the same as
+    \c{fromString(QString::fromLatin1(string), Qt::ISODateWithMs).toMSecsSinceEpoch()}:
+    a date-time without a UTC offset is in local time, and a date on its own is
+    taken as the start of that day. For the layouts that toString(Qt::ISODate),
+    toString(Qt::ISODateWithMs) and \l{RFC 3339} produce, such as
+    \c{2020-07-14T09:53:28.123Z} or \c{2020-07-14 09:53:28+02:00}, this function
+    does not allocate memory, which makes it suitable for reading time stamps from
+    log files or other bulk data.
+
+    If \a ok is not \nullptr, \c{*ok} is set to \c true if \a string was parsed
+    successfully, and to \c false otherwise.
+
+    \sa fromString(), toMSecsSinceEpoch(), msecsSinceEpochFromIsoStrings()
+*/
+qint64 QDateTime::msecsSinceEpochFromIsoString(QByteArrayView string, bool *ok)
+{
+    IsoDateTimeFields fields;
+    if (parseIsoDateTimeFast(string.data(), string.size(), &fields)) {
+        if (fields.spec != Qt::LocalTime) {
+            if (ok)
+                *ok = true;
+            return fields.toMSecsSinceEpoch();
+        }
+        const QDateTime dateTime = fields.toDateTime();
+        if (ok)
+            *ok = dateTime.isValid();
+        return dateTime.isValid() ? dateTime.toMSecsSinceEpoch() : 0;
+    }
+
+    const QDateTime dateTime = fromString(QString::fromLatin1(string.data(), string.size()),
+                                          Qt::ISODateWithMs);
+    if (ok)
+        *ok = dateTime.isValid();
+    return dateTime.isValid() ? dateTime.toMSecsSinceEpoch() : 0;
+}
+
+/*!
+    \fn qint64 QDateTime::msecsSinceEpochFromIsoString(QLatin1String string, bool *ok)
+    \since 6.0
+    \overload
+*/
+
+/*!
+    \since 6.0
+
+    Parses the ISO 8601 date-times in \a column, separated by \a separator, into
+    the array \a msecs, which has room for \a maxCount values, and returns the
+    number of values stored. Each field is converted as
+    msecsSinceEpochFromIsoString() would, after removing the whitespace around
+    it; this allows for \c{"\r\n"} line endings when \a separator is \c{'\n'}. A
+    separator at the very end of \a column does not start another field.
+
+    If \a ok is not \nullptr, \c{*ok} is set to \c false if a field could not be
+    converted, and to \c true otherwise. Parsing stops at the first field that
+    cannot be converted and at \a maxCount values; the values before it are
+    stored.
+
+    \sa msecsSinceEpochFromIsoString(), fromString()
+*/
+qsizetype QDateTime::msecsSinceEpochFromIsoStrings(QByteArrayView column, qint64 *msecs,
+                                                   qsizetype maxCount, char separator, bool *ok)
+{
+    const char *p = column.data();
+    const char *const end = p + column.size();
+    qsizetype count = 0;
+    bool allOk = true;
+    while (p != end && count < maxCount) {
+        const char *fieldEnd = static_cast<const char *>(memchr(p, separator, end - p));
+        if (!fieldEnd)
+            fieldEnd = end;
+        const char *fieldBegin = p;
+        p = fieldEnd == end ? end : fieldEnd + 1;
+        while (fieldBegin != fieldEnd && ascii_isspace(*fieldBegin))
+            ++fieldBegin;
+        while (fieldEnd != fieldBegin && ascii_isspace(fieldEnd[-1]))
+            --fieldEnd;
+
+        bool fieldOk = false;
+        const qint64 value = msecsSinceEpochFromIsoString(
+                QByteArrayView(fieldBegin, fieldEnd - fieldBegin), &fieldOk);
+        if (!fieldOk) {
+            allOk = false;
+            break;
+        }
+        msecs[count++] = value;
+    }
+    if (ok)
+        *ok = allOk;
+    return count;
+}
+
 #endif // datestring
 /*!
     \fn QDateTime QDateTime::toLocalTime() const
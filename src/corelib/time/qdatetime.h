@@ -338,6 +338,12 @@ public:
     static QDateTime fromString(const QString &s, Qt::DateFormat f = Qt::TextDate);
     static QDateTime fromString(const QString &s, const QString &format,
                                 QCalendar cal = QCalendar());
+    static qint64 msecsSinceEpochFromIsoString(QByteArrayView string, bool *ok = nullptr);
+    static qint64 msecsSinceEpochFromIsoString(QLatin1String string, bool *ok = nullptr)
+    { return msecsSinceEpochFromIsoString(QByteArrayView(string.data(), string.size()), ok); }
+    static qsizetype msecsSinceEpochFromIsoStrings(QByteArrayView column, qint64 *msecs,
+                                                   qsizetype maxCount, char separator = '\n',
+                                                   bool *ok = nullptr);
 #endif
 
     static QDateTime fromMSecsSinceEpoch(qint64 msecs, Qt::TimeSpec spec = Qt::LocalTime,
@@ -53,6 +53,7 @@
 //
 
 #include "qlist.h"
+#include "qsharedpointer.h"
 #include "qtimezone.h"
 #include "private/qlocale_p.h"
 
@@ -290,14 +291,19 @@ constexpr inline bool operator==(const QTzTransitionRule &lhs, const QTzTransiti
 constexpr inline bool operator!=(const QTzTransitionRule &lhs, const QTzTransitionRule &rhs) noexcept
 { return !operator==(lhs, rhs); }
 
+class QTzPosixTransitions;
+
 // These are stored separately from QTzTimeZonePrivate so that they can be
 // cached, avoiding the need to re-parse them from disk constantly.
 struct QTzTimeZoneCacheEntry
 {
     QList<QTzTransitionTime> m_tranTimes;
     QList<QTzTransitionRule> m_tranRules;
-    QList<QByteArray> m_abbreviations;
+    QList<QString> m_abbreviations;
     QByteArray m_posixRule;
+    // Expansions of m_posixRule, computed on demand and shared between threads:
+    QSharedPointer<const QTzPosixTransitions> m_posixTransitions;
+    bool m_hasDaylightTime = false;
 };
 
 class Q_AUTOTEST_EXPORT QTzTimeZonePrivate final : public QTimeZonePrivate
@@ -347,11 +353,12 @@ private:
     QList<QTimeZonePrivate::Data> getPosixTransitions(qint64 msNear) const;
 
     Data dataForTzTransition(QTzTransitionTime tran) const;
+    const QTzTransitionTime &transitionAt(qint64 atMSecsSinceEpoch) const;
 #if QT_CONFIG(icu)
     mutable QSharedDataPointer<QTimeZonePrivate> m_icu;
 #endif
     QTzTimeZoneCacheEntry cached_data;
-    QList<QTzTransitionTime> tranCache() const { return cached_data.m_tranTimes; }
+    const QList<QTzTransitionTime> &tranCache() const { return cached_data.m_tranTimes; }
 };
 #endif // Q_OS_UNIX
 
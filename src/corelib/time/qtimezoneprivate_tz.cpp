@@ -41,6 +41,7 @@
 
 #include "qtimezone.h"
 #include "qtimezoneprivate_p.h"
+#include "qgregoriancalendar_p.h"
 #include "private/qlocale_tools_p.h"
 
 #include <QtCore/QDataStream>
@@ -632,6 +633,134 @@ static QList<QTimeZonePrivate::Data> calculatePosixTransitions(const QByteArray
     return result;
 }
 
+/*
+    The transitions of a POSIX rule, expanded once per year and zone.
+
+    Expanding a rule means parsing it and doing calendar arithmetic for each
+    transition, which data() used to do for three years on every call after the
+    last transition of the TZif file. The expansions of the years around the
+    present are computed on first use and then kept, shared by all instances and
+    threads using the zone; they are published with an atomic compare-and-swap,
+    so readers never take a lock.
+*/
+class QTzPosixTransitions
+{
+public:
+    struct Year
+    {
+        QTimeZonePrivate::Data transitions[2];
+        int count = 0;
+    };
+
+    explicit QTzPosixTransitions(const QByteArray &posixRule);
+    ~QTzPosixTransitions();
+    Q_DISABLE_COPY_MOVE(QTzPosixTransitions)
+
+    // A rule without daylight-saving time has the same data at all times:
+    const QTimeZonePrivate::Data *constantData() const
+    { return m_isConstant ? &m_constant.transitions[0] : nullptr; }
+
+    // Returns the transitions in year, using scratch for years that are not cached
+    const Year &year(int year, Year *scratch) const;
+
+private:
+    void expand(int year, Year *into) const;
+
+    enum { FirstCachedYear = 1900, CachedYearCount = 256 };
+    const QByteArray m_posixRule;
+    Year m_constant;
+    bool m_isConstant;
+    mutable QAtomicPointer<Year> m_years[CachedYearCount];
+};
+
+QTzPosixTransitions::QTzPosixTransitions(const QByteArray &posixRule)
+    : m_posixRule(posixRule),
+      m_isConstant(!posixRule.contains(','))
+{
+    if (m_isConstant)
+        expand(1970, &m_constant);
+}
+
+QTzPosixTransitions::~QTzPosixTransitions()
+{
+    for (QAtomicPointer<Year> &year : m_years)
+        delete year.loadRelaxed();
+}
+
+void QTzPosixTransitions::expand(int year, Year *into) const
+{
+    into->count = 0;
+    if (year == 0 || year < int(QDateTime::YearRange::First)
+        || year > int(QDateTime::YearRange::Last)) {
+        return;
+    }
+    const QList<QTimeZonePrivate::Data> transitions
+            = calculatePosixTransitions(m_posixRule, year, year, 0);
+    Q_ASSERT(transitions.size() <= 2);
+    for (const QTimeZonePrivate::Data &data : transitions)
+        into->transitions[into->count++] = data;
+}
+
+const QTzPosixTransitions::Year &QTzPosixTransitions::year(int year, Year *scratch) const
+{
+    const int index = year - FirstCachedYear;
+    if (index < 0 || index >= CachedYearCount) {
+        expand(year, scratch);
+        return *scratch;
+    }
+    if (const Year *cached = m_years[index].loadAcquire())
+        return *cached;
+    Year *expanded = new Year;
+    expand(year, expanded);
+    if (!m_years[index].testAndSetOrdered(nullptr, expanded)) {
+        delete expanded; // another thread was faster
+        return *m_years[index].loadAcquire();
+    }
+    return *expanded;
+}
+
+// The year, in UTC, of a time, as QDateTime::fromMSecsSinceEpoch(msecs, Qt::UTC) sees it:
+static int yearOfMSecsSinceEpoch(qint64 msecs)
+{
+    constexpr qint64 msecsPerDay = 86400000;
+    const qint64 days = msecs / msecsPerDay - (msecs % msecsPerDay < 0 ? 1 : 0);
+    return QGregorianCalendar::partsFromJulian(days + 2440588).year; // 2440588 is 1970-01-01
+}
+
+/*
+    Returns the data of the POSIX rule in effect at atMSecsSinceEpoch, or nullptr
+    if the transitions of the TZif file apply instead. The result points into the
+    shared expansions or into scratch, so it only lives as long as both.
+*/
+static const QTimeZonePrivate::Data *posixDataAt(const QTzTimeZoneCacheEntry &entry,
+                                                 qint64 atMSecsSinceEpoch,
+                                                 QTzPosixTransitions::Year scratch[3])
+{
+    // The rule only applies after the last transition (or if there were none):
+    if (!entry.m_posixTransitions
+        || (!entry.m_tranTimes.isEmpty()
+            && entry.m_tranTimes.last().atMSecsSinceEpoch >= atMSecsSinceEpoch)) {
+        return nullptr;
+    }
+    if (const QTimeZonePrivate::Data *constant = entry.m_posixTransitions->constantData())
+        return constant;
+
+    // Use the most recent transition, if any in the past, of the years around
+    // the time; or the first one if we have no other rules:
+    const QTimeZonePrivate::Data *previous = nullptr;
+    const int year = yearOfMSecsSinceEpoch(atMSecsSinceEpoch);
+    for (int i = 0; i < 3; ++i) {
+        const auto &expansion = entry.m_posixTransitions->year(year - 1 + i, &scratch[i]);
+        for (int j = 0; j < expansion.count; ++j) {
+            const QTimeZonePrivate::Data &data = expansion.transitions[j];
+            if (data.atMSecsSinceEpoch > atMSecsSinceEpoch)
+                return previous ? previous : entry.m_tranTimes.isEmpty() ? &data : nullptr;
+            previous = &data;
+        }
+    }
+    return previous;
+}
+
 // Create the system default time zone
 QTzTimeZonePrivate::QTzTimeZonePrivate()
 {
@@ -750,7 +879,7 @@ QTzTimeZoneCacheEntry QTzTimeZoneCache::findEntry(const QByteArray &ianaId)
     QList<int> abbrindList;
     abbrindList.reserve(size);
     for (auto it = abbrevMap.cbegin(), end = abbrevMap.cend(); it != end; ++it) {
-        ret.m_abbreviations.append(it.value());
+        ret.m_abbreviations.append(QString::fromUtf8(it.value()));
         abbrindList.append(it.key());
     }
     for (int i = 0; i < typeList.size(); ++i)
@@ -848,6 +977,12 @@ QTzTimeZoneCacheEntry QTzTimeZoneCache::fetchEntry(const QByteArray &ianaId)
 
     // ... or build a new entry from scratch
     QTzTimeZoneCacheEntry ret = findEntry(ianaId);
+    if (!ret.m_posixRule.isEmpty())
+        ret.m_posixTransitions = QSharedPointer<const QTzPosixTransitions>::create(ret.m_posixRule);
+    ret.m_hasDaylightTime = std::any_of(ret.m_tranRules.cbegin(), ret.m_tranRules.cend(),
+                                        [](const QTzTransitionRule &rule) {
+                                            return rule.dstOffset != 0;
+                                        });
     m_cache[ianaId] = ret;
     return ret;
 }
@@ -965,30 +1100,43 @@ QString QTzTimeZonePrivate::abbreviation(qint64 atMSecsSinceEpoch) const
     return data(atMSecsSinceEpoch).abbreviation;
 }
 
+// The offset getters look the rule up directly, instead of building all of data():
+
 int QTzTimeZonePrivate::offsetFromUtc(qint64 atMSecsSinceEpoch) const
 {
-    const QTimeZonePrivate::Data tran = data(atMSecsSinceEpoch);
-    return tran.offsetFromUtc; // == tran.standardTimeOffset + tran.daylightTimeOffset
+    QTzPosixTransitions::Year scratch[3];
+    if (const Data *posix = posixDataAt(cached_data, atMSecsSinceEpoch, scratch))
+        return posix->offsetFromUtc;
+    if (tranCache().isEmpty())
+        return invalidSeconds();
+    const QTzTransitionRule &rule
+            = cached_data.m_tranRules.at(transitionAt(atMSecsSinceEpoch).ruleIndex);
+    return rule.stdOffset + rule.dstOffset;
 }
 
 int QTzTimeZonePrivate::standardTimeOffset(qint64 atMSecsSinceEpoch) const
 {
-    return data(atMSecsSinceEpoch).standardTimeOffset;
+    QTzPosixTransitions::Year scratch[3];
+    if (const Data *posix = posixDataAt(cached_data, atMSecsSinceEpoch, scratch))
+        return posix->standardTimeOffset;
+    if (tranCache().isEmpty())
+        return invalidSeconds();
+    return cached_data.m_tranRules.at(transitionAt(atMSecsSinceEpoch).ruleIndex).stdOffset;
 }
 
 int QTzTimeZonePrivate::daylightTimeOffset(qint64 atMSecsSinceEpoch) const
 {
-    return data(atMSecsSinceEpoch).daylightTimeOffset;
+    QTzPosixTransitions::Year scratch[3];
+    if (const Data *posix = posixDataAt(cached_data, atMSecsSinceEpoch, scratch))
+        return posix->daylightTimeOffset;
+    if (tranCache().isEmpty())
+        return invalidSeconds();
+    return cached_data.m_tranRules.at(transitionAt(atMSecsSinceEpoch).ruleIndex).dstOffset;
 }
 
 bool QTzTimeZonePrivate::hasDaylightTime() const
 {
-    // TODO Perhaps cache as frequently accessed?
-    for (const QTzTransitionRule &rule : cached_data.m_tranRules) {
-        if (rule.dstOffset != 0)
-            return true;
-    }
-    return false;
+    return cached_data.m_hasDaylightTime;
 }
 
 bool QTzTimeZonePrivate::isDaylightTime(qint64 atMSecsSinceEpoch) const
@@ -1004,47 +1152,57 @@ QTimeZonePrivate::Data QTzTimeZonePrivate::dataForTzTransition(QTzTransitionTime
     data.standardTimeOffset = rule.stdOffset;
     data.daylightTimeOffset = rule.dstOffset;
     data.offsetFromUtc = rule.stdOffset + rule.dstOffset;
-    data.abbreviation = QString::fromUtf8(cached_data.m_abbreviations.at(rule.abbreviationIndex));
+    data.abbreviation = cached_data.m_abbreviations.at(rule.abbreviationIndex);
     return data;
 }
 
 QList<QTimeZonePrivate::Data> QTzTimeZonePrivate::getPosixTransitions(qint64 msNear) const
 {
-    const int year = QDateTime::fromMSecsSinceEpoch(msNear, Qt::UTC).date().year();
-    // The Data::atMSecsSinceEpoch of the single entry if zone is constant:
-    qint64 atTime = tranCache().isEmpty() ? msNear : tranCache().last().atMSecsSinceEpoch;
-    return calculatePosixTransitions(cached_data.m_posixRule, year - 1, year + 1, atTime);
+    const int year = yearOfMSecsSinceEpoch(msNear);
+    if (cached_data.m_posixTransitions->constantData()) {
+        // The Data::atMSecsSinceEpoch of the single entry if zone is constant:
+        qint64 atTime = tranCache().isEmpty() ? msNear : tranCache().last().atMSecsSinceEpoch;
+        return calculatePosixTransitions(cached_data.m_posixRule, year - 1, year + 1, atTime);
+    }
+
+    QList<QTimeZonePrivate::Data> result;
+    QTzPosixTransitions::Year scratch;
+    for (int i = year - 1; i <= year + 1; ++i) {
+        const auto &expansion = cached_data.m_posixTransitions->year(i, &scratch);
+        for (int j = 0; j < expansion.count; ++j)
+            result << expansion.transitions[j];
+    }
+    return result;
+}
+
+// The most recent transition at a time, or the first one; tranCache() must not be empty.
+const QTzTransitionTime &QTzTimeZonePrivate::transitionAt(qint64 atMSecsSinceEpoch) const
+{
+    Q_ASSERT(!tranCache().isEmpty());
+    auto last = std::partition_point(tranCache().cbegin(), tranCache().cend(),
+                                     [atMSecsSinceEpoch] (const QTzTransitionTime &at) {
+                                         return at.atMSecsSinceEpoch <= atMSecsSinceEpoch;
+                                     });
+    if (last > tranCache().cbegin())
+        --last;
+    return *last;
 }
 
 QTimeZonePrivate::Data QTzTimeZonePrivate::data(qint64 forMSecsSinceEpoch) const
 {
     // If the required time is after the last transition (or there were none)
     // and we have a POSIX rule, then use it:
-    if (!cached_data.m_posixRule.isEmpty()
-        && (tranCache().isEmpty() || tranCache().last().atMSecsSinceEpoch < forMSecsSinceEpoch)) {
-        QList<QTimeZonePrivate::Data> posixTrans = getPosixTransitions(forMSecsSinceEpoch);
-        auto it = std::partition_point(posixTrans.cbegin(), posixTrans.cend(),
-                                       [forMSecsSinceEpoch] (const QTimeZonePrivate::Data &at) {
-                                           return at.atMSecsSinceEpoch <= forMSecsSinceEpoch;
-                                       });
-        // Use most recent, if any in the past; or the first if we have no other rules:
-        if (it > posixTrans.cbegin() || (tranCache().isEmpty() && it < posixTrans.cend())) {
-            QTimeZonePrivate::Data data = *(it > posixTrans.cbegin() ? it - 1 : it);
-            data.atMSecsSinceEpoch = forMSecsSinceEpoch;
-            return data;
-        }
+    QTzPosixTransitions::Year scratch[3];
+    if (const Data *posix = posixDataAt(cached_data, forMSecsSinceEpoch, scratch)) {
+        QTimeZonePrivate::Data data = *posix;
+        data.atMSecsSinceEpoch = forMSecsSinceEpoch;
+        return data;
     }
     if (tranCache().isEmpty()) // Only possible if !isValid()
         return invalidData();
 
     // Otherwise, use the rule for the most recent or first transition:
-    auto last = std::partition_point(tranCache().cbegin(), tranCache().cend(),
-                                     [forMSecsSinceEpoch] (const QTzTransitionTime &at) {
-                                         return at.atMSecsSinceEpoch <= forMSecsSinceEpoch;
-                                     });
-    if (last > tranCache().cbegin())
-        --last;
-    Data data = dataForTzTransition(*last);
+    Data data = dataForTzTransition(transitionAt(forMSecsSinceEpoch));
     data.atMSecsSinceEpoch = forMSecsSinceEpoch;
     return data;
 }
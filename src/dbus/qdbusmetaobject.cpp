@@ -422,7 +422,7 @@ void QDBusMetaObjectGenerator::write(QDBusMetaObject *obj)
             - methods.count(); // ditto
 
     QDBusMetaObjectPrivate *header = reinterpret_cast<QDBusMetaObjectPrivate *>(idata.data());
-    static_assert(QMetaObjectPrivate::OutputRevision == 9, "QtDBus meta-object generator should generate the same version as moc");
+    static_assert(QMetaObjectPrivate::OutputRevision == 10, "QtDBus meta-object generator should generate the same version as moc");
     header->revision = QMetaObjectPrivate::OutputRevision;
     header->className = 0;
     header->classInfoCount = 0;
@@ -437,6 +437,7 @@ void QDBusMetaObjectGenerator::write(QDBusMetaObject *obj)
     header->constructorData = 0;
     header->flags = RequiresVariantMetaObject;
     header->signalCount = signals_.count();
+    header->nameHashData = 0;
     // These are specific to QDBusMetaObject:
     header->propertyDBusData = header->propertyData + header->propertyCount * QMetaObjectPrivate::IntsPerProperty;
     header->methodDBusData = header->propertyDBusData + header->propertyCount * intsPerProperty;
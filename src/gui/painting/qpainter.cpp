@@ -75,6 +75,8 @@
 #include <private/qguiapplication_p.h>
 #include <private/qrawfont_p.h>
 
+#include <qtgui_tracepoints_p.h>
+
 QT_BEGIN_NAMESPACE
 
 #define QGradient_StretchToDevice 0x10000000
@@ -3197,6 +3199,10 @@ void QPainter::drawPath(const QPainterPath &path)
         return;
     }
 
+    // only count the elements when somebody is listening
+    Q_TRACE_SCOPE(QPainter_drawPath,
+                  Q_TRACE_ENABLED(QPainter_drawPath_entry) ? path.elementCount() : 0);
+
     if (d->extended) {
         d->extended->drawPath(path);
         return;
@@ -3312,6 +3318,8 @@ void QPainter::drawRects(const QRectF *rects, int rectCount)
     if (rectCount <= 0)
         return;
 
+    Q_TRACE_SCOPE(QPainter_drawRects, rectCount);
+
     if (d->extended) {
         d->extended->drawRects(rects, rectCount);
         return;
@@ -3372,6 +3380,8 @@ void QPainter::drawRects(const QRect *rects, int rectCount)
     if (rectCount <= 0)
         return;
 
+    Q_TRACE_SCOPE(QPainter_drawRects, rectCount);
+
     if (d->extended) {
         d->extended->drawRects(rects, rectCount);
         return;
@@ -3472,6 +3482,8 @@ void QPainter::drawPoints(const QPointF *points, int pointCount)
     if (pointCount <= 0)
         return;
 
+    Q_TRACE_SCOPE(QPainter_drawPoints, pointCount);
+
     if (d->extended) {
         d->extended->drawPoints(points, pointCount);
         return;
@@ -3534,6 +3546,8 @@ void QPainter::drawPoints(const QPoint *points, int pointCount)
     if (pointCount <= 0)
         return;
 
+    Q_TRACE_SCOPE(QPainter_drawPoints, pointCount);
+
     if (d->extended) {
         d->extended->drawPoints(points, pointCount);
         return;
@@ -4006,6 +4020,8 @@ void QPainter::drawEllipse(const QRectF &r)
     if (!d->engine)
         return;
 
+    Q_TRACE_SCOPE(QPainter_drawEllipse, r.x(), r.y(), r.width(), r.height());
+
     QRectF rect(r.normalized());
 
     if (d->extended) {
@@ -4047,6 +4063,8 @@ void QPainter::drawEllipse(const QRect &r)
     if (!d->engine)
         return;
 
+    Q_TRACE_SCOPE(QPainter_drawEllipse, r.x(), r.y(), r.width(), r.height());
+
     QRect rect(r.normalized());
 
     if (d->extended) {
@@ -4312,6 +4330,8 @@ void QPainter::drawLines(const QLineF *lines, int lineCount)
     if (!d->engine || lineCount < 1)
         return;
 
+    Q_TRACE_SCOPE(QPainter_drawLines, lineCount);
+
     if (d->extended) {
         d->extended->drawLines(lines, lineCount);
         return;
@@ -4361,6 +4381,8 @@ void QPainter::drawLines(const QLine *lines, int lineCount)
     if (!d->engine || lineCount < 1)
         return;
 
+    Q_TRACE_SCOPE(QPainter_drawLines, lineCount);
+
     if (d->extended) {
         d->extended->drawLines(lines, lineCount);
         return;
@@ -4596,6 +4618,8 @@ void QPainter::drawPolygon(const QPointF *points, int pointCount, Qt::FillRule f
     if (!d->engine || pointCount < 2)
         return;
 
+    Q_TRACE_SCOPE(QPainter_drawPolygon, pointCount, fillRule);
+
     if (d->extended) {
         d->extended->drawPolygon(points, pointCount, QPaintEngine::PolygonDrawMode(fillRule));
         return;
@@ -4635,6 +4659,8 @@ void QPainter::drawPolygon(const QPoint *points, int pointCount, Qt::FillRule fi
     if (!d->engine || pointCount < 2)
         return;
 
+    Q_TRACE_SCOPE(QPainter_drawPolygon, pointCount, fillRule);
+
     if (d->extended) {
         d->extended->drawPolygon(points, pointCount, QPaintEngine::PolygonDrawMode(fillRule));
         return;
@@ -4734,6 +4760,8 @@ void QPainter::drawConvexPolygon(const QPoint *points, int pointCount)
     if (!d->engine || pointCount < 2)
         return;
 
+    Q_TRACE_SCOPE(QPainter_drawConvexPolygon, pointCount);
+
     if (d->extended) {
         d->extended->drawPolygon(points, pointCount, QPaintEngine::ConvexMode);
         return;
@@ -4768,6 +4796,8 @@ void QPainter::drawConvexPolygon(const QPointF *points, int pointCount)
     if (!d->engine || pointCount < 2)
         return;
 
+    Q_TRACE_SCOPE(QPainter_drawConvexPolygon, pointCount);
+
     if (d->extended) {
         d->extended->drawPolygon(points, pointCount, QPaintEngine::ConvexMode);
         return;
@@ -4834,6 +4864,8 @@ void QPainter::drawPixmap(const QPointF &p, const QPixmap &pm)
     if (!d->engine || pm.isNull())
         return;
 
+    Q_TRACE_SCOPE(QPainter_drawPixmap, p.x(), p.y(), pm.width(), pm.height(), pm.width(), pm.height());
+
 #ifndef QT_NO_DEBUG
     qt_painter_thread_test(d->device->devType(), d->engine->type(), "drawPixmap()");
 #endif
@@ -4905,6 +4937,8 @@ void QPainter::drawPixmap(const QRectF &r, const QPixmap &pm, const QRectF &sr)
     Q_D(QPainter);
     if (!d->engine || pm.isNull())
         return;
+
+    Q_TRACE_SCOPE(QPainter_drawPixmap, r.x(), r.y(), r.width(), r.height(), pm.width(), pm.height());
 #ifndef QT_NO_DEBUG
     qt_painter_thread_test(d->device->devType(), d->engine->type(), "drawPixmap()");
 #endif
@@ -5136,6 +5170,8 @@ void QPainter::drawImage(const QPointF &p, const QImage &image)
     if (!d->engine || image.isNull())
         return;
 
+    Q_TRACE_SCOPE(QPainter_drawImage, p.x(), p.y(), image.width(), image.height(), image.width(), image.height());
+
     if (d->extended) {
         d->extended->drawImage(p, image);
         return;
@@ -5192,6 +5228,8 @@ void QPainter::drawImage(const QRectF &targetRect, const QImage &image, const QR
     if (!d->engine || image.isNull())
         return;
 
+    Q_TRACE_SCOPE(QPainter_drawImage, targetRect.x(), targetRect.y(), targetRect.width(), targetRect.height(), image.width(), image.height());
+
     qreal x = targetRect.x();
     qreal y = targetRect.y();
     qreal w = targetRect.width();
@@ -5318,6 +5356,10 @@ void QPainter::drawGlyphRun(const QPointF &position, const QGlyphRun &glyphRun)
         return;
     }
 
+    Q_TRACE_SCOPE(QPainter_drawGlyphRun,
+                  Q_TRACE_ENABLED(QPainter_drawGlyphRun_entry)
+                  ? int(glyphRun.glyphIndexes().size()) : 0);
+
     QRawFont font = glyphRun.rawFont();
     if (!font.isValid())
         return;
@@ -5620,6 +5662,8 @@ void QPainter::drawText(const QPointF &p, const QString &str, int tf, int justif
     if (!d->engine || str.isEmpty() || pen().style() == Qt::NoPen)
         return;
 
+    Q_TRACE_SCOPE(QPainter_drawText, p.x(), p.y(), str.size());
+
     QStackTextEngine engine(str, d->state->font);
     engine.option.setTextDirection(d->state->layoutDirection);
     if (tf & (Qt::TextForceLeftToRight|Qt::TextForceRightToLeft)) {
@@ -5773,6 +5817,8 @@ void QPainter::drawText(const QRectF &r, int flags, const QString &str, QRectF *
     if (!d->engine || str.length() == 0 || pen().style() == Qt::NoPen)
         return;
 
+    Q_TRACE_SCOPE(QPainter_drawText, r.x(), r.y(), str.size());
+
     if (!d->extended)
         d->updateState(d->state);
 
@@ -5892,6 +5938,8 @@ void QPainter::drawText(const QRectF &r, const QString &text, const QTextOption
     if (!d->engine || text.length() == 0 || pen().style() == Qt::NoPen)
         return;
 
+    Q_TRACE_SCOPE(QPainter_drawText, r.x(), r.y(), text.size());
+
     if (!d->extended)
         d->updateState(d->state);
 
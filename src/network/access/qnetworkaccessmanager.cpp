@@ -82,6 +82,8 @@
 
 #include <QtCore/private/qfactoryloader_p.h>
 
+#include <qtnetwork_tracepoints_p.h>
+
 #if defined(Q_OS_MACOS)
 #include <CoreServices/CoreServices.h>
 #include <SystemConfiguration/SystemConfiguration.h>
@@ -1134,6 +1136,7 @@ QNetworkReply *QNetworkAccessManager::createRequest(QNetworkAccessManager::Opera
                                                     QIODevice *outgoingData)
 {
     Q_D(QNetworkAccessManager);
+    Q_TRACE_SCOPE(QNetworkAccessManager_createRequest, this, op, originalReq.url());
 
     QNetworkRequest req(originalReq);
     if (redirectPolicy() != QNetworkRequest::NoLessSafeRedirectPolicy
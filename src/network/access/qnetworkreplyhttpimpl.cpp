@@ -63,6 +63,8 @@
 
 #include "qnetworkreplyimpl_p.h"
 
+#include <qtnetwork_tracepoints_p.h>
+
 #include <string.h>             // for strchr
 
 QT_BEGIN_NAMESPACE
@@ -608,6 +610,7 @@ QHttpNetworkRequest::Priority QNetworkReplyHttpImplPrivate::convert(const QNetwo
 void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpRequest)
 {
     Q_Q(QNetworkReplyHttpImpl);
+    Q_TRACE(QNetworkReplyHttpImpl_postRequest, q, newHttpRequest.url(), synchronous);
 
     QThread *thread = nullptr;
     if (synchronous) {
@@ -1029,6 +1032,8 @@ void QNetworkReplyHttpImplPrivate::replyDownloadData(QByteArray d)
     if (!q->isOpen())
         return;
 
+    Q_TRACE(QNetworkReplyHttpImpl_dataReceived, q, d.size());
+
     if (cacheEnabled && isCachingAllowed() && !cacheSaveDevice)
         initCacheSaveDevice();
 
@@ -1234,6 +1239,7 @@ void QNetworkReplyHttpImplPrivate::replyDownloadMetaData(const QList<QPair<QByte
                                                          bool h2Used)
 {
     Q_Q(QNetworkReplyHttpImpl);
+    Q_TRACE(QNetworkReplyHttpImpl_metaDataReceived, q, sc, contentLength, h2Used);
     Q_UNUSED(contentLength);
 
     statusCode = sc;
@@ -1404,6 +1410,7 @@ void QNetworkReplyHttpImplPrivate::httpError(QNetworkReply::NetworkError errorCo
 #if defined(QNETWORKACCESSHTTPBACKEND_DEBUG)
     qDebug() << "http error!" << errorCode << errorString;
 #endif
+    Q_TRACE(QNetworkReplyHttpImpl_error, q_func(), errorCode);
 
     // FIXME?
     error(errorCode, errorString);
@@ -1988,6 +1995,8 @@ void QNetworkReplyHttpImplPrivate::finished()
     if (state == Finished || state == Aborted)
         return;
 
+    Q_TRACE(QNetworkReplyHttpImpl_finished, q, bytesDownloaded);
+
     QVariant totalSize = cookedHeaders.value(QNetworkRequest::ContentLengthHeader);
 
     // if we don't know the total size of or we received everything save the cache
@@ -24,4 +24,7 @@ include(ssl/ssl.pri)
 
 QMAKE_LIBS += $$QMAKE_LIBS_NETWORK
 
+TRACEPOINT_PROVIDER = $$PWD/qtnetwork.tracepoints
+CONFIG += qt_tracepoints
+
 load(qt_module)
@@ -897,6 +897,27 @@ bool QAbstractSocketPrivate::flush()
     return dataWasWritten;
 }
 
+/*! \internal
+
+    Returns the socket descriptor of a connected TCP socket that has no data
+    waiting in its write buffers, so that QIODevice::transferTo() can send
+    file data directly. Proxied sockets and sockets without a socket engine
+    of their own, such as QSslSocket, do not qualify.
+*/
+int QAbstractSocketPrivate::transferDescriptor(QIODevice::OpenModeFlag direction)
+{
+    if (direction != QIODevice::WriteOnly || socketType != QAbstractSocket::TcpSocket
+        || state != QAbstractSocket::ConnectedState || !socketEngine
+        || !allWriteBuffersEmpty()) {
+        return -1;
+    }
+#ifndef QT_NO_NETWORKPROXY
+    if (proxyInUse.type() != QNetworkProxy::NoProxy)
+        return -1;
+#endif
+    return int(socketEngine->socketDescriptor());
+}
+
 #ifndef QT_NO_NETWORKPROXY
 /*! \internal
 
@@ -130,6 +130,7 @@ public:
 
     void resetSocketLayer();
     virtual bool flush();
+    int transferDescriptor(QIODevice::OpenModeFlag direction) override;
 
     bool initSocketLayer(QAbstractSocket::NetworkLayerProtocol protocol);
     virtual void configureCreatedSocket();
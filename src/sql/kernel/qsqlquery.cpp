@@ -51,6 +51,8 @@
 #include "qsqldatabase.h"
 #include "private/qsqlnulldriver_p.h"
 
+#include <qtsql_tracepoints_p.h>
+
 QT_BEGIN_NAMESPACE
 
 class QSqlQueryPrivate
@@ -376,6 +378,10 @@ bool QSqlQuery::exec(const QString& query)
     QElapsedTimer t;
     t.start();
 #endif
+    bool retval = false;
+    Q_TRACE(QSqlQuery_exec_entry, this, query);
+    Q_TRACE_EXIT(QSqlQuery_exec_exit, retval);
+
     if (d->ref.loadRelaxed() != 1) {
         bool fo = isForwardOnly();
         *this = QSqlQuery(driver()->createResult());
@@ -398,7 +404,7 @@ bool QSqlQuery::exec(const QString& query)
         return false;
     }
 
-    bool retval = d->sqlResult->reset(query);
+    retval = d->sqlResult->reset(query);
 #ifdef QT_DEBUG_SQL
     qDebug().nospace() << "Executed query (" << t.elapsed() << "ms, " << d->sqlResult->size()
                        << " results, " << d->sqlResult->numRowsAffected()
@@ -1006,12 +1012,16 @@ bool QSqlQuery::exec()
     QElapsedTimer t;
     t.start();
 #endif
+    bool retval = false;
+    Q_TRACE(QSqlQuery_execPrepared_entry, this);
+    Q_TRACE_EXIT(QSqlQuery_execPrepared_exit, retval);
+
     d->sqlResult->resetBindCount();
 
     if (d->sqlResult->lastError().isValid())
         d->sqlResult->setLastError(QSqlError());
 
-    bool retval = d->sqlResult->exec();
+    retval = d->sqlResult->exec();
 #ifdef QT_DEBUG_SQL
     qDebug().nospace() << "Executed prepared query (" << t.elapsed() << "ms, "
                        << d->sqlResult->size() << " results, " << d->sqlResult->numRowsAffected()
@@ -1071,8 +1081,13 @@ bool QSqlQuery::exec()
 */
 bool QSqlQuery::execBatch(BatchExecutionMode mode)
 {
+    bool retval = false;
+    Q_TRACE(QSqlQuery_execBatch_entry, this, mode);
+    Q_TRACE_EXIT(QSqlQuery_execBatch_exit, retval);
+
     d->sqlResult->resetBindCount();
-    return d->sqlResult->execBatch(mode == ValuesAsColumns);
+    retval = d->sqlResult->execBatch(mode == ValuesAsColumns);
+    return retval;
 }
 
 /*!
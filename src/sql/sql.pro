@@ -15,4 +15,7 @@ qtConfig(sqlmodel): include(models/models.pri)
 
 MODULE_PLUGIN_TYPES = \
     sqldrivers
+
+TRACEPOINT_PROVIDER = $$PWD/qtsql.tracepoints
+CONFIG += qt_tracepoints
 load(qt_module)
@@ -88,6 +88,7 @@ SOURCES += \
            ../../corelib/text/qbytearray.cpp \
            ../../corelib/text/qbytearraylist.cpp \
            ../../corelib/text/qbytearraymatcher.cpp \
+           ../../corelib/text/qfloatconversion.cpp \
            ../../corelib/text/qlocale.cpp \
            ../../corelib/text/qlocale_tools.cpp \
            ../../corelib/text/qregularexpression.cpp \
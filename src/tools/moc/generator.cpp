@@ -40,6 +40,9 @@
 #include <QtCore/qplugin.h>
 #include <QtCore/qstringview.h>
 
+#include <algorithm>
+#include <numeric>
+
 #include <math.h>
 #include <stdio.h>
 
@@ -380,6 +383,8 @@ void Generator::generateCode()
         index += 5 + (cdef->enumList.at(i).values.count() * 2);
     fprintf(out, "    %4d, %4d, // constructors\n", isConstructible ? int(cdef->constructorList.count()) : 0,
             isConstructible ? index : 0);
+    if (isConstructible)
+        index += cdef->constructorList.count() * QMetaObjectPrivate::IntsPerMethod;
 
     int flags = 0;
     if (cdef->hasQGadget || cdef->hasQNamespace) {
@@ -389,6 +394,9 @@ void Generator::generateCode()
     }
     fprintf(out, "    %4d,       // flags\n", flags);
     fprintf(out, "    %4d,       // signalCount\n", int(cdef->signalList.count()));
+    computeNameHash();
+    const int nameHashIndex = nameHashEntries.isEmpty() ? 0 : index;
+    fprintf(out, "    %4d,       // name hash\n", nameHashIndex);
 
 
 //
@@ -447,6 +455,12 @@ void Generator::generateCode()
     if (isConstructible)
         generateFunctions(cdef->constructorList, "constructor", MethodConstructor, paramsIndex, initialMetaTypeOffset);
 
+//
+// Build name hash
+//
+    if (nameHashIndex)
+        generateNameHash(nameHashIndex);
+
 //
 // Terminate data array
 //
@@ -798,6 +812,153 @@ void Generator::generateFunctionRevisions(const QList<FunctionDef> &list, const
     }
 }
 
+// Below this number of distinct names, a linear search is just as fast.
+static const int MinimumNameHashEntries = 8;
+
+void Generator::computeNameHash()
+{
+    nameHashEntries.clear();
+    nameHashSeeds.clear();
+    nameHashTable.clear();
+
+    QHash<QByteArray, int> entryForName;
+    const auto entry = [&](const QByteArray &name) -> NameHashEntry & {
+        auto it = entryForName.constFind(name);
+        if (it == entryForName.constEnd()) {
+            it = entryForName.insert(name, nameHashEntries.count());
+            nameHashEntries.append({ name, -1, {} });
+        }
+        return nameHashEntries[*it];
+    };
+    int methodIndex = 0;
+    for (const QList<FunctionDef> *list : { &cdef->signalList, &cdef->slotList, &cdef->methodList }) {
+        for (const FunctionDef &f : *list)
+            entry(f.name).methods.prepend(methodIndex++);
+    }
+    for (int i = 0; i < cdef->propertyList.count(); ++i) {
+        NameHashEntry &e = entry(cdef->propertyList.at(i).name);
+        if (e.property < 0)
+            e.property = i;
+    }
+
+    const int count = nameHashEntries.count();
+    if (count < MinimumNameHashEntries) {
+        nameHashEntries.clear();
+        return;
+    }
+
+    QList<uint> hashes;
+    hashes.reserve(count);
+    for (const NameHashEntry &e : qAsConst(nameHashEntries))
+        hashes.append(QMetaObjectPrivate::nameHash(e.name.constData(), e.name.size()));
+    QList<uint> sortedHashes = hashes;
+    std::sort(sortedHashes.begin(), sortedHashes.end());
+    if (std::adjacent_find(sortedHashes.begin(), sortedHashes.end()) != sortedHashes.end()) {
+        nameHashEntries.clear();    // no seed can separate these
+        return;
+    }
+
+    // about two names per bucket, and the table at most 80% full
+    int bucketCount = 1;
+    while (2 * bucketCount < count)
+        bucketCount *= 2;
+    int size = 1;
+    while (4 * size < 5 * count)
+        size *= 2;
+
+    QList<QList<int>> buckets(bucketCount);
+    for (int i = 0; i < count; ++i)
+        buckets[hashes.at(i) & uint(bucketCount - 1)].append(i);
+    QList<int> order(bucketCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&buckets](int a, int b) {
+        return buckets.at(a).count() > buckets.at(b).count();
+    });
+
+    for (;; size *= 2) {
+        QList<uint> seeds(bucketCount, 0);
+        QList<int> table(size, 0);
+        bool placed = true;
+        for (int b : qAsConst(order)) {
+            const QList<int> &bucket = buckets.at(b);
+            if (bucket.isEmpty())
+                break;
+            QList<uint> positions(bucket.count());
+            uint seed = 0;
+            for (; seed < 0x10000; ++seed) {
+                bool fits = true;
+                for (int i = 0; i < bucket.count() && fits; ++i) {
+                    positions[i] = QMetaObjectPrivate::nameHashSlot(hashes.at(bucket.at(i)), seed)
+                            & uint(size - 1);
+                    fits = !table.at(positions.at(i))
+                            && !std::count(positions.cbegin(), positions.cbegin() + i,
+                                           positions.at(i));
+                }
+                if (fits)
+                    break;
+            }
+            if (seed == 0x10000) {
+                placed = false;
+                break;
+            }
+            seeds[b] = seed;
+            for (int i = 0; i < bucket.count(); ++i)
+                table[positions.at(i)] = bucket.at(i) + 1;
+        }
+        if (placed) {
+            nameHashSeeds = seeds;
+            nameHashTable = table;
+            return;
+        }
+    }
+}
+
+int Generator::nameHashDataSize() const
+{
+    int size = QMetaObjectPrivate::NameHashHeaderSize + nameHashSeeds.count()
+            + nameHashTable.count();
+    for (const NameHashEntry &e : nameHashEntries)
+        size += QMetaObjectPrivate::NameHashEntryHeaderSize + e.methods.count();
+    return size;
+}
+
+void Generator::generateNameHash(int index)
+{
+    fprintf(out, "\n // name hash: buckets, size\n");
+    fprintf(out, "    %4d, %4d,\n", int(nameHashSeeds.count()), int(nameHashTable.count()));
+
+    fprintf(out, "\n // name hash: seeds\n   ");
+    for (int i = 0; i < nameHashSeeds.count(); ++i)
+        fprintf(out, "%s %4u,", (i && i % 8 == 0) ? "\n   " : "", nameHashSeeds.at(i));
+    fputc('\n', out);
+
+    // the entries follow the table
+    QList<int> entryIndexes;
+    int entryIndex = index + QMetaObjectPrivate::NameHashHeaderSize + nameHashSeeds.count()
+            + nameHashTable.count();
+    for (const NameHashEntry &e : qAsConst(nameHashEntries)) {
+        entryIndexes.append(entryIndex);
+        entryIndex += QMetaObjectPrivate::NameHashEntryHeaderSize + e.methods.count();
+    }
+
+    fprintf(out, "\n // name hash: table\n   ");
+    for (int i = 0; i < nameHashTable.count(); ++i) {
+        const int entry = nameHashTable.at(i);
+        fprintf(out, "%s %4d,", (i && i % 8 == 0) ? "\n   " : "",
+                entry ? entryIndexes.at(entry - 1) : 0);
+    }
+    fputc('\n', out);
+
+    fprintf(out, "\n // name hash: name, property, methodCount, methods\n");
+    for (const NameHashEntry &e : qAsConst(nameHashEntries)) {
+        fprintf(out, "    %4d, %4d, %4d,", stridx(e.name), e.property + 1, int(e.methods.count()));
+        for (int method : e.methods)
+            fprintf(out, " %4d,", method);
+        fputc('\n', out);
+    }
+    Q_ASSERT(entryIndex == index + nameHashDataSize());
+}
+
 void Generator::generateFunctionParameters(const QList<FunctionDef> &list, const char *functype)
 {
     if (list.isEmpty())
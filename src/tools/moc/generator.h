@@ -55,6 +55,9 @@ private:
                            int &paramsIndex, int &initialMetatypeOffset);
     void generateFunctionRevisions(const QList<FunctionDef> &list, const char *functype);
     void generateFunctionParameters(const QList<FunctionDef> &list, const char *functype);
+    void computeNameHash();
+    int nameHashDataSize() const;
+    void generateNameHash(int index);
     void generateTypeInfo(const QByteArray &typeName, bool allowEmptyName = false);
     void registerEnumStrings();
     void generateEnums(int index);
@@ -71,6 +74,15 @@ private:
     void strreg(const QByteArray &); // registers a string
     int stridx(const QByteArray &); // returns a string's id
     QList<QByteArray> strings;
+    struct NameHashEntry
+    {
+        QByteArray name;
+        int property;
+        QList<int> methods;
+    };
+    QList<NameHashEntry> nameHashEntries;
+    QList<uint> nameHashSeeds;
+    QList<int> nameHashTable;   // entry number + 1, or 0
     QByteArray purestSuperClass;
     QList<QByteArray> metaTypes;
     QHash<QByteArray, QByteArray> knownQObjectClasses;
@@ -0,0 +1,137 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the utils of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/qcommandlineparser.h>
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/private/qbinarylog_p.h>
+
+#include <cstdio>
+
+static QLatin1String typeName(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg: return QLatin1String("debug");
+    case QtInfoMsg: return QLatin1String("info");
+    case QtWarningMsg: return QLatin1String("warning");
+    case QtCriticalMsg: return QLatin1String("critical");
+    case QtFatalMsg: return QLatin1String("fatal");
+    }
+    return QLatin1String("unknown");
+}
+
+static bool convert(const QString &fileName, QFile &output)
+{
+    QFile input(fileName);
+    if (!input.open(QIODevice::ReadOnly)) {
+        fprintf(stderr, "qbinlog2json: cannot open %s: %s\n", qPrintable(fileName),
+                qPrintable(input.errorString()));
+        return false;
+    }
+
+    const qint64 size = input.size();
+    const uchar *mapped = input.map(0, size);
+    const QByteArray data = mapped
+            ? QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), qsizetype(size))
+            : input.readAll();
+
+    QBinaryLogReader reader(data);
+    QBinaryLog::Message message;
+    while (reader.readNext(&message)) {
+        QJsonObject object;
+        object.insert(QLatin1String("time"),
+                      QDateTime::fromMSecsSinceEpoch(message.wallClockMSecs, Qt::UTC)
+                          .toString(Qt::ISODateWithMs));
+        object.insert(QLatin1String("monotonic_ns"), message.monotonicNSecs);
+        object.insert(QLatin1String("pid"), reader.pid());
+        object.insert(QLatin1String("thread"), message.threadId);
+        object.insert(QLatin1String("type"), typeName(message.type));
+        if (!message.category.isNull())
+            object.insert(QLatin1String("category"), QString::fromUtf8(message.category));
+        if (!message.file.isNull())
+            object.insert(QLatin1String("file"), QString::fromUtf8(message.file));
+        if (message.line)
+            object.insert(QLatin1String("line"), message.line);
+        if (!message.function.isNull())
+            object.insert(QLatin1String("function"), QString::fromUtf8(message.function));
+        object.insert(QLatin1String("message"), message.message);
+        output.write(QJsonDocument(object).toJson(QJsonDocument::Compact));
+        output.write("\n", 1);
+    }
+
+    if (!reader.isValid()) {
+        fprintf(stderr, "qbinlog2json: %s: %s\n", qPrintable(fileName),
+                qPrintable(reader.errorString()));
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationVersion(QLatin1String(QT_VERSION_STR));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QLatin1String(
+            "Converts the binary logs written with QT_LOGGING_BINARY_FILE to JSON lines.\n"
+            "Rotated files are read in the order given; pass the oldest first."));
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption outputOption(QStringList() << QLatin1String("o") << QLatin1String("output"),
+                                    QLatin1String("Write to <file> instead of stdout."),
+                                    QLatin1String("file"));
+    parser.addOption(outputOption);
+    parser.addPositionalArgument(QLatin1String("files"), QLatin1String("Binary log files."),
+                                 QLatin1String("files..."));
+    parser.process(app);
+
+    const QStringList files = parser.positionalArguments();
+    if (files.isEmpty())
+        parser.showHelp(1);
+
+    QFile output;
+    if (parser.isSet(outputOption)) {
+        output.setFileName(parser.value(outputOption));
+        if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            fprintf(stderr, "qbinlog2json: cannot write %s: %s\n",
+                    qPrintable(output.fileName()), qPrintable(output.errorString()));
+            return 1;
+        }
+    } else if (!output.open(stdout, QIODevice::WriteOnly)) {
+        return 1;
+    }
+
+    bool ok = true;
+    for (const QString &file : files)
+        ok = convert(file, output) && ok;
+    return ok ? 0 : 1;
+}
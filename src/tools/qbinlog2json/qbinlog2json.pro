@@ -0,0 +1,13 @@
+option(host_build)
+QT = core-private
+
+SOURCES += \
+    main.cpp
+
+DEFINES += \
+    QT_NO_CAST_FROM_ASCII \
+    QT_NO_CAST_TO_ASCII \
+    QT_NO_FOREACH
+
+QMAKE_TARGET_DESCRIPTION = "Qt Binary Log to JSON Converter"
+load(qt_tool)
@@ -0,0 +1,253 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "ctf.h"
+#include "provider.h"
+#include "helpers.h"
+#include "panic.h"
+#include "qtheaders.h"
+
+#include <qfile.h>
+#include <qfileinfo.h>
+#include <qtextstream.h>
+
+static inline QString tracePointVar(const QString &providerName, const QString &name)
+{
+    return providerName + QLatin1Char('_') + name + QLatin1String("_tracepoint");
+}
+
+// returns the number of CTF fields written for 'field'
+static int writeFieldDescription(QTextStream &stream, const Tracepoint::Field &field)
+{
+    const QString &paramType = field.paramType;
+    const QString &name = field.name;
+
+    auto describe = [&stream](const QString &type, const QString &name, const char *kind) {
+        stream << "    QCtfTracePointField::make<" << type << ">(\"" << name
+               << "\", QCtfTracePointField::" << kind << "),\n";
+    };
+
+    switch (field.backendType) {
+    case Tracepoint::Field::Array:
+        stream << "    QCtfTracePointField::make<" << paramType << ">(\"" << name
+               << "\", QCtfTracePointField::Array, " << field.arrayLen << "),\n";
+        return 1;
+    case Tracepoint::Field::Sequence:
+        describe(paramType, name, "Sequence");
+        return 1;
+    case Tracepoint::Field::Integer:
+        describe(paramType, name, "Integer");
+        return 1;
+    case Tracepoint::Field::IntegerHex:
+        describe(paramType, name, "IntegerHex");
+        return 1;
+    case Tracepoint::Field::Pointer:
+        describe(QStringLiteral("quintptr"), name, "IntegerHex");
+        return 1;
+    case Tracepoint::Field::Float:
+        describe(paramType, name, "Float");
+        return 1;
+    case Tracepoint::Field::String:
+    case Tracepoint::Field::QtString:
+    case Tracepoint::Field::QtUrl:
+        describe(QStringLiteral("char"), name, "String");
+        return 1;
+    case Tracepoint::Field::QtByteArray:
+        describe(QStringLiteral("char"), name, "Sequence");
+        return 1;
+    case Tracepoint::Field::QtRect:
+        // prefixed, so that two rectangles in one event do not clash
+        describe(QStringLiteral("int"), name + QLatin1String("_x"), "Integer");
+        describe(QStringLiteral("int"), name + QLatin1String("_y"), "Integer");
+        describe(QStringLiteral("int"), name + QLatin1String("_width"), "Integer");
+        describe(QStringLiteral("int"), name + QLatin1String("_height"), "Integer");
+        return 4;
+    case Tracepoint::Field::Unknown:
+        justified_worry("Cannot deduce CTF type for '%s %s'", qPrintable(paramType),
+                        qPrintable(name));
+        break;
+    }
+
+    return 0;
+}
+
+static void writeFieldSerialization(QTextStream &stream, const Tracepoint::Field &field)
+{
+    const QString &name = field.name;
+
+    stream << "    ";
+
+    switch (field.backendType) {
+    case Tracepoint::Field::Array:
+        stream << "writer.writeArray(" << name << ", " << field.arrayLen << ");\n";
+        return;
+    case Tracepoint::Field::Sequence:
+        stream << "writer.writeSequence(" << name << ", " << field.seqLen << ");\n";
+        return;
+    case Tracepoint::Field::Integer:
+    case Tracepoint::Field::IntegerHex:
+        stream << "writer.writeValue(" << name << ");\n";
+        return;
+    case Tracepoint::Field::Pointer:
+        stream << "writer.writePointer(" << name << ");\n";
+        return;
+    case Tracepoint::Field::Float:
+        stream << "writer.writeFloat(" << name << ");\n";
+        return;
+    case Tracepoint::Field::String:
+    case Tracepoint::Field::QtString:
+        stream << "writer.writeString(" << name << ");\n";
+        return;
+    case Tracepoint::Field::QtUrl:
+        stream << "writer.writeString(" << name << ".toEncoded());\n";
+        return;
+    case Tracepoint::Field::QtByteArray:
+        stream << "writer.writeSequence(" << name << ".constData(), " << name << ".size());\n";
+        return;
+    case Tracepoint::Field::QtRect:
+        stream << "writer.writeValue(" << name << ".x());\n"
+               << "    writer.writeValue(" << name << ".y());\n"
+               << "    writer.writeValue(" << name << ".width());\n"
+               << "    writer.writeValue(" << name << ".height());\n";
+        return;
+    case Tracepoint::Field::Unknown:
+        stream << "Q_UNUSED(" << name << ");\n";
+        return;
+    }
+}
+
+static void writePrologue(QTextStream &stream, const QString &fileName, const Provider &provider)
+{
+    const QString guard = includeGuard(fileName);
+
+    stream << "#ifndef " << guard << "\n"
+           << "#define " << guard << "\n"
+           << "\n"
+           << "#include <private/qctf_p.h>\n"
+           << "\n";
+
+    stream << qtHeaders();
+    stream << "\n";
+
+    if (!provider.prefixText.isEmpty())
+        stream << provider.prefixText.join(QLatin1Char('\n')) << "\n\n";
+}
+
+static void writeEpilogue(QTextStream &stream, const QString &fileName)
+{
+    stream << "\n#endif // " << includeGuard(fileName) << "\n"
+           << "#include <private/qtrace_p.h>\n";
+}
+
+static void writeTracepoint(QTextStream &stream, const Tracepoint &tracepoint,
+                            const QString &providerName)
+{
+    const QString argList = formatFunctionSignature(tracepoint.args);
+    const QString paramList = formatParameterList(tracepoint.args, CTF);
+    const QString &name = tracepoint.name;
+    const QString variable = tracePointVar(providerName, name);
+
+    QString fields;
+    QTextStream fieldStream(&fields);
+    int fieldCount = 0;
+    for (const Tracepoint::Field &field : tracepoint.fields)
+        fieldCount += writeFieldDescription(fieldStream, field);
+    fieldStream.flush();
+
+    stream << "\n";
+
+    if (fieldCount) {
+        stream << "inline constexpr QCtfTracePointField " << variable << "_fields[] = {\n"
+               << fields
+               << "};\n";
+        stream << "inline QCtfTracePoint " << variable << "(\"" << providerName << "\", \""
+               << name << "\", " << variable << "_fields, " << fieldCount << ");\n\n";
+    } else {
+        stream << "inline QCtfTracePoint " << variable << "(\"" << providerName << "\", \""
+               << name << "\", nullptr, 0);\n\n";
+    }
+
+    stream << "inline void do_trace_" << name << "(" << argList << ")\n"
+           << "{\n"
+           << "    QCtfEventWriter writer;\n";
+
+    for (const Tracepoint::Field &field : tracepoint.fields)
+        writeFieldSerialization(stream, field);
+
+    stream << "    writer.commit(&" << variable << ");\n"
+           << "}\n\n";
+
+    stream << "inline void trace_" << name << "(" << argList << ")\n"
+           << "{\n"
+           << "    if (Q_UNLIKELY(" << variable << ".isEnabled()))\n"
+           << "        do_trace_" << name << "(" << paramList << ");\n"
+           << "}\n\n";
+
+    stream << "inline bool trace_" << name << "_enabled()\n"
+           << "{\n"
+           << "    return " << variable << ".isEnabled();\n"
+           << "}\n";
+}
+
+static void writeTracepoints(QTextStream &stream, const Provider &provider)
+{
+    if (provider.tracepoints.isEmpty())
+        return;
+
+    stream << "QT_BEGIN_NAMESPACE\n"
+           << "namespace QtPrivate {\n";
+
+    for (const Tracepoint &t : provider.tracepoints)
+        writeTracepoint(stream, t, provider.name);
+
+    stream << "} // namespace QtPrivate\n"
+           << "QT_END_NAMESPACE\n";
+}
+
+void writeCtf(QFile &file, const Provider &provider)
+{
+    QTextStream stream(&file);
+
+    const QString fileName = QFileInfo(file.fileName()).fileName();
+
+    writePrologue(stream, fileName, provider);
+    writeTracepoints(stream, provider);
+    writeEpilogue(stream, fileName);
+}
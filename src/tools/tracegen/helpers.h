@@ -47,7 +47,8 @@
 
 enum ParamType {
     LTTNG,
-    ETW
+    ETW,
+    CTF
 };
 
 QString includeGuard(const QString &filename);
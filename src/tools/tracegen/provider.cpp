@@ -158,6 +158,17 @@ static Tracepoint::Field::BackendType backendType(QString rawType)
         { "signed_long_long_int",   Tracepoint::Field::Integer },
         { "unsigned_long_long",     Tracepoint::Field::Integer },
         { "char",                   Tracepoint::Field::Integer },
+        { "qint8",                  Tracepoint::Field::Integer },
+        { "quint8",                 Tracepoint::Field::Integer },
+        { "qint16",                 Tracepoint::Field::Integer },
+        { "quint16",                Tracepoint::Field::Integer },
+        { "qint32",                 Tracepoint::Field::Integer },
+        { "quint32",                Tracepoint::Field::Integer },
+        { "qint64",                 Tracepoint::Field::Integer },
+        { "quint64",                Tracepoint::Field::Integer },
+        { "qlonglong",              Tracepoint::Field::Integer },
+        { "qulonglong",             Tracepoint::Field::Integer },
+        { "qsizetype",              Tracepoint::Field::Integer },
         { "intptr_t",               Tracepoint::Field::IntegerHex },
         { "uintptr_t",              Tracepoint::Field::IntegerHex },
         { "std::intptr_t",          Tracepoint::Field::IntegerHex },
@@ -165,6 +176,7 @@ static Tracepoint::Field::BackendType backendType(QString rawType)
         { "float",                  Tracepoint::Field::Float },
         { "double",                 Tracepoint::Field::Float },
         { "long_double",            Tracepoint::Field::Float },
+        { "qreal",                  Tracepoint::Field::Float },
         { "QString",                Tracepoint::Field::QtString },
         { "QByteArray",             Tracepoint::Field::QtByteArray },
         { "QUrl",                   Tracepoint::Field::QtUrl },
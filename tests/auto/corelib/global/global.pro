@@ -13,5 +13,11 @@ SUBDIRS=\
     qglobalstatic \
     qhooks
 
+qtConfig(private_tests): SUBDIRS += \
+    qbinarylog
+
+qtConfig(ctf): SUBDIRS += \
+    qctf
+
 win32: SUBDIRS += \
     qwinregistry
@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qbinarylog
+QT = core-private testlib
+SOURCES = tst_qbinarylog.cpp
@@ -0,0 +1,370 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/qtemporarydir.h>
+#include <QtCore/private/qbinarylog_p.h>
+
+#ifdef Q_OS_UNIX
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+class tst_QBinaryLog : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void roundTrip();
+    void internedStrings();
+    void rotation();
+    void oversizedRecord();
+    void concurrentWriters();
+    void forkedChild();
+    void truncatedFile();
+    void invalidData();
+
+private:
+    static QByteArray readAll(const QString &fileName);
+};
+
+QByteArray tst_QBinaryLog::readAll(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    return file.readAll();
+}
+
+void tst_QBinaryLog::roundTrip()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(QLatin1String("log.bin"));
+
+    const qint64 start = QDeadlineTimer::current(Qt::PreciseTimer).deadlineNSecs();
+    const qint64 startWallClock = QDateTime::currentMSecsSinceEpoch();
+    {
+        QBinaryLogWriter writer(fileName, 64 * 1024, 2);
+        QVERIFY(writer.isOpen());
+        QMessageLogContext context("file.cpp", 42, "void f()", "qt.test");
+        writer.write(QtWarningMsg, context, QStringLiteral("héllo"), start + 1000, 7);
+        QMessageLogContext empty;
+        writer.write(QtDebugMsg, empty, QString(), start + 500, 8);
+    }
+
+    QBinaryLogReader reader(readAll(fileName));
+    QVERIFY2(reader.isValid(), qPrintable(reader.errorString()));
+    QCOMPARE(reader.pid(), QCoreApplication::applicationPid());
+    QCOMPARE(reader.sequence(), 0u);
+
+    QBinaryLog::Message message;
+    QVERIFY(reader.readNext(&message));
+    QCOMPARE(message.type, QtWarningMsg);
+    QCOMPARE(message.monotonicNSecs, start + 1000);
+    QVERIFY(qAbs(message.wallClockMSecs - startWallClock) < 1000);
+    QCOMPARE(message.threadId, 7);
+    QCOMPARE(message.line, 42);
+    QCOMPARE(message.category, QByteArray("qt.test"));
+    QCOMPARE(message.file, QByteArray("file.cpp"));
+    QCOMPARE(message.function, QByteArray("void f()"));
+    QCOMPARE(message.message, QStringLiteral("héllo"));
+
+    // time deltas may be negative when messages race for the writer
+    QVERIFY(reader.readNext(&message));
+    QCOMPARE(message.type, QtDebugMsg);
+    QCOMPARE(message.monotonicNSecs, start + 500);
+    QCOMPARE(message.threadId, 8);
+    QCOMPARE(message.line, 0);
+    QVERIFY(message.category.isNull());
+    QVERIFY(message.file.isNull());
+    QVERIFY(message.function.isNull());
+    QVERIFY(message.message.isEmpty());
+
+    QVERIFY(!reader.readNext(&message));
+    QVERIFY(reader.atEnd());
+    QVERIFY(reader.isValid());
+}
+
+void tst_QBinaryLog::internedStrings()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(QLatin1String("log.bin"));
+
+    const int count = 100;
+    char buffer[16];
+    {
+        QBinaryLogWriter writer(fileName, 64 * 1024, 1);
+        const qint64 now = QDeadlineTimer::current(Qt::PreciseTimer).deadlineNSecs();
+        for (int i = 0; i < count; ++i) {
+            // the same buffer holds different categories
+            qsnprintf(buffer, sizeof buffer, "cat%d", i % 3);
+            QMessageLogContext context("file.cpp", i, "void f()", buffer);
+            writer.write(QtInfoMsg, context, QString::number(i), now, 1);
+        }
+    }
+
+    const QByteArray data = readAll(fileName);
+    // each string is stored once, not once per message
+    QCOMPARE(data.count("file.cpp"), 1);
+    QCOMPARE(data.count("void f()"), 1);
+
+    QBinaryLogReader reader(data);
+    QBinaryLog::Message message;
+    for (int i = 0; i < count; ++i) {
+        QVERIFY2(reader.readNext(&message), qPrintable(reader.errorString()));
+        QCOMPARE(message.line, i);
+        QCOMPARE(message.category, QByteArray("cat") + QByteArray::number(i % 3));
+        QCOMPARE(message.file, QByteArray("file.cpp"));
+        QCOMPARE(message.message, QString::number(i));
+    }
+    QVERIFY(!reader.readNext(&message));
+    QVERIFY(reader.isValid());
+}
+
+void tst_QBinaryLog::rotation()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(QLatin1String("log.bin"));
+
+    const int count = 2000;
+    const QString padding(100, QLatin1Char('x'));
+    {
+        QBinaryLogWriter writer(fileName, 16 * 1024, 3);
+        QVERIFY(writer.isOpen());
+        QMessageLogContext context("file.cpp", 1, "void f()", "qt.test");
+        const qint64 now = QDeadlineTimer::current(Qt::PreciseTimer).deadlineNSecs();
+        for (int i = 0; i < count; ++i)
+            writer.write(QtWarningMsg, context, QString::number(i) + padding, now + i, 1);
+    }
+
+    // the oldest files were dropped, the remaining ones are complete and in order
+    QVERIFY(!QFile::exists(fileName + QLatin1String(".3")));
+    int expected = -1;
+    quint32 previousSequence = 0;
+    for (const QString &suffix : { QStringLiteral(".2"), QStringLiteral(".1"), QString() }) {
+        const QByteArray data = readAll(fileName + suffix);
+        QVERIFY(data.size() <= 16 * 1024);
+        QBinaryLogReader reader(data);
+        QVERIFY2(reader.isValid(), qPrintable(reader.errorString()));
+        if (expected >= 0)
+            QCOMPARE(reader.sequence(), previousSequence + 1);
+        previousSequence = reader.sequence();
+
+        QBinaryLog::Message message;
+        int messages = 0;
+        while (reader.readNext(&message)) {
+            // every file carries its own string table
+            QCOMPARE(message.category, QByteArray("qt.test"));
+            const int n = message.message.chopped(padding.size()).toInt();
+            if (expected >= 0)
+                QCOMPARE(n, expected);
+            expected = n + 1;
+            ++messages;
+        }
+        QVERIFY(reader.isValid());
+        QVERIFY(messages > 0);
+    }
+    QCOMPARE(expected, count);
+
+    // a new writer keeps the previous log
+    {
+        QBinaryLogWriter writer(fileName, 16 * 1024, 3);
+        QVERIFY(writer.isOpen());
+    }
+    QBinaryLogReader previous(readAll(fileName + QLatin1String(".1")));
+    QCOMPARE(previous.sequence(), previousSequence);
+}
+
+void tst_QBinaryLog::oversizedRecord()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(QLatin1String("log.bin"));
+    {
+        QBinaryLogWriter writer(fileName, 4096, 2);
+        QVERIFY(writer.isOpen());
+        QMessageLogContext context("file.cpp", 1, "void f()", "qt.test");
+        const qint64 now = QDeadlineTimer::current(Qt::PreciseTimer).deadlineNSecs();
+        QVERIFY(writer.write(QtWarningMsg, context, QStringLiteral("first"), now, 1));
+
+        // reported instead of being dropped, and without rotating
+        QVERIFY(!writer.write(QtWarningMsg, context, QString(8192, QLatin1Char('x')), now, 1));
+        QVERIFY(!QFile::exists(fileName + QLatin1String(".1")));
+        QVERIFY(writer.write(QtWarningMsg, context, QStringLiteral("second"), now, 1));
+    }
+
+    QBinaryLogReader reader(readAll(fileName));
+    QBinaryLog::Message message;
+    QVERIFY(reader.readNext(&message));
+    QCOMPARE(message.message, QStringLiteral("first"));
+    QVERIFY(reader.readNext(&message));
+    QCOMPARE(message.message, QStringLiteral("second"));
+    QVERIFY(!reader.readNext(&message));
+}
+
+void tst_QBinaryLog::concurrentWriters()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(QLatin1String("log.bin"));
+    const QString ownFileName = fileName + QLatin1Char('-')
+            + QString::number(QCoreApplication::applicationPid());
+
+    QMessageLogContext context("file.cpp", 1, "void f()", "qt.test");
+    const qint64 now = QDeadlineTimer::current(Qt::PreciseTimer).deadlineNSecs();
+    {
+        QBinaryLogWriter first(fileName, 64 * 1024, 3);
+        QVERIFY(first.isOpen());
+        first.write(QtWarningMsg, context, QStringLiteral("first"), now, 1);
+
+        // the second writer neither rotates nor truncates the locked file
+        QBinaryLogWriter second(fileName, 64 * 1024, 3);
+        QVERIFY(second.isOpen());
+        second.write(QtWarningMsg, context, QStringLiteral("second"), now, 1);
+        QVERIFY(!QFile::exists(fileName + QLatin1String(".1")));
+        QVERIFY(QFile::exists(ownFileName));
+    }
+
+    QBinaryLog::Message message;
+    QBinaryLogReader first(readAll(fileName));
+    QVERIFY(first.readNext(&message));
+    QCOMPARE(message.message, QStringLiteral("first"));
+    QVERIFY(!first.readNext(&message));
+    QBinaryLogReader second(readAll(ownFileName));
+    QVERIFY(second.readNext(&message));
+    QCOMPARE(message.message, QStringLiteral("second"));
+    QVERIFY(!second.readNext(&message));
+
+    // the lock is gone with its writer
+    {
+        QBinaryLogWriter writer(fileName, 64 * 1024, 3);
+        QVERIFY(writer.isOpen());
+    }
+    QVERIFY(QFile::exists(fileName + QLatin1String(".1")));
+}
+
+void tst_QBinaryLog::forkedChild()
+{
+#ifdef Q_OS_UNIX
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(QLatin1String("log.bin"));
+    QMessageLogContext context("file.cpp", 1, "void f()", "qt.test");
+    const qint64 now = QDeadlineTimer::current(Qt::PreciseTimer).deadlineNSecs();
+    pid_t pid;
+    {
+        QBinaryLogWriter writer(fileName, 64 * 1024, 3);
+        QVERIFY(writer.isOpen());
+        QVERIFY(writer.write(QtWarningMsg, context, QStringLiteral("before"), now, 1));
+
+        writer.prepareFork();
+        pid = fork();
+        if (pid == 0) {
+            writer.childAfterFork();
+            const bool written =
+                    writer.write(QtWarningMsg, context, QStringLiteral("child"), now, 2);
+            _exit(written ? 0 : 1);
+        }
+        writer.parentAfterFork();
+        QVERIFY(pid > 0);
+        int status = 0;
+        QCOMPARE(waitpid(pid, &status, 0), pid);
+        QVERIFY(WIFEXITED(status));
+        QCOMPARE(WEXITSTATUS(status), 0);
+
+        QVERIFY(writer.write(QtWarningMsg, context, QStringLiteral("after"), now, 1));
+    }
+
+    // the child neither wrote into the file of its parent nor truncated it
+    QBinaryLog::Message message;
+    QBinaryLogReader parent(readAll(fileName));
+    QVERIFY(parent.readNext(&message));
+    QCOMPARE(message.message, QStringLiteral("before"));
+    QVERIFY(parent.readNext(&message));
+    QCOMPARE(message.message, QStringLiteral("after"));
+    QVERIFY(!parent.readNext(&message));
+    QVERIFY(parent.isValid());
+
+    QBinaryLogReader child(readAll(fileName + QLatin1Char('-') + QString::number(pid)));
+    QCOMPARE(child.pid(), qint64(pid));
+    QVERIFY(child.readNext(&message));
+    QCOMPARE(message.message, QStringLiteral("child"));
+    QVERIFY(!child.readNext(&message));
+#else
+    QSKIP("This test requires fork()");
+#endif
+}
+
+void tst_QBinaryLog::truncatedFile()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(QLatin1String("log.bin"));
+    {
+        QBinaryLogWriter writer(fileName, 64 * 1024, 1);
+        QMessageLogContext context("file.cpp", 1, "void f()", "qt.test");
+        const qint64 now = QDeadlineTimer::current(Qt::PreciseTimer).deadlineNSecs();
+        writer.write(QtWarningMsg, context, QStringLiteral("first"), now, 1);
+        writer.write(QtWarningMsg, context, QStringLiteral("second"), now, 1);
+    }
+
+    QByteArray data = readAll(fileName);
+    data.chop(3);
+    QBinaryLogReader reader(data);
+    QBinaryLog::Message message;
+    QVERIFY(reader.readNext(&message));
+    QCOMPARE(message.message, QStringLiteral("first"));
+    QVERIFY(!reader.readNext(&message));
+    QVERIFY(!reader.isValid());
+}
+
+void tst_QBinaryLog::invalidData()
+{
+    QBinaryLog::Message message;
+
+    QBinaryLogReader empty{QByteArray()};
+    QVERIFY(!empty.isValid());
+    QVERIFY(!empty.readNext(&message));
+
+    QBinaryLogReader garbage(QByteArray(64, 'x'));
+    QVERIFY(!garbage.isValid());
+    QVERIFY(!garbage.readNext(&message));
+
+    QBinaryLog::Header header = {};
+    memcpy(header.magic, QBinaryLog::Magic, sizeof header.magic);
+    header.version = qToLittleEndian(QBinaryLog::Version + 1);
+    header.headerSize = qToLittleEndian(quint32(sizeof header));
+    QBinaryLogReader future(QByteArray(reinterpret_cast<const char *>(&header), sizeof header));
+    QVERIFY(!future.isValid());
+}
+
+QTEST_MAIN(tst_QBinaryLog)
+#include "tst_qbinarylog.moc"
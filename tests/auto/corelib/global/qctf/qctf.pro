@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qctf
+QT = core-private testlib
+SOURCES = tst_qctf.cpp
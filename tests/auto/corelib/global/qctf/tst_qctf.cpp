@@ -0,0 +1,278 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtCore/qtemporarydir.h>
+#include <QtCore/private/qctf_p.h>
+
+static void initializeEnvironment()
+{
+    // The registry reads these once, when the first tracepoint is used.
+    // Ask for the smallest ring, which is two packets of 64 KiB.
+    qputenv("QT_CTF_BUFFER_SIZE", "1");
+    qunsetenv("QT_CTF_TRACEPOINTS");
+    qunsetenv("QT_CTF_OUTPUT_DIRECTORY");
+}
+Q_CONSTRUCTOR_FUNCTION(initializeEnvironment)
+
+static const QCtfTracePointField valueFields[] = {
+    QCtfTracePointField::make<quint32>("value", QCtfTracePointField::Integer)
+};
+static QCtfTracePoint eventOne("qtctftest", "Event_one", valueFields, 1);
+static QCtfTracePoint eventTwo("qtctftest", "Event_two", valueFields, 1);
+static QCtfTracePoint otherEvent("qtctftest", "Other_one", valueFields, 1);
+
+static void trace(QCtfTracePoint *tracePoint, quint32 value)
+{
+    if (tracePoint->isEnabled()) {
+        QCtfEventWriter writer;
+        writer.writeValue(value);
+        writer.commit(tracePoint);
+    }
+}
+
+class tst_QCtf : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void cleanup();
+    void filter_data();
+    void filter();
+    void ringWrapAround();
+    void writeTrace();
+
+private:
+    struct Packet {
+        quint64 sequenceNumber;
+        quint64 discarded;
+        quint64 threadId;
+        QList<quint32> ids;
+        QList<quint32> values;
+    };
+
+    static QByteArray readAll(const QString &fileName);
+    static bool parseStream(const QByteArray &stream, QList<Packet> *packets);
+    static QString takeStream(QByteArray *stream);
+};
+
+QByteArray tst_QCtf::readAll(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    return file.readAll();
+}
+
+// Splits a stream file into its packets; every event in it must have been
+// recorded by one of the tracepoints above.
+bool tst_QCtf::parseStream(const QByteArray &stream, QList<Packet> *packets)
+{
+    const qsizetype headerSize = 2 * sizeof(quint32) + 7 * sizeof(quint64);
+    const qsizetype eventSize = sizeof(quint32) + sizeof(quint64) + sizeof(quint32);
+    const char *data = stream.constData();
+    qsizetype offset = 0;
+    while (offset < stream.size()) {
+        if (stream.size() - offset < headerSize)
+            return false;
+        quint32 header[2];
+        quint64 context[7];
+        memcpy(header, data + offset, sizeof(header));
+        memcpy(context, data + offset + sizeof(header), sizeof(context));
+        if (header[0] != 0xc1fc1fc1 || header[1] != 0 || context[2] != context[3])
+            return false;
+
+        const qsizetype packetSize = qsizetype(context[3] / 8);
+        if (packetSize < headerSize || stream.size() - offset < packetSize
+                || (packetSize - headerSize) % eventSize != 0) {
+            return false;
+        }
+
+        Packet packet = { context[4], context[5], context[6], {}, {} };
+        for (qsizetype event = offset + headerSize; event < offset + packetSize; event += eventSize) {
+            quint32 id;
+            quint32 value;
+            memcpy(&id, data + event, sizeof(id));
+            memcpy(&value, data + event + sizeof(quint32) + sizeof(quint64), sizeof(value));
+            packet.ids.append(id);
+            packet.values.append(value);
+        }
+        packets->append(packet);
+        offset += packetSize;
+    }
+    return true;
+}
+
+// Writes the trace recorded so far and returns the one stream file in it
+QString tst_QCtf::takeStream(QByteArray *stream)
+{
+    QTemporaryDir dir;
+    if (!dir.isValid())
+        return QLatin1String("cannot create a temporary directory");
+    if (!QCtfTracer::writeTrace(dir.path()))
+        return QLatin1String("writeTrace() failed");
+    const QStringList streams = QDir(dir.path()).entryList({ QLatin1String("stream_*") });
+    if (streams.size() != 1)
+        return QLatin1String("expected one stream, got ") + QString::number(streams.size());
+    *stream = readAll(dir.filePath(streams.first()));
+    return QString();
+}
+
+void tst_QCtf::cleanup()
+{
+    // drop whatever the test recorded
+    QCtfTracer::setTracePointFilter(QString());
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QVERIFY(QCtfTracer::writeTrace(dir.path()));
+}
+
+void tst_QCtf::filter_data()
+{
+    QTest::addColumn<QString>("filter");
+    QTest::addColumn<bool>("eventOneEnabled");
+    QTest::addColumn<bool>("eventTwoEnabled");
+    QTest::addColumn<bool>("otherEventEnabled");
+
+    QTest::newRow("empty") << QString() << false << false << false;
+    QTest::newRow("all") << "*" << true << true << true;
+    QTest::newRow("provider") << "qtctftest:*" << true << true << true;
+    QTest::newRow("other-provider") << "qtcore:*" << false << false << false;
+    QTest::newRow("exact") << "qtctftest:Event_two" << false << true << false;
+    QTest::newRow("name-only") << "Event_*" << true << true << false;
+    QTest::newRow("disable-prefix") << "qtctftest:*,-qtctftest:Event_*"
+                                    << false << false << true;
+    QTest::newRow("disable-name") << "qtctftest:*, -Event_one" << false << true << true;
+    QTest::newRow("last-wins") << "-qtctftest:Event_*,qtctftest:*" << true << true << true;
+    QTest::newRow("reenable") << "*,-qtctftest:*,qtctftest:Other_*" << false << false << true;
+    QTest::newRow("empty-patterns") << ",,qtctftest:Event_one,," << true << false << false;
+}
+
+void tst_QCtf::filter()
+{
+    QFETCH(QString, filter);
+    QFETCH(bool, eventOneEnabled);
+    QFETCH(bool, eventTwoEnabled);
+    QFETCH(bool, otherEventEnabled);
+
+    QCtfTracer::setTracePointFilter(filter);
+    QCOMPARE(eventOne.isEnabled(), eventOneEnabled);
+    QCOMPARE(eventTwo.isEnabled(), eventTwoEnabled);
+    QCOMPARE(otherEvent.isEnabled(), otherEventEnabled);
+}
+
+void tst_QCtf::ringWrapAround()
+{
+    QCtfTracer::setTracePointFilter(QLatin1String("qtctftest:Event_one"));
+
+    // Each event takes 16 bytes, so 4096 of them fill a packet; write
+    // enough to go around the two packet ring more than once.
+    const quint32 count = 3 * 4096 + 100;
+    for (quint32 i = 0; i < count; ++i)
+        trace(&eventOne, i);
+    trace(&eventTwo, count);
+
+    QByteArray stream;
+    const QString error = takeStream(&stream);
+    QVERIFY2(error.isEmpty(), qPrintable(error));
+    QList<Packet> packets;
+    QVERIFY(parseStream(stream, &packets));
+
+    // only the two newest packets survive, oldest first
+    QCOMPARE(packets.size(), 2);
+    QCOMPARE(packets.at(1).sequenceNumber, packets.at(0).sequenceNumber + 1);
+    QCOMPARE(packets.at(0).values.size(), 4096);
+    QCOMPARE(packets.at(1).values.size(), 100);
+
+    QList<quint32> values = packets.at(0).values + packets.at(1).values;
+    const quint32 first = count - quint32(values.size());
+    for (qsizetype i = 0; i < values.size(); ++i)
+        QCOMPARE(values.at(i), first + quint32(i));
+    QCOMPARE(packets.at(0).discarded, quint64(first));
+    QCOMPARE(packets.at(1).discarded, quint64(first));
+
+    // the ring was emptied
+    const QString secondError = takeStream(&stream);
+    QCOMPARE(secondError, QLatin1String("expected one stream, got 0"));
+}
+
+void tst_QCtf::writeTrace()
+{
+    // Writing the files passes the QIODevice tracepoints, which must not
+    // deadlock against the registry.
+    QCtfTracer::setTracePointFilter(QLatin1String("qtctftest:*,qtcore:QIODevice_*"));
+
+    trace(&eventOne, 1);
+    trace(&otherEvent, 2);
+    QScopedPointer<QThread> thread(QThread::create([] {
+        trace(&eventTwo, 3);
+        trace(&eventTwo, 4);
+    }));
+    thread->start();
+    QVERIFY(thread->wait());
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QVERIFY(QCtfTracer::writeTrace(dir.path()));
+
+    const QByteArray metadata = readAll(dir.filePath(QLatin1String("metadata")));
+    QVERIFY(metadata.startsWith("/* CTF 1.8 */"));
+    QHash<QByteArray, quint32> ids;
+    const QRegularExpression eventRe(QLatin1String("name = \"(qtctftest:\\w+)\";\\s*id = (\\d+);"));
+    for (auto it = eventRe.globalMatch(QString::fromLatin1(metadata)); it.hasNext(); ) {
+        const QRegularExpressionMatch match = it.next();
+        ids.insert(match.captured(1).toLatin1(), match.captured(2).toUInt());
+    }
+    QCOMPARE(ids.size(), 3);
+    QVERIFY(metadata.contains("integer { size = 32; align = 8; signed = false; base = 10; } _value;"));
+
+    // one stream per thread that recorded events
+    const QStringList streams = QDir(dir.path()).entryList({ QLatin1String("stream_*") });
+    QCOMPARE(streams.size(), 2);
+
+    QHash<quint32, quint32> recorded;
+    QSet<quint64> threadIds;
+    for (const QString &fileName : streams) {
+        QList<Packet> packets;
+        QVERIFY(parseStream(readAll(dir.filePath(fileName)), &packets));
+        QCOMPARE(packets.size(), 1);
+        threadIds.insert(packets.first().threadId);
+        for (qsizetype i = 0; i < packets.first().ids.size(); ++i)
+            recorded.insert(packets.first().values.at(i), packets.first().ids.at(i));
+    }
+    QCOMPARE(threadIds.size(), 2);
+    QCOMPARE(recorded.size(), 4);
+    QCOMPARE(recorded.value(1), ids.value("qtctftest:Event_one"));
+    QCOMPARE(recorded.value(2), ids.value("qtctftest:Other_one"));
+    QCOMPARE(recorded.value(3), ids.value("qtctftest:Event_two"));
+    QCOMPARE(recorded.value(4), ids.value("qtctftest:Event_two"));
+}
+
+QTEST_MAIN(tst_QCtf)
+#include "tst_qctf.moc"
@@ -67,6 +67,13 @@ int main(int argc, char **argv)
 
     qSetMessagePattern("[%{type}] %{message}");
 
+    if (argc > 1 && qstrcmp(argv[1], "async-fatal") == 0) {
+        qSetAsyncMessageLogging(true);
+        for (int i = 0; i < 100; ++i)
+            qWarning("queued %d", i);
+        qFatal("fatal");
+    }
+
     qDebug("qDebug");
     qInfo("qInfo");
     qWarning("qWarning");
@@ -32,8 +32,17 @@
 #if QT_CONFIG(process)
 # include <QtCore/QProcess>
 #endif
+#include <QtCore/QMutex>
+#include <QtCore/QScopeGuard>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThread>
 #include <QtTest/QTest>
 
+#ifdef Q_OS_UNIX
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
 class tst_qmessagehandler : public QObject
 {
     Q_OBJECT
@@ -56,8 +65,14 @@ private slots:
 
     void qMessagePattern_data();
     void qMessagePattern();
+    void setMessagePattern_data();
     void setMessagePattern();
 
+    void asyncMessageLogging();
+    void asyncMessageLoggingFullQueue();
+    void asyncMessageLoggingAfterFork();
+    void asyncMessageLoggingFatal();
+
     void formatLogMessage_data();
     void formatLogMessage();
 
@@ -671,12 +686,12 @@ void tst_qmessagehandler::qMessagePattern_data()
             //  we can't be sure whether the QT_MESSAGE_PATTERN is already destructed
             << "static destructor"
             << "debug tst_qlogging 60 MyClass::myFunction from_a_function 34"
-            << "debug tst_qlogging 70 main qDebug"
-            << "info tst_qlogging 71 main qInfo"
-            << "warning tst_qlogging 72 main qWarning"
-            << "critical tst_qlogging 73 main qCritical"
-            << "warning tst_qlogging 76 main qDebug with category"
-            << "debug tst_qlogging 80 main qDebug2");
+            << "debug tst_qlogging 77 main qDebug"
+            << "info tst_qlogging 78 main qInfo"
+            << "warning tst_qlogging 79 main qWarning"
+            << "critical tst_qlogging 80 main qCritical"
+            << "warning tst_qlogging 83 main qDebug with category"
+            << "debug tst_qlogging 87 main qDebug2");
 
 
     QTest::newRow("invalid") << "PREFIX: %{unknown} %{message}" << false << (QList<QByteArray>()
@@ -814,6 +829,14 @@ void tst_qmessagehandler::qMessagePattern()
 #endif
 }
 
+void tst_qmessagehandler::setMessagePattern_data()
+{
+    QTest::addColumn<bool>("async");
+
+    QTest::newRow("synchronous") << false;
+    QTest::newRow("asynchronous") << true;
+}
+
 void tst_qmessagehandler::setMessagePattern()
 {
 #if !QT_CONFIG(process)
@@ -843,6 +866,9 @@ void tst_qmessagehandler::setMessagePattern()
     std::copy_if(m_baseEnvironment.cbegin(), m_baseEnvironment.cend(),
                  std::back_inserter(environment),
                  doesNotStartWith(QLatin1String("QT_MESSAGE_PATTERN")));
+    QFETCH(bool, async);
+    if (async)
+        environment.append(QStringLiteral("QT_LOGGING_ASYNC=1"));
     process.setEnvironment(environment);
 
     process.start(appExe);
@@ -865,6 +891,213 @@ void tst_qmessagehandler::setMessagePattern()
 #endif // QT_CONFIG(process)
 }
 
+struct AsyncMessage
+{
+    QThread *thread;
+    QString message;
+};
+static QMutex s_asyncMutex;
+static QList<AsyncMessage> s_asyncMessages;
+
+static void asyncMessageHandler(QtMsgType, const QMessageLogContext &, const QString &msg)
+{
+    QMutexLocker locker(&s_asyncMutex);
+    s_asyncMessages.append({ QThread::currentThread(), msg });
+}
+
+#if QT_CONFIG(thread)
+class LoggingThread : public QThread
+{
+public:
+    LoggingThread(int id, int count) : id(id), count(count) {}
+    void run() override
+    {
+        for (int i = 0; i < count; ++i)
+            qWarning("%d %d", id, i);
+    }
+    int id;
+    int count;
+};
+#endif
+
+void tst_qmessagehandler::asyncMessageLogging()
+{
+#if !QT_CONFIG(thread)
+    QSKIP("This test requires thread support");
+#else
+    const int threadCount = 4;
+    const int messageCount = 500;
+
+    qInstallMessageHandler(asyncMessageHandler);
+    qSetAsyncMessageLogging(true);
+    auto cleanup = qScopeGuard([] { qSetAsyncMessageLogging(false); });
+
+    QList<QThread *> threads;
+    for (int i = 0; i < threadCount; ++i) {
+        threads.append(new LoggingThread(i, messageCount));
+        threads.last()->start();
+    }
+    for (QThread *thread : qAsConst(threads))
+        QVERIFY(thread->wait());
+
+    // disabling flushes the queue
+    cleanup.dismiss();
+    qSetAsyncMessageLogging(false);
+    qInstallMessageHandler(nullptr);
+
+    QMutexLocker locker(&s_asyncMutex);
+    QCOMPARE(s_asyncMessages.size(), threadCount * messageCount);
+
+    // warnings are never dropped and each thread's messages stay in order
+    QList<int> next(threadCount, 0);
+    for (const AsyncMessage &message : qAsConst(s_asyncMessages)) {
+        QVERIFY(!threads.contains(message.thread));
+        const QStringList parts = message.message.split(QLatin1Char(' '));
+        QCOMPARE(parts.size(), 2);
+        const int thread = parts.at(0).toInt();
+        QCOMPARE(parts.at(1).toInt(), next[thread]++);
+    }
+    qDeleteAll(threads);
+    s_asyncMessages.clear();
+#endif
+}
+
+static QSemaphore s_handlerGate;
+
+static void blockingMessageHandler(QtMsgType type, const QMessageLogContext &context,
+                                   const QString &msg)
+{
+    s_handlerGate.acquire();
+    s_handlerGate.release();
+    asyncMessageHandler(type, context, msg);
+}
+
+void tst_qmessagehandler::asyncMessageLoggingFullQueue()
+{
+#if !QT_CONFIG(thread)
+    QSKIP("This test requires thread support");
+#else
+    const int messageCount = 3000;
+
+    // the writer blocks in the handler, so the queue fills up
+    qInstallMessageHandler(blockingMessageHandler);
+    qSetAsyncMessageLogging(true);
+    auto cleanup = qScopeGuard([] {
+        s_handlerGate.release();
+        qSetAsyncMessageLogging(false);
+        qInstallMessageHandler(nullptr);
+        QMutexLocker locker(&s_asyncMutex);
+        s_asyncMessages.clear();
+    });
+
+    // warnings only wait a bounded time for room, then they are dropped
+    LoggingThread thread(0, messageCount);
+    thread.start();
+    QVERIFY(thread.wait(QDeadlineTimer(30000)));
+
+    cleanup.dismiss();
+    s_handlerGate.release();
+    qSetAsyncMessageLogging(false);
+    qInstallMessageHandler(nullptr);
+
+    QMutexLocker locker(&s_asyncMutex);
+    int logged = 0;
+    int dropped = 0;
+    int last = -1;
+    for (const AsyncMessage &message : qAsConst(s_asyncMessages)) {
+        const QStringList parts = message.message.split(QLatin1Char(' '));
+        if (message.message.endsWith(QLatin1String("because the message queue was full"))) {
+            dropped += parts.at(0).toInt();
+        } else {
+            QCOMPARE(parts.size(), 2);
+            QVERIFY(parts.at(1).toInt() > last);
+            last = parts.at(1).toInt();
+            ++logged;
+        }
+    }
+    QVERIFY(dropped > 0);
+    QCOMPARE(logged + dropped, messageCount);
+    s_asyncMessages.clear();
+#endif
+}
+
+void tst_qmessagehandler::asyncMessageLoggingAfterFork()
+{
+#if !QT_CONFIG(thread) || !defined(Q_OS_UNIX)
+    QSKIP("This test requires thread support and fork()");
+#else
+    qInstallMessageHandler(asyncMessageHandler);
+    qSetAsyncMessageLogging(true);
+    auto cleanup = qScopeGuard([] {
+        qSetAsyncMessageLogging(false);
+        qInstallMessageHandler(nullptr);
+        QMutexLocker locker(&s_asyncMutex);
+        s_asyncMessages.clear();
+    });
+
+    // start the writer thread, and make sure it is idle when forking
+    qWarning("parent");
+    qSetAsyncMessageLogging(false);
+    qSetAsyncMessageLogging(true);
+
+    const pid_t pid = fork();
+    QVERIFY(pid >= 0);
+    if (pid == 0) {
+        // there is no writer thread in the child: the message is handled
+        // right away, and flushing must not wait for the writer
+        qWarning("child");
+        bool handled;
+        {
+            QMutexLocker locker(&s_asyncMutex);
+            handled = !s_asyncMessages.isEmpty()
+                    && s_asyncMessages.constLast().message == QLatin1String("child")
+                    && s_asyncMessages.constLast().thread == QThread::currentThread();
+        }
+        qSetAsyncMessageLogging(false);
+        ::_exit(handled ? 0 : 1);
+    }
+
+    int status = 0;
+    QCOMPARE(::waitpid(pid, &status, 0), pid);
+    QVERIFY(WIFEXITED(status));
+    QCOMPARE(WEXITSTATUS(status), 0);
+#endif
+}
+
+void tst_qmessagehandler::asyncMessageLoggingFatal()
+{
+#if !QT_CONFIG(process)
+    QSKIP("This test requires QProcess support");
+#else
+#ifdef Q_OS_ANDROID
+    QSKIP("This test crashes on Android");
+#endif
+    QProcess process;
+#ifndef Q_OS_ANDROID
+    const QString appExe(QLatin1String(HELPER_BINARY));
+#else
+    const QString appExe(QCoreApplication::applicationDirPath() + QLatin1String("/libhelper.so"));
+#endif
+    process.setEnvironment(m_baseEnvironment);
+    process.start(appExe, QStringList(QStringLiteral("async-fatal")));
+    QVERIFY2(process.waitForStarted(), qPrintable(
+        QString::fromLatin1("Could not start %1: %2").arg(appExe, process.errorString())));
+    QVERIFY(process.waitForFinished());
+    QCOMPARE(process.exitStatus(), QProcess::CrashExit);
+
+    // the fatal message comes after everything that was queued before it
+    QByteArray output = process.readAllStandardError();
+#ifdef Q_OS_WIN
+    output.replace("\r\n", "\n");
+#endif
+    QByteArray expected = "static constructor\n";
+    for (int i = 0; i < 100; ++i)
+        expected += "[warning] queued " + QByteArray::number(i) + '\n';
+    expected += "[fatal] fatal\n";
+    QCOMPARE(QString::fromLatin1(output), QString::fromLatin1(expected));
+#endif
+}
+
 Q_DECLARE_METATYPE(QtMsgType)
 
 void tst_qmessagehandler::formatLogMessage_data()
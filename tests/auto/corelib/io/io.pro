@@ -1,6 +1,7 @@
 TEMPLATE=subdirs
 SUBDIRS=\
     qabstractfileengine \
+    qasyncfile \
     qbuffer \
     qdataurl \
     qdebug \
@@ -18,6 +19,7 @@ SUBDIRS=\
     qlockfile \
     qloggingcategory \
     qloggingregistry \
+    qmappedfiledevice \
     qnodebug \
     qprocess \
     qprocess-noapplication \
@@ -0,0 +1,5 @@
+CONFIG += testcase
+TARGET = tst_qasyncfile
+QT = core testlib
+SOURCES = tst_qasyncfile.cpp
+RESOURCES += qasyncfile.qrc
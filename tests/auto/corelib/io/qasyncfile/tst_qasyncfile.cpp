@@ -0,0 +1,232 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <qasyncfile.h>
+#include <qfile.h>
+#include <qtemporarydir.h>
+
+class tst_QAsyncFile : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void readAll();
+    void readAllMany();
+    void readAllNonExistent();
+    void readAllResource();
+    void read_data();
+    void read();
+    void write();
+    void writeEmpty();
+    void writeError();
+    void copy();
+
+private:
+    QByteArray makeData(int size, char seed) const;
+    QString writeFile(const QString &name, const QByteArray &data);
+
+    QTemporaryDir dir;
+};
+
+QByteArray tst_QAsyncFile::makeData(int size, char seed) const
+{
+    QByteArray data(size, Qt::Uninitialized);
+    for (int i = 0; i < size; ++i)
+        data[i] = char(seed + i * 7);
+    return data;
+}
+
+QString tst_QAsyncFile::writeFile(const QString &name, const QByteArray &data)
+{
+    const QString fileName = dir.filePath(name);
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size())
+        return QString();
+    return fileName;
+}
+
+void tst_QAsyncFile::initTestCase()
+{
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+}
+
+void tst_QAsyncFile::readAll()
+{
+    const QByteArray data = makeData(3 * 1024 * 1024 + 17, 'a');
+    const QString fileName = writeFile("readAll", data);
+    QVERIFY(!fileName.isEmpty());
+
+    QFuture<QByteArray> future = QAsyncFile::readAll(fileName);
+    future.waitForFinished();
+    QVERIFY(!future.isCanceled());
+    QCOMPARE(future.resultCount(), 1);
+    QCOMPARE(future.result(), data);
+}
+
+void tst_QAsyncFile::readAllMany()
+{
+    // More files than requests the kernel ring holds at once
+    QStringList fileNames;
+    QList<QByteArray> contents;
+    for (int i = 0; i < 200; ++i) {
+        contents.append(makeData(i * 31, char(i)));
+        fileNames.append(writeFile(QString::number(i), contents.last()));
+        QVERIFY(!fileNames.last().isEmpty());
+    }
+    fileNames.append(dir.filePath("does-not-exist"));
+
+    const QList<QFuture<QByteArray>> futures = QAsyncFile::readAll(fileNames);
+    QCOMPARE(futures.size(), fileNames.size());
+    for (int i = 0; i < contents.size(); ++i) {
+        QFuture<QByteArray> future = futures.at(i);
+        future.waitForFinished();
+        QVERIFY2(!future.isCanceled(), qPrintable(fileNames.at(i)));
+        QCOMPARE(future.result(), contents.at(i));
+    }
+    QFuture<QByteArray> missing = futures.last();
+    missing.waitForFinished();
+    QVERIFY(missing.isCanceled());
+    QCOMPARE(missing.resultCount(), 0);
+}
+
+void tst_QAsyncFile::readAllNonExistent()
+{
+    QFuture<QByteArray> future = QAsyncFile::readAll(dir.filePath("does-not-exist"));
+    future.waitForFinished();
+    QVERIFY(future.isCanceled());
+    QCOMPARE(future.resultCount(), 0);
+
+    future = QAsyncFile::readAll(QString());
+    future.waitForFinished();
+    QVERIFY(future.isCanceled());
+
+    // A directory cannot be read
+    future = QAsyncFile::readAll(dir.path());
+    future.waitForFinished();
+    QVERIFY(future.isCanceled());
+}
+
+void tst_QAsyncFile::readAllResource()
+{
+    QFile file(":/tst_qasyncfile.cpp");
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray expected = file.readAll();
+    QVERIFY(!expected.isEmpty());
+
+    QFuture<QByteArray> future = QAsyncFile::readAll(file.fileName());
+    future.waitForFinished();
+    QVERIFY(!future.isCanceled());
+    QCOMPARE(future.result(), expected);
+}
+
+void tst_QAsyncFile::read_data()
+{
+    QTest::addColumn<qint64>("offset");
+    QTest::addColumn<qint64>("maxSize");
+    QTest::addColumn<qint64>("expected");
+
+    QTest::newRow("whole") << qint64(0) << qint64(4096) << qint64(4096);
+    QTest::newRow("prefix") << qint64(0) << qint64(100) << qint64(100);
+    QTest::newRow("middle") << qint64(1000) << qint64(100) << qint64(100);
+    QTest::newRow("past-end") << qint64(4000) << qint64(1000) << qint64(96);
+    QTest::newRow("at-end") << qint64(4096) << qint64(10) << qint64(0);
+    QTest::newRow("empty") << qint64(10) << qint64(0) << qint64(0);
+}
+
+void tst_QAsyncFile::read()
+{
+    QFETCH(qint64, offset);
+    QFETCH(qint64, maxSize);
+    QFETCH(qint64, expected);
+
+    const QByteArray data = makeData(4096, 'r');
+    const QString fileName = writeFile("read", data);
+    QVERIFY(!fileName.isEmpty());
+
+    QByteArray buffer(int(maxSize), '\0');
+    QFuture<qint64> future = QAsyncFile::read(fileName, buffer.data(), maxSize, offset);
+    QCOMPARE(future.result(), expected);
+    QCOMPARE(buffer.left(int(expected)), data.mid(int(offset), int(expected)));
+
+    future = QAsyncFile::read(dir.filePath("does-not-exist"), buffer.data(), maxSize);
+    QCOMPARE(future.result(), qint64(-1));
+}
+
+void tst_QAsyncFile::write()
+{
+    const QString fileName = writeFile("write", makeData(10000, 'x'));
+    QVERIFY(!fileName.isEmpty());
+
+    // Replaces the existing contents
+    const QByteArray data = makeData(2 * 1024 * 1024 + 3, 'w');
+    QFuture<qint64> future = QAsyncFile::write(fileName, data);
+    QCOMPARE(future.result(), qint64(data.size()));
+
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), data);
+}
+
+void tst_QAsyncFile::writeEmpty()
+{
+    const QString fileName = dir.filePath("writeEmpty");
+    QFuture<qint64> future = QAsyncFile::write(fileName, QByteArray());
+    QCOMPARE(future.result(), qint64(0));
+    QVERIFY(QFile::exists(fileName));
+    QCOMPARE(QFileInfo(fileName).size(), qint64(0));
+}
+
+void tst_QAsyncFile::writeError()
+{
+    QFuture<qint64> future = QAsyncFile::write(dir.filePath("no-such-dir/file"), "data");
+    QCOMPARE(future.result(), qint64(-1));
+}
+
+void tst_QAsyncFile::copy()
+{
+    const QByteArray data = makeData(100000, 'c');
+    const QString fileName = writeFile("copy", data);
+    QVERIFY(!fileName.isEmpty());
+
+    const QString newName = dir.filePath("copy-target");
+    QFuture<bool> future = QAsyncFile::copy(fileName, newName);
+    QVERIFY(future.result());
+
+    QFile file(newName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), data);
+
+    // QFile::copy() does not overwrite
+    future = QAsyncFile::copy(fileName, newName);
+    QVERIFY(!future.result());
+}
+
+QTEST_GUILESS_MAIN(tst_QAsyncFile)
+#include "tst_qasyncfile.moc"
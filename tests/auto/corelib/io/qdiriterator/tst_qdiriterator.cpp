@@ -94,6 +94,10 @@ private slots:
     void iterateRelativeDirectory();
     void iterateResource_data();
     void iterateResource();
+    void traverse_data();
+    void traverse();
+    void traverseResource_data();
+    void traverseResource();
     void stopLinkLoop();
 #ifdef QT_BUILD_INTERNAL
     void engineWithNoIterator();
@@ -436,6 +440,68 @@ void tst_QDirIterator::iterateResource()
     QCOMPARE(list, sortedEntries);
 }
 
+void tst_QDirIterator::traverse_data()
+{
+    iterateRelativeDirectory_data();
+}
+
+void tst_QDirIterator::traverse()
+{
+    QFETCH(QString, dirName);
+    QFETCH(QDirIterator::IteratorFlags, flags);
+    QFETCH(QDir::Filters, filters);
+    QFETCH(QStringList, nameFilters);
+    QFETCH(QStringList, entries);
+
+    QStringList sortedEntries;
+    for (const QString &item : qAsConst(entries))
+        sortedEntries.append(QFileInfo(item).canonicalFilePath());
+    sortedEntries.sort();
+
+    for (int threads : {1, 4}) {
+        QStringList list;
+        QDirIterator::traverse(dirName, nameFilters, filters, flags,
+                               [&](const QFileInfoList &batch) {
+            for (const QFileInfo &info : batch) {
+                QVERIFY(info.filePath().startsWith(dirName));
+                list << info.canonicalFilePath();
+            }
+        }, threads);
+
+        // The order of items returned by traverse() is not guaranteed.
+        list.sort();
+        QCOMPARE(list, sortedEntries);
+    }
+}
+
+void tst_QDirIterator::traverseResource_data()
+{
+    iterateResource_data();
+}
+
+void tst_QDirIterator::traverseResource()
+{
+    QFETCH(QString, dirName);
+    QFETCH(QDirIterator::IteratorFlags, flags);
+    QFETCH(QDir::Filters, filters);
+    QFETCH(QStringList, nameFilters);
+    QFETCH(QStringList, entries);
+
+    QStringList list;
+    QDirIterator::traverse(dirName, nameFilters, filters, flags,
+                           [&](const QFileInfoList &batch) {
+        for (const QFileInfo &info : batch) {
+            if (!info.filePath().startsWith(":/qt-project.org"))
+                list << info.filePath();
+        }
+    });
+
+    list.sort();
+    QStringList sortedEntries = entries;
+    sortedEntries.sort();
+    QCOMPARE(list, sortedEntries);
+}
+
 void tst_QDirIterator::stopLinkLoop()
 {
 #ifdef Q_OS_WIN
@@ -466,6 +532,12 @@ void tst_QDirIterator::stopLinkLoop()
         it.next();
     QVERIFY(max);
 
+    int count = 0;
+    QDirIterator::traverse(QLatin1String("entrylist"), QStringList(), QDir::NoFilter,
+                           QDirIterator::Subdirectories | QDirIterator::FollowSymlinks,
+                           [&](const QFileInfoList &batch) { count += batch.size(); }, 4);
+    QVERIFY(count < 200);
+
     // The goal of this test is only to ensure that the test above don't malfunction
 }
 
@@ -64,6 +64,8 @@ QT_END_NAMESPACE
 #ifdef Q_OS_MAC
 # include <sys/mount.h>
 #elif defined(Q_OS_LINUX)
+# include <fcntl.h>
+# include <sys/mman.h>
 # include <sys/vfs.h>
 #elif defined(Q_OS_FREEBSD)
 # include <sys/param.h>
@@ -254,6 +256,10 @@ private slots:
     void mapOpenMode();
     void mapWrittenFile_data();
     void mapWrittenFile();
+    void adviseMap();
+    void adviseMapPopulate();
+    void readBufferGrowth();
+    void readDataReimplemented();
 
     void openStandardStreamsFileDescriptors();
     void openStandardStreamsBufferedStreams();
@@ -3198,6 +3204,16 @@ void tst_QFile::mapOpenMode_data()
     QTest::newRow("ReadWrite,Unbuffered") << int(QIODevice::ReadWrite | QIODevice::Unbuffered) << int(QFileDevice::NoOptions);
     QTest::newRow("ReadOnly + MapPrivate") << int(QIODevice::ReadOnly) << int(QFileDevice::MapPrivateOption);
     QTest::newRow("ReadWrite + MapPrivate") << int(QIODevice::ReadWrite) << int(QFileDevice::MapPrivateOption);
+    QTest::newRow("ReadOnly + MapPopulate") << int(QIODevice::ReadOnly) << int(QFileDevice::MapPopulateOption);
+    QTest::newRow("ReadWrite + MapPopulate") << int(QIODevice::ReadWrite) << int(QFileDevice::MapPopulateOption);
+    QTest::newRow("ReadOnly + hints")
+            << int(QIODevice::ReadOnly)
+            << int(QFileDevice::MapSequentialHint | QFileDevice::MapWillNeedHint
+                   | QFileDevice::MapHugePagesHint);
+    QTest::newRow("ReadWrite + MapPrivate + hints")
+            << int(QIODevice::ReadWrite)
+            << int(QFileDevice::MapPrivateOption | QFileDevice::MapPopulateOption
+                   | QFileDevice::MapRandomHint);
 }
 
 void tst_QFile::mapOpenMode()
@@ -3280,6 +3296,182 @@ void tst_QFile::mapWrittenFile()
     file.remove();
 }
 
+void tst_QFile::adviseMap()
+{
+    QString fileName = QDir::currentPath() + '/' + "qfile_map_testfile";
+    QFile file(fileName);
+    QVERIFY2(file.open(QIODevice::ReadWrite | QIODevice::Truncate), msgOpenFailed(file).constData());
+    const QByteArray data(3 * 65536, 'x');
+    QCOMPARE(file.write(data), qint64(data.size()));
+    QVERIFY(file.flush());
+
+    uchar *memory = file.map(100, data.size() - 100);
+    QVERIFY(memory);
+
+    // Any part of the mapping, aligned or not
+    QVERIFY2(file.adviseMap(memory, data.size() - 100, QFileDevice::MapWillNeedHint),
+             qPrintable(file.errorString()));
+    QVERIFY(file.adviseMap(memory + 5000, 70000,
+                           QFileDevice::MapSequentialHint | QFileDevice::MapPopulateOption));
+    QVERIFY(file.adviseMap(memory + 65436, 1, QFileDevice::MapRandomHint));
+    QVERIFY(file.adviseMap(memory, 0, QFileDevice::MapWillNeedHint));
+
+    // Not within the mapping
+    QVERIFY(!file.adviseMap(memory - 1, 10, QFileDevice::MapWillNeedHint));
+    QVERIFY(!file.adviseMap(memory + 10, data.size(), QFileDevice::MapWillNeedHint));
+    QCOMPARE(file.error(), QFile::UnspecifiedError);
+
+    QVERIFY(file.unmap(memory));
+    QVERIFY(!file.adviseMap(memory, 10, QFileDevice::MapWillNeedHint));
+
+    file.close();
+    file.remove();
+}
+
+void tst_QFile::adviseMapPopulate()
+{
+#if defined(Q_OS_LINUX)
+    QTemporaryFile file;
+    QVERIFY2(file.open(), msgOpenFailed(file).constData());
+    const QByteArray data(64 * 4096, 'x');
+    QCOMPARE(file.write(data), qint64(data.size()));
+    QVERIFY(file.flush());
+
+    // drop the file from the page cache, so that its pages are only resident
+    // after the populate request read them
+    QCOMPARE(::fsync(file.handle()), 0);
+    QCOMPARE(::posix_fadvise(file.handle(), 0, 0, POSIX_FADV_DONTNEED), 0);
+
+    uchar *memory = file.map(0, data.size());
+    QVERIFY(memory);
+    const size_t pageCount = size_t(data.size()) / ::getpagesize();
+    const auto residentPages = [&]() {
+        std::vector<unsigned char> pages(pageCount);
+        if (::mincore(memory, data.size(), pages.data()) != 0)
+            return size_t(0);
+        return size_t(std::count_if(pages.cbegin(), pages.cend(),
+                                    [](unsigned char page) { return page & 1; }));
+    };
+    if (residentPages() == pageCount)
+        QSKIP("The file system did not drop the file from the page cache");
+
+    QVERIFY2(file.adviseMap(memory, data.size(), QFileDevice::MapPopulateOption),
+             qPrintable(file.errorString()));
+    // without MADV_POPULATE_READ, the read-ahead runs in the background
+    QTRY_COMPARE(residentPages(), pageCount);
+
+    QVERIFY(file.unmap(memory));
+#else
+    QSKIP("This test requires mincore()");
+#endif
+}
+
+void tst_QFile::readBufferGrowth()
+{
+    QByteArray data(4 * 1024 * 1024, Qt::Uninitialized);
+    for (int i = 0; i < data.size(); ++i)
+        data[i] = char(i % 253);
+    const QString fileName = QDir::currentPath() + '/' + "qfile_readbuffer_testfile";
+    {
+        QFile file(fileName);
+        QVERIFY2(file.open(QIODevice::WriteOnly | QIODevice::Truncate), msgOpenFailed(file).constData());
+        QCOMPARE(file.write(data), qint64(data.size()));
+    }
+
+    QFile file(fileName);
+    QVERIFY2(file.open(QIODevice::ReadOnly), msgOpenFailed(file).constData());
+    const qint64 initialChunkSize = file.readBufferChunkSize();
+    QCOMPARE(initialChunkSize, qint64(16384));
+
+    // Small sequential reads make the buffer grow
+    QByteArray result;
+    char block[1000];
+    while (result.size() < data.size() / 2) {
+        const qint64 readBytes = file.read(block, sizeof(block));
+        QCOMPARE(readBytes, qint64(sizeof(block)));
+        result.append(block, int(readBytes));
+    }
+    QVERIFY(file.readBufferChunkSize() > initialChunkSize);
+    QVERIFY(file.readBufferChunkSize() <= 256 * 1024);
+    QCOMPARE(result, data.left(result.size()));
+
+    // Seeking away starts over
+    QVERIFY(file.seek(10));
+    QCOMPARE(file.readBufferChunkSize(), initialChunkSize);
+    QCOMPARE(file.read(7), data.mid(10, 7));
+
+    // Mixed reads return the right data, whichever way they are served
+    qint64 pos = 17;
+    int step = 1;
+    while (pos < data.size()) {
+        step = (step * 7 + 13) % 40000;
+        QByteArray part = file.read(step);
+        QCOMPARE(part, data.mid(pos, step));
+        pos += part.size();
+        if (pos % 3 == 0) {
+            char c;
+            if (file.getChar(&c)) {
+                QCOMPARE(c, data.at(pos));
+                ++pos;
+            }
+        }
+    }
+    QVERIFY(file.atEnd());
+    QCOMPARE(file.pos(), qint64(data.size()));
+
+    // A fixed chunk size disables growth
+    file.close();
+    file.setReadBufferChunkSize(4096);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    result.clear();
+    while (!file.atEnd())
+        result += file.read(100);
+    QCOMPARE(result, data);
+    QCOMPARE(file.readBufferChunkSize(), qint64(4096));
+
+    file.close();
+    file.remove();
+}
+
+class UpperCaseFile : public QFile
+{
+    Q_OBJECT
+public:
+    using QFile::QFile;
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override
+    {
+        const qint64 read = QFile::readData(data, maxSize);
+        for (qint64 i = 0; i < read; ++i) {
+            if (data[i] >= 'a' && data[i] <= 'z')
+                data[i] -= 'a' - 'A';
+        }
+        return read;
+    }
+};
+
+void tst_QFile::readDataReimplemented()
+{
+    QTemporaryDir dir;
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+    const QString fileName = dir.filePath("readDataReimplemented");
+    const QByteArray data = QByteArray("abcdefghij").repeated(10000);
+    {
+        QFile file(fileName);
+        QVERIFY2(file.open(QIODevice::WriteOnly), msgOpenFailed(file).constData());
+        QCOMPARE(file.write(data), qint64(data.size()));
+    }
+
+    // reads that refill the buffer must still go through readData()
+    UpperCaseFile file(fileName);
+    QVERIFY2(file.open(QIODevice::ReadOnly), msgOpenFailed(file).constData());
+    QByteArray result;
+    while (!file.atEnd())
+        result += file.read(1000);
+    QCOMPARE(result, data.toUpper());
+}
+
 void tst_QFile::openDirectory()
 {
     QFile f1(m_resourcesDir);
@@ -256,6 +256,8 @@ private slots:
     void isNativePath();
 
     void refresh();
+    void statFields();
+    void sharedCache();
 
 #if defined(Q_OS_WIN)
     void ntfsJunctionPointsAndSymlinks_data();
@@ -1642,6 +1644,101 @@ void tst_QFileInfo::refresh()
     QCOMPARE(info2.size(), info.size());
 }
 
+void tst_QFileInfo::statFields()
+{
+    const QString fileName = QDir::current().absoluteFilePath("statFields");
+    QFile file(fileName);
+    QVERIFY(file.open(QFile::WriteOnly));
+    QCOMPARE(file.write("0123456789"), qint64(10));
+    file.close();
+
+    QFileInfo info(fileName);
+    info.stat(QFileInfo::MetadataField::Size | QFileInfo::MetadataField::Times);
+    QVERIFY(info.exists());
+    QCOMPARE(info.size(), qint64(10));
+    QCOMPARE(info.lastModified(), QFileInfo(fileName).lastModified());
+
+    // attributes that were not asked for are still read on demand
+    QVERIFY(info.isFile());
+    QVERIFY(!info.isDir());
+    QCOMPARE(info.permissions(), QFileInfo(fileName).permissions());
+
+    QFileInfo all(fileName);
+    all.stat(QFileInfo::MetadataField::All);
+    QCOMPARE(all.size(), qint64(10));
+    QCOMPARE(all.permissions(), info.permissions());
+    QCOMPARE(all.ownerId(), QFileInfo(fileName).ownerId());
+
+    QFileInfo missing(fileName + QLatin1String(".missing"));
+    missing.stat(QFileInfo::MetadataField::Size);
+    QVERIFY(!missing.exists());
+}
+
+void tst_QFileInfo::sharedCache()
+{
+    QVERIFY(!QFileInfo::isSharedCacheEnabled());
+
+    const QDir dir(QDir::current().absoluteFilePath("sharedCache"));
+    QVERIFY(QDir().mkpath(dir.path()));
+    const QString fileName = dir.absoluteFilePath("file");
+    {
+        QFile file(fileName);
+        QVERIFY(file.open(QFile::WriteOnly));
+        QCOMPARE(file.write("abc"), qint64(3));
+    }
+
+    QFileInfo::setSharedCacheEnabled(true);
+    auto cleanup = qScopeGuard([] { QFileInfo::setSharedCacheEnabled(false); });
+    QVERIFY(QFileInfo::isSharedCacheEnabled());
+
+    const auto fill = [&dir] {
+        QDirIterator::traverse(dir.path(), QStringList(), QDir::Files, QDirIterator::NoIteratorFlags,
+                               [](const QFileInfoList &) { });
+    };
+    fill();
+    QCOMPARE(QFileInfo(fileName).size(), qint64(3));
+
+    // writing through QFile drops the entry
+    {
+        QFile file(fileName);
+        QVERIFY(file.open(QFile::Append));
+        QCOMPARE(file.write("def"), qint64(3));
+    }
+    QCOMPARE(QFileInfo(fileName).size(), qint64(6));
+
+#ifdef Q_OS_UNIX
+    // changes made behind our back go unnoticed until invalidated
+    fill();
+    QCOMPARE(::truncate(QFile::encodeName(fileName).constData(), 1), 0);
+    QCOMPARE(QFileInfo(fileName).size(), qint64(6));
+    QFileInfo info(fileName);
+    info.refresh();
+    QCOMPARE(info.size(), qint64(1));
+
+    QCOMPARE(dir.entryList(QDir::Files), QStringList("file"));
+    QCOMPARE(::unlink(QFile::encodeName(fileName).constData()), 0);
+    QVERIFY(QFileInfo::exists(fileName));
+    QFileInfo::invalidateSharedCache(fileName);
+    QVERIFY(!QFileInfo::exists(fileName));
+    QVERIFY(QFile(fileName).open(QFile::WriteOnly));
+#endif
+
+    // so does removing it through QFile
+    QCOMPARE(dir.entryList(QDir::Files), QStringList("file"));
+    QVERIFY(QFile::remove(fileName));
+    QVERIFY(!QFileInfo::exists(fileName));
+    QVERIFY(!QFileInfo(fileName).exists());
+
+    // disabling the cache empties it
+    QVERIFY(QFile(fileName).open(QFile::WriteOnly));
+    QCOMPARE(dir.entryList(QDir::Files), QStringList("file"));
+#ifdef Q_OS_UNIX
+    QCOMPARE(::unlink(QFile::encodeName(fileName).constData()), 0);
+    QFileInfo::setSharedCacheEnabled(false);
+    QVERIFY(!QFileInfo::exists(fileName));
+#endif
+}
+
 #if defined(Q_OS_WIN)
 
 struct NtfsTestResource {
@@ -85,6 +85,10 @@ private slots:
 #if defined(Q_OS_WIN)
     void watchDirectoryAttributeChanges();
 #endif
+#if defined(Q_OS_LINUX)
+    void recursiveWatch_data();
+    void recursiveWatch();
+#endif
 
 private:
     QString m_tempDirPattern;
@@ -841,5 +845,107 @@ void tst_QFileSystemWatcher::watchDirectoryAttributeChanges()
 }
 #endif
 
+#if defined(Q_OS_LINUX)
+static QSet<QString> changedPaths(const QSignalSpy &spy)
+{
+    QSet<QString> result;
+    for (const QList<QVariant> &arguments : spy) {
+        const QStringList paths = arguments.at(0).toStringList();
+        for (const QString &path : paths)
+            result.insert(path);
+    }
+    return result;
+}
+
+static bool writeFile(const QString &fileName)
+{
+    QFile file(fileName);
+    return file.open(QIODevice::WriteOnly) && file.write("data") == 4;
+}
+
+void tst_QFileSystemWatcher::recursiveWatch_data()
+{
+    QTest::addColumn<bool>("fanotify");
+    QTest::newRow("default") << true;
+    QTest::newRow("inotify") << false;
+}
+
+void tst_QFileSystemWatcher::recursiveWatch()
+{
+    QFETCH(bool, fanotify);
+    if (!fanotify)
+        qputenv("QT_NO_FANOTIFY", "1");
+    const auto restoreEnvironment = qScopeGuard([] { qunsetenv("QT_NO_FANOTIFY"); });
+
+    QTemporaryDir temporaryDirectory(m_tempDirPattern);
+    QVERIFY2(temporaryDirectory.isValid(), qPrintable(temporaryDirectory.errorString()));
+    const QString root = temporaryDirectory.path();
+    QDir rootDir(root);
+    QVERIFY(rootDir.mkpath("a/b/c"));
+
+    QFileSystemWatcher watcher;
+    watcher.setBatchInterval(20);
+    QCOMPARE(watcher.batchInterval(), 20);
+    QVERIFY(watcher.addRecursivePath(root));
+    QCOMPARE(watcher.recursivePaths(), QStringList(root));
+    QVERIFY(!watcher.addRecursivePath(root + "/a"));
+    QVERIFY(!watcher.addRecursivePath(root + "/a/b/c/missing"));
+    QVERIFY(watcher.directories().isEmpty());
+
+    QSignalSpy spy(&watcher, &QFileSystemWatcher::pathsChanged);
+    QVERIFY(spy.isValid());
+
+    // changes deep in the tree
+    const QString deepFile = root + "/a/b/c/deep.txt";
+    QVERIFY(writeFile(deepFile));
+    QTRY_VERIFY(changedPaths(spy).contains(deepFile));
+
+    // directories created after the watch was set up, and their contents
+    QVERIFY(rootDir.mkpath("a/new/sub"));
+    QTRY_VERIFY(changedPaths(spy).contains(root + "/a/new"));
+    const QString lateFile = root + "/a/new/sub/late.txt";
+    QVERIFY(writeFile(lateFile));
+    QTRY_VERIFY(changedPaths(spy).contains(lateFile));
+
+    // renames are reported under both names
+    QVERIFY(rootDir.rename("a/new", "a/renamed"));
+    QTRY_VERIFY(changedPaths(spy).contains(root + "/a/renamed"));
+    QVERIFY(changedPaths(spy).contains(root + "/a/new"));
+    const QString movedFile = root + "/a/renamed/sub/moved.txt";
+    QVERIFY(writeFile(movedFile));
+    QTRY_VERIFY(changedPaths(spy).contains(movedFile));
+
+    // many changes are coalesced into a few signals
+    spy.clear();
+    const int fileCount = 200;
+    for (int i = 0; i < fileCount; ++i)
+        QVERIFY(writeFile(root + QString::fromLatin1("/a/b/bulk%1").arg(i)));
+    QTRY_VERIFY(changedPaths(spy).contains(root + QString::fromLatin1("/a/b/bulk%1").arg(fileCount - 1)));
+    QTest::qWait(50);
+    QCOMPARE(changedPaths(spy).size(), fileCount);
+    QVERIFY2(spy.count() < fileCount / 2, QByteArray::number(spy.count()));
+    for (const QList<QVariant> &arguments : qAsConst(spy)) {
+        const QStringList paths = arguments.at(0).toStringList();
+        QVERIFY(std::is_sorted(paths.cbegin(), paths.cend()));
+    }
+
+    // nothing is reported once the tree is removed
+    QVERIFY(watcher.removeRecursivePath(root));
+    QVERIFY(!watcher.removeRecursivePath(root));
+    QVERIFY(watcher.recursivePaths().isEmpty());
+
+    // the tree is known by its clean path, however it was added
+    QVERIFY(watcher.addRecursivePath(root + "/a/../"));
+    QCOMPARE(watcher.recursivePaths(), QStringList(root));
+    QVERIFY(watcher.removeRecursivePath(root + "/."));
+    QVERIFY(watcher.recursivePaths().isEmpty());
+    QTest::qWait(50);
+    spy.clear();
+    QVERIFY(writeFile(deepFile));
+    QTest::qWait(100);
+    QCOMPARE(spy.count(), 0);
+}
+#endif
+
 QTEST_MAIN(tst_QFileSystemWatcher)
 #include "tst_qfilesystemwatcher.moc"
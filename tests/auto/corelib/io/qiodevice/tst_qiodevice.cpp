@@ -63,6 +63,13 @@ private slots:
     void transaction_data();
     void transaction();
 
+    void transferTo_data();
+    void transferTo();
+    void transferToSocket();
+    void transferToSequentialTarget();
+
+    void readBufferChunkSize();
+
 private:
     QSharedPointer<QTemporaryDir> m_tempDir;
     QString m_previousCurrent;
@@ -570,6 +577,27 @@ private:
     bool ownbuf;
 };
 
+class SequentialWriteBuffer : public QIODevice
+{
+public:
+    bool isSequential() const override { return true; }
+    const QByteArray &buffer() const { return buf; }
+
+protected:
+    qint64 readData(char * /* data */, qint64 /* maxSize */) override
+    {
+        return -1;
+    }
+    qint64 writeData(const char *data, qint64 maxSize) override
+    {
+        buf.append(data, maxSize);
+        return maxSize;
+    }
+
+private:
+    QByteArray buf;
+};
+
 // Test readAll() on position change for sequential device
 void tst_QIODevice::readAllKeepPosition()
 {
@@ -828,5 +856,176 @@ void tst_QIODevice::transaction()
     }
 }
 
+void tst_QIODevice::transferTo_data()
+{
+    QTest::addColumn<QString>("source");
+    QTest::addColumn<QString>("target");
+    QTest::addColumn<int>("preRead");
+    QTest::addColumn<qint64>("maxSize");
+    QTest::addColumn<int>("expected");
+
+    const int size = 600000;   // larger than the intermediate buffer
+    const QStringList devices = { "file", "buffer", "sequential" };
+    for (const QString &source : devices) {
+        for (const QString &target : { QString("file"), QString("buffer") }) {
+            const QString name = source + "-to-" + target;
+            QTest::newRow(qPrintable(name + "-all")) << source << target << 0 << qint64(-1) << size;
+            QTest::newRow(qPrintable(name + "-preread")) << source << target << 10 << qint64(-1)
+                                                         << size - 10;
+            QTest::newRow(qPrintable(name + "-limited")) << source << target << 10 << qint64(300001)
+                                                         << 300001;
+            QTest::newRow(qPrintable(name + "-none")) << source << target << 0 << qint64(0) << 0;
+        }
+    }
+}
+
+void tst_QIODevice::transferTo()
+{
+    QFETCH(QString, source);
+    QFETCH(QString, target);
+    QFETCH(int, preRead);
+    QFETCH(qint64, maxSize);
+    QFETCH(int, expected);
+
+    QByteArray data(600000, Qt::Uninitialized);
+    for (int i = 0; i < data.size(); ++i)
+        data[i] = char(i * 13 + i / 251);
+
+    QFile sourceFile("transferTo-source");
+    QBuffer sourceBuffer(&data);
+    SequentialReadBuffer sequentialBuffer(&data);
+    QIODevice *in = &sourceBuffer;
+    if (source == "file") {
+        QVERIFY(sourceFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        QCOMPARE(sourceFile.write(data), qint64(data.size()));
+        sourceFile.close();
+        in = &sourceFile;
+    } else if (source == "sequential") {
+        in = &sequentialBuffer;
+    }
+    QVERIFY(in->open(QIODevice::ReadOnly));
+    QCOMPARE(in->read(preRead).size(), preRead);
+
+    QFile targetFile("transferTo-target");
+    QByteArray targetData("prefix");
+    QBuffer targetBuffer(&targetData);
+    QIODevice *out = &targetBuffer;
+    if (target == "file") {
+        QVERIFY(targetFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        out = &targetFile;
+    } else {
+        QVERIFY(targetBuffer.open(QIODevice::WriteOnly | QIODevice::Append));
+    }
+    // Data buffered by the target goes out before the transferred data
+    const qint64 prefixSize = out->write("prefix");
+    QCOMPARE(prefixSize, qint64(6));
+
+    QCOMPARE(in->transferTo(out, maxSize), qint64(expected));
+    if (!in->isSequential())
+        QCOMPARE(in->pos(), qint64(preRead + expected));
+    QCOMPARE(in->read(4), data.mid(preRead + expected, 4));
+
+    // The target is positioned after the data
+    QCOMPARE(out->write("suffix"), qint64(6));
+    out->close();
+    if (target == "file") {
+        QVERIFY(targetFile.open(QIODevice::ReadOnly));
+        targetData = targetFile.readAll();
+        targetData.prepend("prefix");
+    }
+    QCOMPARE(targetData.size(), 6 + 6 + expected + 6);
+    QCOMPARE(targetData.mid(12, expected), data.mid(preRead, expected));
+    QVERIFY(targetData.endsWith("suffix"));
+}
+
+void tst_QIODevice::transferToSocket()
+{
+    QByteArray data(8 * 1024 * 1024 + 3, Qt::Uninitialized);
+    for (int i = 0; i < data.size(); ++i)
+        data[i] = char(i * 7 + i / 4093);
+
+    QFile file("transferToSocket");
+    QVERIFY(file.open(QIODevice::ReadWrite | QIODevice::Truncate));
+    QCOMPARE(file.write(data), qint64(data.size()));
+    QVERIFY(file.seek(0));
+
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    QTcpSocket client;
+    client.connectToHost(server.serverAddress(), server.serverPort());
+    QVERIFY(client.waitForConnected(5000));
+    QVERIFY(server.waitForNewConnection(5000));
+    QScopedPointer<QTcpSocket> peer(server.nextPendingConnection());
+    QVERIFY(peer);
+
+    QByteArray received;
+    connect(peer.data(), &QIODevice::readyRead, [&]() { received += peer->readAll(); });
+
+    qint64 sent = 0;
+    const auto sendMore = [&]() {
+        if (sent == data.size())
+            return;
+        const qint64 transferred = file.transferTo(&client);
+        QVERIFY(transferred > 0);
+        sent += transferred;
+    };
+    connect(&client, &QIODevice::bytesWritten, sendMore);
+    sendMore();
+
+    QTRY_COMPARE_WITH_TIMEOUT(received.size(), data.size(), 30000);
+    QCOMPARE(sent, qint64(data.size()));
+    QCOMPARE(file.pos(), qint64(data.size()));
+    QVERIFY(received == data);
+}
+
+void tst_QIODevice::transferToSequentialTarget()
+{
+    QByteArray data(600000, Qt::Uninitialized);
+    for (int i = 0; i < data.size(); ++i)
+        data[i] = char(i * 11 + i / 257);
+
+    QBuffer source(&data);
+    QVERIFY(source.open(QIODevice::ReadOnly));
+    SequentialWriteBuffer target;
+    QVERIFY(target.open(QIODevice::WriteOnly));
+
+    // There is no telling whether the target could take more data without
+    // blocking, so each call passes it one block only
+    QCOMPARE(source.transferTo(&target), qint64(256 * 1024));
+    QCOMPARE(target.buffer().size(), 256 * 1024);
+    QCOMPARE(source.transferTo(&target), qint64(256 * 1024));
+    QCOMPARE(source.transferTo(&target), qint64(data.size() - 512 * 1024));
+    QCOMPARE(source.transferTo(&target), qint64(0));
+    QVERIFY(target.buffer() == data);
+}
+
+void tst_QIODevice::readBufferChunkSize()
+{
+    QByteArray data(100000, Qt::Uninitialized);
+    for (int i = 0; i < data.size(); ++i)
+        data[i] = char(i % 251);
+
+    QBuffer buffer(&data);
+    QCOMPARE(buffer.readBufferChunkSize(), qint64(16384));
+
+    QTest::ignoreMessage(QtWarningMsg, "QIODevice::setReadBufferChunkSize: Invalid chunk size 0");
+    buffer.setReadBufferChunkSize(0);
+    QCOMPARE(buffer.readBufferChunkSize(), qint64(16384));
+
+    buffer.setReadBufferChunkSize(100);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QCOMPARE(buffer.readBufferChunkSize(), qint64(100));
+
+    // Small reads go through the buffer, larger ones bypass it
+    QByteArray result;
+    char c;
+    while (buffer.getChar(&c)) {
+        result += c;
+        result += buffer.read(result.size() % 150);
+    }
+    QCOMPARE(result, data);
+    QCOMPARE(buffer.readBufferChunkSize(), qint64(100));
+}
+
 QTEST_MAIN(tst_QIODevice)
 #include "tst_qiodevice.moc"
@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qmappedfiledevice
+QT = core testlib
+SOURCES = tst_qmappedfiledevice.cpp
@@ -0,0 +1,306 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <qmappedfiledevice.h>
+#include <qfile.h>
+#include <qtemporarydir.h>
+#include <qtemporaryfile.h>
+#include <qtextstream.h>
+
+class tst_QMappedFileDevice : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void openAndClose();
+    void openErrors();
+    void emptyFile();
+    void read();
+    void readAllIsView();
+    void peekIsView();
+    void readInTransaction();
+    void seek();
+    void view();
+    void advise();
+    void textStream();
+
+private:
+    QByteArray testData;
+};
+
+void tst_QMappedFileDevice::initTestCase()
+{
+    testData.resize(100000);
+    for (int i = 0; i < testData.size(); ++i)
+        testData[i] = char('a' + i % 26);
+}
+
+void tst_QMappedFileDevice::openAndClose()
+{
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(testData), qint64(testData.size()));
+    file.close();
+    const QString fileName = file.fileName();
+
+    QMappedFileDevice device(fileName);
+    QCOMPARE(device.fileName(), fileName);
+    QCOMPARE(device.size(), qint64(0));
+    QVERIFY(!device.data());
+
+    QVERIFY2(device.open(QIODevice::ReadOnly), qPrintable(device.errorString()));
+    QCOMPARE(device.openMode(), QIODevice::ReadOnly | QIODevice::Unbuffered);
+    QVERIFY(!device.isSequential());
+    QCOMPARE(device.size(), qint64(testData.size()));
+    QVERIFY(device.data());
+    QVERIFY(memcmp(device.data(), testData.constData(), testData.size()) == 0);
+
+    // The file can be removed while it is mapped
+    QVERIFY(QFile::remove(fileName));
+    QCOMPARE(device.readAll(), testData);
+
+    device.close();
+    QVERIFY(!device.isOpen());
+    QVERIFY(!device.data());
+    QCOMPARE(device.size(), qint64(0));
+}
+
+void tst_QMappedFileDevice::openErrors()
+{
+    QTemporaryDir dir;
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+    QMappedFileDevice device(dir.filePath("does-not-exist"));
+    QVERIFY(!device.open(QIODevice::ReadOnly));
+    QVERIFY(!device.errorString().isEmpty());
+    QVERIFY(!device.isOpen());
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(testData), qint64(testData.size()));
+    file.close();
+    device.setFileName(file.fileName());
+    QTest::ignoreMessage(QtWarningMsg, "QMappedFileDevice::open: Only ReadOnly is supported");
+    QVERIFY(!device.open(QIODevice::ReadWrite));
+
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    QCOMPARE(device.write("x"), qint64(-1));
+}
+
+void tst_QMappedFileDevice::emptyFile()
+{
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.close();
+    const QString fileName = file.fileName();
+
+    QMappedFileDevice device(fileName);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    QCOMPARE(device.size(), qint64(0));
+    QVERIFY(device.atEnd());
+    QVERIFY(device.readAll().isEmpty());
+    QVERIFY(device.view().isEmpty());
+    char c;
+    QVERIFY(!device.getChar(&c));
+}
+
+void tst_QMappedFileDevice::read()
+{
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(testData), qint64(testData.size()));
+    file.close();
+    const QString fileName = file.fileName();
+    QMappedFileDevice device(fileName);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+
+    char buffer[1000];
+    QCOMPARE(device.read(buffer, sizeof(buffer)), qint64(sizeof(buffer)));
+    QVERIFY(memcmp(buffer, testData.constData(), sizeof(buffer)) == 0);
+    QCOMPARE(device.pos(), qint64(sizeof(buffer)));
+
+    QCOMPARE(device.read(10), testData.mid(1000, 10));
+    QCOMPARE(device.pos(), qint64(1010));
+    char c;
+    QVERIFY(device.getChar(&c));
+    QCOMPARE(c, testData.at(1010));
+
+    QCOMPARE(device.readAll(), testData.mid(1011));
+    QVERIFY(device.atEnd());
+    QCOMPARE(device.read(10), QByteArray());
+}
+
+void tst_QMappedFileDevice::readAllIsView()
+{
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(testData), qint64(testData.size()));
+    file.close();
+    const QString fileName = file.fileName();
+    QMappedFileDevice device(fileName);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    QVERIFY(device.seek(500));
+
+    const QByteArray all = device.readAll();
+    QCOMPARE(all, testData.mid(500));
+    QCOMPARE(static_cast<const void *>(all.constData()),
+             static_cast<const void *>(device.data() + 500));
+    QCOMPARE(device.pos(), device.size());
+
+    QVERIFY(device.seek(10));
+    const QByteArray part = device.read(20);
+    QCOMPARE(static_cast<const void *>(part.constData()),
+             static_cast<const void *>(device.data() + 10));
+    QCOMPARE(device.pos(), qint64(30));
+
+    // Modifying the result detaches it from the mapping
+    QByteArray copy = part;
+    copy[0] = '!';
+    QCOMPARE(device.data()[10], uchar(testData.at(10)));
+}
+
+void tst_QMappedFileDevice::peekIsView()
+{
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(testData), qint64(testData.size()));
+    file.close();
+    const QString fileName = file.fileName();
+    QMappedFileDevice device(fileName);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    QVERIFY(device.seek(42));
+
+    const QByteArray peeked = device.peek(100);
+    QCOMPARE(peeked, testData.mid(42, 100));
+    QCOMPARE(static_cast<const void *>(peeked.constData()),
+             static_cast<const void *>(device.data() + 42));
+    QCOMPARE(device.pos(), qint64(42));
+
+    char buffer[10];
+    QCOMPARE(device.peek(buffer, sizeof(buffer)), qint64(sizeof(buffer)));
+    QVERIFY(memcmp(buffer, testData.constData() + 42, sizeof(buffer)) == 0);
+    QCOMPARE(device.pos(), qint64(42));
+}
+
+void tst_QMappedFileDevice::readInTransaction()
+{
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(testData), qint64(testData.size()));
+    file.close();
+    const QString fileName = file.fileName();
+    QMappedFileDevice device(fileName);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+
+    device.startTransaction();
+    QCOMPARE(device.read(100), testData.left(100));
+    device.rollbackTransaction();
+    QCOMPARE(device.pos(), qint64(0));
+    QCOMPARE(device.read(100), testData.left(100));
+}
+
+void tst_QMappedFileDevice::seek()
+{
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(testData), qint64(testData.size()));
+    file.close();
+    const QString fileName = file.fileName();
+    QMappedFileDevice device(fileName);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+
+    QVERIFY(device.seek(testData.size()));
+    QVERIFY(device.atEnd());
+    QTest::ignoreMessage(QtWarningMsg, "QMappedFileDevice::seek: Invalid pos: 100001");
+    QVERIFY(!device.seek(testData.size() + 1));
+    QVERIFY(device.seek(99));
+    QCOMPARE(device.read(1), testData.mid(99, 1));
+}
+
+void tst_QMappedFileDevice::view()
+{
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(testData), qint64(testData.size()));
+    file.close();
+    const QString fileName = file.fileName();
+    QMappedFileDevice device(fileName);
+    QVERIFY(device.view().isEmpty());
+    QVERIFY(device.open(QIODevice::ReadOnly));
+
+    QCOMPARE(device.view(), testData);
+    QCOMPARE(device.view(10, 5), testData.mid(10, 5));
+    QCOMPARE(device.view(testData.size() - 3, 100), testData.right(3));
+    QVERIFY(device.view(testData.size()).isEmpty());
+    QVERIFY(device.view(-1).isEmpty());
+    QCOMPARE(device.pos(), qint64(0));
+}
+
+void tst_QMappedFileDevice::advise()
+{
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(testData), qint64(testData.size()));
+    file.close();
+    const QString fileName = file.fileName();
+    QMappedFileDevice device(fileName);
+    QVERIFY(!device.advise(0, 10, QFileDevice::MapWillNeedHint));
+
+    device.setMapFlags(QFileDevice::MapPopulateOption | QFileDevice::MapSequentialHint);
+    QCOMPARE(device.mapFlags(), QFileDevice::MapPopulateOption | QFileDevice::MapSequentialHint);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    QCOMPARE(device.readAll(), testData);
+
+    QVERIFY(device.advise(0, testData.size(), QFileDevice::MapWillNeedHint));
+    QVERIFY(device.advise(5000, 10000, QFileDevice::MapRandomHint));
+    QVERIFY(device.advise(testData.size(), 0, QFileDevice::MapWillNeedHint));
+    QVERIFY(!device.advise(5000, testData.size(), QFileDevice::MapWillNeedHint));
+    QVERIFY(!device.advise(-1, 10, QFileDevice::MapWillNeedHint));
+}
+
+void tst_QMappedFileDevice::textStream()
+{
+    const QByteArray lines = "first line\nsecond line\nthird line\n";
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(lines), qint64(lines.size()));
+    file.close();
+    const QString fileName = file.fileName();
+    QMappedFileDevice device(fileName);
+    QVERIFY(device.open(QIODevice::ReadOnly | QIODevice::Text));
+
+    QTextStream stream(&device);
+    QCOMPARE(stream.readLine(), QString("first line"));
+    QCOMPARE(stream.readLine(), QString("second line"));
+    QCOMPARE(stream.readLine(), QString("third line"));
+    QVERIFY(stream.atEnd());
+}
+
+QTEST_GUILESS_MAIN(tst_QMappedFileDevice)
+#include "tst_qmappedfiledevice.moc"
@@ -151,6 +151,11 @@ private slots:
     void isWritable_data();
     void isWritable();
     void registerFormat();
+    void binaryFormat();
+    void binaryFormatCompaction();
+#ifdef Q_OS_UNIX
+    void binaryFormatChangeDetection();
+#endif
     void setPath();
     void setDefaultFormat();
     void dontCreateNeedlessPaths();
@@ -3339,6 +3344,141 @@ void tst_QSettings::registerFormat()
     }
 }
 
+void tst_QSettings::binaryFormat()
+{
+    const QSettings::Format format = QSettings::registerBinaryFormat("qsb");
+    QVERIFY(format >= QSettings::CustomFormat1);
+    QCOMPARE(QSettings::registerBinaryFormat("qsb"), format);
+
+    const QString fileName = settingsPath("binary.qsb");
+    const QDateTime dateTime(QDate(2020, 1, 1), QTime(12, 0));
+    {
+        QSettings settings(fileName, format);
+        QCOMPARE(settings.status(), QSettings::NoError);
+        QVERIFY(settings.isWritable());
+        settings.setValue("alpha", 1);
+        settings.setValue("Alpha", QString("upper"));
+        settings.setValue("group/beta", QStringList{ "x", "y" });
+        settings.setValue("group/delta", dateTime);
+        settings.setValue("group/sub/gamma", QByteArray("\0\1", 2));
+        settings.sync();
+        QCOMPARE(settings.status(), QSettings::NoError);
+    }
+#ifdef QT_BUILD_INTERNAL
+    QConfFile::clearCache();
+#endif
+    {
+        QSettings settings(fileName, format);
+        QCOMPARE(settings.status(), QSettings::NoError);
+        QCOMPARE(settings.value("alpha").toInt(), 1);
+        QCOMPARE(settings.value("Alpha").toString(), QString("upper"));
+        QCOMPARE(settings.value("group/beta").toStringList(), QStringList({ "x", "y" }));
+        QCOMPARE(settings.value("group/delta").toDateTime(), dateTime);
+        QCOMPARE(settings.value("group/sub/gamma").toByteArray(), QByteArray("\0\1", 2));
+        QVERIFY(!settings.contains("missing"));
+        QCOMPARE(settings.allKeys(),
+                 QStringList({ "Alpha", "alpha", "group/beta", "group/delta", "group/sub/gamma" }));
+
+        settings.beginGroup("group");
+        QCOMPARE(settings.childKeys(), QStringList({ "beta", "delta" }));
+        QCOMPARE(settings.childGroups(), QStringList("sub"));
+        settings.endGroup();
+
+        // these end up in the log of the file
+        settings.remove("group");
+        settings.setValue("alpha", 2);
+        settings.sync();
+        QCOMPARE(settings.status(), QSettings::NoError);
+        QCOMPARE(settings.allKeys(), QStringList({ "Alpha", "alpha" }));
+        QCOMPARE(settings.value("alpha").toInt(), 2);
+    }
+#ifdef QT_BUILD_INTERNAL
+    QConfFile::clearCache();
+#endif
+    {
+        QSettings settings(fileName, format);
+        QCOMPARE(settings.allKeys(), QStringList({ "Alpha", "alpha" }));
+        QCOMPARE(settings.value("alpha").toInt(), 2);
+        QVERIFY(!settings.contains("group/beta"));
+
+        settings.clear();
+        settings.sync();
+        QCOMPARE(settings.status(), QSettings::NoError);
+        QVERIFY(settings.allKeys().isEmpty());
+    }
+
+    QFile garbage(settingsPath("garbage.qsb"));
+    QVERIFY(garbage.open(QIODevice::WriteOnly));
+    garbage.write(QByteArray(64, 'x'));
+    garbage.close();
+    {
+        QSettings settings(garbage.fileName(), format);
+        QCOMPARE(settings.status(), QSettings::FormatError);
+        QVERIFY(settings.allKeys().isEmpty());
+    }
+}
+
+void tst_QSettings::binaryFormatCompaction()
+{
+    const QSettings::Format format = QSettings::registerBinaryFormat("qsb");
+    const QString fileName = settingsPath("compaction.qsb");
+    const QString value(100, QLatin1Char('x'));
+
+    {
+        QSettings settings(fileName, format);
+        settings.setValue("fixed", 42);
+        for (int round = 0; round < 20; ++round) {
+            for (int i = 0; i < 50; ++i)
+                settings.setValue(QString("key%1").arg(i), value + QString::number(round));
+            settings.sync();
+            QCOMPARE(settings.status(), QSettings::NoError);
+
+            // each round appends about 12 KB to the log, which gets compacted at 64 KB
+            QVERIFY2(QFileInfo(fileName).size() < 128 * 1024,
+                     qPrintable(QString::number(QFileInfo(fileName).size())));
+        }
+    }
+#ifdef QT_BUILD_INTERNAL
+    QConfFile::clearCache();
+#endif
+    QSettings settings(fileName, format);
+    QCOMPARE(settings.status(), QSettings::NoError);
+    QCOMPARE(settings.allKeys().size(), 51);
+    QCOMPARE(settings.value("fixed").toInt(), 42);
+    QCOMPARE(settings.value("key7").toString(), value + QLatin1String("19"));
+}
+
+#ifdef Q_OS_UNIX
+void tst_QSettings::binaryFormatChangeDetection()
+{
+    const QSettings::Format format = QSettings::registerBinaryFormat("qsb");
+    const QString fileName = settingsPath("shared.qsb");
+    const QString linkName = settingsPath("shared-link.qsb");
+
+    QSettings writer(fileName, format);
+    writer.setValue("counter", 0);
+    writer.sync();
+    QCOMPARE(writer.status(), QSettings::NoError);
+
+    // The link makes the reader use its own mapping of the file, like
+    // another process would.
+    QVERIFY(QFile::link(fileName, linkName));
+    QSettings reader(linkName, format);
+    QCOMPARE(reader.value("counter").toInt(), 0);
+
+    // enough rounds for the writer to compact the file a few times
+    const QString padding(200, QLatin1Char('p'));
+    for (int i = 1; i <= 600; ++i) {
+        writer.setValue("counter", i);
+        writer.setValue(QString("padding%1").arg(i % 100), padding);
+        writer.sync();
+        reader.sync();
+        QCOMPARE(reader.value("counter").toInt(), i);
+    }
+    QCOMPARE(reader.allKeys().size(), 101);
+}
+#endif
+
 void tst_QSettings::setPath()
 {
 #define TEST_PATH(doSet, ext, format, scope, path) \
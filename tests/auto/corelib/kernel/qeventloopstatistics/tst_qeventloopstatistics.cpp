@@ -0,0 +1,294 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qthread.h>
+#include <QtCore/private/qeventloopstatistics_p.h>
+#include <QtCore/private/qhooks_p.h>
+
+class EventSink : public QObject
+{
+    Q_OBJECT
+public:
+    int received = 0;
+    int sleepMSecs = 0;
+
+protected:
+    bool event(QEvent *e) override
+    {
+        if (e->type() == QEvent::User) {
+            ++received;
+            if (sleepMSecs)
+                QThread::msleep(sleepMSecs);
+            return true;
+        }
+        return QObject::event(e);
+    }
+};
+
+class tst_QEventLoopStatistics : public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+
+    void histogram();
+    void histogramPercentiles();
+    void histogramTopRange();
+    void enable();
+    void postedEvents();
+    void sentEvents();
+    void disabled();
+    void finishedThreads();
+    void dump();
+
+private:
+    static QEventLoopStatistics::Entry find(int type, const QByteArray &receiverClass);
+};
+
+void tst_QEventLoopStatistics::init()
+{
+    QEventLoopStatistics::reset();
+}
+
+void tst_QEventLoopStatistics::cleanup()
+{
+    QEventLoopStatistics::setEnabled(false);
+}
+
+QEventLoopStatistics::Entry tst_QEventLoopStatistics::find(int type, const QByteArray &receiverClass)
+{
+    const auto entries = QEventLoopStatistics::snapshot();
+    for (const auto &entry : entries) {
+        if (entry.eventType == type && entry.receiverClass == receiverClass
+            && entry.threadId == QThread::currentThreadId()) {
+            return entry;
+        }
+    }
+    return {};
+}
+
+void tst_QEventLoopStatistics::histogram()
+{
+    QEventLoopStatistics::Histogram h;
+    QCOMPARE(h.count(), quint64(0));
+    QCOMPARE(h.valueAtPercentile(50), qint64(0));
+
+    h.record(5);
+    h.record(-3);
+    h.record(1000);
+    QCOMPARE(h.count(), quint64(3));
+    QCOMPARE(h.minimum(), qint64(0));
+    QCOMPARE(h.maximum(), qint64(1000));
+    QCOMPARE(h.total(), qint64(1005));
+    QCOMPARE(h.valueAtPercentile(0), qint64(0));
+    QCOMPARE(h.valueAtPercentile(100), qint64(1000));
+
+    // beyond the last bucket only the maximum stays exact
+    const qint64 huge = Q_INT64_C(1) << 40;
+    h.record(huge);
+    QCOMPARE(h.maximum(), huge);
+    QCOMPARE(h.valueAtPercentile(100), huge);
+
+    QEventLoopStatistics::Histogram other;
+    other.record(3);
+    other.record(2000);
+    h.add(other);
+    QCOMPARE(h.count(), quint64(6));
+    QCOMPARE(h.minimum(), qint64(0));
+    QCOMPARE(h.total(), qint64(1005) + huge + 2003);
+    QCOMPARE(h.valueAtPercentile(100), huge);
+
+    h.reset();
+    QCOMPARE(h.count(), quint64(0));
+    QCOMPARE(h.maximum(), qint64(0));
+}
+
+void tst_QEventLoopStatistics::histogramPercentiles()
+{
+    QEventLoopStatistics::Histogram h;
+    for (qint64 i = 1; i <= 100000; ++i)
+        h.record(i * 1000);
+
+    // the relative error is bounded by the sub-bucket resolution
+    const double precision = 1.0 / (1 << (QEventLoopStatistics::Histogram::SubBucketBits - 1));
+    for (double percentile : { 1.0, 25.0, 50.0, 90.0, 99.0, 99.9 }) {
+        const double expected = percentile * 1000 * 1000;
+        const qint64 actual = h.valueAtPercentile(percentile);
+        QVERIFY2(actual >= expected && actual <= expected * (1 + precision),
+                 qPrintable(QString::number(percentile) + ": " + QString::number(actual)));
+    }
+}
+
+void tst_QEventLoopStatistics::histogramTopRange()
+{
+    // the highest regular bucket covers [15 * 2^32, 2^36) and must not be
+    // mixed up with the samples beyond it
+    const qint64 top = Q_INT64_C(15) << 32;
+    const qint64 limit = Q_INT64_C(1) << 36;
+    const qint64 huge = Q_INT64_C(1) << 40;
+    QEventLoopStatistics::Histogram h;
+    for (int i = 0; i < 50; ++i) {
+        h.record(top);
+        h.record(limit - 1);
+    }
+    h.record(huge);
+
+    QCOMPARE(h.minimum(), top);
+    QCOMPARE(h.valueAtPercentile(50), limit - 1);
+    QCOMPARE(h.valueAtPercentile(99), limit - 1);
+    QCOMPARE(h.valueAtPercentile(100), huge);
+}
+
+void tst_QEventLoopStatistics::enable()
+{
+    QVERIFY(!QEventLoopStatistics::isEnabled());
+    QVERIFY(QEventLoopStatistics::setEnabled(true));
+    QVERIFY(QEventLoopStatistics::isEnabled());
+    QVERIFY(qtHookData[QHooks::EventDequeued]);
+    QVERIFY(qtHookData[QHooks::EventNotifyEnd]);
+
+    QVERIFY(QEventLoopStatistics::setEnabled(false));
+    QVERIFY(!QEventLoopStatistics::isEnabled());
+    QCOMPARE(qtHookData[QHooks::EventDequeued], quintptr(0));
+    QCOMPARE(qtHookData[QHooks::EventNotifyBegin], quintptr(0));
+    QCOMPARE(qtHookData[QHooks::EventNotifyEnd], quintptr(0));
+
+    // refuse to replace somebody else's hook
+    const auto foreignHook = [](QObject *, QEvent *) {};
+    qtHookData[QHooks::EventNotifyBegin] = quintptr(+foreignHook);
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QEventLoopStatistics: event hooks are in use by another tool");
+    QVERIFY(!QEventLoopStatistics::setEnabled(true));
+    QVERIFY(!QEventLoopStatistics::isEnabled());
+    QCOMPARE(qtHookData[QHooks::EventDequeued], quintptr(0));
+    qtHookData[QHooks::EventNotifyBegin] = 0;
+}
+
+void tst_QEventLoopStatistics::postedEvents()
+{
+    EventSink sink;
+    sink.sleepMSecs = 2;
+    QVERIFY(QEventLoopStatistics::setEnabled(true));
+
+    for (int i = 0; i < 10; ++i)
+        QCoreApplication::postEvent(&sink, new QEvent(QEvent::User));
+    QThread::msleep(5);
+    QCoreApplication::sendPostedEvents(&sink, QEvent::User);
+    QCOMPARE(sink.received, 10);
+
+    const auto entry = find(QEvent::User, "EventSink");
+    QCOMPARE(entry.queueWait.count(), quint64(10));
+    QCOMPARE(entry.dispatch.count(), quint64(10));
+    QVERIFY(entry.queueWait.minimum() >= 5 * 1000 * 1000);
+    QVERIFY(entry.dispatch.minimum() >= 2 * 1000 * 1000);
+    // the last event waited for all the others to be delivered
+    QVERIFY(entry.queueWait.maximum() >= entry.queueWait.minimum() + 9 * 2 * 1000 * 1000);
+}
+
+void tst_QEventLoopStatistics::sentEvents()
+{
+    EventSink sink;
+    QVERIFY(QEventLoopStatistics::setEnabled(true));
+
+    QEvent event(QEvent::User);
+    QCoreApplication::sendEvent(&sink, &event);
+    QCoreApplication::sendEvent(&sink, &event);
+    QCOMPARE(sink.received, 2);
+
+    const auto entry = find(QEvent::User, "EventSink");
+    QCOMPARE(entry.queueWait.count(), quint64(0));
+    QCOMPARE(entry.dispatch.count(), quint64(2));
+}
+
+void tst_QEventLoopStatistics::disabled()
+{
+    EventSink sink;
+    QEvent event(QEvent::User);
+    QCoreApplication::sendEvent(&sink, &event);
+
+    // posted before enabling, so not timestamped
+    QCoreApplication::postEvent(&sink, new QEvent(QEvent::User));
+    QVERIFY(QEventLoopStatistics::setEnabled(true));
+    QCoreApplication::sendPostedEvents(&sink, QEvent::User);
+    QCOMPARE(sink.received, 2);
+
+    const auto entry = find(QEvent::User, "EventSink");
+    QCOMPARE(entry.queueWait.count(), quint64(0));
+    QCOMPARE(entry.dispatch.count(), quint64(1));
+}
+
+void tst_QEventLoopStatistics::finishedThreads()
+{
+    QVERIFY(QEventLoopStatistics::setEnabled(true));
+
+    const auto sendEvents = [](int count) {
+        return QThread::create([count] {
+            EventSink sink;
+            QEvent event(QEvent::User);
+            for (int i = 0; i < count; ++i)
+                QCoreApplication::sendEvent(&sink, &event);
+        });
+    };
+    QScopedPointer<QThread> first(sendEvents(2));
+    first->start();
+    QVERIFY(first->wait());
+    QScopedPointer<QThread> second(sendEvents(3));
+    second->start();
+    QVERIFY(second->wait());
+
+    // the threads are gone, only their merged data is left
+    quint64 dispatched = 0;
+    const auto entries = QEventLoopStatistics::snapshot();
+    for (const auto &entry : entries) {
+        if (entry.receiverClass != "EventSink" || entry.threadId == QThread::currentThreadId())
+            continue;
+        QCOMPARE(entry.threadId, Qt::HANDLE(nullptr));
+        QCOMPARE(entry.threadName, QStringLiteral("finished threads"));
+        dispatched += entry.dispatch.count();
+    }
+    QCOMPARE(dispatched, quint64(5));
+}
+
+void tst_QEventLoopStatistics::dump()
+{
+    EventSink sink;
+    QVERIFY(QEventLoopStatistics::setEnabled(true));
+    QCoreApplication::postEvent(&sink, new QEvent(QEvent::User));
+    QCoreApplication::sendPostedEvents(&sink, QEvent::User);
+
+    const QString text = QEventLoopStatistics::dump();
+    QVERIFY2(text.contains(QLatin1String("EventSink")), qPrintable(text));
+    QVERIFY2(text.contains(QLatin1String("User")), qPrintable(text));
+}
+
+QTEST_MAIN(tst_QEventLoopStatistics)
+#include "tst_qeventloopstatistics.moc"
@@ -322,6 +322,7 @@ private slots:
     void indexOfMethod();
 
     void indexOfMethodPMF();
+    void nameHash();
 
     void signalOffset_data();
     void signalOffset();
@@ -1710,6 +1711,80 @@ void tst_QMetaObject::indexOfMethodPMF()
     INDEXOFMETHODPMF_HELPER(QtTestCustomObject, sig_custom, (const CustomString &))
 }
 
+class NameHashBase : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int shadowed READ shadowed CONSTANT)
+public:
+    int shadowed() const { return 0; }
+signals:
+    void baseSignal();
+public slots:
+    void overridden() {}
+};
+
+class NameHashObject : public NameHashBase
+{
+    Q_OBJECT
+    Q_PROPERTY(int alpha READ alpha CONSTANT)
+    Q_PROPERTY(int beta READ beta CONSTANT)
+    Q_PROPERTY(QString shadowed READ text CONSTANT)
+    Q_PROPERTY(QString text READ text CONSTANT)
+public:
+    int alpha() const { return 1; }
+    int beta() const { return 2; }
+    Q_INVOKABLE QString text() const { return QString(); }
+signals:
+    void changed();
+    void changed(int value);
+    void changed(const QString &value);
+    void finished();
+public slots:
+    void overridden() {}
+    void update(int x = 0, int y = 0) { Q_UNUSED(x); Q_UNUSED(y); }
+    void reset() {}
+    void start() {}
+    void stop() {}
+    void clear() {}
+};
+
+void tst_QMetaObject::nameHash()
+{
+    const QMetaObject *mo = &NameHashObject::staticMetaObject;
+    QVERIFY(QMetaObjectPrivate::get(mo)->nameHashData);
+    // too few names to be worth a hash
+    QVERIFY(!QMetaObjectPrivate::get(&NameHashBase::staticMetaObject)->nameHashData);
+
+    for (int i = mo->methodOffset(); i < mo->methodCount(); ++i) {
+        const QMetaMethod method = mo->method(i);
+        const QByteArray signature = method.methodSignature();
+        const bool isSignal = method.methodType() == QMetaMethod::Signal;
+        QCOMPARE(mo->indexOfMethod(signature), i);
+        QCOMPARE(mo->indexOfSignal(signature), isSignal ? i : -1);
+        QCOMPARE(mo->indexOfSlot(signature), isSignal ? -1 : i);
+    }
+    for (int i = mo->propertyOffset(); i < mo->propertyCount(); ++i)
+        QCOMPARE(mo->indexOfProperty(mo->property(i).name()), i);
+
+    // names of the class hide those of its base class, others are found there
+    QCOMPARE(mo->indexOfProperty("shadowed"), mo->propertyOffset() + 2);
+    QVERIFY(mo->indexOfSlot("overridden()") >= mo->methodOffset());
+    const int baseSignal = NameHashBase::staticMetaObject.indexOfSignal("baseSignal()");
+    QVERIFY(baseSignal >= 0);
+    QCOMPARE(mo->indexOfSignal("baseSignal()"), baseSignal);
+    QCOMPARE(mo->indexOfMethod("deleteLater()"),
+             QObject::staticMetaObject.indexOfMethod("deleteLater()"));
+    QCOMPARE(mo->indexOfProperty("objectName"), 0);
+
+    // unknown names, and names only used by another kind of member
+    QCOMPARE(mo->indexOfMethod("missing()"), -1);
+    QCOMPARE(mo->indexOfMethod("alpha()"), -1);
+    QCOMPARE(mo->indexOfMethod("changed(double)"), -1);
+    QCOMPARE(mo->indexOfSlot("changed()"), -1);
+    QCOMPARE(mo->indexOfProperty("changed"), -1);
+    QCOMPARE(mo->indexOfProperty("missing"), -1);
+}
+
 namespace SignalTestHelper
 {
 // These functions use the public QMetaObject/QMetaMethod API to implement
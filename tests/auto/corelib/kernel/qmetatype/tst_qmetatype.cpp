@@ -178,6 +178,8 @@ private:
 private slots:
     void defined();
     void threadSafety();
+    void concurrentRegistrationAndLookup();
+    void removedConvertersAreFreed();
     void namespaces();
     void id();
     void qMetaTypeId();
@@ -576,6 +578,125 @@ void tst_QMetaType::threadSafety()
     QCOMPARE(Bar::failureCount, 0);
 }
 
+struct RegistryProbe
+{
+    int value;
+};
+
+void tst_QMetaType::concurrentRegistrationAndLookup()
+{
+    const int probeId = qRegisterMetaType<RegistryProbe>("RegistryProbe");
+    QVERIFY((QMetaType::registerConverter<RegistryProbe, int>(
+            [](const RegistryProbe &probe) { return probe.value; })));
+
+    // the writer keeps growing the name registry and adds and removes a
+    // converter, while the readers look up what was registered up front
+    const int aliasCount = 2000;
+    QAtomicInt writing = 1;
+    QScopedPointer<QThread> writer(QThread::create([&writing, probeId] {
+        const auto converter = [](const void *, void *) { return true; };
+        for (int i = 0; i < aliasCount; ++i) {
+            QMetaType::registerNormalizedTypedef("RegistryProbeAlias" + QByteArray::number(i),
+                                                 QMetaType(probeId));
+            QMetaType::registerConverterFunction(converter, probeId, QMetaType::Long);
+            QMetaType::unregisterConverterFunction(probeId, QMetaType::Long);
+        }
+        writing.storeRelease(0);
+    }));
+
+    QAtomicInt failures;
+    std::vector<std::unique_ptr<QThread>> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back(QThread::create([&writing, &failures, probeId] {
+            const RegistryProbe probe = { 42 };
+            do {
+                int result = 0;
+                if (QMetaType::fromName("RegistryProbe").id() != probeId
+                        || !QMetaType(probeId).isValid()
+                        || !QMetaType::convert(QMetaType(probeId), &probe,
+                                               QMetaType::fromType<int>(), &result)
+                        || result != 42) {
+                    failures.ref();
+                }
+            } while (writing.loadAcquire());
+        }));
+        readers.back()->start();
+    }
+    writer->start();
+
+    QVERIFY(writer->wait());
+    for (const auto &reader : readers)
+        QVERIFY(reader->wait());
+    QCOMPARE(failures.loadRelaxed(), 0);
+
+    for (int i = 0; i < aliasCount; ++i)
+        QCOMPARE(QMetaType::fromName("RegistryProbeAlias" + QByteArray::number(i)).id(), probeId);
+    QVERIFY(!QMetaType::hasRegisteredConverterFunction(probeId, QMetaType::Long));
+}
+
+struct CountedConverter
+{
+    static QAtomicInt instances;
+
+    CountedConverter() { instances.ref(); }
+    CountedConverter(const CountedConverter &) { instances.ref(); }
+    ~CountedConverter() { instances.deref(); }
+    bool operator()(const void *, void *) const { return true; }
+};
+
+QAtomicInt CountedConverter::instances;
+
+void tst_QMetaType::removedConvertersAreFreed()
+{
+    const int probeId = qRegisterMetaType<RegistryProbe>("RegistryProbe");
+    if (!QMetaType::hasRegisteredConverterFunction(probeId, QMetaType::Int)) {
+        QVERIFY((QMetaType::registerConverter<RegistryProbe, int>(
+                [](const RegistryProbe &probe) { return probe.value; })));
+    }
+
+    // converters that were removed while readers were looking must be
+    // destroyed once the readers are done, not kept until shutdown
+    QAtomicInt writing = 1;
+    QAtomicInt failures;
+    std::vector<std::unique_ptr<QThread>> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back(QThread::create([&writing, &failures, probeId] {
+            const RegistryProbe probe = { 42 };
+            do {
+                int result = 0;
+                if (!QMetaType::convert(QMetaType(probeId), &probe,
+                                        QMetaType::fromType<int>(), &result)
+                        || result != 42) {
+                    failures.ref();
+                }
+                QMetaType::hasRegisteredConverterFunction(probeId, QMetaType::Short);
+            } while (writing.loadAcquire());
+        }));
+        readers.back()->start();
+    }
+
+    int maxInstances = 0;
+    for (int i = 0; i < 20000; ++i) {
+        QMetaType::registerConverterFunction(CountedConverter(), probeId, QMetaType::Short);
+        QMetaType::unregisterConverterFunction(probeId, QMetaType::Short);
+        maxInstances = qMax(maxInstances, CountedConverter::instances.loadRelaxed());
+    }
+    writing.storeRelease(0);
+    for (const auto &reader : readers)
+        QVERIFY(reader->wait());
+    QCOMPARE(failures.loadRelaxed(), 0);
+
+    // a few converters may be waiting for readers, but not one per cycle
+    QVERIFY2(maxInstances < 1000, QByteArray::number(maxInstances));
+
+    // once nobody reads, two more writes free whatever was held back
+    for (int i = 0; i < 2; ++i) {
+        QMetaType::registerConverterFunction(CountedConverter(), probeId, QMetaType::Short);
+        QMetaType::unregisterConverterFunction(probeId, QMetaType::Short);
+    }
+    QVERIFY(CountedConverter::instances.loadRelaxed() <= 1);
+}
+
 namespace TestSpace
 {
     struct Foo { double d; public: ~Foo() {} };
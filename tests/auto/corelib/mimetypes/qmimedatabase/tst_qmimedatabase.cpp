@@ -43,6 +43,11 @@
 #include <QtCore/QTextStream>
 #include <QtConcurrent/QtConcurrentRun>
 
+#ifdef QT_BUILD_INTERNAL
+#include <QtCore/private/qmimeprovider_p.h>
+#include <QtCore/private/qmimetypeparser_p.h>
+#endif
+
 #include <QtTest/QtTest>
 
 static const char *const additionalMimeFiles[] = {
@@ -869,6 +874,170 @@ void tst_QMimeDatabase::fromThreads()
     QVERIFY(tp.waitForDone(60000));
 }
 
+#ifdef QT_BUILD_INTERNAL
+class MagicMatcherCollector : public QMimeTypeParserBase
+{
+public:
+    QList<QMimeMagicRuleMatcher> matchers;
+
+protected:
+    bool process(const QMimeType &, QString *) override { return true; }
+    bool process(const QMimeGlobPattern &, QString *) override { return true; }
+    void processParent(const QString &, const QString &) override {}
+    void processAlias(const QString &, const QString &) override {}
+    void processMagicMatcher(const QMimeMagicRuleMatcher &matcher) override { matchers.append(matcher); }
+};
+#endif
+
+void tst_QMimeDatabase::magicMatcherSet()
+{
+#ifndef QT_BUILD_INTERNAL
+    QSKIP("This test requires a developer build");
+#else
+    QFile file(QLatin1String(RESOURCE_PREFIX "packages/freedesktop.org.xml"));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    MagicMatcherCollector collector;
+    QString errorMessage;
+    QVERIFY2(collector.parse(&file, file.fileName(), &errorMessage), qPrintable(errorMessage));
+    QVERIFY(collector.matchers.size() > 100);
+
+    QMimeMagicRuleMatcherSet set;
+    for (const QMimeMagicRuleMatcher &matcher : qAsConst(collector.matchers))
+        set.append(matcher);
+
+    // Data that passes the prefilter of each rule, followed by the beginning of
+    // the XML, so that the full rules both match and fail
+    QList<QByteArray> samples = { QByteArray(), QByteArray(1, 'a'), QByteArray(64, '\0') };
+    file.seek(0);
+    const QByteArray text = file.read(512);
+    for (const QMimeMagicRuleMatcher &matcher : qAsConst(collector.matchers)) {
+        for (const QMimeMagicRule &rule : matcher.magicRules()) {
+            quint32 value;
+            quint32 mask;
+            if (!rule.fixedPrefix(&value, &mask))
+                value = 0;
+            QByteArray sample(rule.startPos(), '\0');
+            sample.append(reinterpret_cast<const char *>(&value), sizeof(value));
+            samples.append(sample);
+            samples.append(sample + text);
+            samples.append(sample.left(sample.size() - 1));
+        }
+    }
+
+    for (const QByteArray &sample : qAsConst(samples)) {
+        for (unsigned minimumPriority : { 0, 50, 80 }) {
+            const QMimeMagicRuleMatcher *expected = nullptr;
+            unsigned bestPriority = minimumPriority;
+            for (const QMimeMagicRuleMatcher &matcher : qAsConst(collector.matchers)) {
+                if (matcher.priority() > bestPriority && matcher.matches(sample)) {
+                    expected = &matcher;
+                    bestPriority = matcher.priority();
+                }
+            }
+            const QMimeMagicRuleMatcher *actual = set.bestMatch(sample, minimumPriority);
+            QCOMPARE(actual ? actual->mimetype() : QString(), expected ? expected->mimetype() : QString());
+        }
+    }
+#endif
+}
+
+void tst_QMimeDatabase::internalDatabaseIndex()
+{
+#if !QT_CONFIG(mimetype_database) || !defined(QT_BUILD_INTERNAL)
+    QSKIP("This test requires the internal MIME database and a developer build");
+#else
+    QMimeIndexProvider indexProvider(nullptr);
+    if (!indexProvider.isValid())
+        QSKIP("The internal MIME database was generated without an index");
+    QMimeXMLProvider xmlProvider(nullptr, QMimeXMLProvider::InternalDatabase);
+
+    QList<QMimeType> xmlTypes;
+    xmlProvider.addAllMimeTypes(xmlTypes);
+    QList<QMimeType> indexTypes;
+    indexProvider.addAllMimeTypes(indexTypes);
+    QCOMPARE(indexTypes.size(), xmlTypes.size());
+
+    QStringList fileNames = { QString(), QStringLiteral("foo"), QStringLiteral("core"),
+                              QStringLiteral("README"), QStringLiteral("README.md"),
+                              QStringLiteral("Makefile.am"), QStringLiteral("123.vdr"),
+                              QStringLiteral("foo.anim5"), QStringLiteral("foo.tar.bz2"),
+                              QStringLiteral("foo.TXT"), QStringLiteral("foo~") };
+    for (const QMimeType &xmlType : qAsConst(xmlTypes)) {
+        const QString name = xmlType.name();
+        const QMimeType indexType = indexProvider.mimeTypeForName(name);
+        QVERIFY2(indexType.isValid(), qPrintable(name));
+
+        const QMimeTypePrivate xmlData(xmlType);
+        QMimeTypePrivate indexData(indexType);
+        QVERIFY(!indexData.loaded);
+        indexProvider.loadMimeTypePrivate(indexData);
+        QVERIFY(indexData.loaded);
+        QCOMPARE(indexData.localeComments, xmlData.localeComments);
+        QCOMPARE(indexData.globPatterns, xmlData.globPatterns);
+        indexProvider.loadIcon(indexData);
+        QCOMPARE(indexData.iconName, xmlData.iconName);
+        indexProvider.loadGenericIcon(indexData);
+        QCOMPARE(indexData.genericIconName, xmlData.genericIconName);
+
+        QStringList xmlParents, indexParents;
+        xmlProvider.addParents(name, xmlParents);
+        indexProvider.addParents(name, indexParents);
+        QCOMPARE(indexParents, xmlParents);
+
+        QStringList xmlAliases, indexAliases;
+        xmlProvider.addAliases(name, xmlAliases);
+        indexProvider.addAliases(name, indexAliases);
+        xmlAliases.sort();
+        indexAliases.sort();
+        QCOMPARE(indexAliases, xmlAliases);
+        for (const QString &alias : qAsConst(xmlAliases))
+            QCOMPARE(indexProvider.resolveAlias(alias), name);
+
+        for (QString pattern : xmlData.globPatterns) {
+            if (pattern.contains(QLatin1Char('[')))
+                continue;
+            pattern.replace(QLatin1Char('*'), QLatin1String("foo")).replace(QLatin1Char('?'), QLatin1Char('x'));
+            fileNames << pattern << pattern.toUpper() << QLatin1String("x.") + pattern;
+        }
+    }
+    QVERIFY(indexProvider.resolveAlias(QStringLiteral("text/x-nonexistent")).isEmpty());
+
+    for (const QString &fileName : qAsConst(fileNames)) {
+        QMimeGlobMatchResult xmlResult, indexResult;
+        xmlProvider.addFileNameMatches(fileName, xmlResult);
+        indexProvider.addFileNameMatches(fileName, indexResult);
+        QCOMPARE(indexResult.m_matchingMimeTypes, xmlResult.m_matchingMimeTypes);
+        QCOMPARE(indexResult.m_allMatchingMimeTypes, xmlResult.m_allMatchingMimeTypes);
+        QCOMPARE(indexResult.m_weight, xmlResult.m_weight);
+        QCOMPARE(indexResult.m_matchingPatternLength, xmlResult.m_matchingPatternLength);
+        QCOMPARE(indexResult.m_knownSuffixLength, xmlResult.m_knownSuffixLength);
+    }
+
+    QList<QByteArray> samples = {
+        QByteArray(), QByteArray(64, '\0'), QByteArray("\x89PNG\r\n\x1a\n"), QByteArray("%PDF-1.4\n"),
+        QByteArray("PK\x03\x04"), QByteArray("\x7f" "ELF\x02\x01\x01"), QByteArray("\x1f\x8b\x08"),
+        QByteArray("GIF89a"), QByteArray("#!/bin/sh\n"), QByteArray("%!PS-Adobe-3.0"),
+        QByteArray("<?xml version=\"1.0\"?>\n<svg xmlns=\"http://www.w3.org/2000/svg\">"),
+        QByteArray("<!DOCTYPE html><html>"), QByteArray("{\\rtf1")
+    };
+    QDirIterator it(QLatin1String(RESOURCE_PREFIX));
+    while (it.hasNext()) {
+        QFile file(it.next());
+        if (file.open(QIODevice::ReadOnly))
+            samples.append(file.read(16384));
+    }
+    for (const QByteArray &sample : qAsConst(samples)) {
+        int xmlAccuracy = 0;
+        int indexAccuracy = 0;
+        QMimeType xmlCandidate, indexCandidate;
+        xmlProvider.findByMagic(sample, &xmlAccuracy, xmlCandidate);
+        indexProvider.findByMagic(sample, &indexAccuracy, indexCandidate);
+        QCOMPARE(indexCandidate.name(), xmlCandidate.name());
+        QCOMPARE(indexAccuracy, xmlAccuracy);
+    }
+#endif
+}
+
 #if QT_CONFIG(process)
 
 enum {
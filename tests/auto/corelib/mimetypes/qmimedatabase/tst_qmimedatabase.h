@@ -68,6 +68,8 @@ private slots:
     void knownSuffix();
     void symlinkToFifo();
     void fromThreads();
+    void magicMatcherSet();
+    void internalDatabaseIndex();
 
     // shared-mime-info test suite
 
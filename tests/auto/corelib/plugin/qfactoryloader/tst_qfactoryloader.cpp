@@ -30,7 +30,12 @@
 #include <QtCore/qdir.h>
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qplugin.h>
+#include <QtCore/qscopeguard.h>
+#include <QtCore/qtemporarydir.h>
 #include <private/qfactoryloader_p.h>
+#if QT_CONFIG(library)
+#include <private/qpluginmetadatacache_p.h>
+#endif
 #include "plugin1/plugininterface1.h"
 #include "plugin2/plugininterface2.h"
 
@@ -51,6 +56,7 @@ public slots:
     void initTestCase();
 
 private slots:
+    void metaDataCache();
     void usingTwoFactoriesFromSameDir();
 };
 
@@ -92,5 +98,89 @@ void tst_QFactoryLoader::usingTwoFactoriesFromSameDir()
     QCOMPARE(plugin2->pluginName(), QLatin1String("Plugin2 ok"));
 }
 
+void tst_QFactoryLoader::metaDataCache()
+{
+#if !QT_CONFIG(library)
+    QSKIP("This test requires dynamic plugins");
+#else
+    QTemporaryDir tempDir;
+    QVERIFY2(tempDir.isValid(), qPrintable(tempDir.errorString()));
+    const QString cacheFile = tempDir.filePath(QLatin1String("cache.cbor"));
+
+    QPluginMetaDataCache *cache = QPluginMetaDataCache::instance();
+    const QString previousFileName = cache->fileName();
+    cache->setFileName(cacheFile);
+    const auto restore = qScopeGuard([&] { cache->setFileName(previousFileName); });
+
+    // this test must run before the plugins are loaded, as the metadata of
+    // loaded libraries is queried from the library itself
+    const QString suffix = QLatin1Char('/') + QLatin1String(binFolderC);
+    QList<QJsonObject> parsed;
+    {
+        QFactoryLoader loader(PluginInterface1_iid, suffix);
+        parsed = loader.metaData();
+    }
+    QCOMPARE(parsed.size(), 1);
+    QVERIFY(QFile::exists(cacheFile));
+
+    // start over from the file, as a new process would
+    cache->setFileName(cacheFile);
+    {
+        QFactoryLoader loader(PluginInterface1_iid, suffix);
+        QCOMPARE(loader.metaData(), parsed);
+    }
+
+    QString pluginFile;
+    const QFileInfoList binFiles = QDir(QFINDTESTDATA(binFolderC)).entryInfoList(QDir::Files);
+    for (const QFileInfo &info : binFiles) {
+        if (info.fileName().contains(QLatin1String("plugin1")))
+            pluginFile = info.canonicalFilePath();
+    }
+    QVERIFY(!pluginFile.isEmpty());
+
+    QJsonObject metaData;
+    QString errorString;
+    QPluginMetaDataCache other;
+    other.setFileName(cacheFile);
+    QVERIFY(other.lookup(pluginFile, &metaData, &errorString));
+    QCOMPARE(metaData.value(QLatin1String("IID")).toString(),
+             QLatin1String(PluginInterface1_iid));
+
+    // a changed file is not served from the cache
+    const QString copy = tempDir.filePath(QLatin1String("copy"));
+    QVERIFY(QFile::copy(pluginFile, copy));
+    QVERIFY(!other.lookup(copy, &metaData, &errorString));
+    other.insert(copy, QJsonObject(), QLatin1String("not a plugin"));
+    QVERIFY(other.lookup(copy, &metaData, &errorString));
+    QVERIFY(metaData.isEmpty());
+    QCOMPARE(errorString, QLatin1String("not a plugin"));
+    {
+        QFile f(copy);
+        QVERIFY(f.open(QIODevice::Append));
+        f.write("x");
+    }
+    QVERIFY(!other.lookup(copy, &metaData, &errorString));
+
+    // entries written by another process are merged, not overwritten
+    other.insert(copy, QJsonObject(), QLatin1String("still not a plugin"));
+    QVERIFY(other.sync());
+    QPluginMetaDataCache reader;
+    reader.setFileName(cacheFile);
+    QVERIFY(reader.lookup(pluginFile, &metaData, &errorString));
+    QVERIFY(reader.lookup(copy, &metaData, &errorString));
+    QCOMPARE(errorString, QLatin1String("still not a plugin"));
+
+    // entries of files that are gone are dropped on the next write
+    QVERIFY(QFile::remove(copy));
+    reader.insert(pluginFile, parsed.first(), QString());
+    QVERIFY(reader.sync());
+    QFile written(cacheFile);
+    QVERIFY(written.open(QIODevice::ReadOnly));
+    const QByteArray contents = written.readAll();
+    QVERIFY(contents.contains(pluginFile.toUtf8()));
+    QVERIFY(!contents.contains(copy.toUtf8()));
+#endif
+}
+
 QTEST_MAIN(tst_QFactoryLoader)
 #include "tst_qfactoryloader.moc"
@@ -202,6 +202,10 @@ private slots:
 
     void floatingPointPrecision();
 
+    void rawArray_data();
+    void rawArray();
+    void rawArrayReadPastEnd();
+
     void compatibility_Qt5();
     void compatibility_Qt3();
     void compatibility_Qt2();
@@ -3349,6 +3353,159 @@ void tst_QDataStream::streamRealDataTypes()
     }
 }
 
+template <typename T>
+static void checkRawArray(QDataStream::ByteOrder byteOrder,
+                          QDataStream::FloatingPointPrecision precision, int version)
+{
+    QList<T> values;
+    for (int i = 0; i < 1000; ++i)
+        values.append(T(i * 37 + 11));
+
+    auto setUp = [&](QDataStream &stream) {
+        stream.setByteOrder(byteOrder);
+        stream.setFloatingPointPrecision(precision);
+        stream.setVersion(version);
+    };
+
+    QByteArray elementWise;
+    {
+        QDataStream stream(&elementWise, QIODevice::WriteOnly);
+        setUp(stream);
+        for (T value : qAsConst(values))
+            stream << value;
+    }
+
+    QByteArray bulk;
+    {
+        QDataStream stream(&bulk, QIODevice::WriteOnly);
+        setUp(stream);
+        stream.writeRawArray(values.constData(), values.size());
+        QCOMPARE(stream.status(), QDataStream::Ok);
+    }
+    QCOMPARE(bulk, elementWise);
+
+    // streams older than Qt 3.3 don't round-trip 64-bit integers, so compare
+    // against what reading one element at a time yields
+    QList<T> expected;
+    {
+        QDataStream stream(elementWise);
+        setUp(stream);
+        for (int i = 0; i < values.size(); ++i) {
+            T value;
+            stream >> value;
+            expected.append(value);
+        }
+    }
+    if (version >= QDataStream::Qt_3_3 || sizeof(T) != sizeof(qint64) || !std::is_integral_v<T>)
+        QCOMPARE(expected, values);
+
+    {
+        QDataStream stream(bulk);
+        setUp(stream);
+        QList<T> result(values.size());
+        stream.readRawArray(result.data(), result.size());
+        QCOMPARE(stream.status(), QDataStream::Ok);
+        QVERIFY(stream.atEnd());
+        QCOMPARE(result, expected);
+    }
+
+    // the QList operators use the bulk path and must keep the format
+    QByteArray listBytes;
+    {
+        QDataStream stream(&listBytes, QIODevice::WriteOnly);
+        setUp(stream);
+        stream << values;
+    }
+    QCOMPARE(listBytes.mid(int(sizeof(quint32))), elementWise);
+    {
+        QDataStream stream(listBytes);
+        setUp(stream);
+        QList<T> result;
+        stream >> result;
+        QCOMPARE(stream.status(), QDataStream::Ok);
+        QCOMPARE(result, expected);
+    }
+}
+
+void tst_QDataStream::rawArray_data()
+{
+    QTest::addColumn<QDataStream::ByteOrder>("byteOrder");
+    QTest::addColumn<QDataStream::FloatingPointPrecision>("precision");
+    QTest::addColumn<int>("version");
+
+    QTest::newRow("BE-double") << QDataStream::BigEndian << QDataStream::DoublePrecision
+                               << int(QDataStream::Qt_DefaultCompiledVersion);
+    QTest::newRow("LE-double") << QDataStream::LittleEndian << QDataStream::DoublePrecision
+                               << int(QDataStream::Qt_DefaultCompiledVersion);
+    QTest::newRow("BE-single") << QDataStream::BigEndian << QDataStream::SinglePrecision
+                               << int(QDataStream::Qt_DefaultCompiledVersion);
+    QTest::newRow("LE-single") << QDataStream::LittleEndian << QDataStream::SinglePrecision
+                               << int(QDataStream::Qt_DefaultCompiledVersion);
+    QTest::newRow("LE-Qt_3_1") << QDataStream::LittleEndian << QDataStream::DoublePrecision
+                               << int(QDataStream::Qt_3_1);
+}
+
+void tst_QDataStream::rawArray()
+{
+    QFETCH(QDataStream::ByteOrder, byteOrder);
+    QFETCH(QDataStream::FloatingPointPrecision, precision);
+    QFETCH(int, version);
+
+    checkRawArray<qint8>(byteOrder, precision, version);
+    checkRawArray<quint16>(byteOrder, precision, version);
+    checkRawArray<qint32>(byteOrder, precision, version);
+    checkRawArray<quint64>(byteOrder, precision, version);
+    checkRawArray<char16_t>(byteOrder, precision, version);
+    checkRawArray<float>(byteOrder, precision, version);
+    checkRawArray<double>(byteOrder, precision, version);
+
+    QList<bool> bools = { true, false, false, true };
+    QByteArray ba;
+    {
+        QDataStream stream(&ba, QIODevice::WriteOnly);
+        stream.setByteOrder(byteOrder);
+        stream << bools;
+    }
+    ba[int(sizeof(quint32))] = 2; // any non-zero byte reads back as true
+    {
+        QDataStream stream(ba);
+        stream.setByteOrder(byteOrder);
+        QList<bool> result;
+        stream >> result;
+        QCOMPARE(result, bools);
+    }
+}
+
+void tst_QDataStream::rawArrayReadPastEnd()
+{
+    QByteArray ba;
+    {
+        QDataStream stream(&ba, QIODevice::WriteOnly);
+        stream << QList<double>{ 1.0, 2.0, 3.0 };
+    }
+
+    {
+        QDataStream stream(ba.left(ba.size() - 1));
+        double values[3] = { 4.0, 5.0, 6.0 };
+        stream.skipRawData(int(sizeof(quint32)));
+        stream.readRawArray(values, 3);
+        QCOMPARE(stream.status(), QDataStream::ReadPastEnd);
+        QCOMPARE(values[0], 0.0);
+        QCOMPARE(values[2], 0.0);
+    }
+
+    {
+        // a corrupt size must not produce a list
+        QByteArray corrupt = ba;
+        corrupt[0] = char(0x7f);
+        QDataStream stream(corrupt);
+        QList<double> result;
+        stream >> result;
+        QCOMPARE(stream.status(), QDataStream::ReadPastEnd);
+        QVERIFY(result.isEmpty());
+    }
+}
+
 void tst_QDataStream::compatibility_Qt5()
 {
     QLinearGradient gradient(QPointF(0,0), QPointF(1,1));
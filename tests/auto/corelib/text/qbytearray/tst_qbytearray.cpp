@@ -94,6 +94,12 @@ private slots:
     void toInt();
     void toDouble_data();
     void toDouble();
+    void numberShortestDouble_data();
+    void numberShortestDouble();
+    void shortestDoubleRoundTrip();
+    void appendDoubles();
+    void parseDoubles_data();
+    void parseDoubles();
     void blockSizeCalculations();
 
     void resizeAfterFromRawData();
@@ -1113,6 +1119,20 @@ void tst_QByteArray::toDouble_data()
 
     QTest::newRow("raw, null plus junk") << QByteArray::fromRawData("1.2\0 junk", 9) << 0.0 << false;
     QTest::newRow("raw, null-terminator not included") << QByteArray::fromRawData("2.3", 3) << 2.3 << true;
+
+    QTest::newRow("negative zero") << QByteArray("-0") << -0.0 << true;
+    QTest::newRow("integer") << QByteArray("1234567890") << 1234567890.0 << true;
+    QTest::newRow("max") << QByteArray("1.7976931348623157e308")
+                         << std::numeric_limits<double>::max() << true;
+    QTest::newRow("min normal") << QByteArray("2.2250738585072014e-308")
+                                << std::numeric_limits<double>::min() << true;
+    QTest::newRow("denormal") << QByteArray("4.9406564584124654e-324")
+                              << std::numeric_limits<double>::denorm_min() << true;
+    QTest::newRow("many digits") << QByteArray("0.1000000000000000055511151231257827021181583404541015625")
+                                 << 0.1 << true;
+    QTest::newRow("halfway, rounds to even") << QByteArray("9007199254740993") << 9007199254740992.0
+                                             << true;
+    QTest::newRow("leading zeros") << QByteArray("0000000000000000000000000.5") << 0.5 << true;
 }
 
 void tst_QByteArray::toDouble()
@@ -1128,6 +1148,126 @@ void tst_QByteArray::toDouble()
     QCOMPARE(number, expectedNumber);
 }
 
+void tst_QByteArray::numberShortestDouble_data()
+{
+    QTest::addColumn<double>("value");
+    QTest::addColumn<char>("format");
+    QTest::addColumn<QByteArray>("expected");
+
+    QTest::newRow("zero") << 0.0 << 'g' << QByteArray("0");
+    QTest::newRow("negative zero") << -0.0 << 'g' << QByteArray("0");
+    QTest::newRow("one") << 1.0 << 'g' << QByteArray("1");
+    QTest::newRow("fraction") << -1.5 << 'g' << QByteArray("-1.5");
+    QTest::newRow("0.1") << 0.1 << 'g' << QByteArray("0.1");
+    QTest::newRow("1e-4") << 1e-4 << 'g' << QByteArray("1e-04");
+    QTest::newRow("1e-3") << 1e-3 << 'g' << QByteArray("0.001");
+    QTest::newRow("1e-5") << 1e-5 << 'g' << QByteArray("1e-05");
+    QTest::newRow("1234567") << 1234567.0 << 'g' << QByteArray("1234567");
+    QTest::newRow("1e20") << 1e20 << 'g' << QByteArray("1e+20");
+    QTest::newRow("1e100") << 1e100 << 'g' << QByteArray("1e+100");
+    QTest::newRow("capital") << 1e100 << 'G' << QByteArray("1E+100");
+    QTest::newRow("1.5e-300") << 1.5e-300 << 'g' << QByteArray("1.5e-300");
+    QTest::newRow("denormal") << std::numeric_limits<double>::denorm_min() << 'g'
+                              << QByteArray("5e-324");
+    QTest::newRow("max") << std::numeric_limits<double>::max() << 'g'
+                         << QByteArray("1.7976931348623157e+308");
+    QTest::newRow("inf") << qInf() << 'g' << QByteArray("inf");
+    QTest::newRow("-inf") << -qInf() << 'g' << QByteArray("-inf");
+    QTest::newRow("nan") << qQNaN() << 'g' << QByteArray("nan");
+}
+
+void tst_QByteArray::numberShortestDouble()
+{
+    QFETCH(double, value);
+    QFETCH(char, format);
+    QFETCH(QByteArray, expected);
+
+    QCOMPARE(QByteArray::number(value, format, QLocale::FloatingPointShortest), expected);
+    QCOMPARE(QString::number(value, format, QLocale::FloatingPointShortest),
+             QString::fromLatin1(expected));
+}
+
+void tst_QByteArray::shortestDoubleRoundTrip()
+{
+    // Compare the fast shortest formatting and parsing against each other,
+    // and against the locale code, for bit patterns spread over the range.
+    quint64 state = Q_UINT64_C(0x9E3779B97F4A7C15);
+    for (int i = 0; i < 20000; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        double value;
+        memcpy(&value, &state, sizeof(value));
+        if (!qIsFinite(value))
+            continue;
+        const QByteArray text = QByteArray::number(value, 'g', QLocale::FloatingPointShortest);
+        bool ok = false;
+        QCOMPARE(text.toDouble(&ok), value);
+        QVERIFY(ok);
+        QCOMPARE(QLocale::c().toString(value, 'g', QLocale::FloatingPointShortest),
+                 QString::fromLatin1(text));
+        QCOMPARE(QLocale::c().toDouble(QString::fromLatin1(text)), value);
+    }
+}
+
+void tst_QByteArray::appendDoubles()
+{
+    const double values[] = { 0.0, -1.5, 0.1, 1e-5, 1e20, 123456.0 };
+    QByteArray column("x=");
+    column.appendDoubles(values, std::size(values), ',');
+    QCOMPARE(column, QByteArray("x=0,-1.5,0.1,1e-05,1e+20,123456"));
+
+    column.clear();
+    column.appendDoubles(values, 0);
+    QVERIFY(column.isEmpty());
+    column.appendDoubles(values, 2);
+    QCOMPARE(column, QByteArray("0\n-1.5"));
+}
+
+void tst_QByteArray::parseDoubles_data()
+{
+    QTest::addColumn<QByteArray>("column");
+    QTest::addColumn<QList<double>>("expected");
+    QTest::addColumn<bool>("expectedOk");
+
+    QTest::newRow("empty") << QByteArray() << QList<double>() << true;
+    QTest::newRow("one") << QByteArray("1.25") << QList<double>{ 1.25 } << true;
+    QTest::newRow("several") << QByteArray("1\n-2.5\n3e10\n0.1")
+                             << QList<double>{ 1, -2.5, 3e10, 0.1 } << true;
+    QTest::newRow("trailing separator") << QByteArray("1\n2\n")
+                                        << QList<double>{ 1, 2 } << true;
+    QTest::newRow("crlf") << QByteArray("1\r\n2\r\n") << QList<double>{ 1, 2 } << true;
+    QTest::newRow("spaces") << QByteArray(" 1 \n\t2") << QList<double>{ 1, 2 } << true;
+    QTest::newRow("empty field") << QByteArray("1\n\n2") << QList<double>{ 1 } << false;
+    QTest::newRow("junk") << QByteArray("1\n2x\n3") << QList<double>{ 1 } << false;
+    QTest::newRow("many digits") << QByteArray("0.1000000000000000055511151231257827\n7")
+                                 << QList<double>{ 0.1, 7 } << true;
+    QTest::newRow("too many") << QByteArray("1\n2\n3\n4\n5\n6\n7\n8\n9")
+                              << QList<double>{ 1, 2, 3, 4, 5, 6, 7, 8 } << true;
+}
+
+void tst_QByteArray::parseDoubles()
+{
+    QFETCH(QByteArray, column);
+    QFETCH(QList<double>, expected);
+    QFETCH(bool, expectedOk);
+
+    double values[8];
+    bool ok = !expectedOk;
+    const qsizetype count = QByteArray::parseDoubles(column, values, std::size(values), '\n', &ok);
+    QCOMPARE(ok, expectedOk);
+    QCOMPARE(QList<double>(values, values + count), expected);
+
+    // Round trip through appendDoubles()
+    if (expectedOk) {
+        QByteArray formatted;
+        formatted.appendDoubles(values, count, ';');
+        double reparsed[8];
+        QCOMPARE(QByteArray::parseDoubles(formatted, reparsed, std::size(reparsed), ';'), count);
+        QCOMPARE(QList<double>(reparsed, reparsed + count), expected);
+    }
+}
+
 void tst_QByteArray::toULong_data()
 {
     QTest::addColumn<QByteArray>("str");
@@ -44,6 +44,9 @@ private slots:
     void interface();
     void indexIn();
     void staticByteArrayMatcher();
+    void multiByteArrayMatcher_data();
+    void multiByteArrayMatcher();
+    void multiByteArrayMatcherInterface();
 };
 
 void tst_QByteArrayMatcher::interface()
@@ -213,5 +216,121 @@ void tst_QByteArrayMatcher::staticByteArrayMatcher()
 #undef LONG_STRING__64
 #undef LONG_STRING__32
 
+static QList<QMultiByteArrayMatcher::Match>
+naiveMatches(const QList<QByteArray> &needles, QByteArray haystack, Qt::CaseSensitivity cs)
+{
+    const auto fold = [cs](QByteArray ba) {
+        if (cs == Qt::CaseInsensitive)
+            return QString::fromLatin1(ba).toLower().toLatin1();
+        return ba;
+    };
+    haystack = fold(haystack);
+    QList<QMultiByteArrayMatcher::Match> result;
+    for (qsizetype pos = 0; pos < haystack.size(); ++pos) {
+        for (qsizetype i = 0; i < needles.size(); ++i) {
+            const QByteArray needle = fold(needles.at(i));
+            if (!needle.isEmpty() && haystack.mid(pos).startsWith(needle))
+                result.append({ pos, i });
+        }
+    }
+    return result;
+}
+
+void tst_QByteArrayMatcher::multiByteArrayMatcher_data()
+{
+    QTest::addColumn<QList<QByteArray>>("needles");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+
+    const QList<QByteArray> overlapping = { "he", "she", "his", "hers", "", "e", "hers" };
+    QTest::newRow("overlapping") << overlapping << Qt::CaseSensitive;
+    QTest::newRow("overlapping-ci") << overlapping << Qt::CaseInsensitive;
+
+    // enough distinct first bytes to disable the vectorized start filter
+    const QList<QByteArray> keywords = { "if", "else", "while", "for", "return", "switch",
+                                         "case", "break", "\xc4\xd6", "\xe9t\xe9", "\xb5s" };
+    QTest::newRow("keywords") << keywords << Qt::CaseSensitive;
+    QTest::newRow("keywords-ci") << keywords << Qt::CaseInsensitive;
+
+    QTest::newRow("binary") << QList<QByteArray>{ QByteArray("\0\1", 2), QByteArray("\xff\0", 2) }
+                            << Qt::CaseSensitive;
+    QTest::newRow("none") << QList<QByteArray>() << Qt::CaseSensitive;
+}
+
+void tst_QByteArrayMatcher::multiByteArrayMatcher()
+{
+    QFETCH(QList<QByteArray>, needles);
+    QFETCH(Qt::CaseSensitivity, cs);
+
+    const QMultiByteArrayMatcher matcher(needles, cs);
+    QCOMPARE(matcher.needles(), needles);
+    QCOMPARE(matcher.caseSensitivity(), cs);
+
+    QList<QByteArray> haystacks = {
+        QByteArray(),
+        "ushers",
+        "USHERS and SHE said HIS",
+        "while (x) { if (y) break; else return; }",
+        "\xe4\xf6 \xc4\xd6 \xc9T\xc9 \xb5S \xb5s",
+        QByteArray("\xff\0\1\0\1", 5),
+    };
+    // long inputs cross the vectorized chunks of the start filter
+    QByteArray noise;
+    for (int i = 0; i < 1000; ++i)
+        noise += char('a' + (i * 7919) % 26) + QByteArray(i % 17, 'x');
+    haystacks << noise << noise.toUpper() << QByteArray(100, 'z') + "she" + QByteArray(100, 'z');
+
+    for (const QByteArray &haystack : qAsConst(haystacks)) {
+        const QList<QMultiByteArrayMatcher::Match> expected = naiveMatches(needles, haystack, cs);
+        QCOMPARE(matcher.matches(haystack), expected);
+
+        for (qsizetype from = 0; from <= haystack.size(); from += qMax(haystack.size() / 50, 1)) {
+            qsizetype needleIndex = -1;
+            const qsizetype pos = matcher.indexIn(haystack, from, &needleIndex);
+            const auto it = std::find_if(expected.cbegin(), expected.cend(),
+                                         [from](const QMultiByteArrayMatcher::Match &m) {
+                return m.position >= from;
+            });
+            if (it == expected.cend()) {
+                QCOMPARE(pos, qsizetype(-1));
+            } else {
+                QCOMPARE(pos, it->position);
+                QCOMPARE(needleIndex, it->needleIndex);
+            }
+        }
+    }
+}
+
+void tst_QByteArrayMatcher::multiByteArrayMatcherInterface()
+{
+    QMultiByteArrayMatcher matcher;
+    QVERIFY(matcher.needles().isEmpty());
+    QCOMPARE(matcher.indexIn("abc"), -1);
+    QVERIFY(matcher.matches("abc").isEmpty());
+
+    matcher.setNeedles({ "abc", "bcd" });
+    QCOMPARE(matcher.indexIn("xabcd"), 1);
+    QCOMPARE(matcher.indexIn("xabcd", 2), 2);
+    QCOMPARE(matcher.indexIn("xabcd", -3), 2);
+    QCOMPARE(matcher.indexIn("xABCD"), -1);
+
+    QMultiByteArrayMatcher copy = matcher;
+    matcher.setCaseSensitivity(Qt::CaseInsensitive);
+    QCOMPARE(matcher.indexIn("xABCD"), 1);
+    QCOMPARE(copy.indexIn("xABCD"), -1);
+    QCOMPARE(copy.caseSensitivity(), Qt::CaseSensitive);
+
+    copy.swap(matcher);
+    QCOMPARE(copy.caseSensitivity(), Qt::CaseInsensitive);
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseSensitive);
+
+    // a longer needle starting further left must win over a shorter one
+    // that ends first
+    matcher.setNeedles({ "b", "abcdef" });
+    qsizetype needleIndex = -1;
+    QCOMPARE(matcher.indexIn("xxabcdef", 0, &needleIndex), 2);
+    QCOMPARE(needleIndex, 1);
+}
+
+
 QTEST_APPLESS_MAIN(tst_QByteArrayMatcher)
 #include "tst_qbytearraymatcher.moc"
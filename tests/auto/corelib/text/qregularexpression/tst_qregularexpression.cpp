@@ -37,6 +37,8 @@
 #include <qregularexpression.h>
 #include <qthread.h>
 
+#include <private/qregularexpression_p.h>
+
 Q_DECLARE_METATYPE(QRegularExpression::PatternOptions)
 Q_DECLARE_METATYPE(QRegularExpression::MatchType)
 Q_DECLARE_METATYPE(QRegularExpression::MatchOptions)
@@ -79,6 +81,11 @@ private slots:
     void QStringAndQStringViewEquivalence();
     void threadSafety_data();
     void threadSafety();
+    void sharedCompiledPatterns();
+    void sharedCompiledPatternsThreaded();
+    void regularExpressionSet_data();
+    void regularExpressionSet();
+    void regularExpressionSetModification();
 
     void wildcard_data();
     void wildcard();
@@ -2181,6 +2188,262 @@ void tst_QRegularExpression::threadSafety()
     }
 }
 
+void tst_QRegularExpression::sharedCompiledPatterns()
+{
+    qt_clearRegularExpressionCache();
+    const QString pattern = QStringLiteral("(?<word>\\w+)-cache-test");
+
+    {
+        QRegularExpression re(pattern);
+        QVERIFY(re.isValid());
+        QCOMPARE(qt_regularExpressionCacheStatistics().misses, 1);
+        QCOMPARE(qt_regularExpressionCacheStatistics().hits, 0);
+        QCOMPARE(re.match("foo-cache-test").captured("word"), QStringLiteral("foo"));
+    }
+
+    // the compiled pattern outlives the first object
+    {
+        QRegularExpression re(pattern);
+        QVERIFY(re.isValid());
+        QCOMPARE(qt_regularExpressionCacheStatistics().hits, 1);
+        QCOMPARE(re.captureCount(), 1);
+        QCOMPARE(re.namedCaptureGroups(), QStringList({ QString(), QStringLiteral("word") }));
+        QCOMPARE(re.match("bar-cache-test").captured("word"), QStringLiteral("bar"));
+    }
+
+    // different options are a different entry
+    {
+        QRegularExpression re(pattern, QRegularExpression::CaseInsensitiveOption);
+        QVERIFY(re.isValid());
+        QCOMPARE(qt_regularExpressionCacheStatistics().misses, 2);
+        QVERIFY(re.match("FOO-CACHE-TEST").hasMatch());
+    }
+
+    // invalid patterns are never cached, but still report their error
+    for (int i = 0; i < 2; ++i) {
+        QRegularExpression re(QStringLiteral("(cache-test"));
+        QVERIFY(!re.isValid());
+        QCOMPARE(re.patternErrorOffset(), 11);
+    }
+    QCOMPARE(qt_regularExpressionCacheStatistics().size, 2);
+
+    // the cache is bounded
+    qt_setRegularExpressionCacheSize(1);
+    QCOMPARE(qt_regularExpressionCacheStatistics().maxSize, 1);
+    QCOMPARE(qt_regularExpressionCacheStatistics().size, 1);
+    qt_setRegularExpressionCacheSize(0);
+    QCOMPARE(qt_regularExpressionCacheStatistics().size, 0);
+    {
+        QRegularExpression re(pattern);
+        QVERIFY(re.match("baz-cache-test").hasMatch());
+        QCOMPARE(qt_regularExpressionCacheStatistics().size, 0);
+    }
+
+    qt_setRegularExpressionCacheSize(256);
+    qt_clearRegularExpressionCache();
+}
+
+class ConstructingMatcherThread : public QThread
+{
+public:
+    explicit ConstructingMatcherThread(const QString &pattern, QObject *parent = nullptr)
+        : QThread(parent),
+          m_pattern(pattern)
+    {
+    }
+
+    int matches = 0;
+
+private:
+    void run() override
+    {
+        yieldCurrentThread();
+        for (int i = 0; i < 100; ++i) {
+            const QRegularExpression re(m_pattern);
+            if (re.match(QStringLiteral("abbbcd")).hasMatch())
+                ++matches;
+        }
+    }
+
+    const QString m_pattern;
+};
+
+void tst_QRegularExpression::sharedCompiledPatternsThreaded()
+{
+    qt_clearRegularExpressionCache();
+    const int threadCount = qMax(QThread::idealThreadCount(), 4);
+
+    QList<ConstructingMatcherThread *> threads;
+    for (int i = 0; i < threadCount; ++i) {
+        ConstructingMatcherThread *thread = new ConstructingMatcherThread(QStringLiteral("ab+c(d)"));
+        thread->start();
+        threads.push_back(thread);
+    }
+
+    for (ConstructingMatcherThread *thread : qAsConst(threads)) {
+        thread->wait();
+        QCOMPARE(thread->matches, 100);
+    }
+    qDeleteAll(threads);
+
+    const QRegularExpressionCacheStatistics stats = qt_regularExpressionCacheStatistics();
+    QCOMPARE(stats.size, 1);
+    QCOMPARE(stats.hits + stats.misses, threadCount * 100);
+    QVERIFY(stats.hits >= threadCount * 100 - threadCount);
+    qt_clearRegularExpressionCache();
+}
+
+void tst_QRegularExpression::regularExpressionSet_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<QRegularExpression::PatternOptions>("options");
+    QTest::addColumn<QStringList>("subjects");
+
+    const QStringList subjects = {
+        QString(),
+        QStringLiteral("hello world"),
+        QStringLiteral("HELLO WORLD"),
+        QStringLiteral("error: disk /var full"),
+        QStringLiteral("connection reset by peer"),
+        QStringLiteral("timeout after 1500 ms"),
+        QStringLiteral("abbbc abc ac aXc"),
+        QStringLiteral("color colour colr"),
+        QStringLiteral("a.b*c+d?e(f)g[h]i{j}k\\l|m"),
+        QStringLiteral("tab\there\nnewline"),
+        QStringLiteral("Straße STRASSE İstanbul"),
+        QStringLiteral("emoji \U0001F600 smile"),
+        QStringLiteral("aaaa bbbb 1234 ----"),
+        QStringLiteral("]abc (abc"),
+    };
+
+    const QStringList patterns = {
+        QStringLiteral("hello"),
+        QStringLiteral("world$"),
+        QStringLiteral("^hello"),
+        QStringLiteral("disk \\w+ full"),
+        QStringLiteral("connection (refused|reset)"),
+        QStringLiteral("timeout after \\d+ ms"),
+        QStringLiteral("ab*c"),
+        QStringLiteral("ab+c"),
+        QStringLiteral("ab?c"),
+        QStringLiteral("ab{0}c"),
+        QStringLiteral("ab{2,}c"),
+        QStringLiteral("ab{,3}c"),
+        QStringLiteral("colou?r"),
+        QStringLiteral("colo(u)?r"),
+        QStringLiteral("a\\.b\\*c\\+d"),
+        QStringLiteral("\\(f\\)g\\[h\\]"),
+        QStringLiteral("k\\\\l\\|m"),
+        QStringLiteral("tab\\there\\nnew"),
+        QStringLiteral("hello|disk"),
+        QStringLiteral("[a-z]+ [0-9]+"),
+        QStringLiteral("[]a]bbb"),
+        QStringLiteral("[^]x]+ 1234"),
+        QStringLiteral("[[:digit:]]{4} -"),
+        QStringLiteral("(?i)hello"),
+        QStringLiteral("(?:a|b)bbb"),
+        QStringLiteral("\\Qa.b\\E"),
+        QStringLiteral("[\\Q]\\E]abc"),
+        QStringLiteral("[\\Q]x\\E]abc"),
+        QStringLiteral("(\\Q(\\E)abc"),
+        QStringLiteral("a(*ACCEPT)bc"),
+        QStringLiteral("(*UCP)\\w+ bbbb"),
+        QStringLiteral("\\x41ab"),
+        QStringLiteral("\\x{61}bc"),
+        QStringLiteral("\\p{Lu}ELLO"),
+        QStringLiteral("straße"),
+        QStringLiteral("\U0001F600 smile"),
+        QStringLiteral("\U0001F600? smile"),
+        QStringLiteral("(a)\\1aa"),
+        QStringLiteral("a(?=b)bbb"),
+        QStringLiteral("."),
+        QStringLiteral("^$"),
+        QStringLiteral("nomatch"),
+        QStringLiteral("invalid(pattern"),
+        QStringLiteral("also)invalid"),
+    };
+
+    QTest::newRow("default") << patterns << QRegularExpression::PatternOptions{} << subjects;
+    QTest::newRow("case-insensitive")
+            << patterns << QRegularExpression::PatternOptions(QRegularExpression::CaseInsensitiveOption)
+            << subjects;
+    QTest::newRow("extended")
+            << patterns << QRegularExpression::PatternOptions(QRegularExpression::ExtendedPatternSyntaxOption)
+            << subjects;
+    QTest::newRow("multiline")
+            << patterns << QRegularExpression::PatternOptions(QRegularExpression::MultilineOption)
+            << subjects;
+    QTest::newRow("empty") << QStringList() << QRegularExpression::PatternOptions{} << subjects;
+
+    // many patterns sharing prefixes exercise the automaton's failure links
+    QStringList numbered;
+    for (int i = 0; i < 500; ++i)
+        numbered << QStringLiteral("item%1\\b").arg(i);
+    QTest::newRow("numbered")
+            << numbered << QRegularExpression::PatternOptions{}
+            << QStringList{ QStringLiteral("item7 item42 item4999 item123"),
+                            QStringLiteral("item"), QStringLiteral("items499") };
+}
+
+void tst_QRegularExpression::regularExpressionSet()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(QRegularExpression::PatternOptions, options);
+    QFETCH(QStringList, subjects);
+
+    const QRegularExpressionSet set(patterns, options);
+    QCOMPARE(set.patterns(), patterns);
+    QCOMPARE(set.patternOptions(), options);
+
+    bool allValid = true;
+    for (qsizetype i = 0; i < patterns.size(); ++i) {
+        const QRegularExpression re(patterns.at(i), options);
+        QCOMPARE(set.regularExpression(i), re);
+        allValid = allValid && re.isValid();
+    }
+    QCOMPARE(set.isValid(), allValid);
+
+    for (const QString &subject : qAsConst(subjects)) {
+        QList<qsizetype> expected;
+        for (qsizetype i = 0; i < patterns.size(); ++i) {
+            if (QRegularExpression(patterns.at(i), options).match(subject).hasMatch())
+                expected.append(i);
+        }
+        QCOMPARE(set.matchingPatterns(subject), expected);
+        QCOMPARE(set.hasMatch(subject), !expected.isEmpty());
+    }
+}
+
+void tst_QRegularExpression::regularExpressionSetModification()
+{
+    QRegularExpressionSet set;
+    QVERIFY(set.patterns().isEmpty());
+    QVERIFY(set.isValid());
+    QVERIFY(!set.hasMatch(u"anything"));
+
+    set.setPatterns({ QStringLiteral("foo"), QStringLiteral("BAR") });
+    QCOMPARE(set.matchingPatterns(u"foo bar"), QList<qsizetype>{ 0 });
+
+    QRegularExpressionSet copy = set;
+    set.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+    QCOMPARE(set.matchingPatterns(u"foo bar"), QList<qsizetype>({ 0, 1 }));
+    QCOMPARE(copy.matchingPatterns(u"foo bar"), QList<qsizetype>{ 0 });
+    QCOMPARE(copy.patternOptions(), QRegularExpression::NoPatternOption);
+
+    copy.swap(set);
+    QCOMPARE(copy.patternOptions(), QRegularExpression::CaseInsensitiveOption);
+    QCOMPARE(set.patternOptions(), QRegularExpression::NoPatternOption);
+
+    set.setPatterns({ QStringLiteral("(") });
+    QVERIFY(!set.isValid());
+    QVERIFY(!set.hasMatch(u"("));
+
+    // match options are forwarded to every pattern
+    set.setPatterns({ QStringLiteral("bar"), QStringLiteral("^foo") });
+    QCOMPARE(set.matchingPatterns(u"foo bar", QRegularExpression::AnchorAtOffsetMatchOption),
+             QList<qsizetype>{ 1 });
+}
+
 void tst_QRegularExpression::wildcard_data()
 {
     QTest::addColumn<QString>("pattern");
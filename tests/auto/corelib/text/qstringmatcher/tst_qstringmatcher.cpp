@@ -41,6 +41,9 @@ private slots:
     void setCaseSensitivity_data();
     void setCaseSensitivity();
     void assignOperator();
+    void multiStringMatcher_data();
+    void multiStringMatcher();
+    void multiStringMatcherInterface();
 };
 
 void tst_QStringMatcher::qstringmatcher()
@@ -148,6 +151,98 @@ void tst_QStringMatcher::assignOperator()
     QCOMPARE(m2.indexIn(hayStack), 3);
 }
 
+void tst_QStringMatcher::multiStringMatcher_data()
+{
+    QTest::addColumn<QStringList>("needles");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+
+    const QStringList needles = {
+        QStringLiteral("he"), QStringLiteral("she"), QStringLiteral("his"), QStringLiteral("hers"),
+        QString(), QStringLiteral("straße"), QStringLiteral("Ärger"),
+        QStringLiteral("k"), QStringLiteral("\U00010400x"), QStringLiteral("Σσ"),
+    };
+    QTest::newRow("sensitive") << needles << Qt::CaseSensitive;
+    QTest::newRow("insensitive") << needles << Qt::CaseInsensitive;
+
+    QStringList many;
+    for (int i = 0; i < 300; ++i)
+        many << QString::number(i * 37, 36);
+    QTest::newRow("many") << many << Qt::CaseSensitive;
+    QTest::newRow("many-ci") << many << Qt::CaseInsensitive;
+}
+
+void tst_QStringMatcher::multiStringMatcher()
+{
+    QFETCH(QStringList, needles);
+    QFETCH(Qt::CaseSensitivity, cs);
+
+    const QMultiStringMatcher matcher(needles, cs);
+    QCOMPARE(matcher.needles(), needles);
+    QCOMPARE(matcher.caseSensitivity(), cs);
+
+    QString noise;
+    for (int i = 0; i < 500; ++i)
+        noise += QChar(u'a' + (i * 7919) % 26) + QString(i % 13, u'-');
+    const QStringList haystacks = {
+        QString(),
+        QStringLiteral("ushers"),
+        QStringLiteral("USHERS and SHE said HIS"),
+        QStringLiteral("STRASSE Straße STRAßE ärger ÄRGER"),
+        QStringLiteral("K kelvin K"),
+        QStringLiteral("\U00010428x \U00010400X \U00010400x"),
+        QStringLiteral("σς ΣΣ σσ"),
+        noise, noise.toUpper(),
+    };
+
+    for (const QString &haystack : haystacks) {
+        QList<QMultiStringMatcher::Match> expected;
+        for (qsizetype i = 0; i < needles.size(); ++i) {
+            if (needles.at(i).isEmpty())
+                continue;
+            const QStringMatcher single(needles.at(i), cs);
+            for (qsizetype pos = single.indexIn(haystack); pos >= 0;
+                 pos = single.indexIn(haystack, pos + 1)) {
+                expected.append({ pos, i });
+            }
+        }
+        std::sort(expected.begin(), expected.end(),
+                  [](QMultiStringMatcher::Match lhs, QMultiStringMatcher::Match rhs) {
+            return std::make_pair(lhs.position, lhs.needleIndex)
+                    < std::make_pair(rhs.position, rhs.needleIndex);
+        });
+        QCOMPARE(matcher.matches(haystack), expected);
+
+        qsizetype needleIndex = -1;
+        const qsizetype pos = matcher.indexIn(haystack, 0, &needleIndex);
+        if (expected.isEmpty()) {
+            QCOMPARE(pos, qsizetype(-1));
+        } else {
+            QCOMPARE(pos, expected.constFirst().position);
+            QCOMPARE(needleIndex, expected.constFirst().needleIndex);
+        }
+    }
+}
+
+void tst_QStringMatcher::multiStringMatcherInterface()
+{
+    QMultiStringMatcher matcher;
+    QVERIFY(matcher.needles().isEmpty());
+    QCOMPARE(matcher.indexIn(u"abc"), -1);
+
+    matcher.setNeedles({ QStringLiteral("abc"), QStringLiteral("bcd") });
+    QCOMPARE(matcher.indexIn(u"xabcd"), 1);
+    QCOMPARE(matcher.indexIn(u"xabcd", 2), 2);
+    QCOMPARE(matcher.indexIn(u"xABCD"), -1);
+
+    QMultiStringMatcher copy = matcher;
+    matcher.setCaseSensitivity(Qt::CaseInsensitive);
+    QCOMPARE(matcher.indexIn(u"xABCD"), 1);
+    QCOMPARE(copy.indexIn(u"xABCD"), -1);
+
+    copy = std::move(matcher);
+    QCOMPARE(copy.caseSensitivity(), Qt::CaseInsensitive);
+}
+
 QTEST_MAIN(tst_QStringMatcher)
 #include "tst_qstringmatcher.moc"
 
@@ -114,6 +114,9 @@ private Q_SLOTS:
 #if QT_CONFIG(datestring)
     void fromStringDateFormat_data();
     void fromStringDateFormat();
+    void msecsSinceEpochFromIsoString_data() { fromStringDateFormat_data(); }
+    void msecsSinceEpochFromIsoString();
+    void msecsSinceEpochFromIsoStrings();
 #  if QT_CONFIG(datetimeparser)
     void fromStringStringFormat_data();
     void fromStringStringFormat();
@@ -2467,6 +2470,53 @@ void tst_QDateTime::fromStringDateFormat()
     QCOMPARE(dateTime, expected);
 }
 
+void tst_QDateTime::msecsSinceEpochFromIsoString()
+{
+    QFETCH(QString, dateTimeStr);
+    QFETCH(Qt::DateFormat, dateFormat);
+    QFETCH(QDateTime, expected);
+
+    if (dateFormat != Qt::ISODate && dateFormat != Qt::ISODateWithMs)
+        QSKIP("Only ISO 8601 date-times can be parsed to milliseconds directly");
+
+    const QByteArray latin1 = dateTimeStr.toLatin1();
+    bool ok = !expected.isValid();
+    const qint64 msecs = QDateTime::msecsSinceEpochFromIsoString(latin1, &ok);
+    QCOMPARE(ok, expected.isValid());
+    QCOMPARE(msecs, expected.isValid() ? expected.toMSecsSinceEpoch() : 0);
+    QCOMPARE(QDateTime::msecsSinceEpochFromIsoString(QLatin1String(latin1)), msecs);
+}
+
+void tst_QDateTime::msecsSinceEpochFromIsoStrings()
+{
+    const QByteArray column = "1970-01-01T00:00:00Z\r\n"
+                              "2020-07-14T09:53:28.123Z\r\n"
+                              "2020-07-14 11:53:28.123+02:00\r\n"
+                              "2020-07-14T09:53:28.1234567Z\r\n"
+                              "1969-12-31T23:59:59.999-0000\r\n"
+                              "2000-02-29T12:00+05\r\n";
+    const qint64 expected[] = {
+        0, Q_INT64_C(1594720408123), Q_INT64_C(1594720408123), Q_INT64_C(1594720408123), -1,
+        QDateTime(QDate(2000, 2, 29), QTime(7, 0), Qt::UTC).toMSecsSinceEpoch()
+    };
+
+    qint64 msecs[8];
+    bool ok = false;
+    QCOMPARE(QDateTime::msecsSinceEpochFromIsoStrings(column, msecs, 8, '\n', &ok), 6);
+    QVERIFY(ok);
+    for (int i = 0; i < 6; ++i)
+        QCOMPARE(msecs[i], expected[i]);
+
+    QCOMPARE(QDateTime::msecsSinceEpochFromIsoStrings(column, msecs, 2), 2);
+    QCOMPARE(msecs[1], expected[1]);
+
+    QCOMPARE(QDateTime::msecsSinceEpochFromIsoStrings("2020-07-14T09:53:28Z;2020-02-30T00:00Z;"
+                                                      "2020-07-14T09:53:28Z",
+                                                      msecs, 8, ';', &ok), 1);
+    QVERIFY(!ok);
+    QCOMPARE(msecs[0], Q_INT64_C(1594720408000));
+}
+
 # if QT_CONFIG(datetimeparser)
 void tst_QDateTime::fromStringStringFormat_data()
 {
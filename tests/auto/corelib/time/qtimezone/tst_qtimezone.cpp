@@ -1253,6 +1253,29 @@ void tst_QTimeZone::tzTest()
         QDateTime dt(QDate(2016, 3, 28), QTime(0, 0, 0), Qt::UTC);
         QCOMPARE(tzBarnaul.data(dt.toMSecsSinceEpoch()).abbreviation, QString("+07"));
     }
+
+    // The offset getters and data() agree, also far beyond the last transition,
+    // where the POSIX rule's memoized expansions are used:
+    for (const QTzTimeZonePrivate *zone : { &tzp, &tzposix }) {
+        for (int year = 1960; year <= 2300; year += 7) {
+            for (int month : { 1, 2, 5, 7, 8, 11, 12 }) {
+                const qint64 when
+                    = QDate(year, month, 28).startOfDay(Qt::UTC).toMSecsSinceEpoch();
+                const QTimeZonePrivate::Data data = zone->data(when);
+                QCOMPARE(zone->offsetFromUtc(when), data.offsetFromUtc);
+                QCOMPARE(zone->standardTimeOffset(when), data.standardTimeOffset);
+                QCOMPARE(zone->daylightTimeOffset(when), data.daylightTimeOffset);
+                QCOMPARE(data.standardTimeOffset, 3600);
+                if (year >= 1981) {
+                    QCOMPARE(data.daylightTimeOffset, (month >= 5 && month <= 8) ? 3600 : 0);
+                    QCOMPARE(data.abbreviation,
+                             (month >= 5 && month <= 8)
+                             ? QString(zone == &tzp ? "CEST" : "METDST")
+                             : QString(zone == &tzp ? "CET" : "MET"));
+                }
+            }
+        }
+    }
 #endif // QT_BUILD_INTERNAL && Q_OS_UNIX && !Q_OS_DARWIN
 }
 
@@ -126,9 +126,9 @@ void tst_toolsupport::offsets_data()
 #ifdef Q_PROCESSOR_X86
         // x86 32-bit has weird alignment rules. Refer to QtPrivate::AlignOf in
         // qglobal.h for more details.
-        data << 188 << 304;
+        data << 196 << 312;
 #else
-        data << 192 << 304;
+        data << 200 << 312;
 #endif
     }
 #endif
@@ -4,6 +4,7 @@ SUBDIRS = \
         json \
         mimetypes \
         kernel \
+        serialization \
         text \
         thread \
         time \
@@ -8,4 +8,5 @@ SUBDIRS = \
         qtemporaryfile \
         qtextstream
 
+qtConfig(filesystemwatcher): SUBDIRS += qfilesystemwatcher
 qtConfig(process): SUBDIRS += qprocess
@@ -28,6 +28,7 @@
 #include <QDebug>
 #include <QDirIterator>
 #include <QString>
+#include <QTemporaryDir>
 #include <qplatformdefs.h>
 
 #ifdef Q_OS_WIN
@@ -53,7 +54,14 @@ class tst_qdiriterator : public QObject
     Q_OBJECT
 
     void data();
+    void generatedData();
+
+    static void generateTree(const QString &path, int depth, int directoriesPerLevel,
+                             int filesPerDirectory);
+
+    QTemporaryDir generatedTrees;
 private slots:
+    void initTestCase();
     void posix();
     void posix_data() { data(); }
     void diriterator();
@@ -62,8 +70,44 @@ private slots:
     void fsiterator_data() { data(); }
     void stdRecursiveDirectoryIterator();
     void stdRecursiveDirectoryIterator_data() { data(); }
+    void diriteratorGenerated();
+    void diriteratorGenerated_data() { generatedData(); }
+    void traverse();
+    void traverse_data();
 };
 
+void tst_qdiriterator::initTestCase()
+{
+    QVERIFY(generatedTrees.isValid());
+    // A narrow tree that is ten levels deep and a flat one with many
+    // directories right below the root, both with about 20000 files.
+    generateTree(generatedTrees.filePath(QStringLiteral("deep")), 10, 2, 10);
+    generateTree(generatedTrees.filePath(QStringLiteral("wide")), 1, 200, 100);
+}
+
+void tst_qdiriterator::generateTree(const QString &path, int depth, int directoriesPerLevel,
+                                    int filesPerDirectory)
+{
+    QDir().mkpath(path);
+    for (int i = 0; i < filesPerDirectory; ++i) {
+        QFile file(path + QLatin1String("/file") + QString::number(i));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+    }
+    if (depth == 0)
+        return;
+    for (int i = 0; i < directoriesPerLevel; ++i) {
+        generateTree(path + QLatin1String("/dir") + QString::number(i), depth - 1,
+                     directoriesPerLevel, filesPerDirectory);
+    }
+}
+
+void tst_qdiriterator::generatedData()
+{
+    QTest::addColumn<QByteArray>("dirpath");
+    QTest::newRow("deep") << QFile::encodeName(generatedTrees.filePath(QStringLiteral("deep")));
+    QTest::newRow("wide") << QFile::encodeName(generatedTrees.filePath(QStringLiteral("wide")));
+}
+
 
 void tst_qdiriterator::data()
 {
@@ -205,6 +249,56 @@ void tst_qdiriterator::diriterator()
     qDebug() << count;
 }
 
+void tst_qdiriterator::diriteratorGenerated()
+{
+    QFETCH(QByteArray, dirpath);
+
+    int count = 0;
+
+    QBENCHMARK {
+        int c = 0;
+        QDirIterator dir(dirpath, QDir::Files, QDirIterator::Subdirectories);
+        while (dir.hasNext()) {
+            dir.next();
+            c += dir.fileInfo().size() >= 0;
+        }
+        count = c;
+    }
+    qDebug() << count;
+}
+
+void tst_qdiriterator::traverse_data()
+{
+    QTest::addColumn<QByteArray>("dirpath");
+    QTest::addColumn<int>("threads");
+
+    const QByteArray deep = QFile::encodeName(generatedTrees.filePath(QStringLiteral("deep")));
+    const QByteArray wide = QFile::encodeName(generatedTrees.filePath(QStringLiteral("wide")));
+    QTest::newRow("deep, 1 thread") << deep << 1;
+    QTest::newRow("deep, ideal") << deep << 0;
+    QTest::newRow("wide, 1 thread") << wide << 1;
+    QTest::newRow("wide, ideal") << wide << 0;
+}
+
+void tst_qdiriterator::traverse()
+{
+    QFETCH(QByteArray, dirpath);
+    QFETCH(int, threads);
+
+    int count = 0;
+
+    QBENCHMARK {
+        int c = 0;
+        QDirIterator::traverse(dirpath, QStringList(), QDir::Files, QDirIterator::Subdirectories,
+                               [&c](const QFileInfoList &batch) {
+            for (const QFileInfo &info : batch)
+                c += info.size() >= 0;
+        }, threads);
+        count = c;
+    }
+    qDebug() << count;
+}
+
 void tst_qdiriterator::fsiterator()
 {
     QFETCH(QByteArray, dirpath);
@@ -0,0 +1,170 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/QDir>
+#include <QtCore/QFileSystemWatcher>
+#include <QtCore/QTemporaryDir>
+
+class tst_qfilesystemwatcher : public QObject
+{
+    Q_OBJECT
+private slots:
+    void setup_data();
+    void setup();
+    void eventThroughput_data();
+    void eventThroughput();
+
+private:
+    static QStringList createTree(const QString &root, int directoryCount);
+};
+
+// Creates \a directoryCount directories below \a root, ten per level, and
+// returns them.
+QStringList tst_qfilesystemwatcher::createTree(const QString &root, int directoryCount)
+{
+    QStringList directories;
+    QStringList parents(root);
+    while (directories.size() < directoryCount) {
+        QStringList children;
+        for (const QString &parent : qAsConst(parents)) {
+            for (int i = 0; i < 10 && directories.size() < directoryCount; ++i) {
+                const QString path = parent + QLatin1String("/d") + QString::number(i);
+                if (!QDir().mkdir(path))
+                    return QStringList();
+                directories.append(path);
+                children.append(path);
+            }
+        }
+        parents = children;
+    }
+    return directories;
+}
+
+void tst_qfilesystemwatcher::setup_data()
+{
+    QTest::addColumn<int>("directoryCount");
+    QTest::addColumn<QString>("mode");
+
+    for (int count : { 100, 1000, 10000 }) {
+        const QByteArray suffix = QByteArray::number(count) + " dirs";
+        QTest::newRow("addPaths:" + suffix) << count << QString("addPaths");
+        QTest::newRow("recursive:" + suffix) << count << QString("recursive");
+        QTest::newRow("recursive-inotify:" + suffix) << count << QString("recursive-inotify");
+    }
+}
+
+void tst_qfilesystemwatcher::setup()
+{
+    QFETCH(int, directoryCount);
+    QFETCH(QString, mode);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QStringList directories = createTree(dir.path(), directoryCount);
+    QCOMPARE(directories.size(), directoryCount);
+
+    if (mode == QLatin1String("recursive-inotify"))
+        qputenv("QT_NO_FANOTIFY", "1");
+    const auto restoreEnvironment = qScopeGuard([] { qunsetenv("QT_NO_FANOTIFY"); });
+
+    QBENCHMARK {
+        QFileSystemWatcher watcher;
+        if (mode == QLatin1String("addPaths")) {
+            QStringList paths = directories;
+            paths.prepend(dir.path());
+            watcher.addPaths(paths);
+        } else {
+            QVERIFY(watcher.addRecursivePath(dir.path()));
+        }
+    }
+}
+
+void tst_qfilesystemwatcher::eventThroughput_data()
+{
+    QTest::addColumn<int>("fileCount");
+    QTest::addColumn<QString>("mode");
+
+    for (int count : { 1000, 10000 }) {
+        const QByteArray suffix = QByteArray::number(count) + " files";
+        QTest::newRow("addPaths:" + suffix) << count << QString("addPaths");
+        QTest::newRow("recursive:" + suffix) << count << QString("recursive");
+        QTest::newRow("recursive-inotify:" + suffix) << count << QString("recursive-inotify");
+    }
+}
+
+// Measures how long it takes until changes to fileCount files spread over
+// 100 directories have all been delivered.
+void tst_qfilesystemwatcher::eventThroughput()
+{
+    QFETCH(int, fileCount);
+    QFETCH(QString, mode);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QStringList directories = createTree(dir.path(), 100);
+    QCOMPARE(directories.size(), 100);
+    directories.prepend(dir.path());
+
+    if (mode == QLatin1String("recursive-inotify"))
+        qputenv("QT_NO_FANOTIFY", "1");
+    const auto restoreEnvironment = qScopeGuard([] { qunsetenv("QT_NO_FANOTIFY"); });
+
+    QFileSystemWatcher watcher;
+    watcher.setBatchInterval(0);
+    QSet<QString> changed;
+    if (mode == QLatin1String("addPaths")) {
+        QVERIFY(watcher.addPaths(directories).isEmpty());
+        connect(&watcher, &QFileSystemWatcher::directoryChanged, this,
+                [&](const QString &path) { changed.insert(path); });
+    } else {
+        QVERIFY(watcher.addRecursivePath(dir.path()));
+        connect(&watcher, &QFileSystemWatcher::pathsChanged, this,
+                [&](const QStringList &paths) {
+                    for (const QString &path : paths)
+                        changed.insert(path.left(path.lastIndexOf(QLatin1Char('/'))));
+                });
+    }
+
+    int round = 0;
+    QBENCHMARK {
+        changed.clear();
+        for (int i = 0; i < fileCount; ++i) {
+            QFile file(directories.at(i % directories.size()) + QLatin1String("/f")
+                       + QString::number(i) + QLatin1Char('_') + QString::number(round));
+            QVERIFY(file.open(QIODevice::WriteOnly));
+        }
+        ++round;
+        // every directory has changed once all events are in
+        QTRY_VERIFY_WITH_TIMEOUT(changed.size() >= directories.size(), 30000);
+    }
+}
+
+QTEST_MAIN(tst_qfilesystemwatcher)
+
+#include "main.moc"
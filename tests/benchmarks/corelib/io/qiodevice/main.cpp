@@ -41,6 +41,8 @@ private slots:
     void read_old_data() { read_data(); }
     void peekAndRead();
     void peekAndRead_data() { read_data(); }
+    void readSmallBlocks();
+    void readSmallBlocks_data();
     //void read_new();
     //void read_new_data() { read_data(); }
 private:
@@ -119,6 +121,53 @@ void tst_qiodevice::peekAndRead()
     }
 }
 
+void tst_qiodevice::readSmallBlocks_data()
+{
+    QTest::addColumn<int>("blockSize");
+    QTest::addColumn<qint64>("chunkSize");
+
+    const int blockSizes[] = { 1, 100, 1000, 10000 };
+    for (int blockSize : blockSizes) {
+        // A chunk size of 0 keeps the default, growing buffer
+        const QByteArray name = QByteArray::number(blockSize);
+        QTest::newRow((name + " adaptive").constData()) << blockSize << qint64(0);
+        QTest::newRow((name + " 16k").constData()) << blockSize << qint64(16 * 1024);
+        QTest::newRow((name + " 256k").constData()) << blockSize << qint64(256 * 1024);
+    }
+}
+
+void tst_qiodevice::readSmallBlocks()
+{
+    QFETCH(int, blockSize);
+    QFETCH(qint64, chunkSize);
+
+    const qint64 size = 16 * 1024 * 1024;
+    QString name = "tmp" + QString::number(size);
+
+    {
+        QFile file(name);
+        file.open(QIODevice::WriteOnly);
+        file.seek(size);
+        file.write("x", 1);
+        file.close();
+    }
+
+    QByteArray ba(blockSize, Qt::Uninitialized);
+    QBENCHMARK {
+        QFile file(name);
+        if (chunkSize)
+            file.setReadBufferChunkSize(chunkSize);
+        file.open(QIODevice::ReadOnly);
+        while (file.read(ba.data(), ba.size()) > 0)
+            ;
+    }
+
+    {
+        QFile file(name);
+        file.remove();
+    }
+}
+
 QTEST_MAIN(tst_qiodevice)
 
 #include "main.moc"
@@ -37,6 +37,8 @@ class tst_QProcess : public QObject
 private slots:
 
     void echoTest_performance();
+    void spawnRate_data();
+    void spawnRate();
 };
 
 void tst_QProcess::echoTest_performance()
@@ -84,5 +86,49 @@ void tst_QProcess::echoTest_performance()
     QVERIFY(process.waitForFinished());
 }
 
+void tst_QProcess::spawnRate_data()
+{
+    QTest::addColumn<int>("residentMiB");
+    QTest::addColumn<bool>("childProcessModifier");
+
+    const int sizes[] = { 0, 256, 1024 };
+    for (int size : sizes) {
+        QTest::addRow("%d MiB", size) << size << false;
+        // A modifier forces a real fork(), whose cost grows with the parent
+        QTest::addRow("%d MiB, modifier", size) << size << true;
+    }
+}
+
+void tst_QProcess::spawnRate()
+{
+#ifdef Q_OS_WIN
+    QSKIP("This benchmark measures fork()-like process creation.");
+#else
+    QFETCH(int, residentMiB);
+    QFETCH(bool, childProcessModifier);
+
+    const QString program = QStandardPaths::findExecutable("true");
+    if (program.isEmpty())
+        QSKIP("Could not find the 'true' program.");
+
+    // Grow the parent; touching every page makes it resident
+    QByteArray ballast(residentMiB * 1024 * 1024, 'x');
+    QVERIFY(ballast.size() == residentMiB * 1024 * 1024);
+
+    QProcess process;
+    process.setProgram(program);
+    if (childProcessModifier)
+        process.setChildProcessModifier([] {});
+
+    QBENCHMARK {
+        for (int i = 0; i < 20; ++i) {
+            process.start();
+            QVERIFY(process.waitForFinished());
+            QCOMPARE(process.exitCode(), 0);
+        }
+    }
+#endif
+}
+
 QTEST_MAIN(tst_QProcess)
 #include "tst_bench_qprocess.moc"
@@ -122,6 +122,10 @@ private slots:
     void indexOfSignal();
     void indexOfSlot_data();
     void indexOfSlot();
+    void indexOfSignalLotsOfSignals_data();
+    void indexOfSignalLotsOfSignals();
+    void invokeMethodByName_data();
+    void invokeMethodByName();
 
     void unconnected_data();
     void unconnected();
@@ -222,6 +226,46 @@ void tst_qmetaobject::indexOfSlot()
     }
 }
 
+void tst_qmetaobject::indexOfSignalLotsOfSignals_data()
+{
+    QTest::addColumn<QByteArray>("signal");
+    QTest::newRow("first") << QByteArray("extraSignal1()");
+    QTest::newRow("middle") << QByteArray("extraSignal35()");
+    QTest::newRow("last") << QByteArray("extraSignal70()");
+    QTest::newRow("base class") << QByteArray("destroyed()");
+    QTest::newRow("missing") << QByteArray("noSuchSignal()");
+}
+
+void tst_qmetaobject::indexOfSignalLotsOfSignals()
+{
+    QFETCH(QByteArray, signal);
+    const char *p = signal.constData();
+    const QMetaObject *mo = &LotsOfSignals::staticMetaObject;
+    QBENCHMARK {
+        (void)mo->indexOfSignal(p);
+    }
+}
+
+void tst_qmetaobject::invokeMethodByName_data()
+{
+    QTest::addColumn<QByteArray>("signal");
+    QTest::newRow("first") << QByteArray("extraSignal1()");
+    QTest::newRow("middle") << QByteArray("extraSignal35()");
+    QTest::newRow("last") << QByteArray("extraSignal70()");
+}
+
+// The lookup done by scripting bridges: by name, with the lookup on every call.
+void tst_qmetaobject::invokeMethodByName()
+{
+    QFETCH(QByteArray, signal);
+    const QByteArray name = signal.left(signal.indexOf('('));
+    const char *p = name.constData();
+    LotsOfSignals obj;
+    QBENCHMARK {
+        (void)QMetaObject::invokeMethod(&obj, p, Qt::DirectConnection);
+    }
+}
+
 void tst_qmetaobject::unconnected_data()
 {
     QTest::addColumn<int>("signal_index");
@@ -28,6 +28,10 @@
 
 #include <qtest.h>
 #include <QtCore/qmetatype.h>
+#include <QtCore/qthread.h>
+
+#include <memory>
+#include <vector>
 
 class tst_QMetaType : public QObject
 {
@@ -65,6 +69,9 @@ private slots:
     void constructInPlaceCopy();
     void constructInPlaceCopyStaticLess_data();
     void constructInPlaceCopyStaticLess();
+
+    void lookupCustomThreaded_data();
+    void lookupCustomThreaded();
 };
 
 tst_QMetaType::tst_QMetaType()
@@ -319,5 +326,43 @@ void tst_QMetaType::constructInPlaceCopyStaticLess()
     qFreeAligned(storage);
 }
 
+void tst_QMetaType::lookupCustomThreaded_data()
+{
+    QTest::addColumn<int>("threadCount");
+    for (int threadCount : { 1, 4, 16, 64 })
+        QTest::addRow("%d threads", threadCount) << threadCount;
+}
+
+// Name, id and converter lookups of custom types from many threads at once,
+// as done by queued connections and QVariant conversions.
+void tst_QMetaType::lookupCustomThreaded()
+{
+    QFETCH(int, threadCount);
+    const int fooId = qRegisterMetaType<Foo>("Foo");
+    if (!QMetaType::hasRegisteredConverterFunction<Foo, int>())
+        QMetaType::registerConverter<Foo, int>([](const Foo &foo) { return foo.i; });
+
+    const auto lookups = [fooId]() {
+        const Foo foo = { 42 };
+        int result = 0;
+        for (int i = 0; i < 10000; ++i) {
+            QMetaType::fromName("Foo");
+            const QMetaType type(fooId);
+            QMetaType::convert(type, &foo, QMetaType::fromType<int>(), &result);
+        }
+        Q_ASSERT(result == 42);
+    };
+
+    QBENCHMARK {
+        std::vector<std::unique_ptr<QThread>> threads;
+        for (int i = 0; i < threadCount; ++i)
+            threads.emplace_back(QThread::create(lookups));
+        for (const auto &thread : threads)
+            thread->start();
+        for (const auto &thread : threads)
+            thread->wait();
+    }
+}
+
 QTEST_MAIN(tst_QMetaType)
 #include "tst_qmetatype.moc"
@@ -85,6 +85,11 @@ private slots:
     void createCoreType();
     void createCoreTypeCopy_data();
     void createCoreTypeCopy();
+
+    void convertMatrix_data();
+    void convertMatrix();
+    void valueMatrix_data();
+    void valueMatrix();
 };
 
 struct BigClass
@@ -373,6 +378,96 @@ void tst_qvariant::createCoreTypeCopy()
     }
 }
 
+// Conversions between the number, string and date types, in both directions.
+void tst_qvariant::convertMatrix_data()
+{
+    QTest::addColumn<QVariant>("source");
+    QTest::addColumn<int>("targetTypeId");
+
+    const QDate date(2020, 10, 19);
+    const QVariant sources[] = {
+        QVariant(42), QVariant(42.5), QVariant(qlonglong(42)), QVariant(true),
+        QVariant(QStringLiteral("42")), QVariant(QByteArray("42")),
+        QVariant(date), QVariant(QDateTime(date, QTime(12, 30)))
+    };
+    const int targetTypeIds[] = {
+        QMetaType::Int, QMetaType::Double, QMetaType::LongLong, QMetaType::Bool,
+        QMetaType::QString, QMetaType::QByteArray, QMetaType::QDate, QMetaType::QDateTime
+    };
+    for (const QVariant &source : sources) {
+        for (int targetTypeId : targetTypeIds) {
+            const QMetaType targetType(targetTypeId);
+            if (source.metaType() == targetType
+                    || !QMetaType::canConvert(source.metaType(), targetType)) {
+                continue;
+            }
+            QTest::addRow("%s->%s", source.typeName(), targetType.name())
+                    << source << targetTypeId;
+        }
+    }
+}
+
+void tst_qvariant::convertMatrix()
+{
+    QFETCH(QVariant, source);
+    QFETCH(int, targetTypeId);
+    const QMetaType targetType(targetTypeId);
+    void *target = targetType.create();
+    QBENCHMARK {
+        for (int i = 0; i < ITERATION_COUNT; ++i)
+            QMetaType::convert(source.metaType(), source.constData(), targetType, target);
+    }
+    targetType.destroy(target);
+}
+
+template <typename T>
+static void variantValue(const QVariant &source)
+{
+    QBENCHMARK {
+        for (int i = 0; i < ITERATION_COUNT; ++i)
+            source.value<T>();
+    }
+}
+
+void tst_qvariant::valueMatrix_data()
+{
+    convertMatrix_data();
+}
+
+void tst_qvariant::valueMatrix()
+{
+    QFETCH(QVariant, source);
+    QFETCH(int, targetTypeId);
+    switch (targetTypeId) {
+    case QMetaType::Int:
+        variantValue<int>(source);
+        break;
+    case QMetaType::Double:
+        variantValue<double>(source);
+        break;
+    case QMetaType::LongLong:
+        variantValue<qlonglong>(source);
+        break;
+    case QMetaType::Bool:
+        variantValue<bool>(source);
+        break;
+    case QMetaType::QString:
+        variantValue<QString>(source);
+        break;
+    case QMetaType::QByteArray:
+        variantValue<QByteArray>(source);
+        break;
+    case QMetaType::QDate:
+        variantValue<QDate>(source);
+        break;
+    case QMetaType::QDateTime:
+        variantValue<QDateTime>(source);
+        break;
+    default:
+        QFAIL("Unexpected target type");
+    }
+}
+
 QTEST_MAIN(tst_qvariant)
 
 #include "tst_qvariant.moc"
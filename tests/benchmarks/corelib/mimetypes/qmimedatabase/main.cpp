@@ -36,6 +36,10 @@ class tst_QMimeDatabase: public QObject
 private slots:
     void inheritsPerformance();
     void benchMimeTypeForName();
+    void benchMimeTypeForFileName_data();
+    void benchMimeTypeForFileName();
+    void benchMimeTypeForData_data();
+    void benchMimeTypeForData();
 };
 
 void tst_QMimeDatabase::inheritsPerformance()
@@ -81,5 +85,54 @@ void tst_QMimeDatabase::benchMimeTypeForName()
     }
 }
 
+// To measure the internal database rather than the one installed on the
+// system, run with XDG_DATA_DIRS and XDG_DATA_HOME pointing to an empty directory.
+
+void tst_QMimeDatabase::benchMimeTypeForFileName_data()
+{
+    QTest::addColumn<QString>("fileName");
+
+    QTest::newRow("fast-pattern") << QStringLiteral("document.odt");
+    QTest::newRow("upper-case") << QStringLiteral("IMAGE.JPG");
+    QTest::newRow("long-suffix") << QStringLiteral("archive.tar.bz2");
+    QTest::newRow("literal") << QStringLiteral("Makefile");
+    QTest::newRow("other-glob") << QStringLiteral("README.md");
+    QTest::newRow("no-match") << QStringLiteral("file.nosuchextension");
+}
+
+void tst_QMimeDatabase::benchMimeTypeForFileName()
+{
+    QFETCH(QString, fileName);
+    QMimeDatabase db;
+
+    QBENCHMARK {
+        const QMimeType mime = db.mimeTypeForFile(fileName, QMimeDatabase::MatchExtension);
+        QVERIFY(mime.isValid());
+    }
+}
+
+void tst_QMimeDatabase::benchMimeTypeForData_data()
+{
+    QTest::addColumn<QByteArray>("data");
+
+    QTest::newRow("png") << QByteArrayLiteral("\x89PNG\r\n\x1a\n\0\0\0\rIHDR");
+    QTest::newRow("pdf") << QByteArray("%PDF-1.4\n%\xe2\xe3\xcf\xd3\n");
+    QTest::newRow("elf") << QByteArrayLiteral("\x7f" "ELF\x02\x01\x01\0\0\0\0\0\0\0\0\0\x03\0");
+    QTest::newRow("xml") << QByteArray("<?xml version=\"1.0\"?>\n<svg xmlns=\"http://www.w3.org/2000/svg\"/>\n");
+    QTest::newRow("text") << QByteArray("Lorem ipsum dolor sit amet, consectetur adipiscing elit.\n").repeated(64);
+    QTest::newRow("binary") << QByteArray(4096, '\x55');
+}
+
+void tst_QMimeDatabase::benchMimeTypeForData()
+{
+    QFETCH(QByteArray, data);
+    QMimeDatabase db;
+
+    QBENCHMARK {
+        const QMimeType mime = db.mimeTypeForData(data);
+        QVERIFY(mime.isValid());
+    }
+}
+
 QTEST_MAIN(tst_QMimeDatabase)
 #include "main.moc"
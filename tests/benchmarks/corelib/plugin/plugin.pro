@@ -1,2 +1,3 @@
 TEMPLATE = subdirs
 SUBDIRS = quuid
+qtConfig(library): SUBDIRS += qfactoryloader
@@ -0,0 +1,122 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/QDir>
+#include <QtCore/QTemporaryDir>
+#include <private/qfactoryloader_p.h>
+#include <private/qpluginmetadatacache_p.h>
+#include "plugin/benchplugininterface.h"
+
+class tst_qfactoryloader : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void startup_data();
+    void startup();
+
+private:
+    QTemporaryDir pluginDir;
+    QString previousCacheFile;
+};
+
+static const char suffixC[] = "/bench";
+static const int PluginCount = 150;
+
+void tst_qfactoryloader::initTestCase()
+{
+    QVERIFY2(pluginDir.isValid(), qPrintable(pluginDir.errorString()));
+
+    const QString binDir = QFINDTESTDATA("bin");
+    QVERIFY2(!binDir.isEmpty(), "Unable to locate 'bin' folder");
+    const QFileInfoList plugins = QDir(binDir).entryInfoList(QDir::Files);
+    QVERIFY(!plugins.isEmpty());
+
+    // every copy has the same metadata, so each run scans all of them but
+    // keeps only the first one
+    const QString benchDir = pluginDir.path() + QLatin1String(suffixC);
+    QVERIFY(QDir().mkpath(benchDir));
+    const QString pattern = benchDir + QLatin1String("/libbenchplugin%1.")
+            + plugins.first().suffix();
+    for (int i = 0; i < PluginCount; ++i)
+        QVERIFY(QFile::copy(plugins.first().absoluteFilePath(), pattern.arg(i)));
+
+    QCoreApplication::setLibraryPaths(QStringList(pluginDir.path()));
+    previousCacheFile = QPluginMetaDataCache::instance()->fileName();
+}
+
+void tst_qfactoryloader::cleanupTestCase()
+{
+    QPluginMetaDataCache::instance()->setFileName(previousCacheFile);
+}
+
+void tst_qfactoryloader::startup_data()
+{
+    QTest::addColumn<QString>("mode");
+
+    // the plugins are in the OS page cache in all cases, so "uncached"
+    // measures the parsing cost, not the I/O of a cold start
+    QTest::newRow("uncached") << QString("uncached");
+    QTest::newRow("cold-cache") << QString("cold");
+    QTest::newRow("warm-cache") << QString("warm");
+}
+
+void tst_qfactoryloader::startup()
+{
+    QFETCH(QString, mode);
+
+    QPluginMetaDataCache *cache = QPluginMetaDataCache::instance();
+    const QString cacheFile = pluginDir.filePath(QLatin1String("cache.cbor"));
+    QFile::remove(cacheFile);
+    if (mode == QLatin1String("warm")) {
+        cache->setFileName(cacheFile);
+        QFactoryLoader loader(BenchPluginInterface_iid, QLatin1String(suffixC));
+        QCOMPARE(loader.metaData().size(), 1);
+        QVERIFY(QFile::exists(cacheFile));
+    }
+
+    QBENCHMARK {
+        if (mode == QLatin1String("uncached"))
+            cache->setFileName(QString());
+        else if (mode == QLatin1String("cold"))
+            QFile::remove(cacheFile);
+
+        // reading the cache file is part of what a new process has to do
+        if (mode != QLatin1String("uncached"))
+            cache->setFileName(cacheFile);
+
+        QFactoryLoader loader(BenchPluginInterface_iid, QLatin1String(suffixC));
+        QCOMPARE(loader.metaData().size(), 1);
+    }
+}
+
+QTEST_MAIN(tst_qfactoryloader)
+
+#include "main.moc"
@@ -0,0 +1,6 @@
+TEMPLATE = subdirs
+
+test.depends = plugin
+SUBDIRS = \
+    plugin \
+    test
@@ -0,0 +1,7 @@
+TEMPLATE = app
+CONFIG += benchmark
+QT = core-private testlib
+
+TARGET = ../tst_bench_qfactoryloader
+SOURCES += ../main.cpp
+HEADERS += ../plugin/benchplugininterface.h
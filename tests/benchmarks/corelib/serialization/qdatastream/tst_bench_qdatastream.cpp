@@ -0,0 +1,175 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtCore/QBuffer>
+#include <QtCore/QByteArray>
+#include <QtCore/QDataStream>
+#include <QtCore/QList>
+#include <QtTest/QtTest>
+
+class tst_bench_QDataStream : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void writeList_data();
+    void writeList();
+    void readList_data();
+    void readList();
+    void writeElementWise_data();
+    void writeElementWise();
+    void readElementWise_data();
+    void readElementWise();
+
+private:
+    static QList<double> makeValues();
+    static QByteArray serialize(const QList<double> &values, QDataStream::ByteOrder byteOrder);
+};
+
+static const int ValueCount = 1000000;
+
+QList<double> tst_bench_QDataStream::makeValues()
+{
+    QList<double> values;
+    values.reserve(ValueCount);
+    for (int i = 0; i < ValueCount; ++i)
+        values.append(i * 0.5);
+    return values;
+}
+
+QByteArray tst_bench_QDataStream::serialize(const QList<double> &values,
+                                            QDataStream::ByteOrder byteOrder)
+{
+    QByteArray ba;
+    QDataStream stream(&ba, QIODevice::WriteOnly);
+    stream.setByteOrder(byteOrder);
+    stream << values;
+    return ba;
+}
+
+static void addByteOrderData()
+{
+    QTest::addColumn<QDataStream::ByteOrder>("byteOrder");
+
+    QTest::newRow("BigEndian") << QDataStream::BigEndian;
+    QTest::newRow("LittleEndian") << QDataStream::LittleEndian;
+}
+
+void tst_bench_QDataStream::writeList_data()
+{
+    addByteOrderData();
+}
+
+void tst_bench_QDataStream::writeList()
+{
+    QFETCH(QDataStream::ByteOrder, byteOrder);
+    const QList<double> values = makeValues();
+    QByteArray ba;
+    ba.reserve(ValueCount * int(sizeof(double)) + 16);
+
+    QBENCHMARK {
+        QBuffer buffer(&ba);
+        buffer.open(QIODevice::WriteOnly);
+        QDataStream stream(&buffer);
+        stream.setByteOrder(byteOrder);
+        stream << values;
+    }
+}
+
+void tst_bench_QDataStream::readList_data()
+{
+    addByteOrderData();
+}
+
+void tst_bench_QDataStream::readList()
+{
+    QFETCH(QDataStream::ByteOrder, byteOrder);
+    const QByteArray ba = serialize(makeValues(), byteOrder);
+    QList<double> values;
+
+    QBENCHMARK {
+        QDataStream stream(ba);
+        stream.setByteOrder(byteOrder);
+        stream >> values;
+    }
+    QCOMPARE(values.size(), ValueCount);
+}
+
+void tst_bench_QDataStream::writeElementWise_data()
+{
+    addByteOrderData();
+}
+
+void tst_bench_QDataStream::writeElementWise()
+{
+    QFETCH(QDataStream::ByteOrder, byteOrder);
+    const QList<double> values = makeValues();
+    QByteArray ba;
+    ba.reserve(ValueCount * int(sizeof(double)) + 16);
+
+    QBENCHMARK {
+        QBuffer buffer(&ba);
+        buffer.open(QIODevice::WriteOnly);
+        QDataStream stream(&buffer);
+        stream.setByteOrder(byteOrder);
+        stream << quint32(values.size());
+        for (double value : values)
+            stream << value;
+    }
+}
+
+void tst_bench_QDataStream::readElementWise_data()
+{
+    addByteOrderData();
+}
+
+void tst_bench_QDataStream::readElementWise()
+{
+    QFETCH(QDataStream::ByteOrder, byteOrder);
+    const QByteArray ba = serialize(makeValues(), byteOrder);
+    QList<double> values;
+
+    QBENCHMARK {
+        QDataStream stream(ba);
+        stream.setByteOrder(byteOrder);
+        quint32 n;
+        stream >> n;
+        values.clear();
+        values.reserve(n);
+        for (quint32 i = 0; i < n; ++i) {
+            double value;
+            stream >> value;
+            values.append(value);
+        }
+    }
+    QCOMPARE(values.size(), ValueCount);
+}
+
+QTEST_MAIN(tst_bench_QDataStream)
+#include "tst_bench_qdatastream.moc"
@@ -0,0 +1,182 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/QByteArrayMatcher>
+#include <QtCore/QStringMatcher>
+#include <QtTest/QtTest>
+
+class tst_bench_QByteArrayMatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void singleMatchers_data();
+    void singleMatchers();
+    void multiMatcher_data();
+    void multiMatcher();
+    void singleStringMatchers_data();
+    void singleStringMatchers();
+    void multiStringMatcher_data();
+    void multiStringMatcher();
+};
+
+static QList<QByteArray> keywords(int count)
+{
+    QList<QByteArray> result;
+    result.reserve(count);
+    for (int i = 0; i < count; ++i)
+        result << "keyword_" + QByteArray::number(i * 7919, 36);
+    return result;
+}
+
+// 1 MiB of log-like text with a keyword every 4 KiB
+static QByteArray haystack(const QList<QByteArray> &needles)
+{
+    const QByteArray line = "2020-07-01 12:00:00 worker[1234]: processed request in 42 ms\n";
+    QByteArray result;
+    result.reserve(1024 * 1024 + 1024);
+    int next = 0;
+    while (result.size() < 1024 * 1024) {
+        result += line;
+        if (result.size() / 4096 > next && !needles.isEmpty()) {
+            result += needles.at(next % needles.size()) + '\n';
+            ++next;
+        }
+    }
+    return result;
+}
+
+static void addRows()
+{
+    QTest::addColumn<int>("needleCount");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+
+    for (int count : { 1, 10, 100, 10000 }) {
+        QTest::addRow("%d-sensitive", count) << count << Qt::CaseSensitive;
+        QTest::addRow("%d-insensitive", count) << count << Qt::CaseInsensitive;
+    }
+}
+
+void tst_bench_QByteArrayMatcher::singleMatchers_data()
+{
+    addRows();
+}
+
+void tst_bench_QByteArrayMatcher::singleMatchers()
+{
+    QFETCH(int, needleCount);
+    QFETCH(Qt::CaseSensitivity, cs);
+    if (cs == Qt::CaseInsensitive)
+        QSKIP("QByteArrayMatcher has no case insensitive mode");
+    if (needleCount > 100)
+        QSKIP("Too slow to be measured");
+    const QList<QByteArray> needles = keywords(needleCount);
+    const QByteArray data = haystack(needles);
+    QList<QByteArrayMatcher> matchers;
+    for (const QByteArray &needle : needles)
+        matchers.append(QByteArrayMatcher(needle));
+
+    QBENCHMARK {
+        qsizetype found = 0;
+        for (const QByteArrayMatcher &matcher : qAsConst(matchers)) {
+            for (qsizetype pos = matcher.indexIn(data); pos >= 0; pos = matcher.indexIn(data, pos + 1))
+                ++found;
+        }
+        QVERIFY(found > 0);
+    }
+}
+
+void tst_bench_QByteArrayMatcher::multiMatcher_data()
+{
+    addRows();
+}
+
+void tst_bench_QByteArrayMatcher::multiMatcher()
+{
+    QFETCH(int, needleCount);
+    QFETCH(Qt::CaseSensitivity, cs);
+    const QList<QByteArray> needles = keywords(needleCount);
+    const QByteArray data = haystack(needles);
+    const QMultiByteArrayMatcher matcher(needles, cs);
+
+    QBENCHMARK {
+        QVERIFY(!matcher.matches(data).isEmpty());
+    }
+}
+
+void tst_bench_QByteArrayMatcher::singleStringMatchers_data()
+{
+    addRows();
+}
+
+void tst_bench_QByteArrayMatcher::singleStringMatchers()
+{
+    QFETCH(int, needleCount);
+    QFETCH(Qt::CaseSensitivity, cs);
+    if (needleCount > 100)
+        QSKIP("Too slow to be measured");
+    QList<QString> needles;
+    for (const QByteArray &needle : keywords(needleCount))
+        needles.append(QString::fromLatin1(needle));
+    const QString data = QString::fromLatin1(haystack(keywords(needleCount)));
+    QList<QStringMatcher> matchers;
+    for (const QString &needle : qAsConst(needles))
+        matchers.append(QStringMatcher(needle, cs));
+
+    QBENCHMARK {
+        qsizetype found = 0;
+        for (const QStringMatcher &matcher : qAsConst(matchers)) {
+            for (qsizetype pos = matcher.indexIn(data); pos >= 0; pos = matcher.indexIn(data, pos + 1))
+                ++found;
+        }
+        QVERIFY(found > 0);
+    }
+}
+
+void tst_bench_QByteArrayMatcher::multiStringMatcher_data()
+{
+    addRows();
+}
+
+void tst_bench_QByteArrayMatcher::multiStringMatcher()
+{
+    QFETCH(int, needleCount);
+    QFETCH(Qt::CaseSensitivity, cs);
+    QList<QString> needles;
+    for (const QByteArray &needle : keywords(needleCount))
+        needles.append(QString::fromLatin1(needle));
+    const QString data = QString::fromLatin1(haystack(keywords(needleCount)));
+    const QMultiStringMatcher matcher(needles, cs);
+
+    QBENCHMARK {
+        QVERIFY(!matcher.matches(data).isEmpty());
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_bench_QByteArrayMatcher)
+#include "tst_bench_qbytearraymatcher.moc"
@@ -29,6 +29,8 @@
 #include <QLocale>
 #include <QTest>
 
+#include <cmath>
+
 class tst_QLocale : public QObject
 {
     Q_OBJECT
@@ -37,6 +39,12 @@ private Q_SLOTS:
     void toUpper_QLocale_1();
     void toUpper_QLocale_2();
     void toUpper_QString();
+    void number_QString();
+    void number_QByteArray();
+    void appendDoubles();
+    void toDouble_QLocale();
+    void toDouble_QByteArray();
+    void parseDoubles();
 };
 
 static QString data()
@@ -65,6 +73,86 @@ void tst_QLocale::toUpper_QString()
     QBENCHMARK { LOOP(s.toUpper()) }
 }
 
+// A column of 10000 doubles of mixed magnitude, as found in CSV files
+static QList<double> doubleColumn()
+{
+    QList<double> values;
+    values.reserve(10000);
+    quint32 state = 1;
+    for (int i = 0; i < 10000; ++i) {
+        state = state * 1664525u + 1013904223u;
+        const double mantissa = (state >> 8) / double(1 << 24);
+        const int exponent = int(state % 21) - 10;
+        values.append((i % 3 ? mantissa : -mantissa) * std::pow(10.0, exponent));
+    }
+    return values;
+}
+
+static QByteArray formattedColumn(const QList<double> &values)
+{
+    QByteArray column;
+    column.appendDoubles(values.constData(), values.size());
+    return column;
+}
+
+void tst_QLocale::number_QString()
+{
+    const QList<double> values = doubleColumn();
+    QBENCHMARK {
+        for (double d : values)
+            QString::number(d, 'g', QLocale::FloatingPointShortest);
+    }
+}
+
+void tst_QLocale::number_QByteArray()
+{
+    const QList<double> values = doubleColumn();
+    QBENCHMARK {
+        QByteArray column;
+        for (double d : values) {
+            column += QByteArray::number(d, 'g', QLocale::FloatingPointShortest);
+            column += '\n';
+        }
+    }
+}
+
+void tst_QLocale::appendDoubles()
+{
+    const QList<double> values = doubleColumn();
+    QBENCHMARK {
+        QByteArray column;
+        column.appendDoubles(values.constData(), values.size());
+    }
+}
+
+void tst_QLocale::toDouble_QLocale()
+{
+    const QStringList fields = QString::fromLatin1(formattedColumn(doubleColumn())).split(u'\n');
+    const QLocale c = QLocale::c();
+    QBENCHMARK {
+        for (const QString &field : fields)
+            c.toDouble(field);
+    }
+}
+
+void tst_QLocale::toDouble_QByteArray()
+{
+    const QByteArray column = formattedColumn(doubleColumn());
+    QBENCHMARK {
+        for (const QByteArray &field : column.split('\n'))
+            field.toDouble();
+    }
+}
+
+void tst_QLocale::parseDoubles()
+{
+    const QByteArray column = formattedColumn(doubleColumn());
+    QList<double> values(10000);
+    QBENCHMARK {
+        QByteArray::parseDoubles(column, values.data(), values.size());
+    }
+}
+
 QTEST_MAIN(tst_QLocale)
 
 #include "main.moc"
@@ -0,0 +1,5 @@
+CONFIG += benchmark
+QT = core-private testlib
+
+TARGET = tst_bench_qregularexpression
+SOURCES += tst_bench_qregularexpression.cpp
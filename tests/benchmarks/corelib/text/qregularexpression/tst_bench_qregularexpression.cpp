@@ -0,0 +1,173 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtCore/QRegularExpression>
+#include <QtCore/QStringList>
+#include <QtTest/QtTest>
+
+#include <private/qregularexpression_p.h>
+
+class tst_bench_QRegularExpression : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void cleanup();
+
+    void constructAndMatch_data();
+    void constructAndMatch();
+    void constructAndMatchManyPatterns_data();
+    void constructAndMatchManyPatterns();
+    void matchPatternList_data();
+    void matchPatternList();
+    void matchPatternSet_data();
+    void matchPatternSet();
+};
+
+static QStringList routePatterns()
+{
+    QStringList patterns;
+    for (int i = 0; i < 100; ++i)
+        patterns << QStringLiteral("^/api/v%1/(?<resource>[a-z]+)/(?<id>\\d+)(/.*)?$").arg(i);
+    return patterns;
+}
+
+void tst_bench_QRegularExpression::cleanup()
+{
+    qt_setRegularExpressionCacheSize(256);
+    qt_clearRegularExpressionCache();
+}
+
+void tst_bench_QRegularExpression::constructAndMatch_data()
+{
+    QTest::addColumn<int>("cacheSize");
+
+    QTest::newRow("uncached") << 0;
+    QTest::newRow("cached") << 256;
+}
+
+void tst_bench_QRegularExpression::constructAndMatch()
+{
+    QFETCH(int, cacheSize);
+    qt_setRegularExpressionCacheSize(cacheSize);
+    const QString pattern = routePatterns().constFirst();
+    const QString subject = QStringLiteral("/api/v0/users/1234/profile");
+
+    QBENCHMARK {
+        QRegularExpression re(pattern);
+        QVERIFY(re.match(subject).hasMatch());
+    }
+}
+
+void tst_bench_QRegularExpression::constructAndMatchManyPatterns_data()
+{
+    constructAndMatch_data();
+}
+
+void tst_bench_QRegularExpression::constructAndMatchManyPatterns()
+{
+    QFETCH(int, cacheSize);
+    qt_setRegularExpressionCacheSize(cacheSize);
+    const QStringList patterns = routePatterns();
+    const QString subject = QStringLiteral("/api/v42/users/1234/profile");
+
+    QBENCHMARK {
+        int matches = 0;
+        for (const QString &pattern : patterns) {
+            QRegularExpression re(pattern);
+            if (re.match(subject).hasMatch())
+                ++matches;
+        }
+        QCOMPARE(matches, 1);
+    }
+}
+
+static QStringList logRulePatterns(int count)
+{
+    QStringList patterns;
+    patterns.reserve(count);
+    for (int i = 0; i < count; ++i)
+        patterns << QStringLiteral("service-%1: (warning|error) code \\d+").arg(i);
+    return patterns;
+}
+
+static QStringList logLines()
+{
+    return {
+        QStringLiteral("2020-07-01 12:00:00 service-4711: error code 42 while reading"),
+        QStringLiteral("2020-07-01 12:00:01 kernel: eth0 link up"),
+        QStringLiteral("2020-07-01 12:00:02 service-99999: warning code 7"),
+        QStringLiteral("2020-07-01 12:00:03 cron: job finished in 12 ms"),
+    };
+}
+
+void tst_bench_QRegularExpression::matchPatternList_data()
+{
+    QTest::addColumn<int>("patternCount");
+
+    QTest::newRow("10") << 10;
+    QTest::newRow("100") << 100;
+    QTest::newRow("5000") << 5000;
+}
+
+void tst_bench_QRegularExpression::matchPatternList()
+{
+    QFETCH(int, patternCount);
+    QList<QRegularExpression> expressions;
+    for (const QString &pattern : logRulePatterns(patternCount))
+        expressions.append(QRegularExpression(pattern));
+    const QStringList lines = logLines();
+
+    QBENCHMARK {
+        for (const QString &line : lines) {
+            for (const QRegularExpression &re : qAsConst(expressions))
+                re.match(line).hasMatch();
+        }
+    }
+}
+
+void tst_bench_QRegularExpression::matchPatternSet_data()
+{
+    matchPatternList_data();
+}
+
+void tst_bench_QRegularExpression::matchPatternSet()
+{
+    QFETCH(int, patternCount);
+    const QRegularExpressionSet set(logRulePatterns(patternCount));
+    const QStringList lines = logLines();
+
+    QBENCHMARK {
+        for (const QString &line : lines)
+            set.matchingPatterns(line);
+    }
+}
+
+QTEST_MAIN(tst_bench_QRegularExpression)
+#include "tst_bench_qregularexpression.moc"
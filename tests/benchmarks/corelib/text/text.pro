@@ -1,8 +1,10 @@
 TEMPLATE = subdirs
 SUBDIRS = \
         qbytearray \
+        qbytearraymatcher \
         qchar \
         qlocale \
+        qregularexpression \
         qstringbuilder \
         qstringlist
 
@@ -52,6 +52,7 @@ class tst_QDateTime : public QObject
 
     static QList<QDateTime> daily(qint64 start, qint64 end);
     static QList<QDateTime> norse(qint64 start, qint64 end);
+    static QByteArray isoColumn(qint64 start, qint64 end);
 
 private Q_SLOTS:
     void create();
@@ -97,6 +98,9 @@ private Q_SLOTS:
     void fromString();
     void fromStringText();
     void fromStringIso();
+    void fromStringIsoColumn();
+    void msecsSinceEpochFromIsoString();
+    void msecsSinceEpochFromIsoStrings();
     void fromMSecsSinceEpoch();
     void fromMSecsSinceEpochUtc();
     void fromMSecsSinceEpochTz();
@@ -121,6 +125,18 @@ QList<QDateTime> tst_QDateTime::norse(qint64 start, qint64 end)
     return list;
 }
 
+QByteArray tst_QDateTime::isoColumn(qint64 start, qint64 end)
+{
+    // One UTC time stamp with milliseconds per hour, as found in log files
+    QByteArray column;
+    const QDateTime first(QDate::fromJulianDay(start), QTime(0, 0), Qt::UTC);
+    for (qint64 hour = 0; hour < (end - start) * 24; ++hour) {
+        column += first.addMSecs(hour * 3600123).toString(Qt::ISODateWithMs).toLatin1();
+        column += '\n';
+    }
+    return column;
+}
+
 void tst_QDateTime::create()
 {
     QBENCHMARK {
@@ -538,6 +554,34 @@ void tst_QDateTime::fromStringIso()
     }
 }
 
+void tst_QDateTime::fromStringIsoColumn()
+{
+    const QStringList lines = QString::fromLatin1(isoColumn(JULIAN_DAY_2010, JULIAN_DAY_2011))
+            .split(QLatin1Char('\n'), Qt::SkipEmptyParts);
+    QBENCHMARK {
+        for (const QString &line : lines)
+            QDateTime::fromString(line, Qt::ISODateWithMs).toMSecsSinceEpoch();
+    }
+}
+
+void tst_QDateTime::msecsSinceEpochFromIsoString()
+{
+    const QList<QByteArray> lines = isoColumn(JULIAN_DAY_2010, JULIAN_DAY_2011).split('\n');
+    QBENCHMARK {
+        for (const QByteArray &line : lines)
+            QDateTime::msecsSinceEpochFromIsoString(line);
+    }
+}
+
+void tst_QDateTime::msecsSinceEpochFromIsoStrings()
+{
+    const QByteArray column = isoColumn(JULIAN_DAY_2010, JULIAN_DAY_2011);
+    QList<qint64> msecs(column.count('\n'));
+    QBENCHMARK {
+        QDateTime::msecsSinceEpochFromIsoStrings(column, msecs.data(), msecs.size());
+    }
+}
+
 void tst_QDateTime::fromMSecsSinceEpoch()
 {
     const int start = JULIAN_DAY_2010 - JULIAN_DAY_1970;
@@ -49,6 +49,10 @@ private Q_SLOTS:
     void transitionsForward();
     void transitionsReverse_data() { transitionList_data(); }
     void transitionsReverse();
+    void offsetFromUtc_data() { transitionList_data(); }
+    void offsetFromUtc();
+    void toTimeZone_data() { transitionList_data(); }
+    void toTimeZone();
 };
 
 static QList<QByteArray> enoughZones()
@@ -161,6 +165,39 @@ void tst_QTimeZone::transitionsReverse()
     }
 }
 
+// Every 1001 minutes from 1970 to 2100, so that times both before and after
+// the last transition of the zone's data are looked up:
+static QList<QDateTime> spreadTimes()
+{
+    QList<QDateTime> times;
+    const qint64 end = QDate(2100, 1, 1).startOfDay(Qt::UTC).toMSecsSinceEpoch();
+    for (qint64 msecs = 0; msecs < end; msecs += 1001 * 60 * 1000)
+        times.append(QDateTime::fromMSecsSinceEpoch(msecs, Qt::UTC));
+    return times;
+}
+
+void tst_QTimeZone::offsetFromUtc()
+{
+    QFETCH(QByteArray, name);
+    const QTimeZone zone = name.isEmpty() ? QTimeZone::systemTimeZone() : QTimeZone(name);
+    const QList<QDateTime> times = spreadTimes();
+    QBENCHMARK {
+        for (const QDateTime &time : times)
+            zone.offsetFromUtc(time);
+    }
+}
+
+void tst_QTimeZone::toTimeZone()
+{
+    QFETCH(QByteArray, name);
+    const QTimeZone zone = name.isEmpty() ? QTimeZone::systemTimeZone() : QTimeZone(name);
+    const QList<QDateTime> times = spreadTimes();
+    QBENCHMARK {
+        for (const QDateTime &time : times)
+            time.toTimeZone(zone).time();
+    }
+}
+
 QTEST_MAIN(tst_QTimeZone)
 
 #include "main.moc"